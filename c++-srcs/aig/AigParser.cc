@@ -8,16 +8,42 @@
 
 #include "AigParser.h"
 #include "ModelImpl.h"
+#include "MappedFile.h"
+#include "ParseFileInfo.h"
+#include "ProgressReporter.h"
+#include "ParseCache.h"
 #include "ym/BnModel.h"
-#include "ym/MsgMgr.h"
-#include "ym/FileRegion.h"
+#include "ym/SopCover.h"
+#include "MsgQueue.h"
+#include <cstring>
 
 
 BEGIN_NAMESPACE_YM_BN
 
 BEGIN_NONAMESPACE
 
-bool debug = false;
+// 未定義のノード番号
+const BnIdType NO_NODE = static_cast<BnIdType>(BAD_ID);
+
+// 空白文字の時 true を返す．
+inline
+bool
+is_space(
+  char c
+)
+{
+  return c == ' ' || c == '\t';
+}
+
+// 数字の時 true を返す．
+inline
+bool
+is_digit(
+  char c
+)
+{
+  return '0' <= c && c <= '9';
+}
 
 END_NONAMESPACE
 
@@ -29,40 +55,50 @@ END_NONAMESPACE
 // @brief aag ファイルの読み込みを行う．
 BnModel
 BnModel::read_aag(
-  const string& filename,
-  const string& clock_name,
-  const string& reset_name
+  const std::string& filename,
+  const JsonValue& option
 )
 {
+  ParseCache cache{filename, "aag", option};
   BnModel model;
+  if ( cache.load(model) ) {
+    return model;
+  }
+  model._set_read_option(option);
 
-  AigParser parser;
-  if ( !parser.read_aag(filename, clock_name, reset_name, model.mImpl.get()) ) {
-    ostringstream buf;
+  AigParser parser(model._model_impl());
+  if ( !parser.read_aag(filename, ReadOption{option}) ) {
+    std::ostringstream buf;
     buf << "BnModel::read_aag(\"" << filename << "\") failed.";
     throw std::invalid_argument{buf.str()};
   }
 
+  cache.save(model);
   return model;
 }
 
 // @brief aig ファイルの読み込みを行う．
 BnModel
 BnModel::read_aig(
-  const string& filename,
-  const string& clock_name,
-  const string& reset_name
+  const std::string& filename,
+  const JsonValue& option
 )
 {
+  ParseCache cache{filename, "aig", option};
   BnModel model;
+  if ( cache.load(model) ) {
+    return model;
+  }
+  model._set_read_option(option);
 
-  AigParser parser;
-  if ( !parser.read_aig(filename, clock_name, reset_name, model.mImpl.get()) ) {
-    ostringstream buf;
+  AigParser parser(model._model_impl());
+  if ( !parser.read_aig(filename, ReadOption{option}) ) {
+    std::ostringstream buf;
     buf << "BnModel::read_aig(\"" << filename << "\") failed.";
     throw std::invalid_argument{buf.str()};
   }
 
+  cache.save(model);
   return model;
 }
 
@@ -71,628 +107,718 @@ BnModel::read_aig(
 // クラス AigParser
 //////////////////////////////////////////////////////////////////////
 
+// @brief コンストラクタ
+AigParser::AigParser(
+  ModelImpl& model
+) : mModel{model}
+{
+}
+
 // @brief Ascii AIG フォーマットを読み込む．
 bool
 AigParser::read_aag(
-  const string& filename,
-  const string& clock_name,
-  const string& reset_name,
-  ModelImpl* model
+  const std::string& filename,
+  const ReadOption& option
 )
 {
-  if ( !open(filename) ) {
-    return true;
+  MappedFile fin;
+  if ( !fin.open(filename, option.use_mmap) ) {
+    std::ostringstream buf;
+    buf << filename << ": No such file.";
+    MsgQueue::output(__FILE__, __LINE__, FileRegion(),
+		     MsgType::Failure, "AIG_PARSER", buf.str());
+    return false;
   }
+  mFileInfo = new_file_info(filename);
+  mBegin = fin.begin();
+  mCur = fin.begin();
+  mEnd = fin.end();
+  mLineBegin = mCur;
+  mLineNo = 1;
+  mProgress = ProgressReporter{"read", fin.size(),
+			       ProgressReporter::BYTE_STRIDE};
 
   // ヘッダ行の読み込み
-  SizeType M, I, L, O, A;
-  if ( !read_aag_header(M, I, L, O, A) ) {
+  if ( !read_header("aag") ) {
+    return false;
+  }
+  if ( mM < (mI + mL + mA) ) {
+    error("Wrong parameters in the header.");
     return false;
   }
 
-  initialize(M, I, O, model);
+  initialize();
+  mAndArray.resize(mM + 1, AndInfo{0, 0, 0});
 
   // 入力行の読み込み
-  for ( SizeType i = 0; i < I; ++ i ) {
-    SizeType id;
-    if ( !read_input(id) ) {
+  for ( SizeType i = 0; i < mI; ++ i ) {
+    SizeType lit;
+    if ( !read_number(lit) || !read_eol() ) {
       return false;
     }
-    if ( debug ) {
-      cout << "I#" << i << ": " << id << endl;
+    if ( !new_input(lit) ) {
+      return false;
     }
-    model->set_input(id);
   }
 
   // ラッチ行の読み込み
-  SizeType clock_id = BAD_ID;
-  SizeType reset_id = BAD_ID;
-  if ( L > 0 ) {
-    clock_id = model->new_input();
-    reset_id = model->new_input();
-  }
-  for ( SizeType i = 0; i < L; ++ i ) {
-    SizeType oid;
-    SizeType src_lit;
-    if ( !read_latch(oid, src_lit) ) {
+  for ( SizeType i = 0; i < mL; ++ i ) {
+    SizeType lit;
+    SizeType next;
+    if ( !read_number(lit) || !read_number(next) ) {
       return false;
     }
-    if ( debug ) {
-      cout << "L#" << i << ": " << oid << " " << src_lit << endl;
-    }
-    SizeType dff_id = mModel->new_dff();
-    model->set_data_output(dff_id, oid);
-    model->set_seq_output(oid, dff_id);
-    model->set_clock(dff_id, clock_id);
-    model->set_clear(dff_id, reset_id);
-    auto src_id = lit2node(src_lit);
-    model->set_data_src(dff_id, src_id);
-  }
-
-  // 出力行の読み込み
-  for ( SizeType i = 0; i < O; ++ i ) {
-    SizeType src_lit;
-    if ( !read_src(src_lit) ) {
+    SizeType reset = 0;
+    if ( has_number() && !read_number(reset) ) {
       return false;
     }
-    if ( debug ) {
-      cout << "O#" << i << ": " << src_lit << endl;
-    }
-    auto src_id = lit2node(src_lit);
-    mModel->new_output(src_id);
-  }
-
-  // AND行の読み込み
-  for ( SizeType i = 0; i < A; ++ i ) {
-    SizeType id;
-    SizeType src0_lit, src1_lit;
-    if ( !read_and(id, src0_lit, src1_lit) ) {
+    if ( !read_eol() ) {
       return false;
     }
-    if ( debug ) {
-      cout << "A#" << i << ": " << id << " " << src0_lit << " " << src1_lit << endl;
-    }
-    bool src0_inv;
-    auto src0_id = lit2node(src0_lit, src0_inv);
-    bool src1_inv;
-    auto src1_id = lit2node(src1_lit, src1_inv);
-    mModel->set_aig(id, src0_id, src1_id, src0_inv, src1_inv);
-  }
-
-  // ラッチのソースが定義されているかチェック
-  for ( SizeType i = 0; i < mModel->seq_num(); ++ i ) {
-    auto& seq = mModel->seq_impl(i);
-    auto src = seq.data_src();
-    ostringstream buf;
-    buf << "Latch#" << i << "(Node#" << seq.data_output() << ")";
-    if ( !check_defined(src, buf.str()) ) {
+    if ( !new_latch(lit, next, reset) ) {
       return false;
     }
   }
-  // 出力のソースが定義されているかのチェック
-  for ( SizeType i = 0; i < mModel->output_num(); ++ i ) {
-    auto id = mModel->output_id(i);
-    ostringstream buf;
-    buf << "Output#" << i;
-    if ( !check_defined(id, buf.str()) ) {
+
+  // 出力行の読み込み
+  for ( SizeType i = 0; i < mO + mB + mC; ++ i ) {
+    SizeType lit;
+    if ( !read_number(lit) || !check_range(lit) || !read_eol() ) {
       return false;
     }
+    mOutputList.push_back(lit);
   }
-  // 論理ノードのソースが定義されているかのチェック
-  for ( auto id: mModel->logic_list() ) {
-    auto node = mModel->node_impl(id);
-    ostringstream buf;
-    buf << "Node#" << id;
-    for ( auto iid: node->fanin_list() ) {
-      if ( !check_defined(iid, buf.str()) ) {
-	return false;
-      }
-    }
+
+  // AND行の読み込み
+  if ( !read_aag_and() ) {
+    return false;
   }
 
-  model->make_logic_list();
+  if ( !set_outputs() ) {
+    return false;
+  }
 
   // シンボルテーブルとコメントの読み込みを行う．
-  read_symbols();
+  if ( !read_symbols() ) {
+    return false;
+  }
+
+  mProgress.finish(mModel.node_num());
+  mModel.make_logic_list();
 
   return true;
 }
 
-BEGIN_NONAMESPACE
-
-END_NONAMESPACE
-
 // @brief AIG フォーマットを読み込む．
 bool
 AigParser::read_aig(
-  const string& filename,
-  const string& clock_name,
-  const string& reset_name,
-  ModelImpl* model
+  const std::string& filename,
+  const ReadOption& option
 )
 {
-  if ( !open(filename) ) {
-    return true;
+  MappedFile fin;
+  if ( !fin.open(filename, option.use_mmap) ) {
+    std::ostringstream buf;
+    buf << filename << ": No such file.";
+    MsgQueue::output(__FILE__, __LINE__, FileRegion(),
+		     MsgType::Failure, "AIG_PARSER", buf.str());
+    return false;
   }
+  mFileInfo = new_file_info(filename);
+  mBegin = fin.begin();
+  mCur = fin.begin();
+  mEnd = fin.end();
+  mLineBegin = mCur;
+  mLineNo = 1;
+  mProgress = ProgressReporter{"read", fin.size(),
+			       ProgressReporter::BYTE_STRIDE};
 
   // ヘッダ行の読み込み
-  SizeType M, I, L, O, A;
-  if ( !read_aig_header(M, I, L, O, A) ) {
+  if ( !read_header("aig") ) {
     return false;
   }
-
-  if ( debug ) {
-    cout << "aig " << M
-	 << " " << I
-	 << " " << L
-	 << " " << O
-	 << " " << A << endl;
+  if ( mM != (mI + mL + mA) ) {
+    error("Wrong parameters in the header.");
+    return false;
   }
 
-  initialize(M, I, O, model);
+  initialize();
+
+  // 入力は暗黙に 2, 4, ..., 2I となっている．
+  for ( SizeType i = 0; i < mI; ++ i ) {
+    new_input((i + 1) * 2);
+  }
 
   // ラッチ行の読み込み
-  SizeType clock_id = BAD_ID;
-  SizeType reset_id = BAD_ID;
-  if ( L > 0 ) {
-    clock_id = model->new_input();
-    reset_id = model->new_input();
-  }
-  for ( SizeType i = 0; i < L; ++ i ) {
-    SizeType src_lit;
-    if ( !read_src(src_lit) ) {
+  // 出力のリテラルは暗黙に 2(I + 1), ..., 2(I + L) となっている．
+  for ( SizeType i = 0; i < mL; ++ i ) {
+    auto lit = (mI + i + 1) * 2;
+    SizeType next;
+    if ( !read_number(next) ) {
+      return false;
+    }
+    SizeType reset = 0;
+    if ( has_number() && !read_number(reset) ) {
+      return false;
+    }
+    if ( !read_eol() ) {
       return false;
     }
-    if ( debug ) {
-      cout << "L#" << i << ": " << src_lit << endl;
+    if ( !new_latch(lit, next, reset) ) {
+      return false;
     }
-    auto oid = i + I;
-    //auto dff_id = mModel->new_dff({}, oid, clock_id, reset_id, BAD_ID, ' ');
-    auto dff_id = mModel->new_dff(' ');
-    mModel->set_clock(dff_id, clock_id);
-    mModel->set_clear(dff_id, reset_id);
-    bool src_inv;
-    auto src_id = lit2node(src_lit, src_inv);
-    mModel->set_data_src(dff_id, src_id);
   }
 
   // 出力行の読み込み
-  for ( SizeType i = 0; i < O; ++ i ) {
-    SizeType src_lit;
-    if ( !read_src(src_lit) ) {
+  for ( SizeType i = 0; i < mO + mB + mC; ++ i ) {
+    SizeType lit;
+    if ( !read_number(lit) || !check_range(lit) || !read_eol() ) {
       return false;
     }
-    if ( debug ) {
-      cout << "O#" << i << ": " << src_lit << endl;
-    }
-    auto src_id = lit2node(src_lit);
-    mModel->new_output(src_id);
+    mOutputList.push_back(lit);
   }
 
-  // AND行の読み込み
-  for ( SizeType i = 0; i < A; ++ i ) {
-    SizeType d0 = read_number();
-    SizeType d1 = read_number();
-    SizeType pos = i + I + L + 1;
-    SizeType lhs = pos * 2;
-    SizeType rhs0 = lhs - d0;
-    SizeType rhs1 = rhs0 - d1;
-    if ( debug ) {
-      cout << "A#" << i << ": "
-	   << d0 << " " << d1
-	   << " -> " << rhs0 << " " << rhs1 << endl;
-    }
-    auto id = i + I + L;
-    bool src0_inv;
-    auto src0_id = lit2node(rhs0, src0_inv);
-    bool src1_inv;
-    auto src1_id = lit2node(rhs1, src1_inv);
-    mModel->set_aig(id, src0_id, src1_id, src0_inv, src1_inv);
-    set_defined(id);
-  }
-
-  model->make_logic_list();
-
-  // シンボルの読み込み
-  read_symbols();
-
-  return true;
-}
-
-// @brief aag ヘッダ行を読み込む．
-bool
-AigParser::read_aag_header(
-  SizeType& M,
-  SizeType& I,
-  SizeType& L,
-  SizeType& O,
-  SizeType& A
-)
-{
-  string linebuf;
-  if ( !read_line(linebuf) ) {
+  // AND部分の読み込み
+  if ( !read_aig_and() ) {
     return false;
   }
-  if ( linebuf.substr(0, 3) != string{"aag"} ) {
-    ostringstream buf;
-    buf << linebuf << ": Illegal header signature, 'aag' expected.";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    FileRegion{mFileInfo, mLineNo, 1, mLineNo, mLastCol},
-		    MsgType::Error, "AIG_PARSER", buf.str());
+
+  if ( !set_outputs() ) {
     return false;
   }
-  istringstream tmp{linebuf.substr(4, string::npos)};
-  tmp >> M >> I >> L >> O >> A;
 
-  if ( debug ) {
-    cout << "aag " << M
-	 << " " << I
-	 << " " << L
-	 << " " << O
-	 << " " << A << endl;
+  // シンボルテーブルとコメントの読み込みを行う．
+  if ( !read_symbols() ) {
+    return false;
   }
 
+  mProgress.finish(mModel.node_num());
+  mModel.make_logic_list();
+
   return true;
 }
 
-// @brief ファイルを開く
+// @brief ヘッダ行を読み込む．
 bool
-AigParser::open(
-  const string& filename
+AigParser::read_header(
+  const char* signature
 )
 {
-  mS = new ifstream{filename};
-  if ( !*mS ) {
-    ostringstream buf;
-    buf << filename << ": No such file";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    MsgType::Failure, "AIG_PARSER", buf.str());
-    delete mS;
-    mS = nullptr;
+  if ( mEnd - mCur < 4 ||
+       strncmp(mCur, signature, 3) != 0 ||
+       !is_space(mCur[3]) ) {
+    std::ostringstream buf;
+    buf << "Illegal header signature, '" << signature << "' expected.";
+    error(buf.str());
     return false;
   }
-  mFileInfo = FileInfo{filename};
-  mLineNo = 0;
-  mLastCol = 0;
-  return true;
-}
+  mCur += 3;
 
-// @brief aig ヘッダ行を読み込む．
-bool
-AigParser::read_aig_header(
-  SizeType& M,
-  SizeType& I,
-  SizeType& L,
-  SizeType& O,
-  SizeType& A
-)
-{
-  string linebuf;
-  if ( !read_line(linebuf) ) {
+  if ( !read_number(mM) ||
+       !read_number(mI) ||
+       !read_number(mL) ||
+       !read_number(mO) ||
+       !read_number(mA) ) {
     return false;
   }
-  if ( linebuf.substr(0, 3) != string{"aig"} ) {
-    ostringstream buf;
-    buf << linebuf << ": Illegal header signature, 'aig' expected.";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    FileRegion{mFileInfo, mLineNo, 1, mLineNo, mLastCol},
-		    MsgType::Error, "AIG_PARSER", buf.str());
+
+  // AIGER 1.9 の拡張部分
+  SizeType ext[4] = {0, 0, 0, 0};
+  for ( SizeType i = 0; i < 4 && has_number(); ++ i ) {
+    if ( !read_number(ext[i]) ) {
+      return false;
+    }
+  }
+  mB = ext[0];
+  mC = ext[1];
+  if ( ext[2] > 0 || ext[3] > 0 ) {
+    error("Justice and fairness properties are not supported.");
     return false;
   }
-  istringstream tmp{linebuf.substr(4, string::npos)};
-  tmp >> M >> I >> L >> O >> A;
 
-  if ( M != (I + L + A) ) {
-    ostringstream buf;
-    buf << linebuf << ": wrong parameters";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    FileRegion{mFileInfo, mLineNo, 1, mLineNo, mLastCol},
-		    MsgType::Error, "AIG_PARSER", buf.str());
-    return false;
+  return read_eol();
+}
+
+// @brief 初期化する．
+void
+AigParser::initialize()
+{
+  // ノード数の上限は 定数 + 変数 + 出力の反転
+  mModel.reserve(mM + mO + mB + mC + mL + 2);
+  mVarMap.clear();
+  mVarMap.resize(mM + 1, NO_NODE);
+  mInvMap.clear();
+  mInvMap.resize(mM + 1, NO_NODE);
+  mNextList.clear();
+  mNextList.reserve(mL);
+  mOutputList.clear();
+  mOutputList.reserve(mO + mB + mC);
+  mAndArray.clear();
+  for ( auto& func_id: mAndFunc ) {
+    func_id = BAD_ID;
+  }
+  mConst0 = BAD_ID;
+  mConst1 = BAD_ID;
+}
+
+// @brief aag の AND 行を読み込んでノードを作る．
+bool
+AigParser::read_aag_and()
+{
+  std::vector<SizeType> and_list;
+  and_list.reserve(mA);
+  for ( SizeType i = 0; i < mA; ++ i ) {
+    mProgress.update(mCur - mBegin, mModel.node_num());
+    SizeType lit;
+    SizeType lit0;
+    SizeType lit1;
+    if ( !read_number(lit) ||
+	 !read_number(lit0) ||
+	 !read_number(lit1) ) {
+      return false;
+    }
+    if ( !check_def(lit) || !check_range(lit0) || !check_range(lit1) ) {
+      return false;
+    }
+    auto var = lit / 2;
+    mAndArray[var] = AndInfo{lit0, lit1, mLineNo};
+    and_list.push_back(var);
+    if ( !read_eol() ) {
+      return false;
+    }
   }
 
-  if ( debug ) {
-    cout << "aag " << M
-	 << " " << I
-	 << " " << L
-	 << " " << O
-	 << " " << A << endl;
+  // aag では AND 行の順番に制約がないので
+  // ファンインから先にノードを作る．
+  // 0: 未処理, 1: 処理中, 2: 処理済み
+  std::vector<std::uint8_t> state(mM + 1, 0);
+  std::vector<SizeType> stack;
+  for ( auto root: and_list ) {
+    if ( state[root] == 2 ) {
+      continue;
+    }
+    stack.push_back(root);
+    while ( !stack.empty() ) {
+      auto var = stack.back();
+      if ( state[var] == 0 ) {
+	state[var] = 1;
+	auto& info = mAndArray[var];
+	for ( auto lit: {info.lit0, info.lit1} ) {
+	  auto ivar = lit / 2;
+	  if ( ivar == 0 || mVarMap[ivar] != NO_NODE ) {
+	    continue;
+	  }
+	  if ( mAndArray[ivar].line == 0 ) {
+	    std::ostringstream buf;
+	    buf << lit << ": Undefined literal.";
+	    MsgQueue::output(__FILE__, __LINE__,
+			     FileRegion{mFileInfo, info.line, 1, info.line, 1},
+			     MsgType::Error, "AIG_PARSER", buf.str());
+	    return false;
+	  }
+	  if ( state[ivar] == 1 ) {
+	    std::ostringstream buf;
+	    buf << (var * 2) << ": Combinational loop detected.";
+	    MsgQueue::output(__FILE__, __LINE__,
+			     FileRegion{mFileInfo, info.line, 1, info.line, 1},
+			     MsgType::Error, "AIG_PARSER", buf.str());
+	    return false;
+	  }
+	  stack.push_back(ivar);
+	}
+      }
+      else {
+	if ( state[var] == 1 ) {
+	  auto& info = mAndArray[var];
+	  new_and(var, info.lit0, info.lit1);
+	  state[var] = 2;
+	}
+	stack.pop_back();
+      }
+    }
   }
 
   return true;
 }
 
-// @brief 内容を初期化する．
-void
-AigParser::initialize(
-  SizeType M,
-  SizeType I,
-  SizeType O,
-  ModelImpl* model
-)
+// @brief aig の AND 部分を読み込んでノードを作る．
+bool
+AigParser::read_aig_and()
 {
-  for ( SizeType i = 0; i < M; ++ i ) {
-    // これで id 番号が一致するはず．
-    model->alloc_node();
-  }
-  mModel = model;
-  mDefined = vector<bool>(M, false);
-  mConst0 = -1;
-  mConst1 = -1;
-  mInvDict.clear();
+  // AND の出力は暗黙に 2(I + L + 1), ... となっていて，
+  // 入力のリテラルとの差分が符号化されている．
+  // lhs > rhs0 >= rhs1 が保証されているので
+  // ファンインは必ず作られている．
+  auto var = mI + mL + 1;
+  for ( SizeType i = 0; i < mA; ++ i, ++ var ) {
+    mProgress.update(mCur - mBegin, mModel.node_num());
+    SizeType lhs = var * 2;
+    SizeType delta0;
+    SizeType delta1;
+    if ( !read_delta(delta0) || !read_delta(delta1) ) {
+      error("Unexpected EOF in the AND section.");
+      return false;
+    }
+    if ( delta0 == 0 || delta0 > lhs || delta1 > lhs - delta0 ) {
+      std::ostringstream buf;
+      buf << "AND#" << i << ": Illegal delta value.";
+      error(buf.str());
+      return false;
+    }
+    auto lit0 = lhs - delta0;
+    auto lit1 = lit0 - delta1;
+    new_and(var, lit0, lit1);
+  }
+
+  // 以降はテキスト
+  mLineBegin = mCur;
+  return true;
 }
 
-// @brief aag の入力行の読み込み
+// @brief 出力と DFF の入力を設定する．
 bool
-AigParser::read_input(
-  SizeType& id
-)
+AigParser::set_outputs()
 {
-  string linebuf;
-  if ( !read_line(linebuf) ) {
-    return false;
+  for ( SizeType i = 0; i < mL; ++ i ) {
+    auto lit = mNextList[i];
+    auto var = lit / 2;
+    if ( var > 0 && mVarMap[var] == NO_NODE ) {
+      std::ostringstream buf;
+      buf << lit << ": Undefined literal required by Latch#" << i << ".";
+      error(buf.str());
+      return false;
+    }
+    mModel.set_dff_src(i, lit2node(lit));
   }
 
-  istringstream tmp{linebuf};
-  SizeType lit;
-  tmp >> lit;
-
-  if ( !set_defined(lit) ) {
-    return false;
+  for ( SizeType i = 0; i < mOutputList.size(); ++ i ) {
+    auto lit = mOutputList[i];
+    auto var = lit / 2;
+    if ( var > 0 && mVarMap[var] == NO_NODE ) {
+      std::ostringstream buf;
+      buf << lit << ": Undefined literal required by Output#" << i << ".";
+      error(buf.str());
+      return false;
+    }
+    mModel.new_output(lit2node(lit));
   }
-  bool dummy;
-  id = lit2node(lit, dummy);
+
   return true;
 }
 
-// @brief aag のラッチ行の読み込み
+// @brief シンボルテーブルとコメントを読み込む．
 bool
-AigParser::read_latch(
-  SizeType& id,
-  SizeType& src
-)
+AigParser::read_symbols()
 {
-  string linebuf;
-  if ( !read_line(linebuf) ) {
-    return false;
-  }
+  while ( mCur != mEnd ) {
+    // 行末を探す．
+    auto p = static_cast<const char*>(memchr(mCur, '\n', mEnd - mCur));
+    auto next = p == nullptr ? mEnd : p + 1;
+    auto tail = p == nullptr ? mEnd : p;
+    if ( tail > mCur && *(tail - 1) == '\r' ) {
+      -- tail;
+    }
 
-  istringstream tmp{linebuf};
-  SizeType lit;
-  tmp >> lit >> src;
+    auto prefix = *mCur;
+    if ( prefix == 'c' && (tail - mCur) == 1 ) {
+      // コメントの開始
+      // 以降は全てコメントとみなす．
+      mCur = next;
+      while ( mCur != mEnd ) {
+	auto p = static_cast<const char*>(memchr(mCur, '\n', mEnd - mCur));
+	auto tail = p == nullptr ? mEnd : p;
+	auto next = p == nullptr ? mEnd : p + 1;
+	if ( tail > mCur && *(tail - 1) == '\r' ) {
+	  -- tail;
+	}
+	mModel.add_comment(std::string{mCur, tail});
+	mCur = next;
+      }
+      break;
+    }
 
-  if ( !set_defined(lit) ) {
-    return false;
+    if ( tail == mCur ) {
+      // 空行は読み飛ばす．
+      mCur = next;
+      mLineBegin = mCur;
+      ++ mLineNo;
+      continue;
+    }
+
+    // <prefix><pos> <name>
+    auto q = mCur + 1;
+    SizeType pos = 0;
+    if ( q == tail || !is_digit(*q) ) {
+      error("Illegal symbol table entry.");
+      return false;
+    }
+    for ( ; q != tail && is_digit(*q); ++ q ) {
+      pos = pos * 10 + (*q - '0');
+    }
+    if ( q == tail || *q != ' ' ) {
+      error("Illegal symbol table entry.");
+      return false;
+    }
+    std::string name{q + 1, tail};
+
+    SizeType limit = 0;
+    switch ( prefix ) {
+    case 'i': limit = mI; break;
+    case 'l': limit = mL; break;
+    case 'o': limit = mO; break;
+    case 'b': limit = mB; break;
+    case 'c': limit = mC; break;
+    default:
+      {
+	std::ostringstream buf;
+	buf << prefix << ": Illegal symbol prefix.";
+	error(buf.str());
+	return false;
+      }
+    }
+    if ( pos >= limit ) {
+      std::ostringstream buf;
+      buf << prefix << pos << ": Symbol position is out of range.";
+      error(buf.str());
+      return false;
+    }
+
+    switch ( prefix ) {
+    case 'i': mModel.set_input_name(pos, name); break;
+    case 'l': mModel.set_dff_name(pos, name); break;
+    case 'o': mModel.set_output_name(pos, name); break;
+    case 'b': mModel.set_output_name(mO + pos, name); break;
+    case 'c': mModel.set_output_name(mO + mB + pos, name); break;
+    }
+
+    mCur = next;
+    mLineBegin = mCur;
+    ++ mLineNo;
   }
-  bool dummy;
-  id = lit2node(lit, dummy);
   return true;
 }
 
-// @brief aag の出力行の読み込み
+// @brief 入力ノードを作る．
 bool
-AigParser::read_src(
-  SizeType& src
+AigParser::new_input(
+  SizeType lit
 )
 {
-  string linebuf;
-  if ( !read_line(linebuf) ) {
+  if ( !check_def(lit) ) {
     return false;
   }
-
-  istringstream tmp{linebuf};
-  tmp >> src;
+  mVarMap[lit / 2] = mModel.new_input();
   return true;
 }
 
-// @brief aag のAND行の読み込み
+// @brief ラッチを作る．
 bool
-AigParser::read_and(
-  SizeType& id,
-  SizeType& src0,
-  SizeType& src1
+AigParser::new_latch(
+  SizeType lit,
+  SizeType next,
+  SizeType reset
 )
 {
-  string linebuf;
-  if ( !read_line(linebuf) ) {
+  if ( !check_def(lit) || !check_range(next) ) {
     return false;
   }
-
-  istringstream tmp{linebuf};
-  SizeType lit;
-  tmp >> lit >> src0 >> src1;
-
-  if ( !set_defined(lit) ) {
+  char rval;
+  if ( reset == 0 ) {
+    rval = '0';
+  }
+  else if ( reset == 1 ) {
+    rval = '1';
+  }
+  else if ( reset == lit ) {
+    // 不定値
+    rval = 'X';
+  }
+  else {
+    std::ostringstream buf;
+    buf << reset << ": Illegal reset value.";
+    error(buf.str());
     return false;
   }
-  bool dummy;
-  id = lit2node(lit, dummy);
+  auto dff_id = mModel.new_dff({}, rval);
+  mVarMap[lit / 2] = mModel.new_dff_output(dff_id);
+  mNextList.push_back(next);
   return true;
 }
 
-// @brief 数字を一つ読み出す．
-SizeType
-AigParser::read_number()
+// @brief リテラルが新たに定義可能か調べる．
+bool
+AigParser::check_def(
+  SizeType lit
+)
 {
-  SizeType num = 0;
-  for ( SizeType weight = 1; ; weight *= 128 ) {
-    SizeType c = mS->get();
-    num += (c & 127) * weight;
-    if ( (c & 128) == 0 ) {
-      break;
-    }
+  if ( (lit % 2) == 1 ) {
+    error("Positive literal(even number) expected.");
+    return false;
   }
-  return num;
-}
-
-// @brief シンボルテーブルとコメントを読み込む．
-void
-AigParser::read_symbols()
-{
-  string linebuf;
-  string comment;
-  bool symbol_mode = true;
-  while ( getline(*mS, linebuf) ) {
-    if ( symbol_mode ) {
-      if ( linebuf == "c" ) {
-	symbol_mode = false;
-      }
-      else {
-	auto p = linebuf.find_first_of(" ");
-	auto pos_str = linebuf.substr(0, p);
-	auto name = linebuf.substr(p + 1, string::npos);
-	SizeType pos = atoi(pos_str.substr(1, string::npos).c_str());
-	ostringstream buf;
-	buf << pos;
-	char prefix = pos_str[0];
-	if ( prefix == 'i' ) {
-	  mModel->set_input_name(pos, name);
-	}
-	else if ( prefix == 'l' ) {
-	  mModel->set_output_name(pos, name);
-	}
-	else if ( prefix == 'o' ) {
-	  mModel->set_seq_name(pos, name);
-	}
-	else {
-	  ostringstream buf;
-	  buf << prefix << ": Illegal prefix";
-	  throw std::invalid_argument{buf.str()};
-	}
-      }
-    }
-    else {
-      comment += linebuf + '\n';
-    }
+  if ( lit <= 1 ) {
+    error("Unexpected constant literal.");
+    return false;
+  }
+  if ( !check_range(lit) ) {
+    return false;
+  }
+  auto var = lit / 2;
+  if ( mVarMap[var] != NO_NODE ||
+       (!mAndArray.empty() && mAndArray[var].line > 0) ) {
+    std::ostringstream buf;
+    buf << lit << ": Defined more than once.";
+    error(buf.str());
+    return false;
   }
-  mModel->set_comment(comment);
+  return true;
 }
 
-// @brief 1行読み出す．
+// @brief リテラルが範囲内に収まっているか調べる．
 bool
-AigParser::read_line(
-  string& buf
+AigParser::check_range(
+  SizeType lit
 )
 {
-  ++ mLineNo;
-  if ( !getline(*mS, buf) ) {
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    FileRegion{mFileInfo, mLineNo, 1, mLineNo, 1},
-		    MsgType::Error, "AIG_PARSER", "Unexpected EOF");
+  if ( (lit / 2) > mM ) {
+    std::ostringstream buf;
+    buf << lit << ": Literal is out of range.";
+    error(buf.str());
     return false;
   }
-  mLastCol = buf.size();
   return true;
 }
 
-// @brief リテラルを定義済みにする．
+// @brief 10進数を一つ読み出す．
 bool
-AigParser:: set_defined(
-  SizeType lit
+AigParser::read_number(
+  SizeType& num
 )
 {
-  if ( (lit % 2) == 1 ) {
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    FileRegion{mFileInfo, mLineNo, 1, mLineNo, mLastCol},
-		    MsgType::Error, "AIG_PARSER",
-		    "Positive Literal(even number) expected");
-    return false;
+  while ( mCur != mEnd && is_space(*mCur) ) {
+    ++ mCur;
   }
-  if ( lit <= 1 ) {
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    FileRegion{mFileInfo, mLineNo, 1, mLineNo, mLastCol},
-		    MsgType::Error, "AIG_PARSER",
-		    "Unexpected constant literal");
+  if ( mCur == mEnd ) {
+    error("Unexpected EOF.");
     return false;
   }
-
-  SizeType id = (lit / 2) - 1;
-  if ( mDefined[id] ) {
-    ostringstream buf;
-    buf << id << " is already defined.";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    FileRegion{mFileInfo, mLineNo, 1, mLineNo, mLastCol},
-		    MsgType::Error, "AIG_PARSER", buf.str());
+  if ( !is_digit(*mCur) ) {
+    error("Number expected.");
     return false;
   }
-  mDefined[id] = true;
+  SizeType val = 0;
+  for ( ; mCur != mEnd && is_digit(*mCur); ++ mCur ) {
+    val = val * 10 + (*mCur - '0');
+  }
+  num = val;
   return true;
 }
 
-// @brief リテラルが定義済みか調べる．
+// @brief 行末を読み出す．
 bool
-AigParser::check_defined(
-  SizeType lit,
-  const string& ref
-)
+AigParser::read_eol()
 {
-  if ( lit <= 1 ) {
-    // 定数リテラルは常に定義されている．
+  while ( mCur != mEnd && is_space(*mCur) ) {
+    ++ mCur;
+  }
+  if ( mCur != mEnd && *mCur == '\r' ) {
+    ++ mCur;
+  }
+  if ( mCur == mEnd ) {
+    // 最後の行に改行がなくても許す．
     return true;
   }
-  auto id = (lit / 2) - 1;
-  if ( !mDefined[id] ) {
-    ostringstream buf;
-    buf << lit << " is not defined required by " << ref << ".";
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    FileRegion{mFileInfo, mLineNo, 1, mLineNo, mLastCol},
-		    MsgType::Error, "AIG_PARSER", buf.str());
+  if ( *mCur != '\n' ) {
+    error("Newline expected.");
+    return false;
   }
+  ++ mCur;
+  mLineBegin = mCur;
+  ++ mLineNo;
   return true;
 }
 
-// @brief リテラルからノードの情報を得る．
+// @brief 行末までに10進数が残っているか調べる．
+bool
+AigParser::has_number()
+{
+  while ( mCur != mEnd && is_space(*mCur) ) {
+    ++ mCur;
+  }
+  return mCur != mEnd && is_digit(*mCur);
+}
+
+// @brief AND 用の関数番号を返す．
 SizeType
-AigParser::lit2node(
-  SizeType lit,
-  bool& inv
+AigParser::and_func(
+  bool inv0,
+  bool inv1
 )
 {
-  inv = static_cast<bool>(lit & 1);
-  auto id = lit / 2;
-  if ( id == 0 ) {
-    // 定数0
-    return const0();
+  auto pos = (inv0 ? 2 : 0) + (inv1 ? 1 : 0);
+  auto& func_id = mAndFunc[pos];
+  if ( func_id == BAD_ID ) {
+    if ( !inv0 && !inv1 ) {
+      func_id = mModel.reg_primitive(2, PrimType::And);
+    }
+    else if ( inv0 && inv1 ) {
+      func_id = mModel.reg_primitive(2, PrimType::Nor);
+    }
+    else {
+      auto lit0 = Literal{0, inv0};
+      auto lit1 = Literal{1, inv1};
+      auto cover = SopCover(2, {{lit0, lit1}});
+      func_id = mModel.reg_cover(cover, false);
+    }
   }
-  return id - 1;
+  return func_id;
+}
+
+// @brief AND ノードを作る．
+void
+AigParser::new_and(
+  SizeType var,
+  SizeType lit0,
+  SizeType lit1
+)
+{
+  // 定数は定数0ノードと反転属性で表す．
+  auto var0 = lit0 / 2;
+  auto var1 = lit1 / 2;
+  BnIdType id0 = var0 == 0 ? const0() : mVarMap[var0];
+  BnIdType id1 = var1 == 0 ? const0() : mVarMap[var1];
+  auto func_id = and_func(lit0 & 1, lit1 & 1);
+  mVarMap[var] = mModel.new_logic(func_id, std::vector<BnIdType>{id0, id1});
 }
 
-// @brief リテラルからノードの情報を得る．
+// @brief リテラルに対応するノード番号を返す．
 SizeType
 AigParser::lit2node(
   SizeType lit
 )
 {
-  auto id = lit / 2;
+  auto var = lit / 2;
   bool inv = static_cast<bool>(lit & 1);
-  if ( id == 0 ) {
-    if ( inv ) {
-      // 定数1
-      return const1();
-    }
-    else {
-      // 定数0
-      return const0();
-    }
+  if ( var == 0 ) {
+    return inv ? const1() : const0();
   }
-  auto node_id = id - 1;
-  if ( inv ) {
-    if ( mInvDict.count(node_id) > 0 ) {
-      return mInvDict.at(node_id);
-    }
-    auto inv_id = mModel->new_primitive({node_id}, PrimType::Not);
-    mInvDict.emplace(node_id, inv_id);
-    return inv_id;
+  auto id = mVarMap[var];
+  if ( !inv ) {
+    return id;
+  }
+  if ( mInvMap[var] == NO_NODE ) {
+    auto func_id = mModel.reg_primitive(1, PrimType::Not);
+    mInvMap[var] = mModel.new_logic(func_id, std::vector<BnIdType>{id});
   }
-  return node_id;
+  return mInvMap[var];
 }
 
 // @brief 定数0ノードを返す．
 SizeType
 AigParser::const0()
 {
-  if ( mConst0 == -1 ) {
-    mConst0 = mModel->new_primitive({}, PrimType::C0);
+  if ( mConst0 == BAD_ID ) {
+    auto func_id = mModel.reg_primitive(0, PrimType::C0);
+    mConst0 = mModel.new_logic(func_id, std::vector<BnIdType>{});
   }
   return mConst0;
 }
@@ -701,10 +827,21 @@ AigParser::const0()
 SizeType
 AigParser::const1()
 {
-  if ( mConst1 == -1 ) {
-    mConst1 = mModel->new_primitive({}, PrimType::C1);
+  if ( mConst1 == BAD_ID ) {
+    auto func_id = mModel.reg_primitive(0, PrimType::C1);
+    mConst1 = mModel.new_logic(func_id, std::vector<BnIdType>{});
   }
   return mConst1;
 }
 
+// @brief エラーメッセージを出力する．
+void
+AigParser::error(
+  const std::string& msg
+)
+{
+  MsgQueue::output(__FILE__, __LINE__, cur_loc(),
+		   MsgType::Error, "AIG_PARSER", msg);
+}
+
 END_NAMESPACE_YM_BN
@@ -10,22 +10,37 @@
 
 #include "ym/bn.h"
 #include "ym/FileInfo.h"
+#include "ym/FileRegion.h"
+#include "ModelImpl.h"
+#include "ReadOption.h"
+#include "ProgressReporter.h"
 
 
 BEGIN_NAMESPACE_YM_BN
 
-class ModelImpl;
-
 //////////////////////////////////////////////////////////////////////
 /// @class AigParser AigParser.h "AigParser.h"
-/// @brief AIG 形式のファイルを読むためのクラス
+/// @brief AIGER 形式のファイルを読むためのクラス
+///
+/// ファイルの内容はメモリ上に展開(mmap)したバッファから直接読み出す．
+/// ヘッダの M I L O A の値でノード用の領域をあらかじめ確保しておく．
+///
+/// - 入力は外部入力ノードになる．
+/// - ラッチは DFF になる．リセット値は AIGER 1.9 の初期値
+///   (0, 1, 不定)をそれぞれ '0', '1', 'X' に対応させる．
+/// - AND は2入力の論理ノードになる．入力の反転属性は関数の種類で表す．
+/// - 出力とラッチの入力の反転属性は NOT ノードで表す．
+/// - bad state(B) と invariant constraint(C) は出力の後ろに順に追加する．
+/// - justice(J) と fairness(F) には対応していない．
 //////////////////////////////////////////////////////////////////////
 class AigParser
 {
 public:
 
   /// @brief コンストラクタ
-  AigParser() = default;
+  AigParser(
+    ModelImpl& model ///< [in] 結果を格納するオブジェクト
+  );
 
   /// @brief デストラクタ
   ~AigParser() = default;
@@ -41,20 +56,16 @@ public:
   /// @return 読み込みが成功したら true を返す．
   bool
   read_aag(
-    const string& filename,   ///< [in] ファイル名
-    const string& clock_name, ///< [in] クロック入力の名前
-    const string& reset_name, ///< [in] リセット入力の名前
-    ModelImpl* model          ///< [out] 結果を格納するオブジェクト
+    const std::string& filename,            ///< [in] ファイル名
+    const ReadOption& option = ReadOption{} ///< [in] 読み込みオプション
   );
 
   /// @brief AIG フォーマットを読み込む．
   /// @return 読み込みが成功したら true を返す．
   bool
   read_aig(
-    const string& filename,   ///< [in] ファイル名
-    const string& clock_name, ///< [in] クロック入力の名前
-    const string& reset_name, ///< [in] リセット入力の名前
-    ModelImpl* model          ///< [out] 結果を格納するオブジェクト
+    const std::string& filename,            ///< [in] ファイル名
+    const ReadOption& option = ReadOption{} ///< [in] 読み込みオプション
   );
 
   /// @}
@@ -66,109 +77,121 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief ファイルを開く
+  /// @brief ヘッダ行を読み込む．
+  ///
+  /// 結果は mM, mI, mL, mO, mA, mB, mC に格納される．
   bool
-  open(
-    const string& filename ///< [in] ファイル名
+  read_header(
+    const char* signature ///< [in] 先頭の識別子("aag" or "aig")
   );
 
-  /// @brief aag ヘッダ行を読み込む．
+  /// @brief 初期化する．
+  void
+  initialize();
+
+  /// @brief aag の AND 行を読み込んでノードを作る．
   bool
-  read_aag_header(
-    SizeType& M,
-    SizeType& I,
-    SizeType& L,
-    SizeType& O,
-    SizeType& A
-  );
+  read_aag_and();
 
-  /// @brief aig ヘッダ行を読み込む．
+  /// @brief aig の AND 部分を読み込んでノードを作る．
   bool
-  read_aig_header(
-    SizeType& M,
-    SizeType& I,
-    SizeType& L,
-    SizeType& O,
-    SizeType& A
-  );
+  read_aig_and();
 
-  /// @brief 初期化する．
-  void
-  initialize(
-    SizeType M,      ///< [in] 総ノード数
-    SizeType I,      ///< [in] 入力数
-    SizeType O,      ///< [in] 出力数
-    ModelImpl* model ///< [in] 結果を格納するオブジェクト
-  );
+  /// @brief 出力と DFF の入力を設定する．
+  bool
+  set_outputs();
 
-  /// @brief aag の入力行の読み込み
+  /// @brief シンボルテーブルとコメントを読み込む．
   bool
-  read_input(
-    SizeType& id ///< [out] 結果のIDを格納するオブジェクト
-  );
+  read_symbols();
 
-  /// @brief aag のラッチ行の読み込み
+  /// @brief 入力ノードを作る．
   bool
-  read_latch(
-    SizeType& id,  ///< [out] 結果のIDを格納するオブジェクト
-    SizeType& src  ///< [out] 結果のソースリテラルを格納するオブジェクト
+  new_input(
+    SizeType lit ///< [in] リテラル
   );
 
-  /// @brief aag の出力行/aig のラッチ行の読み込み
+  /// @brief ラッチを作る．
   bool
-  read_src(
-    SizeType& src ///< [out] 結果のソースリテラルを格納するオブジェクト
+  new_latch(
+    SizeType lit,  ///< [in] リテラル
+    SizeType next, ///< [in] 次状態のリテラル
+    SizeType reset ///< [in] 初期値を表すリテラル
   );
 
-  /// @brief aag のAND行の読み込み
+  /// @brief リテラルが新たに定義可能か調べる．
+  ///
+  /// このリテラルは正のリテラルである必要がある．
   bool
-  read_and(
-    SizeType& id,   ///< [out] 結果のIDを格納するオブジェクト
-    SizeType& src0, ///< [out] 結果のソースリテラル0を格納するオブジェクト
-    SizeType& src1  ///< [out] 結果のソースリテラル1を格納するオブジェクト
+  check_def(
+    SizeType lit ///< [in] リテラル
   );
 
-  /// @brief aig の数字の読み込み
-  SizeType
-  read_number();
-
-  /// @brief シンボルテーブルとコメントを読み込む．
-  void
-  read_symbols();
-
-  /// @brief 1行読み出す．
+  /// @brief リテラルが範囲内に収まっているか調べる．
   bool
-  read_line(
-    string& buf  ///< [out] 結果を格納するオブジェクト
+  check_range(
+    SizeType lit ///< [in] リテラル
   );
 
-  /// @brief リテラルを定義済みにする．
+  /// @brief 10進数を一つ読み出す．
   ///
-  /// このリテラルは正のリテラルである必要がある．
+  /// 先頭の空白は読み飛ばす．
   bool
-  set_defined(
-    SizeType lit ///< [in] リテラル
+  read_number(
+    SizeType& num ///< [out] 結果を格納する変数
   );
 
-  /// @brief リテラルが定義済みか調べる．
+  /// @brief 行末を読み出す．
   bool
-  check_defined(
-    SizeType lit,     ///< [in] リテラル
-    const string& ref ///< [in] このリテラルを参照しているオブジェクト名
-  );
+  read_eol();
 
-  /// @brief リテラルからノードの情報を得る．
+  /// @brief 行末までに10進数が残っているか調べる．
   ///
-  /// 通常は2で割って1引くだけだが，定数の場合定数ノードを返す．
+  /// 先頭の空白は読み飛ばす．
+  /// ラッチ行の省略可能な初期値などの読み込みに用いる．
+  bool
+  has_number();
+
+  /// @brief aig の AND の差分を一つ読み出す．
+  bool
+  read_delta(
+    SizeType& delta ///< [out] 結果を格納する変数
+  )
+  {
+    SizeType num = 0;
+    for ( SizeType shift = 0; ; shift += 7 ) {
+      if ( mCur == mEnd || shift > 28 ) {
+	return false;
+      }
+      auto c = static_cast<unsigned char>(*mCur);
+      ++ mCur;
+      num |= static_cast<SizeType>(c & 0x7f) << shift;
+      if ( (c & 0x80) == 0 ) {
+	break;
+      }
+    }
+    delta = num;
+    return true;
+  }
+
+  /// @brief AND 用の関数番号を返す．
   SizeType
-  lit2node(
-    SizeType lit, ///< [in] リテラル
-    bool& inv     ///< [out] 反転属性
+  and_func(
+    bool inv0, ///< [in] 入力0の反転属性
+    bool inv1  ///< [in] 入力1の反転属性
+  );
+
+  /// @brief AND ノードを作る．
+  void
+  new_and(
+    SizeType var,  ///< [in] 変数番号
+    SizeType lit0, ///< [in] 入力0のリテラル
+    SizeType lit1  ///< [in] 入力1のリテラル
   );
 
-  /// @brief リテラルからノードの情報を得る．
+  /// @brief リテラルに対応するノード番号を返す．
   ///
-  /// こちらは反転属性を使わないバージョン
+  /// 負のリテラルの場合には NOT ノードを作る．
   SizeType
   lit2node(
     SizeType lit ///< [in] リテラル
@@ -182,38 +205,108 @@ private:
   SizeType
   const1();
 
+  /// @brief 現在の位置を返す．
+  FileRegion
+  cur_loc() const
+  {
+    int column = mCur - mLineBegin + 1;
+    return FileRegion{mFileInfo, mLineNo, column, mLineNo, column};
+  }
+
+  /// @brief エラーメッセージを出力する．
+  void
+  error(
+    const std::string& msg ///< [in] メッセージ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  // aag の AND 行の情報
+  struct AndInfo
+  {
+    SizeType lit0; ///< 入力0のリテラル
+    SizeType lit1; ///< 入力1のリテラル
+    int line;      ///< 行番号
+  };
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 入力ストリーム
-  istream* mS{nullptr};
+  // 対象のモデル
+  ModelImpl& mModel;
 
   // ファイルの情報
   FileInfo mFileInfo;
 
+  // バッファの先頭
+  const char* mBegin{nullptr};
+
+  // 現在の読み出し位置
+  const char* mCur{nullptr};
+
+  // バッファの末尾
+  const char* mEnd{nullptr};
+
+  // 現在の行の先頭
+  const char* mLineBegin{nullptr};
+
   // 現在の行番号
-  int mLineNo;
+  int mLineNo{0};
 
-  // 右端のコラム
-  int mLastCol;
+  // 進捗の通知先
+  ProgressReporter mProgress;
 
-  // 対象のモデル
-  ModelImpl* mModel{nullptr};
+  // 最大変数番号
+  SizeType mM{0};
+
+  // 入力数
+  SizeType mI{0};
+
+  // ラッチ数
+  SizeType mL{0};
+
+  // 出力数
+  SizeType mO{0};
+
+  // AND数
+  SizeType mA{0};
 
-  // 定義済みノード番号の印
-  vector<bool> mDefined;
+  // bad state 数
+  SizeType mB{0};
+
+  // invariant constraint 数
+  SizeType mC{0};
+
+  // 変数番号をキーにしてノード番号を格納する配列
+  std::vector<BnIdType> mVarMap;
+
+  // 変数番号をキーにして NOT ノードのノード番号を格納する配列
+  std::vector<BnIdType> mInvMap;
+
+  // ラッチの次状態のリテラルのリスト
+  std::vector<SizeType> mNextList;
+
+  // 出力(bad state, constraint を含む)のリテラルのリスト
+  std::vector<SizeType> mOutputList;
+
+  // 変数番号をキーにして aag の AND 行の情報を格納する配列
+  std::vector<AndInfo> mAndArray;
+
+  // AND 用の関数番号
+  SizeType mAndFunc[4];
 
   // 定数0のノード番号
-  SizeType mConst0;
+  SizeType mConst0{BAD_ID};
 
   // 定数1のノード番号
-  SizeType mConst1;
-
-  // 反転出力の辞書
-  unordered_map<SizeType, SizeType> mInvDict;
+  SizeType mConst1{BAD_ID};
 
 };
 
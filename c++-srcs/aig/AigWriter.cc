@@ -0,0 +1,497 @@
+
+/// @file AigWriter.cc
+/// @brief AigWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "AigWriter.h"
+#include "BufWriter.h"
+#include "FuncImpl.h"
+#include "ym/BnModel.h"
+#include "ym/SopCover.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/Bdd.h"
+#include "ym/BddVar.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// AIG の差分を符号化して出力する．
+inline
+void
+put_delta(
+  BufWriter& w,
+  SizeType delta
+)
+{
+  while ( delta & ~0x7f ) {
+    w.put(static_cast<char>((delta & 0x7f) | 0x80));
+    delta >>= 7;
+  }
+  w.put(static_cast<char>(delta));
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief aag(ASCII AIGER) 形式で出力する．
+void
+BnModel::write_aag(
+  std::ostream& s
+) const
+{
+  AigWriter writer{_model_impl()};
+  writer.write_aag(s);
+}
+
+// @brief aag(ASCII AIGER) 形式でファイルに出力する．
+void
+BnModel::write_aag(
+  const std::string& filename
+) const
+{
+  write_file(filename, "write_aag",
+	     [&](std::ostream& s){ write_aag(s); });
+}
+
+// @brief aig(バイナリ AIGER) 形式で出力する．
+void
+BnModel::write_aig(
+  std::ostream& s
+) const
+{
+  AigWriter writer{_model_impl()};
+  writer.write_aig(s);
+}
+
+// @brief aig(バイナリ AIGER) 形式でファイルに出力する．
+void
+BnModel::write_aig(
+  const std::string& filename
+) const
+{
+  write_file(filename, "write_aig",
+	     [&](std::ostream& s){ write_aig(s); });
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+AigWriter::AigWriter(
+  const ModelImpl& model
+) : mModel{model},
+    mBaseVar{model.input_num() + model.dff_num() + 1}
+{
+  make_aig();
+}
+
+// @brief Ascii AIG フォーマットで出力する．
+void
+AigWriter::write_aag(
+  std::ostream& s
+)
+{
+  BufWriter w{s};
+
+  auto I = mModel.input_num();
+  auto L = mModel.dff_num();
+  auto O = mOutputList.size();
+  auto A = mAndList.size();
+  auto M = I + L + A;
+  w.put("aag ");
+  w.put_num(M);
+  w.put(' ');
+  w.put_num(I);
+  w.put(' ');
+  w.put_num(L);
+  w.put(' ');
+  w.put_num(O);
+  w.put(' ');
+  w.put_num(A);
+  w.put('\n');
+
+  for ( SizeType i = 0; i < I; ++ i ) {
+    w.put_num((i + 1) * 2);
+    w.put('\n');
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto lit = (I + i + 1) * 2;
+    w.put_num(lit);
+    w.put(' ');
+    w.put_num(mNextList[i]);
+    write_reset(w, i, lit);
+    w.put('\n');
+  }
+  for ( auto lit: mOutputList ) {
+    w.put_num(lit);
+    w.put('\n');
+  }
+  auto lhs = mBaseVar * 2;
+  for ( auto& p: mAndList ) {
+    w.put_num(lhs);
+    w.put(' ');
+    w.put_num(p.first);
+    w.put(' ');
+    w.put_num(p.second);
+    w.put('\n');
+    lhs += 2;
+  }
+
+  write_symbols(w);
+}
+
+// @brief AIG フォーマットで出力する．
+void
+AigWriter::write_aig(
+  std::ostream& s
+)
+{
+  BufWriter w{s};
+
+  auto I = mModel.input_num();
+  auto L = mModel.dff_num();
+  auto O = mOutputList.size();
+  auto A = mAndList.size();
+  auto M = I + L + A;
+  w.put("aig ");
+  w.put_num(M);
+  w.put(' ');
+  w.put_num(I);
+  w.put(' ');
+  w.put_num(L);
+  w.put(' ');
+  w.put_num(O);
+  w.put(' ');
+  w.put_num(A);
+  w.put('\n');
+
+  // 入力とラッチの出力は暗黙に決まる．
+  for ( SizeType i = 0; i < L; ++ i ) {
+    w.put_num(mNextList[i]);
+    write_reset(w, i, (I + i + 1) * 2);
+    w.put('\n');
+  }
+  for ( auto lit: mOutputList ) {
+    w.put_num(lit);
+    w.put('\n');
+  }
+  auto lhs = mBaseVar * 2;
+  for ( auto& p: mAndList ) {
+    put_delta(w, lhs - p.first);
+    put_delta(w, p.first - p.second);
+    lhs += 2;
+  }
+
+  write_symbols(w);
+}
+
+// @brief AIG に分解する．
+void
+AigWriter::make_aig()
+{
+  auto n = mModel.node_num();
+  mNodeLit.clear();
+  mNodeLit.resize(n, BAD_ID);
+
+  auto I = mModel.input_num();
+  for ( SizeType i = 0; i < I; ++ i ) {
+    mNodeLit[mModel.input_id(i)] = (i + 1) * 2;
+  }
+  auto L = mModel.dff_num();
+  for ( SizeType i = 0; i < L; ++ i ) {
+    mNodeLit[mModel.dff_impl(i).id] = (I + i + 1) * 2;
+  }
+
+  // 論理ノードはトポロジカル順に並んでいる．
+  mAndList.clear();
+  mAndList.reserve(mModel.logic_num());
+  mAndDict.clear();
+  mAndDict.reserve(mModel.logic_num());
+  for ( auto id: mModel.logic_id_list() ) {
+    mNodeLit[id] = decomp_node(mModel.node_impl(id));
+  }
+
+  auto node_lit = [&](SizeType id) {
+    if ( id >= n || mNodeLit[id] == BAD_ID ) {
+      throw std::logic_error{"AigWriter: undefined node. wrap_up() may be required."};
+    }
+    return mNodeLit[id];
+  };
+
+  mNextList.clear();
+  mNextList.reserve(L);
+  for ( SizeType i = 0; i < L; ++ i ) {
+    mNextList.push_back(node_lit(mModel.dff_impl(i).src_id));
+  }
+
+  mOutputList.clear();
+  mOutputList.reserve(mModel.output_num());
+  for ( auto id: mModel.output_id_list() ) {
+    mOutputList.push_back(node_lit(id));
+  }
+}
+
+// @brief 論理ノードの関数を分解する．
+SizeType
+AigWriter::decomp_node(
+  const NodeImpl& node
+)
+{
+  std::vector<SizeType> lit_list;
+  lit_list.reserve(node.fanin_num());
+  for ( auto iid: node.fanin_id_list() ) {
+    auto lit = mNodeLit[iid];
+    if ( lit == BAD_ID ) {
+      throw std::logic_error{"AigWriter: undefined node. wrap_up() may be required."};
+    }
+    lit_list.push_back(lit);
+  }
+
+  auto& func = mModel.func_impl(node.func_id());
+  if ( func.is_primitive() ) {
+    return decomp_primitive(func.primitive_type(), lit_list);
+  }
+  if ( func.is_cover() ) {
+    return decomp_cover(func.input_cover(), func.output_inv(), lit_list);
+  }
+  if ( func.is_expr() ) {
+    return decomp_expr(func.expr(), lit_list);
+  }
+  if ( func.is_tvfunc() ) {
+    return decomp_tvfunc(func.tvfunc(), lit_list);
+  }
+  if ( func.is_bdd() ) {
+    // サポート変数の順番がファンインの順番に対応している．
+    auto bdd = func.bdd();
+    auto tvfunc = bdd.to_truth(bdd.get_support_list());
+    return decomp_tvfunc(tvfunc, lit_list);
+  }
+  throw std::logic_error{"AigWriter: unknown function type"};
+}
+
+// @brief プリミティブ型の関数を分解する．
+SizeType
+AigWriter::decomp_primitive(
+  PrimType primitive_type,
+  const std::vector<SizeType>& lit_list
+)
+{
+  auto tmp_list = lit_list;
+  auto and_op = [&](SizeType a, SizeType b) { return make_and(a, b); };
+  auto or_op = [&](SizeType a, SizeType b) { return make_or(a, b); };
+  auto xor_op = [&](SizeType a, SizeType b) { return make_xor(a, b); };
+  switch ( primitive_type ) {
+  case PrimType::C0:   return 0;
+  case PrimType::C1:   return 1;
+  case PrimType::Buff: return lit_list[0];
+  case PrimType::Not:  return lit_list[0] ^ 1;
+  case PrimType::And:  return make_tree(tmp_list, 1, and_op);
+  case PrimType::Nand: return make_tree(tmp_list, 1, and_op) ^ 1;
+  case PrimType::Or:   return make_tree(tmp_list, 0, or_op);
+  case PrimType::Nor:  return make_tree(tmp_list, 0, or_op) ^ 1;
+  case PrimType::Xor:  return make_tree(tmp_list, 0, xor_op);
+  case PrimType::Xnor: return make_tree(tmp_list, 0, xor_op) ^ 1;
+  default: break;
+  }
+  throw std::logic_error{"AigWriter: unexpected primitive type"};
+}
+
+// @brief カバー型の関数を分解する．
+SizeType
+AigWriter::decomp_cover(
+  const SopCover& cover,
+  bool output_inv,
+  const std::vector<SizeType>& lit_list
+)
+{
+  auto and_op = [&](SizeType a, SizeType b) { return make_and(a, b); };
+  auto or_op = [&](SizeType a, SizeType b) { return make_or(a, b); };
+  std::vector<SizeType> cube_lits;
+  cube_lits.reserve(cover.cube_num());
+  for ( auto& cube: cover.literal_list() ) {
+    std::vector<SizeType> tmp_list;
+    tmp_list.reserve(cube.size());
+    for ( auto lit: cube ) {
+      auto ilit = lit_list[lit.varid()];
+      tmp_list.push_back(lit.is_negative() ? ilit ^ 1 : ilit);
+    }
+    cube_lits.push_back(make_tree(tmp_list, 1, and_op));
+  }
+  auto olit = make_tree(cube_lits, 0, or_op);
+  return output_inv ? olit ^ 1 : olit;
+}
+
+// @brief 論理式型の関数を分解する．
+SizeType
+AigWriter::decomp_expr(
+  const Expr& expr,
+  const std::vector<SizeType>& lit_list
+)
+{
+  if ( expr.is_zero() ) {
+    return 0;
+  }
+  if ( expr.is_one() ) {
+    return 1;
+  }
+  if ( expr.is_posi_literal() ) {
+    return lit_list[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return lit_list[expr.varid()] ^ 1;
+  }
+  std::vector<SizeType> tmp_list;
+  tmp_list.reserve(expr.operand_num());
+  for ( auto& opr: expr.operand_list() ) {
+    tmp_list.push_back(decomp_expr(opr, lit_list));
+  }
+  if ( expr.is_and() ) {
+    auto op = [&](SizeType a, SizeType b) { return make_and(a, b); };
+    return make_tree(tmp_list, 1, op);
+  }
+  if ( expr.is_or() ) {
+    auto op = [&](SizeType a, SizeType b) { return make_or(a, b); };
+    return make_tree(tmp_list, 0, op);
+  }
+  if ( expr.is_xor() ) {
+    auto op = [&](SizeType a, SizeType b) { return make_xor(a, b); };
+    return make_tree(tmp_list, 0, op);
+  }
+  throw std::logic_error{"AigWriter: unexpected expression"};
+}
+
+// @brief 真理値表型の関数を分解する．
+SizeType
+AigWriter::decomp_tvfunc(
+  const TvFunc& func,
+  const std::vector<SizeType>& lit_list
+)
+{
+  return decomp_tvfunc_sub(func, lit_list, func.input_num(), 0);
+}
+
+// @brief decomp_tvfunc() の下請け関数
+SizeType
+AigWriter::decomp_tvfunc_sub(
+  const TvFunc& func,
+  const std::vector<SizeType>& lit_list,
+  SizeType var_num,
+  SizeType base
+)
+{
+  if ( var_num == 0 ) {
+    return func.value(base) ? 1 : 0;
+  }
+  auto var = var_num - 1;
+  auto lit0 = decomp_tvfunc_sub(func, lit_list, var, base);
+  auto lit1 = decomp_tvfunc_sub(func, lit_list, var, base + (SizeType{1} << var));
+  return make_mux(lit_list[var], lit1, lit0);
+}
+
+// @brief AND を作る．
+SizeType
+AigWriter::make_and(
+  SizeType lit0,
+  SizeType lit1
+)
+{
+  // lit0 >= lit1 に正規化する．
+  if ( lit0 < lit1 ) {
+    std::swap(lit0, lit1);
+  }
+  // 定数と同一/相補な入力の簡単化
+  if ( lit1 == 0 ) {
+    return 0;
+  }
+  if ( lit1 == 1 ) {
+    return lit0;
+  }
+  if ( lit0 == lit1 ) {
+    return lit0;
+  }
+  if ( lit0 == (lit1 ^ 1) ) {
+    return 0;
+  }
+
+  auto key = std::make_pair(lit0, lit1);
+  auto p = mAndDict.find(key);
+  if ( p != mAndDict.end() ) {
+    return p->second;
+  }
+  auto lhs = (mBaseVar + mAndList.size()) * 2;
+  mAndList.push_back(key);
+  mAndDict.emplace(key, lhs);
+  return lhs;
+}
+
+// @brief ラッチのリセット値を出力する．
+void
+AigWriter::write_reset(
+  BufWriter& w,
+  SizeType dff_id,
+  SizeType lit
+)
+{
+  // 0 は省略する．
+  switch ( mModel.dff_impl(dff_id).reset_val ) {
+  case '0':
+    break;
+  case '1':
+    w.put(" 1");
+    break;
+  default:
+    w.put(' ');
+    w.put_num(lit);
+    break;
+  }
+}
+
+// @brief シンボルテーブルとコメントを出力する．
+void
+AigWriter::write_symbols(
+  BufWriter& w
+)
+{
+  auto put_symbol = [&](char prefix, SizeType pos, const std::string& name) {
+    if ( name == std::string{} ) {
+      return;
+    }
+    w.put(prefix);
+    w.put_num(pos);
+    w.put(' ');
+    w.put(name);
+    w.put('\n');
+  };
+  for ( SizeType i = 0; i < mModel.input_num(); ++ i ) {
+    put_symbol('i', i, mModel.input_name(i));
+  }
+  for ( SizeType i = 0; i < mModel.dff_num(); ++ i ) {
+    put_symbol('l', i, mModel.dff_name(i));
+  }
+  for ( SizeType i = 0; i < mModel.output_num(); ++ i ) {
+    put_symbol('o', i, mModel.output_name(i));
+  }
+
+  auto& comment_list = mModel.comment_list();
+  if ( !comment_list.empty() ) {
+    w.put("c\n");
+    for ( auto& comment: comment_list ) {
+      w.put(comment);
+      w.put('\n');
+    }
+  }
+}
+
+END_NAMESPACE_YM_BN
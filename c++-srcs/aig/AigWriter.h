@@ -0,0 +1,270 @@
+#ifndef AIGWRITER_H
+#define AIGWRITER_H
+
+/// @file AigWriter.h
+/// @brief AigWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class BufWriter;
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigWriter AigWriter.h "AigWriter.h"
+/// @brief BnModel を AIGER 形式で出力するクラス
+///
+/// 論理ノードは関数の種類に応じて AND-INVERTER グラフに分解する．
+/// 分解の際には構造ハッシュと定数の伝搬を行う．
+/// - プリミティブ: n入力の AND/OR/XOR は平衡木に分解する．
+/// - カバー: キューブごとの AND の OR に分解する．
+/// - 論理式: 演算子ごとに分解する．
+/// - 真理値表/BDD: シャノン展開で分解する．
+///
+/// DFF はラッチになる．リセット値 '0', '1' はそのまま初期値になり，
+/// それ以外の値は不定(AIGER 1.9 の自己参照)として出力する．
+///
+/// AND の変数番号は生成順に割り当てるので
+/// 常に lhs > rhs0 >= rhs1 が成り立つ．
+//////////////////////////////////////////////////////////////////////
+class AigWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// この時点で AIG への分解を行う．
+  AigWriter(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief デストラクタ
+  ~AigWriter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief Ascii AIG フォーマットで出力する．
+  void
+  write_aag(
+    std::ostream& s ///< [in] 出力先のストリーム
+  );
+
+  /// @brief AIG フォーマットで出力する．
+  void
+  write_aig(
+    std::ostream& s ///< [in] 出力先のストリーム
+  );
+
+  /// @brief AND 数を返す．
+  SizeType
+  and_num() const
+  {
+    return mAndList.size();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AIG に分解する．
+  void
+  make_aig();
+
+  /// @brief 論理ノードの関数を分解する．
+  /// @return 出力のリテラルを返す．
+  SizeType
+  decomp_node(
+    const NodeImpl& node ///< [in] 論理ノード
+  );
+
+  /// @brief プリミティブ型の関数を分解する．
+  SizeType
+  decomp_primitive(
+    PrimType primitive_type,              ///< [in] プリミティブの種類
+    const std::vector<SizeType>& lit_list ///< [in] ファンインのリテラルのリスト
+  );
+
+  /// @brief カバー型の関数を分解する．
+  SizeType
+  decomp_cover(
+    const SopCover& cover,                ///< [in] 入力カバー
+    bool output_inv,                      ///< [in] 出力の反転属性
+    const std::vector<SizeType>& lit_list ///< [in] ファンインのリテラルのリスト
+  );
+
+  /// @brief 論理式型の関数を分解する．
+  SizeType
+  decomp_expr(
+    const Expr& expr,                     ///< [in] 論理式
+    const std::vector<SizeType>& lit_list ///< [in] ファンインのリテラルのリスト
+  );
+
+  /// @brief 真理値表型の関数を分解する．
+  SizeType
+  decomp_tvfunc(
+    const TvFunc& func,                   ///< [in] 真理値表
+    const std::vector<SizeType>& lit_list ///< [in] ファンインのリテラルのリスト
+  );
+
+  /// @brief decomp_tvfunc() の下請け関数
+  ///
+  /// 変数 0 〜 var_num - 1 をシャノン展開する．
+  SizeType
+  decomp_tvfunc_sub(
+    const TvFunc& func,                    ///< [in] 真理値表
+    const std::vector<SizeType>& lit_list, ///< [in] ファンインのリテラルのリスト
+    SizeType var_num,                      ///< [in] 残りの変数の数
+    SizeType base                          ///< [in] 真理値表の位置の基点
+  );
+
+  /// @brief AND を作る．
+  /// @return 出力のリテラルを返す．
+  SizeType
+  make_and(
+    SizeType lit0, ///< [in] 入力0のリテラル
+    SizeType lit1  ///< [in] 入力1のリテラル
+  );
+
+  /// @brief OR を作る．
+  SizeType
+  make_or(
+    SizeType lit0, ///< [in] 入力0のリテラル
+    SizeType lit1  ///< [in] 入力1のリテラル
+  )
+  {
+    return make_and(lit0 ^ 1, lit1 ^ 1) ^ 1;
+  }
+
+  /// @brief XOR を作る．
+  SizeType
+  make_xor(
+    SizeType lit0, ///< [in] 入力0のリテラル
+    SizeType lit1  ///< [in] 入力1のリテラル
+  )
+  {
+    return make_or(make_and(lit0, lit1 ^ 1), make_and(lit0 ^ 1, lit1));
+  }
+
+  /// @brief MUX を作る．
+  SizeType
+  make_mux(
+    SizeType sel,  ///< [in] 選択信号のリテラル
+    SizeType lit1, ///< [in] sel = 1 の時の入力のリテラル
+    SizeType lit0  ///< [in] sel = 0 の時の入力のリテラル
+  )
+  {
+    if ( lit1 == lit0 ) {
+      return lit0;
+    }
+    return make_or(make_and(sel, lit1), make_and(sel ^ 1, lit0));
+  }
+
+  /// @brief 2入力の演算を平衡木の形で適用する．
+  ///
+  /// lit_list は破壊される．
+  template<typename Op>
+  SizeType
+  make_tree(
+    std::vector<SizeType>& lit_list, ///< [in] 入力のリテラルのリスト
+    SizeType empty_val,              ///< [in] 入力が空の時の値
+    Op op                            ///< [in] 2入力の演算
+  )
+  {
+    auto n = lit_list.size();
+    if ( n == 0 ) {
+      return empty_val;
+    }
+    while ( n > 1 ) {
+      SizeType m = 0;
+      for ( SizeType i = 0; i + 1 < n; i += 2, ++ m ) {
+	lit_list[m] = op(lit_list[i], lit_list[i + 1]);
+      }
+      if ( n % 2 == 1 ) {
+	lit_list[m] = lit_list[n - 1];
+	++ m;
+      }
+      n = m;
+    }
+    return lit_list[0];
+  }
+
+  /// @brief ラッチのリセット値を出力する．
+  void
+  write_reset(
+    BufWriter& w,    ///< [in] 出力先
+    SizeType dff_id, ///< [in] DFF番号
+    SizeType lit     ///< [in] ラッチのリテラル
+  );
+
+  /// @brief シンボルテーブルとコメントを出力する．
+  void
+  write_symbols(
+    BufWriter& w ///< [in] 出力先
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  // 構造ハッシュ用のハッシュ関数
+  struct PairHash
+  {
+    SizeType
+    operator()(
+      const std::pair<SizeType, SizeType>& key
+    ) const
+    {
+      return key.first * 1048573 + key.second;
+    }
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のモデル
+  const ModelImpl& mModel;
+
+  // 最初の AND の変数番号
+  SizeType mBaseVar;
+
+  // ノード番号をキーにしてリテラルを格納する配列
+  std::vector<SizeType> mNodeLit;
+
+  // ラッチの次状態のリテラルのリスト
+  std::vector<SizeType> mNextList;
+
+  // 出力のリテラルのリスト
+  std::vector<SizeType> mOutputList;
+
+  // AND の入力のリテラル対のリスト
+  //
+  // 先頭の要素の変数番号が mBaseVar となる．
+  std::vector<std::pair<SizeType, SizeType>> mAndList;
+
+  // 構造ハッシュ用の辞書
+  std::unordered_map<std::pair<SizeType, SizeType>, SizeType,
+		     PairHash> mAndDict;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // AIGWRITER_H
@@ -7,16 +7,84 @@
 /// All rights reserved.
 
 #include <gtest/gtest.h>
-#include "ym/BnModel.h"
+#include "ym/JsonValue.h"
+#include "BnTestUtil.h"
 
 
-BEGIN_NAMESPACE_YM
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// AIGER 1.0 の仕様書の半加算器
+//
+// 6 = x & y (キャリー)
+// 8 = ~x & ~y
+// 10 = ~6 & ~8 (和)
+const std::string half_adder_symbols =
+  "i0 x\n"
+  "i1 y\n"
+  "o0 s\n"
+  "o1 c\n"
+  "c\n"
+  "half adder\n";
+
+const std::string half_adder_aag =
+  "aag 5 2 0 2 3\n"
+  "2\n"
+  "4\n"
+  "10\n"
+  "6\n"
+  "6 4 2\n"
+  "8 5 3\n"
+  "10 9 7\n"
+  + half_adder_symbols;
+
+const std::string half_adder_aig =
+  "aig 5 2 0 2 3\n"
+  "10\n"
+  "6\n"
+  "\x02\x02"
+  "\x03\x02"
+  "\x01\x02"
+  + half_adder_symbols;
+
+// 半加算器の内容をチェックする．
+void
+check_half_adder(
+  const BnModel& model
+)
+{
+  ASSERT_EQ( 2, model.input_num() );
+  EXPECT_EQ( "x", model.input_name(0) );
+  EXPECT_EQ( "y", model.input_name(1) );
+  ASSERT_EQ( 2, model.output_num() );
+  EXPECT_EQ( "s", model.output_name(0) );
+  EXPECT_EQ( "c", model.output_name(1) );
+  EXPECT_EQ( 0, model.dff_num() );
+  EXPECT_EQ( 3, model.logic_num() );
+  ASSERT_EQ( 1, model.comment_list().size() );
+  EXPECT_EQ( "half adder", model.comment_list()[0] );
+
+  auto c = model.output(1);
+  EXPECT_EQ( PrimType::And, c.func().primitive_type() );
+  EXPECT_EQ( (std::vector<SizeType>{model.input(1).id(), model.input(0).id()}),
+	     c.fanin_id_list().to_vector() );
+
+  auto s = model.output(0);
+  EXPECT_EQ( PrimType::Nor, s.func().primitive_type() );
+  ASSERT_EQ( 2, s.fanin_num() );
+  EXPECT_EQ( c.id(), s.fanin(1).id() );
+  auto n8 = s.fanin(0);
+  EXPECT_EQ( PrimType::Nor, n8.func().primitive_type() );
+}
+
+END_NONAMESPACE
 
 TEST( BnModelTest, read_aag1)
 {
   // 普通のファイルの読み込みテスト
-  string filename{"test1.aag"};
-  string path{DATAPATH + filename};
+  std::string filename{"test1.aag"};
+  std::string path{DATAPATH + filename};
 
   auto bnet = BnModel::read_aag(path);
 
@@ -27,8 +95,170 @@ TEST( BnModelTest, read_aag1)
 
   EXPECT_EQ( ni, bnet.input_num() );
   EXPECT_EQ( no, bnet.output_num() );
-  EXPECT_EQ( nd, bnet.seq_num() );
+  EXPECT_EQ( nd, bnet.dff_num() );
   EXPECT_EQ( ng, bnet.logic_num() );
 }
 
-END_NAMESPACE_YM
+TEST( BnModelTest, read_aag_half_adder )
+{
+  auto path = make_file("half_adder.aag", half_adder_aag);
+  auto model = BnModel::read_aag(path);
+  check_half_adder(model);
+}
+
+TEST( BnModelTest, read_aig_half_adder )
+{
+  auto path = make_file("half_adder.aig", half_adder_aig);
+  auto model = BnModel::read_aig(path);
+  check_half_adder(model);
+}
+
+TEST( BnModelTest, read_aig_nommap )
+{
+  auto path = make_file("half_adder.aig", half_adder_aig);
+  std::unordered_map<std::string, JsonValue> opt_dict;
+  opt_dict.emplace("mmap", JsonValue{false});
+  auto model = BnModel::read_aig(path, JsonValue{opt_dict});
+  check_half_adder(model);
+}
+
+TEST( BnModelTest, read_aag_unordered )
+{
+  // aag では AND 行の順番は任意
+  auto path = make_file("unordered.aag",
+			 "aag 5 2 0 2 3\n"
+			 "2\n"
+			 "4\n"
+			 "10\n"
+			 "6\n"
+			 "10 9 7\n"
+			 "8 5 3\n"
+			 "6 4 2\n"
+			 + half_adder_symbols);
+  auto model = BnModel::read_aag(path);
+  check_half_adder(model);
+}
+
+TEST( BnModelTest, read_aig_latch )
+{
+  // 初期値が 0, 1, 不定の3つのラッチ
+  // 出力とラッチの入力は反転している．
+  // 出力と DFF#2 の入力は同じリテラル
+  auto path = make_file("latch.aig",
+			 "aig 4 1 3 1 0\n"
+			 "3\n"
+			 "5 1\n"
+			 "7 8\n"
+			 "7\n"
+			 "l0 q0\n"
+			 "l1 q1\n"
+			 "l2 q2\n");
+  auto model = BnModel::read_aig(path);
+
+  EXPECT_EQ( 1, model.input_num() );
+  ASSERT_EQ( 3, model.dff_num() );
+  EXPECT_EQ( '0', model.dff(0).reset_val() );
+  EXPECT_EQ( '1', model.dff(1).reset_val() );
+  EXPECT_EQ( 'X', model.dff(2).reset_val() );
+  EXPECT_EQ( "q0", model.dff_name(0) );
+  EXPECT_EQ( "q1", model.dff_name(1) );
+  EXPECT_EQ( "q2", model.dff_name(2) );
+
+  // DFF#0 の入力は入力の否定
+  auto src0 = model.dff(0).input();
+  EXPECT_EQ( PrimType::Not, src0.func().primitive_type() );
+  EXPECT_EQ( model.input(0).id(), src0.fanin(0).id() );
+
+  // DFF#1 の入力は DFF#0 の出力の否定
+  auto src1 = model.dff(1).input();
+  EXPECT_EQ( PrimType::Not, src1.func().primitive_type() );
+  EXPECT_EQ( model.dff(0).output().id(), src1.fanin(0).id() );
+
+  // DFF#2 の入力と外部出力は DFF#1 の出力の否定
+  // NOT ノードは共有される．
+  auto src2 = model.dff(2).input();
+  EXPECT_EQ( PrimType::Not, src2.func().primitive_type() );
+  EXPECT_EQ( model.dff(1).output().id(), src2.fanin(0).id() );
+  ASSERT_EQ( 1, model.output_num() );
+  EXPECT_EQ( src2.id(), model.output(0).id() );
+
+  EXPECT_EQ( 3, model.logic_num() );
+}
+
+TEST( BnModelTest, read_aig_const )
+{
+  // 定数出力と bad state
+  auto path = make_file("const.aig",
+			 "aig 0 0 0 2 0 1\n"
+			 "0\n"
+			 "1\n"
+			 "1\n"
+			 "b0 bad\n");
+  auto model = BnModel::read_aig(path);
+
+  ASSERT_EQ( 3, model.output_num() );
+  EXPECT_EQ( PrimType::C0, model.output(0).func().primitive_type() );
+  EXPECT_EQ( PrimType::C1, model.output(1).func().primitive_type() );
+  EXPECT_EQ( model.output(1).id(), model.output(2).id() );
+  EXPECT_EQ( "bad", model.output_name(2) );
+}
+
+TEST( BnModelTest, read_aig_bad_delta )
+{
+  // 差分が lhs を超えている．
+  auto path = make_file("bad_delta.aig",
+			 "aig 2 1 0 1 1\n"
+			 "4\n"
+			 "\x05\x01");
+  EXPECT_THROW( BnModel::read_aig(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_aig_truncated )
+{
+  auto path = make_file("truncated.aig",
+			 "aig 5 2 0 2 3\n"
+			 "10\n"
+			 "6\n"
+			 "\x02\x02"
+			 "\x03");
+  EXPECT_THROW( BnModel::read_aig(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_aag_undef )
+{
+  auto path = make_file("undef.aag",
+			 "aag 3 1 0 1 1\n"
+			 "2\n"
+			 "6\n"
+			 "6 2 4\n");
+  EXPECT_THROW( BnModel::read_aag(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_aag_loop )
+{
+  auto path = make_file("loop.aag",
+			 "aag 3 1 0 1 2\n"
+			 "2\n"
+			 "6\n"
+			 "4 2 6\n"
+			 "6 2 4\n");
+  EXPECT_THROW( BnModel::read_aag(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_aag_multidef )
+{
+  auto path = make_file("multidef.aag",
+			 "aag 2 1 0 1 1\n"
+			 "2\n"
+			 "2\n"
+			 "2 3 3\n");
+  EXPECT_THROW( BnModel::read_aag(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_aig_bad_header )
+{
+  auto path = make_file("bad_header.aig", "aag 0 0 0 0 0\n");
+  EXPECT_THROW( BnModel::read_aig(path), std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,129 @@
+
+/// @file write_aig_test.cc
+/// @brief write_aig_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+const std::string half_adder_aag =
+  "aag 5 2 0 2 3\n"
+  "2\n"
+  "4\n"
+  "10\n"
+  "6\n"
+  "6 4 2\n"
+  "8 5 3\n"
+  "10 9 7\n"
+  "i0 x\n"
+  "i1 y\n"
+  "o0 s\n"
+  "o1 c\n"
+  "c\n"
+  "half adder\n";
+
+// 色々な種類の関数を含むモデルを作る．
+BnModel
+make_model()
+{
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto c = model.new_input("c");
+  auto dff0 = model.new_dff("q0", '0');
+  auto dff1 = model.new_dff("q1", '1');
+  auto dff2 = model.new_dff("q2", 'X');
+  auto q0 = dff0.output();
+  auto q1 = dff1.output();
+  auto q2 = dff2.output();
+
+  auto n1 = model.new_primitive(PrimType::Xor, {a, b, c});
+  auto n2 = model.new_primitive(PrimType::Nand, {a, q0, q1});
+  // a b' + c q2'
+  SopCover cover{4, {{Literal{0, false}, Literal{1, true}},
+		     {Literal{2, false}, Literal{3, true}}}};
+  auto n3 = model.new_cover(cover, true, {a, b, c, q2});
+  auto expr = (Expr::literal(0) & ~Expr::literal(1)) | Expr::literal(2);
+  auto n4 = model.new_expr(expr, {n1, n2, n3});
+  // 多数決関数
+  TvFunc maj{"11101000"};
+  auto n5 = model.new_tvfunc(maj, {n4, q1, b});
+  auto n6 = model.new_primitive(PrimType::Xnor, {n5, n1});
+
+  model.set_dff_src(dff0, n5);
+  model.set_dff_src(dff1, n6);
+  model.set_dff_src(dff2, n2);
+  model.new_output(n4, "o1");
+  model.new_output(n6, "o2");
+  model.new_output(a, "o3");
+  model.wrap_up();
+  return model;
+}
+
+END_NONAMESPACE
+
+TEST( BnModelTest, write_aag_half_adder )
+{
+  auto path = make_file("half_adder.aag", half_adder_aag);
+  auto model = BnModel::read_aag(path);
+
+  std::ostringstream buf;
+  model.write_aag(buf);
+  auto str = buf.str();
+  // AND 数は変わらない．
+  EXPECT_EQ( "aag 5 2 0 2 3\n", str.substr(0, 14) );
+  EXPECT_EQ( "i0 x\ni1 y\no0 s\no1 c\nc\nhalf adder\n",
+	     str.substr(str.size() - 33) );
+
+  auto path2 = make_file("half_adder2.aag", str);
+  auto model2 = BnModel::read_aag(path2);
+  check_equiv(model, model2);
+  EXPECT_EQ( model.comment_list(), model2.comment_list() );
+}
+
+TEST( BnModelTest, write_aig_half_adder )
+{
+  auto path = make_file("half_adder.aag", half_adder_aag);
+  auto model = BnModel::read_aag(path);
+
+  std::ostringstream buf;
+  model.write_aig(buf);
+  auto str = buf.str();
+  EXPECT_EQ( "aig 5 2 0 2 3\n", str.substr(0, 14) );
+
+  auto path2 = make_file("half_adder2.aig", str);
+  auto model2 = BnModel::read_aig(path2);
+  check_equiv(model, model2);
+  EXPECT_EQ( model.comment_list(), model2.comment_list() );
+}
+
+TEST( BnModelTest, write_aig_round_trip )
+{
+  auto model = make_model();
+  auto model2 = round_trip(model, "aig", "round_trip.aig");
+  check_equiv(model, model2);
+}
+
+TEST( BnModelTest, write_aag_round_trip )
+{
+  auto model = make_model();
+  auto model2 = round_trip(model, "aag", "round_trip.aag");
+  check_equiv(model, model2);
+}
+
+TEST( BnModelTest, write_aig_bad_file )
+{
+  auto model = make_model();
+  EXPECT_THROW( model.write_aig("/nonexistent/dir/foo.aig"),
+		std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,290 @@
+
+/// @file BlifChunkReader.cc
+/// @brief BlifChunkReader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BlifChunkReader.h"
+#include "ym/SopCover.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BlifChunkReader
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BlifChunkReader::BlifChunkReader(
+  const char* begin,
+  const char* end,
+  const FileInfo& file_info,
+  int line,
+  const BnCellLibrary* library
+) : mScanner{begin, end, file_info, line},
+    mLibrary{library},
+    mCurToken{BlifToken::_EOF},
+    mCurMark{mScanner.mark()},
+    mStopMark{mCurMark}
+{
+}
+
+// @brief 読み込みを行う．
+void
+BlifChunkReader::read(
+  const std::atomic<bool>& cancel,
+  const ProgressReporter& progress
+)
+{
+  try {
+    mComplete = read_stmts(cancel, progress);
+  }
+  catch ( ... ) {
+    mException = std::current_exception();
+  }
+}
+
+// @brief 文の読み込みを行う．
+bool
+BlifChunkReader::read_stmts(
+  const std::atomic<bool>& cancel,
+  const ProgressReporter& progress
+)
+{
+  // BlifParser::read_body() の .names/.latch/.gate 文のみを扱う版
+  next_token();
+  for ( ; ; ) {
+    if ( cancel || progress.is_canceled() ) {
+      return false;
+    }
+    auto mark = mCurMark;
+    bool ok = true;
+    switch ( mCurToken ) {
+    case BlifToken::NL:
+      next_token();
+      break;
+
+    case BlifToken::_EOF:
+      mEofLoc = mCurLoc;
+      return true;
+
+    case BlifToken::NAMES:
+      ok = read_names();
+      break;
+
+    case BlifToken::LATCH:
+      ok = read_latch();
+      break;
+
+    case BlifToken::GATE:
+      ok = read_gate();
+      break;
+
+    default:
+      // それ以外の文は BlifParser に任せる．
+      ok = false;
+      break;
+    }
+    if ( !ok ) {
+      mStopMark = mark;
+      return false;
+    }
+  }
+}
+
+// @brief .names 文の読み込みを行う．
+bool
+BlifChunkReader::read_names()
+{
+  auto name_begin = mNameList.size();
+
+  // str* nl
+  for ( ; ; ) {
+    next_token();
+    if ( mCurToken == BlifToken::STRING ) {
+      add_name();
+    }
+    else if ( mCurToken == BlifToken::NL ) {
+      if ( mNameList.size() == name_begin ) {
+	return false;
+      }
+      break;
+    }
+    else {
+      return false;
+    }
+  }
+
+  // 入力数
+  auto name_num = mNameList.size() - name_begin;
+  auto ni = name_num - 1;
+
+  // キューブは FuncMgr のバッファに直接詰めていく．
+  mFuncMgr.begin_cover(ni);
+  bool has_cube = false;
+
+  // キューブの出力部分
+  char opat_char{'-'};
+
+  for ( ; ; ) {
+    next_token();
+    if ( mCurToken == BlifToken::STRING ) {
+      if ( ni > 0 ) {
+	// 入力のキューブ
+	if ( !mFuncMgr.add_cube(mScanner.cur_string()) ) {
+	  return false;
+	}
+
+	next_token();
+	if ( mCurToken != BlifToken::STRING ) {
+	  return false;
+	}
+      }
+
+      // 出力のキューブ
+      char ochar = mScanner.cur_string()[0];
+      if ( ochar != '0' && ochar != '1' ) {
+	return false;
+      }
+      if ( opat_char == '-' ) {
+	opat_char = ochar;
+      }
+      else if ( opat_char != ochar ) {
+	return false;
+      }
+      // 入力数0の行は恒真のキューブを表す．
+      if ( ni == 0 && !has_cube ) {
+	mFuncMgr.add_cube({});
+	has_cube = true;
+      }
+
+      next_token();
+      if ( mCurToken != BlifToken::NL ) {
+	return false;
+      }
+    }
+    else if ( mCurToken != BlifToken::NL ) {
+      // 次の文の先頭
+      break;
+    }
+  }
+
+  auto output_inv = opat_char == '0';
+  auto func_id = mFuncMgr.end_cover(output_inv);
+  mStmtList.push_back(Stmt{false, name_begin, name_num, func_id, 'X', BAD_ID, 0});
+  return true;
+}
+
+// @brief .latch 文の読み込みを行う．
+bool
+BlifChunkReader::read_latch()
+{
+  auto name_begin = mNameList.size();
+
+  next_token();
+  if ( mCurToken != BlifToken::STRING ) {
+    return false;
+  }
+  add_name();
+
+  next_token();
+  if ( mCurToken != BlifToken::STRING ) {
+    return false;
+  }
+  add_name();
+
+  next_token();
+  char rval = 'X';
+  if ( mCurToken == BlifToken::STRING ) {
+    rval = mScanner.cur_string()[0];
+    if ( rval != '0' && rval != '1' ) {
+      return false;
+    }
+    next_token();
+  }
+  if ( mCurToken != BlifToken::NL ) {
+    return false;
+  }
+
+  mStmtList.push_back(Stmt{true, name_begin, 2, BAD_ID, rval, BAD_ID, 0});
+  return true;
+}
+
+// @brief .gate 文の読み込みを行う．
+bool
+BlifChunkReader::read_gate()
+{
+  // セルやピンが見つからない場合もエラーとして BlifParser に任せる．
+  if ( mLibrary == nullptr ) {
+    return false;
+  }
+
+  next_token();
+  if ( mCurToken != BlifToken::STRING ) {
+    return false;
+  }
+  auto cell_id = mLibrary->find_cell(std::string{mScanner.cur_string()});
+  if ( cell_id == BAD_ID ) {
+    return false;
+  }
+  auto& cell = mLibrary->cell(cell_id);
+  if ( !cell.is_logic() ) {
+    return false;
+  }
+
+  auto name_begin = mNameList.size();
+  auto pin_begin = mPinPosList.size();
+  auto ni = cell.input_list.size();
+  auto opin_id = cell.output_list[0];
+  // 接続済みのピンの印
+  std::vector<bool> conn(ni + 1, false);
+
+  // (str '=' str)* nl
+  for ( ; ; ) {
+    next_token();
+    if ( mCurToken == BlifToken::NL ) {
+      break;
+    }
+    if ( mCurToken != BlifToken::STRING ) {
+      return false;
+    }
+    auto pin_id = cell.find_pin(std::string{mScanner.cur_string()});
+    if ( pin_id == BAD_ID ) {
+      return false;
+    }
+    SizeType pos = ni;
+    if ( pin_id != opin_id ) {
+      auto p = std::find(cell.input_list.begin(), cell.input_list.end(),
+			 pin_id);
+      pos = p - cell.input_list.begin();
+    }
+    if ( conn[pos] ) {
+      return false;
+    }
+    conn[pos] = true;
+
+    next_token();
+    if ( mCurToken != BlifToken::EQ ) {
+      return false;
+    }
+    next_token();
+    if ( mCurToken != BlifToken::STRING ) {
+      return false;
+    }
+    add_name();
+    mPinPosList.push_back(pos);
+  }
+  for ( auto flag: conn ) {
+    if ( !flag ) {
+      return false;
+    }
+  }
+
+  mStmtList.push_back(Stmt{false, name_begin, ni + 1, BAD_ID, 'X',
+			   cell_id, pin_begin});
+  return true;
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,276 @@
+#ifndef BLIFCHUNKREADER_H
+#define BLIFCHUNKREADER_H
+
+/// @file BlifChunkReader.h
+/// @brief BlifChunkReader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnCellLibrary.h"
+#include "BlifScanner.h"
+#include "FuncMgr.h"
+#include "ProgressReporter.h"
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BlifChunkReader BlifChunkReader.h "BlifChunkReader.h"
+/// @brief blif ファイルの一部分(チャンク)を読み込むクラス
+///
+/// BlifParser の並列読み込みで用いられる．
+/// チャンクは .names/.latch/.gate 文の先頭から始まる行の範囲で，
+/// このクラスは他のスレッドと独立に字句解析とカバーの生成を行う．
+/// カバーはチャンク内の FuncMgr に登録し，局所的な関数番号を用いる．
+///
+/// .gate 文のセルとピンはこのクラスで解決し，名前はファイル中の順に，
+/// ピンの位置(入力ピンの位置もしくは出力を表す入力数)を別に記録する．
+///
+/// 名前の解決と二重定義/未定義のチェックは BlifParser 側で
+/// チャンクの順に逐次的に行う．
+///
+/// .names/.latch/.gate 以外の文や構文エラーを見つけたらその文の先頭で
+/// 読み込みを中断する．BlifParser はその位置から逐次的に読み込むので，
+/// エラーメッセージはこのクラスでは出力しない．
+//////////////////////////////////////////////////////////////////////
+class BlifChunkReader
+{
+public:
+
+  /// @brief 読み込んだ文の情報
+  struct Stmt
+  {
+    // .latch 文の時 true
+    bool is_latch;
+
+    // 名前のリストの先頭の位置
+    SizeType name_begin;
+
+    // 名前の数
+    SizeType name_num;
+
+    // .names 文の局所的な関数番号
+    SizeType func_id;
+
+    // .latch 文のリセット値
+    char rval;
+
+    // .gate 文のセル番号
+    //
+    // .gate 文以外では BAD_ID となる．
+    SizeType cell_id;
+
+    // .gate 文のピンの位置のリストの先頭の位置
+    SizeType pin_begin;
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  BlifChunkReader(
+    const char* begin,                     ///< [in] チャンクの先頭
+    const char* end,                       ///< [in] チャンクの末尾の次
+    const FileInfo& file_info,             ///< [in] ファイル情報
+    int line,                              ///< [in] 先頭の行番号
+    const BnCellLibrary* library = nullptr ///< [in] .gate 文で用いるセルライブラリ
+  );
+
+  /// @brief デストラクタ
+  ~BlifChunkReader() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込みを行う．
+  ///
+  /// cancel が true になるか，progress に中断が要求されたら途中で終わる．
+  /// 例外が送出された場合は exception() で取り出せるようにする．
+  void
+  read(
+    const std::atomic<bool>& cancel, ///< [in] 中断フラグ
+    const ProgressReporter& progress ///< [in] 中断要求を調べる対象
+  );
+
+  /// @brief 最後まで読み込んだ時 true を返す．
+  bool
+  is_complete() const
+  {
+    return mComplete;
+  }
+
+  /// @brief 中断した文の先頭の位置を返す．
+  ///
+  /// is_complete() が false の時のみ意味を持つ．
+  const BufScanner::Mark&
+  stop_mark() const
+  {
+    return mStopMark;
+  }
+
+  /// @brief 末尾の EOF の位置を返す．
+  const FileRegion&
+  eof_loc() const
+  {
+    return mEofLoc;
+  }
+
+  /// @brief 読み込み中に送出された例外を返す．
+  std::exception_ptr
+  exception() const
+  {
+    return mException;
+  }
+
+  /// @brief 読み込んだ文のリストを返す．
+  const std::vector<Stmt>&
+  stmt_list() const
+  {
+    return mStmtList;
+  }
+
+  /// @brief 名前を返す．
+  const std::string&
+  name(
+    SizeType pos ///< [in] 位置 ( 0 <= pos < 名前の総数 )
+  ) const
+  {
+    return mNameList[pos];
+  }
+
+  /// @brief 名前の位置を返す．
+  const FileRegion&
+  name_loc(
+    SizeType pos ///< [in] 位置 ( 0 <= pos < 名前の総数 )
+  ) const
+  {
+    return mLocList[pos];
+  }
+
+  /// @brief .gate 文のピンの位置を返す．
+  ///
+  /// 入力ピンの場合はセルの入力中の位置，出力ピンの場合は入力数となる．
+  SizeType
+  pin_pos(
+    SizeType pos ///< [in] 位置 ( 0 <= pos < .gate 文のピンの総数 )
+  ) const
+  {
+    return mPinPosList[pos];
+  }
+
+  /// @brief 局所的な関数を管理するオブジェクトを返す．
+  const FuncMgr&
+  func_mgr() const
+  {
+    return mFuncMgr;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 文の読み込みを行う．
+  /// @retval true 最後まで読み込んだ．
+  /// @retval false 読み込みを中断した．
+  bool
+  read_stmts(
+    const std::atomic<bool>& cancel, ///< [in] 中断フラグ
+    const ProgressReporter& progress ///< [in] 中断要求を調べる対象
+  );
+
+  /// @brief .names 文の読み込みを行う．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false 構文エラーが起こった．
+  bool
+  read_names();
+
+  /// @brief .latch 文の読み込みを行う．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false 構文エラーが起こった．
+  bool
+  read_latch();
+
+  /// @brief .gate 文の読み込みを行う．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false 構文エラーが起こった．
+  bool
+  read_gate();
+
+  /// @brief 名前を追加する．
+  void
+  add_name()
+  {
+    mNameList.emplace_back(mScanner.cur_string());
+    mLocList.push_back(mCurLoc);
+  }
+
+  /// @brief 次のトークンを読み出す．
+  void
+  next_token()
+  {
+    mCurMark = mScanner.mark();
+    mCurToken = mScanner.read_token(mCurLoc);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 字句解析器
+  BlifScanner mScanner;
+
+  // セルライブラリ
+  const BnCellLibrary* mLibrary;
+
+  // 現在のトークン
+  BlifToken mCurToken;
+
+  // 現在のトークンの位置
+  FileRegion mCurLoc;
+
+  // 現在のトークンを読み出す前の位置
+  BufScanner::Mark mCurMark;
+
+  // 最後まで読み込んだ時 true
+  bool mComplete{false};
+
+  // 中断した文の先頭の位置
+  BufScanner::Mark mStopMark;
+
+  // 末尾の EOF の位置
+  FileRegion mEofLoc;
+
+  // 読み込み中に送出された例外
+  std::exception_ptr mException;
+
+  // 文のリスト
+  std::vector<Stmt> mStmtList;
+
+  // 名前のリスト
+  std::vector<std::string> mNameList;
+
+  // 名前の位置のリスト
+  std::vector<FileRegion> mLocList;
+
+  // .gate 文のピンの位置のリスト
+  std::vector<SizeType> mPinPosList;
+
+  // 局所的な関数を管理するオブジェクト
+  FuncMgr mFuncMgr;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BLIFCHUNKREADER_H
@@ -0,0 +1,348 @@
+
+/// @file BlifConeIndex.cc
+/// @brief BlifConeIndex の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BlifConeIndex.h"
+#include "BlifScanner.h"
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BlifConeIndex
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BlifConeIndex::BlifConeIndex(
+  const char* begin,
+  const char* end,
+  const BnCellLibrary* library
+) : mCur{begin},
+    mEnd{end},
+    mLineTop{begin},
+    mLibrary{library}
+{
+  mHasBlockComment =
+    std::string_view{begin, static_cast<SizeType>(end - begin)}.find("/*")
+    != std::string_view::npos;
+  build();
+}
+
+// @brief 出力の推移的ファンインに含まれる文を選ぶ．
+void
+BlifConeIndex::select(
+  const std::vector<std::string>& output_list
+)
+{
+  // 出力が特定できない文とそれ以外の文は常に選ぶ．
+  for ( auto& stmt: mStmtList ) {
+    stmt.selected = stmt.out_pos == BAD_ID;
+  }
+
+  std::vector<SizeType> queue;
+  auto add_def = [&](const std::string_view& name) {
+    auto p = mDefDict.find(name);
+    if ( p == mDefDict.end() ) {
+      return;
+    }
+    for ( auto id = p->second; id != BAD_ID; id = mStmtList[id].next_def ) {
+      auto& stmt = mStmtList[id];
+      if ( !stmt.selected ) {
+	stmt.selected = true;
+	queue.push_back(id);
+      }
+    }
+  };
+
+  for ( auto& name: output_list ) {
+    add_def(name);
+  }
+  for ( auto& stmt: mStmtList ) {
+    if ( stmt.out_pos == BAD_ID ) {
+      for ( SizeType i = 0; i < stmt.name_num; ++ i ) {
+	add_def(mNameList[stmt.name_begin + i]);
+      }
+    }
+  }
+  while ( !queue.empty() ) {
+    auto& stmt = mStmtList[queue.back()];
+    queue.pop_back();
+    for ( SizeType i = 0; i < stmt.name_num; ++ i ) {
+      if ( i != stmt.out_pos ) {
+	add_def(mNameList[stmt.name_begin + i]);
+      }
+    }
+  }
+}
+
+// @brief 索引を作る．
+void
+BlifConeIndex::build()
+{
+  std::vector<std::string_view> word_list;
+  for ( ; ; ) {
+    // 論理的な行の先頭
+    if ( mCur == mEnd ) {
+      mReachEof = true;
+      mEofLine = mLine;
+      mEofColumn = mCur - mLineTop + 1;
+      return;
+    }
+    std::string_view word;
+    if ( !next_word(word) ) {
+      // 空行
+      continue;
+    }
+    auto ptr = word.data();
+    if ( word[0] != '.' || (ptr - 1 >= mLineTop && ptr[-1] == '\\') ) {
+      // キューブの行
+      skip_line();
+      continue;
+    }
+
+    auto stmt_id = mStmtList.size();
+    mStmtList.push_back(Stmt{ptr, mLine, static_cast<int>(ptr - mLineTop + 1),
+			     mNameList.size(), 0, BAD_ID, BAD_ID, false});
+    auto keyword = word.substr(1);
+    read_words(word_list);
+    if ( keyword == "names" || keyword == "latch" || keyword == "gate" ) {
+      add_logic(stmt_id, keyword, word_list);
+    }
+    else if ( keyword == "end" || keyword == "exdc" ) {
+      // 以降は BlifParser が最後まで読む．
+      return;
+    }
+  }
+}
+
+// @brief 行末までの単語を読み出す．
+void
+BlifConeIndex::read_words(
+  std::vector<std::string_view>& word_list
+)
+{
+  word_list.clear();
+  std::string_view word;
+  while ( next_word(word) ) {
+    word_list.push_back(word);
+  }
+}
+
+// @brief 次の単語を1つ読み出す．
+bool
+BlifConeIndex::next_word(
+  std::string_view& word
+)
+{
+  for ( ; ; ) {
+    if ( mCur == mEnd ) {
+      return false;
+    }
+    auto c = *mCur;
+    switch ( c ) {
+    case ' ':
+    case '\t':
+      ++ mCur;
+      continue;
+
+    case '\n':
+    case '\r':
+      accept_nl();
+      return false;
+
+    case '=':
+      word = std::string_view{mCur, 1};
+      ++ mCur;
+      return true;
+
+    case '#':
+      // 改行までは読み飛ばす．
+      while ( mCur != mEnd && *mCur != '\n' && *mCur != '\r' ) {
+	++ mCur;
+      }
+      continue;
+
+    case '/':
+      if ( mCur + 1 != mEnd && mCur[1] == '*' ) {
+	// "*/" までは空白扱いにする．
+	mCur += 2;
+	for ( ; ; ) {
+	  if ( mCur == mEnd ) {
+	    return false;
+	  }
+	  if ( *mCur == '*' && mCur + 1 != mEnd && mCur[1] == '/' ) {
+	    mCur += 2;
+	    break;
+	  }
+	  if ( *mCur == '\n' || *mCur == '\r' ) {
+	    accept_nl();
+	  }
+	  else {
+	    ++ mCur;
+	  }
+	}
+	continue;
+      }
+      break;
+
+    case '\\':
+      ++ mCur;
+      if ( mCur == mEnd ) {
+	return false;
+      }
+      if ( *mCur == '\n' || *mCur == '\r' ) {
+	// エスケープされた改行は空白扱いにする．
+	accept_nl();
+	continue;
+      }
+      // 次の文字から単語が始まる．
+      {
+	auto start = mCur;
+	mCur = BlifScanner::find_delimiter(mCur + 1, mEnd);
+	word = std::string_view{start, static_cast<SizeType>(mCur - start)};
+      }
+      return true;
+
+    default:
+      break;
+    }
+
+    auto start = mCur;
+    mCur = BlifScanner::find_delimiter(mCur + 1, mEnd);
+    word = std::string_view{start, static_cast<SizeType>(mCur - start)};
+    return true;
+  }
+}
+
+// @brief キューブの行などの文以外の行を読み飛ばす．
+void
+BlifConeIndex::skip_line()
+{
+  if ( !mHasBlockComment ) {
+    // 改行のエスケープや単独の '\r' がなければ改行まで一気に進める．
+    auto size = static_cast<SizeType>(mEnd - mCur);
+    auto nl = static_cast<const char*>(memchr(mCur, '\n', size));
+    auto line_end = nl != nullptr ? nl : mEnd;
+    auto len = static_cast<SizeType>(line_end - mCur);
+    auto cr = static_cast<const char*>(memchr(mCur, '\r', len));
+    if ( memchr(mCur, '\\', len) == nullptr &&
+	 (cr == nullptr || cr + 1 == line_end) ) {
+      if ( nl == nullptr ) {
+	mCur = mEnd;
+      }
+      else {
+	mCur = nl + 1;
+	++ mLine;
+	mLineTop = mCur;
+      }
+      return;
+    }
+  }
+  std::string_view word;
+  while ( next_word(word) ) {
+    ;
+  }
+}
+
+// @brief 改行を読み進める．
+void
+BlifConeIndex::accept_nl()
+{
+  // "\r\n" は1つの改行として扱う．
+  if ( *mCur == '\r' && mCur + 1 != mEnd && mCur[1] == '\n' ) {
+    ++ mCur;
+  }
+  ++ mCur;
+  ++ mLine;
+  mLineTop = mCur;
+}
+
+// @brief .names/.latch/.gate 文を記録する．
+void
+BlifConeIndex::add_logic(
+  SizeType stmt_id,
+  const std::string_view& keyword,
+  const std::vector<std::string_view>& word_list
+)
+{
+  auto& stmt = mStmtList[stmt_id];
+  auto n = word_list.size();
+  if ( keyword == "names" ) {
+    // .names <入力名> ... <出力名>
+    bool ok = n > 0;
+    for ( auto& word: word_list ) {
+      if ( word == "=" ) {
+	ok = false;
+      }
+      else {
+	mNameList.push_back(word);
+      }
+    }
+    if ( ok ) {
+      stmt.out_pos = n - 1;
+    }
+  }
+  else if ( keyword == "latch" ) {
+    // .latch <入力名> <出力名> [<リセット値>]
+    if ( (n == 2 || n == 3) && word_list[0] != "=" && word_list[1] != "=" ) {
+      mNameList.push_back(word_list[0]);
+      mNameList.push_back(word_list[1]);
+      stmt.out_pos = 1;
+    }
+  }
+  else {
+    // .gate <セル名> <ピン名>=<ネット名> ...
+    // 出力ピン名はセルライブラリから求める．
+    std::string oname;
+    if ( mLibrary != nullptr && n > 0 ) {
+      auto cell_id = mLibrary->find_cell(std::string{word_list[0]});
+      if ( cell_id != BAD_ID ) {
+	auto& cell = mLibrary->cell(cell_id);
+	if ( cell.is_logic() ) {
+	  oname = cell.pin_list[cell.output_list[0]].name;
+	}
+      }
+    }
+    bool ok = !oname.empty() && n % 3 == 1;
+    for ( SizeType i = 1; i < n && ok; i += 3 ) {
+      if ( word_list[i + 1] != "=" ) {
+	ok = false;
+	break;
+      }
+      if ( word_list[i] == oname ) {
+	stmt.out_pos = (i - 1) / 3;
+      }
+      mNameList.push_back(word_list[i + 2]);
+    }
+    if ( !ok ) {
+      // 出力が特定できないので名前は全てファンインとして扱う．
+      mNameList.resize(stmt.name_begin);
+      stmt.out_pos = BAD_ID;
+      for ( SizeType i = 1; i < n; ++ i ) {
+	if ( word_list[i] != "=" ) {
+	  mNameList.push_back(word_list[i]);
+	}
+      }
+    }
+  }
+  stmt.name_num = mNameList.size() - stmt.name_begin;
+
+  if ( stmt.out_pos != BAD_ID ) {
+    auto& oname = mNameList[stmt.name_begin + stmt.out_pos];
+    auto p = mDefDict.find(oname);
+    if ( p == mDefDict.end() ) {
+      mDefDict.emplace(oname, stmt_id);
+    }
+    else {
+      stmt.next_def = p->second;
+      p->second = stmt_id;
+    }
+  }
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,225 @@
+#ifndef BLIFCONEINDEX_H
+#define BLIFCONEINDEX_H
+
+/// @file BlifConeIndex.h
+/// @brief BlifConeIndex のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnCellLibrary.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BlifConeIndex BlifConeIndex.h "BlifConeIndex.h"
+/// @brief blif ファイルの文の位置と定義される名前の索引
+///
+/// BlifParser で指定された出力の推移的ファンインのみを読み込む際に用いられる．
+/// ファイルを1度走査して各文の先頭の位置と .names/.latch/.gate 文に
+/// 現れる名前を記録する．キューブの行は読み飛ばし，文字列のコピーも
+/// 行わないので BlifScanner で読み込むよりもずっと軽い．
+///
+/// select() で出力名のリストを与えると，その推移的ファンインに含まれる
+/// 文と，.names/.latch/.gate 以外の文に印をつける．
+/// 出力が特定できない文(構文エラーや未知のセル)は BlifParser に
+/// エラーを出させるために常に印をつける．
+///
+/// .end もしくは .exdc 文以降は記録しない．
+//////////////////////////////////////////////////////////////////////
+class BlifConeIndex
+{
+public:
+
+  /// @brief 文の情報
+  struct Stmt
+  {
+    // 先頭の '.' の位置
+    const char* ptr;
+
+    // 先頭の行番号
+    int line;
+
+    // 先頭のコラム番号
+    int column;
+
+    // 名前のリストの先頭の位置
+    SizeType name_begin;
+
+    // 名前の数
+    SizeType name_num;
+
+    // 出力の名前の位置
+    //
+    // .names/.latch/.gate 以外の文と出力が特定できない文では BAD_ID となる．
+    SizeType out_pos;
+
+    // 同じ名前を定義している別の文の番号
+    //
+    // なければ BAD_ID となる．
+    SizeType next_def;
+
+    // select() で選ばれた時 true
+    bool selected;
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// ここで索引を作る．
+  BlifConeIndex(
+    const char* begin,                     ///< [in] ファイルの先頭
+    const char* end,                       ///< [in] ファイルの末尾の次
+    const BnCellLibrary* library = nullptr ///< [in] .gate 文で用いるセルライブラリ
+  );
+
+  /// @brief デストラクタ
+  ~BlifConeIndex() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力の推移的ファンインに含まれる文を選ぶ．
+  void
+  select(
+    const std::vector<std::string>& output_list ///< [in] 出力名のリスト
+  );
+
+  /// @brief 文のリストを返す．
+  const std::vector<Stmt>&
+  stmt_list() const
+  {
+    return mStmtList;
+  }
+
+  /// @brief 末尾まで記録した時 true を返す．
+  ///
+  /// .end もしくは .exdc 文で終わった時は false となる．
+  bool
+  reach_eof() const
+  {
+    return mReachEof;
+  }
+
+  /// @brief 末尾の行番号を返す．
+  ///
+  /// reach_eof() が true の時のみ意味を持つ．
+  int
+  eof_line() const
+  {
+    return mEofLine;
+  }
+
+  /// @brief 末尾のコラム番号を返す．
+  ///
+  /// reach_eof() が true の時のみ意味を持つ．
+  int
+  eof_column() const
+  {
+    return mEofColumn;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 索引を作る．
+  void
+  build();
+
+  /// @brief 行末までの単語を読み出す．
+  ///
+  /// エスケープされた改行は空白として扱う．
+  /// 行末の改行も読み進める．
+  void
+  read_words(
+    std::vector<std::string_view>& word_list ///< [out] 単語のリスト
+  );
+
+  /// @brief 次の単語を1つ読み出す．
+  /// @retval true 単語を読み出した．
+  /// @retval false 行末に達した．
+  bool
+  next_word(
+    std::string_view& word ///< [out] 単語
+  );
+
+  /// @brief キューブの行などの文以外の行を読み飛ばす．
+  void
+  skip_line();
+
+  /// @brief 改行を読み進める．
+  ///
+  /// mCur は '\n' もしくは '\r' を指していなければならない．
+  void
+  accept_nl();
+
+  /// @brief .names/.latch/.gate 文を記録する．
+  void
+  add_logic(
+    SizeType stmt_id,                              ///< [in] 文の番号
+    const std::string_view& keyword,               ///< [in] キーワード
+    const std::vector<std::string_view>& word_list ///< [in] 単語のリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 現在の位置
+  const char* mCur;
+
+  // ファイルの末尾の次
+  const char* mEnd;
+
+  // 現在の行の先頭
+  const char* mLineTop;
+
+  // 現在の行番号
+  int mLine{1};
+
+  // "/*" を含む時 true
+  bool mHasBlockComment{false};
+
+  // .gate 文で用いるセルライブラリ
+  const BnCellLibrary* mLibrary;
+
+  // 末尾まで記録した時 true
+  bool mReachEof{false};
+
+  // 末尾の行番号
+  int mEofLine{0};
+
+  // 末尾のコラム番号
+  int mEofColumn{0};
+
+  // 文のリスト
+  std::vector<Stmt> mStmtList;
+
+  // 名前のリスト
+  std::vector<std::string_view> mNameList;
+
+  // 名前をキーにしてそれを定義している文の番号を格納する辞書
+  //
+  // 同じ名前を定義している文が複数ある場合は最後の文の番号を格納し，
+  // Stmt::next_def で残りの文をたどる．
+  std::unordered_map<std::string_view, SizeType> mDefDict;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BLIFCONEINDEX_H
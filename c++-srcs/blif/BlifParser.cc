@@ -9,12 +9,77 @@
 #include "BlifParser.h"
 #include "ModelImpl.h"
 #include "ym/BnModel.h"
+#include "ym/BnHierModel.h"
+#include "HierImpl.h"
 #include "ym/SopCover.h"
+#include "BlifChunkReader.h"
+#include "BlifConeIndex.h"
+#include "MappedFile.h"
+#include "ParseFileInfo.h"
+#include "ParseCache.h"
+#include "ThreadJoiner.h"
 #include "ym/MsgMgr.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_BN
 
+BEGIN_NONAMESPACE
+
+// line の先頭が分割位置になれる時 true を返す．
+bool
+is_split_point(
+  const char* line,
+  const char* begin,
+  const char* end
+)
+{
+  // 直前の行が '\\' で継続している場合はダメ
+  auto p = line - 1;
+  if ( p > begin && *(p - 1) == '\r' ) {
+    -- p;
+  }
+  if ( p > begin && *(p - 1) == '\\' ) {
+    return false;
+  }
+  for ( auto kwd: {".names", ".latch", ".gate"} ) {
+    auto n = strlen(kwd);
+    if ( static_cast<SizeType>(end - line) > n &&
+	 strncmp(line, kwd, n) == 0 &&
+	 (line[n] == ' ' || line[n] == '\t') ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// p 以降で最初の分割位置を探す．
+//
+// 見つからなければ end を返す．
+const char*
+find_split_point(
+  const char* p,
+  const char* begin,
+  const char* end
+)
+{
+  for ( ; ; ) {
+    // 次の行の先頭まで進める．
+    auto q = static_cast<const char*>(memchr(p, '\n', end - p));
+    if ( q == nullptr ) {
+      return end;
+    }
+    p = q + 1;
+    if ( is_split_point(p, begin, end) ) {
+      return p;
+    }
+  }
+}
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // クラス BnModel
 //////////////////////////////////////////////////////////////////////
@@ -22,18 +87,86 @@ BEGIN_NAMESPACE_YM_BN
 // @brief blif ファイルの読み込みを行う(セルライブラリ付き)．
 BnModel
 BnModel::read_blif(
-  const std::string& filename
+  const std::string& filename,
+  const JsonValue& option
 )
 {
+  ParseCache cache{filename, "blif", option};
   BnModel model;
+  if ( cache.load(model) ) {
+    return model;
+  }
+  model._set_read_option(option);
 
   BlifParser parser(model._model_impl());
-  if ( !parser.read(filename) ) {
+  if ( !parser.read(filename, ReadOption{option}) ) {
     std::ostringstream buf;
     buf << "BnModel::read_blif(\"" << filename << "\") failed.";
     throw std::invalid_argument{buf.str()};
   }
 
+  cache.save(model);
+  return model;
+}
+
+// @brief blif ファイルの読み込みを行う(セルライブラリ付き)．
+BnModel
+BnModel::read_blif(
+  const std::string& filename,
+  const BnCellLibrary& library,
+  const JsonValue& option
+)
+{
+  // 結果はセルライブラリにも依存するのでキャッシュは用いない．
+  BnModel model;
+  model._set_read_option(option);
+
+  BlifParser parser(model._model_impl(), &library);
+  if ( !parser.read(filename, ReadOption{option}) ) {
+    std::ostringstream buf;
+    buf << "BnModel::read_blif(\"" << filename << "\") failed.";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  return model;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnHierModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief 階層構造を持つ blif ファイルの読み込みを行う．
+BnHierModel
+BnHierModel::read_blif(
+  const std::string& filename,
+  const JsonValue& option
+)
+{
+  BnHierModel model;
+  if ( !BlifParser::read_hier(filename, ReadOption{option}, *model.mImpl) ) {
+    std::ostringstream buf;
+    buf << "BnHierModel::read_blif(\"" << filename << "\") failed.";
+    throw std::invalid_argument{buf.str()};
+  }
+  return model;
+}
+
+// @brief 階層構造を持つ blif ファイルの読み込みを行う(セルライブラリ付き)．
+BnHierModel
+BnHierModel::read_blif(
+  const std::string& filename,
+  const BnCellLibrary& library,
+  const JsonValue& option
+)
+{
+  BnHierModel model;
+  if ( !BlifParser::read_hier(filename, ReadOption{option}, *model.mImpl,
+			      &library) ) {
+    std::ostringstream buf;
+    buf << "BnHierModel::read_blif(\"" << filename << "\") failed.";
+    throw std::invalid_argument{buf.str()};
+  }
   return model;
 }
 
@@ -44,15 +177,46 @@ BnModel::read_blif(
 
 // @brief コンストラクタ
 BlifParser::BlifParser(
-  ModelImpl& model
-) : mModel{model}
+  ModelImpl& model,
+  const BnCellLibrary* library
+) : mModel{model},
+    mLibrary{library}
 {
 }
 
 // @brief 読み込みを行う．
 bool
 BlifParser::read(
-  const std::string& filename
+  const std::string& filename,
+  const ReadOption& option
+)
+{
+  if ( option.track_location ) {
+    return read_file(filename, option);
+  }
+
+  // 位置情報を記録せずに読み込む．
+  // 読み直す可能性があるのでメッセージは保留しておく．
+  mTrackLoc = false;
+  mMsgQueue.set_defer(true);
+  auto ok = read_file(filename, option);
+  if ( ok || !mNeedRetry ) {
+    mMsgQueue.flush();
+    return ok;
+  }
+
+  // 位置情報が必要なエラーが見つかったので記録しながら読み直す．
+  mMsgQueue.clear();
+  mModel.clear();
+  BlifParser parser{mModel, mLibrary};
+  return parser.read_file(filename, option);
+}
+
+// @brief ファイルを開いて読み込む．
+bool
+BlifParser::read_file(
+  const std::string& filename,
+  const ReadOption& option
 )
 {
   // blif ファイル読み込みの状態遷移
@@ -70,35 +234,628 @@ BlifParser::read(
   //          otherwise                     -> neutral
 
   // ファイルをオープンする．
-  std::ifstream fin{filename};
-  if ( !fin ) {
+  MappedFile fin;
+  if ( !fin.open(filename, option.use_mmap) ) {
     // エラー
     std::ostringstream buf;
     buf << filename << " : No such file.";
-    MsgMgr::put_msg(__FILE__, __LINE__, FileRegion(),
-		    MsgType::Failure, "BLIF_PARSER", buf.str());
+    mMsgQueue.put_msg(__FILE__, __LINE__, FileRegion(),
+		      MsgType::Failure, "BLIF_PARSER", buf.str());
     return false;
   }
 
-  BlifScanner scanner(fin, {filename});
+  auto file_info = new_file_info(filename);
+  mFileTop = fin.begin();
+  mProgress = ProgressReporter{"read", fin.size_hint(),
+			       ProgressReporter::BYTE_STRIDE};
+
+  if ( fin.is_streaming() && option.output_filter.empty() &&
+       option.thread_num <= 1 ) {
+    // 逐次的に読み込む場合は展開と並行して読み込める．
+    return read_stream(fin, file_info);
+  }
+
+  // 以降の処理はファイル全体を用いる．
+  mProgress.set_total(fin.size());
+
+  if ( is_hierarchical(fin.begin(), fin.end()) ) {
+    if ( !option.output_filter.empty() ) {
+      mMsgQueue.put_msg(__FILE__, __LINE__, FileRegion(),
+			MsgType::Failure, "BLIF_PARSER",
+			"'output_filter' cannot be used with hierarchical models.");
+      return false;
+    }
+    return read_flatten(fin.begin(), fin.end(), file_info);
+  }
+
+  if ( !option.output_filter.empty() ) {
+    // 指定された出力の推移的ファンインのみを読み込む．
+    return read_cone(fin.begin(), fin.end(), file_info, option.output_filter);
+  }
+
+  if ( option.thread_num > 1 ) {
+    // 並列に読み込めるように分割する．
+    auto split_list = split_chunks(fin.begin(), fin.end(), option.thread_num);
+    if ( !split_list.empty() ) {
+      return read_parallel(fin.begin(), fin.end(), file_info, split_list);
+    }
+  }
+
+  BlifScanner scanner(fin.begin(), fin.end(), file_info);
 
   // 初期化を行う．
   mScanner = &scanner;
 
+  if ( !read_model() ) {
+    return false;
+  }
+
+  bool stopped;
+  if ( !read_body(nullptr, stopped) ) {
+    return false;
+  }
+
+  return end_read();
+}
+
+// @brief 階層構造を保ったまま読み込みを行う．
+bool
+BlifParser::read_hier(
+  const std::string& filename,
+  const ReadOption& option,
+  HierImpl& hier,
+  const BnCellLibrary* library
+)
+{
+  MappedFile fin;
+  if ( !fin.open(filename, option.use_mmap) ) {
+    // エラー
+    std::ostringstream buf;
+    buf << filename << " : No such file.";
+    MsgQueue::output(__FILE__, __LINE__, FileRegion(),
+		     MsgType::Failure, "BLIF_PARSER", buf.str());
+    return false;
+  }
+
+  auto file_info = new_file_info(filename);
+  return read_hier_body(fin.begin(), fin.end(), file_info, library, hier);
+}
+
+// @brief 展開中のファイルを展開済みの部分から読み込む．
+bool
+BlifParser::read_stream(
+  const MappedFile& fin,
+  const FileInfo& file_info
+)
+{
+  // 階層構造を持つかはファイル全体を見ないとわからないので
+  // 平坦なモデルとして読み進めながら調べる．
+  // 階層構造を持つ場合は読み直すのでメッセージは保留しておく．
+  bool defer = mMsgQueue.is_deferred();
+  mMsgQueue.set_defer(true);
+
+  BlifScanner scanner(fin.begin(), fin.ready_end(), file_info);
+  scanner.set_source(fin);
+  mScanner = &scanner;
+  mCheckHier = true;
+
+  bool stopped;
+  bool ok = read_model() && read_body(nullptr, stopped);
+  if ( ok && !mHierFound ) {
+    mProgress.set_total(fin.size());
+    ok = end_read();
+  }
+  mCheckHier = false;
+
+  // 途中で失敗した場合は読んでいない部分に .subckt 文があるかもしれない．
+  if ( mHierFound || (!ok && is_hierarchical(fin.begin(), fin.end())) ) {
+    mMsgQueue.clear();
+    mMsgQueue.set_defer(defer);
+    mNeedRetry = false;
+    mModel.clear();
+    mProgress.set_total(fin.size());
+    return read_flatten(fin.begin(), fin.end(), file_info);
+  }
+
+  mMsgQueue.set_defer(defer);
+  if ( !defer ) {
+    mMsgQueue.flush();
+  }
+  return ok;
+}
+
+// @brief 階層構造を持つファイルを読み込んで平坦化する．
+bool
+BlifParser::read_flatten(
+  const char* begin,
+  const char* end,
+  const FileInfo& file_info
+)
+{
+  // 各モジュールを読み込んでから平坦化する．
+  HierImpl hier;
+  if ( !read_hier_body(begin, end, file_info, mLibrary, hier) ) {
+    return false;
+  }
+  hier.flatten(0, mModel);
+  mProgress.finish(mModel.node_num());
+  return true;
+}
+
+// @brief 階層構造を持つファイルか調べる．
+bool
+BlifParser::is_hierarchical(
+  const char* begin,
+  const char* end
+)
+{
+  // 文字列として含まれていなければ字句解析するまでもない．
+  std::string_view text{begin, static_cast<SizeType>(end - begin)};
+  if ( text.find(".subckt") == std::string_view::npos ) {
+    auto pos = text.find(".model");
+    if ( pos == std::string_view::npos ||
+	 text.find(".model", pos + 1) == std::string_view::npos ) {
+      return false;
+    }
+  }
+
+  // コメントや名前の一部に含まれている場合もあるので
+  // 字句解析を行って予約語として現れるか調べる．
+  BlifScanner scanner(begin, end, FileInfo{});
+  SizeType model_num = 0;
+  for ( ; ; ) {
+    FileRegion loc;
+    auto tk = scanner.read_token(loc);
+    if ( tk == BlifToken::_EOF ) {
+      return false;
+    }
+    if ( tk == BlifToken::SUBCKT ) {
+      return true;
+    }
+    if ( tk == BlifToken::MODEL ) {
+      ++ model_num;
+      if ( model_num > 1 ) {
+	return true;
+      }
+    }
+  }
+}
+
+// @brief 階層構造を持つファイルの内容を読み込む．
+bool
+BlifParser::read_hier_body(
+  const char* begin,
+  const char* end,
+  const FileInfo& file_info,
+  const BnCellLibrary* library,
+  HierImpl& hier
+)
+{
+  // 全てのモジュールを読み込んでから .subckt 文の接続を解決する．
+  // 各モジュールは独立したパーサーで読み込むが字句解析器は共有する．
+  BlifScanner scanner(begin, end, file_info);
+  std::vector<std::unique_ptr<BlifParser>> parser_list;
+  for ( ; ; ) {
+    auto body = std::unique_ptr<ModelImpl>{new ModelImpl};
+    auto parser = std::unique_ptr<BlifParser>{new BlifParser{*body, library}};
+    parser->mScanner = &scanner;
+    parser->mHierMode = true;
+    parser->mFileTop = begin;
+    parser->mProgress = ProgressReporter{"read",
+					 static_cast<SizeType>(end - begin),
+					 ProgressReporter::BYTE_STRIDE};
+    if ( parser_list.empty() ) {
+      if ( !parser->read_model() ) {
+	return false;
+      }
+    }
+    else {
+      // 直前のパーサーが .model を読んだところで止まっている．
+      auto& prev = *parser_list.back();
+      parser->mCurToken = prev.mCurToken;
+      parser->mCurLoc = prev.mCurLoc;
+      if ( !parser->read_model_name() ) {
+	return false;
+      }
+    }
+    auto module_id = hier.new_module(parser->mModelName, std::move(body));
+    if ( module_id == BAD_ID ) {
+      std::ostringstream buf;
+      buf << parser->mModelName << ": Model defined more than once.";
+      MsgQueue::output(__FILE__, __LINE__, parser->mModelLoc,
+		       MsgType::Error,
+		       "MLTDEF02", buf.str());
+      return false;
+    }
+    bool stopped;
+    if ( !parser->read_body(nullptr, stopped) ) {
+      return false;
+    }
+    auto& module = hier.module(module_id);
+    module.port_input_num = module.body->input_num();
+    module.port_output_num = module.body->output_num();
+    auto tk = parser->cur_token();
+    parser_list.push_back(std::move(parser));
+    if ( tk != BlifToken::MODEL ) {
+      break;
+    }
+  }
+
+  auto n = parser_list.size();
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto& parser = *parser_list[i];
+    if ( !parser.resolve_subckt(hier, i) ) {
+      return false;
+    }
+    if ( !parser.end_read() ) {
+      return false;
+    }
+  }
+
+  auto cycle_id = hier.find_cycle();
+  if ( cycle_id != BAD_ID ) {
+    std::ostringstream buf;
+    buf << hier.module(cycle_id).name << ": Recursive instantiation.";
+    MsgQueue::output(__FILE__, __LINE__, parser_list[cycle_id]->mModelLoc,
+		     MsgType::Error,
+		     "SUBCKT05", buf.str());
+    return false;
+  }
+
+  return true;
+}
+
+// @brief .subckt 文の接続を解決する．
+bool
+BlifParser::resolve_subckt(
+  HierImpl& hier,
+  SizeType module_id
+)
+{
+  for ( auto& info: mSubcktList ) {
+    auto sub_id = hier.find_module(info.model_name);
+    if ( sub_id == BAD_ID ) {
+      std::ostringstream buf;
+      buf << info.model_name << ": Undefined model.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, info.loc,
+			MsgType::Error,
+			"SUBCKT01", buf.str());
+      return false;
+    }
+    auto& sub = hier.module(sub_id);
+    auto& sub_body = *sub.body;
+
+    // ポート名をキーにしてポート番号を格納する辞書
+    // 出力ポートの番号は入力ポートの後に続ける．
+    auto ni = sub.port_input_num;
+    auto no = sub.port_output_num;
+    std::unordered_map<std::string, SizeType> port_dict;
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      port_dict.emplace(sub_body.input_name(i), i);
+    }
+    for ( SizeType i = 0; i < no; ++ i ) {
+      port_dict.emplace(sub_body.output_name(i), ni + i);
+    }
+
+    std::vector<SizeType> conn_list(ni + no, BAD_ID);
+    std::vector<FileRegion> conn_loc_list(ni + no);
+    auto nf = info.formal_list.size();
+    for ( SizeType i = 0; i < nf; ++ i ) {
+      auto& formal = info.formal_list[i];
+      auto& loc = info.formal_loc_list[i];
+      auto p = port_dict.find(formal);
+      if ( p == port_dict.end() ) {
+	std::ostringstream buf;
+	buf << formal << ": No such port in '" << info.model_name << "'.";
+	mMsgQueue.put_msg(__FILE__, __LINE__, loc,
+			  MsgType::Error,
+			  "SUBCKT02", buf.str());
+	return false;
+      }
+      auto pos = p->second;
+      if ( conn_list[pos] != BAD_ID ) {
+	std::ostringstream buf;
+	buf << formal << ": Connected more than once.";
+	mMsgQueue.put_msg(__FILE__, __LINE__, loc,
+			  MsgType::Error,
+			  "SUBCKT03", buf.str());
+	return false;
+      }
+      conn_list[pos] = info.actual_list[i];
+      conn_loc_list[pos] = loc;
+    }
+
+    HierInst inst{sub_id, {}, {}};
+    inst.input_list.reserve(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto id = conn_list[i];
+      if ( id == BAD_ID ) {
+	std::ostringstream buf;
+	buf << sub_body.input_name(i) << ": Input of '" << info.model_name
+	    << "' is not connected.";
+	mMsgQueue.put_msg(__FILE__, __LINE__, info.loc,
+			  MsgType::Error,
+			  "SUBCKT04", buf.str());
+	return false;
+      }
+      // 疑似出力にする．
+      auto oid = mModel.output_num();
+      mModel.new_output(id);
+      mModel.set_output_name(oid, id2str(id));
+      inst.input_list.push_back(id);
+    }
+    inst.output_list.reserve(no);
+    for ( SizeType i = 0; i < no; ++ i ) {
+      auto id = conn_list[ni + i];
+      if ( id == BAD_ID ) {
+	// 未接続の出力には名前のないノードを割り当てる．
+	id = mModel.alloc_node();
+	mModel.set_input(id);
+      }
+      else {
+	auto& loc = conn_loc_list[ni + i];
+	if ( !check_multi_def(id, loc) ) {
+	  return false;
+	}
+	// 疑似入力にする．
+	set_defined(id, loc);
+	mModel.set_input(id, id2str(id));
+      }
+      inst.output_list.push_back(id);
+    }
+    hier.module(module_id).inst_list.push_back(std::move(inst));
+  }
+  return true;
+}
+
+// @brief 分割したファイルを並列に読み込む．
+bool
+BlifParser::read_parallel(
+  const char* begin,
+  const char* end,
+  const FileInfo& file_info,
+  const std::vector<const char*>& split_list
+)
+{
+  // split_list[0] より前はこのスレッドで逐次的に読み込む．
+  // その間に各チャンクを別スレッドで読み込んでおき，
+  // 終わったものから順に結果を取り込む．
+
+  auto n = split_list.size() - 1;
+  std::vector<std::unique_ptr<BlifChunkReader>> reader_list;
+  reader_list.reserve(n);
+  int line = 1 + count_lines(begin, split_list[0]);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto chunk_begin = split_list[i];
+    auto chunk_end = split_list[i + 1];
+    reader_list.emplace_back(new BlifChunkReader{chunk_begin, chunk_end,
+						 file_info, line, mLibrary});
+    line += count_lines(chunk_begin, chunk_end);
+  }
+
+  std::atomic<bool> cancel{false};
+  std::vector<std::thread> thread_list;
+  // 関数を抜ける時には全てのスレッドを終了させる．
+  ThreadJoiner joiner{cancel, thread_list};
+  thread_list.reserve(n);
+  for ( auto& reader: reader_list ) {
+    auto reader_p = reader.get();
+    thread_list.emplace_back([reader_p, &cancel, this]{
+      reader_p->read(cancel, mProgress);
+    });
+  }
+
+  BlifScanner scanner(begin, end, file_info);
+  mScanner = &scanner;
+
+  if ( !read_model() ) {
+    return false;
+  }
+
+  bool stopped;
+  if ( !read_body(split_list[0], stopped) ) {
+    return false;
+  }
+  if ( !stopped ) {
+    // 最初のチャンクに達する前に終わった．
+    return end_read();
+  }
+
+  for ( SizeType i = 0; i < n; ++ i ) {
+    thread_list[i].join();
+    // 中断が要求された場合はチャンクが途中で終わっている．
+    mProgress.check_cancel();
+    auto& reader = *reader_list[i];
+    if ( reader.exception() ) {
+      std::rethrow_exception(reader.exception());
+    }
+    if ( !merge_chunk(reader) ) {
+      return false;
+    }
+    mProgress.update(split_list[i + 1] - mFileTop, mModel.node_num());
+    if ( !reader.is_complete() ) {
+      // 中断した文から最後まで逐次的に読み込む．
+      cancel = true;
+      auto& mark = reader.stop_mark();
+      BlifScanner scanner2(mark.ptr, end, file_info, mark.line, mark.column);
+      mScanner = &scanner2;
+      next_token();
+      if ( !read_body(nullptr, stopped) ) {
+	return false;
+      }
+      return end_read();
+    }
+  }
+
+  // .end がないまま末尾に達した．
+  warn_unexpected_eof(reader_list.back()->eof_loc());
+
+  return end_read();
+}
+
+// @brief 指定された出力の推移的ファンインのみを読み込む．
+bool
+BlifParser::read_cone(
+  const char* begin,
+  const char* end,
+  const FileInfo& file_info,
+  const std::vector<std::string>& output_list
+)
+{
+  // 索引を作って必要な文を選ぶ．
+  BlifConeIndex index{begin, end, mLibrary};
+  index.select(output_list);
+  for ( auto& name: output_list ) {
+    mOutputFilter.emplace(name, false);
+  }
+
+  // 選ばれた文の連続した範囲ごとに読み込む．
+  // 選ばれなかった文の先頭で read_body() を中断する．
+  auto& stmt_list = index.stmt_list();
+  auto n = stmt_list.size();
+  std::unique_ptr<BlifScanner> scanner{new BlifScanner{begin, end, file_info}};
+  mScanner = scanner.get();
+  if ( !read_model() ) {
+    return false;
+  }
+  // 最初の文は .model 文
+  SizeType pos = 1;
+  for ( ; ; ) {
+    while ( pos < n && stmt_list[pos].selected ) {
+      ++ pos;
+    }
+    auto stop_pos = pos < n ? stmt_list[pos].ptr : nullptr;
+    bool stopped;
+    if ( !read_body(stop_pos, stopped) ) {
+      return false;
+    }
+    if ( !stopped ) {
+      break;
+    }
+    while ( pos < n && !stmt_list[pos].selected ) {
+      ++ pos;
+    }
+    if ( pos < n ) {
+      auto& stmt = stmt_list[pos];
+      scanner.reset(new BlifScanner{stmt.ptr, end, file_info,
+				    stmt.line, stmt.column});
+    }
+    else {
+      // 残りは全て読み飛ばす．
+      // 索引は .end 文で終わるので，ここに来るのは末尾に達した時のみ．
+      ASSERT_COND( index.reach_eof() );
+      scanner.reset(new BlifScanner{end, end, file_info,
+				    index.eof_line(), index.eof_column()});
+    }
+    mScanner = scanner.get();
+    next_token();
+  }
+
+  for ( auto& name: output_list ) {
+    if ( !mOutputFilter.at(name) ) {
+      std::ostringstream buf;
+      buf << name << ": No such output.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, FileRegion(),
+			MsgType::Error,
+			"FILTER01", buf.str());
+      return false;
+    }
+  }
+
+  return end_read();
+}
+
+// @brief チャンクの読み込み結果を取り込む．
+bool
+BlifParser::merge_chunk(
+  const BlifChunkReader& reader
+)
+{
+  // 局所的な関数番号から大域的な関数番号への変換表
+  // 文の順に必要になった時点で登録するので，関数番号は逐次的に
+  // 読み込んだ場合と同じになる．
+  auto& func_mgr = reader.func_mgr();
+  auto nf = func_mgr.func_num();
+  std::vector<SizeType> func_map(nf, BAD_ID);
+
+  std::vector<SizeType> id_list;
+  std::vector<SizeType> fanin_list;
+  for ( auto& stmt: reader.stmt_list() ) {
+    id_list.clear();
+    id_list.reserve(stmt.name_num);
+    for ( SizeType i = 0; i < stmt.name_num; ++ i ) {
+      auto pos = stmt.name_begin + i;
+      auto id = find_id(reader.name(pos), reader.name_loc(pos));
+      id_list.push_back(id);
+    }
+    if ( stmt.cell_id != BAD_ID ) {
+      // .gate 文の名前はファイル中の順に並んでいる．
+      auto ni = stmt.name_num - 1;
+      fanin_list.resize(ni);
+      SizeType opos = 0;
+      for ( SizeType i = 0; i < stmt.name_num; ++ i ) {
+	auto pin_pos = reader.pin_pos(stmt.pin_begin + i);
+	if ( pin_pos == ni ) {
+	  opos = i;
+	}
+	else {
+	  fanin_list[pin_pos] = id_list[i];
+	}
+      }
+      auto oid = id_list[opos];
+      auto& oloc = reader.name_loc(stmt.name_begin + opos);
+      if ( !check_multi_def(oid, oloc) ) {
+	return false;
+      }
+      new_names(oid, oloc, cell_func(stmt.cell_id), fanin_list);
+      continue;
+    }
+    auto oid = id_list.back();
+    auto& oloc = reader.name_loc(stmt.name_begin + stmt.name_num - 1);
+    if ( !check_multi_def(oid, oloc) ) {
+      return false;
+    }
+    if ( stmt.is_latch ) {
+      new_latch(id_list[0], oid, oloc, stmt.rval);
+    }
+    else {
+      auto& func_id = func_map[stmt.func_id];
+      if ( func_id == BAD_ID ) {
+	auto& func = func_mgr.func(stmt.func_id);
+	func_id = mModel.reg_cover(func.input_cover(), func.output_inv());
+      }
+      id_list.pop_back();
+      new_names(oid, oloc, func_id, id_list);
+    }
+  }
+  return true;
+}
+
+// @brief .end 文もしくは stop_pos までの読み込みを行う．
+bool
+BlifParser::read_body(
+  const char* stop_pos,
+  bool& stopped
+)
+{
   // エラー箇所
   FileRegion error_loc;
 
   // .end 文の位置
   FileRegion end_loc;
 
-  // ハードコーディングした状態遷移
+  stopped = false;
 
-  if ( !read_model() ) {
-    goto ST_ERROR_EXIT;
-  }
+  // ハードコーディングした状態遷移
 
   // 本体の処理
   for ( ; ; ) {
+    mProgress.update(mScanner->first_ptr() - mFileTop, mModel.node_num());
+    if ( stop_pos != nullptr && mScanner->first_ptr() == stop_pos ) {
+      // 文の先頭が stop_pos に達した．
+      stopped = true;
+      return true;
+    }
     auto tk = cur_token();
     switch (tk) {
     case BlifToken::NL:
@@ -111,11 +868,15 @@ BlifParser::read(
       goto ST_AFTER_EOF;
 
     case BlifToken::MODEL:
-      MsgMgr::put_msg(__FILE__, __LINE__,
-		      cur_loc(),
-		      MsgType::Error,
-		      "SYN04",
-		      "Multiple '.model' statements.");
+      if ( mHierMode ) {
+	// 次のモデルの開始
+	goto ST_NORMAL_EXIT;
+      }
+      mMsgQueue.put_msg(__FILE__, __LINE__,
+			cur_loc(),
+			MsgType::Error,
+			"SYN04",
+			"Multiple '.model' statements.");
       goto ST_ERROR_EXIT;
 
     case BlifToken::INPUTS:
@@ -148,6 +909,16 @@ BlifParser::read(
       }
       break;
 
+    case BlifToken::SUBCKT:
+      if ( !mHierMode ) {
+	error_loc = cur_loc();
+	goto ST_SYNTAX_ERROR;
+      }
+      if ( !read_subckt() ) {
+	goto ST_ERROR_EXIT;
+      }
+      break;
+
     case BlifToken::END:
       end_loc = cur_loc();
       next_token();
@@ -225,61 +996,212 @@ BlifParser::read(
     }
   }
 
- ST_AFTER_END:
-  {
-    auto tk = cur_token();
-    if ( tk == BlifToken::_EOF ) {
-      goto ST_NORMAL_EXIT;
-    }
-    else if ( tk != BlifToken::NL ) {
-      MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-		      MsgType::Warning,
-		      "SYN06",
-		      "Statement after '.end' is ignored.");
-    }
-    next_token();
-    goto ST_AFTER_END;
+ ST_AFTER_END:
+  {
+    auto tk = cur_token();
+    if ( tk == BlifToken::_EOF ) {
+      goto ST_NORMAL_EXIT;
+    }
+    else if ( mHierMode && tk == BlifToken::MODEL ) {
+      // 次のモデルの開始
+      goto ST_NORMAL_EXIT;
+    }
+    else if ( tk != BlifToken::NL ) {
+      mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			MsgType::Warning,
+			"SYN06",
+			"Statement after '.end' is ignored.");
+    }
+    next_token();
+    goto ST_AFTER_END;
+  }
+
+ ST_AFTER_EOF:
+  warn_unexpected_eof(error_loc);
+
+ ST_NORMAL_EXIT:
+  return true;
+
+ ST_SYNTAX_ERROR:
+  mMsgQueue.put_msg(__FILE__, __LINE__, error_loc,
+		    MsgType::Error,
+		    "SYN00",
+		    "Syntax error.");
+  // わざと次の行につづく
+  // goto ST_ERROR_EXIT;
+
+ ST_ERROR_EXIT:
+
+  return false;
+}
+
+// @brief 読み込みの終了処理を行う．
+bool
+BlifParser::end_read()
+{
+  SizeType n = mDefinedArray.size();
+  for ( SizeType id = 0; id < n; ++ id ) {
+    if ( !is_defined(id) ) {
+      if ( !has_loc() ) {
+	return false;
+      }
+      std::ostringstream buf;
+      buf << id2str(id) << ": Undefined.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, ref_loc(id),
+			MsgType::Error,
+			"UNDEF01", buf.str().c_str());
+      return false;
+    }
+  }
+
+  if ( !mHierMode ) {
+    mProgress.finish(mModel.node_num());
   }
+  mModel.make_logic_list();
 
- ST_AFTER_EOF:
-  {
-    MsgMgr::put_msg(__FILE__, __LINE__, error_loc,
+  return true;
+}
+
+// @brief 予期せぬ EOF の警告を出す．
+void
+BlifParser::warn_unexpected_eof(
+  const FileRegion& loc
+)
+{
+  mMsgQueue.put_msg(__FILE__, __LINE__, loc,
 		    MsgType::Warning,
 		    "SYN05",
 		    "unexpected EOF. '.end' is assumed.");
-    goto ST_NORMAL_EXIT;
-  }
+}
 
- ST_NORMAL_EXIT:
-  {
-    SizeType n = mRefLocArray.size();
-    for ( auto id = 0; id < n; ++ id ) {
-      if ( !is_defined(id) ) {
-	std::ostringstream buf;
-	buf << id2str(id) << ": Undefined.";
-	MsgMgr::put_msg(__FILE__, __LINE__, ref_loc(id),
-			MsgType::Error,
-			"UNDEF01", buf.str().c_str());
-	goto ST_ERROR_EXIT;
-      }
+// @brief 二重定義のチェックを行う．
+bool
+BlifParser::check_multi_def(
+  SizeType id,
+  const FileRegion& loc
+)
+{
+  if ( is_defined(id) ) {
+    // 二重定義
+    if ( !has_loc() ) {
+      return false;
     }
+    std::ostringstream buf;
+    buf << id2str(id) << ": Defined more than once. "
+	<< "Previsous Definition is at " << def_loc(id) << ".";
+    mMsgQueue.put_msg(__FILE__, __LINE__, loc,
+		      MsgType::Error,
+		      "MLTDEF01", buf.str());
+    return false;
   }
+  return true;
+}
 
-  mModel.make_logic_list();
+// @brief .names 文の内容を設定する．
+void
+BlifParser::new_names(
+  SizeType oid,
+  const FileRegion& loc,
+  SizeType func_id,
+  const std::vector<SizeType>& fanin_id_list
+)
+{
+  set_defined(oid, loc);
+  mModel.set_logic(oid, func_id, fanin_id_list);
+  auto oname = id2str(oid);
+  mModel.set_node_name(oid, oname);
+}
 
-  return true;
+// @brief セルの関数番号を返す．
+SizeType
+BlifParser::cell_func(
+  SizeType cell_id
+)
+{
+  if ( mCellFuncMap.get() == nullptr ) {
+    mCellFuncMap.reset(new CellFuncMap{*mLibrary});
+  }
+  return (*mCellFuncMap)(mModel, cell_id);
+}
 
- ST_SYNTAX_ERROR:
-  MsgMgr::put_msg(__FILE__, __LINE__, error_loc,
-		  MsgType::Error,
-		  "SYN00",
-		  "Syntax error.");
-  // わざと次の行につづく
-  // goto ST_ERROR_EXIT;
+// @brief .latch 文の内容を設定する．
+void
+BlifParser::new_latch(
+  SizeType src_id,
+  SizeType oid,
+  const FileRegion& loc,
+  char rval
+)
+{
+  set_defined(oid, loc);
+  auto dff_id = mModel.new_dff(id2str(oid), rval);
+  mModel.set_dff_output(oid, dff_id);
+  mModel.set_dff_src(dff_id, src_id);
+}
 
- ST_ERROR_EXIT:
+// @brief ファイルの内容を分割する．
+std::vector<const char*>
+BlifParser::split_chunks(
+  const char* begin,
+  const char* end,
+  SizeType chunk_num
+)
+{
+  if ( begin == end ) {
+    return {};
+  }
 
-  return false;
+  // 複数行にまたがるコメントがあると行の先頭で分割できない．
+  if ( std::string_view{begin, static_cast<SizeType>(end - begin)}.find("/*")
+       != std::string_view::npos ) {
+    return {};
+  }
+
+  // 最初の .names/.latch/.gate 文の位置
+  // ファイルの先頭は .model 文のはずなので除外する．
+  auto body = find_split_point(begin, begin, end);
+  if ( body == end ) {
+    return {};
+  }
+
+  std::vector<const char*> split_list{body};
+  SizeType body_size = end - body;
+  for ( SizeType i = 1; i < chunk_num; ++ i ) {
+    auto p = body + body_size * i / chunk_num;
+    if ( p <= split_list.back() ) {
+      continue;
+    }
+    auto q = find_split_point(p, begin, end);
+    if ( q == end ) {
+      break;
+    }
+    if ( q > split_list.back() ) {
+      split_list.push_back(q);
+    }
+  }
+  split_list.push_back(end);
+  return split_list;
+}
+
+// @brief 行数を数える．
+int
+BlifParser::count_lines(
+  const char* begin,
+  const char* end
+)
+{
+  // BufScanner と同じく "\r\n" と単独の '\r' も改行とみなす．
+  SizeType n = std::count(begin, end, '\n');
+  for ( auto p = begin; p != end; ++ p ) {
+    p = static_cast<const char*>(memchr(p, '\r', end - p));
+    if ( p == nullptr ) {
+      break;
+    }
+    if ( p + 1 == end || *(p + 1) != '\n' ) {
+      ++ n;
+    }
+  }
+  return n;
 }
 
 // @brief .model 文の読み込みを行う．
@@ -305,38 +1227,48 @@ BlifParser::read_model()
 
     default:
       // それ以外はエラー
-      MsgMgr::put_msg(__FILE__, __LINE__,
-		      cur_loc(),
-		      MsgType::Error,
-		      "SYN01",
-		      "No '.model' statement.");
+      mMsgQueue.put_msg(__FILE__, __LINE__,
+			cur_loc(),
+			MsgType::Error,
+			"SYN01",
+			"No '.model' statement.");
       return false;
     }
   }
 
+  return read_model_name();
+}
+
+// @brief .model 文のモデル名以降の読み込みを行う．
+bool
+BlifParser::read_model_name()
+{
+  mModelLoc = cur_loc();
+
   // モデル名の読み込み
   next_token();
   auto tk = cur_token();
   auto name_loc = cur_loc();
   if ( tk != BlifToken::STRING ) {
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    name_loc,
-		    MsgType::Error,
-		    "SYN02",
-		    "String expected after '.model'.");
+    mMsgQueue.put_msg(__FILE__, __LINE__,
+		      name_loc,
+		      MsgType::Error,
+		      "SYN02",
+		      "String expected after '.model'.");
     return false;
   }
 
-  mModel.set_name(cur_string());
+  mModelName = cur_string();
+  mModel.set_name(mModelName);
 
   // NL を待つ．
   next_token();
   if ( cur_token() != BlifToken::NL ) {
-    MsgMgr::put_msg(__FILE__, __LINE__,
-		    cur_loc(),
-		    MsgType::Error,
-		    "SYN03",
-		    "Newline expected.");
+    mMsgQueue.put_msg(__FILE__, __LINE__,
+		      cur_loc(),
+		      MsgType::Error,
+		      "SYN03",
+		      "Newline expected.");
     return false;
   }
 
@@ -356,17 +1288,20 @@ BlifParser::read_inputs()
     next_token();
     auto tk = cur_token();
     if ( tk == BlifToken::STRING ) {
-      auto name = cur_string();
+      std::string name{cur_string()};
       auto name_loc = cur_loc();
       auto id = find_id(name, name_loc);
       if ( is_defined(id) ) {
+	if ( !has_loc() ) {
+	  return false;
+	}
 	auto loc = def_loc(id);
 	std::ostringstream buf;
 	buf << name << ": Defined more than once. Previous definition is at "
 	    << loc << ".";
-	MsgMgr::put_msg(__FILE__, __LINE__, name_loc,
-			MsgType::Error,
-			"MLTDEF01", buf.str().c_str());
+	mMsgQueue.put_msg(__FILE__, __LINE__, name_loc,
+			  MsgType::Error,
+			  "MLTDEF01", buf.str().c_str());
 	ok = false;
       }
 
@@ -379,9 +1314,9 @@ BlifParser::read_inputs()
     }
     else if ( tk == BlifToken::NL ) {
       if ( n_token == 0 ) {
-	MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			MsgType::Warning,
-			"SYN07", "Empty '.inputs' statement. Ignored.");
+	mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			  MsgType::Warning,
+			  "SYN07", "Empty '.inputs' statement. Ignored.");
       }
       // 次のトークンを読んでおく
       next_token();
@@ -403,8 +1338,17 @@ BlifParser::read_outputs()
     next_token();
     auto tk = cur_token();
     if ( tk == BlifToken::STRING ) {
-      auto name = cur_string();
+      std::string name{cur_string()};
       auto name_loc = cur_loc();
+      if ( !mOutputFilter.empty() ) {
+	// 指定されていない出力は読み飛ばす．
+	auto p = mOutputFilter.find(name);
+	if ( p == mOutputFilter.end() ) {
+	  ++ n_token;
+	  continue;
+	}
+	p->second = true;
+      }
       auto id = find_id(name, name_loc);
       auto oid = mModel.output_num();
       mModel.new_output(id);
@@ -413,9 +1357,9 @@ BlifParser::read_outputs()
     }
     else if ( tk == BlifToken::NL ) {
       if ( n_token == 0 ) {
-	MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			MsgType::Warning,
-			"SYN08", "Empty '.outputs' statement. Ignored.");
+	mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			  MsgType::Warning,
+			  "SYN08", "Empty '.outputs' statement. Ignored.");
       }
       // 次のトークンを読んでおく
       next_token();
@@ -437,9 +1381,6 @@ BlifParser::read_names()
   // .names 文の最後の識別子の定義場所
   FileRegion names_loc;
 
-  // .names 文のキューブを表すリテラルのりスト
-  std::vector<std::vector<Literal>> cube_list;
-
   // .names 文のキューブの出力部分
   // 複数行ある場合も同一のはずなので１文字で十分
   char opat_char{'-'};
@@ -458,27 +1399,31 @@ BlifParser::read_names()
       auto n = names_id_list.size();
       if ( n == 0 ) {
 	// 名前が1つもない場合
-	MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			MsgType::Error,
-			"SYN09",
-			"Empty '.names' statement.");
+	mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			  MsgType::Error,
+			  "SYN09",
+			  "Empty '.names' statement.");
 	return false;
       }
       break;
     }
     else {
-      MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-		      MsgType::Error,
-		      "SYN00",
-		      "Syntax error.");
+      mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			MsgType::Error,
+			"SYN00",
+			"Syntax error.");
       return false;
     }
   }
 
   // 入力数
   auto ni = names_id_list.size() - 1;
+
+  // キューブは FuncMgr のバッファに直接詰めていく．
+  mModel.begin_cover(ni);
   if ( ni == 0 ) {
     // 入力のキューブがない場合
+    bool has_cube = false;
     for ( ; ; ) {
       next_token();
       auto tk = cur_token();
@@ -489,28 +1434,33 @@ BlifParser::read_names()
 	case '0':	break;
 	case '1': break;
 	default:
-	  MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			  MsgType::Error,
-			  "SYN15",
-			  "Illegal character in output cube.");
+	  mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			    MsgType::Error,
+			    "SYN15",
+			    "Illegal character in output cube.");
 	  return false;
 	}
 	if ( opat_char == '-' ) {
 	  opat_char = ochar;
 	}
 	else if ( opat_char != ochar ) {
-	  MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			  MsgType::Error,
-			  "SYN10",
-			  "Output pattern mismatch.");
+	  mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			    MsgType::Error,
+			    "SYN10",
+			    "Output pattern mismatch.");
 	  return false;
 	}
+	// 入力数0の行は恒真のキューブを表す．
+	if ( !has_cube ) {
+	  mModel.add_cube({});
+	  has_cube = true;
+	}
 	next_token();
 	if ( cur_token() != BlifToken::NL ) {
-	  MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			  MsgType::Error,
-			  "SYN14",
-			  "Newline is expected.");
+	  mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			    MsgType::Error,
+			    "SYN14",
+			    "Newline is expected.");
 	  return false;
 	}
       }
@@ -534,33 +1484,20 @@ BlifParser::read_names()
 	auto icube_str = cur_string();
 	auto n = icube_str.size();
 	if ( n != names_id_list.size() - 1 ) {
-	  MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			  MsgType::Error,
-			  "SYN12",
-			  "Input pattern does not fit "
-			  "with the number of fanins.");
+	  mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			    MsgType::Error,
+			    "SYN12",
+			    "Input pattern does not fit "
+			    "with the number of fanins.");
 	  return false;
 	}
-	// icube_str からリテラルのりストを作る．
-	std::vector<Literal> lit_list;
-	lit_list.reserve(ni);
-	for ( SizeType i = 0; i < ni; ++ i ) {
-	  auto c = icube_str[i];
-	  if ( c == '1' ) {
-	    lit_list.push_back(Literal(i, false));
-	  }
-	  else if ( c == '0' ) {
-	    lit_list.push_back(Literal(i, true));
-	  }
-	  else if ( c != '-' ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
+	if ( !mModel.add_cube(icube_str) ) {
+	  mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
 			    MsgType::Error,
 			    "SYN11",
 			    "Illegal character in input cube.");
-	    return false;
-	  }
+	  return false;
 	}
-	cube_list.push_back(lit_list);
 
 	// 出力のキューブ
 	next_token();
@@ -572,34 +1509,34 @@ BlifParser::read_names()
 	  case '0': break;
 	  case '1': break;
 	  default:
-	    MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			    MsgType::Error,
-			    "SYN15",
-			    "Illegal character in output cube.");
+	    mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			      MsgType::Error,
+			      "SYN15",
+			      "Illegal character in output cube.");
 	    return false;
 	  }
 	  if ( opat_char == '-' ) {
 	    opat_char = ochar;
 	  }
 	  else if ( opat_char != ochar ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			    MsgType::Error, "SYN10",
-			    "Outpat pattern mismatch.");
+	    mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			      MsgType::Error, "SYN10",
+			      "Outpat pattern mismatch.");
 	    return false;
 	  }
 
 	  next_token();
 	  if ( cur_token() != BlifToken::NL ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			    MsgType::Error, "SYN14",
-			    "Newline is expected.");
+	    mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			      MsgType::Error, "SYN14",
+			      "Newline is expected.");
 	    return false;
 	  }
 	}
 	else {
-	  MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			  MsgType::Error, "SYN13",
-			  "No output cube.");
+	  mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+			    MsgType::Error, "SYN13",
+			    "No output cube.");
 	  return false;
 	}
       }
@@ -617,27 +1554,16 @@ BlifParser::read_names()
 
   auto oid = names_id_list[ni];
   names_id_list.pop_back();
-  if ( is_defined(oid) ) {
-    // 二重定義
-    FileRegion loc = def_loc(oid);
-    std::ostringstream buf;
-    buf << id2str(oid) << ": Defined more than once. "
-	<< "Previsous Definition is at " << loc << ".";
-    MsgMgr::put_msg(__FILE__, __LINE__, names_loc,
-		    MsgType::Error,
-		    "MLTDEF01", buf.str());
+  if ( !check_multi_def(oid, names_loc) ) {
     return false;
   }
 
-  // カバーを作る．
-  auto input_cover = SopCover(ni, cube_list);
+  // カバーを登録する．
+  // 同じ関数が既に登録されていた場合は SopCover は作られない．
   auto output_inv = opat_char == '0';
-  auto func_id = mModel.reg_cover(input_cover, output_inv);
+  auto func_id = mModel.end_cover(output_inv);
 
-  set_defined(oid, names_loc);
-  mModel.set_logic(oid, func_id, names_id_list);
-  auto oname = id2str(oid);
-  mModel.set_node_name(oid, oname);
+  new_names(oid, names_loc, func_id, names_id_list);
 
   return true;
 }
@@ -646,165 +1572,122 @@ BlifParser::read_names()
 bool
 BlifParser::read_gate()
 {
-#if 0
-  // 最初のトークンは文字列
-  next_token();
-  auto tk = cur_token();
-  if ( tk != BlifToken::STRING ) {
-    MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-		    MsgType::Error,
-		    "SYN??",
-		    "Syntax error: string is expected after '.gate'");
+  // .gate <セル名> (<ピン名>=<ネット名>)* NL
+  auto syntax_error = [&]() {
+    mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+		      MsgType::Error,
+		      "SYN20", "Syntax error in '.gate' statement.");
     return false;
-  }
+  };
 
-  auto name = cur_string();
-  auto name_loc = cur_loc();
-  auto cell = mCellLibrary.cell(name);
-  if ( cell.is_invalid() ) {
-    std::ostringstream buf;
-    buf << name << ": No such cell.";
-    MsgMgr::put_msg(__FILE__, __LINE__, name_loc,
-		    MsgType::Error,
-		    "NOCELL02", buf.str());
-    return false;
+  next_token();
+  if ( cur_token() != BlifToken::STRING ) {
+    return syntax_error();
   }
 
-  if ( !cell.is_logic() ) {
-    std::ostringstream buf;
-    buf << name << " : Not a logic cell.";
-    MsgMgr::put_msg(__FILE__, __LINE__, name_loc,
-		    MsgType::Error,
-		    "BNetBlifReader",// TODO 直す
-		    buf.str());
-    return false;
-  }
-  if ( cell.output_num() != 1 ) {
-    std::ostringstream buf;
-    buf << name << " : Not a single output cell.";
-    MsgMgr::put_msg(__FILE__, __LINE__, name_loc,
-		    MsgType::Error,
-		    "BNetBlifReader",
-		    buf.str());
+  std::string name{cur_string()};
+  auto name_loc = cur_loc();
+  if ( mLibrary == nullptr ) {
+    mMsgQueue.put_msg(__FILE__, __LINE__, name_loc,
+		      MsgType::Error,
+		      "NOCELL01",
+		      "No cell library is specified for '.gate' statement.");
     return false;
   }
-  if ( cell.has_tristate(0) ) {
+  auto cell_id = mLibrary->find_cell(name);
+  if ( cell_id == BAD_ID ) {
     std::ostringstream buf;
-    buf << name << " : Is a tri-state cell.";
-    MsgMgr::put_msg(__FILE__, __LINE__, name_loc,
-		    MsgType::Error,
-		    "BNetBlifReader",
-		    buf.str());
+    buf << name << ": No such cell.";
+    mMsgQueue.put_msg(__FILE__, __LINE__, name_loc,
+		      MsgType::Error,
+		      "NOCELL02", buf.str());
     return false;
   }
-  if ( cell.inout_num() > 0 ) {
+  auto& cell = mLibrary->cell(cell_id);
+  if ( !cell.is_logic() ) {
     std::ostringstream buf;
-    buf << name << " : Has inout pins.";
-    MsgMgr::put_msg(__FILE__, __LINE__, name_loc,
-		    MsgType::Error,
-		    "BNetBlifReader",
-		    buf.str());
+    buf << name << ": Not a single output combinational cell.";
+    mMsgQueue.put_msg(__FILE__, __LINE__, name_loc,
+		      MsgType::Error,
+		      "NOCELL03", buf.str());
     return false;
   }
 
-  // 出力ピンに対応する識別子番号
-  SizeType oid;
-  // 出力ピンの位置
+  auto ni = cell.input_list.size();
+  auto opin_id = cell.output_list[0];
+  std::vector<SizeType> id_list(ni, BAD_ID);
+  auto oid = BAD_ID;
   FileRegion oloc;
-  // 入力ピンに対応する識別子番号
-  auto ni = cell.input_num();
-  vector<SizeType> id_array(ni, -1);
-
-  SizeType n_pins = 0;
-
-  // (str '=' str)* nl
   for ( ; ; ) {
     next_token();
     auto tk = cur_token();
-    if ( tk == BlifToken::STRING ) {
-      auto pin_name = cur_string();
-      auto pin = cell.pin(pin_name);
-      if ( pin.is_invalid() ) {
-	std::ostringstream buf;
-	buf << pin_name << ": No such pin.";
-	MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
+    if ( tk == BlifToken::NL ) {
+      break;
+    }
+    if ( tk != BlifToken::STRING ) {
+      return syntax_error();
+    }
+    std::string pin_name{cur_string()};
+    auto pin_loc = cur_loc();
+    auto pin_id = cell.find_pin(pin_name);
+    if ( pin_id == BAD_ID ) {
+      std::ostringstream buf;
+      buf << pin_name << ": No such pin in '" << name << "'.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, pin_loc,
 			MsgType::Error,
 			"NOPIN01", buf.str());
-	return false;
-      }
+      return false;
+    }
 
-      next_token();
-      tk = cur_token();
-      if ( tk != BlifToken::EQ ) {
-	MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			MsgType::Error,
-			"NOPIN01",
-			"Syntax error: '=' is expected.");
-	return false;
-      }
+    next_token();
+    if ( cur_token() != BlifToken::EQ ) {
+      return syntax_error();
+    }
+    next_token();
+    if ( cur_token() != BlifToken::STRING ) {
+      return syntax_error();
+    }
+    auto id = find_id(cur_string(), cur_loc());
 
-      next_token();
-      tk = cur_token();
-      if ( tk != BlifToken::STRING ) {
-	MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
+    auto& conn_id = pin_id == opin_id ? oid :
+      id_list[std::find(cell.input_list.begin(), cell.input_list.end(),
+			pin_id) - cell.input_list.begin()];
+    if ( conn_id != BAD_ID ) {
+      std::ostringstream buf;
+      buf << pin_name << ": Connected more than once.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, pin_loc,
 			MsgType::Error,
-			"NOPIN01",
-			"Syntax error: string is expected.");
-	return false;
-      }
-
-      auto name2 = cur_string();
-      auto name2_loc = cur_loc();
-      auto id2 = find_id(name2, name2_loc);
-      if ( pin.is_output() ) {
-	oid = id2;
-	oloc = name2_loc;
-	if ( is_defined(id2) ) {
-	  // 二重定義
-	  auto loc = def_loc(id2);
-	  std::ostringstream buf;
-	  buf << name2 << ": Defined more than once. "
-	      << "Previous definition is at " << loc << ".";
-	  MsgMgr::put_msg(__FILE__, __LINE__, name2_loc,
-			  MsgType::Error,
-			  "MLTDEF01", buf.str());
-	  return false;
-	}
-      }
-      else {
-	if ( id_array[pin.input_id()] != -1 ) {
-	  std::ostringstream buf;
-	  buf << name2 << ": Appears more than once.";
-	  MsgMgr::put_msg(__FILE__, __LINE__, name2_loc,
-			  MsgType::Error,
-			  "MLTDEF02", buf.str());
-	  return false;
-	}
-	id_array[pin.input_id()] = id2;
-      }
-      ++ n_pins;
+			"NOPIN02", buf.str());
+      return false;
     }
-    else if ( tk == BlifToken::NL ) {
-      if ( n_pins == 0 ) {
-	MsgMgr::put_msg(__FILE__, __LINE__, cur_loc(),
-			MsgType::Error,
-			"GATEXX",
-			"Syntax error: pin assiments expected.");
-	return false;
-      }
-
-      set_defined(oid, oloc);
-      mModel.set_cell(oid, id_array, cell);
+    conn_id = id;
+    if ( pin_id == opin_id ) {
+      oloc = cur_loc();
+    }
+  }
 
-      // 次のトークンを読み込んでおく
-      next_token();
-      return true;
+  for ( SizeType i = 0; i <= ni; ++ i ) {
+    auto id = i < ni ? id_list[i] : oid;
+    if ( id == BAD_ID ) {
+      auto pin_id = i < ni ? cell.input_list[i] : opin_id;
+      std::ostringstream buf;
+      buf << cell.pin_list[pin_id].name << ": Not connected.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, name_loc,
+			MsgType::Error,
+			"NOPIN03", buf.str());
+      return false;
     }
   }
-  return false;
-#else
-  return read_dummy1();
-#endif
+
+  if ( !check_multi_def(oid, oloc) ) {
+    return false;
+  }
+  new_names(oid, oloc, cell_func(cell_id), id_list);
+
+  // 次のトークンを読んでおく
+  next_token();
+
+  return true;
 }
 
 // @brief .latch 文の読み込みを行う．
@@ -830,15 +1713,7 @@ BlifParser::read_latch()
     auto name2 = cur_string();
     auto name2_loc = cur_loc();
     auto id2 = find_id(name2, name2_loc);
-    if ( is_defined(id2) ) {
-      // 二重定義
-      FileRegion loc = def_loc(id2);
-      std::ostringstream buf;
-      buf << name2 << ": Defined more than once. "
-	  << "Previsous Definition is at " << loc << ".";
-      MsgMgr::put_msg(__FILE__, __LINE__, name2_loc,
-		      MsgType::Error,
-		      "MLTDEF01", buf.str().c_str());
+    if ( !check_multi_def(id2, name2_loc) ) {
       return false;
     }
 
@@ -850,10 +1725,10 @@ BlifParser::read_latch()
       rval = cur_string()[0];
       if ( rval != '0' &&
 	   rval != '1' ) {
-	MsgMgr::put_msg(__FILE__, __LINE__, loc3,
-			MsgType::Error,
-			"SYN18",
-			"Illegal character for reset value.");
+	mMsgQueue.put_msg(__FILE__, __LINE__, loc3,
+			  MsgType::Error,
+			  "SYN18",
+			  "Illegal character for reset value.");
 	return false;
       }
       next_token();
@@ -865,10 +1740,7 @@ BlifParser::read_latch()
       goto ST_LATCH_SYNERROR;
     }
 
-    set_defined(id2, name2_loc);
-    auto dff_id = mModel.new_dff(name2, rval);
-    mModel.set_dff_output(id2, dff_id);
-    mModel.set_dff_src(dff_id, id1);
+    new_latch(id1, id2, name2_loc, rval);
 
     return true;
   }
@@ -878,12 +1750,64 @@ BlifParser::read_latch()
   }
 
  ST_LATCH_SYNERROR:
-  MsgMgr::put_msg(__FILE__, __LINE__, error_loc,
-		  MsgType::Error,
-		  "SYN17", "Syntax error in '.latch' statement.");
+  mMsgQueue.put_msg(__FILE__, __LINE__, error_loc,
+		    MsgType::Error,
+		    "SYN17", "Syntax error in '.latch' statement.");
   return false;
 }
 
+// @brief .subckt 文の読み込みを行う．
+bool
+BlifParser::read_subckt()
+{
+  auto syntax_error = [&]() {
+    mMsgQueue.put_msg(__FILE__, __LINE__, cur_loc(),
+		      MsgType::Error,
+		      "SYN19", "Syntax error in '.subckt' statement.");
+    return false;
+  };
+
+  next_token();
+  if ( cur_token() != BlifToken::STRING ) {
+    return syntax_error();
+  }
+  SubcktInfo info;
+  info.model_name = cur_string();
+  info.loc = cur_loc();
+
+  // (<仮引数名> = <ネット名>)* NL
+  for ( ; ; ) {
+    next_token();
+    auto tk = cur_token();
+    if ( tk == BlifToken::NL ) {
+      break;
+    }
+    if ( tk != BlifToken::STRING ) {
+      return syntax_error();
+    }
+    std::string formal{cur_string()};
+    auto formal_loc = cur_loc();
+    next_token();
+    if ( cur_token() != BlifToken::EQ ) {
+      return syntax_error();
+    }
+    next_token();
+    if ( cur_token() != BlifToken::STRING ) {
+      return syntax_error();
+    }
+    auto id = find_id(cur_string(), cur_loc());
+    info.formal_list.push_back(formal);
+    info.formal_loc_list.push_back(formal_loc);
+    info.actual_list.push_back(id);
+  }
+  mSubcktList.push_back(std::move(info));
+
+  // 次のトークンを読んでおく
+  next_token();
+
+  return true;
+}
+
 // @brief .exdc 文の読み込みを行う．
 bool
 BlifParser::read_exdc()
@@ -921,7 +1845,18 @@ BlifParser::read_dummy1()
 void
 BlifParser::next_token()
 {
+  if ( mHierFound ) {
+    mCurToken = BlifToken::_EOF;
+    return;
+  }
   mCurToken = mScanner->read_token(mCurLoc);
+  if ( mCheckHier &&
+       (mCurToken == BlifToken::SUBCKT ||
+	(mCurToken == BlifToken::MODEL && ++ mModelNum > 1)) ) {
+    // 階層構造を持つファイルなのでここで読み込みを打ち切る．
+    mHierFound = true;
+    mCurToken = BlifToken::_EOF;
+  }
 }
 
 // @brief 直前に読み出したトークンを返す．
@@ -932,7 +1867,7 @@ BlifParser::cur_token() const
 }
 
 // @brief 直前に読み出したトークンが文字列の場合にその文字列を返す．
-std::string
+std::string_view
 BlifParser::cur_string() const
 {
   return mScanner->cur_string();
@@ -9,12 +9,20 @@
 /// All rights reserved.
 
 #include "ym/bn.h"
+#include "ym/BnCellLibrary.h"
+#include "CellFuncMap.h"
+#include "MsgQueue.h"
 #include "BlifScanner.h"
 #include "ModelImpl.h"
+#include "ReadOption.h"
+#include "ProgressReporter.h"
 
 
 BEGIN_NAMESPACE_YM_BN
 
+class BlifChunkReader;
+class HierImpl;
+
 //////////////////////////////////////////////////////////////////////
 /// @class BlifParser BlifParser.h "ym/BlifParser.h"
 /// @brief blif形式のファイルを読み込むパーサークラス
@@ -24,10 +32,26 @@ class BlifParser
 public:
 
   /// @brief コンストラクタ
+  ///
+  /// library が nullptr の場合は .gate 文を扱えない．
   BlifParser(
-    ModelImpl& model ///< [in] 結果を格納するオブジェクト
+    ModelImpl& model,                      ///< [in] 結果を格納するオブジェクト
+    const BnCellLibrary* library = nullptr ///< [in] .gate 文で用いるセルライブラリ
   );
 
+  /// @brief コピーは禁止
+  ///
+  /// mIdDict のキーが mNameDict 中の文字列を指しているため．
+  BlifParser(
+    const BlifParser& src
+  ) = delete;
+
+  /// @brief コピー代入も禁止
+  BlifParser&
+  operator=(
+    const BlifParser& src
+  ) = delete;
+
   /// @brief デストラクタ
   ~BlifParser() = default;
 
@@ -42,7 +66,22 @@ public:
   /// @retval false 読み込みが失敗した．
   bool
   read(
-    const std::string& filename ///< [in] ファイル名
+    const std::string& filename,            ///< [in] ファイル名
+    const ReadOption& option = ReadOption{} ///< [in] 読み込みオプション
+  );
+
+  /// @brief 階層構造を保ったまま読み込みを行う．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  ///
+  /// 各 .model 文がモジュールとなり，.subckt 文がインスタンスとなる．
+  static
+  bool
+  read_hier(
+    const std::string& filename,           ///< [in] ファイル名
+    const ReadOption& option,              ///< [in] 読み込みオプション
+    HierImpl& hier,                        ///< [out] 結果を格納するオブジェクト
+    const BnCellLibrary* library = nullptr ///< [in] .gate 文で用いるセルライブラリ
   );
 
 
@@ -57,17 +96,22 @@ private:
   /// 未登録の場合には新たに作る．
   SizeType
   find_id(
-    const std::string& name, ///< [in] 名前
-    const FileRegion& loc    ///< [in] name の位置
+    const std::string_view& name, ///< [in] 名前
+    const FileRegion& loc         ///< [in] name の位置
   )
   {
-    if ( mIdDict.count(name) > 0 ) {
-      return mIdDict.at(name);
+    // 検索は string_view のまま行い，登録時のみ文字列を確保する．
+    auto p = mIdDict.find(name);
+    if ( p != mIdDict.end() ) {
+      return p->second;
+    }
+    if ( mTrackLoc ) {
+      mRefLocArray.push_back(loc);
     }
-    mRefLocArray.push_back(loc);
+    mDefinedArray.push_back(false);
     auto id = mModel.alloc_node();
-    mIdDict.emplace(name, id);
-    mNameDict.emplace(id, name);
+    auto q = mNameDict.emplace(id, std::string{name}).first;
+    mIdDict.emplace(q->second, id);
     return id;
   }
 
@@ -97,7 +141,11 @@ private:
     const FileRegion& loc ///< [in] 定義位置
   )
   {
-    mDefLocDict.emplace(id, loc);
+    ASSERT_COND( id < mDefinedArray.size() );
+    mDefinedArray[id] = true;
+    if ( mTrackLoc ) {
+      mDefLocDict.emplace(id, loc);
+    }
   }
 
   /// @brief 対応する識別子がすでに定義済みか調べる．
@@ -108,7 +156,8 @@ private:
     SizeType id ///< [in] 識別子番号
   ) const
   {
-    return mDefLocDict.count(id) > 0;
+    ASSERT_COND( id < mDefinedArray.size() );
+    return mDefinedArray[id];
   }
 
   /// @brief 定義位置を返す．
@@ -121,18 +170,223 @@ private:
     return mDefLocDict.at(id);
   }
 
+  /// @brief 位置情報が使えるか調べる．
+  /// @retval true ref_loc(), def_loc() が使える．
+  /// @retval false 位置情報を記録していない．
+  ///
+  /// false の場合は読み直しが必要な印をつける．
+  bool
+  has_loc()
+  {
+    if ( !mTrackLoc ) {
+      mNeedRetry = true;
+    }
+    return mTrackLoc;
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief ファイルを開いて読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read_file(
+    const std::string& filename, ///< [in] ファイル名
+    const ReadOption& option     ///< [in] 読み込みオプション
+  );
+
+  /// @brief 展開中のファイルを展開済みの部分から読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  ///
+  /// 階層構造を持つファイルだった場合は read_flatten() で読み直す．
+  bool
+  read_stream(
+    const MappedFile& fin,    ///< [in] 展開中のファイル
+    const FileInfo& file_info ///< [in] ファイル情報
+  );
+
+  /// @brief 階層構造を持つファイルを読み込んで平坦化する．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read_flatten(
+    const char* begin,        ///< [in] ファイルの先頭
+    const char* end,          ///< [in] ファイルの末尾の次
+    const FileInfo& file_info ///< [in] ファイル情報
+  );
+
+  /// @brief 階層構造を持つファイルか調べる．
+  ///
+  /// .subckt 文を含むか，.model 文を複数含む時に true を返す．
+  /// コメント中や名前の一部に現れるものは数えない．
+  static
+  bool
+  is_hierarchical(
+    const char* begin, ///< [in] ファイルの先頭
+    const char* end    ///< [in] ファイルの末尾の次
+  );
+
+  /// @brief 階層構造を持つファイルの内容を読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  static
+  bool
+  read_hier_body(
+    const char* begin,            ///< [in] ファイルの先頭
+    const char* end,              ///< [in] ファイルの末尾の次
+    const FileInfo& file_info,    ///< [in] ファイル情報
+    const BnCellLibrary* library, ///< [in] セルライブラリ
+    HierImpl& hier                ///< [out] 結果を格納するオブジェクト
+  );
+
+  /// @brief .subckt 文の接続を解決する．
+  /// @retval true 正しく解決できた．
+  /// @retval false エラーが起こった．
+  ///
+  /// 下位モジュールの入力につながるノードは疑似出力に，
+  /// 出力につながるノードは疑似入力にする．
+  bool
+  resolve_subckt(
+    HierImpl& hier,    ///< [in] 階層構造
+    SizeType module_id ///< [in] このパーサーが読み込んだモジュール番号
+  );
+
+  /// @brief 分割したファイルを並列に読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read_parallel(
+    const char* begin,                         ///< [in] ファイルの先頭
+    const char* end,                           ///< [in] ファイルの末尾の次
+    const FileInfo& file_info,                 ///< [in] ファイル情報
+    const std::vector<const char*>& split_list ///< [in] 分割位置のリスト
+  );
+
+  /// @brief 指定された出力の推移的ファンインのみを読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  ///
+  /// BlifConeIndex で文の位置を調べてから必要な文のみを読み込む．
+  /// 読み飛ばした文の構文エラーは検出されない．
+  bool
+  read_cone(
+    const char* begin,                          ///< [in] ファイルの先頭
+    const char* end,                            ///< [in] ファイルの末尾の次
+    const FileInfo& file_info,                  ///< [in] ファイル情報
+    const std::vector<std::string>& output_list ///< [in] 出力名のリスト
+  );
+
+  /// @brief チャンクの読み込み結果を取り込む．
+  /// @retval true 正しく取り込んだ．
+  /// @retval false エラーが起こった．
+  bool
+  merge_chunk(
+    const BlifChunkReader& reader ///< [in] チャンクの読み込み結果
+  );
+
+  /// @brief .end 文もしくは stop_pos までの読み込みを行う．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false エラーが起こった．
+  ///
+  /// 文の先頭が stop_pos に一致したらそこで読み込みを中断して
+  /// stopped を true にする．
+  /// stop_pos が nullptr の場合は最後まで読み込む．
+  bool
+  read_body(
+    const char* stop_pos, ///< [in] 中断する位置
+    bool& stopped         ///< [out] 中断した時 true を設定する．
+  );
+
+  /// @brief 読み込みの終了処理を行う．
+  /// @retval true 正しく終了した．
+  /// @retval false 未定義の名前があった．
+  bool
+  end_read();
+
+  /// @brief 予期せぬ EOF の警告を出す．
+  void
+  warn_unexpected_eof(
+    const FileRegion& loc ///< [in] EOF の位置
+  );
+
+  /// @brief 二重定義のチェックを行う．
+  /// @retval true 未定義だった．
+  /// @retval false 既に定義されていた．
+  ///
+  /// 既に定義されていた場合はエラーメッセージを出力する．
+  bool
+  check_multi_def(
+    SizeType id,          ///< [in] ID番号
+    const FileRegion& loc ///< [in] 今回の定義位置
+  );
+
+  /// @brief .names 文の内容を設定する．
+  void
+  new_names(
+    SizeType oid,                              ///< [in] 出力のID番号
+    const FileRegion& loc,                     ///< [in] 出力の定義位置
+    SizeType func_id,                          ///< [in] 関数番号
+    const std::vector<SizeType>& fanin_id_list ///< [in] ファンインのID番号のリスト
+  );
+
+  /// @brief セルの関数番号を返す．
+  ///
+  /// 関数はセルごとに1度だけ登録する．
+  SizeType
+  cell_func(
+    SizeType cell_id ///< [in] セル番号
+  );
+
+  /// @brief .latch 文の内容を設定する．
+  void
+  new_latch(
+    SizeType src_id,       ///< [in] 入力のID番号
+    SizeType oid,          ///< [in] 出力のID番号
+    const FileRegion& loc, ///< [in] 出力の定義位置
+    char rval              ///< [in] リセット値
+  );
+
+  /// @brief ファイルの内容を分割する．
+  /// @return 分割位置のリストを返す．
+  ///
+  /// 最初の要素は最初の .names/.latch/.gate 文の位置，
+  /// 最後の要素は end となる．
+  /// 分割できない場合は空のリストを返す．
+  static
+  std::vector<const char*>
+  split_chunks(
+    const char* begin, ///< [in] ファイルの先頭
+    const char* end,   ///< [in] ファイルの末尾の次
+    SizeType chunk_num ///< [in] 分割数
+  );
+
+  /// @brief 行数を数える．
+  static
+  int
+  count_lines(
+    const char* begin, ///< [in] 先頭
+    const char* end    ///< [in] 末尾の次
+  );
+
   /// @brief .model 文の読み込みを行う．
   /// @retval true 正しく読み込んだ．
   /// @retval false エラーが起こった．
   bool
   read_model();
 
+  /// @brief .model 文のモデル名以降の読み込みを行う．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false エラーが起こった．
+  ///
+  /// 現在のトークンが .model であると仮定している．
+  bool
+  read_model_name();
+
   /// @brief .inputs 文の読み込みを行う．
   /// @retval true 正しく読み込んだ．
   /// @retval false エラーが起こった．
@@ -163,6 +417,14 @@ private:
   bool
   read_latch();
 
+  /// @brief .subckt 文の読み込みを行う．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false エラーが起こった．
+  ///
+  /// 接続の解決は resolve_subckt() で行う．
+  bool
+  read_subckt();
+
   /// @brief .exdc 文の読み込みを行う．
   /// @retval true 正しく読み込んだ．
   /// @retval false エラーが起こった．
@@ -176,6 +438,9 @@ private:
   read_dummy1();
 
   /// @brief 次のトークンを読み出す．
+  ///
+  /// mCheckHier が true の時に .subckt 文か2つめの .model 文を
+  /// 読み出したら mHierFound を true にして以降は EOF を返す．
   void
   next_token();
 
@@ -184,7 +449,9 @@ private:
   cur_token() const;
 
   /// @brief 直前に読み出したトークンが文字列の場合にその文字列を返す．
-  std::string
+  ///
+  /// 次のトークンを読み出すまでの間のみ有効．
+  std::string_view
   cur_string() const;
 
   /// @brief 直前に読み出したトークンの位置を返す．
@@ -192,6 +459,31 @@ private:
   cur_loc() const;
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // .subckt 文の情報
+  struct SubcktInfo
+  {
+    // モデル名
+    std::string model_name;
+
+    // モデル名の位置
+    FileRegion loc;
+
+    // 仮引数名のリスト
+    std::vector<std::string> formal_list;
+
+    // 仮引数の位置のリスト
+    std::vector<FileRegion> formal_loc_list;
+
+    // 実引数のID番号のリスト
+    std::vector<SizeType> actual_list;
+  };
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -204,6 +496,14 @@ private:
   // 結果を格納するオブジェクト
   ModelImpl& mModel;
 
+  // .gate 文で用いるセルライブラリ
+  const BnCellLibrary* mLibrary;
+
+  // セル番号から関数番号への変換表
+  //
+  // 最初の .gate 文で作られる．
+  std::unique_ptr<CellFuncMap> mCellFuncMap;
+
   // 現在のトークン
   BlifToken mCurToken;
 
@@ -213,18 +513,66 @@ private:
   // モデル名
   std::string mModelName;
 
+  // モデル名の位置
+  FileRegion mModelLoc;
+
+  // 階層構造を読み込んでいる時 true にする．
+  bool mHierMode{false};
+
+  // 平坦なモデルとして読みながら階層構造を持つか調べる時 true にする．
+  bool mCheckHier{false};
+
+  // mCheckHier が true の時に階層構造を持つことがわかったら true にする．
+  bool mHierFound{false};
+
+  // mCheckHier が true の時に読み出した .model 文の数
+  SizeType mModelNum{0};
+
+  // .subckt 文のリスト
+  std::vector<SubcktInfo> mSubcktList;
+
   // 名前をキーにしたノード番号の辞書
-  std::unordered_map<std::string, SizeType> mIdDict;
+  //
+  // キーは mNameDict 中の文字列を指している．
+  // unordered_map の要素は再ハッシュで移動しないので無効にならない．
+  std::unordered_map<std::string_view, SizeType> mIdDict;
 
   // ID番号をキーにした名前の辞書
   std::unordered_map<SizeType, std::string> mNameDict;
 
+  // 参照位置と定義位置を記録する時 true
+  bool mTrackLoc{true};
+
+  // 位置情報を記録しながら読み直す必要がある時 true
+  bool mNeedRetry{false};
+
+  // 定義済みの印を ID番号ごとに格納する配列
+  std::vector<bool> mDefinedArray;
+
   // ノードを参照している箇所の配列
+  //
+  // mTrackLoc が true の時のみ用いる．
   std::vector<FileRegion> mRefLocArray;
 
   // ノードを定義している箇所の辞書
+  //
+  // mTrackLoc が true の時のみ用いる．
   std::unordered_map<SizeType, FileRegion> mDefLocDict;
 
+  // 読み込む出力名をキーにして .outputs 文に現れたかを格納する辞書
+  //
+  // 空の場合は全ての出力を読み込む．
+  std::unordered_map<std::string, bool> mOutputFilter;
+
+  // メッセージの出力を保留するためのオブジェクト
+  MsgQueue mMsgQueue;
+
+  // ファイルの先頭
+  const char* mFileTop{nullptr};
+
+  // 進捗の通知先
+  ProgressReporter mProgress;
+
 };
 
 END_NAMESPACE_YM_BN
@@ -16,6 +16,118 @@ BEGIN_NONAMESPACE
 // read_token() の動作をデバッグするときに true にする．
 const bool debug_read_token = false;
 
+// 予約語
+struct Keyword
+{
+  // 先頭の '.' を除いた文字列
+  std::string_view name;
+
+  // トークン
+  BlifToken token;
+};
+
+// 予約語のリスト
+constexpr Keyword KEYWORD_LIST[] = {
+  {"model", BlifToken::MODEL},
+  {"inputs", BlifToken::INPUTS},
+  {"outputs", BlifToken::OUTPUTS},
+  {"clock", BlifToken::CLOCK},
+  {"end", BlifToken::END},
+  {"names", BlifToken::NAMES},
+  {"exdc", BlifToken::EXDC},
+  {"latch", BlifToken::LATCH},
+  {"gate", BlifToken::GATE},
+  {"mlatch", BlifToken::MLATCH},
+  {"subckt", BlifToken::SUBCKT},
+  {"search", BlifToken::SEARCH},
+  {"start_kiss", BlifToken::START_KISS},
+  {"i", BlifToken::I},
+  {"o", BlifToken::O},
+  {"p", BlifToken::P},
+  {"r", BlifToken::R},
+  {"end_kiss", BlifToken::END_KISS},
+  {"latch_order", BlifToken::LATCH_ORDER},
+  {"code", BlifToken::CODE},
+  {"cycle", BlifToken::CYCLE},
+  {"clock_event", BlifToken::CLOCK_EVENT},
+  {"area", BlifToken::AREA},
+  {"delay", BlifToken::DELAY},
+  {"wire_load_slope", BlifToken::WIRE_LOAD_SLOPE},
+  {"wire", BlifToken::WIRE},
+  {"input_arrival", BlifToken::INPUT_ARRIVAL},
+  {"default_input_arrival", BlifToken::DEFAULT_INPUT_ARRIVAL},
+  {"output_required", BlifToken::OUTPUT_REQUIRED},
+  {"default_output_required", BlifToken::DEFAULT_OUTPUT_REQUIRED},
+  {"input_drive", BlifToken::INPUT_DRIVE},
+  {"default_input_drive", BlifToken::DEFAULT_INPUT_DRIVE},
+  {"output_load", BlifToken::OUTPUT_LOAD},
+  {"default_output_load", BlifToken::DEFAULT_OUTPUT_LOAD}
+};
+
+// 予約語の数
+constexpr SizeType KEYWORD_NUM = sizeof(KEYWORD_LIST) / sizeof(Keyword);
+
+// ハッシュ表のサイズ
+constexpr SizeType HASH_SIZE = 128;
+
+// 予約語のハッシュ関数
+//
+// 長さと先頭と末尾の文字のみを用いる．
+// KEYWORD_LIST に対して衝突しないことはコンパイル時に検査する．
+constexpr
+SizeType
+keyword_hash(
+  const std::string_view& word
+)
+{
+  return (word.size() +
+	  (static_cast<SizeType>(static_cast<unsigned char>(word.front())) << 2) +
+	  (static_cast<SizeType>(static_cast<unsigned char>(word.back())) << 1))
+    % HASH_SIZE;
+}
+
+// ハッシュ値をキーにして KEYWORD_LIST 中の位置を格納する表
+struct KeywordTable
+{
+  // 位置(該当する予約語がない場合は -1)
+  int pos[HASH_SIZE];
+};
+
+// KeywordTable を作る．
+constexpr
+KeywordTable
+make_keyword_table()
+{
+  KeywordTable table{};
+  for ( SizeType h = 0; h < HASH_SIZE; ++ h ) {
+    table.pos[h] = -1;
+  }
+  for ( SizeType i = 0; i < KEYWORD_NUM; ++ i ) {
+    table.pos[keyword_hash(KEYWORD_LIST[i].name)] = i;
+  }
+  return table;
+}
+
+// keyword_hash() が KEYWORD_LIST に対して衝突しない時 true を返す．
+constexpr
+bool
+is_perfect_hash()
+{
+  auto table = make_keyword_table();
+  for ( SizeType i = 0; i < KEYWORD_NUM; ++ i ) {
+    if ( table.pos[keyword_hash(KEYWORD_LIST[i].name)] != static_cast<int>(i) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert( is_perfect_hash(),
+	       "keyword_hash() has collisions in KEYWORD_LIST" );
+
+// 予約語のハッシュ表
+constexpr KeywordTable KEYWORD_TABLE = make_keyword_table();
+
 END_NONAMESPACE
 
 
@@ -25,43 +137,12 @@ END_NONAMESPACE
 
 // @brief コンストラクタ
 BlifScanner::BlifScanner(
-  std::istream& s,
-  const FileInfo& file_info
-) : Scanner(s, file_info),
-    mDic{ {"model", BlifToken::MODEL},
-	  {"inputs", BlifToken::INPUTS},
-	  {"outputs", BlifToken::OUTPUTS},
-	  {"clock", BlifToken::CLOCK},
-	  {"end", BlifToken::END},
-	  {"names", BlifToken::NAMES},
-	  {"exdc", BlifToken::EXDC},
-	  {"latch", BlifToken::LATCH},
-	  {"gate", BlifToken::GATE},
-	  {"mlatch", BlifToken::MLATCH},
-	  {"subckt", BlifToken::SUBCKT},
-	  {"search", BlifToken::SEARCH},
-	  {"start_kiss", BlifToken::START_KISS},
-	  {"i", BlifToken::I},
-	  {"o", BlifToken::O},
-	  {"p", BlifToken::P},
-	  {"r", BlifToken::R},
-	  {"end_kiss", BlifToken::END_KISS},
-	  {"latch_order", BlifToken::LATCH_ORDER},
-	  {"code", BlifToken::CODE},
-	  {"cycle", BlifToken::CYCLE},
-	  {"clock_event", BlifToken::CLOCK_EVENT},
-	  {"area", BlifToken::AREA},
-	  {"delay", BlifToken::DELAY},
-	  {"wire_load_slope", BlifToken::WIRE_LOAD_SLOPE},
-	  {"wire", BlifToken::WIRE},
-	  {"input_arrival", BlifToken::INPUT_ARRIVAL},
-	  {"default_input_arrival", BlifToken::DEFAULT_INPUT_ARRIVAL},
-	  {"output_required", BlifToken::OUTPUT_REQUIRED},
-	  {"default_output_required", BlifToken::DEFAULT_OUTPUT_REQUIRED},
-	  {"input_drive", BlifToken::INPUT_DRIVE},
-	  {"default_input_drive", BlifToken::DEFAULT_INPUT_DRIVE},
-	  {"output_load", BlifToken::OUTPUT_LOAD},
-	  {"default_output_load", BlifToken::DEFAULT_OUTPUT_LOAD} }
+  const char* begin,
+  const char* end,
+  const FileInfo& file_info,
+  int line,
+  int column
+) : BufScanner(begin, end, file_info, line, column)
 {
 }
 
@@ -92,8 +173,9 @@ BlifScanner::read_token(
 BlifToken
 BlifScanner::scan()
 {
-  mCurString = "";
+  mCurString = {};
   bool StartWithDot = false;
+  const char* start;
   int c;
 
   // 状態遷移を goto 文で表現したもの
@@ -120,6 +202,7 @@ BlifScanner::scan()
 
   case '.':
     StartWithDot = true;
+    start = cur_ptr();
     goto ST_STR;
 
   case '#':
@@ -131,14 +214,14 @@ BlifScanner::scan()
       // ここまでで "/*" を読んでいる．
       goto ST_CM1;
     }
-    mCurString += '/';
+    start = cur_ptr() - 1;
     goto ST_STR;
 
   case '\\':
     goto ST_ESC;
 
   default:
-    mCurString += static_cast<char>(c);
+    start = cur_ptr() - 1;
     goto ST_STR;
   }
 
@@ -186,27 +269,25 @@ BlifScanner::scan()
     return check_word(StartWithDot);
   }
   // それ以外は普通の文字として扱う．
-  mCurString += static_cast<char>(c);
+  start = cur_ptr() - 1;
   goto ST_STR;
 
  ST_STR:
-  c = peek();
-  switch ( c ) {
-  case ' ':
-  case '\t':
-  case '\n':
-  case '=':
-  case '#':
-  case '\\':
-  case EOF:
-    // 文字列の終わり
-    return check_word(StartWithDot);
+  // 文字列の終わりまでまとめて読み進める．
+  // 単語は常に入力中の連続した領域となる．
+  scan_word(start);
+  return check_word(StartWithDot);
+}
 
-  default:
-    accept();
-    mCurString += static_cast<char>(c);
-    goto ST_STR;
-  }
+// @brief 区切り文字の直前まで読み進めて mCurString に設定する．
+void
+BlifScanner::scan_word(
+  const char* start
+)
+{
+  auto p = find_delimiter(cur_ptr(), end_ptr());
+  mCurString = std::string_view{start, static_cast<SizeType>(p - start)};
+  advance(p);
 }
 
 // @brief 予約後の検査をする．
@@ -215,11 +296,11 @@ BlifScanner::check_word(
   bool start_with_dot
 )
 {
-  if ( start_with_dot ) {
+  if ( start_with_dot && !mCurString.empty() ) {
     // 予約後の検索
-    auto p = mDic.find(std::string{cur_string()});
-    if ( p != mDic.end() ) {
-      return p->second;
+    auto pos = KEYWORD_TABLE.pos[keyword_hash(mCurString)];
+    if ( pos >= 0 && KEYWORD_LIST[pos].name == mCurString ) {
+      return KEYWORD_LIST[pos].token;
     }
   }
   return BlifToken::STRING;
@@ -9,8 +9,11 @@
 /// All rights reserved.
 
 #include "ym/bn.h"
-#include "ym/Scanner.h"
+#include "BufScanner.h"
 #include "BlifToken.h"
+#include <cstdint>
+#include <cstring>
+#include <string_view>
 
 
 BEGIN_NAMESPACE_YM_BN
@@ -18,16 +21,23 @@ BEGIN_NAMESPACE_YM_BN
 //////////////////////////////////////////////////////////////////////
 /// @class BlifScanner BlifScanner.h "BlifScanner.h"
 /// @brief blif 用の字句解析器
+///
+/// 入力はメモリ上に展開された内容([begin, end))を対象とする．
+/// 文字列のトークンは入力の内容を直接指す std::string_view で表すので
+/// コピーは行わない．
 //////////////////////////////////////////////////////////////////////
 class BlifScanner :
-  public Scanner
+  public BufScanner
 {
 public:
 
   /// @brief コンストラクタ
   BlifScanner(
-    std::istream& s,          ///< [in] 入力ストリーム
-    const FileInfo& file_info ///< [in] ファイル情報
+    const char* begin,         ///< [in] 内容の先頭
+    const char* end,           ///< [in] 内容の末尾の次
+    const FileInfo& file_info, ///< [in] ファイル情報
+    int line = 1,              ///< [in] 先頭の文字の行番号
+    int column = 1             ///< [in] 先頭の文字のコラム番号
   );
 
   /// @brief デストラクタ
@@ -46,8 +56,52 @@ public:
   );
 
   /// @brief 最後の get_token() で読み出した字句の文字列を返す．
-  std::string
-  cur_string() { return mCurString; }
+  ///
+  /// 内容は入力のバッファを指しているので，バッファが有効な間のみ
+  /// 用いることができる．
+  std::string_view
+  cur_string() const
+  {
+    return mCurString;
+  }
+
+  /// @brief 単語の区切り文字の時 true を返す．
+  static
+  bool
+  is_delimiter(
+    char c ///< [in] 文字
+  )
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+      c == '=' || c == '#' || c == '\\';
+  }
+
+  /// @brief 最初の区切り文字の位置を返す．
+  ///
+  /// 見つからなければ end を返す．
+  /// 8バイトずつまとめて区切り文字を含むか調べるので，
+  /// 長い単語ほど速く読み飛ばせる．
+  static
+  const char*
+  find_delimiter(
+    const char* begin, ///< [in] 探索範囲の先頭
+    const char* end    ///< [in] 探索範囲の末尾の次
+  )
+  {
+    auto p = begin;
+    while ( end - p >= 8 ) {
+      std::uint64_t x;
+      std::memcpy(&x, p, 8);
+      if ( may_have_delimiter(x) ) {
+	break;
+      }
+      p += 8;
+    }
+    while ( p != end && !is_delimiter(*p) ) {
+      ++ p;
+    }
+    return p;
+  }
 
 
 private:
@@ -60,6 +114,12 @@ private:
   BlifToken
   scan();
 
+  /// @brief 区切り文字の直前まで読み進めて mCurString に設定する．
+  void
+  scan_word(
+    const char* start ///< [in] 単語の先頭
+  );
+
   /// @brief 予約後の検査をする．
   /// @return トークンを返す．
   BlifToken
@@ -67,17 +127,35 @@ private:
     bool start_with_dot ///< [in] '.' で始まっている時に true を渡す．
   );
 
+  /// @brief 8バイト中に区切り文字が含まれている可能性がある時 true を返す．
+  ///
+  /// false の時は確実に含まれていない．
+  /// 区切り文字以外の制御文字を含む場合も true を返す．
+  static
+  bool
+  may_have_delimiter(
+    std::uint64_t x ///< [in] 8バイト分の内容
+  )
+  {
+    const std::uint64_t ONES = 0x0101010101010101ULL;
+    const std::uint64_t HIGHS = 0x8080808080808080ULL;
+    // ' ', '\t', '\n', '\r' は 0x21 未満のバイトとしてまとめて調べる．
+    auto lt = (x - ONES * 0x21) & ~x;
+    auto y1 = x ^ (ONES * '=');
+    auto y2 = x ^ (ONES * '#');
+    auto y3 = x ^ (ONES * '\\');
+    auto z = ((y1 - ONES) & ~y1) | ((y2 - ONES) & ~y2) | ((y3 - ONES) & ~y3);
+    return ((lt | z) & HIGHS) != 0;
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 予約語テーブル
-  std::unordered_map<std::string, BlifToken> mDic;
-
-  // 文字列バッファ
-  std::string mCurString;
+  // 最後に読み出した文字列
+  std::string_view mCurString;
 
 };
 
@@ -0,0 +1,354 @@
+
+/// @file BlifWriter.cc
+/// @brief BlifWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BlifWriter.h"
+#include "BufWriter.h"
+#include "FuncImpl.h"
+#include "Isop.h"
+#include "ym/BnModel.h"
+#include "ym/SopCover.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/Bdd.h"
+#include "ym/BddVar.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 1行の長さの目安
+const SizeType LINE_LIMIT = 72;
+
+// 入力パタンと出力値から1行を作る．
+inline
+void
+put_row(
+  std::string& buf,
+  const std::string& pat,
+  char ochar
+)
+{
+  if ( !pat.empty() ) {
+    buf += pat;
+    buf += ' ';
+  }
+  buf += ochar;
+  buf += '\n';
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief blif 形式で出力する．
+void
+BnModel::write_blif(
+  std::ostream& s
+) const
+{
+  BlifWriter writer{_model_impl()};
+  writer.write(s);
+}
+
+// @brief blif 形式でファイルに出力する．
+void
+BnModel::write_blif(
+  const std::string& filename
+) const
+{
+  write_file(filename, "write_blif",
+	     [&](std::ostream& s){ write_blif(s); });
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BlifWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BlifWriter::BlifWriter(
+  const ModelImpl& model
+) : mModel{model},
+    mNameMgr{model},
+    mCoverArray(model.func_num()),
+    mCoverDone(model.func_num(), false)
+{
+}
+
+// @brief blif 形式で出力する．
+void
+BlifWriter::write(
+  std::ostream& s
+)
+{
+  BufWriter w{s};
+
+  for ( auto& comment: mModel.comment_list() ) {
+    w.put("# ");
+    w.put(comment);
+    w.put('\n');
+  }
+
+  w.put(".model ");
+  if ( mModel.name() == std::string{} ) {
+    w.put("top");
+  }
+  else {
+    w.put(mModel.name());
+  }
+  w.put('\n');
+
+  std::vector<std::string> input_names;
+  input_names.reserve(mModel.input_num());
+  for ( auto id: mModel.input_id_list() ) {
+    input_names.push_back(mNameMgr.node_name(id));
+  }
+  write_name_list(w, ".inputs", input_names);
+  write_name_list(w, ".outputs", mNameMgr.output_name_list());
+
+  for ( SizeType i = 0; i < mModel.dff_num(); ++ i ) {
+    auto& dff = mModel.dff_impl(i);
+    w.put(".latch ");
+    w.put(mNameMgr.node_name(dff.src_id));
+    w.put(' ');
+    w.put(mNameMgr.node_name(dff.id));
+    if ( dff.reset_val == '0' || dff.reset_val == '1' ) {
+      w.put(' ');
+      w.put(dff.reset_val);
+    }
+    w.put('\n');
+  }
+
+  for ( auto id: mModel.logic_id_list() ) {
+    auto& node = mModel.node_impl(id);
+    w.put(".names");
+    for ( auto iid: node.fanin_id_list() ) {
+      w.put(' ');
+      w.put(mNameMgr.node_name(iid));
+    }
+    w.put(' ');
+    w.put(mNameMgr.node_name(id));
+    w.put('\n');
+    w.put(cover_str(node.func_id()));
+  }
+
+  // ノード名と異なる名前の出力にはバッファを挿入する．
+  for ( SizeType i = 0; i < mModel.output_num(); ++ i ) {
+    auto& src_name = mNameMgr.node_name(mModel.output_id(i));
+    auto& oname = mNameMgr.output_name(i);
+    if ( oname != src_name ) {
+      w.put(".names ");
+      w.put(src_name);
+      w.put(' ');
+      w.put(oname);
+      w.put("\n1 1\n");
+    }
+  }
+
+  w.put(".end\n");
+}
+
+// @brief 関数に対応するカバーの文字列を返す．
+const std::string&
+BlifWriter::cover_str(
+  SizeType func_id
+)
+{
+  if ( !mCoverDone[func_id] ) {
+    mCoverArray[func_id] = make_cover_str(mModel.func_impl(func_id));
+    mCoverDone[func_id] = true;
+  }
+  return mCoverArray[func_id];
+}
+
+// @brief 関数をカバーの文字列に変換する．
+std::string
+BlifWriter::make_cover_str(
+  const FuncImpl& func
+)
+{
+  if ( func.is_primitive() ) {
+    return primitive_cover_str(func.primitive_type(), func.input_num());
+  }
+  if ( func.is_cover() ) {
+    return sop_cover_str(func.input_cover(), func.output_inv());
+  }
+  if ( func.is_expr() ) {
+    return tvfunc_cover_str(func.expr().tvfunc(func.input_num()));
+  }
+  if ( func.is_tvfunc() ) {
+    return tvfunc_cover_str(func.tvfunc());
+  }
+  if ( func.is_bdd() ) {
+    // サポート変数の順番がファンインの順番に対応している．
+    auto bdd = func.bdd();
+    return tvfunc_cover_str(bdd.to_truth(bdd.get_support_list()));
+  }
+  throw std::logic_error{"BlifWriter: unknown function type"};
+}
+
+// @brief プリミティブ型の関数をカバーの文字列に変換する．
+std::string
+BlifWriter::primitive_cover_str(
+  PrimType primitive_type,
+  SizeType input_num
+)
+{
+  std::string buf;
+  switch ( primitive_type ) {
+  case PrimType::None:
+    break;
+
+  case PrimType::C0:
+    // 空のカバーは定数0を表す．
+    break;
+
+  case PrimType::C1:
+    put_row(buf, std::string(input_num, '-'), '1');
+    break;
+
+  case PrimType::Buff:
+    put_row(buf, "1", '1');
+    break;
+
+  case PrimType::Not:
+    put_row(buf, "0", '1');
+    break;
+
+  case PrimType::And:
+    put_row(buf, std::string(input_num, '1'), '1');
+    break;
+
+  case PrimType::Nand:
+    put_row(buf, std::string(input_num, '1'), '0');
+    break;
+
+  case PrimType::Or:
+    put_row(buf, std::string(input_num, '0'), '0');
+    break;
+
+  case PrimType::Nor:
+    put_row(buf, std::string(input_num, '0'), '1');
+    break;
+
+  case PrimType::Xor:
+  case PrimType::Xnor:
+    {
+      // パリティが奇数(Xnor なら偶数)の最小項を列挙する．
+      SizeType parity = primitive_type == PrimType::Xor ? 1 : 0;
+      std::string pat(input_num, '0');
+      SizeType np = 1 << input_num;
+      for ( SizeType p = 0; p < np; ++ p ) {
+	SizeType count = 0;
+	for ( SizeType i = 0; i < input_num; ++ i ) {
+	  if ( p & (1 << i) ) {
+	    pat[i] = '1';
+	    ++ count;
+	  }
+	  else {
+	    pat[i] = '0';
+	  }
+	}
+	if ( (count % 2) == parity ) {
+	  put_row(buf, pat, '1');
+	}
+      }
+    }
+    break;
+  }
+  return buf;
+}
+
+// @brief SopCover をカバーの文字列に変換する．
+std::string
+BlifWriter::sop_cover_str(
+  const SopCover& cover,
+  bool output_inv
+)
+{
+  auto nc = cover.cube_num();
+  auto ni = cover.variable_num();
+  auto ochar = output_inv ? '0' : '1';
+  std::string buf;
+  if ( nc == 0 ) {
+    if ( output_inv ) {
+      // 空のカバーの否定は定数1
+      put_row(buf, std::string(ni, '-'), '1');
+    }
+    return buf;
+  }
+  buf.reserve(nc * (ni + 3));
+  std::string pat(ni, '-');
+  for ( SizeType c = 0; c < nc; ++ c ) {
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      switch ( cover.get_pat(c, i) ) {
+      case SopPat::_X: pat[i] = '-'; break;
+      case SopPat::_0: pat[i] = '0'; break;
+      case SopPat::_1: pat[i] = '1'; break;
+      }
+    }
+    put_row(buf, pat, ochar);
+  }
+  return buf;
+}
+
+// @brief 真理値表をカバーの文字列に変換する．
+std::string
+BlifWriter::tvfunc_cover_str(
+  const TvFunc& func
+)
+{
+  // オンセットとオフセットのうちキューブ数の少ない方を用いる．
+  // ただし定数1はオフセットでは表せない．
+  auto on_cubes = isop(func);
+  auto off_cubes = isop(~func);
+  std::string buf;
+  if ( off_cubes.empty() || on_cubes.size() <= off_cubes.size() ) {
+    for ( auto& pat: on_cubes ) {
+      put_row(buf, pat, '1');
+    }
+  }
+  else {
+    for ( auto& pat: off_cubes ) {
+      put_row(buf, pat, '0');
+    }
+  }
+  return buf;
+}
+
+// @brief 名前のリストを出力する．
+void
+BlifWriter::write_name_list(
+  BufWriter& w,
+  const char* keyword,
+  const std::vector<std::string>& names
+)
+{
+  if ( names.empty() ) {
+    return;
+  }
+  std::string_view kwd{keyword};
+  w.put(kwd);
+  SizeType len = kwd.size();
+  for ( auto& name: names ) {
+    if ( len + name.size() + 1 > LINE_LIMIT && len > kwd.size() ) {
+      w.put(" \\\n ");
+      len = 1;
+    }
+    w.put(' ');
+    w.put(name);
+    len += name.size() + 1;
+  }
+  w.put('\n');
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,133 @@
+#ifndef BLIFWRITER_H
+#define BLIFWRITER_H
+
+/// @file BlifWriter.h
+/// @brief BlifWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ModelImpl.h"
+#include "NameMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class BufWriter;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BlifWriter BlifWriter.h "BlifWriter.h"
+/// @brief BnModel を blif 形式で出力するクラス
+///
+/// 論理ノードの関数は .names 文のカバー(の本体部分)に変換する．
+/// 変換結果は関数番号ごとにキャッシュするので，
+/// 同じ関数を持つノードが多数あっても変換は1回で済む．
+/// - カバー型: そのまま出力する．
+/// - プリミティブ型: 対応するカバーを直接作る．
+/// - 論理式/真理値表/BDD: 真理値表から非冗長積和形を求める．
+///
+/// ノード名の割り当ては NameMgr で行う．
+//////////////////////////////////////////////////////////////////////
+class BlifWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  BlifWriter(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief デストラクタ
+  ~BlifWriter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief blif 形式で出力する．
+  void
+  write(
+    std::ostream& s ///< [in] 出力先のストリーム
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 関数に対応するカバーの文字列を返す．
+  ///
+  /// 結果はキャッシュされる．
+  const std::string&
+  cover_str(
+    SizeType func_id ///< [in] 関数番号
+  );
+
+  /// @brief 関数をカバーの文字列に変換する．
+  std::string
+  make_cover_str(
+    const FuncImpl& func ///< [in] 関数
+  );
+
+  /// @brief プリミティブ型の関数をカバーの文字列に変換する．
+  static
+  std::string
+  primitive_cover_str(
+    PrimType primitive_type, ///< [in] プリミティブの種類
+    SizeType input_num       ///< [in] 入力数
+  );
+
+  /// @brief SopCover をカバーの文字列に変換する．
+  static
+  std::string
+  sop_cover_str(
+    const SopCover& cover, ///< [in] 入力カバー
+    bool output_inv        ///< [in] 出力の反転属性
+  );
+
+  /// @brief 真理値表をカバーの文字列に変換する．
+  static
+  std::string
+  tvfunc_cover_str(
+    const TvFunc& func ///< [in] 真理値表
+  );
+
+  /// @brief 名前のリストを出力する．
+  ///
+  /// 長くなる場合には継続行に分ける．
+  void
+  write_name_list(
+    BufWriter& w,                          ///< [in] 出力先
+    const char* keyword,                   ///< [in] キーワード
+    const std::vector<std::string>& names  ///< [in] 名前のリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のモデル
+  const ModelImpl& mModel;
+
+  // ノード名の管理
+  NameMgr mNameMgr;
+
+  // 関数番号をキーにしてカバーの文字列を格納する配列
+  std::vector<std::string> mCoverArray;
+
+  // mCoverArray の内容が設定済みの時 true となる配列
+  std::vector<bool> mCoverDone;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BLIFWRITER_H
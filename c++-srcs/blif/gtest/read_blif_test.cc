@@ -7,10 +7,151 @@
 /// All rights reserved.
 
 #include <gtest/gtest.h>
-#include "ym/BnModel.h"
+#include "ym/JsonValue.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include "BnTestUtil.h"
 
 
-BEGIN_NAMESPACE_YM
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// option を指定して読み込み，結果とメッセージを文字列で返す．
+bool
+read_with_option(
+  const std::string& path,
+  const JsonValue& option,
+  std::string& result,
+  std::string& msg
+)
+{
+  std::ostringstream msg_buf;
+  StreamMsgHandler msg_handler(msg_buf);
+  MsgMgr::attach_handler(&msg_handler);
+  bool ok = true;
+  try {
+    auto model = BnModel::read_blif(path, option);
+    std::ostringstream buf;
+    model.print(buf);
+    result = buf.str();
+  }
+  catch ( const std::invalid_argument& ) {
+    ok = false;
+  }
+  MsgMgr::detach_handler(&msg_handler);
+  msg = msg_buf.str();
+  return ok;
+}
+
+// thread_num を指定して読み込み，結果とメッセージを文字列で返す．
+bool
+read_with_threads(
+  const std::string& path,
+  int thread_num,
+  std::string& result,
+  std::string& msg
+)
+{
+  auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+      {"thread_num", JsonValue{thread_num}}}};
+  return read_with_option(path, option, result, msg);
+}
+
+// 逐次的に読み込んだ場合と並列に読み込んだ場合を比較する．
+void
+check_parallel(
+  const std::string& path,
+  bool exp_ok
+)
+{
+  std::string result1;
+  std::string msg1;
+  auto ok1 = read_with_threads(path, 1, result1, msg1);
+  EXPECT_EQ( exp_ok, ok1 );
+  for ( int n: {2, 3, 8} ) {
+    std::string result2;
+    std::string msg2;
+    auto ok2 = read_with_threads(path, n, result2, msg2);
+    EXPECT_EQ( ok1, ok2 );
+    EXPECT_EQ( result1, result2 );
+    EXPECT_EQ( msg1, msg2 );
+  }
+}
+
+// 位置情報を記録する場合としない場合を比較する．
+void
+check_track_location(
+  const std::string& path,
+  bool exp_ok
+)
+{
+  std::string result1;
+  std::string msg1;
+  auto ok1 = read_with_threads(path, 1, result1, msg1);
+  EXPECT_EQ( exp_ok, ok1 );
+  for ( int n: {1, 4} ) {
+    auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+	{"thread_num", JsonValue{n}},
+	{"track_location", JsonValue{false}}}};
+    std::string result2;
+    std::string msg2;
+    auto ok2 = read_with_option(path, option, result2, msg2);
+    EXPECT_EQ( ok1, ok2 );
+    EXPECT_EQ( result1, result2 );
+    EXPECT_EQ( msg1, msg2 );
+  }
+}
+
+// テスト用の blif ファイルを作る．
+//
+// n 個のインバーターの鎖を作り，途中に extra を挿入する．
+std::string
+make_chain_blif(
+  const std::string& name,
+  SizeType n,
+  const std::string& extra,
+  bool has_end = true
+)
+{
+  auto path = ::testing::TempDir() + name;
+  std::ofstream s{path};
+  s << ".model " << name << std::endl
+    << ".inputs x0" << std::endl
+    << ".outputs x" << n << std::endl;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( i == n * 3 / 4 ) {
+      s << extra;
+    }
+    if ( i % 7 == 0 ) {
+      s << ".latch x" << i << " x" << (i + 1) << " 0" << std::endl;
+    }
+    else {
+      s << ".names x" << i << " x" << (i + 1) << std::endl
+	<< "0 1" << std::endl;
+    }
+  }
+  if ( has_end ) {
+    s << ".end" << std::endl;
+  }
+  return path;
+}
+
+// output_filter を指定したオプションを作る．
+JsonValue
+filter_option(
+  const std::vector<std::string>& name_list
+)
+{
+  std::vector<JsonValue> js_list;
+  for ( auto& name: name_list ) {
+    js_list.push_back(JsonValue{name});
+  }
+  return JsonValue{std::unordered_map<std::string, JsonValue>{
+      {"output_filter", JsonValue{js_list}}}};
+}
+
+END_NONAMESPACE
 
 TEST( BnModelTest, read_blif1)
 {
@@ -50,6 +191,370 @@ TEST( BnModelTest, read_blif1)
   EXPECT_FALSE( is2 );
 }
 
+TEST( BnModelTest, read_blif_strash)
+{
+  // 構造ハッシュ付きの読み込みテスト
+  auto filename = std::string{"s5378.blif"};
+  auto path = std::string{DATAPATH + filename};
+
+  auto model0 = BnModel::read_blif(path);
+  auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+      {"strash", JsonValue{true}}}};
+  auto model = BnModel::read_blif(path, option);
+
+  EXPECT_TRUE( model.strash() );
+  EXPECT_EQ( model0.input_num(), model.input_num() );
+  EXPECT_EQ( model0.output_num(), model.output_num() );
+  EXPECT_EQ( model0.dff_num(), model.dff_num() );
+  EXPECT_GE( model0.logic_num(), model.logic_num() );
+
+  // 同じ構造の論理ノードが存在しないことを確かめる．
+  std::set<std::pair<SizeType, std::vector<SizeType>>> node_set;
+  for ( auto node: model.logic_ref_list() ) {
+    auto key = std::make_pair(node.func_id(), node.fanin_id_list().to_vector());
+    EXPECT_EQ( 0, node_set.count(key) );
+    node_set.insert(key);
+    // ファンインは論理ノードのリストに含まれているか入力でなければならない．
+    for ( auto inode: node.fanin_list() ) {
+      if ( inode.is_logic() ) {
+	auto ikey = std::make_pair(inode.func_id(), inode.fanin_id_list().to_vector());
+	EXPECT_EQ( 1, node_set.count(ikey) );
+      }
+    }
+  }
+}
+
+TEST( BnModelTest, read_blif_nommap)
+{
+  // mmap() を用いない読み込みテスト
+  auto filename = std::string{"s5378.blif"};
+  auto path = std::string{DATAPATH + filename};
+
+  auto model0 = BnModel::read_blif(path);
+  auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+      {"mmap", JsonValue{false}}}};
+  auto model = BnModel::read_blif(path, option);
+
+  std::ostringstream s0;
+  model0.print(s0);
+  std::ostringstream s1;
+  model.print(s1);
+  EXPECT_EQ( s0.str(), s1.str() );
+}
+
+TEST( BnModelTest, read_blif_parallel)
+{
+  // 並列読み込みのテスト
+  auto filename = std::string{"s5378.blif"};
+  auto path = std::string{DATAPATH + filename};
+  check_parallel(path, true);
+}
+
+TEST( BnModelTest, read_blif_parallel_noend)
+{
+  // .end のないファイルの並列読み込みのテスト
+  auto path = make_chain_blif("noend.blif", 1000, "", false);
+  check_parallel(path, true);
+}
+
+TEST( BnModelTest, read_blif_parallel_multidef)
+{
+  // 二重定義のあるファイルの並列読み込みのテスト
+  auto path = make_chain_blif("multidef.blif", 1000,
+			      ".names x1 x2 x10\n11 1\n");
+  check_parallel(path, false);
+}
+
+TEST( BnModelTest, read_blif_parallel_undef)
+{
+  // 未定義の名前のあるファイルの並列読み込みのテスト
+  auto path = make_chain_blif("undef.blif", 1000,
+			      ".names x1 y x1000000\n11 1\n");
+  check_parallel(path, false);
+}
+
+TEST( BnModelTest, read_blif_parallel_syntax_error)
+{
+  // 構文エラーのあるファイルの並列読み込みのテスト
+  auto path = make_chain_blif("synerr.blif", 1000,
+			      ".latch x1 y0 2\n");
+  check_parallel(path, false);
+}
+
+TEST( BnModelTest, read_blif_parallel_after_end)
+{
+  // .end の後に文のあるファイルの並列読み込みのテスト
+  // .end 以降は無視されるので出力が未定義となる．
+  auto path = make_chain_blif("after_end.blif", 1000,
+			      ".names x1 y0\n1 1\n.end\n");
+  check_parallel(path, false);
+}
+
+TEST( BnModelTest, read_blif_parallel_func_id)
+{
+  // キューブの順番が異なるカバーと重複したキューブを含むカバー
+  std::vector<std::vector<std::string>> pats_list{
+    {"1-0", "-11"},
+    {"-11", "1-0"},
+    {"1-0", "1-0", "-11"},
+    {"1-0", "-11", "1-0"},
+    {"0--", "-0-", "--0"},
+    {"--0", "-0-", "0--"},
+    {"--0", "--0"}
+  };
+  const SizeType n = 100;
+  std::ostringstream buf;
+  buf << ".model perm" << std::endl
+      << ".inputs a b c" << std::endl
+      << ".outputs";
+  for ( SizeType i = 0; i < n; ++ i ) {
+    buf << " y" << i;
+  }
+  buf << std::endl;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    buf << ".names a b c y" << i << std::endl;
+    auto& pats = pats_list[(i * 3) % pats_list.size()];
+    // 出力が 0 の行も混ぜる．
+    auto oval = (i % 5 == 0) ? "0" : "1";
+    for ( auto& pat: pats ) {
+      buf << pat << " " << oval << std::endl;
+    }
+  }
+  buf << ".end" << std::endl;
+  auto path = make_file("perm.blif", buf.str());
+
+  // 並列に読み込んだ場合も関数番号は逐次的に読み込んだ場合と同一になる．
+  auto model1 = BnModel::read_blif(path);
+  for ( int thread_num: {2, 4, 8} ) {
+    auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+	{"thread_num", JsonValue{thread_num}}}};
+    auto model2 = BnModel::read_blif(path, option);
+    ASSERT_EQ( model1.func_num(), model2.func_num() );
+    for ( SizeType i = 0; i < model1.func_num(); ++ i ) {
+      EXPECT_EQ( model1.func(i).input_cover(), model2.func(i).input_cover() );
+      EXPECT_EQ( model1.func(i).output_inv(), model2.func(i).output_inv() );
+    }
+    ASSERT_EQ( n, model2.output_num() );
+    for ( SizeType i = 0; i < n; ++ i ) {
+      EXPECT_EQ( model1.output(i).func().id(), model2.output(i).func().id() );
+    }
+  }
+  check_parallel(path, true);
+}
+
+TEST( BnModelTest, read_blif_const)
+{
+  // 入力数0の .names は定数を表す．
+  auto path = make_file("const.blif",
+			".model const\n"
+			".inputs a\n"
+			".outputs x y z\n"
+			".names x\n"
+			"1\n"
+			".names y\n"
+			".names z\n"
+			"0\n"
+			".end\n");
+  for ( int thread_num: {1, 4} ) {
+    auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+	{"thread_num", JsonValue{thread_num}}}};
+    auto model = BnModel::read_blif(path, option);
+    ASSERT_EQ( 3, model.output_num() );
+    for ( bool a: {false, true} ) {
+      auto ovals = simulate(model, {a});
+      EXPECT_TRUE( ovals[0] );
+      EXPECT_FALSE( ovals[1] );
+      EXPECT_FALSE( ovals[2] );
+    }
+  }
+  check_parallel(path, true);
+}
+
+TEST( BnModelTest, read_blif_notrack)
+{
+  // 位置情報を記録しない読み込みのテスト
+  auto filename = std::string{"s5378.blif"};
+  auto path = std::string{DATAPATH + filename};
+  check_track_location(path, true);
+}
+
+TEST( BnModelTest, read_blif_notrack_multidef)
+{
+  // 二重定義のあるファイルを位置情報を記録せずに読み込むテスト
+  auto path = make_chain_blif("notrack_multidef.blif", 1000,
+			      ".names x1 x2 x10\n11 1\n");
+  check_track_location(path, false);
+}
+
+TEST( BnModelTest, read_blif_notrack_undef)
+{
+  // 未定義の名前のあるファイルを位置情報を記録せずに読み込むテスト
+  auto path = make_chain_blif("notrack_undef.blif", 1000,
+			      ".names x1 y x1000000\n11 1\n");
+  check_track_location(path, false);
+}
+
+TEST( BnModelTest, read_blif_notrack_syntax_error)
+{
+  // 構文エラーのあるファイルを位置情報を記録せずに読み込むテスト
+  auto path = make_chain_blif("notrack_synerr.blif", 1000,
+			      ".latch x1 y0 2\n");
+  check_track_location(path, false);
+}
+
+TEST( BnModelTest, read_blif_filter)
+{
+  // 出力の推移的ファンインのみを読み込むテスト
+  auto path = make_file("filter.blif",
+			".model filter\n"
+			".inputs a b\n"
+			".outputs x y\n"
+			".names a n1\n"
+			"0 1\n"
+			".names n1 x\n"
+			"0 1\n"
+			".names b \\\n"
+			"  m1\n"
+			"1 1\n"
+			".latch m1 m2 0\n"
+			"# comment\n"
+			".names m2 y\n"
+			"1 1\n"
+			".end\n");
+  // y の推移的ファンインのみを書いたファイル
+  auto ref_path = make_file("filter_ref.blif",
+			    ".model filter\n"
+			    ".inputs a b\n"
+			    ".outputs y\n"
+			    ".names b m1\n"
+			    "1 1\n"
+			    ".latch m1 m2 0\n"
+			    ".names m2 y\n"
+			    "1 1\n"
+			    ".end\n");
+
+  auto model = BnModel::read_blif(path, filter_option({"y"}));
+  EXPECT_EQ( 2, model.input_num() );
+  ASSERT_EQ( 1, model.output_num() );
+  EXPECT_EQ( "y", model.output_name(0) );
+  EXPECT_EQ( 1, model.dff_num() );
+  EXPECT_EQ( 2, model.logic_num() );
+
+  auto ref_model = BnModel::read_blif(ref_path);
+  std::ostringstream s1;
+  model.print(s1);
+  std::ostringstream s2;
+  ref_model.print(s2);
+  EXPECT_EQ( s2.str(), s1.str() );
+
+  auto model2 = BnModel::read_blif(path, filter_option({"x"}));
+  ASSERT_EQ( 1, model2.output_num() );
+  EXPECT_EQ( "x", model2.output_name(0) );
+  EXPECT_EQ( 0, model2.dff_num() );
+  EXPECT_EQ( 2, model2.logic_num() );
+}
+
+TEST( BnModelTest, read_blif_filter_all)
+{
+  // 全ての出力を指定した場合は通常の読み込みと同じになる．
+  auto filename = std::string{"s5378.blif"};
+  auto path = std::string{DATAPATH + filename};
+  auto model0 = BnModel::read_blif(path);
+  std::vector<std::string> name_list;
+  for ( SizeType i = 0; i < model0.output_num(); ++ i ) {
+    name_list.push_back(model0.output_name(i));
+  }
+  auto model = BnModel::read_blif(path, filter_option(name_list));
+  EXPECT_EQ( model0.input_num(), model.input_num() );
+  EXPECT_EQ( model0.output_num(), model.output_num() );
+  EXPECT_GE( model0.dff_num(), model.dff_num() );
+  EXPECT_GE( model0.logic_num(), model.logic_num() );
+
+  // 一部の出力のみの場合
+  auto model1 = BnModel::read_blif(path, filter_option({name_list[0]}));
+  EXPECT_EQ( 1, model1.output_num() );
+  EXPECT_GT( model.logic_num(), model1.logic_num() );
+}
+
+TEST( BnModelTest, read_blif_filter_noend)
+{
+  // 末尾の文を読み飛ばした場合も .end がない警告が出る．
+  auto path = make_chain_blif("filter_noend.blif", 100,
+			      ".names x0 z\n1 1\n", false);
+  std::string result1;
+  std::string msg1;
+  EXPECT_TRUE( read_with_threads(path, 1, result1, msg1) );
+  std::string result2;
+  std::string msg2;
+  EXPECT_TRUE( read_with_option(path, filter_option({"x100"}), result2, msg2) );
+  EXPECT_FALSE( msg1.empty() );
+  EXPECT_EQ( msg1, msg2 );
+}
+
+TEST( BnModelTest, read_blif_filter_error)
+{
+  auto path = make_file("filter_error.blif",
+			".model filter_error\n"
+			".inputs a b\n"
+			".outputs x y\n"
+			".names a c x\n"
+			"11 1\n"
+			".names b y\n"
+			"1 1\n"
+			".names a y\n"
+			"1 1\n"
+			".end\n");
+  // x の推移的ファンインには未定義の c がある．
+  EXPECT_THROW( {
+      auto _ = BnModel::read_blif(path, filter_option({"x"}));
+    }, std::invalid_argument );
+  // y は二重定義されている．
+  EXPECT_THROW( {
+      auto _ = BnModel::read_blif(path, filter_option({"y"}));
+    }, std::invalid_argument );
+  // 出力でない名前
+  EXPECT_THROW( {
+      auto _ = BnModel::read_blif(path, filter_option({"a"}));
+    }, std::invalid_argument );
+
+  // エラーのない推移的ファンインのみを読み込むなら成功する．
+  auto path2 = make_file("filter_error2.blif",
+			 ".model filter_error2\n"
+			 ".inputs a b\n"
+			 ".outputs x y\n"
+			 ".names a c x\n"
+			 "11 1\n"
+			 ".names b y\n"
+			 "1 1\n"
+			 ".end\n");
+  auto model = BnModel::read_blif(path2, filter_option({"y"}));
+  EXPECT_EQ( 1, model.output_num() );
+  EXPECT_EQ( 1, model.logic_num() );
+}
+
+TEST( BnModelTest, read_blif_filter_comment)
+{
+  // コメント中や名前の一部の .subckt/.model は階層構造とみなさない．
+  auto path = make_file("filter_comment.blif",
+			".model top\n"
+			"# this file does not use .subckt\n"
+			".inputs a b c\n"
+			".outputs x y\n"
+			"/* .model dummy */\n"
+			".names a a.model1\n"
+			"0 1\n"
+			".names a.model1 b x\n"
+			"11 1\n"
+			".names c y\n"
+			"1 1\n"
+			".end\n");
+  auto model = BnModel::read_blif(path, filter_option({"x"}));
+  EXPECT_EQ( 3, model.input_num() );
+  ASSERT_EQ( 1, model.output_num() );
+  EXPECT_EQ( "x", model.output_name(0) );
+  EXPECT_EQ( 2, model.logic_num() );
+}
+
 TEST( BnModelTest, read_blif_file_not_found)
 {
   // 存在しないファイルの場合の例外送出テスト
@@ -68,4 +573,4 @@ TEST( BnModelTest, read_blif_wrong_data)
     }, std::invalid_argument );
 }
 
-END_NAMESPACE_YM
+END_NAMESPACE_YM_BN
@@ -0,0 +1,111 @@
+
+/// @file write_blif_test.cc
+/// @brief write_blif_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+TEST( BnModelTest, write_blif_s5378 )
+{
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  auto model = BnModel::read_blif(path);
+  auto model2 = round_trip(model, "blif", "s5378.blif");
+
+  EXPECT_EQ( model.logic_num(), model2.logic_num() );
+  check_equiv(model, model2);
+}
+
+TEST( BnModelTest, write_blif_funcs )
+{
+  // 色々な種類の関数を含むモデル
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto c = model.new_input("c");
+  auto dff0 = model.new_dff("q0", '0');
+  auto dff1 = model.new_dff("q1", '1');
+  auto dff2 = model.new_dff("q2", 'X');
+  auto q0 = dff0.output();
+  auto q1 = dff1.output();
+  auto q2 = dff2.output();
+
+  auto n1 = model.new_primitive(PrimType::Xor, {a, b, c});
+  auto n2 = model.new_primitive(PrimType::Nand, {a, q0, q1});
+  // a b' + c q2'
+  SopCover cover{4, {{Literal{0, false}, Literal{1, true}},
+		     {Literal{2, false}, Literal{3, true}}}};
+  auto n3 = model.new_cover(cover, true, {a, b, c, q2});
+  auto expr = (Expr::literal(0) & ~Expr::literal(1)) | Expr::literal(2);
+  auto n4 = model.new_expr(expr, {n1, n2, n3});
+  // 多数決関数
+  TvFunc maj{"11101000"};
+  auto n5 = model.new_tvfunc(maj, {n4, q1, b});
+  auto n6 = model.new_primitive(PrimType::Xnor, {n5, n1});
+  // オンセットの方が大きい真理値表
+  TvFunc f7{"11111110"};
+  auto n7 = model.new_tvfunc(f7, {n4, n5, n6});
+  auto n8 = model.new_primitive(PrimType::C1, {});
+
+  model.set_dff_src(dff0, n5);
+  model.set_dff_src(dff1, n6);
+  model.set_dff_src(dff2, n2);
+  model.new_output(n4, "o1");
+  model.new_output(n6, "o2");
+  model.new_output(a, "o3");
+  model.new_output(n7, "o4");
+  model.new_output(n8, "o5");
+  model.wrap_up();
+
+  auto model2 = round_trip(model, "blif", "funcs.blif");
+  check_equiv(model, model2);
+}
+
+TEST( BnModelTest, write_blif_names )
+{
+  // 名前のないノードと重複した名前
+  BnModel model;
+  auto a = model.new_input("n3");
+  auto b = model.new_input();
+  auto n1 = model.new_primitive(PrimType::And, {a, b});
+  auto n2 = model.new_primitive(PrimType::Or, {a, n1});
+  model.new_output(n1, "n3");
+  model.new_output(n2);
+  model.new_output(n2, "x");
+  model.wrap_up();
+
+  auto model2 = round_trip(model, "blif", "names.blif");
+
+  ASSERT_EQ( 2, model2.input_num() );
+  EXPECT_EQ( "n3", model2.input_name(0) );
+  EXPECT_NE( "", model2.input_name(1) );
+  EXPECT_NE( "n3", model2.input_name(1) );
+  ASSERT_EQ( 3, model2.output_num() );
+  // "n3" は入力名と重複するので別の名前になる．
+  EXPECT_NE( "n3", model2.output_name(0) );
+  EXPECT_EQ( "x", model2.output_name(2) );
+
+  std::vector<bool> ivals(2);
+  for ( SizeType p = 0; p < 4; ++ p ) {
+    ivals[0] = p & 1;
+    ivals[1] = (p >> 1) & 1;
+    EXPECT_EQ( simulate(model, ivals), simulate(model2, ivals) );
+  }
+}
+
+TEST( BnModelTest, write_blif_bad_file )
+{
+  BnModel model;
+  model.new_output(model.new_input("a"), "b");
+  model.wrap_up();
+  EXPECT_THROW( model.write_blif("/nonexistent/dir/foo.blif"),
+		std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
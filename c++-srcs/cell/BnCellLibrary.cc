@@ -0,0 +1,62 @@
+
+/// @file BnCellLibrary.cc
+/// @brief BnCellLibrary の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnCellLibrary.h"
+#include "CellLibImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnCellLibrary
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+BnCellLibrary::BnCellLibrary(
+) : mImpl{new CellLibImpl}
+{
+}
+
+// @brief デストラクタ
+BnCellLibrary::~BnCellLibrary()
+{
+}
+
+// @brief ライブラリ名を返す．
+const std::string&
+BnCellLibrary::name() const
+{
+  return mImpl->name();
+}
+
+// @brief セル数を返す．
+SizeType
+BnCellLibrary::cell_num() const
+{
+  return mImpl->cell_num();
+}
+
+// @brief セルを返す．
+const BnCell&
+BnCellLibrary::cell(
+  SizeType cell_id
+) const
+{
+  return mImpl->cell(cell_id);
+}
+
+// @brief 名前からセル番号を探す．
+SizeType
+BnCellLibrary::find_cell(
+  const std::string& name
+) const
+{
+  return mImpl->find_cell(name);
+}
+
+END_NAMESPACE_YM_BN
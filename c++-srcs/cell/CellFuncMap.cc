@@ -0,0 +1,41 @@
+
+/// @file CellFuncMap.cc
+/// @brief CellFuncMap の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CellFuncMap.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス CellFuncMap
+//////////////////////////////////////////////////////////////////////
+
+// @brief セルの関数を登録する．
+SizeType
+CellFuncMap::reg_func(
+  ModelImpl& model,
+  SizeType cell_id
+)
+{
+  auto& cell = mLibrary.cell(cell_id);
+  if ( !cell.is_logic() ) {
+    std::ostringstream buf;
+    buf << cell.name << ": Not a single output combinational cell.";
+    throw std::invalid_argument{buf.str()};
+  }
+  auto ni = cell.input_list.size();
+  auto& expr = cell.pin_list[cell.output_list[0]].function;
+  if ( expr.input_size() == ni ) {
+    return model.reg_expr(expr);
+  }
+  // 関数に現れない入力ピンがある場合は入力数を合わせる．
+  return model.reg_tvfunc(expr.tvfunc(ni));
+}
+
+END_NAMESPACE_YM_BN
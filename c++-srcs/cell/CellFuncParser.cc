@@ -0,0 +1,215 @@
+
+/// @file CellFuncParser.cc
+/// @brief CellFuncParser の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CellFuncParser.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 名前に使える文字の時 true を返す．
+inline
+bool
+is_name_char(
+  char c
+)
+{
+  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+    ('0' <= c && c <= '9') || c == '_' || c == '[' || c == ']' ||
+    c == '.' || c == '<' || c == '>';
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス CellFuncParser
+//////////////////////////////////////////////////////////////////////
+
+// @brief 論理式を読み込む．
+bool
+CellFuncParser::parse(
+  std::vector<std::string>& var_list,
+  bool allow_new,
+  Expr& expr
+)
+{
+  mPos = 0;
+  mVarList = &var_list;
+  mAllowNew = allow_new;
+  mErrorMessage.clear();
+  if ( !parse_or(expr) ) {
+    return false;
+  }
+  if ( peek() != '\0' ) {
+    return error("Syntax error");
+  }
+  return true;
+}
+
+// @brief OR 式を読み込む．
+bool
+CellFuncParser::parse_or(
+  Expr& expr
+)
+{
+  if ( !parse_and(expr) ) {
+    return false;
+  }
+  for ( ; ; ) {
+    auto c = peek();
+    if ( c != '|' && c != '+' ) {
+      return true;
+    }
+    ++ mPos;
+    Expr expr1;
+    if ( !parse_and(expr1) ) {
+      return false;
+    }
+    expr = expr | expr1;
+  }
+}
+
+// @brief AND 式を読み込む．
+bool
+CellFuncParser::parse_and(
+  Expr& expr
+)
+{
+  if ( !parse_xor(expr) ) {
+    return false;
+  }
+  for ( ; ; ) {
+    auto c = peek();
+    if ( c == '&' || c == '*' ) {
+      ++ mPos;
+    }
+    else if ( c != '!' && c != '(' && !is_name_char(c) ) {
+      // 空白で区切られた項も AND とみなす．
+      return true;
+    }
+    Expr expr1;
+    if ( !parse_xor(expr1) ) {
+      return false;
+    }
+    expr = expr & expr1;
+  }
+}
+
+// @brief XOR 式を読み込む．
+bool
+CellFuncParser::parse_xor(
+  Expr& expr
+)
+{
+  if ( !parse_factor(expr) ) {
+    return false;
+  }
+  for ( ; ; ) {
+    if ( peek() != '^' ) {
+      return true;
+    }
+    ++ mPos;
+    Expr expr1;
+    if ( !parse_factor(expr1) ) {
+      return false;
+    }
+    expr = expr ^ expr1;
+  }
+}
+
+// @brief 否定を含む項を読み込む．
+bool
+CellFuncParser::parse_factor(
+  Expr& expr
+)
+{
+  auto c = peek();
+  if ( c == '!' ) {
+    ++ mPos;
+    if ( !parse_factor(expr) ) {
+      return false;
+    }
+    expr = ~expr;
+    return true;
+  }
+
+  if ( c == '(' ) {
+    ++ mPos;
+    if ( !parse_or(expr) ) {
+      return false;
+    }
+    if ( peek() != ')' ) {
+      return error("')' is expected");
+    }
+    ++ mPos;
+  }
+  else if ( is_name_char(c) ) {
+    auto start = mPos;
+    while ( mPos < mStr.size() && is_name_char(mStr[mPos]) ) {
+      ++ mPos;
+    }
+    auto name = mStr.substr(start, mPos - start);
+    if ( name == "0" || name == "CONST0" ) {
+      expr = Expr::zero();
+    }
+    else if ( name == "1" || name == "CONST1" ) {
+      expr = Expr::one();
+    }
+    else {
+      auto& var_list = *mVarList;
+      auto p = std::find(var_list.begin(), var_list.end(), name);
+      SizeType var = p - var_list.begin();
+      if ( p == var_list.end() ) {
+	if ( !mAllowNew ) {
+	  return error(name + ": Unknown variable");
+	}
+	var_list.push_back(name);
+      }
+      expr = Expr::literal(var, false);
+    }
+  }
+  else {
+    return error("Syntax error");
+  }
+
+  // 後置の否定
+  while ( peek() == '\'' ) {
+    ++ mPos;
+    expr = ~expr;
+  }
+  return true;
+}
+
+// @brief 空白を読み飛ばして次の文字を返す．
+char
+CellFuncParser::peek()
+{
+  while ( mPos < mStr.size() ) {
+    auto c = mStr[mPos];
+    if ( c != ' ' && c != '\t' && c != '\n' && c != '\r' ) {
+      return c;
+    }
+    ++ mPos;
+  }
+  return '\0';
+}
+
+// @brief エラーメッセージを設定する．
+bool
+CellFuncParser::error(
+  const std::string& msg
+)
+{
+  std::ostringstream buf;
+  buf << "\"" << mStr << "\": " << msg << ".";
+  mErrorMessage = buf.str();
+  return false;
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,139 @@
+#ifndef CELLFUNCPARSER_H
+#define CELLFUNCPARSER_H
+
+/// @file CellFuncParser.h
+/// @brief CellFuncParser のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class CellFuncParser CellFuncParser.h "CellFuncParser.h"
+/// @brief セルの論理関数を表す文字列を Expr に変換するクラス
+///
+/// Liberty の function 属性と genlib の論理式で共通に用いる．
+/// 演算子の優先順位は高い順に
+/// - '!'(前置の否定), '\''(後置の否定)
+/// - '^'(XOR)
+/// - '&', '*', 空白(AND)
+/// - '|', '+'(OR)
+/// となる．定数は 0, 1, CONST0, CONST1 で表す．
+//////////////////////////////////////////////////////////////////////
+class CellFuncParser
+{
+public:
+
+  /// @brief コンストラクタ
+  CellFuncParser(
+    const std::string& str ///< [in] 対象の文字列
+  ) : mStr{str}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~CellFuncParser() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 論理式を読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  ///
+  /// 変数番号は var_list 中の位置となる．
+  /// var_list にない名前が現れた場合，allow_new が true なら
+  /// var_list の末尾に追加し，false なら失敗とする．
+  /// 失敗した場合は error_message() に理由が設定される．
+  bool
+  parse(
+    std::vector<std::string>& var_list, ///< [inout] 変数名のリスト
+    bool allow_new,                     ///< [in] 新しい変数を許す時 true
+    Expr& expr                          ///< [out] 結果の論理式
+  );
+
+  /// @brief エラーメッセージを返す．
+  const std::string&
+  error_message() const
+  {
+    return mErrorMessage;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief OR 式を読み込む．
+  bool
+  parse_or(
+    Expr& expr ///< [out] 結果の論理式
+  );
+
+  /// @brief AND 式を読み込む．
+  bool
+  parse_and(
+    Expr& expr ///< [out] 結果の論理式
+  );
+
+  /// @brief XOR 式を読み込む．
+  bool
+  parse_xor(
+    Expr& expr ///< [out] 結果の論理式
+  );
+
+  /// @brief 否定を含む項を読み込む．
+  bool
+  parse_factor(
+    Expr& expr ///< [out] 結果の論理式
+  );
+
+  /// @brief 空白を読み飛ばして次の文字を返す．
+  ///
+  /// 末尾の場合は '\0' を返す．
+  char
+  peek();
+
+  /// @brief エラーメッセージを設定する．
+  /// @return false を返す．
+  bool
+  error(
+    const std::string& msg ///< [in] メッセージ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象の文字列
+  std::string mStr;
+
+  // 読み出し位置
+  SizeType mPos{0};
+
+  // 変数名のリスト
+  std::vector<std::string>* mVarList{nullptr};
+
+  // 新しい変数を許す時 true
+  bool mAllowNew{false};
+
+  // エラーメッセージ
+  std::string mErrorMessage;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // CELLFUNCPARSER_H
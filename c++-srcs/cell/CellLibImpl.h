@@ -0,0 +1,124 @@
+#ifndef CELLLIBIMPL_H
+#define CELLLIBIMPL_H
+
+/// @file CellLibImpl.h
+/// @brief CellLibImpl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnCellLibrary.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class CellLibImpl CellLibImpl.h "CellLibImpl.h"
+/// @brief BnCellLibrary の内部情報を表すクラス
+//////////////////////////////////////////////////////////////////////
+class CellLibImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  CellLibImpl() = default;
+
+  /// @brief デストラクタ
+  ~CellLibImpl() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ライブラリ名を返す．
+  const std::string&
+  name() const
+  {
+    return mName;
+  }
+
+  /// @brief セル数を返す．
+  SizeType
+  cell_num() const
+  {
+    return mCellList.size();
+  }
+
+  /// @brief セルを返す．
+  const BnCell&
+  cell(
+    SizeType cell_id ///< [in] セル番号 ( 0 <= cell_id < cell_num() )
+  ) const
+  {
+    if ( cell_id >= cell_num() ) {
+      throw std::out_of_range{"cell_id is out of range"};
+    }
+    return mCellList[cell_id];
+  }
+
+  /// @brief 名前からセル番号を探す．
+  ///
+  /// 見つからなければ BAD_ID を返す．
+  SizeType
+  find_cell(
+    const std::string& name ///< [in] セル名
+  ) const
+  {
+    auto p = mCellDict.find(name);
+    if ( p == mCellDict.end() ) {
+      return BAD_ID;
+    }
+    return p->second;
+  }
+
+  /// @brief ライブラリ名を設定する．
+  void
+  set_name(
+    const std::string& name ///< [in] ライブラリ名
+  )
+  {
+    mName = name;
+  }
+
+  /// @brief セルを追加する．
+  /// @return セル番号を返す．
+  ///
+  /// 同名のセルが存在する場合は BAD_ID を返す．
+  SizeType
+  add_cell(
+    BnCell&& cell ///< [in] セル
+  )
+  {
+    if ( mCellDict.count(cell.name) > 0 ) {
+      return BAD_ID;
+    }
+    auto cell_id = mCellList.size();
+    mCellDict.emplace(cell.name, cell_id);
+    mCellList.push_back(std::move(cell));
+    return cell_id;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ライブラリ名
+  std::string mName;
+
+  // セルのリスト
+  std::vector<BnCell> mCellList;
+
+  // セル名をキーにしてセル番号を格納する辞書
+  std::unordered_map<std::string, SizeType> mCellDict;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // CELLLIBIMPL_H
@@ -0,0 +1,325 @@
+
+/// @file GenlibParser.cc
+/// @brief GenlibParser の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "GenlibParser.h"
+#include "GenlibScanner.h"
+#include "CellLibImpl.h"
+#include "CellFuncParser.h"
+#include "MappedFile.h"
+#include "MsgQueue.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnCellLibrary
+//////////////////////////////////////////////////////////////////////
+
+// @brief genlib 形式のファイルを読み込む．
+BnCellLibrary
+BnCellLibrary::read_genlib(
+  const std::string& filename
+)
+{
+  BnCellLibrary library;
+  GenlibParser parser{*library.mImpl};
+  if ( !parser.read(filename) ) {
+    std::ostringstream buf;
+    buf << "BnCellLibrary::read_genlib(\"" << filename << "\") failed.";
+    throw std::invalid_argument{buf.str()};
+  }
+  return library;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス GenlibParser
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+GenlibParser::GenlibParser(
+  CellLibImpl& library
+) : mLibrary{library}
+{
+}
+
+// @brief 読み込みを行う．
+bool
+GenlibParser::read(
+  const std::string& filename
+)
+{
+  MappedFile fin;
+  if ( !fin.open(filename) ) {
+    // エラー
+    std::ostringstream buf;
+    buf << filename << " : No such file.";
+    MsgQueue::output(__FILE__, __LINE__, FileRegion(),
+		     MsgType::Failure, "GENLIB_PARSER", buf.str());
+    return false;
+  }
+
+  FileInfo file_info{filename};
+  GenlibScanner scanner{fin.begin(), fin.ready_end(), file_info};
+  scanner.set_source(fin);
+  mScanner = &scanner;
+
+  next_token();
+  for ( ; ; ) {
+    if ( mCurToken == GenlibToken::_EOF ) {
+      break;
+    }
+    if ( mCurToken != GenlibToken::WORD ) {
+      return syntax_error();
+    }
+    auto& keyword = mScanner->cur_string();
+    if ( keyword == "GATE" ) {
+      if ( !read_gate(false) ) {
+	return false;
+      }
+    }
+    else if ( keyword == "LATCH" ) {
+      if ( !read_gate(true) ) {
+	return false;
+      }
+    }
+    else {
+      return syntax_error();
+    }
+  }
+
+  return true;
+}
+
+// @brief GATE 文もしくは LATCH 文を読み込む．
+bool
+GenlibParser::read_gate(
+  bool is_latch
+)
+{
+  auto loc = mCurLoc;
+
+  next_token();
+  if ( mCurToken != GenlibToken::WORD ) {
+    return syntax_error();
+  }
+  BnCell cell;
+  cell.name = mScanner->cur_string();
+  cell.is_sequential = is_latch;
+
+  next_token();
+  if ( !read_number(cell.area) ) {
+    return false;
+  }
+
+  next_token();
+  if ( mCurToken != GenlibToken::WORD ) {
+    return syntax_error();
+  }
+  BnCellPin opin;
+  opin.name = mScanner->cur_string();
+  opin.direction = BnCellPin::Output;
+
+  next_token();
+  if ( mCurToken != GenlibToken::EQ ) {
+    return syntax_error();
+  }
+  FileRegion expr_loc;
+  if ( !mScanner->read_expr(expr_loc) ) {
+    mCurLoc = expr_loc;
+    return syntax_error();
+  }
+
+  // 入力ピンは論理式中に現れた順に番号づける．
+  std::vector<std::string> input_name_list;
+  CellFuncParser parser{mScanner->cur_string()};
+  if ( !parser.parse(input_name_list, true, opin.function) ) {
+    std::ostringstream buf;
+    buf << cell.name << ": " << parser.error_message();
+    MsgQueue::output(__FILE__, __LINE__, expr_loc,
+		     MsgType::Error,
+		     "GENLIB03", buf.str());
+    return false;
+  }
+  opin.has_function = true;
+
+  next_token();
+  std::vector<PinInfo> pin_info_list;
+  while ( mCurToken == GenlibToken::WORD &&
+	  mScanner->cur_string() == "PIN" ) {
+    pin_info_list.push_back(PinInfo{});
+    if ( !read_pin(pin_info_list.back()) ) {
+      return false;
+    }
+  }
+  if ( is_latch ) {
+    // SEQ, CONTROL, CONSTRAINT 文は読み飛ばす．
+    while ( mCurToken == GenlibToken::WORD &&
+	    mScanner->cur_string() != "GATE" &&
+	    mScanner->cur_string() != "LATCH" ) {
+      next_token();
+    }
+  }
+
+  // 論理式に現れないピンは入力の末尾に加える．
+  for ( auto& pin_info: pin_info_list ) {
+    auto& name = pin_info.name;
+    if ( name != "*" &&
+	 std::find(input_name_list.begin(), input_name_list.end(), name)
+	 == input_name_list.end() ) {
+      input_name_list.push_back(name);
+    }
+  }
+
+  auto ni = input_name_list.size();
+  std::vector<const PinInfo*> pin_info_map(ni, nullptr);
+  for ( auto& pin_info: pin_info_list ) {
+    auto& name = pin_info.name;
+    if ( name == "*" ) {
+      for ( auto& p: pin_info_map ) {
+	p = &pin_info;
+      }
+    }
+    else {
+      auto pos = std::find(input_name_list.begin(), input_name_list.end(), name)
+	- input_name_list.begin();
+      if ( pin_info_map[pos] != nullptr ) {
+	std::ostringstream buf;
+	buf << name << ": Defined more than once.";
+	MsgQueue::output(__FILE__, __LINE__, pin_info.loc,
+			 MsgType::Error,
+			 "GENLIB04", buf.str());
+	return false;
+      }
+      pin_info_map[pos] = &pin_info;
+    }
+  }
+
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    BnCellPin pin;
+    pin.name = input_name_list[i];
+    pin.direction = BnCellPin::Input;
+    auto pin_info = pin_info_map[i];
+    if ( pin_info != nullptr ) {
+      pin.capacitance = pin_info->val[0];
+      BnCellTiming timing;
+      timing.related_pin = pin.name;
+      auto& phase = pin_info->phase;
+      if ( phase == "INV" ) {
+	timing.timing_sense = "negative_unate";
+      }
+      else if ( phase == "NONINV" ) {
+	timing.timing_sense = "positive_unate";
+      }
+      else {
+	timing.timing_sense = "non_unate";
+      }
+      timing.rise_block_delay = pin_info->val[2];
+      timing.rise_fanout_delay = pin_info->val[3];
+      timing.fall_block_delay = pin_info->val[4];
+      timing.fall_fanout_delay = pin_info->val[5];
+      opin.timing_list.push_back(std::move(timing));
+    }
+    cell.input_list.push_back(i);
+    cell.pin_list.push_back(std::move(pin));
+  }
+  cell.output_list.push_back(ni);
+  cell.pin_list.push_back(std::move(opin));
+
+  auto cell_name = cell.name;
+  if ( mLibrary.add_cell(std::move(cell)) == BAD_ID ) {
+    std::ostringstream buf;
+    buf << cell_name << ": Defined more than once. Ignored.";
+    MsgQueue::output(__FILE__, __LINE__, loc,
+		     MsgType::Warning,
+		     "GENLIB05", buf.str());
+  }
+  return true;
+}
+
+// @brief PIN 文を読み込む．
+bool
+GenlibParser::read_pin(
+  PinInfo& pin_info
+)
+{
+  next_token();
+  if ( mCurToken != GenlibToken::WORD ) {
+    return syntax_error();
+  }
+  pin_info.name = mScanner->cur_string();
+  pin_info.loc = mCurLoc;
+
+  next_token();
+  if ( mCurToken != GenlibToken::WORD ) {
+    return syntax_error();
+  }
+  pin_info.phase = mScanner->cur_string();
+  if ( pin_info.phase != "INV" &&
+       pin_info.phase != "NONINV" &&
+       pin_info.phase != "UNKNOWN" ) {
+    std::ostringstream buf;
+    buf << pin_info.phase << ": Unknown phase. 'UNKNOWN' is assumed.";
+    MsgQueue::output(__FILE__, __LINE__, mCurLoc,
+		     MsgType::Warning,
+		     "GENLIB06", buf.str());
+  }
+
+  for ( SizeType i = 0; i < 6; ++ i ) {
+    next_token();
+    if ( !read_number(pin_info.val[i]) ) {
+      return false;
+    }
+  }
+  next_token();
+  return true;
+}
+
+// @brief 数値を読み込む．
+bool
+GenlibParser::read_number(
+  double& val
+)
+{
+  if ( mCurToken != GenlibToken::WORD ) {
+    return syntax_error();
+  }
+  auto& str = mScanner->cur_string();
+  char* end;
+  val = std::strtod(str.c_str(), &end);
+  if ( end == str.c_str() || *end != '\0' ) {
+    std::ostringstream buf;
+    buf << str << ": Illegal number.";
+    MsgQueue::output(__FILE__, __LINE__, mCurLoc,
+		     MsgType::Error,
+		     "GENLIB02", buf.str());
+    return false;
+  }
+  return true;
+}
+
+// @brief 次のトークンを読み出す．
+void
+GenlibParser::next_token()
+{
+  mCurToken = mScanner->read_token(mCurLoc);
+}
+
+// @brief 構文エラーを出力する．
+bool
+GenlibParser::syntax_error()
+{
+  MsgQueue::output(__FILE__, __LINE__, mCurLoc,
+		   MsgType::Error,
+		   "GENLIB01",
+		   "Syntax error.");
+  return false;
+}
+
+END_NAMESPACE_YM_BN
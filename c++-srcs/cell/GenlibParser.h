@@ -0,0 +1,148 @@
+#ifndef GENLIBPARSER_H
+#define GENLIBPARSER_H
+
+/// @file GenlibParser.h
+/// @brief GenlibParser のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnCellLibrary.h"
+#include "ym/FileRegion.h"
+#include "GenlibToken.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class CellLibImpl;
+class GenlibScanner;
+
+//////////////////////////////////////////////////////////////////////
+/// @class GenlibParser GenlibParser.h "GenlibParser.h"
+/// @brief genlib 形式のファイルを読み込むパーサークラス
+///
+/// 以下の文を解釈する．
+/// - GATE <セル名> <面積> <出力名> = <論理式> ;
+/// - LATCH <セル名> <面積> <出力名> = <論理式> ;
+/// - PIN <ピン名> <phase> <入力負荷> <最大負荷>
+///   <rise-block> <rise-fanout> <fall-block> <fall-fanout>
+///
+/// LATCH に続く SEQ, CONTROL, CONSTRAINT 文は読み飛ばす．
+//////////////////////////////////////////////////////////////////////
+class GenlibParser
+{
+public:
+
+  /// @brief コンストラクタ
+  GenlibParser(
+    CellLibImpl& library ///< [in] 結果を格納するオブジェクト
+  );
+
+  /// @brief デストラクタ
+  ~GenlibParser() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込みを行う．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read(
+    const std::string& filename ///< [in] ファイル名
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // PIN 文の内容
+  struct PinInfo
+  {
+    // ピン名
+    std::string name;
+
+    // 位置
+    FileRegion loc;
+
+    // phase
+    std::string phase;
+
+    // 数値のリスト
+    double val[6];
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief GATE 文もしくは LATCH 文を読み込む．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false エラーが起こった．
+  ///
+  /// 現在のトークンが GATE か LATCH であると仮定している．
+  bool
+  read_gate(
+    bool is_latch ///< [in] LATCH 文の時 true
+  );
+
+  /// @brief PIN 文を読み込む．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false エラーが起こった．
+  ///
+  /// 現在のトークンが PIN であると仮定している．
+  bool
+  read_pin(
+    PinInfo& pin_info ///< [out] 結果を格納するオブジェクト
+  );
+
+  /// @brief 数値を読み込む．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false エラーが起こった．
+  bool
+  read_number(
+    double& val ///< [out] 結果の値
+  );
+
+  /// @brief 次のトークンを読み出す．
+  void
+  next_token();
+
+  /// @brief 構文エラーを出力する．
+  /// @return false を返す．
+  bool
+  syntax_error();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 字句解析器
+  // この変数は read() 内でのみ有効
+  GenlibScanner* mScanner{nullptr};
+
+  // 結果を格納するオブジェクト
+  CellLibImpl& mLibrary;
+
+  // 現在のトークン
+  GenlibToken mCurToken;
+
+  // 現在のトークンの位置
+  FileRegion mCurLoc;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // GENLIBPARSER_H
@@ -0,0 +1,140 @@
+
+/// @file GenlibScanner.cc
+/// @brief GenlibScanner の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "GenlibScanner.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// WORD を終わらせる文字の時 true を返す．
+inline
+bool
+is_delim(
+  int c
+)
+{
+  switch ( c ) {
+  case EOF:
+  case ' ':
+  case '\t':
+  case '\r':
+  case '\n':
+  case '\f':
+  case '=':
+  case ';':
+  case '#':
+    return true;
+  default:
+    return false;
+  }
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// genlib 形式用の字句解析器
+//////////////////////////////////////////////////////////////////////
+
+// @brief トークンを一つ読み出す．
+GenlibToken
+GenlibScanner::read_token(
+  FileRegion& loc
+)
+{
+  auto token = scan();
+  loc = cur_region();
+  return token;
+}
+
+// @brief ';' までの文字列を論理式として読み出す．
+bool
+GenlibScanner::read_expr(
+  FileRegion& loc
+)
+{
+  mCurString.clear();
+  bool first = true;
+  for ( ; ; ) {
+    auto c = get();
+    if ( first ) {
+      set_first_loc();
+      first = false;
+    }
+    if ( c == ';' ) {
+      break;
+    }
+    if ( c == EOF ) {
+      loc = cur_region();
+      return false;
+    }
+    if ( c == '\n' || c == '\r' || c == '\t' || c == '\f' ) {
+      c = ' ';
+    }
+    mCurString += static_cast<char>(c);
+  }
+  loc = cur_region();
+  return true;
+}
+
+// @brief read_token() の下請け関数
+GenlibToken
+GenlibScanner::scan()
+{
+  int c;
+
+  mCurString.clear();
+
+ ST_INIT:
+  c = get();
+  set_first_loc();
+  switch ( c ) {
+  case EOF:
+    return GenlibToken::_EOF;
+
+  case ' ':
+  case '\t':
+  case '\r':
+  case '\n':
+  case '\f':
+    // ホワイトスペースは読み飛ばす．
+    goto ST_INIT;
+
+  case '#':
+    goto ST_COMMENT;
+
+  case '=': return GenlibToken::EQ;
+  case ';': return GenlibToken::SEMI;
+
+  default:
+    mCurString += static_cast<char>(c);
+    goto ST_WORD;
+  }
+
+ ST_WORD:
+  c = peek();
+  if ( is_delim(c) ) {
+    return GenlibToken::WORD;
+  }
+  accept();
+  mCurString += static_cast<char>(c);
+  goto ST_WORD;
+
+ ST_COMMENT:
+  c = get();
+  if ( c == '\n' ) {
+    goto ST_INIT;
+  }
+  if ( c == EOF ) {
+    return GenlibToken::_EOF;
+  }
+  goto ST_COMMENT;
+}
+
+END_NAMESPACE_YM_BN
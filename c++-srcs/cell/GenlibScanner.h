@@ -0,0 +1,95 @@
+#ifndef GENLIBSCANNER_H
+#define GENLIBSCANNER_H
+
+/// @file GenlibScanner.h
+/// @brief GenlibScanner のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "BufScanner.h"
+#include "GenlibToken.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class GenlibScanner GenlibScanner.h "GenlibScanner.h"
+/// @brief genlib 形式用の字句解析器
+///
+/// '#' から行末まではコメントとして読み飛ばす．
+/// 空白，'=', ';' 以外の連続した文字は WORD となる．
+/// 論理式は read_expr() で ';' の直前までをまとめて読み出す．
+//////////////////////////////////////////////////////////////////////
+class GenlibScanner :
+  public BufScanner
+{
+public:
+
+  /// @brief コンストラクタ
+  GenlibScanner(
+    const char* begin,        ///< [in] 内容の先頭
+    const char* end,          ///< [in] 内容の末尾の次
+    const FileInfo& file_info ///< [in] ファイル情報
+  ) : BufScanner{begin, end, file_info}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~GenlibScanner() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief トークンを一つ読み出す．
+  GenlibToken
+  read_token(
+    FileRegion& loc ///< [out] トークンの位置
+  );
+
+  /// @brief ';' までの文字列を論理式として読み出す．
+  /// @retval true 読み出しが成功した．
+  /// @retval false ';' が現れずにファイルが終わった．
+  ///
+  /// 結果は cur_string() で得られる．終端の ';' も読み込まれる．
+  bool
+  read_expr(
+    FileRegion& loc ///< [out] 論理式の位置
+  );
+
+  /// @brief 直前のトークンが WORD の時その文字列を返す．
+  const std::string&
+  cur_string() const
+  {
+    return mCurString;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief read_token() の下請け関数
+  GenlibToken
+  scan();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 文字列バッファ
+  std::string mCurString;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // GENLIBSCANNER_H
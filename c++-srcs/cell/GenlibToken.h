@@ -0,0 +1,29 @@
+#ifndef GENLIBTOKEN_H
+#define GENLIBTOKEN_H
+
+/// @file GenlibToken.h
+/// @brief GenlibToken のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @brief genlib 形式のトークンを表す列挙型
+//////////////////////////////////////////////////////////////////////
+enum class GenlibToken {
+  EQ,     // =
+  SEMI,   // ;
+  WORD,   // それ以外の文字列
+  _EOF,
+  ERROR
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // GENLIBTOKEN_H
@@ -0,0 +1,508 @@
+
+/// @file LibertyParser.cc
+/// @brief LibertyParser の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "LibertyParser.h"
+#include "LibertyScanner.h"
+#include "CellLibImpl.h"
+#include "CellFuncParser.h"
+#include "MappedFile.h"
+#include "MsgQueue.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnCellLibrary
+//////////////////////////////////////////////////////////////////////
+
+// @brief Liberty 形式のファイルを読み込む．
+BnCellLibrary
+BnCellLibrary::read_liberty(
+  const std::string& filename
+)
+{
+  BnCellLibrary library;
+  LibertyParser parser{*library.mImpl};
+  if ( !parser.read(filename) ) {
+    std::ostringstream buf;
+    buf << "BnCellLibrary::read_liberty(\"" << filename << "\") failed.";
+    throw std::invalid_argument{buf.str()};
+  }
+  return library;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス LibertyParser
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+LibertyParser::LibertyParser(
+  CellLibImpl& library
+) : mLibrary{library}
+{
+}
+
+// @brief 読み込みを行う．
+bool
+LibertyParser::read(
+  const std::string& filename
+)
+{
+  MappedFile fin;
+  if ( !fin.open(filename) ) {
+    // エラー
+    std::ostringstream buf;
+    buf << filename << " : No such file.";
+    MsgQueue::output(__FILE__, __LINE__, FileRegion(),
+		     MsgType::Failure, "LIBERTY_PARSER", buf.str());
+    return false;
+  }
+
+  FileInfo file_info{filename};
+  LibertyScanner scanner{fin.begin(), fin.ready_end(), file_info};
+  scanner.set_source(fin);
+  mScanner = &scanner;
+
+  next_token();
+  if ( mCurToken != LibertyToken::WORD ) {
+    return syntax_error();
+  }
+  Stmt top;
+  if ( !read_stmt(top) ) {
+    return false;
+  }
+  if ( mCurToken != LibertyToken::_EOF ) {
+    MsgQueue::output(__FILE__, __LINE__, mCurLoc,
+		     MsgType::Warning,
+		     "LIBERTY02",
+		     "Statements after 'library' group are ignored.");
+  }
+
+  return read_library(top);
+}
+
+// @brief 属性もしくはグループを読み込む．
+bool
+LibertyParser::read_stmt(
+  Stmt& stmt
+)
+{
+  stmt.name = mScanner->cur_string();
+  stmt.loc = mCurLoc;
+  next_token();
+  if ( mCurToken == LibertyToken::COLON ) {
+    // 単純な属性
+    next_token();
+    if ( mCurToken != LibertyToken::WORD &&
+	 mCurToken != LibertyToken::STRING ) {
+      return syntax_error();
+    }
+    stmt.value_list.push_back(mScanner->cur_string());
+    next_token();
+    // ';' は省略されることがある．
+    if ( mCurToken == LibertyToken::SEMI ) {
+      next_token();
+    }
+    return true;
+  }
+
+  if ( mCurToken != LibertyToken::LP ) {
+    return syntax_error();
+  }
+  if ( !read_value_list(stmt.value_list) ) {
+    return false;
+  }
+  if ( mCurToken == LibertyToken::LCB ) {
+    // グループ
+    stmt.is_group = true;
+    next_token();
+    for ( ; ; ) {
+      if ( mCurToken == LibertyToken::RCB ) {
+	next_token();
+	break;
+      }
+      if ( mCurToken == LibertyToken::SEMI ) {
+	// 余分な ';' は読み飛ばす．
+	next_token();
+	continue;
+      }
+      if ( mCurToken != LibertyToken::WORD ) {
+	return syntax_error();
+      }
+      stmt.child_list.push_back(Stmt{});
+      if ( !read_stmt(stmt.child_list.back()) ) {
+	return false;
+      }
+    }
+  }
+  else if ( mCurToken == LibertyToken::SEMI ) {
+    // 複合的な属性
+    next_token();
+  }
+  return true;
+}
+
+// @brief 括弧で囲まれた値のリストを読み込む．
+bool
+LibertyParser::read_value_list(
+  std::vector<std::string>& value_list
+)
+{
+  // (value (, value)*)?
+  for ( ; ; ) {
+    next_token();
+    auto tk = mCurToken;
+    if ( tk == LibertyToken::RP ) {
+      next_token();
+      return true;
+    }
+    if ( tk == LibertyToken::COMMA ) {
+      continue;
+    }
+    if ( tk != LibertyToken::WORD && tk != LibertyToken::STRING ) {
+      return syntax_error();
+    }
+    value_list.push_back(mScanner->cur_string());
+  }
+}
+
+// @brief 次のトークンを読み出す．
+void
+LibertyParser::next_token()
+{
+  mCurToken = mScanner->read_token(mCurLoc);
+}
+
+// @brief 構文エラーを出力する．
+bool
+LibertyParser::syntax_error()
+{
+  MsgQueue::output(__FILE__, __LINE__, mCurLoc,
+		   MsgType::Error,
+		   "LIBERTY01",
+		   "Syntax error.");
+  return false;
+}
+
+// @brief library グループを解釈する．
+bool
+LibertyParser::read_library(
+  const Stmt& stmt
+)
+{
+  if ( stmt.name != "library" || !stmt.is_group ) {
+    MsgQueue::output(__FILE__, __LINE__, stmt.loc,
+		     MsgType::Error,
+		     "LIBERTY03",
+		     "'library' group is expected.");
+    return false;
+  }
+  if ( !stmt.value_list.empty() ) {
+    mLibrary.set_name(stmt.value_list[0]);
+  }
+  for ( auto& child: stmt.child_list ) {
+    if ( child.name == "lu_table_template" ) {
+      read_template(child);
+    }
+    else if ( child.name == "cell" ) {
+      if ( !read_cell(child) ) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+// @brief lu_table_template グループを解釈する．
+void
+LibertyParser::read_template(
+  const Stmt& stmt
+)
+{
+  if ( stmt.value_list.empty() ) {
+    return;
+  }
+  Template tmpl;
+  for ( auto& child: stmt.child_list ) {
+    if ( child.name == "index_1" ) {
+      tmpl.index_1 = get_double_list(child);
+    }
+    else if ( child.name == "index_2" ) {
+      tmpl.index_2 = get_double_list(child);
+    }
+  }
+  mTemplateDict.emplace(stmt.value_list[0], std::move(tmpl));
+}
+
+// @brief cell グループを解釈する．
+bool
+LibertyParser::read_cell(
+  const Stmt& stmt
+)
+{
+  if ( !stmt.is_group || stmt.value_list.empty() ) {
+    MsgQueue::output(__FILE__, __LINE__, stmt.loc,
+		     MsgType::Error,
+		     "LIBERTY04",
+		     "Cell name is expected.");
+    return false;
+  }
+
+  BnCell cell;
+  cell.name = stmt.value_list[0];
+  std::vector<std::string> func_str_list;
+  for ( auto& child: stmt.child_list ) {
+    if ( child.name == "area" ) {
+      cell.area = get_double(child);
+    }
+    else if ( child.name == "pin" ) {
+      // 複数のピンをまとめて定義することができる．
+      for ( auto& name: child.value_list ) {
+	BnCellPin pin;
+	std::string func_str;
+	read_pin(child, pin, func_str);
+	pin.name = name;
+	cell.pin_list.push_back(std::move(pin));
+	func_str_list.push_back(func_str);
+      }
+    }
+    else if ( child.name == "ff" ||
+	      child.name == "latch" ||
+	      child.name == "ff_bank" ||
+	      child.name == "latch_bank" ||
+	      child.name == "statetable" ) {
+      cell.is_sequential = true;
+    }
+  }
+
+  auto np = cell.pin_list.size();
+  for ( SizeType i = 0; i < np; ++ i ) {
+    auto dir = cell.pin_list[i].direction;
+    if ( dir == BnCellPin::Input ) {
+      cell.input_list.push_back(i);
+    }
+    else if ( dir == BnCellPin::Output ) {
+      cell.output_list.push_back(i);
+    }
+  }
+
+  // 論理関数の変数は入力ピンの順番で番号づける．
+  std::vector<std::string> input_name_list;
+  for ( auto i: cell.input_list ) {
+    input_name_list.push_back(cell.pin_list[i].name);
+  }
+  for ( SizeType i = 0; i < np; ++ i ) {
+    auto& func_str = func_str_list[i];
+    if ( func_str.empty() ) {
+      continue;
+    }
+    auto& pin = cell.pin_list[i];
+    CellFuncParser parser{func_str};
+    if ( parser.parse(input_name_list, false, pin.function) ) {
+      pin.has_function = true;
+    }
+    else if ( !cell.is_sequential ) {
+      // 順序素子の出力は内部状態を参照するので警告しない．
+      std::ostringstream buf;
+      buf << cell.name << ": " << parser.error_message()
+	  << " Function of '" << pin.name << "' is ignored.";
+      MsgQueue::output(__FILE__, __LINE__, stmt.loc,
+		       MsgType::Warning,
+		       "LIBERTY05", buf.str());
+    }
+  }
+
+  auto cell_name = cell.name;
+  if ( mLibrary.add_cell(std::move(cell)) == BAD_ID ) {
+    std::ostringstream buf;
+    buf << cell_name << ": Defined more than once. Ignored.";
+    MsgQueue::output(__FILE__, __LINE__, stmt.loc,
+		     MsgType::Warning,
+		     "LIBERTY06", buf.str());
+  }
+  return true;
+}
+
+// @brief pin グループを解釈する．
+void
+LibertyParser::read_pin(
+  const Stmt& stmt,
+  BnCellPin& pin,
+  std::string& func_str
+)
+{
+  for ( auto& child: stmt.child_list ) {
+    if ( child.name == "direction" ) {
+      auto dir = get_value(child);
+      if ( dir == "input" ) {
+	pin.direction = BnCellPin::Input;
+      }
+      else if ( dir == "output" ) {
+	pin.direction = BnCellPin::Output;
+      }
+      else if ( dir == "inout" ) {
+	pin.direction = BnCellPin::Inout;
+      }
+      else if ( dir == "internal" ) {
+	pin.direction = BnCellPin::Internal;
+      }
+      else {
+	std::ostringstream buf;
+	buf << dir << ": Unknown direction. Ignored.";
+	MsgQueue::output(__FILE__, __LINE__, child.loc,
+			 MsgType::Warning,
+			 "LIBERTY07", buf.str());
+      }
+    }
+    else if ( child.name == "capacitance" ) {
+      pin.capacitance = get_double(child);
+    }
+    else if ( child.name == "function" ) {
+      func_str = get_value(child);
+    }
+    else if ( child.name == "three_state" ) {
+      pin.has_tristate = true;
+    }
+    else if ( child.name == "timing" ) {
+      pin.timing_list.push_back(BnCellTiming{});
+      read_timing(child, pin.timing_list.back());
+    }
+  }
+}
+
+// @brief timing グループを解釈する．
+void
+LibertyParser::read_timing(
+  const Stmt& stmt,
+  BnCellTiming& timing
+)
+{
+  for ( auto& child: stmt.child_list ) {
+    if ( child.name == "related_pin" ) {
+      timing.related_pin = get_value(child);
+    }
+    else if ( child.name == "timing_sense" ) {
+      timing.timing_sense = get_value(child);
+    }
+    else if ( child.name == "timing_type" ) {
+      timing.timing_type = get_value(child);
+    }
+    else if ( child.name == "cell_rise" ) {
+      read_lut(child, timing.cell_rise);
+    }
+    else if ( child.name == "cell_fall" ) {
+      read_lut(child, timing.cell_fall);
+    }
+    else if ( child.name == "rise_transition" ) {
+      read_lut(child, timing.rise_transition);
+    }
+    else if ( child.name == "fall_transition" ) {
+      read_lut(child, timing.fall_transition);
+    }
+  }
+}
+
+// @brief 遅延テーブルのグループを解釈する．
+void
+LibertyParser::read_lut(
+  const Stmt& stmt,
+  BnCellLut& lut
+)
+{
+  if ( !stmt.value_list.empty() ) {
+    lut.template_name = stmt.value_list[0];
+    // インデックスの既定値はテンプレートのものを用いる．
+    auto p = mTemplateDict.find(lut.template_name);
+    if ( p != mTemplateDict.end() ) {
+      lut.index_1 = p->second.index_1;
+      lut.index_2 = p->second.index_2;
+    }
+  }
+  for ( auto& child: stmt.child_list ) {
+    if ( child.name == "index_1" ) {
+      lut.index_1 = get_double_list(child);
+    }
+    else if ( child.name == "index_2" ) {
+      lut.index_2 = get_double_list(child);
+    }
+    else if ( child.name == "values" ) {
+      lut.values = get_double_list(child);
+    }
+  }
+}
+
+// @brief 単純な属性の値を返す．
+std::string
+LibertyParser::get_value(
+  const Stmt& stmt
+)
+{
+  if ( stmt.value_list.empty() ) {
+    std::ostringstream buf;
+    buf << stmt.name << ": Value is expected. Ignored.";
+    MsgQueue::output(__FILE__, __LINE__, stmt.loc,
+		     MsgType::Warning,
+		     "LIBERTY08", buf.str());
+    return {};
+  }
+  return stmt.value_list[0];
+}
+
+// @brief 単純な属性の値を実数に変換する．
+double
+LibertyParser::get_double(
+  const Stmt& stmt
+)
+{
+  auto val_list = get_double_list(stmt);
+  if ( val_list.size() != 1 ) {
+    std::ostringstream buf;
+    buf << stmt.name << ": A number is expected. Ignored.";
+    MsgQueue::output(__FILE__, __LINE__, stmt.loc,
+		     MsgType::Warning,
+		     "LIBERTY09", buf.str());
+    return 0.0;
+  }
+  return val_list[0];
+}
+
+// @brief 値のリストを実数のリストに変換する．
+std::vector<double>
+LibertyParser::get_double_list(
+  const Stmt& stmt
+)
+{
+  std::vector<double> ans;
+  for ( auto& value: stmt.value_list ) {
+    auto p = value.c_str();
+    for ( ; ; ) {
+      while ( *p == ',' || *p == ' ' || *p == '\t' ) {
+	++ p;
+      }
+      if ( *p == '\0' ) {
+	break;
+      }
+      char* q;
+      auto v = std::strtod(p, &q);
+      if ( q == p ) {
+	std::ostringstream buf;
+	buf << value << ": Illegal number.";
+	MsgQueue::output(__FILE__, __LINE__, stmt.loc,
+			 MsgType::Warning,
+			 "LIBERTY09", buf.str());
+	break;
+      }
+      ans.push_back(v);
+      p = q;
+    }
+  }
+  return ans;
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,227 @@
+#ifndef LIBERTYPARSER_H
+#define LIBERTYPARSER_H
+
+/// @file LibertyParser.h
+/// @brief LibertyParser のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnCellLibrary.h"
+#include "ym/FileRegion.h"
+#include "LibertyToken.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class CellLibImpl;
+class LibertyScanner;
+
+//////////////////////////////////////////////////////////////////////
+/// @class LibertyParser LibertyParser.h "LibertyParser.h"
+/// @brief Liberty 形式のファイルを読み込むパーサークラス
+///
+/// ファイル全体を属性とグループからなる構文木に変換してから
+/// 必要な情報を取り出す．
+//////////////////////////////////////////////////////////////////////
+class LibertyParser
+{
+public:
+
+  /// @brief コンストラクタ
+  LibertyParser(
+    CellLibImpl& library ///< [in] 結果を格納するオブジェクト
+  );
+
+  /// @brief デストラクタ
+  ~LibertyParser() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込みを行う．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read(
+    const std::string& filename ///< [in] ファイル名
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 構文木のノード
+  //
+  // - 単純な属性   name : value ;
+  // - 複合的な属性 name ( value, ... ) ;
+  // - グループ     name ( value, ... ) { ... }
+  // のいずれかを表す．
+  struct Stmt
+  {
+    // 名前
+    std::string name;
+
+    // 位置
+    FileRegion loc;
+
+    // 値のリスト
+    std::vector<std::string> value_list;
+
+    // グループの時 true
+    bool is_group{false};
+
+    // グループの要素のリスト
+    std::vector<Stmt> child_list;
+  };
+
+  // lu_table_template の情報
+  struct Template
+  {
+    // 1番目の変数のインデックス
+    std::vector<double> index_1;
+
+    // 2番目の変数のインデックス
+    std::vector<double> index_2;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 構文解析を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 属性もしくはグループを読み込む．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false エラーが起こった．
+  ///
+  /// 現在のトークンが名前であると仮定している．
+  bool
+  read_stmt(
+    Stmt& stmt ///< [out] 結果を格納するオブジェクト
+  );
+
+  /// @brief 括弧で囲まれた値のリストを読み込む．
+  /// @retval true 正しく読み込んだ．
+  /// @retval false エラーが起こった．
+  ///
+  /// 現在のトークンが '(' であると仮定している．
+  bool
+  read_value_list(
+    std::vector<std::string>& value_list ///< [out] 値のリスト
+  );
+
+  /// @brief 次のトークンを読み出す．
+  void
+  next_token();
+
+  /// @brief 構文エラーを出力する．
+  /// @return false を返す．
+  bool
+  syntax_error();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 構文木から情報を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief library グループを解釈する．
+  bool
+  read_library(
+    const Stmt& stmt ///< [in] library グループ
+  );
+
+  /// @brief lu_table_template グループを解釈する．
+  void
+  read_template(
+    const Stmt& stmt ///< [in] lu_table_template グループ
+  );
+
+  /// @brief cell グループを解釈する．
+  bool
+  read_cell(
+    const Stmt& stmt ///< [in] cell グループ
+  );
+
+  /// @brief pin グループを解釈する．
+  void
+  read_pin(
+    const Stmt& stmt,     ///< [in] pin グループ
+    BnCellPin& pin,       ///< [out] 結果を格納するオブジェクト
+    std::string& func_str ///< [out] function 属性の値
+  );
+
+  /// @brief timing グループを解釈する．
+  void
+  read_timing(
+    const Stmt& stmt,    ///< [in] timing グループ
+    BnCellTiming& timing ///< [out] 結果を格納するオブジェクト
+  );
+
+  /// @brief 遅延テーブルのグループを解釈する．
+  void
+  read_lut(
+    const Stmt& stmt, ///< [in] cell_rise などのグループ
+    BnCellLut& lut    ///< [out] 結果を格納するオブジェクト
+  );
+
+  /// @brief 単純な属性の値を返す．
+  ///
+  /// 値を持たない場合は警告を出して空文字列を返す．
+  static
+  std::string
+  get_value(
+    const Stmt& stmt ///< [in] 属性
+  );
+
+  /// @brief 単純な属性の値を実数に変換する．
+  static
+  double
+  get_double(
+    const Stmt& stmt ///< [in] 属性
+  );
+
+  /// @brief 値のリストを実数のリストに変換する．
+  ///
+  /// 各々の値はコンマもしくは空白で区切られた数値の並びとみなす．
+  static
+  std::vector<double>
+  get_double_list(
+    const Stmt& stmt ///< [in] 属性
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 字句解析器
+  // この変数は read() 内でのみ有効
+  LibertyScanner* mScanner{nullptr};
+
+  // 結果を格納するオブジェクト
+  CellLibImpl& mLibrary;
+
+  // 現在のトークン
+  LibertyToken mCurToken;
+
+  // 現在のトークンの位置
+  FileRegion mCurLoc;
+
+  // テンプレート名をキーにして lu_table_template の情報を格納する辞書
+  std::unordered_map<std::string, Template> mTemplateDict;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // LIBERTYPARSER_H
@@ -0,0 +1,168 @@
+
+/// @file LibertyScanner.cc
+/// @brief LibertyScanner の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "LibertyScanner.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// WORD を終わらせる文字の時 true を返す．
+inline
+bool
+is_delim(
+  int c
+)
+{
+  switch ( c ) {
+  case EOF:
+  case ' ':
+  case '\t':
+  case '\n':
+  case '\f':
+  case '(':
+  case ')':
+  case '{':
+  case '}':
+  case ':':
+  case ';':
+  case ',':
+  case '"':
+  case '\\':
+    return true;
+  default:
+    return false;
+  }
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// Liberty 形式用の字句解析器
+//////////////////////////////////////////////////////////////////////
+
+// @brief トークンを一つ読み出す．
+LibertyToken
+LibertyScanner::read_token(
+  FileRegion& loc
+)
+{
+  auto token = scan();
+  loc = cur_region();
+  return token;
+}
+
+// @brief read_token() の下請け関数
+LibertyToken
+LibertyScanner::scan()
+{
+  int c;
+
+  mCurString.clear();
+
+  // 状態遷移を goto 文で表現したもの
+
+ ST_INIT:
+  c = get();
+  set_first_loc();
+  switch ( c ) {
+  case EOF:
+    return LibertyToken::_EOF;
+
+  case ' ':
+  case '\t':
+  case '\n':
+  case '\f':
+    // ホワイトスペースは読み飛ばす．
+    goto ST_INIT;
+
+  case '\\':
+    // 行の継続
+    if ( peek() == '\n' ) {
+      accept();
+      goto ST_INIT;
+    }
+    return LibertyToken::ERROR;
+
+  case '/':
+    if ( peek() == '*' ) {
+      accept();
+      goto ST_COMMENT;
+    }
+    mCurString += '/';
+    goto ST_WORD;
+
+  case '(': return LibertyToken::LP;
+  case ')': return LibertyToken::RP;
+  case '{': return LibertyToken::LCB;
+  case '}': return LibertyToken::RCB;
+  case ':': return LibertyToken::COLON;
+  case ';': return LibertyToken::SEMI;
+  case ',': return LibertyToken::COMMA;
+
+  case '"':
+    goto ST_STRING;
+
+  default:
+    mCurString += static_cast<char>(c);
+    goto ST_WORD;
+  }
+
+ ST_WORD:
+  c = peek();
+  if ( is_delim(c) ) {
+    return LibertyToken::WORD;
+  }
+  accept();
+  mCurString += static_cast<char>(c);
+  goto ST_WORD;
+
+ ST_STRING:
+  c = get();
+  if ( c == '"' ) {
+    return LibertyToken::STRING;
+  }
+  if ( c == '\\' && peek() == '\n' ) {
+    // 文字列中の行の継続
+    accept();
+    goto ST_STRING;
+  }
+  if ( c == EOF ) {
+    // 文字列が閉じていない．
+    return LibertyToken::ERROR;
+  }
+  mCurString += static_cast<char>(c);
+  goto ST_STRING;
+
+ ST_COMMENT:
+  c = get();
+  if ( c == '*' ) {
+    goto ST_COMMENT2;
+  }
+  if ( c == EOF ) {
+    // コメントが閉じていない．
+    return LibertyToken::ERROR;
+  }
+  goto ST_COMMENT;
+
+ ST_COMMENT2:
+  c = get();
+  if ( c == '/' ) {
+    goto ST_INIT;
+  }
+  if ( c == '*' ) {
+    goto ST_COMMENT2;
+  }
+  if ( c == EOF ) {
+    return LibertyToken::ERROR;
+  }
+  goto ST_COMMENT;
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,85 @@
+#ifndef LIBERTYSCANNER_H
+#define LIBERTYSCANNER_H
+
+/// @file LibertyScanner.h
+/// @brief LibertyScanner のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "BufScanner.h"
+#include "LibertyToken.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class LibertyScanner LibertyScanner.h "LibertyScanner.h"
+/// @brief Liberty 形式用の字句解析器
+///
+/// コメント(/* */)は読み飛ばし，'\\' に続く改行は空白とみなす．
+/// 区切り文字以外の連続した文字は WORD となるので，
+/// 数値も WORD として扱われる．
+//////////////////////////////////////////////////////////////////////
+class LibertyScanner :
+  public BufScanner
+{
+public:
+
+  /// @brief コンストラクタ
+  LibertyScanner(
+    const char* begin,        ///< [in] 内容の先頭
+    const char* end,          ///< [in] 内容の末尾の次
+    const FileInfo& file_info ///< [in] ファイル情報
+  ) : BufScanner{begin, end, file_info}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~LibertyScanner() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief トークンを一つ読み出す．
+  LibertyToken
+  read_token(
+    FileRegion& loc ///< [out] トークンの位置
+  );
+
+  /// @brief 直前のトークンが STRING か WORD の時その文字列を返す．
+  const std::string&
+  cur_string() const
+  {
+    return mCurString;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief read_token() の下請け関数
+  LibertyToken
+  scan();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 文字列バッファ
+  std::string mCurString;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // LIBERTYSCANNER_H
@@ -0,0 +1,35 @@
+#ifndef LIBERTYTOKEN_H
+#define LIBERTYTOKEN_H
+
+/// @file LibertyToken.h
+/// @brief LibertyToken のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Liberty 形式のトークンを表す列挙型
+//////////////////////////////////////////////////////////////////////
+enum class LibertyToken {
+  LP,     // (
+  RP,     // )
+  LCB,    // {
+  RCB,    // }
+  COLON,  // :
+  SEMI,   // ;
+  COMMA,  // ,
+  STRING, // "..." で囲まれた文字列
+  WORD,   // それ以外の文字列
+  _EOF,
+  ERROR
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // LIBERTYTOKEN_H
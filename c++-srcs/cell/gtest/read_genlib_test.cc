@@ -0,0 +1,196 @@
+
+/// @file read_genlib_test.cc
+/// @brief read_genlib_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnCellLibrary.h"
+#include "ym/BnModelBuilder.h"
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+TEST( BnCellLibraryTest, read_genlib1 )
+{
+  auto filename = std::string{DATAPATH} + "lib2.genlib";
+  auto library = BnCellLibrary::read_genlib(filename);
+  EXPECT_EQ( 29, library.cell_num() );
+
+  auto& inv = library.cell(library.find_cell("inv1x"));
+  EXPECT_DOUBLE_EQ( 928.0, inv.area );
+  ASSERT_EQ( 1, inv.input_list.size() );
+  ASSERT_EQ( 1, inv.output_list.size() );
+  EXPECT_TRUE( inv.is_logic() );
+  auto& pin_a = inv.pin_list[inv.input_list[0]];
+  EXPECT_EQ( "a", pin_a.name );
+  EXPECT_DOUBLE_EQ( 0.0514, pin_a.capacitance );
+  auto& pin_o = inv.pin_list[inv.output_list[0]];
+  EXPECT_EQ( "O", pin_o.name );
+  EXPECT_EQ( BnCellPin::Output, pin_o.direction );
+  EXPECT_EQ( (~Expr::literal(0)).tvfunc(1), pin_o.function.tvfunc(1) );
+  ASSERT_EQ( 1, pin_o.timing_list.size() );
+  auto& timing = pin_o.timing_list[0];
+  EXPECT_EQ( "a", timing.related_pin );
+  EXPECT_EQ( "negative_unate", timing.timing_sense );
+  EXPECT_DOUBLE_EQ( 0.42, timing.rise_block_delay );
+  EXPECT_DOUBLE_EQ( 4.71, timing.rise_fanout_delay );
+  EXPECT_DOUBLE_EQ( 0.42, timing.fall_block_delay );
+  EXPECT_DOUBLE_EQ( 3.60, timing.fall_fanout_delay );
+
+  // 入力ピンは論理式中に現れた順となる．
+  auto& aoi = library.cell(library.find_cell("aoi21"));
+  ASSERT_EQ( 3, aoi.input_list.size() );
+  EXPECT_EQ( "a1", aoi.pin_list[aoi.input_list[0]].name );
+  EXPECT_EQ( "a2", aoi.pin_list[aoi.input_list[1]].name );
+  EXPECT_EQ( "b", aoi.pin_list[aoi.input_list[2]].name );
+  auto a1 = Expr::literal(0);
+  auto a2 = Expr::literal(1);
+  auto b = Expr::literal(2);
+  EXPECT_EQ( (~((a1 & a2) | b)).tvfunc(3),
+	     aoi.pin_list[aoi.output_list[0]].function.tvfunc(3) );
+
+  auto& xor_cell = library.cell(library.find_cell("xor"));
+  EXPECT_EQ( "non_unate",
+	     xor_cell.pin_list[xor_cell.output_list[0]].timing_list[0].timing_sense );
+
+  auto& zero = library.cell(library.find_cell("zero"));
+  EXPECT_EQ( 0, zero.input_list.size() );
+  EXPECT_EQ( Expr::zero().tvfunc(0),
+	     zero.pin_list[zero.output_list[0]].function.tvfunc(0) );
+}
+
+TEST( BnCellLibraryTest, read_genlib2 )
+{
+  auto path = make_file("test2.genlib",
+			"# comment\n"
+			"GATE and2 2 Y=A*B;\n"
+			"  PIN * NONINV 1 999 1 0.5 1 0.5\n"
+			"GATE buf_en 3 Y=A;\n"
+			"  PIN A NONINV 1 999 1 0.5 1 0.5\n"
+			"  PIN EN UNKNOWN 2 999 1 0.5 1 0.5\n"
+			"LATCH dlat 5 Q=D;\n"
+			"  PIN D NONINV 1 999 1 0.5 1 0.5\n"
+			"  SEQ Q ANY ACTIVE_HIGH\n"
+			"  CONTROL G 1 999 1 0.5 1 0.5\n"
+			"GATE tie1 1 Y=CONST1;\n");
+  auto library = BnCellLibrary::read_genlib(path);
+  ASSERT_EQ( 4, library.cell_num() );
+
+  auto& and2 = library.cell(0);
+  auto& and2_out = and2.pin_list[and2.output_list[0]];
+  ASSERT_EQ( 2, and2_out.timing_list.size() );
+  EXPECT_EQ( "A", and2_out.timing_list[0].related_pin );
+  EXPECT_EQ( "B", and2_out.timing_list[1].related_pin );
+  EXPECT_EQ( "positive_unate", and2_out.timing_list[1].timing_sense );
+
+  // 論理式に現れないピンは入力の末尾に加えられる．
+  auto& buf_en = library.cell(1);
+  ASSERT_EQ( 2, buf_en.input_list.size() );
+  EXPECT_EQ( "EN", buf_en.pin_list[buf_en.input_list[1]].name );
+  EXPECT_DOUBLE_EQ( 2.0, buf_en.pin_list[buf_en.input_list[1]].capacitance );
+
+  auto& dlat = library.cell(2);
+  EXPECT_TRUE( dlat.is_sequential );
+  EXPECT_FALSE( dlat.is_logic() );
+
+  EXPECT_EQ( "tie1", library.cell(3).name );
+}
+
+TEST( BnCellLibraryTest, read_genlib_error )
+{
+  auto path1 = make_file("error1.genlib",
+			 "GATE and2 2 Y=A*B\n"
+			 "  PIN * NONINV 1 999 1 0.5 1 0.5\n");
+  EXPECT_THROW( BnCellLibrary::read_genlib(path1), std::invalid_argument );
+
+  auto path2 = make_file("error2.genlib",
+			 "GATE and2 x2 Y=A*B;\n");
+  EXPECT_THROW( BnCellLibrary::read_genlib(path2), std::invalid_argument );
+
+  auto path3 = make_file("error3.genlib",
+			 "GATE and2 2 Y=A*(B;\n");
+  EXPECT_THROW( BnCellLibrary::read_genlib(path3), std::invalid_argument );
+}
+
+TEST( BnModelBuilderTest, reg_cell )
+{
+  auto filename = std::string{DATAPATH} + "lib2.genlib";
+  auto library = BnCellLibrary::read_genlib(filename);
+  auto nand2 = library.find_cell("nand2");
+  auto nor2 = library.find_cell("nor2");
+
+  BnModelBuilder builder;
+  auto a = builder.new_input("a");
+  auto b = builder.new_input("b");
+  auto fid1 = builder.reg_cell(library, nand2);
+  auto fid2 = builder.reg_cell(library, nor2);
+  auto fid3 = builder.reg_cell(library, nand2);
+  EXPECT_NE( fid1, fid2 );
+  EXPECT_EQ( fid1, fid3 );
+  auto n1 = builder.new_logic(fid1, {a, b});
+  auto n2 = builder.new_logic(fid2, {a, n1});
+  builder.new_output(n2, "z");
+  EXPECT_THROW( builder.reg_cell(library, library.cell_num()),
+		std::out_of_range );
+  auto model = builder.wrap_up();
+  EXPECT_EQ( 2, model.func_num() );
+
+  std::vector<bool> ivals(2);
+  for ( SizeType p = 0; p < 4; ++ p ) {
+    ivals[0] = p & 1;
+    ivals[1] = (p >> 1) & 1;
+    bool v1 = !(ivals[0] && ivals[1]);
+    bool v2 = !(ivals[0] || v1);
+    EXPECT_EQ( (std::vector<bool>{v2}), simulate(model, ivals) )
+      << "p = " << p;
+  }
+}
+
+TEST( BnModelBuilderTest, reg_cell_bad )
+{
+  auto path = make_file("seq.genlib",
+			"LATCH dlat 5 Q=D;\n"
+			"  PIN D NONINV 1 999 1 0.5 1 0.5\n"
+			"  SEQ Q ANY ACTIVE_HIGH\n");
+  auto library = BnCellLibrary::read_genlib(path);
+  BnModelBuilder builder;
+  EXPECT_THROW( builder.reg_cell(library, 0), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_blif_genlib )
+{
+  auto filename = std::string{DATAPATH} + "lib2.genlib";
+  auto library = BnCellLibrary::read_genlib(filename);
+  auto path = make_file("genlib.blif",
+			".model genlib\n"
+			".inputs a b c\n"
+			".outputs y\n"
+			".gate nand2 a=a b=b O=n1\n"
+			".gate aoi21 b=c a1=n1 a2=a O=n2\n"
+			".gate nand2 a=n2 b=c O=y\n"
+			".end\n");
+  auto model = BnModel::read_blif(path, library);
+  EXPECT_EQ( 3, model.logic_num() );
+  EXPECT_EQ( 2, model.func_num() );
+
+  std::vector<bool> ivals(3);
+  for ( SizeType p = 0; p < 8; ++ p ) {
+    for ( SizeType i = 0; i < 3; ++ i ) {
+      ivals[i] = (p >> i) & 1;
+    }
+    bool a = ivals[0];
+    bool b = ivals[1];
+    bool c = ivals[2];
+    bool n1 = !(a && b);
+    bool n2 = !((n1 && a) || c);
+    bool y = !(n2 && c);
+    EXPECT_EQ( (std::vector<bool>{y}), simulate(model, ivals) )
+      << "p = " << p;
+  }
+}
+
+END_NAMESPACE_YM_BN
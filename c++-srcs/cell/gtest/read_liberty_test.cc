@@ -0,0 +1,232 @@
+
+/// @file read_liberty_test.cc
+/// @brief read_liberty_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnCellLibrary.h"
+#include "CellFuncParser.h"
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+TEST( BnCellLibraryTest, read_liberty1 )
+{
+  auto filename = std::string{DATAPATH} + "HIT018.typ.snp";
+  auto library = BnCellLibrary::read_liberty(filename);
+  EXPECT_EQ( "HIT018", library.name() );
+  EXPECT_EQ( 310, library.cell_num() );
+
+  auto cell_id = library.find_cell("HIT18AND2P005");
+  ASSERT_NE( BAD_ID, cell_id );
+  auto& cell = library.cell(cell_id);
+  EXPECT_EQ( "HIT18AND2P005", cell.name );
+  EXPECT_DOUBLE_EQ( 38.4, cell.area );
+  ASSERT_EQ( 3, cell.pin_list.size() );
+  ASSERT_EQ( 2, cell.input_list.size() );
+  ASSERT_EQ( 1, cell.output_list.size() );
+  EXPECT_FALSE( cell.is_sequential );
+  EXPECT_TRUE( cell.is_logic() );
+
+  auto& pin_a = cell.pin_list[cell.input_list[0]];
+  EXPECT_EQ( "A", pin_a.name );
+  EXPECT_EQ( BnCellPin::Input, pin_a.direction );
+  EXPECT_DOUBLE_EQ( 0.003052, pin_a.capacitance );
+  EXPECT_EQ( "B", cell.pin_list[cell.input_list[1]].name );
+  EXPECT_EQ( 2, cell.find_pin("Y") );
+  EXPECT_EQ( BAD_ID, cell.find_pin("Z") );
+
+  auto& pin_y = cell.pin_list[cell.output_list[0]];
+  EXPECT_EQ( BnCellPin::Output, pin_y.direction );
+  ASSERT_TRUE( pin_y.has_function );
+  auto expr = Expr::literal(0) & Expr::literal(1);
+  EXPECT_EQ( expr.tvfunc(2), pin_y.function.tvfunc(2) );
+
+  ASSERT_EQ( 2, pin_y.timing_list.size() );
+  auto& timing = pin_y.timing_list[0];
+  EXPECT_EQ( "A", timing.related_pin );
+  EXPECT_EQ( "positive_unate", timing.timing_sense );
+  auto& lut = timing.cell_rise;
+  EXPECT_EQ( "DELAY_6", lut.template_name );
+  EXPECT_EQ( (std::vector<double>{0.005, 0.05, 0.14, 0.3}), lut.index_1 );
+  EXPECT_EQ( (std::vector<double>{0.04, 0.92, 2.0}), lut.index_2 );
+  ASSERT_EQ( 12, lut.values.size() );
+  EXPECT_DOUBLE_EQ( 0.116371, lut.values[0] );
+  EXPECT_DOUBLE_EQ( 1.289372, lut.values[11] );
+  EXPECT_DOUBLE_EQ( 0.084900, timing.fall_transition.values[0] );
+
+  auto& dff = library.cell(library.find_cell("HIT18DFNP010"));
+  EXPECT_TRUE( dff.is_sequential );
+  EXPECT_FALSE( dff.is_logic() );
+
+  EXPECT_EQ( BAD_ID, library.find_cell("NO_SUCH_CELL") );
+  EXPECT_THROW( library.cell(library.cell_num()), std::out_of_range );
+}
+
+TEST( BnCellLibraryTest, read_liberty2 )
+{
+  auto path = make_file("test2.lib",
+			"/* comment */\n"
+			"library (test2) {\n"
+			"  cell (AOI21) {\n"
+			"    area : 3;\n"
+			"    pin (A1, A2, B) { direction : input; }\n"
+			"    pin (ZN) {\n"
+			"      direction : output;\n"
+			"      function : \"!((A1 A2) + B)\";\n"
+			"    }\n"
+			"  }\n"
+			"  cell (TIE1) {\n"
+			"    area : 1;\n"
+			"    pin (Z) { direction : output; function : \"1\"; }\n"
+			"  }\n"
+			"}\n");
+  auto library = BnCellLibrary::read_liberty(path);
+  EXPECT_EQ( "test2", library.name() );
+  ASSERT_EQ( 2, library.cell_num() );
+  auto& cell = library.cell(0);
+  EXPECT_EQ( "AOI21", cell.name );
+  ASSERT_EQ( 3, cell.input_list.size() );
+  EXPECT_EQ( "A2", cell.pin_list[cell.input_list[1]].name );
+  auto& func = cell.pin_list[cell.output_list[0]].function;
+  auto a1 = Expr::literal(0);
+  auto a2 = Expr::literal(1);
+  auto b = Expr::literal(2);
+  EXPECT_EQ( (~((a1 & a2) | b)).tvfunc(3), func.tvfunc(3) );
+  auto& tie = library.cell(1);
+  EXPECT_EQ( 0, tie.input_list.size() );
+  EXPECT_TRUE( tie.is_logic() );
+  EXPECT_EQ( Expr::one().tvfunc(0),
+	     tie.pin_list[tie.output_list[0]].function.tvfunc(0) );
+}
+
+TEST( BnCellLibraryTest, read_liberty_error )
+{
+  auto path = make_file("error.lib",
+			"library (error) {\n"
+			"  cell (X) {\n"
+			"    area : 1;\n"
+			"}\n");
+  EXPECT_THROW( BnCellLibrary::read_liberty(path), std::invalid_argument );
+}
+
+TEST( CellFuncParserTest, parse )
+{
+  std::vector<std::string> var_list{"A", "B", "C"};
+  auto a = Expr::literal(0);
+  auto b = Expr::literal(1);
+  auto c = Expr::literal(2);
+  std::vector<std::pair<std::string, Expr>> case_list{
+    {"A*B+C", (a & b) | c},
+    {"A+B*C", a | (b & c)},
+    {"(A|B)&C", (a | b) & c},
+    {"A'B", ~a & b},
+    {"!A^B", ~a ^ b},
+    {"A B C", a & b & c},
+    {"CONST0", Expr::zero()},
+    {"CONST1", Expr::one()},
+  };
+  for ( auto& p: case_list ) {
+    CellFuncParser parser{p.first};
+    auto vlist = var_list;
+    Expr expr;
+    ASSERT_TRUE( parser.parse(vlist, false, expr) ) << p.first;
+    EXPECT_EQ( p.second.tvfunc(3), expr.tvfunc(3) ) << p.first;
+  }
+
+  CellFuncParser parser1{"A&D"};
+  auto vlist = var_list;
+  Expr expr;
+  EXPECT_FALSE( parser1.parse(vlist, false, expr) );
+
+  CellFuncParser parser2{"(A&B"};
+  EXPECT_FALSE( parser2.parse(vlist, false, expr) );
+}
+
+TEST( BnModelTest, read_blif_gate )
+{
+  auto filename = std::string{DATAPATH} + "HIT018.typ.snp";
+  auto library = BnCellLibrary::read_liberty(filename);
+  auto path = make_file("gate.blif",
+			".model gate\n"
+			".inputs a b c\n"
+			".outputs y z\n"
+			".gate HIT18AND2P005 B=b A=a Y=n1\n"
+			".gate HIT18MUX2P010 D0=n1 D1=c S=a Y=y\n"
+			".gate HIT18AND2P005 Y=n2 A=n1 B=c\n"
+			".names n2 z\n"
+			"0 1\n"
+			".end\n");
+  auto model = BnModel::read_blif(path, library);
+  ASSERT_EQ( 3, model.input_num() );
+  ASSERT_EQ( 2, model.output_num() );
+  EXPECT_EQ( 4, model.logic_num() );
+  // 同じセルの関数は1度だけ登録される．
+  EXPECT_EQ( 3, model.func_num() );
+
+  auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+      {"thread_num", JsonValue{4}}}};
+  auto model2 = BnModel::read_blif(path, library, option);
+  EXPECT_EQ( model.func_num(), model2.func_num() );
+
+  std::vector<bool> ivals(3);
+  for ( SizeType p = 0; p < 8; ++ p ) {
+    for ( SizeType i = 0; i < 3; ++ i ) {
+      ivals[i] = (p >> i) & 1;
+    }
+    bool a = ivals[0];
+    bool b = ivals[1];
+    bool c = ivals[2];
+    bool n1 = a && b;
+    bool y = a ? c : n1;
+    bool z = !(n1 && c);
+    EXPECT_EQ( (std::vector<bool>{y, z}), simulate(model, ivals) )
+      << "p = " << p;
+    EXPECT_EQ( (std::vector<bool>{y, z}), simulate(model2, ivals) )
+      << "p = " << p;
+  }
+}
+
+TEST( BnModelTest, read_blif_gate_error )
+{
+  auto filename = std::string{DATAPATH} + "HIT018.typ.snp";
+  auto library = BnCellLibrary::read_liberty(filename);
+  auto path1 = make_file("gate_err1.blif",
+			 ".model gate\n"
+			 ".inputs a b\n"
+			 ".outputs y\n"
+			 ".gate NO_SUCH_CELL A=a B=b Y=y\n"
+			 ".end\n");
+  EXPECT_THROW( BnModel::read_blif(path1, library), std::invalid_argument );
+
+  auto path2 = make_file("gate_err2.blif",
+			 ".model gate\n"
+			 ".inputs a b\n"
+			 ".outputs y\n"
+			 ".gate HIT18AND2P005 A=a C=b Y=y\n"
+			 ".end\n");
+  EXPECT_THROW( BnModel::read_blif(path2, library), std::invalid_argument );
+
+  auto path3 = make_file("gate_err3.blif",
+			 ".model gate\n"
+			 ".inputs a b\n"
+			 ".outputs y\n"
+			 ".gate HIT18AND2P005 A=a Y=y\n"
+			 ".end\n");
+  EXPECT_THROW( BnModel::read_blif(path3, library), std::invalid_argument );
+
+  auto path4 = make_file("gate_ok.blif",
+			 ".model gate\n"
+			 ".inputs a b\n"
+			 ".outputs y\n"
+			 ".gate HIT18AND2P005 A=a B=b Y=y\n"
+			 ".end\n");
+  // セルライブラリがなければエラーとなる．
+  EXPECT_THROW( BnModel::read_blif(path4), std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
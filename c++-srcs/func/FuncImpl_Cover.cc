@@ -94,9 +94,10 @@ std::string
 FuncImpl_Cover::signature() const
 {
   std::ostringstream buf;
-  buf << "c" << mInputCover.variable_num() << ":";
   auto nc = mInputCover.cube_num();
   auto ni = mInputCover.variable_num();
+  // 入力数0の時は空のカバーと恒真のキューブを区別するためにキューブ数も含める．
+  buf << "c" << ni << ":" << nc << ":";
   for ( SizeType c = 0; c < nc; ++ c ) {
     for ( SizeType i = 0; i < ni; ++ i ) {
       buf << mInputCover.get_pat(c, i);
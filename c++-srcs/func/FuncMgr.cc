@@ -11,6 +11,87 @@
 
 BEGIN_NAMESPACE_YM_BN
 
+BEGIN_NONAMESPACE
+
+// パタンを表す2ビットの符号
+const int CODE_X = 0;
+const int CODE_1 = 1;
+const int CODE_0 = 2;
+
+// SopPat を符号に変換する．
+inline
+int
+pat_code(
+  SopPat pat
+)
+{
+  switch ( pat ) {
+  case SopPat::_1: return CODE_1;
+  case SopPat::_0: return CODE_0;
+  default: break;
+  }
+  return CODE_X;
+}
+
+// 文字を符号に変換する．
+//
+// 不正な文字の場合は -1 を返す．
+inline
+int
+char_code(
+  char c
+)
+{
+  switch ( c ) {
+  case '1': return CODE_1;
+  case '0': return CODE_0;
+  case '-': return CODE_X;
+  default: break;
+  }
+  return -1;
+}
+
+// キューブのバッファに符号を書き込む．
+inline
+void
+set_code(
+  char* cube,
+  SizeType pos,
+  int code
+)
+{
+  cube[pos / 4] |= static_cast<char>(code << ((pos % 4) * 2));
+}
+
+// キューブのバッファから符号を読み出す．
+inline
+int
+get_code(
+  const char* cube,
+  SizeType pos
+)
+{
+  return (static_cast<unsigned char>(cube[pos / 4]) >> ((pos % 4) * 2)) & 3;
+}
+
+// キーに整数を追加する．
+inline
+void
+append_int(
+  std::string& key,
+  SizeType val
+)
+{
+  key.append(reinterpret_cast<const char*>(&val), sizeof(val));
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス FuncMgr
+//////////////////////////////////////////////////////////////////////
+
 // @brief コピーコンストラクタもどき
 FuncMgr::FuncMgr(
   const FuncMgr& src
@@ -20,7 +101,14 @@ FuncMgr::FuncMgr(
     SizeType id = mFuncArray.size();
     mFuncArray.push_back(src_func->copy(mBddMgr));
     auto func = mFuncArray.back().get();
-    mFuncMap.emplace(func, id);
+    if ( func->is_cover() ) {
+      set_cover(func->input_cover());
+      make_cover_key(func->output_inv());
+      mCoverMap.emplace(mCoverKey, id);
+    }
+    else {
+      mFuncMap.emplace(func, id);
+    }
   }
 }
 
@@ -30,6 +118,7 @@ FuncMgr::clear()
 {
   mFuncArray.clear();
   mFuncMap.clear();
+  mCoverMap.clear();
 }
 
 // @brief プリミティブ型を登録する．
@@ -50,8 +139,87 @@ FuncMgr::reg_cover(
   bool output_inv
 )
 {
+  set_cover(input_cover);
+  make_cover_key(output_inv);
+  auto p = mCoverMap.find(mCoverKey);
+  if ( p != mCoverMap.end() ) {
+    return p->second;
+  }
   auto func = FuncImpl::new_cover(input_cover, output_inv);
-  return reg_func(func);
+  return reg_cover_func(func);
+}
+
+// @brief キューブを順に与えてカバー型を登録する準備をする．
+void
+FuncMgr::begin_cover(
+  SizeType input_num
+)
+{
+  mCoverInputNum = input_num;
+  mCoverCubeSize = (input_num + 3) / 4;
+  mCoverCubeNum = 0;
+  mCoverBuff.clear();
+}
+
+// @brief キューブを追加する．
+bool
+FuncMgr::add_cube(
+  const std::string_view& pat
+)
+{
+  if ( pat.size() != mCoverInputNum ) {
+    return false;
+  }
+  auto base = mCoverBuff.size();
+  mCoverBuff.resize(base + mCoverCubeSize, '\0');
+  auto cube = &mCoverBuff[base];
+  for ( SizeType i = 0; i < mCoverInputNum; ++ i ) {
+    auto code = char_code(pat[i]);
+    if ( code < 0 ) {
+      mCoverBuff.resize(base);
+      return false;
+    }
+    set_code(cube, i, code);
+  }
+  ++ mCoverCubeNum;
+  return true;
+}
+
+// @brief 追加したキューブからなるカバー型を登録する．
+SizeType
+FuncMgr::end_cover(
+  bool output_inv
+)
+{
+  make_cover_key(output_inv);
+  auto p = mCoverMap.find(mCoverKey);
+  if ( p != mCoverMap.end() ) {
+    // 既に同じ並びのキューブが登録されていたので SopCover は作らない．
+    return p->second;
+  }
+  std::string raw_key;
+  raw_key.swap(mCoverKey);
+
+  auto ni = mCoverInputNum;
+  std::vector<std::vector<Literal>> cube_list(mCoverCubeNum);
+  for ( SizeType c = 0; c < mCoverCubeNum; ++ c ) {
+    auto cube = &mCoverBuff[c * mCoverCubeSize];
+    auto& lit_list = cube_list[c];
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto code = get_code(cube, i);
+      if ( code == CODE_1 ) {
+	lit_list.push_back(Literal(i, false));
+      }
+      else if ( code == CODE_0 ) {
+	lit_list.push_back(Literal(i, true));
+      }
+    }
+  }
+  // 同一性の判定は SopCover の正規形で行う．
+  auto id = reg_cover(SopCover{ni, cube_list}, output_inv);
+  // 同じ並びのキューブが再び現れた時のために別名として登録しておく．
+  mCoverMap.emplace(std::move(raw_key), id);
+  return id;
 }
 
 // @brief 論理式型を登録する．
@@ -103,4 +271,53 @@ FuncMgr::reg_func(
   return id;
 }
 
+// @brief カバーの内容をキューブのバッファに設定する．
+void
+FuncMgr::set_cover(
+  const SopCover& cover
+)
+{
+  auto ni = cover.variable_num();
+  auto nc = cover.cube_num();
+  begin_cover(ni);
+  mCoverBuff.resize(nc * mCoverCubeSize, '\0');
+  for ( SizeType c = 0; c < nc; ++ c ) {
+    auto cube = &mCoverBuff[c * mCoverCubeSize];
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      set_code(cube, i, pat_code(cover.get_pat(c, i)));
+    }
+  }
+  mCoverCubeNum = nc;
+}
+
+// @brief キューブのバッファの内容からカバーのキーを作る．
+void
+FuncMgr::make_cover_key(
+  bool output_inv
+)
+{
+  // キューブの順番は変えない．
+  // 並べ替えや重複の除去は SopCover に任せる．
+  auto nc = mCoverCubeNum;
+  auto size = mCoverCubeSize;
+  mCoverKey.clear();
+  mCoverKey.reserve(sizeof(SizeType) * 2 + 1 + nc * size);
+  append_int(mCoverKey, mCoverInputNum);
+  append_int(mCoverKey, nc);
+  mCoverKey.push_back(output_inv ? '1' : '0');
+  mCoverKey.append(mCoverBuff.data(), nc * size);
+}
+
+// @brief mCoverKey をキーとしてカバー型の関数情報を登録する．
+SizeType
+FuncMgr::reg_cover_func(
+  FuncImpl* func
+)
+{
+  auto id = mFuncArray.size();
+  mFuncArray.push_back(std::unique_ptr<FuncImpl>{func});
+  mCoverMap.emplace(mCoverKey, id);
+  return id;
+}
+
 END_NAMESPACE_YM_BN
@@ -0,0 +1,98 @@
+
+/// @file Isop.cc
+/// @brief isop() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Isop.h"
+#include "ym/TvFunc.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 真理値表の型
+using TvBits = std::vector<std::uint8_t>;
+
+// isop() の下請け関数
+//
+// lower <= R <= upper となる関数 R の主項を cube_list に追加し，
+// R の真理値表を返す．
+// 変数 0 〜 var_num - 1 が対象で pat がそれ以外の変数の値を表す．
+TvBits
+isop_sub(
+  const TvBits& lower,
+  const TvBits& upper,
+  SizeType var_num,
+  std::string& pat,
+  std::vector<std::string>& cube_list
+)
+{
+  auto n = lower.size();
+  if ( std::find(lower.begin(), lower.end(), 1) == lower.end() ) {
+    return TvBits(n, 0);
+  }
+  if ( std::find(upper.begin(), upper.end(), 0) == upper.end() ) {
+    cube_list.push_back(pat);
+    return TvBits(n, 1);
+  }
+
+  auto var = var_num - 1;
+  auto h = n / 2;
+  TvBits l0(lower.begin(), lower.begin() + h);
+  TvBits l1(lower.begin() + h, lower.end());
+  TvBits u0(upper.begin(), upper.begin() + h);
+  TvBits u1(upper.begin() + h, upper.end());
+
+  TvBits tmp(h);
+  for ( SizeType i = 0; i < h; ++ i ) {
+    tmp[i] = l0[i] & ~u1[i] & 1;
+  }
+  pat[var] = '0';
+  auto r0 = isop_sub(tmp, u0, var, pat, cube_list);
+
+  for ( SizeType i = 0; i < h; ++ i ) {
+    tmp[i] = l1[i] & ~u0[i] & 1;
+  }
+  pat[var] = '1';
+  auto r1 = isop_sub(tmp, u1, var, pat, cube_list);
+
+  for ( SizeType i = 0; i < h; ++ i ) {
+    tmp[i] = (l0[i] & ~r0[i] & 1) | (l1[i] & ~r1[i] & 1);
+    u0[i] &= u1[i];
+  }
+  pat[var] = '-';
+  auto rs = isop_sub(tmp, u0, var, pat, cube_list);
+
+  TvBits ans(n);
+  for ( SizeType i = 0; i < h; ++ i ) {
+    ans[i] = r0[i] | rs[i];
+    ans[i + h] = r1[i] | rs[i];
+  }
+  return ans;
+}
+
+END_NONAMESPACE
+
+// @brief 真理値表の非冗長積和形を求める．
+std::vector<std::string>
+isop(
+  const TvFunc& func
+)
+{
+  auto ni = func.input_num();
+  SizeType np = 1 << ni;
+  TvBits bits(np);
+  for ( SizeType p = 0; p < np; ++ p ) {
+    bits[p] = func.value(p) ? 1 : 0;
+  }
+  std::string pat(ni, '-');
+  std::vector<std::string> cube_list;
+  isop_sub(bits, bits, ni, pat, cube_list);
+  return cube_list;
+}
+
+END_NAMESPACE_YM_BN
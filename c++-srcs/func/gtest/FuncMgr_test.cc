@@ -0,0 +1,151 @@
+
+/// @file FuncMgr_test.cc
+/// @brief FuncMgr_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "FuncMgr.h"
+#include "ym/SopCover.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+TEST(FuncMgr_test, reg_cover)
+{
+  FuncMgr mgr;
+  auto lit0 = Literal(0, false);
+  auto lit1 = Literal(1, true);
+  auto cover = SopCover(2, {{lit0}, {lit1}});
+  auto id1 = mgr.reg_cover(cover, false);
+  auto id2 = mgr.reg_cover(cover, false);
+  auto id3 = mgr.reg_cover(cover, true);
+
+  EXPECT_EQ( id1, id2 );
+  EXPECT_NE( id1, id3 );
+  EXPECT_EQ( 2, mgr.func_num() );
+  auto& func = mgr.func(id1);
+  EXPECT_TRUE( func.is_cover() );
+  EXPECT_EQ( cover, func.input_cover() );
+  EXPECT_FALSE( func.output_inv() );
+}
+
+TEST(FuncMgr_test, stream_cover)
+{
+  FuncMgr mgr;
+  mgr.begin_cover(3);
+  EXPECT_TRUE( mgr.add_cube("1-0") );
+  EXPECT_TRUE( mgr.add_cube("-11") );
+  auto id1 = mgr.end_cover(false);
+
+  EXPECT_EQ( 1, mgr.func_num() );
+  auto& func = mgr.func(id1);
+  ASSERT_TRUE( func.is_cover() );
+  EXPECT_FALSE( func.output_inv() );
+  auto& cover = func.input_cover();
+  auto exp_cover = SopCover(3, {{Literal(0, false), Literal(2, true)},
+				{Literal(1, false), Literal(2, false)}});
+  EXPECT_EQ( exp_cover, cover );
+
+  // 同じ並びのキューブは同じ関数となる．
+  mgr.begin_cover(3);
+  EXPECT_TRUE( mgr.add_cube("1-0") );
+  EXPECT_TRUE( mgr.add_cube("-11") );
+  auto id2 = mgr.end_cover(false);
+  EXPECT_EQ( id1, id2 );
+
+  // reg_cover() で登録したものとも同じ関数とみなす．
+  auto id3 = mgr.reg_cover(cover, false);
+  EXPECT_EQ( id1, id3 );
+  EXPECT_EQ( 1, mgr.func_num() );
+}
+
+TEST(FuncMgr_test, stream_cover_same_as_reg_cover)
+{
+  // キューブの順番が異なるものと重複したキューブを含むもの
+  std::vector<std::vector<std::string>> pats_list{
+    {"1-0", "-11"},
+    {"-11", "1-0"},
+    {"1-0", "1-0", "-11"},
+    {"1-0", "-11", "1-0"},
+    {"1-0", "-11"},
+    {"-11", "1-0", "-11"},
+    {"-11", "1-0"},
+    {"1-0", "1-0", "-11"}
+  };
+
+  // end_cover() で登録した結果は SopCover を作って reg_cover() で
+  // 登録した結果と同じになる．
+  FuncMgr mgr1;
+  FuncMgr mgr2;
+  for ( auto& pats: pats_list ) {
+    mgr1.begin_cover(3);
+    std::vector<std::vector<Literal>> cube_list;
+    for ( auto& pat: pats ) {
+      EXPECT_TRUE( mgr1.add_cube(pat) );
+      std::vector<Literal> lit_list;
+      for ( SizeType i = 0; i < 3; ++ i ) {
+	if ( pat[i] == '1' ) {
+	  lit_list.push_back(Literal(i, false));
+	}
+	else if ( pat[i] == '0' ) {
+	  lit_list.push_back(Literal(i, true));
+	}
+      }
+      cube_list.push_back(lit_list);
+    }
+    auto id1 = mgr1.end_cover(false);
+    auto id2 = mgr2.reg_cover(SopCover{3, cube_list}, false);
+    EXPECT_EQ( id2, id1 );
+  }
+  EXPECT_EQ( mgr2.func_num(), mgr1.func_num() );
+}
+
+TEST(FuncMgr_test, stream_cover_bad)
+{
+  FuncMgr mgr;
+  mgr.begin_cover(2);
+  EXPECT_TRUE( mgr.add_cube("10") );
+  EXPECT_FALSE( mgr.add_cube("1x") );
+  EXPECT_FALSE( mgr.add_cube("101") );
+  auto id = mgr.end_cover(true);
+
+  auto& func = mgr.func(id);
+  EXPECT_TRUE( func.output_inv() );
+  EXPECT_EQ( 1, func.input_cover().cube_num() );
+}
+
+TEST(FuncMgr_test, stream_cover_const)
+{
+  FuncMgr mgr;
+  mgr.begin_cover(0);
+  auto id0 = mgr.end_cover(false);
+  mgr.begin_cover(0);
+  EXPECT_TRUE( mgr.add_cube({}) );
+  auto id1 = mgr.end_cover(false);
+
+  EXPECT_NE( id0, id1 );
+  EXPECT_EQ( 0, mgr.func(id0).input_cover().cube_num() );
+  EXPECT_EQ( 1, mgr.func(id1).input_cover().cube_num() );
+}
+
+TEST(FuncMgr_test, copy)
+{
+  FuncMgr mgr;
+  auto id0 = mgr.reg_primitive(2, PrimType::And);
+  mgr.begin_cover(2);
+  mgr.add_cube("11");
+  auto id1 = mgr.end_cover(false);
+
+  FuncMgr mgr2{mgr};
+  EXPECT_EQ( 2, mgr2.func_num() );
+  EXPECT_EQ( id0, mgr2.reg_primitive(2, PrimType::And) );
+  mgr2.begin_cover(2);
+  mgr2.add_cube("11");
+  EXPECT_EQ( id1, mgr2.end_cover(false) );
+  EXPECT_EQ( 2, mgr2.func_num() );
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,152 @@
+
+/// @file BnHierModel.cc
+/// @brief BnHierModel の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnHierModel.h"
+#include "HierImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// インスタンスを取り出す．
+const HierInst&
+get_inst(
+  const HierImpl& impl,
+  SizeType module_id,
+  SizeType inst_pos
+)
+{
+  auto& inst_list = impl.module(module_id).inst_list;
+  if ( inst_pos >= inst_list.size() ) {
+    throw std::out_of_range{"inst_pos is out of range"};
+  }
+  return inst_list[inst_pos];
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnHierModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+BnHierModel::BnHierModel(
+) : mImpl{new HierImpl}
+{
+}
+
+// @brief デストラクタ
+BnHierModel::~BnHierModel()
+{
+}
+
+// @brief モジュール数を返す．
+SizeType
+BnHierModel::module_num() const
+{
+  return mImpl->module_num();
+}
+
+// @brief モジュール名を返す．
+const std::string&
+BnHierModel::module_name(
+  SizeType module_id
+) const
+{
+  return mImpl->module(module_id).name;
+}
+
+// @brief 名前からモジュール番号を探す．
+SizeType
+BnHierModel::find_module(
+  const std::string& name
+) const
+{
+  return mImpl->find_module(name);
+}
+
+// @brief モジュールの本体を返す．
+BnModel
+BnHierModel::module_body(
+  SizeType module_id
+) const
+{
+  return BnModel{mImpl->module(module_id).body->copy()};
+}
+
+// @brief 入力ポート数を返す．
+SizeType
+BnHierModel::port_input_num(
+  SizeType module_id
+) const
+{
+  return mImpl->module(module_id).port_input_num;
+}
+
+// @brief 出力ポート数を返す．
+SizeType
+BnHierModel::port_output_num(
+  SizeType module_id
+) const
+{
+  return mImpl->module(module_id).port_output_num;
+}
+
+// @brief インスタンス数を返す．
+SizeType
+BnHierModel::instance_num(
+  SizeType module_id
+) const
+{
+  return mImpl->module(module_id).inst_list.size();
+}
+
+// @brief インスタンスのモジュール番号を返す．
+SizeType
+BnHierModel::instance_module(
+  SizeType module_id,
+  SizeType inst_pos
+) const
+{
+  return get_inst(*mImpl, module_id, inst_pos).module_id;
+}
+
+// @brief インスタンスの入力ポートにつながるノード番号のリストを返す．
+const std::vector<SizeType>&
+BnHierModel::instance_input_list(
+  SizeType module_id,
+  SizeType inst_pos
+) const
+{
+  return get_inst(*mImpl, module_id, inst_pos).input_list;
+}
+
+// @brief インスタンスの出力ポートにつながるノード番号のリストを返す．
+const std::vector<SizeType>&
+BnHierModel::instance_output_list(
+  SizeType module_id,
+  SizeType inst_pos
+) const
+{
+  return get_inst(*mImpl, module_id, inst_pos).output_list;
+}
+
+// @brief 平坦化した BnModel を返す．
+BnModel
+BnHierModel::flatten(
+  SizeType module_id
+) const
+{
+  BnModel model;
+  mImpl->flatten(module_id, model._model_impl());
+  return model;
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,432 @@
+
+/// @file HierImpl.cc
+/// @brief HierImpl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "HierImpl.h"
+#include "FuncImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 関数を別の ModelImpl に登録する．
+SizeType
+copy_func(
+  ModelImpl& dst,
+  const FuncImpl& func
+)
+{
+  if ( func.is_primitive() ) {
+    return dst.reg_primitive(func.input_num(), func.primitive_type());
+  }
+  if ( func.is_cover() ) {
+    return dst.reg_cover(func.input_cover(), func.output_inv());
+  }
+  if ( func.is_expr() ) {
+    return dst.reg_expr(func.expr());
+  }
+  if ( func.is_tvfunc() ) {
+    return dst.reg_tvfunc(func.tvfunc());
+  }
+  if ( func.is_bdd() ) {
+    return dst.reg_bdd(func.bdd());
+  }
+  throw std::logic_error{"HierImpl: unknown function type"};
+}
+
+// 関数番号の変換表
+//
+// 必要になった関数のみを登録する．
+class FuncMap
+{
+public:
+
+  // コンストラクタ
+  FuncMap(
+    const ModelImpl& src,
+    ModelImpl& dst
+  ) : mSrc{src},
+      mDst{dst},
+      mMap(src.func_num(), BAD_ID)
+  {
+  }
+
+  // src の関数番号を dst の関数番号に変換する．
+  SizeType
+  operator()(
+    SizeType func_id
+  )
+  {
+    auto& ans = mMap[func_id];
+    if ( ans == BAD_ID ) {
+      ans = copy_func(mDst, mSrc.func_impl(func_id));
+    }
+    return ans;
+  }
+
+private:
+
+  // 変換元
+  const ModelImpl& mSrc;
+
+  // 変換先
+  ModelImpl& mDst;
+
+  // 変換表
+  std::vector<SizeType> mMap;
+
+};
+
+// 平坦化を行うクラス
+class Flattener
+{
+public:
+
+  // コンストラクタ
+  Flattener(
+    const HierImpl& hier
+  ) : mHier{hier},
+      mTemplateList(hier.module_num()),
+      mBusy(hier.module_num(), false)
+  {
+  }
+
+  // module_id のモジュールを平坦化して dst に作る．
+  //
+  // keep_names が true の時はノード名を複製する．
+  void
+  build(
+    SizeType module_id,
+    ModelImpl& dst,
+    bool keep_names
+  );
+
+
+private:
+
+  // 平坦化済みのテンプレートを返す．
+  //
+  // テンプレートはモジュールごとに1度だけ作る．
+  const ModelImpl&
+  get_template(
+    SizeType module_id
+  );
+
+  // テンプレートを dst に複製する．
+  //
+  // テンプレートの入力は input_list のノードに，出力は可能な限り
+  // output_list のノードに対応させ，残りのノードには dst の末尾から
+  // 連続した番号を割り当てる．
+  void
+  expand(
+    const ModelImpl& tmpl,
+    ModelImpl& dst,
+    const std::vector<SizeType>& input_list,
+    const std::vector<SizeType>& output_list,
+    FuncMap& func_map
+  );
+
+  // 対象の階層構造
+  const HierImpl& mHier;
+
+  // モジュール番号をキーにしてテンプレートを格納する配列
+  std::vector<std::unique_ptr<ModelImpl>> mTemplateList;
+
+  // 平坦化中のモジュールに印をつける配列
+  std::vector<bool> mBusy;
+
+};
+
+// @brief module_id のモジュールを平坦化して dst に作る．
+void
+Flattener::build(
+  SizeType module_id,
+  ModelImpl& dst,
+  bool keep_names
+)
+{
+  if ( mBusy[module_id] ) {
+    throw std::logic_error{"HierImpl: recursive instantiation"};
+  }
+  mBusy[module_id] = true;
+
+  auto& module = mHier.module(module_id);
+  auto& body = *module.body;
+
+  // 本体のノードは番号をずらすだけで複製する．
+  auto base = dst.node_num();
+  auto n = body.node_num();
+  dst.reserve(base + n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    dst.alloc_node();
+  }
+
+  for ( SizeType i = 0; i < module.port_input_num; ++ i ) {
+    auto id = body.input_id(i);
+    if ( keep_names ) {
+      dst.set_input(base + id, body.input_name(i));
+    }
+    else {
+      dst.set_input(base + id);
+    }
+  }
+
+  auto nd = body.dff_num();
+  std::vector<SizeType> dff_list(nd);
+  for ( SizeType i = 0; i < nd; ++ i ) {
+    auto& dff = body.dff_impl(i);
+    auto dff_id = dst.new_dff(keep_names ? dff.name : std::string{},
+			      dff.reset_val);
+    dst.set_dff_output(base + dff.id, dff_id);
+    dff_list[i] = dff_id;
+  }
+
+  FuncMap func_map{body, dst};
+  for ( auto id: body.logic_id_list() ) {
+    auto& node = body.node_impl(id);
+    std::vector<BnIdType> fanin_list;
+    fanin_list.reserve(node.fanin_num());
+    for ( auto iid: node.fanin_id_list() ) {
+      fanin_list.push_back(base + iid);
+    }
+    dst.set_logic(base + id, func_map(node.func_id()), std::move(fanin_list));
+    if ( keep_names ) {
+      auto name = body.get_node_name(id);
+      if ( !name.empty() ) {
+	dst.set_node_name(base + id, name);
+      }
+    }
+  }
+
+  // インスタンスを展開する．
+  // 変換表はモジュールごとに共有する．
+  std::unordered_map<SizeType, FuncMap> func_map_dict;
+  std::vector<SizeType> input_list;
+  std::vector<SizeType> output_list;
+  for ( auto& inst: module.inst_list ) {
+    auto& tmpl = get_template(inst.module_id);
+    input_list.clear();
+    for ( auto id: inst.input_list ) {
+      input_list.push_back(base + id);
+    }
+    output_list.clear();
+    for ( auto id: inst.output_list ) {
+      output_list.push_back(base + id);
+    }
+    auto p = func_map_dict.find(inst.module_id);
+    if ( p == func_map_dict.end() ) {
+      p = func_map_dict.emplace(inst.module_id, FuncMap{tmpl, dst}).first;
+    }
+    expand(tmpl, dst, input_list, output_list, p->second);
+  }
+
+  if ( keep_names ) {
+    // インスタンスの出力につながるノードの名前を複製する．
+    for ( SizeType i = module.port_input_num; i < body.input_num(); ++ i ) {
+      auto name = body.input_name(i);
+      if ( !name.empty() ) {
+	dst.set_node_name(base + body.input_id(i), name);
+      }
+    }
+  }
+
+  for ( SizeType i = 0; i < module.port_output_num; ++ i ) {
+    auto id = body.output_id(i);
+    if ( keep_names ) {
+      dst.new_output(base + id, body.output_name(i));
+    }
+    else {
+      dst.new_output(base + id);
+    }
+  }
+
+  for ( SizeType i = 0; i < nd; ++ i ) {
+    dst.set_dff_src(dff_list[i], base + body.dff_impl(i).src_id);
+  }
+
+  dst.make_logic_list();
+
+  mBusy[module_id] = false;
+}
+
+// @brief 平坦化済みのテンプレートを返す．
+const ModelImpl&
+Flattener::get_template(
+  SizeType module_id
+)
+{
+  auto& tmpl = mTemplateList[module_id];
+  if ( tmpl.get() == nullptr ) {
+    auto model = std::unique_ptr<ModelImpl>{new ModelImpl};
+    build(module_id, *model, false);
+    tmpl = std::move(model);
+  }
+  return *tmpl;
+}
+
+// @brief テンプレートを dst に複製する．
+void
+Flattener::expand(
+  const ModelImpl& tmpl,
+  ModelImpl& dst,
+  const std::vector<SizeType>& input_list,
+  const std::vector<SizeType>& output_list,
+  FuncMap& func_map
+)
+{
+  auto n = tmpl.node_num();
+  std::vector<SizeType> id_map(n, BAD_ID);
+  auto ni = tmpl.input_num();
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    id_map[tmpl.input_id(i)] = input_list[i];
+  }
+
+  // 出力ポートのソースは上位のノードをそのまま用いる．
+  // 入力ポートや他の出力ポートと共有されている場合はバッファを挿入する．
+  auto no = tmpl.output_num();
+  std::vector<bool> need_buff(no, false);
+  for ( SizeType i = 0; i < no; ++ i ) {
+    auto src = tmpl.output_id(i);
+    if ( id_map[src] == BAD_ID ) {
+      id_map[src] = output_list[i];
+    }
+    else {
+      need_buff[i] = true;
+    }
+  }
+
+  // 残りのノードに連続した番号を割り当てる．
+  auto base = dst.node_num();
+  SizeType count = 0;
+  auto nd = tmpl.dff_num();
+  for ( SizeType i = 0; i < nd; ++ i ) {
+    auto id = tmpl.dff_impl(i).id;
+    if ( id_map[id] == BAD_ID ) {
+      id_map[id] = base + count;
+      ++ count;
+    }
+  }
+  for ( auto id: tmpl.logic_id_list() ) {
+    if ( id_map[id] == BAD_ID ) {
+      id_map[id] = base + count;
+      ++ count;
+    }
+  }
+  dst.reserve(base + count);
+  for ( SizeType i = 0; i < count; ++ i ) {
+    dst.alloc_node();
+  }
+
+  std::vector<SizeType> dff_list(nd);
+  for ( SizeType i = 0; i < nd; ++ i ) {
+    auto& dff = tmpl.dff_impl(i);
+    auto dff_id = dst.new_dff({}, dff.reset_val);
+    dst.set_dff_output(id_map[dff.id], dff_id);
+    dff_list[i] = dff_id;
+  }
+
+  for ( auto id: tmpl.logic_id_list() ) {
+    auto& node = tmpl.node_impl(id);
+    std::vector<BnIdType> fanin_list;
+    fanin_list.reserve(node.fanin_num());
+    for ( auto iid: node.fanin_id_list() ) {
+      fanin_list.push_back(id_map[iid]);
+    }
+    dst.set_logic(id_map[id], func_map(node.func_id()), std::move(fanin_list));
+  }
+
+  for ( SizeType i = 0; i < no; ++ i ) {
+    if ( need_buff[i] ) {
+      auto src = id_map[tmpl.output_id(i)];
+      auto func_id = dst.reg_primitive(1, PrimType::Buff);
+      dst.set_logic(output_list[i], func_id,
+		    std::vector<BnIdType>{static_cast<BnIdType>(src)});
+    }
+  }
+
+  for ( SizeType i = 0; i < nd; ++ i ) {
+    dst.set_dff_src(dff_list[i], id_map[tmpl.dff_impl(i).src_id]);
+  }
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス HierImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief モジュールを追加する．
+SizeType
+HierImpl::new_module(
+  const std::string& name,
+  std::unique_ptr<ModelImpl>&& body
+)
+{
+  if ( mModuleDict.count(name) > 0 ) {
+    return BAD_ID;
+  }
+  auto module_id = mModuleList.size();
+  mModuleList.push_back(HierModule{name, std::move(body), 0, 0, {}});
+  mModuleDict.emplace(name, module_id);
+  return module_id;
+}
+
+// @brief インスタンスの循環がないか調べる．
+SizeType
+HierImpl::find_cycle() const
+{
+  // 0: 未訪問, 1: 訪問中, 2: 訪問済み
+  auto n = module_num();
+  std::vector<int> state(n, 0);
+  std::vector<std::pair<SizeType, SizeType>> stack;
+  for ( SizeType root = 0; root < n; ++ root ) {
+    if ( state[root] != 0 ) {
+      continue;
+    }
+    state[root] = 1;
+    stack.push_back({root, 0});
+    while ( !stack.empty() ) {
+      auto& top = stack.back();
+      auto& inst_list = mModuleList[top.first].inst_list;
+      if ( top.second == inst_list.size() ) {
+	state[top.first] = 2;
+	stack.pop_back();
+	continue;
+      }
+      auto sub_id = inst_list[top.second].module_id;
+      ++ top.second;
+      if ( state[sub_id] == 1 ) {
+	return sub_id;
+      }
+      if ( state[sub_id] == 0 ) {
+	state[sub_id] = 1;
+	stack.push_back({sub_id, 0});
+      }
+    }
+  }
+  return BAD_ID;
+}
+
+// @brief 平坦化した結果を dst に作る．
+void
+HierImpl::flatten(
+  SizeType module_id,
+  ModelImpl& dst
+) const
+{
+  _check_module_id(module_id);
+  if ( dst.node_num() > 0 ) {
+    throw std::logic_error{"HierImpl::flatten(): dst should be empty"};
+  }
+  Flattener flattener{*this};
+  flattener.build(module_id, dst, true);
+  dst.set_name(module(module_id).name);
+}
+
+END_NAMESPACE_YM_BN
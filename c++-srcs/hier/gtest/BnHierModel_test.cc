@@ -0,0 +1,356 @@
+
+/// @file BnHierModel_test.cc
+/// @brief BnHierModel_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnHierModel.h"
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 全加算器を2段つないだ階層構造を持つ blif
+const char* ADDER_BLIF =
+  ".model top\n"
+  ".inputs a b c\n"
+  ".outputs o1 o2 o3\n"
+  ".subckt fa x=a y=b ci=c s=s1 co=c1\n"
+  ".subckt fa x=s1 y=c ci=c1 s=o1 co=o2\n"
+  ".subckt reg d=a q=o3\n"
+  ".end\n"
+  "\n"
+  ".model fa\n"
+  ".inputs x y ci\n"
+  ".outputs s co\n"
+  ".subckt xor2 i0=x i1=y o=t\n"
+  ".subckt xor2 i0=t i1=ci o=s\n"
+  ".names x y ci co\n"
+  "11- 1\n"
+  "1-1 1\n"
+  "-11 1\n"
+  ".end\n"
+  "\n"
+  ".model xor2\n"
+  ".inputs i0 i1\n"
+  ".outputs o\n"
+  ".names i0 i1 o\n"
+  "10 1\n"
+  "01 1\n"
+  ".end\n"
+  "\n"
+  ".model reg\n"
+  ".inputs d\n"
+  ".outputs q\n"
+  ".latch d q 0\n"
+  ".end\n";
+
+bool
+maj(
+  bool a,
+  bool b,
+  bool c
+)
+{
+  return (a && b) || (a && c) || (b && c);
+}
+
+END_NONAMESPACE
+
+TEST( BnHierModelTest, read_blif )
+{
+  auto path = make_file("adder.blif", ADDER_BLIF);
+  auto hier = BnHierModel::read_blif(path);
+  ASSERT_EQ( 4, hier.module_num() );
+  EXPECT_EQ( "top", hier.module_name(0) );
+  auto fa_id = hier.find_module("fa");
+  auto xor_id = hier.find_module("xor2");
+  auto reg_id = hier.find_module("reg");
+  EXPECT_EQ( 1, fa_id );
+  EXPECT_EQ( 2, xor_id );
+  EXPECT_EQ( 3, reg_id );
+  EXPECT_EQ( BAD_ID, hier.find_module("foo") );
+
+  EXPECT_EQ( 3, hier.port_input_num(0) );
+  EXPECT_EQ( 3, hier.port_output_num(0) );
+  ASSERT_EQ( 3, hier.instance_num(0) );
+  EXPECT_EQ( fa_id, hier.instance_module(0, 0) );
+  EXPECT_EQ( fa_id, hier.instance_module(0, 1) );
+  EXPECT_EQ( reg_id, hier.instance_module(0, 2) );
+  EXPECT_EQ( 3, hier.instance_input_list(0, 0).size() );
+  EXPECT_EQ( 2, hier.instance_output_list(0, 0).size() );
+  EXPECT_EQ( 3, hier.port_input_num(fa_id) );
+  EXPECT_EQ( 2, hier.port_output_num(fa_id) );
+  EXPECT_EQ( 2, hier.instance_num(fa_id) );
+  EXPECT_EQ( 0, hier.instance_num(xor_id) );
+  EXPECT_THROW( hier.instance_module(0, 3), std::out_of_range );
+  EXPECT_THROW( hier.module_name(4), std::out_of_range );
+
+  // 本体はインスタンスの部分で切り離されている．
+  auto body = hier.module_body(0);
+  EXPECT_EQ( 3 + 2 + 2 + 1, body.input_num() );
+  EXPECT_EQ( 3 + 3 + 3 + 1, body.output_num() );
+  EXPECT_EQ( 0, body.dff_num() );
+  EXPECT_EQ( "s1", body.input_name(3) );
+
+  auto fa = hier.flatten(fa_id);
+  ASSERT_EQ( 3, fa.input_num() );
+  ASSERT_EQ( 2, fa.output_num() );
+  std::vector<bool> ivals(3);
+  for ( SizeType p = 0; p < 8; ++ p ) {
+    for ( SizeType i = 0; i < 3; ++ i ) {
+      ivals[i] = (p >> i) & 1;
+    }
+    bool x = ivals[0];
+    bool y = ivals[1];
+    bool ci = ivals[2];
+    EXPECT_EQ( (std::vector<bool>{(x != y) != ci, maj(x, y, ci)}),
+	       simulate(fa, ivals) );
+  }
+}
+
+TEST( BnHierModelTest, flatten )
+{
+  auto path = make_file("adder.blif", ADDER_BLIF);
+  auto model = BnModel::read_blif(path);
+  EXPECT_EQ( "top", model.name() );
+  ASSERT_EQ( 3, model.input_num() );
+  ASSERT_EQ( 3, model.output_num() );
+  ASSERT_EQ( 1, model.dff_num() );
+  EXPECT_EQ( "a", model.input_name(0) );
+  EXPECT_EQ( "b", model.input_name(1) );
+  EXPECT_EQ( "c", model.input_name(2) );
+  EXPECT_EQ( "o1", model.output_name(0) );
+  EXPECT_EQ( "o2", model.output_name(1) );
+  EXPECT_EQ( "o3", model.output_name(2) );
+  // xor2 が4個と fa の多数決関数が2個
+  EXPECT_EQ( 6, model.logic_num() );
+
+  std::vector<bool> ivals(4);
+  for ( SizeType p = 0; p < 16; ++ p ) {
+    for ( SizeType i = 0; i < 4; ++ i ) {
+      ivals[i] = (p >> i) & 1;
+    }
+    bool a = ivals[0];
+    bool b = ivals[1];
+    bool c = ivals[2];
+    bool q = ivals[3];
+    bool s1 = (a != b) != c;
+    bool c1 = maj(a, b, c);
+    bool o1 = (s1 != c) != c1;
+    bool o2 = maj(s1, c, c1);
+    EXPECT_EQ( (std::vector<bool>{o1, o2, q, a}), simulate(model, ivals) )
+      << "p = " << p;
+  }
+
+  auto hier = BnHierModel::read_blif(path);
+  auto model2 = hier.flatten();
+  EXPECT_EQ( model.node_num(), model2.node_num() );
+  EXPECT_EQ( model.logic_num(), model2.logic_num() );
+}
+
+TEST( BnHierModelTest, many_instances )
+{
+  // 同じモジュールのインスタンスを多数並べる．
+  const SizeType n = 100;
+  std::ostringstream buf;
+  buf << ".model chain\n"
+      << ".inputs a b\n"
+      << ".outputs o\n";
+  for ( SizeType i = 0; i < n; ++ i ) {
+    buf << ".subckt xor2 i0=" << (i == 0 ? "a" : "w" + std::to_string(i))
+	<< " i1=b o=" << (i == n - 1 ? "o" : "w" + std::to_string(i + 1))
+	<< "\n";
+  }
+  buf << ".end\n"
+      << ".model xor2\n"
+      << ".inputs i0 i1\n"
+      << ".outputs o\n"
+      << ".names i0 i1 o\n"
+      << "10 1\n"
+      << "01 1\n"
+      << ".end\n";
+  auto path = make_file("chain.blif", buf.str());
+  auto model = BnModel::read_blif(path);
+  ASSERT_EQ( 2, model.input_num() );
+  ASSERT_EQ( 1, model.output_num() );
+  EXPECT_EQ( n, model.logic_num() );
+  EXPECT_EQ( 1, model.func_num() );
+  for ( SizeType p = 0; p < 4; ++ p ) {
+    bool a = p & 1;
+    bool b = (p >> 1) & 1;
+    // b を偶数回 XOR するので a に戻る．
+    EXPECT_EQ( (std::vector<bool>{a}), simulate(model, {a, b}) );
+  }
+}
+
+TEST( BnHierModelTest, passthrough )
+{
+  // 入力をそのまま出力するモジュール
+  auto path = make_file("pass.blif",
+			".model top\n"
+			".inputs a\n"
+			".outputs o1 o2\n"
+			".subckt pass i=a o1=o1 o2=o2\n"
+			".end\n"
+			".model pass\n"
+			".inputs i\n"
+			".outputs o1 o2\n"
+			".names i o1\n"
+			"1 1\n"
+			".names i o2\n"
+			"0 1\n"
+			".end\n");
+  auto model = BnModel::read_blif(path);
+  for ( bool a: {false, true} ) {
+    EXPECT_EQ( (std::vector<bool>{a, !a}), simulate(model, {a}) );
+  }
+}
+
+TEST( BnHierModelTest, unconnected_output )
+{
+  auto path = make_file("unconn.blif",
+			".model top\n"
+			".inputs a b\n"
+			".outputs o\n"
+			".subckt fa2 x=a y=b s=o\n"
+			".end\n"
+			".model fa2\n"
+			".inputs x y\n"
+			".outputs s co\n"
+			".names x y s\n"
+			"10 1\n"
+			"01 1\n"
+			".names x y co\n"
+			"11 1\n"
+			".end\n");
+  auto model = BnModel::read_blif(path);
+  ASSERT_EQ( 1, model.output_num() );
+  for ( SizeType p = 0; p < 4; ++ p ) {
+    bool a = p & 1;
+    bool b = (p >> 1) & 1;
+    EXPECT_EQ( (std::vector<bool>{a != b}), simulate(model, {a, b}) );
+  }
+}
+
+TEST( BnHierModelTest, undefined_model )
+{
+  auto path = make_file("undef_model.blif",
+			".model top\n"
+			".inputs a\n"
+			".outputs o\n"
+			".subckt foo i=a o=o\n"
+			".end\n");
+  EXPECT_THROW( BnModel::read_blif(path), std::invalid_argument );
+  EXPECT_THROW( BnHierModel::read_blif(path), std::invalid_argument );
+}
+
+TEST( BnHierModelTest, bad_port )
+{
+  auto path = make_file("bad_port.blif",
+			".model top\n"
+			".inputs a\n"
+			".outputs o\n"
+			".subckt inv x=a o=o\n"
+			".end\n"
+			".model inv\n"
+			".inputs i\n"
+			".outputs o\n"
+			".names i o\n"
+			"0 1\n"
+			".end\n");
+  EXPECT_THROW( BnModel::read_blif(path), std::invalid_argument );
+}
+
+TEST( BnHierModelTest, unconnected_input )
+{
+  auto path = make_file("unconn_input.blif",
+			".model top\n"
+			".inputs a\n"
+			".outputs o\n"
+			".subckt and2 i0=a o=o\n"
+			".end\n"
+			".model and2\n"
+			".inputs i0 i1\n"
+			".outputs o\n"
+			".names i0 i1 o\n"
+			"11 1\n"
+			".end\n");
+  EXPECT_THROW( BnModel::read_blif(path), std::invalid_argument );
+}
+
+TEST( BnHierModelTest, multi_def )
+{
+  auto path = make_file("multi_def.blif",
+			".model top\n"
+			".inputs a\n"
+			".outputs o\n"
+			".subckt inv i=a o=o\n"
+			".names a o\n"
+			"1 1\n"
+			".end\n"
+			".model inv\n"
+			".inputs i\n"
+			".outputs o\n"
+			".names i o\n"
+			"0 1\n"
+			".end\n");
+  EXPECT_THROW( BnModel::read_blif(path), std::invalid_argument );
+}
+
+TEST( BnHierModelTest, duplicated_model )
+{
+  auto path = make_file("dup_model.blif",
+			".model top\n"
+			".inputs a\n"
+			".outputs o\n"
+			".names a o\n"
+			"1 1\n"
+			".end\n"
+			".model top\n"
+			".inputs a\n"
+			".outputs o\n"
+			".names a o\n"
+			"0 1\n"
+			".end\n");
+  EXPECT_THROW( BnModel::read_blif(path), std::invalid_argument );
+}
+
+TEST( BnHierModelTest, recursive )
+{
+  auto path = make_file("recursive.blif",
+			".model top\n"
+			".inputs a\n"
+			".outputs o\n"
+			".subckt sub i=a o=o\n"
+			".end\n"
+			".model sub\n"
+			".inputs i\n"
+			".outputs o\n"
+			".subckt sub i=i o=o\n"
+			".end\n");
+  EXPECT_THROW( BnModel::read_blif(path), std::invalid_argument );
+  EXPECT_THROW( BnHierModel::read_blif(path), std::invalid_argument );
+}
+
+TEST( BnHierModelTest, flat_file )
+{
+  // 階層構造を持たないファイルも読み込める．
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  auto hier = BnHierModel::read_blif(path);
+  ASSERT_EQ( 1, hier.module_num() );
+  EXPECT_EQ( 0, hier.instance_num(0) );
+  auto model = BnModel::read_blif(path);
+  auto model2 = hier.flatten();
+  EXPECT_EQ( model.input_num(), model2.input_num() );
+  EXPECT_EQ( model.output_num(), model2.output_num() );
+  EXPECT_EQ( model.dff_num(), model2.dff_num() );
+  EXPECT_EQ( model.logic_num(), model2.logic_num() );
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,94 @@
+
+/// @file BnProgressScope.cc
+/// @brief BnProgressScope の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnProgress.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 現在のスレッドで有効なオブジェクト
+thread_local BnProgressScope* cur_scope = nullptr;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnProgressScope
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BnProgressScope::BnProgressScope(
+  const Callback& callback,
+  const BnCancelToken& token,
+  double interval
+) : mCallback{callback},
+    mToken{token},
+    mInterval{std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<double>(interval))},
+    mLastTime{std::chrono::steady_clock::now()},
+    mOuter{cur_scope}
+{
+  cur_scope = this;
+}
+
+// @brief デストラクタ
+BnProgressScope::~BnProgressScope()
+{
+  cur_scope = mOuter;
+}
+
+// @brief 現在のスレッドで有効なオブジェクトを返す．
+BnProgressScope*
+BnProgressScope::current()
+{
+  return cur_scope;
+}
+
+// @brief 進捗を通知する．
+void
+BnProgressScope::report(
+  const BnProgress& progress,
+  bool final
+)
+{
+  if ( mToken.is_canceled() ) {
+    std::ostringstream buf;
+    buf << "canceled during '" << progress.phase << "'.";
+    throw BnCanceled{buf.str()};
+  }
+  if ( !mCallback ) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock{mMutex};
+  auto now = std::chrono::steady_clock::now();
+  if ( final || now - mLastTime >= mInterval ) {
+    mLastTime = now;
+    try {
+      mCallback(progress);
+    }
+    catch ( ... ) {
+      mCallbackFailed.store(true, std::memory_order_relaxed);
+      throw;
+    }
+  }
+}
+
+// @brief 現在のスレッドで有効なオブジェクトを設定する．
+BnProgressScope*
+BnProgressScope::_set_current(
+  BnProgressScope* scope
+)
+{
+  auto old_scope = cur_scope;
+  cur_scope = scope;
+  return old_scope;
+}
+
+END_NAMESPACE_YM_BN
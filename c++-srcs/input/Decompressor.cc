@@ -0,0 +1,559 @@
+
+/// @file Decompressor.cc
+/// @brief Decompressor の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Decompressor.h"
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#if defined(YM_BN_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(YM_BN_HAS_LZMA)
+#include <lzma.h>
+#endif
+
+#if defined(YM_BN_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 1度に読み出す圧縮データのサイズ
+const SizeType BLOCK_SIZE = 1024 * 1024;
+
+// 1度に確保する展開結果の領域の最小サイズ
+const SizeType OUT_CHUNK = 256 * 1024;
+
+// std::string の末尾に追加する Output
+class StringOutput :
+  public Decompressor::Output
+{
+public:
+
+  // コンストラクタ
+  explicit
+  StringOutput(
+    std::string& str
+  ) : mStr{str},
+      mSize{str.size()}
+  {
+  }
+
+  // 書き込み用の領域を確保する．
+  char*
+  reserve(
+    SizeType& avail
+  ) override
+  {
+    avail = std::max(OUT_CHUNK, mSize / 2);
+    mStr.resize(mSize + avail);
+    return mStr.data() + mSize;
+  }
+
+  // reserve() で確保した領域の先頭から size バイトを確定する．
+  void
+  commit(
+    SizeType size
+  ) override
+  {
+    mSize += size;
+    mStr.resize(mSize);
+  }
+
+  // 確定したサイズの合計を返す．
+  SizeType
+  size() const override
+  {
+    return mSize;
+  }
+
+
+private:
+
+  // 追加先の文字列
+  std::string& mStr;
+
+  // 確定したサイズ
+  SizeType mSize;
+
+};
+
+// 展開器の基底クラス
+class Decoder
+{
+public:
+
+  // デストラクタ
+  virtual
+  ~Decoder() = default;
+
+  // 圧縮データを展開して out に書き込む．
+  //
+  // last は最後のデータの時 true となる．
+  // 内容が壊れていたら false を返す．
+  virtual
+  bool
+  decode(
+    const char* in,
+    SizeType in_size,
+    bool last,
+    Decompressor::Output& out
+  ) = 0;
+
+};
+
+#if defined(YM_BN_HAS_ZLIB)
+
+// gzip 形式の展開器
+//
+// 複数のメンバを連結したファイルにも対応する．
+class GzipDecoder :
+  public Decoder
+{
+public:
+
+  // コンストラクタ
+  GzipDecoder()
+  {
+    std::memset(&mStream, 0, sizeof(mStream));
+    // 32 を加えると gzip のヘッダを自動で判別する．
+    mOk = inflateInit2(&mStream, 15 + 32) == Z_OK;
+  }
+
+  // デストラクタ
+  ~GzipDecoder()
+  {
+    inflateEnd(&mStream);
+  }
+
+  // 圧縮データを展開して out に書き込む．
+  bool
+  decode(
+    const char* in,
+    SizeType in_size,
+    bool last,
+    Decompressor::Output& out
+  ) override
+  {
+    if ( !mOk ) {
+      return false;
+    }
+    mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+    mStream.avail_in = in_size;
+    // 出力の領域を使い切った場合は zlib 内部に残りがある可能性がある．
+    mStream.avail_out = 1;
+    while ( mStream.avail_in > 0 || mStream.avail_out == 0 ) {
+      SizeType avail;
+      auto dst = out.reserve(avail);
+      mStream.next_out = reinterpret_cast<Bytef*>(dst);
+      mStream.avail_out = avail;
+      auto ret = inflate(&mStream, Z_NO_FLUSH);
+      out.commit(avail - mStream.avail_out);
+      if ( ret == Z_STREAM_END ) {
+	// 次のメンバに備える．
+	mEnd = true;
+	inflateReset(&mStream);
+	mStream.avail_out = 1;
+	continue;
+      }
+      if ( ret != Z_OK && ret != Z_BUF_ERROR ) {
+	return false;
+      }
+      mEnd = false;
+    }
+    if ( last ) {
+      return mEnd;
+    }
+    return true;
+  }
+
+
+private:
+
+  // zlib のストリーム
+  z_stream mStream;
+
+  // 初期化に成功した時 true
+  bool mOk;
+
+  // メンバの末尾に達している時 true
+  bool mEnd{false};
+
+};
+
+#endif
+
+#if defined(YM_BN_HAS_LZMA)
+
+// xz 形式の展開器
+class XzDecoder :
+  public Decoder
+{
+public:
+
+  // コンストラクタ
+  XzDecoder()
+  {
+    mOk = lzma_stream_decoder(&mStream, UINT64_MAX,
+			      LZMA_CONCATENATED) == LZMA_OK;
+  }
+
+  // デストラクタ
+  ~XzDecoder()
+  {
+    lzma_end(&mStream);
+  }
+
+  // 圧縮データを展開して out に書き込む．
+  bool
+  decode(
+    const char* in,
+    SizeType in_size,
+    bool last,
+    Decompressor::Output& out
+  ) override
+  {
+    if ( !mOk ) {
+      return false;
+    }
+    mStream.next_in = reinterpret_cast<const uint8_t*>(in);
+    mStream.avail_in = in_size;
+    auto action = last ? LZMA_FINISH : LZMA_RUN;
+    for ( ; ; ) {
+      SizeType avail;
+      auto dst = out.reserve(avail);
+      mStream.next_out = reinterpret_cast<uint8_t*>(dst);
+      mStream.avail_out = avail;
+      auto ret = lzma_code(&mStream, action);
+      out.commit(avail - mStream.avail_out);
+      if ( ret == LZMA_STREAM_END ) {
+	return true;
+      }
+      if ( ret != LZMA_OK ) {
+	return false;
+      }
+      if ( mStream.avail_in == 0 && mStream.avail_out > 0 ) {
+	// 入力を使い切った．
+	// LZMA_FINISH の場合は LZMA_STREAM_END が返るはず．
+	return !last;
+      }
+    }
+  }
+
+
+private:
+
+  // liblzma のストリーム
+  lzma_stream mStream = LZMA_STREAM_INIT;
+
+  // 初期化に成功した時 true
+  bool mOk;
+
+};
+
+#endif
+
+#if defined(YM_BN_HAS_ZSTD)
+
+// zstd 形式の展開器
+//
+// 複数のフレームを連結したファイルにも対応する．
+class ZstdDecoder :
+  public Decoder
+{
+public:
+
+  // コンストラクタ
+  ZstdDecoder() :
+    mStream{ZSTD_createDStream()}
+  {
+  }
+
+  // デストラクタ
+  ~ZstdDecoder()
+  {
+    ZSTD_freeDStream(mStream);
+  }
+
+  // 圧縮データを展開して out に書き込む．
+  bool
+  decode(
+    const char* in,
+    SizeType in_size,
+    bool last,
+    Decompressor::Output& out
+  ) override
+  {
+    if ( mStream == nullptr ) {
+      return false;
+    }
+    ZSTD_inBuffer in_buf{in, in_size, 0};
+    for ( ; ; ) {
+      SizeType avail;
+      auto dst = out.reserve(avail);
+      ZSTD_outBuffer out_buf{dst, avail, 0};
+      auto ret = ZSTD_decompressStream(mStream, &out_buf, &in_buf);
+      out.commit(out_buf.pos);
+      if ( ZSTD_isError(ret) ) {
+	return false;
+      }
+      // ret が 0 の時はフレームの末尾に達している．
+      mEnd = ret == 0;
+      if ( in_buf.pos == in_buf.size && out_buf.pos < out_buf.size ) {
+	break;
+      }
+    }
+    if ( last ) {
+      return mEnd;
+    }
+    return true;
+  }
+
+
+private:
+
+  // zstd のストリーム
+  ZSTD_DStream* mStream;
+
+  // フレームの末尾に達している時 true
+  bool mEnd{true};
+
+};
+
+#endif
+
+// 展開器を作る．
+//
+// 形式が利用できない場合は nullptr を返す．
+std::unique_ptr<Decoder>
+new_decoder(
+  Decompressor::Type type
+)
+{
+  switch ( type ) {
+#if defined(YM_BN_HAS_ZLIB)
+  case Decompressor::Gzip: return std::unique_ptr<Decoder>{new GzipDecoder};
+#endif
+#if defined(YM_BN_HAS_LZMA)
+  case Decompressor::Xz:   return std::unique_ptr<Decoder>{new XzDecoder};
+#endif
+#if defined(YM_BN_HAS_ZSTD)
+  case Decompressor::Zstd: return std::unique_ptr<Decoder>{new ZstdDecoder};
+#endif
+  default: break;
+  }
+  return nullptr;
+}
+
+// 読み出し用のバッファ
+struct Block
+{
+  // 内容
+  std::vector<char> data;
+
+  // 内容のサイズ
+  SizeType size{0};
+
+  // 最後のブロックの時 true
+  bool last{false};
+
+  // 内容が入っている時 true
+  bool full{false};
+};
+
+// 読み出し用のスレッドを終了させるためのクラス
+//
+// 展開中に例外が送出された場合も読み出し用のスレッドを止めてから
+// join する．
+struct ReaderJoiner
+{
+  ~ReaderJoiner()
+  {
+    {
+      std::lock_guard<std::mutex> lock{mtx};
+      abort = true;
+    }
+    cv.notify_all();
+    if ( reader.joinable() ) {
+      reader.join();
+    }
+  }
+
+  bool& abort;
+  std::mutex& mtx;
+  std::condition_variable& cv;
+  std::thread& reader;
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Decompressor
+//////////////////////////////////////////////////////////////////////
+
+// @brief 先頭のバイト列から圧縮形式を判定する．
+Decompressor::Type
+Decompressor::detect(
+  const char* buf,
+  SizeType size
+)
+{
+  auto ubuf = reinterpret_cast<const unsigned char*>(buf);
+  if ( size >= 2 && ubuf[0] == 0x1f && ubuf[1] == 0x8b ) {
+    return Gzip;
+  }
+  if ( size >= 6 && std::memcmp(buf, "\xfd" "7zXZ\0", 6) == 0 ) {
+    return Xz;
+  }
+  if ( size >= 4 && std::memcmp(buf, "\x28\xb5\x2f\xfd", 4) == 0 ) {
+    return Zstd;
+  }
+  return None;
+}
+
+// @brief 圧縮形式の名前を返す．
+const char*
+Decompressor::type_name(
+  Type type
+)
+{
+  switch ( type ) {
+  case None: return "none";
+  case Gzip: return "gzip";
+  case Xz:   return "xz";
+  case Zstd: return "zstd";
+  }
+  return "unknown";
+}
+
+// @brief 圧縮形式が利用可能な時 true を返す．
+bool
+Decompressor::is_supported(
+  Type type
+)
+{
+  switch ( type ) {
+  case None: return true;
+#if defined(YM_BN_HAS_ZLIB)
+  case Gzip: return true;
+#endif
+#if defined(YM_BN_HAS_LZMA)
+  case Xz:   return true;
+#endif
+#if defined(YM_BN_HAS_ZSTD)
+  case Zstd: return true;
+#endif
+  default: break;
+  }
+  return false;
+}
+
+// @brief ストリームから読み出して展開する．
+void
+Decompressor::read(
+  std::istream& s,
+  Type type,
+  const std::string& filename,
+  std::string& out,
+  SizeType limit
+)
+{
+  StringOutput output{out};
+  read(s, type, filename, output, limit);
+}
+
+// @brief ストリームから読み出して展開する．
+void
+Decompressor::read(
+  std::istream& s,
+  Type type,
+  const std::string& filename,
+  Output& out,
+  SizeType limit
+)
+{
+  auto decoder = new_decoder(type);
+  if ( decoder.get() == nullptr ) {
+    std::ostringstream buf;
+    buf << filename << ": " << type_name(type)
+	<< " format is not supported.";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  // 読み出し用のスレッドが block_list に交互に書き込み，
+  // このスレッドで展開する．
+  Block block_list[2];
+  bool abort = false;
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::thread reader{[&]() {
+    for ( SizeType k = 0; ; k ^= 1 ) {
+      auto& block = block_list[k];
+      {
+	std::unique_lock<std::mutex> lock{mtx};
+	cv.wait(lock, [&]() { return !block.full || abort; });
+	if ( abort ) {
+	  return;
+	}
+      }
+      block.data.resize(BLOCK_SIZE);
+      s.read(block.data.data(), BLOCK_SIZE);
+      block.size = s.gcount();
+      block.last = !s;
+      {
+	std::lock_guard<std::mutex> lock{mtx};
+	block.full = true;
+      }
+      cv.notify_all();
+      if ( block.last ) {
+	return;
+      }
+    }
+  }};
+
+  bool ok = true;
+  {
+    ReaderJoiner joiner{abort, mtx, cv, reader};
+    for ( SizeType k = 0; ; k ^= 1 ) {
+      auto& block = block_list[k];
+      {
+	std::unique_lock<std::mutex> lock{mtx};
+	cv.wait(lock, [&]() { return block.full; });
+      }
+      ok = decoder->decode(block.data.data(), block.size, block.last, out);
+      bool last = block.last;
+      bool done = !ok || last || (limit > 0 && out.size() >= limit);
+      {
+	std::lock_guard<std::mutex> lock{mtx};
+	block.full = false;
+	if ( done ) {
+	  abort = true;
+	}
+      }
+      cv.notify_all();
+      if ( done ) {
+	break;
+      }
+    }
+  }
+
+  if ( !ok && (limit == 0 || out.size() < limit) ) {
+    std::ostringstream buf;
+    buf << filename << ": corrupted " << type_name(type) << " data.";
+    throw std::invalid_argument{buf.str()};
+  }
+}
+
+END_NAMESPACE_YM_BN
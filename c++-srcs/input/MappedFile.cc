@@ -0,0 +1,363 @@
+
+/// @file MappedFile.cc
+/// @brief MappedFile の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MappedFile.h"
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define YM_BN_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 展開結果を1度に書き込むサイズ
+//
+// 展開済みの範囲は最大でこの単位で公開される．
+const SizeType STREAM_CHUNK = 64 * 1024;
+
+// 展開用に確保する領域の圧縮されたファイルのサイズに対する比
+//
+// deflate の圧縮率は最大でも 1032 倍程度なのでそれより大きくとる．
+const SizeType STREAM_RATIO = 4096;
+
+// 展開用に確保する領域の最小サイズ
+const SizeType STREAM_MIN_RESERVE = 64 * 1024 * 1024;
+
+// 展開用に確保する領域の最大サイズ
+const SizeType STREAM_MAX_RESERVE = static_cast<SizeType>(1) << 44;
+
+// 展開を中断したことを表す例外
+struct StreamAborted
+{
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// 展開結果を mmap() で確保した領域に書き込む Output
+//////////////////////////////////////////////////////////////////////
+class MappedFile::StreamOutput :
+  public Decompressor::Output
+{
+public:
+
+  // コンストラクタ
+  StreamOutput(
+    MappedFile& file,
+    const std::string& filename
+  ) : mFile{file},
+      mFilename{filename}
+  {
+  }
+
+  // 書き込み用の領域を確保する．
+  char*
+  reserve(
+    SizeType& avail
+  ) override
+  {
+    if ( mFile.mAbort ) {
+      throw StreamAborted{};
+    }
+    avail = std::min(STREAM_CHUNK, mFile.mMapSize - mSize);
+    if ( avail == 0 ) {
+      std::ostringstream buf;
+      buf << mFilename << ": decompressed data is too large.";
+      throw std::invalid_argument{buf.str()};
+    }
+    return static_cast<char*>(mFile.mMapAddr) + mSize;
+  }
+
+  // reserve() で確保した領域の先頭から size バイトを確定する．
+  void
+  commit(
+    SizeType size
+  ) override
+  {
+    // 公開するのは最後の改行文字までとする．
+    // スキャナーが区切り文字を探す時に単語の途中で止まらないようにするため．
+    auto begin = static_cast<const char*>(mFile.mMapAddr) + mSize;
+    auto end = begin + size;
+    mSize += size;
+    for ( auto p = end; p != begin; -- p ) {
+      if ( *(p - 1) == '\n' ) {
+	mFile.publish(p - static_cast<const char*>(mFile.mMapAddr), false);
+	break;
+      }
+    }
+  }
+
+  // 確定したサイズの合計を返す．
+  SizeType
+  size() const override
+  {
+    return mSize;
+  }
+
+
+private:
+
+  // 書き込み先のファイル
+  MappedFile& mFile;
+
+  // エラーメッセージ用のファイル名
+  std::string mFilename;
+
+  // 確定したサイズ
+  SizeType mSize{0};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス MappedFile
+//////////////////////////////////////////////////////////////////////
+
+// @brief デストラクタ
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+// @brief ファイルを開く．
+bool
+MappedFile::open(
+  const std::string& filename,
+  bool use_mmap,
+  bool decompress
+)
+{
+  close();
+
+  if ( decompress ) {
+    // 先頭のバイト列で圧縮されているか調べる．
+    std::ifstream s{filename, std::ios::binary};
+    if ( !s ) {
+      return false;
+    }
+    char magic[Decompressor::MAGIC_SIZE];
+    s.read(magic, sizeof(magic));
+    auto type = Decompressor::detect(magic, s.gcount());
+    if ( type != Decompressor::None ) {
+      s.clear();
+      s.seekg(0, std::ios::end);
+      SizeType file_size = s.tellg();
+      s.seekg(0);
+      // 可能ならば別スレッドで展開しながら読み出せるようにする．
+      if ( Decompressor::is_supported(type) &&
+	   start_stream(std::move(s), type, filename, file_size) ) {
+	return true;
+      }
+      Decompressor::read(s, type, filename, mBuff);
+      mBegin = mBuff.data();
+      mSize = mBuff.size();
+      return true;
+    }
+  }
+
+#if defined(YM_BN_HAS_MMAP)
+  if ( use_mmap ) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if ( fd < 0 ) {
+      return false;
+    }
+    struct stat st;
+    if ( ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) ) {
+      SizeType size = st.st_size;
+      if ( size == 0 ) {
+	// 空のファイルはマップできない．
+	::close(fd);
+	return true;
+      }
+      auto addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if ( addr != MAP_FAILED ) {
+	::close(fd);
+	::madvise(addr, size, MADV_SEQUENTIAL);
+	mMapAddr = addr;
+	mMapSize = size;
+	mBegin = static_cast<const char*>(addr);
+	mSize = size;
+	return true;
+      }
+    }
+    // 通常ファイル以外や mmap() の失敗時は普通に読み込む．
+    ::close(fd);
+  }
+#endif
+
+  std::ifstream s{filename, std::ios::binary};
+  if ( !s ) {
+    return false;
+  }
+  read(s);
+  return true;
+}
+
+// @brief ストリームの内容を全て読み込む．
+void
+MappedFile::read(
+  std::istream& s
+)
+{
+  close();
+
+  std::ostringstream buf;
+  buf << s.rdbuf();
+  mBuff = buf.str();
+  mBegin = mBuff.data();
+  mSize = mBuff.size();
+}
+
+// @brief 閉じる．
+void
+MappedFile::close()
+{
+  if ( mDecoder.joinable() ) {
+    // 展開中ならば中断させる．
+    mAbort = true;
+    mDecoder.join();
+  }
+#if defined(YM_BN_HAS_MMAP)
+  if ( mMapAddr != nullptr ) {
+    ::munmap(mMapAddr, mMapSize);
+    mMapAddr = nullptr;
+    mMapSize = 0;
+  }
+#endif
+  mBuff.clear();
+  mBegin = nullptr;
+  mSize = 0;
+  mStreaming = false;
+  mReady = 0;
+  mDone = false;
+  mError = nullptr;
+  mAbort = false;
+}
+
+// @brief 内容のサイズがわかっていればそれを返す．
+SizeType
+MappedFile::size_hint() const
+{
+  if ( !mStreaming ) {
+    return mSize;
+  }
+  std::lock_guard<std::mutex> lock{mMutex};
+  if ( mDone && mError == nullptr ) {
+    return mSize;
+  }
+  return 0;
+}
+
+// @brief 展開済みの範囲の末尾の次を返す．
+const char*
+MappedFile::ready_end() const
+{
+  if ( !mStreaming ) {
+    return mBegin + mSize;
+  }
+  std::lock_guard<std::mutex> lock{mMutex};
+  return mBegin + mReady;
+}
+
+// @brief 展開済みの範囲が end より先に伸びるまで待つ．
+const char*
+MappedFile::wait_more(
+  const char* end
+) const
+{
+  if ( !mStreaming ) {
+    return mBegin + mSize;
+  }
+  bool all = end == nullptr;
+  SizeType pos = all ? 0 : end - mBegin;
+  std::unique_lock<std::mutex> lock{mMutex};
+  mCond.wait(lock, [&]() { return mDone || (!all && mReady > pos); });
+  if ( (all || mReady <= pos) && mError != nullptr ) {
+    // 展開済みの範囲を読み終えてから例外を送出する．
+    std::rethrow_exception(mError);
+  }
+  return mBegin + mReady;
+}
+
+// @brief 展開用のスレッドを起動する．
+bool
+MappedFile::start_stream(
+  std::ifstream&& s,
+  Decompressor::Type type,
+  const std::string& filename,
+  SizeType file_size
+)
+{
+#if defined(YM_BN_HAS_MMAP) && defined(MAP_NORESERVE)
+  if ( sizeof(void*) < 8 ) {
+    // 十分な仮想アドレスの領域がない．
+    return false;
+  }
+  // 展開後のサイズはわからないので大きめの領域を確保しておく．
+  // MAP_NORESERVE を指定するので実際に書き込んだ部分しか
+  // 記憶領域を消費しない．
+  auto size = std::min(std::max(file_size * STREAM_RATIO,
+				STREAM_MIN_RESERVE),
+		       STREAM_MAX_RESERVE);
+  auto addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+		     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if ( addr == MAP_FAILED ) {
+    return false;
+  }
+  mMapAddr = addr;
+  mMapSize = size;
+  mBegin = static_cast<const char*>(addr);
+  mStreaming = true;
+  mDecoder = std::thread{[this, type, filename](std::ifstream s) {
+    StreamOutput out{*this, filename};
+    std::exception_ptr error;
+    try {
+      Decompressor::read(s, type, filename, out);
+    }
+    catch ( ... ) {
+      error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      mError = error;
+    }
+    publish(out.size(), true);
+  }, std::move(s)};
+  return true;
+#else
+  return false;
+#endif
+}
+
+// @brief 展開済みの範囲を公開する．
+void
+MappedFile::publish(
+  SizeType size,
+  bool done
+)
+{
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mReady = size;
+    if ( done ) {
+      mSize = size;
+      mDone = true;
+    }
+  }
+  mCond.notify_all();
+}
+
+END_NAMESPACE_YM_BN
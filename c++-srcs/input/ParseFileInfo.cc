@@ -0,0 +1,26 @@
+
+/// @file ParseFileInfo.cc
+/// @brief new_file_info() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ParseFileInfo.h"
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+// @brief 読み込むファイルの FileInfo を作る．
+FileInfo
+new_file_info(
+  const std::string& filename
+)
+{
+  static std::mutex mtx;
+  std::lock_guard<std::mutex> lock{mtx};
+  return FileInfo{filename};
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,51 @@
+
+/// @file ReadOption.cc
+/// @brief ReadOption の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ReadOption.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス ReadOption
+//////////////////////////////////////////////////////////////////////
+
+// @brief JSON オブジェクトから値を取り出すコンストラクタ
+ReadOption::ReadOption(
+  const JsonValue& option
+)
+{
+  if ( !option.is_object() ) {
+    return;
+  }
+  if ( option.has_key("mmap") ) {
+    use_mmap = option.at("mmap").get_bool();
+  }
+  if ( option.has_key("thread_num") ) {
+    auto n = option.at("thread_num").get_int();
+    thread_num = n > 1 ? n : 1;
+  }
+  if ( option.has_key("cache_dir") ) {
+    cache_dir = option.at("cache_dir").get_string();
+  }
+  if ( option.has_key("track_location") ) {
+    track_location = option.at("track_location").get_bool();
+  }
+  if ( option.has_key("output_filter") ) {
+    auto js_list = option.at("output_filter");
+    if ( !js_list.is_array() ) {
+      throw std::invalid_argument{"'output_filter' should be an array"};
+    }
+    auto n = js_list.size();
+    for ( SizeType i = 0; i < n; ++ i ) {
+      output_filter.push_back(js_list[i].get_string());
+    }
+  }
+}
+
+END_NAMESPACE_YM_BN
@@ -11,6 +11,10 @@
 #include "ym/BnModel.h"
 #include "ModelImpl.h"
 #include "ym/Expr.h"
+#include "MappedFile.h"
+#include "ParseFileInfo.h"
+#include "ProgressReporter.h"
+#include "ParseCache.h"
 #include "ym/MsgMgr.h"
 
 
@@ -23,18 +27,25 @@ BEGIN_NAMESPACE_YM_BN
 // @brief iscas89(.bench) ファイルの読み込みを行う．
 BnModel
 BnModel::read_iscas89(
-  const std::string& filename
+  const std::string& filename,
+  const JsonValue& option
 )
 {
+  ParseCache cache{filename, "iscas89", option};
   BnModel model;
+  if ( cache.load(model) ) {
+    return model;
+  }
+  model._set_read_option(option);
 
   Iscas89Parser parser(model._model_impl());
-  if ( !parser.read(filename) ) {
+  if ( !parser.read(filename, ReadOption{option}) ) {
     std::ostringstream buf;
     buf << "BnModel::read_iscas89(\"" << filename << "\") failed.";
     throw std::invalid_argument{buf.str()};
   }
 
+  cache.save(model);
   return model;
 }
 
@@ -71,32 +82,74 @@ Iscas89Parser::~Iscas89Parser()
 // nor    = NAME '=' 'NOR' '(' NAME ',' NAME { ',' NAME } ')'
 // xor    = NAME '=' 'XOR' '(' NAME ',' NAME { ',' NAME } ')'
 // xnor   = NAME '=' 'XNOR' '(' NAME ',' NAME { ',' NAME } ')'
-// mux    = NAME '=' 'MUX' '(' NAME, NAME, NAME ')' // host2015 オリジナル．3入力決め打ち？
+// mux    = NAME '=' 'MUX' '(' NAME ',' NAME { ',' NAME } ')' // host2015 オリジナル
+//          制御入力が n 個の時，2^n 個のデータ入力が続く．
 // dff    = NAME '=' 'DFF' '(' NAME ')'
 //
 bool
 Iscas89Parser::read(
-  const std::string& filename
+  const std::string& filename,
+  const ReadOption& option
+)
+{
+  if ( option.track_location ) {
+    return read_file(filename, option);
+  }
+
+  // 位置情報を記録せずに読み込む．
+  // 読み直す可能性があるのでメッセージは保留しておく．
+  mTrackLoc = false;
+  mMsgQueue.set_defer(true);
+  auto ok = read_file(filename, option);
+  if ( ok || !mNeedRetry ) {
+    mMsgQueue.flush();
+    return ok;
+  }
+
+  // 位置情報が必要なエラーが見つかったので記録しながら読み直す．
+  mMsgQueue.clear();
+  mMsgQueue.set_defer(false);
+  mModel.clear();
+  mIdDict.clear();
+  mNameDict.clear();
+  mDefinedArray.clear();
+  mMark.clear();
+  mTrackLoc = true;
+  mNeedRetry = false;
+  return read_file(filename, option);
+}
+
+// @brief ファイルを開いて読み込む．
+bool
+Iscas89Parser::read_file(
+  const std::string& filename,
+  const ReadOption& option
 )
 {
   // ファイルをオープンする．
-  std::ifstream fin{filename};
-  if ( !fin ) {
+  MappedFile fin;
+  if ( !fin.open(filename, option.use_mmap) ) {
     // エラー
     std::ostringstream buf;
     buf << filename << " : No such file.";
-    MsgMgr::put_msg(__FILE__, __LINE__, FileRegion(),
-		    MsgType::Failure, "ISCAS89_PARSER", buf.str());
+    mMsgQueue.put_msg(__FILE__, __LINE__, FileRegion(),
+		      MsgType::Failure, "ISCAS89_PARSER", buf.str());
     return false;
   }
 
-  Iscas89Scanner scanner(fin, {filename});
+  // 圧縮されたファイルは展開済みの部分から読み進める．
+  Iscas89Scanner scanner(fin.begin(), fin.ready_end(), new_file_info(filename));
+  scanner.set_source(fin);
   mScanner = &scanner;
 
+  ProgressReporter progress{"read", fin.size_hint(),
+			    ProgressReporter::BYTE_STRIDE};
+
   // パーサー本体
   bool go_on = true;
   bool has_error = false;
   while ( go_on ) {
+    progress.update(scanner.cur_ptr() - fin.begin(), mModel.node_num());
     SizeType name_id;
     auto token = read_token(name_id);
     auto first_loc = token.loc();
@@ -129,6 +182,9 @@ Iscas89Parser::read(
     continue;
 
   error:
+    if ( mNeedRetry ) {
+      return false;
+    }
     has_error = true;
     // ')' まで読み進める．
     for ( ; ; ) {
@@ -140,20 +196,30 @@ Iscas89Parser::read(
     }
   }
 
-  {
+  if ( !mTrackLoc ) {
+    for ( bool defined: mDefinedArray ) {
+      if ( !defined ) {
+	has_loc();
+	return false;
+      }
+    }
+  }
+  else {
     for ( auto& p: mRefLocDict ) {
       auto id = p.first;
       if ( !is_defined(id) ) {
 	std::ostringstream buf;
 	buf << id2str(id) << ": Undefined.";
-	MsgMgr::put_msg(__FILE__, __LINE__, ref_loc(id),
-			MsgType::Error,
-			"UNDEF01", buf.str().c_str());
+	mMsgQueue.put_msg(__FILE__, __LINE__, ref_loc(id),
+			  MsgType::Error,
+			  "UNDEF01", buf.str().c_str());
 	return false;
       }
     }
   }
 
+  progress.set_total(fin.size());
+  progress.finish(mModel.node_num());
   mModel.make_logic_list();
 
   return !has_error;
@@ -174,14 +240,17 @@ Iscas89Parser::read_input(
   auto name = id2str(name_id);
   // 二重定義のチェック
   if ( is_defined(name_id) ) {
+    if ( !has_loc() ) {
+      return false;
+    }
     auto loc2 = def_loc(name_id);
     std::ostringstream buf;
     buf << name << ": Defined more than once. Previous definition is at "
 	<< loc2;
-    MsgMgr::put_msg(__FILE__, __LINE__, loc,
-		    MsgType::Error,
-		    "ER_MLTDEF01",
-		    buf.str());
+    mMsgQueue.put_msg(__FILE__, __LINE__, loc,
+		      MsgType::Error,
+		      "ER_MLTDEF01",
+		      buf.str());
     return false;
   }
 
@@ -228,15 +297,18 @@ Iscas89Parser::read_gate(
 
   // 二重定義のチェック
   if ( is_defined(name_id) ) {
+    if ( !has_loc() ) {
+      return false;
+    }
     auto name = id2str(name_id);
     auto loc2 = def_loc(name_id);
     std::ostringstream buf;
     buf << name << ": Defined more than once. "
 	<< "Previsous Definition is at " << loc2;
-    MsgMgr::put_msg(__FILE__, __LINE__, first_loc,
-		    MsgType::Error,
-		    "ER_MLTDEF01",
-		    buf.str());
+    mMsgQueue.put_msg(__FILE__, __LINE__, first_loc,
+		      MsgType::Error,
+		      "ER_MLTDEF01",
+		      buf.str());
     return false;
   }
 
@@ -244,7 +316,20 @@ Iscas89Parser::read_gate(
   if ( gate_token.type() == Iscas89Token::GATE ) {
     std::vector<SizeType> iname_id_list;
     FileRegion last_loc;
-    if ( !parse_name_list(iname_id_list, last_loc) ) {
+    auto gate_type = gate_token.gate_type();
+    if ( gate_type == PrimType::C0 || gate_type == PrimType::C1 ) {
+      // 定数は空の引数リストをとる．
+      bool ok;
+      std::tie(ok, std::ignore, std::ignore) = expect(Iscas89Token::LPAR);
+      if ( !ok ) {
+	return false;
+      }
+      std::tie(ok, std::ignore, last_loc) = expect(Iscas89Token::RPAR);
+      if ( !ok ) {
+	return false;
+      }
+    }
+    else if ( !parse_name_list(iname_id_list, last_loc) ) {
       return false;
     }
     FileRegion loc{first_loc, last_loc};
@@ -268,6 +353,20 @@ Iscas89Parser::read_gate(
     mModel.set_node_name(name_id, name);
     return true;
   }
+  if ( gate_token.type() == Iscas89Token::MUX ) {
+    std::vector<SizeType> iname_id_list;
+    FileRegion last_loc;
+    if ( !parse_name_list(iname_id_list, last_loc) ) {
+      return false;
+    }
+    FileRegion loc{first_loc, last_loc};
+    if ( !read_mux(loc, name_id, iname_id_list) ) {
+      return false;
+    }
+    auto name = id2str(name_id);
+    mModel.set_node_name(name_id, name);
+    return true;
+  }
 #if 0
   if ( gate_token.type() == Iscas89Token::EXGATE ) {
     auto handler = get_handler(gate_token.ex_id());
@@ -278,6 +377,46 @@ Iscas89Parser::read_gate(
   return false;
 }
 
+// @brief MUX 文の内容を設定する．
+bool
+Iscas89Parser::read_mux(
+  const FileRegion& loc,
+  SizeType name_id,
+  const std::vector<SizeType>& iname_id_list
+)
+{
+  // 入力数をチェックする．
+  SizeType ni = iname_id_list.size();
+  SizeType nc = 0;
+  SizeType nd = 1;
+  while ( nc + nd < ni ) {
+    ++ nc;
+    nd <<= 1;
+  }
+  if ( nc == 0 || nc + nd != ni ) {
+    std::ostringstream buf;
+    buf << id2str(name_id) << ": Wrong # of inputs for MUX-type.";
+    mMsgQueue.put_msg(__FILE__, __LINE__, loc,
+		      MsgType::Error,
+		      "ER_MUX01",
+		      buf.str());
+    return false;
+  }
+
+  // 制御入力の値が i の時にデータ入力 i を選ぶ．
+  Expr expr;
+  for ( SizeType i = 0; i < nd; ++ i ) {
+    auto term = Expr::literal(i + nc);
+    for ( SizeType j = 0; j < nc; ++ j ) {
+      bool inv = (i & (1 << j)) == 0;
+      term = term & Expr::literal(j, inv);
+    }
+    expr = i == 0 ? term : expr | term;
+  }
+  set_complex(name_id, loc, expr, iname_id_list);
+  return true;
+}
+
 // @brief '(' ')' で囲まれた名前を読み込む．
 bool
 Iscas89Parser::parse_name(
@@ -338,10 +477,10 @@ Iscas89Parser::parse_name_list(
       // ')' か ',' を期待していたシンタックスエラー
       std::ostringstream buf;
       buf << "Syntax error: ')' or ',' are expected.";
-      MsgMgr::put_msg(__FILE__, __LINE__, token.loc(),
-		      MsgType::Error,
-		      "ER_SYNTAX03",
-		      buf.str());
+      mMsgQueue.put_msg(__FILE__, __LINE__, token.loc(),
+			MsgType::Error,
+			"ER_SYNTAX03",
+			buf.str());
       return false;
     }
   }
@@ -363,6 +502,7 @@ token_str(
   case Iscas89Token::INPUT:  return "INPUT";
   case Iscas89Token::OUTPUT: return "OUTPUT";
   case Iscas89Token::GATE:   return "GATE";
+  case Iscas89Token::MUX:    return "MUX";
   case Iscas89Token::EXGATE: return "EXGATE";
   case Iscas89Token::DFF:    return "DFF";
   case Iscas89Token::NAME:   return "__name__";
@@ -387,10 +527,10 @@ Iscas89Parser::expect(
     // トークンが期待値と異なっていた
     std::ostringstream buf;
     buf << "Syntax error: '" << token_str(exp_type) << "' is expected.";
-    MsgMgr::put_msg(__FILE__, __LINE__, token.loc(),
-		    MsgType::Error,
-		    "ER_SYNTAX01",
-		    buf.str());
+    mMsgQueue.put_msg(__FILE__, __LINE__, token.loc(),
+		      MsgType::Error,
+		      "ER_SYNTAX01",
+		      buf.str());
     return std::make_tuple(false, 0, token.loc());
   }
 
@@ -13,6 +13,8 @@
 #include "Iscas89Scanner.h"
 #include "Iscas89Token.h"
 #include "ModelImpl.h"
+#include "ReadOption.h"
+#include "MsgQueue.h"
 
 
 BEGIN_NAMESPACE_YM_BN
@@ -48,7 +50,8 @@ public:
   /// @retval false 読み込みが失敗した．
   bool
   read(
-    const std::string& filename  ///< [in] ファイル名
+    const std::string& filename,            ///< [in] ファイル名
+    const ReadOption& option = ReadOption{} ///< [in] 読み込みオプション
   );
 
   /// @brief 拡張ハンドラを登録する．
@@ -117,6 +120,16 @@ public:
     mModel.set_logic(id, func_id, fanin_list);
   }
 
+  /// @brief MUX 文の内容を設定する．
+  /// @retval true 入力数が正しかった．
+  /// @retval false 入力数が正しくなかった．
+  bool
+  read_mux(
+    const FileRegion& loc,                     ///< [in] ファイル上の位置
+    SizeType name_id,                          ///< [in] 出力の識別子番号
+    const std::vector<SizeType>& iname_id_list ///< [in] 入力の識別子番号のリスト
+  );
+
   /// @brief '(' ')' で囲まれた名前を読み込む．
   /// @retval true 読み込みが成功した．
   /// @retval false 読み込みが失敗した．
@@ -154,6 +167,15 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief ファイルを開いて読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read_file(
+    const std::string& filename, ///< [in] ファイル名
+    const ReadOption& option     ///< [in] 読み込みオプション
+  );
+
   /// @brief INPUT 文を読み込む．
   /// @return エラーが起きたら false を返す．
   bool
@@ -221,7 +243,10 @@ private:
   )
   {
     auto id = mModel.alloc_node();
-    mRefLocDict.emplace(id, loc);
+    if ( mTrackLoc ) {
+      mRefLocDict.emplace(id, loc);
+    }
+    mDefinedArray.push_back(false);
     return id;
   }
 
@@ -250,7 +275,11 @@ private:
     const FileRegion& loc ///< ファイル上の位置
   )
   {
-    mDefLocDict.emplace(id, loc);
+    ASSERT_COND( id < mDefinedArray.size() );
+    mDefinedArray[id] = true;
+    if ( mTrackLoc ) {
+      mDefLocDict.emplace(id, loc);
+    }
   }
 
   /// @brief 該当の識別子が定義済みか調べる．
@@ -259,7 +288,8 @@ private:
     SizeType id ///< [in] ID番号
   ) const
   {
-    return mDefLocDict.count(id) > 0;
+    ASSERT_COND( id < mDefinedArray.size() );
+    return mDefinedArray[id];
   }
 
   /// @brief ID 番号から参照されている位置情報を得る．
@@ -282,6 +312,20 @@ private:
     return mDefLocDict.at(id);
   }
 
+  /// @brief 位置情報が使えるか調べる．
+  /// @retval true ref_loc(), def_loc() が使える．
+  /// @retval false 位置情報を記録していない．
+  ///
+  /// false の場合は読み直しが必要な印をつける．
+  bool
+  has_loc()
+  {
+    if ( !mTrackLoc ) {
+      mNeedRetry = true;
+    }
+    return mTrackLoc;
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -307,12 +351,28 @@ private:
   // ID をキーにして名前を格納する辞書
   std::unordered_map<SizeType, std::string> mNameDict;
 
+  // 参照位置と定義位置を記録する時 true
+  bool mTrackLoc{true};
+
+  // 位置情報を記録しながら読み直す必要がある時 true
+  bool mNeedRetry{false};
+
+  // 定義済みの印を ID番号ごとに格納する配列
+  std::vector<bool> mDefinedArray;
+
   // 参照された位置を記録する配列
+  //
+  // mTrackLoc が true の時のみ用いる．
   std::unordered_map<SizeType, FileRegion> mRefLocDict;
 
   // 定義された位置を記録する辞書
+  //
+  // mTrackLoc が true の時のみ用いる．
   std::unordered_map<SizeType, FileRegion> mDefLocDict;
 
+  // メッセージの出力を保留するためのオブジェクト
+  MsgQueue mMsgQueue;
+
   // 処理済みの印
   std::unordered_set<SizeType> mMark;
 
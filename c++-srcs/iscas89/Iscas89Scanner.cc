@@ -24,9 +24,10 @@ BEGIN_NAMESPACE_YM_BN
 
 // @brief コンストラクタ
 Iscas89Scanner::Iscas89Scanner(
-  std::istream& s,
+  const char* begin,
+  const char* end,
   const FileInfo& file_info
-) : Scanner{s, file_info}
+) : BufScanner{begin, end, file_info}
 {
   // 予約語辞書を作る．
   mRsvDict.emplace("INPUT", RsvInfo{Iscas89Token::INPUT, PrimType::None});
@@ -53,6 +54,12 @@ Iscas89Scanner::Iscas89Scanner(
   mRsvDict.emplace("xor", RsvInfo{Iscas89Token::GATE, PrimType::Xor});
   mRsvDict.emplace("XNOR", RsvInfo{Iscas89Token::GATE, PrimType::Xnor});
   mRsvDict.emplace("xnor", RsvInfo{Iscas89Token::GATE, PrimType::Xnor});
+  mRsvDict.emplace("CONST0", RsvInfo{Iscas89Token::GATE, PrimType::C0});
+  mRsvDict.emplace("const0", RsvInfo{Iscas89Token::GATE, PrimType::C0});
+  mRsvDict.emplace("CONST1", RsvInfo{Iscas89Token::GATE, PrimType::C1});
+  mRsvDict.emplace("const1", RsvInfo{Iscas89Token::GATE, PrimType::C1});
+  mRsvDict.emplace("MUX", RsvInfo{Iscas89Token::MUX, PrimType::None});
+  mRsvDict.emplace("mux", RsvInfo{Iscas89Token::MUX, PrimType::None});
   mRsvDict.emplace("DFF", RsvInfo{Iscas89Token::DFF, PrimType::None});
   mRsvDict.emplace("dff", RsvInfo{Iscas89Token::DFF, PrimType::None});
 }
@@ -102,6 +109,8 @@ Iscas89Scanner::read_token()
     case Iscas89Token::OUTPUT: std::cerr << "OUTPUT"; break;
     case Iscas89Token::GATE:
       switch ( token.gate_type() ) {
+      case PrimType::C0:     std::cerr << "CONST0"; break;
+      case PrimType::C1:     std::cerr << "CONST1"; break;
       case PrimType::Buff:   std::cerr << "BUFF"; break;
       case PrimType::Not:    std::cerr << "NOT"; break;
       case PrimType::And:    std::cerr << "AND"; break;
@@ -113,6 +122,7 @@ Iscas89Scanner::read_token()
       default: ASSERT_NOT_REACHED; break;
       }
       break;
+    case Iscas89Token::MUX:    std::cerr << "MUX"; break;
     case Iscas89Token::EXGATE: std::cerr << "EXGATE(" << token.ex_id() << ")"; break;
     case Iscas89Token::DFF:    std::cerr << "DFF"; break;
     case Iscas89Token::NAME:   std::cerr << "NAME(" << token.name() << ")"; break;
@@ -181,25 +191,27 @@ Iscas89Scanner::scan()
   goto ST_SHARP;
 
  ST_STR:
-  c = peek();
-  switch ( c ) {
-  case ' ':
-  case '\t':
-  case '\n':
-  case '#':
-  case '=':
-  case '(':
-  case ')':
-  case ',':
-  case EOF:
-    // 文字列の終わり
-    return Iscas89Token::NAME;
+  // 文字列の終わりまでまとめて読み進める．
+  scan_word();
+  return Iscas89Token::NAME;
+}
 
-  default:
-    accept();
-    mCurString += static_cast<char>(c);
-    goto ST_STR;
+// @brief 区切り文字の直前まで読み進めて mCurString に追加する．
+void
+Iscas89Scanner::scan_word()
+{
+  auto start = cur_ptr();
+  auto end = end_ptr();
+  auto p = start;
+  for ( ; p != end; ++ p ) {
+    auto c = *p;
+    if ( c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+	 c == '#' || c == '=' || c == '(' || c == ')' || c == ',' ) {
+      break;
+    }
   }
+  mCurString.append(start, p);
+  advance(p);
 }
 
 END_NAMESPACE_YM_BN
@@ -9,7 +9,7 @@
 /// All rights reserved.
 
 #include "ym/bn.h"
-#include "ym/Scanner.h"
+#include "BufScanner.h"
 #include "Iscas89Token.h"
 
 
@@ -18,15 +18,18 @@ BEGIN_NAMESPACE_YM_BN
 //////////////////////////////////////////////////////////////////////
 /// @class Iscas89Scanner Iscas89Scanner.h "Iscas89Scanner.h"
 /// @brief iscas89 用の字句解析器
+///
+/// 入力はメモリ上に展開された内容([begin, end))を対象とする．
 //////////////////////////////////////////////////////////////////////
 class Iscas89Scanner :
-  public Scanner
+  public BufScanner
 {
 public:
 
   /// @brief コンストラクタ
   Iscas89Scanner(
-    std::istream& s,          ///< [in] 入力ストリーム
+    const char* begin,        ///< [in] 内容の先頭
+    const char* end,          ///< [in] 内容の末尾の次
     const FileInfo& file_info ///< [in] ファイル情報
   );
 
@@ -58,6 +61,10 @@ private:
   Iscas89Token::Type
   scan();
 
+  /// @brief 区切り文字の直前まで読み進めて mCurString に追加する．
+  void
+  scan_word();
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -69,7 +76,7 @@ private:
   {
     Iscas89Token::Type type; // トークンの種類
     PrimType gate_type;      // ゲートの種類
-    SizeType ex_id;          // 拡張ID
+    SizeType ex_id{0};       // 拡張ID
   };
 
 
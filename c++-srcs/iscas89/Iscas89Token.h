@@ -31,7 +31,8 @@ public:
     EQ,
     INPUT,
     OUTPUT,
-    GATE, // BUFF, NOT, AND, NAND, OR, NOR, XOR, XNOR
+    GATE, // BUFF, NOT, AND, NAND, OR, NOR, XOR, XNOR, CONST0, CONST1
+    MUX,
     EXGATE, // 拡張タイプ
     DFF,
     NAME,
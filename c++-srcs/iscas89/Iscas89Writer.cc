@@ -0,0 +1,495 @@
+
+/// @file Iscas89Writer.cc
+/// @brief Iscas89Writer の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Iscas89Writer.h"
+#include "BufWriter.h"
+#include "FuncImpl.h"
+#include "Isop.h"
+#include "ym/BnModel.h"
+#include "ym/SopCover.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/Bdd.h"
+#include "ym/BddVar.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// プリミティブ型に対応するゲート名を返す．
+const char*
+gate_name(
+  PrimType primitive_type
+)
+{
+  switch ( primitive_type ) {
+  case PrimType::C0:   return "CONST0";
+  case PrimType::C1:   return "CONST1";
+  case PrimType::Buff: return "BUFF";
+  case PrimType::Not:  return "NOT";
+  case PrimType::And:  return "AND";
+  case PrimType::Nand: return "NAND";
+  case PrimType::Or:   return "OR";
+  case PrimType::Nor:  return "NOR";
+  case PrimType::Xor:  return "XOR";
+  case PrimType::Xnor: return "XNOR";
+  default: break;
+  }
+  throw std::logic_error{"Iscas89Writer: unexpected primitive type"};
+}
+
+// 真理値表が MUX に一致するか調べる．
+//
+// 一致した場合は MUX の引数に対応するファンイン番号を perm に入れる．
+// MUX の引数は制御入力が nc 個，データ入力が 2^nc 個の順に並ぶ．
+bool
+match_mux(
+  const std::vector<bool>& table,
+  SizeType nc,
+  std::vector<SizeType>& perm
+)
+{
+  SizeType ni = nc + (1 << nc);
+  perm.resize(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    perm[i] = i;
+  }
+  SizeType np = 1 << ni;
+  do {
+    bool ok = true;
+    for ( SizeType p = 0; p < np && ok; ++ p ) {
+      SizeType c = 0;
+      for ( SizeType j = 0; j < nc; ++ j ) {
+	if ( p & (1 << perm[j]) ) {
+	  c |= (1 << j);
+	}
+      }
+      bool v = (p >> perm[nc + c]) & 1;
+      if ( v != table[p] ) {
+	ok = false;
+      }
+    }
+    if ( ok ) {
+      return true;
+    }
+  } while ( std::next_permutation(perm.begin(), perm.end()) );
+  return false;
+}
+
+// 真理値表の値のリストを作る．
+std::vector<bool>
+tvfunc_table(
+  const TvFunc& func
+)
+{
+  SizeType np = 1 << func.input_num();
+  std::vector<bool> table(np);
+  for ( SizeType p = 0; p < np; ++ p ) {
+    table[p] = func.value(p) != 0;
+  }
+  return table;
+}
+
+// 積和形の値のリストを作る．
+std::vector<bool>
+cubes_table(
+  const std::vector<std::string>& cube_list,
+  bool output_inv,
+  SizeType ni
+)
+{
+  SizeType np = 1 << ni;
+  std::vector<bool> table(np, output_inv);
+  for ( SizeType p = 0; p < np; ++ p ) {
+    for ( auto& cube: cube_list ) {
+      bool match = true;
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	bool v = (p >> i) & 1;
+	if ( (cube[i] == '1' && !v) || (cube[i] == '0' && v) ) {
+	  match = false;
+	  break;
+	}
+      }
+      if ( match ) {
+	table[p] = !output_inv;
+	break;
+      }
+    }
+  }
+  return table;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief iscas89(.bench) 形式で出力する．
+void
+BnModel::write_iscas89(
+  std::ostream& s
+) const
+{
+  Iscas89Writer writer{_model_impl()};
+  writer.write(s);
+}
+
+// @brief iscas89(.bench) 形式でファイルに出力する．
+void
+BnModel::write_iscas89(
+  const std::string& filename
+) const
+{
+  write_file(filename, "write_iscas89",
+	     [&](std::ostream& s){ write_iscas89(s); });
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Iscas89Writer
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Iscas89Writer::Iscas89Writer(
+  const ModelImpl& model
+) : mModel{model},
+    mNameMgr{model},
+    mFuncInfoArray(model.func_num()),
+    mNameCount{model.node_num() + model.output_num()}
+{
+}
+
+// @brief iscas89 形式で出力する．
+void
+Iscas89Writer::write(
+  std::ostream& s
+)
+{
+  BufWriter w{s};
+  mWriter = &w;
+
+  for ( auto& comment: mModel.comment_list() ) {
+    w.put("# ");
+    w.put(comment);
+    w.put('\n');
+  }
+  if ( !mModel.comment_list().empty() ) {
+    w.put('\n');
+  }
+
+  for ( auto id: mModel.input_id_list() ) {
+    w.put("INPUT(");
+    w.put(mNameMgr.node_name(id));
+    w.put(")\n");
+  }
+  w.put('\n');
+
+  for ( auto& name: mNameMgr.output_name_list() ) {
+    w.put("OUTPUT(");
+    w.put(name);
+    w.put(")\n");
+  }
+  w.put('\n');
+
+  for ( SizeType i = 0; i < mModel.dff_num(); ++ i ) {
+    auto& dff = mModel.dff_impl(i);
+    w.put(mNameMgr.node_name(dff.id));
+    w.put(" = DFF(");
+    w.put(mNameMgr.node_name(dff.src_id));
+    w.put(")\n");
+  }
+  if ( mModel.dff_num() > 0 ) {
+    w.put('\n');
+  }
+
+  for ( auto id: mModel.logic_id_list() ) {
+    write_node(id);
+  }
+
+  // ノード名と異なる名前の出力にはバッファを挿入する．
+  for ( SizeType i = 0; i < mModel.output_num(); ++ i ) {
+    auto& src_name = mNameMgr.node_name(mModel.output_id(i));
+    auto& oname = mNameMgr.output_name(i);
+    if ( oname != src_name ) {
+      write_gate("BUFF", {src_name}, oname);
+    }
+  }
+
+  mWriter = nullptr;
+}
+
+// @brief 論理ノードを出力する．
+void
+Iscas89Writer::write_node(
+  SizeType id
+)
+{
+  auto& node = mModel.node_impl(id);
+  auto& oname = mNameMgr.node_name(id);
+  auto ni = node.fanin_num();
+  mFaninNames.clear();
+  mFaninNames.reserve(ni);
+  for ( auto iid: node.fanin_id_list() ) {
+    mFaninNames.push_back(mNameMgr.node_name(iid));
+  }
+  mNotNames.clear();
+  mNotNames.resize(ni);
+
+  auto func_id = node.func_id();
+  auto& func = mModel.func_impl(func_id);
+  if ( func.is_primitive() ) {
+    auto primitive_type = func.primitive_type();
+    if ( primitive_type == PrimType::C0 || primitive_type == PrimType::C1 ) {
+      write_gate(gate_name(primitive_type), {}, oname);
+    }
+    else {
+      write_gate(gate_name(primitive_type), mFaninNames, oname);
+    }
+    return;
+  }
+
+  auto& info = func_info(func_id);
+  if ( info.is_mux ) {
+    std::vector<std::string> inputs;
+    inputs.reserve(ni);
+    for ( auto pos: info.mux_perm ) {
+      inputs.push_back(mFaninNames[pos]);
+    }
+    write_gate("MUX", inputs, oname);
+  }
+  else if ( func.is_expr() ) {
+    write_expr(func.expr(), oname);
+  }
+  else {
+    write_cubes(info.cube_list, info.output_inv, oname);
+  }
+}
+
+// @brief 関数の分解方法を返す．
+const Iscas89Writer::FuncInfo&
+Iscas89Writer::func_info(
+  SizeType func_id
+)
+{
+  auto& info = mFuncInfoArray[func_id];
+  if ( info.done ) {
+    return info;
+  }
+  info.done = true;
+
+  auto& func = mModel.func_impl(func_id);
+  auto ni = func.input_num();
+  if ( func.is_cover() ) {
+    auto& cover = func.input_cover();
+    auto nc = cover.cube_num();
+    info.cube_list.reserve(nc);
+    std::string pat(ni, '-');
+    for ( SizeType c = 0; c < nc; ++ c ) {
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	switch ( cover.get_pat(c, i) ) {
+	case SopPat::_X: pat[i] = '-'; break;
+	case SopPat::_0: pat[i] = '0'; break;
+	case SopPat::_1: pat[i] = '1'; break;
+	}
+      }
+      info.cube_list.push_back(pat);
+    }
+    info.output_inv = func.output_inv();
+  }
+  else if ( func.is_tvfunc() || func.is_bdd() ) {
+    TvFunc tvfunc;
+    if ( func.is_tvfunc() ) {
+      tvfunc = func.tvfunc();
+    }
+    else {
+      // サポート変数の順番がファンインの順番に対応している．
+      auto bdd = func.bdd();
+      tvfunc = bdd.to_truth(bdd.get_support_list());
+    }
+    // オンセットとオフセットのうちキューブ数の少ない方を用いる．
+    auto on_cubes = isop(tvfunc);
+    auto off_cubes = isop(~tvfunc);
+    if ( off_cubes.empty() || on_cubes.size() <= off_cubes.size() ) {
+      info.cube_list = std::move(on_cubes);
+      info.output_inv = false;
+    }
+    else {
+      info.cube_list = std::move(off_cubes);
+      info.output_inv = true;
+    }
+  }
+
+  // MUX になり得るのは 3 入力と 6 入力のみ
+  SizeType nc = 0;
+  if ( ni == 3 ) {
+    nc = 1;
+  }
+  else if ( ni == 6 ) {
+    nc = 2;
+  }
+  if ( nc > 0 ) {
+    std::vector<bool> table;
+    if ( func.is_expr() ) {
+      table = tvfunc_table(func.expr().tvfunc(ni));
+    }
+    else {
+      table = cubes_table(info.cube_list, info.output_inv, ni);
+    }
+    info.is_mux = match_mux(table, nc, info.mux_perm);
+  }
+  return info;
+}
+
+// @brief 積和形を出力する．
+void
+Iscas89Writer::write_cubes(
+  const std::vector<std::string>& cube_list,
+  bool output_inv,
+  const std::string& oname
+)
+{
+  if ( cube_list.empty() ) {
+    write_gate(output_inv ? "CONST1" : "CONST0", {}, oname);
+    return;
+  }
+
+  // キューブのリテラルの(ファンイン番号, 否定)のリストを作る．
+  auto nc = cube_list.size();
+  std::vector<std::vector<std::pair<SizeType, bool>>> lits_list(nc);
+  for ( SizeType c = 0; c < nc; ++ c ) {
+    auto& cube = cube_list[c];
+    for ( SizeType i = 0; i < cube.size(); ++ i ) {
+      if ( cube[i] != '-' ) {
+	lits_list[c].push_back({i, cube[i] == '0'});
+      }
+    }
+    if ( lits_list[c].empty() ) {
+      // 恒真のキューブを含む．
+      write_gate(output_inv ? "CONST0" : "CONST1", {}, oname);
+      return;
+    }
+  }
+
+  if ( nc == 1 ) {
+    auto& lits = lits_list[0];
+    if ( lits.size() == 1 ) {
+      auto pos = lits[0].first;
+      auto inv = lits[0].second != output_inv;
+      write_gate(inv ? "NOT" : "BUFF", {mFaninNames[pos]}, oname);
+      return;
+    }
+    std::vector<std::string> inputs;
+    inputs.reserve(lits.size());
+    for ( auto& lit: lits ) {
+      inputs.push_back(literal_name(lit.first, lit.second));
+    }
+    write_gate(output_inv ? "NAND" : "AND", inputs, oname);
+    return;
+  }
+
+  std::vector<std::string> terms;
+  terms.reserve(nc);
+  for ( auto& lits: lits_list ) {
+    if ( lits.size() == 1 ) {
+      terms.push_back(literal_name(lits[0].first, lits[0].second));
+    }
+    else {
+      std::vector<std::string> inputs;
+      inputs.reserve(lits.size());
+      for ( auto& lit: lits ) {
+	inputs.push_back(literal_name(lit.first, lit.second));
+      }
+      terms.push_back(write_gate("AND", inputs, {}));
+    }
+  }
+  write_gate(output_inv ? "NOR" : "OR", terms, oname);
+}
+
+// @brief 論理式を出力する．
+std::string
+Iscas89Writer::write_expr(
+  const Expr& expr,
+  const std::string& oname
+)
+{
+  if ( expr.is_zero() ) {
+    return write_gate("CONST0", {}, oname);
+  }
+  if ( expr.is_one() ) {
+    return write_gate("CONST1", {}, oname);
+  }
+  if ( expr.is_posi_literal() || expr.is_nega_literal() ) {
+    auto pos = expr.varid();
+    bool inv = expr.is_nega_literal();
+    if ( oname.empty() ) {
+      return literal_name(pos, inv);
+    }
+    return write_gate(inv ? "NOT" : "BUFF", {mFaninNames[pos]}, oname);
+  }
+
+  std::vector<std::string> inputs;
+  inputs.reserve(expr.operand_num());
+  for ( auto& opr: expr.operand_list() ) {
+    inputs.push_back(write_expr(opr, {}));
+  }
+  if ( expr.is_and() ) {
+    return write_gate("AND", inputs, oname);
+  }
+  if ( expr.is_or() ) {
+    return write_gate("OR", inputs, oname);
+  }
+  if ( expr.is_xor() ) {
+    return write_gate("XOR", inputs, oname);
+  }
+  throw std::logic_error{"Iscas89Writer: unexpected expression"};
+}
+
+// @brief リテラルの信号名を返す．
+const std::string&
+Iscas89Writer::literal_name(
+  SizeType pos,
+  bool inv
+)
+{
+  if ( !inv ) {
+    return mFaninNames[pos];
+  }
+  if ( mNotNames[pos].empty() ) {
+    mNotNames[pos] = write_gate("NOT", {mFaninNames[pos]}, {});
+  }
+  return mNotNames[pos];
+}
+
+// @brief ゲートを1つ出力する．
+std::string
+Iscas89Writer::write_gate(
+  const char* gate_name,
+  const std::vector<std::string>& inputs,
+  const std::string& oname
+)
+{
+  auto name = oname.empty() ? mNameMgr.new_name(mNameCount ++) : oname;
+  auto& w = *mWriter;
+  w.put(name);
+  w.put(" = ");
+  w.put(gate_name);
+  w.put('(');
+  const char* comma = "";
+  for ( auto& iname: inputs ) {
+    w.put(comma);
+    w.put(iname);
+    comma = ", ";
+  }
+  w.put(")\n");
+  return name;
+}
+
+END_NAMESPACE_YM_BN
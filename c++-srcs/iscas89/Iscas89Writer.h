@@ -0,0 +1,175 @@
+#ifndef ISCAS89WRITER_H
+#define ISCAS89WRITER_H
+
+/// @file Iscas89Writer.h
+/// @brief Iscas89Writer のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ModelImpl.h"
+#include "NameMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class BufWriter;
+
+//////////////////////////////////////////////////////////////////////
+/// @class Iscas89Writer Iscas89Writer.h "Iscas89Writer.h"
+/// @brief BnModel を iscas89(.bench) 形式で出力するクラス
+///
+/// プリミティブ型の論理ノードはそのまま1つのゲートになる．
+/// それ以外の関数は以下のようにプリミティブゲートに分解する．
+/// - MUX 型の関数(ファンインの並べ替えを含む)は MUX ゲートにする．
+/// - カバー型: キューブごとの AND の OR(NOR) にする．
+/// - 論理式型: 演算子ごとにゲートにする．
+/// - 真理値表/BDD: 非冗長積和形を求めてカバーと同様に分解する．
+/// 定数は CONST0/CONST1 ゲートになる．
+///
+/// 分解に用いる関数の解析結果は関数番号ごとにキャッシュする．
+/// DFF のリセット値は出力されない．
+//////////////////////////////////////////////////////////////////////
+class Iscas89Writer
+{
+public:
+
+  /// @brief コンストラクタ
+  Iscas89Writer(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief デストラクタ
+  ~Iscas89Writer() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief iscas89 形式で出力する．
+  void
+  write(
+    std::ostream& s ///< [in] 出力先のストリーム
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  // 関数ごとの分解方法
+  struct FuncInfo
+  {
+    // 解析済みの時 true
+    bool done{false};
+
+    // MUX の時 true
+    bool is_mux{false};
+
+    // MUX の引数に対応するファンイン番号のリスト
+    std::vector<SizeType> mux_perm;
+
+    // 積和形のキューブのリスト
+    std::vector<std::string> cube_list;
+
+    // 出力の反転属性
+    bool output_inv{false};
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 論理ノードを出力する．
+  void
+  write_node(
+    SizeType id ///< [in] ノード番号
+  );
+
+  /// @brief 関数の分解方法を返す．
+  ///
+  /// 結果はキャッシュされる．
+  const FuncInfo&
+  func_info(
+    SizeType func_id ///< [in] 関数番号
+  );
+
+  /// @brief 積和形を出力する．
+  void
+  write_cubes(
+    const std::vector<std::string>& cube_list, ///< [in] キューブのリスト
+    bool output_inv,                           ///< [in] 出力の反転属性
+    const std::string& oname                   ///< [in] 出力名
+  );
+
+  /// @brief 論理式を出力する．
+  /// @return 出力の信号名を返す．
+  ///
+  /// oname が空の場合は名前を生成する．
+  /// リテラルの場合はゲートを作らずにその信号名を返す．
+  std::string
+  write_expr(
+    const Expr& expr,        ///< [in] 論理式
+    const std::string& oname ///< [in] 出力名
+  );
+
+  /// @brief リテラルの信号名を返す．
+  ///
+  /// 否定のリテラルの場合は NOT ゲートを(1度だけ)出力する．
+  const std::string&
+  literal_name(
+    SizeType pos, ///< [in] ファンイン番号
+    bool inv      ///< [in] 否定の時 true
+  );
+
+  /// @brief ゲートを1つ出力する．
+  /// @return 出力の信号名を返す．
+  ///
+  /// oname が空の場合は名前を生成する．
+  std::string
+  write_gate(
+    const char* gate_name,                   ///< [in] ゲート名
+    const std::vector<std::string>& inputs,  ///< [in] 入力の信号名のリスト
+    const std::string& oname                 ///< [in] 出力名
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のモデル
+  const ModelImpl& mModel;
+
+  // ノード名の管理
+  NameMgr mNameMgr;
+
+  // 関数番号をキーにして分解方法を格納する配列
+  std::vector<FuncInfo> mFuncInfoArray;
+
+  // 生成する名前の番号
+  SizeType mNameCount;
+
+  // 出力先(write() の実行中のみ有効)
+  BufWriter* mWriter{nullptr};
+
+  // 処理中のノードのファンインの信号名のリスト
+  std::vector<std::string> mFaninNames;
+
+  // 処理中のノードのファンインの否定の信号名のリスト
+  std::vector<std::string> mNotNames;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // ISCAS89WRITER_H
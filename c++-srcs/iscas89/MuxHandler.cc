@@ -8,7 +8,7 @@
 
 #include "MuxHandler.h"
 #include "ym/Expr.h"
-#include "ym/MsgMgr.h"
+#include "MsgQueue.h"
 
 
 BEGIN_NAMESPACE_YM_ISCAS89
@@ -39,10 +39,10 @@ MuxHandler::read(
     ostringstream buf;
     auto oname = id2str(oname_id);
     buf << oname << ": Wrong # of inputs for MUX-type.";
-    MsgMgr::put_msg(__FILE__, __LINE__, loc,
-		    MsgType::Error,
-		    "ER_MUX01",
-		    buf.str());
+    MsgQueue::output(__FILE__, __LINE__, loc,
+		     MsgType::Error,
+		     "ER_MUX01",
+		     buf.str());
     return false;
   }
 
@@ -7,10 +7,13 @@
 /// All rights reserved.
 
 #include <gtest/gtest.h>
-#include "ym/BnModel.h"
+#include "ym/JsonValue.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include "BnTestUtil.h"
 
 
-BEGIN_NAMESPACE_YM
+BEGIN_NAMESPACE_YM_BN
 
 TEST( BnModelTest, read_iscas1 )
 {
@@ -42,4 +45,64 @@ TEST( BnModelTest, read_iscas1 )
   EXPECT_EQ( ref_contents, s1.str() );
 }
 
-END_NAMESPACE_YM
+TEST( BnModelTest, read_iscas_nommap )
+{
+  // mmap() を用いない読み込みテスト
+  auto filename = std::string{"b10.bench"};
+  auto path = DATAPATH + filename;
+  auto model0 = BnModel::read_iscas89(path);
+  auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+      {"mmap", JsonValue{false}}}};
+  auto model = BnModel::read_iscas89(path, option);
+
+  std::ostringstream s0;
+  model0.print(s0);
+  std::ostringstream s1;
+  model.print(s1);
+  EXPECT_EQ( s0.str(), s1.str() );
+}
+
+TEST( BnModelTest, read_iscas_notrack )
+{
+  // 位置情報を記録しない読み込みテスト
+  auto filename = std::string{"b10.bench"};
+  auto path = DATAPATH + filename;
+  auto model0 = BnModel::read_iscas89(path);
+  auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+      {"track_location", JsonValue{false}}}};
+  auto model = BnModel::read_iscas89(path, option);
+
+  std::ostringstream s0;
+  model0.print(s0);
+  std::ostringstream s1;
+  model.print(s1);
+  EXPECT_EQ( s0.str(), s1.str() );
+}
+
+TEST( BnModelTest, read_iscas_notrack_error )
+{
+  // 位置情報を記録しない場合もエラーメッセージが同一になるかのテスト
+  for ( auto body: {"a = AND(x, b)\n",
+		    "a = NOT(x)\na = NOT(x)\n"} ) {
+    auto path = make_file("notrack_error.bench",
+			  std::string{"INPUT(x)\n"
+				      "OUTPUT(a)\n"} + body);
+    std::string msg[2];
+    for ( int i = 0; i < 2; ++ i ) {
+      auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+	  {"track_location", JsonValue{i == 0}}}};
+      std::ostringstream msg_buf;
+      StreamMsgHandler msg_handler(msg_buf);
+      MsgMgr::attach_handler(&msg_handler);
+      EXPECT_THROW( {
+	  auto _ = BnModel::read_iscas89(path, option);
+	}, std::invalid_argument );
+      MsgMgr::detach_handler(&msg_handler);
+      msg[i] = msg_buf.str();
+    }
+    EXPECT_FALSE( msg[0].empty() );
+    EXPECT_EQ( msg[0], msg[1] );
+  }
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,166 @@
+
+/// @file write_iscas89_test.cc
+/// @brief write_iscas89_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// ゲート名を含む行の数を数える．
+SizeType
+count_gate(
+  const std::string& contents,
+  const std::string& gate_name
+)
+{
+  SizeType n = 0;
+  auto key = " = " + gate_name + "(";
+  for ( auto pos = contents.find(key); pos != std::string::npos;
+	pos = contents.find(key, pos + 1) ) {
+    ++ n;
+  }
+  return n;
+}
+
+END_NONAMESPACE
+
+TEST( BnModelTest, write_iscas89_b10 )
+{
+  auto path = std::string{DATAPATH} + "b10.bench";
+  auto model = BnModel::read_iscas89(path);
+  std::string contents;
+  auto model2 = round_trip(model, "iscas89", "b10.bench", contents);
+
+  // プリミティブゲートはそのまま出力される．
+  EXPECT_EQ( model.logic_num(), model2.logic_num() );
+  // iscas89 形式はリセット値を持たない．
+  check_equiv(model, model2, false);
+}
+
+TEST( BnModelTest, write_iscas89_funcs )
+{
+  // 色々な種類の関数を含むモデル
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto c = model.new_input("c");
+  auto dff0 = model.new_dff("q0");
+  auto q0 = dff0.output();
+
+  auto n1 = model.new_primitive(PrimType::Xor, {a, b, c});
+  // a b' + c q0'
+  SopCover cover{4, {{Literal{0, false}, Literal{1, true}},
+		     {Literal{2, false}, Literal{3, true}}}};
+  auto n2 = model.new_cover(cover, true, {a, b, c, q0});
+  // 否定リテラル1つのカバー
+  SopCover cover1{2, {{Literal{1, true}}}};
+  auto n3 = model.new_cover(cover1, false, {n1, n2});
+  auto expr = (Expr::literal(0) & ~Expr::literal(1)) | (Expr::literal(2) ^ Expr::literal(0));
+  auto n4 = model.new_expr(expr, {n1, n2, n3});
+  // 多数決関数
+  TvFunc maj{"11101000"};
+  auto n5 = model.new_tvfunc(maj, {n4, q0, b});
+  // オンセットの方が大きい真理値表
+  TvFunc f6{"11111110"};
+  auto n6 = model.new_tvfunc(f6, {n4, n5, a});
+  auto n7 = model.new_primitive(PrimType::C0, {});
+  TvFunc one{"1111"};
+  auto n8 = model.new_tvfunc(one, {a, b});
+
+  model.set_dff_src(dff0, n5);
+  model.new_output(n4, "o1");
+  model.new_output(n6, "o2");
+  model.new_output(a, "o3");
+  model.new_output(n7, "o4");
+  model.new_output(n8, "o5");
+  model.wrap_up();
+
+  std::string contents;
+  auto model2 = round_trip(model, "iscas89", "funcs.bench", contents);
+  check_equiv(model, model2, false);
+  EXPECT_EQ( 1, count_gate(contents, "CONST0") );
+  EXPECT_EQ( 1, count_gate(contents, "CONST1") );
+}
+
+TEST( BnModelTest, write_iscas89_mux )
+{
+  // ファンインの順番が入れ替わった MUX
+  BnModel model;
+  auto d1 = model.new_input("d1");
+  auto s = model.new_input("s");
+  auto d0 = model.new_input("d0");
+  // f = s' d0 + s d1 (入力は d1, s, d0 の順)
+  auto expr = (~Expr::literal(1) & Expr::literal(2)) | (Expr::literal(1) & Expr::literal(0));
+  auto n1 = model.new_expr(expr, {d1, s, d0});
+  // 同じ関数の真理値表型(変数0が d1, 1 が s, 2 が d0)
+  std::string tv_str;
+  for ( int p = 7; p >= 0; -- p ) {
+    bool vd1 = p & 1;
+    bool vs = (p >> 1) & 1;
+    bool vd0 = (p >> 2) & 1;
+    tv_str += (vs ? vd1 : vd0) ? '1' : '0';
+  }
+  auto n2 = model.new_tvfunc(TvFunc{tv_str}, {d1, s, d0});
+  model.new_output(n1, "o1");
+  model.new_output(n2, "o2");
+  model.wrap_up();
+
+  std::string contents;
+  auto model2 = round_trip(model, "iscas89", "mux.bench", contents);
+  check_equiv(model, model2, false);
+  EXPECT_EQ( 2, count_gate(contents, "MUX") );
+  EXPECT_NE( std::string::npos, contents.find("o1 = MUX(s, d0, d1)") );
+}
+
+TEST( BnModelTest, read_iscas89_mux )
+{
+  // 制御入力2つの MUX
+  auto path = make_file("mux4.bench",
+			"INPUT(s0)\n"
+			"INPUT(s1)\n"
+			"INPUT(d0)\n"
+			"INPUT(d1)\n"
+			"INPUT(d2)\n"
+			"INPUT(d3)\n"
+			"OUTPUT(o)\n"
+			"o = MUX(s0, s1, d0, d1, d2, d3)\n");
+  auto model = BnModel::read_iscas89(path);
+  ASSERT_EQ( 1, model.output_num() );
+  std::vector<bool> ivals(6);
+  for ( SizeType p = 0; p < 64; ++ p ) {
+    for ( SizeType i = 0; i < 6; ++ i ) {
+      ivals[i] = (p >> i) & 1;
+    }
+    SizeType sel = p & 3;
+    EXPECT_EQ( std::vector<bool>{ivals[2 + sel]}, simulate(model, ivals) );
+  }
+}
+
+TEST( BnModelTest, read_iscas89_bad_mux )
+{
+  auto path = make_file("bad_mux.bench",
+			"INPUT(s0)\n"
+			"INPUT(d0)\n"
+			"OUTPUT(o)\n"
+			"o = MUX(s0, d0)\n");
+  EXPECT_THROW( BnModel::read_iscas89(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, write_iscas89_bad_file )
+{
+  BnModel model;
+  model.new_output(model.new_input("a"), "b");
+  model.wrap_up();
+  EXPECT_THROW( model.write_iscas89("/nonexistent/dir/foo.bench"),
+		std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
@@ -9,6 +9,7 @@
 #include "ym/BnBase.h"
 #include "ym/BnDff.h"
 #include "ym/BnNode.h"
+#include "ym/BnNodeRef.h"
 #include "ym/BnFunc.h"
 #include "ModelImpl.h"
 
@@ -75,7 +76,7 @@ BnBase::_id2node(
 // @brief ノード番号のリストを BnNode のリストに変換する．
 std::vector<BnNode>
 BnBase::_id2node_list(
-  const std::vector<SizeType>& id_list
+  BnIdSpan id_list
 ) const
 {
   std::vector<BnNode> node_list;
@@ -86,6 +87,27 @@ BnBase::_id2node_list(
   return node_list;
 }
 
+// @brief ノード番号を BnNodeRef に変換する．
+BnNodeRef
+BnBase::_id2ref(
+  SizeType id
+) const
+{
+  if ( id >= mImpl->node_num() ) {
+    throw std::out_of_range{"id is out of range"};
+  }
+  return BnNodeRef{mImpl.get(), id};
+}
+
+// @brief ノード番号のリストを BnNodeRefList に変換する．
+BnNodeRefList
+BnBase::_id2ref_list(
+  BnIdSpan id_list
+) const
+{
+  return BnNodeRefList{mImpl.get(), id_list};
+}
+
 // @brief BnNode をノード番号に変換する．
 SizeType
 BnBase::_node2id(
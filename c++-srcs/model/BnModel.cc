@@ -150,6 +150,57 @@ BnModel::logic_list() const
   return _id2node_list(_model_impl().logic_id_list());
 }
 
+// @brief ノードの借用参照を返す．
+BnNodeRef
+BnModel::node_ref(
+  SizeType id
+) const
+{
+  return _id2ref(id);
+}
+
+// @brief 入力ノードのノード番号のリストを返す．
+BnIdSpan
+BnModel::input_id_list() const
+{
+  return _model_impl().input_id_list();
+}
+
+// @brief 入力ノードの借用参照のリストを返す．
+BnNodeRefList
+BnModel::input_ref_list() const
+{
+  return _id2ref_list(_model_impl().input_id_list());
+}
+
+// @brief 出力ノードのノード番号のリストを返す．
+BnIdSpan
+BnModel::output_id_list() const
+{
+  return _model_impl().output_id_list();
+}
+
+// @brief 出力ノードの借用参照のリストを返す．
+BnNodeRefList
+BnModel::output_ref_list() const
+{
+  return _id2ref_list(_model_impl().output_id_list());
+}
+
+// @brief 論理ノードのノード番号のリストを返す．
+BnIdSpan
+BnModel::logic_id_list() const
+{
+  return _model_impl().logic_id_list();
+}
+
+// @brief 論理ノードの借用参照のリストを返す．
+BnNodeRefList
+BnModel::logic_ref_list() const
+{
+  return _id2ref_list(_model_impl().logic_id_list());
+}
+
 // @brief 関数情報の数を返す．
 SizeType
 BnModel::func_num() const
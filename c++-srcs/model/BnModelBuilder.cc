@@ -0,0 +1,249 @@
+
+/// @file BnModelBuilder.cc
+/// @brief BnModelBuilder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModelBuilder.h"
+#include "ModelImpl.h"
+#include "CellFuncMap.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnModelBuilder
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BnModelBuilder::BnModelBuilder(
+) : mImpl{new ModelImpl}
+{
+}
+
+// @brief デストラクタ
+BnModelBuilder::~BnModelBuilder()
+{
+}
+
+// @brief ノード用の領域を予約する．
+void
+BnModelBuilder::reserve(
+  SizeType node_num
+)
+{
+  mImpl->reserve(node_num);
+}
+
+// @brief 現在のノード数を返す．
+SizeType
+BnModelBuilder::node_num() const
+{
+  return mImpl->node_num();
+}
+
+// @brief 設定情報を確定して BnModel を返す．
+BnModel
+BnModelBuilder::wrap_up()
+{
+  mImpl->make_logic_list();
+  auto impl = mImpl.release();
+  mImpl.reset(new ModelImpl);
+  mCellFuncMap.reset();
+  return BnModel{impl};
+}
+
+// @brief プリミティブ型の関数を登録する．
+SizeType
+BnModelBuilder::reg_primitive(
+  SizeType input_num,
+  PrimType primitive_type
+)
+{
+  return mImpl->reg_primitive(input_num, primitive_type);
+}
+
+// @brief カバー型の関数を登録する．
+SizeType
+BnModelBuilder::reg_cover(
+  const SopCover& input_cover,
+  bool output_inv
+)
+{
+  return mImpl->reg_cover(input_cover, output_inv);
+}
+
+// @brief 論理式型の関数を登録する．
+SizeType
+BnModelBuilder::reg_expr(
+  const Expr& expr
+)
+{
+  return mImpl->reg_expr(expr);
+}
+
+// @brief 真理値表型の関数を登録する．
+SizeType
+BnModelBuilder::reg_tvfunc(
+  const TvFunc& func
+)
+{
+  return mImpl->reg_tvfunc(func);
+}
+
+// @brief BDD型の関数を登録する．
+SizeType
+BnModelBuilder::reg_bdd(
+  const Bdd& bdd
+)
+{
+  return mImpl->reg_bdd(bdd);
+}
+
+// @brief セルの論理関数を登録する．
+SizeType
+BnModelBuilder::reg_cell(
+  const BnCellLibrary& library,
+  SizeType cell_id
+)
+{
+  if ( mCellFuncMap.get() == nullptr || mCellFuncMap->library() != library ) {
+    mCellFuncMap.reset(new CellFuncMap{library});
+  }
+  return (*mCellFuncMap)(*mImpl, cell_id);
+}
+
+// @brief 入力ノードを作る．
+SizeType
+BnModelBuilder::new_input(
+  const std::string& name
+)
+{
+  return mImpl->new_input(name);
+}
+
+// @brief DFFを作る．
+SizeType
+BnModelBuilder::new_dff(
+  const std::string& name,
+  char reset_val
+)
+{
+  auto dff_id = mImpl->new_dff(name, reset_val);
+  mImpl->new_dff_output(dff_id);
+  return dff_id;
+}
+
+// @brief DFFの出力ノードのノード番号を返す．
+SizeType
+BnModelBuilder::dff_output_id(
+  SizeType dff_id
+) const
+{
+  if ( dff_id >= mImpl->dff_num() ) {
+    throw std::out_of_range{"'dff_id' is out of range"};
+  }
+  return mImpl->dff_impl(dff_id).id;
+}
+
+// @brief DFFの入力ノードを設定する．
+void
+BnModelBuilder::set_dff_src(
+  SizeType dff_id,
+  SizeType src_id
+)
+{
+  _check_node_id(src_id, "src_id");
+  mImpl->set_dff_src(dff_id, src_id);
+}
+
+// @brief 出力を作る．
+SizeType
+BnModelBuilder::new_output(
+  SizeType src_id,
+  const std::string& name
+)
+{
+  _check_node_id(src_id, "src_id");
+  return mImpl->new_output(src_id, name);
+}
+
+// @brief 論理ノードを作る．
+SizeType
+BnModelBuilder::new_logic(
+  SizeType func_id,
+  const SizeType* fanin_begin,
+  const SizeType* fanin_end
+)
+{
+  _check_func_id(func_id);
+  std::vector<BnIdType> fanin_list;
+  fanin_list.reserve(fanin_end - fanin_begin);
+  for ( auto p = fanin_begin; p != fanin_end; ++ p ) {
+    _check_node_id(*p, "fanin_id");
+    fanin_list.push_back(*p);
+  }
+  return mImpl->new_logic(func_id, std::move(fanin_list));
+}
+
+// @brief 論理ノードを作る．
+SizeType
+BnModelBuilder::new_logic(
+  SizeType func_id,
+  std::vector<SizeType>&& fanin_list
+)
+{
+  _check_func_id(func_id);
+  for ( auto id: fanin_list ) {
+    _check_node_id(id, "fanin_id");
+  }
+#if defined(YM_BN_COMPACT_ID)
+  // 格納形式が異なるので変換する必要がある．
+  return new_logic(func_id, fanin_list.data(),
+		   fanin_list.data() + fanin_list.size());
+#else
+  return mImpl->new_logic(func_id, std::move(fanin_list));
+#endif
+}
+
+// @brief ノード名を設定する．
+void
+BnModelBuilder::set_node_name(
+  SizeType id,
+  const std::string& name
+)
+{
+  _check_node_id(id, "id");
+  mImpl->set_node_name(id, name);
+}
+
+// @brief ノード番号のチェックを行う．
+void
+BnModelBuilder::_check_node_id(
+  SizeType id,
+  const char* index_name
+) const
+{
+  if ( id >= mImpl->node_num() ) {
+    std::ostringstream buf;
+    buf << "'" << index_name << "'(" << id << ") is out of range";
+    throw std::out_of_range{buf.str()};
+  }
+}
+
+// @brief 関数番号のチェックを行う．
+void
+BnModelBuilder::_check_func_id(
+  SizeType func_id
+) const
+{
+  if ( func_id >= mImpl->func_num() ) {
+    std::ostringstream buf;
+    buf << "'func_id'(" << func_id << ") is out of range";
+    throw std::out_of_range{buf.str()};
+  }
+}
+
+END_NAMESPACE_YM_BN
@@ -22,6 +22,7 @@ BEGIN_NAMESPACE_YM_BN
 void
 BnModel::clear()
 {
+  _check_mutable("clear");
   _model_impl().clear();
 }
 
@@ -29,15 +30,84 @@ BnModel::clear()
 void
 BnModel::wrap_up()
 {
+  if ( is_frozen() ) {
+    return;
+  }
   _model_impl().make_logic_list();
 }
 
+// @brief 凍結する．
+void
+BnModel::freeze()
+{
+  _model_impl().freeze();
+}
+
+// @brief 凍結されている時 true を返す．
+bool
+BnModel::is_frozen() const
+{
+  return _model_impl().is_frozen();
+}
+
+// @brief 最大レベルを返す．
+SizeType
+BnModel::depth() const
+{
+  return _model_impl().depth();
+}
+
+// @brief 構造ハッシュのモードを設定する．
+void
+BnModel::set_strash(
+  bool strash
+)
+{
+  _check_mutable("set_strash");
+  _model_impl().set_strash(strash);
+}
+
+// @brief 構造ハッシュのモードの時 true を返す．
+bool
+BnModel::strash() const
+{
+  return _model_impl().strash();
+}
+
+// @brief 凍結されていないかチェックする．
+void
+BnModel::_check_mutable(
+  const char* func_name
+) const
+{
+  if ( is_frozen() ) {
+    std::ostringstream buf;
+    buf << "BnModel::" << func_name << "(): model is frozen";
+    throw std::logic_error{buf.str()};
+  }
+}
+
+// @brief 読み込み時のオプションを適用する．
+void
+BnModel::_set_read_option(
+  const JsonValue& option
+)
+{
+  if ( !option.is_object() ) {
+    return;
+  }
+  if ( option.has_key("strash") ) {
+    set_strash(option.at("strash").get_bool());
+  }
+}
+
 // @brief オプション情報をセットする．
 void
 BnModel::set_option(
   const JsonValue& option
 )
 {
+  _check_mutable("set_option");
   _model_impl().set_option(option);
 }
 
@@ -48,6 +118,7 @@ BnModel::new_dff(
   char reset_val
 )
 {
+  _check_mutable("new_dff");
   auto dff_id = _model_impl().new_dff(name, reset_val);
   _model_impl().new_dff_output(dff_id);
   return _id2dff(dff_id);
@@ -60,6 +131,7 @@ BnModel::set_dff_src(
   BnNode src
 )
 {
+  _check_mutable("set_dff_src");
   _check_dff(dff);
   _check_node(src);
   _model_impl().set_dff_src(dff.id(), src.id());
@@ -71,6 +143,7 @@ BnModel::new_input(
   const std::string& name
 )
 {
+  _check_mutable("new_input");
   auto id = _model_impl().new_input(name);
   auto node = _id2node(id);
   return node;
@@ -83,6 +156,7 @@ BnModel::new_output(
   const std::string& name
 )
 {
+  _check_mutable("new_output");
   _check_node(src);
   auto oid = _model_impl().new_output(src.id(), name);
   return oid;
@@ -95,6 +169,7 @@ BnModel::new_primitive(
   const std::vector<BnNode>& fanin_list
 )
 {
+  _check_mutable("new_primitive");
   auto input_num = fanin_list.size();
   auto func_id = _model_impl().reg_primitive(input_num, primitive_type);
   auto fanin_id_list = _node2id_list(fanin_list);
@@ -110,6 +185,7 @@ BnModel::new_cover(
   const std::vector<BnNode>& fanin_list
 )
 {
+  _check_mutable("new_cover");
   auto func_id = _model_impl().reg_cover(input_cover, output_inv);
   auto fanin_id_list = _node2id_list(fanin_list);
   auto id = _model_impl().new_logic(func_id, fanin_id_list);
@@ -123,6 +199,7 @@ BnModel::new_expr(
   const std::vector<BnNode>& fanin_list
 )
 {
+  _check_mutable("new_expr");
   auto func_id = _model_impl().reg_expr(expr);
   auto fanin_id_list = _node2id_list(fanin_list);
   auto id = _model_impl().new_logic(func_id, fanin_id_list);
@@ -136,6 +213,7 @@ BnModel::new_tvfunc(
   const std::vector<BnNode>& fanin_list
 )
 {
+  _check_mutable("new_tvfunc");
   auto func_id = _model_impl().reg_tvfunc(func);
   auto fanin_id_list = _node2id_list(fanin_list);
   auto id = _model_impl().new_logic(func_id, fanin_id_list);
@@ -149,6 +227,7 @@ BnModel::new_bdd(
   const std::vector<BnNode>& fanin_list
 )
 {
+  _check_mutable("new_bdd");
   auto func_id = _model_impl().reg_bdd(bdd);
   auto fanin_id_list = _node2id_list(fanin_list);
   auto id = _model_impl().new_logic(func_id, fanin_id_list);
@@ -0,0 +1,380 @@
+
+/// @file BnModel_read.cc
+/// @brief BnModel::read() と read_many() の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModel.h"
+#include "ym/BnProgress.h"
+#include "MsgQueue.h"
+#include "Decompressor.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 内容から形式を判定する際に読み込むバイト数
+const SizeType SNIFF_SIZE = 4096;
+
+// 拡張子から形式を判定する．
+//
+// 判定できない場合は空文字列を返す．
+std::string
+format_from_ext(
+  const std::string& filename
+)
+{
+  // 圧縮形式の拡張子は取り除く．
+  auto name = filename;
+  std::string ext;
+  for ( ; ; ) {
+    auto pos = name.find_last_of("./");
+    if ( pos == std::string::npos || name[pos] != '.' ) {
+      return {};
+    }
+    ext.clear();
+    for ( auto c: name.substr(pos + 1) ) {
+      ext += static_cast<char>(tolower(c));
+    }
+    if ( ext != "gz" && ext != "xz" && ext != "zst" ) {
+      break;
+    }
+    name = name.substr(0, pos);
+  }
+  if ( ext == "blif" ) {
+    return "blif";
+  }
+  if ( ext == "bench" || ext == "iscas89" ) {
+    return "iscas89";
+  }
+  if ( ext == "aag" || ext == "aig" || ext == "truth" ) {
+    return ext;
+  }
+  if ( ext == "v" ) {
+    return "verilog";
+  }
+  return {};
+}
+
+// 1行が 0 と 1 のみからなる時 true を返す．
+bool
+is_truth_line(
+  const std::string_view& line
+)
+{
+  if ( line.empty() ) {
+    return false;
+  }
+  for ( auto c: line ) {
+    if ( c != '0' && c != '1' ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ファイルの先頭部分の内容から形式を判定する．
+//
+// 判定できない場合は空文字列を返す．
+std::string
+format_from_content(
+  const std::string& filename
+)
+{
+  std::ifstream s{filename, std::ios::binary};
+  if ( !s ) {
+    return {};
+  }
+  std::string buf(SNIFF_SIZE, '\0');
+  s.read(buf.data(), buf.size());
+  buf.resize(s.gcount());
+  auto type = Decompressor::detect(buf.data(), buf.size());
+  if ( type != Decompressor::None ) {
+    // 圧縮されている場合は先頭部分のみを展開する．
+    s.clear();
+    s.seekg(0);
+    buf.clear();
+    try {
+      Decompressor::read(s, type, filename, buf, SNIFF_SIZE);
+    }
+    catch ( std::invalid_argument& ) {
+      return {};
+    }
+  }
+  if ( buf.size() < SNIFF_SIZE ) {
+    // ファイル全体を読み込んだので最後の行も用いる．
+    buf += '\n';
+  }
+
+  if ( buf.compare(0, 4, "aag ") == 0 ) {
+    return "aag";
+  }
+  if ( buf.compare(0, 4, "aig ") == 0 ) {
+    return "aig";
+  }
+
+  // 空行とコメントを読み飛ばして最初の単語で判定する．
+  // 最後の行は途中で切れている可能性があるので用いない．
+  std::string_view content{buf};
+  SizeType truth_lines = 0;
+  bool in_comment = false;
+  for ( SizeType pos = 0; pos < content.size(); ) {
+    auto nl = content.find('\n', pos);
+    if ( nl == std::string_view::npos ) {
+      break;
+    }
+    auto line = content.substr(pos, nl - pos);
+    pos = nl + 1;
+    if ( !line.empty() && line.back() == '\r' ) {
+      line.remove_suffix(1);
+    }
+    if ( in_comment ) {
+      auto end = line.find("*/");
+      if ( end == std::string_view::npos ) {
+	continue;
+      }
+      in_comment = false;
+      line = line.substr(end + 2);
+    }
+    auto start = line.find_first_not_of(" \t");
+    if ( start == std::string_view::npos ) {
+      continue;
+    }
+    line = line.substr(start);
+    if ( line[0] == '#' || line.compare(0, 2, "//") == 0 ) {
+      continue;
+    }
+    if ( line.compare(0, 2, "/*") == 0 ) {
+      if ( line.find("*/", 2) == std::string_view::npos ) {
+	in_comment = true;
+      }
+      continue;
+    }
+    if ( is_truth_line(line) ) {
+      ++ truth_lines;
+      continue;
+    }
+    if ( line[0] == '.' ) {
+      return "blif";
+    }
+    if ( line.compare(0, 6, "module") == 0 ) {
+      return "verilog";
+    }
+    if ( line.compare(0, 5, "INPUT") == 0 ||
+	 line.compare(0, 6, "OUTPUT") == 0 ||
+	 line.find('=') != std::string_view::npos ) {
+      return "iscas89";
+    }
+    return {};
+  }
+  if ( truth_lines > 0 ) {
+    return "truth";
+  }
+  return {};
+}
+
+// 1つのファイルを読み込んで結果を result に格納する．
+//
+// 読み込みのエラーは result に記録する．
+// 中断された場合と callback が例外を送出した場合はその例外をそのまま送出する．
+void
+read_one(
+  const std::string& filename,
+  const std::string& format,
+  const JsonValue& option,
+  BnReadResult& result
+)
+{
+  result.filename = filename;
+  result.format = format;
+  try {
+    if ( format == "auto" ) {
+      result.format = BnModel::detect_format(filename);
+    }
+    // 判定できなかった場合は BnModel::read() が例外を送出する．
+    auto format1 = result.format.empty() ? format : result.format;
+    result.model = BnModel::read(filename, format1, option);
+    result.ok = true;
+  }
+  catch ( BnCanceled& ) {
+    throw;
+  }
+  catch ( std::exception& e ) {
+    auto scope = BnProgressScope::current();
+    if ( scope != nullptr && scope->callback_failed() ) {
+      throw;
+    }
+    result.ok = false;
+    result.error = e.what();
+  }
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief 形式を指定してファイルの読み込みを行う．
+BnModel
+BnModel::read(
+  const std::string& filename,
+  const std::string& format,
+  const JsonValue& option
+)
+{
+  auto format1 = format;
+  if ( format1 == "auto" ) {
+    format1 = detect_format(filename);
+    if ( format1.empty() ) {
+      std::ostringstream buf;
+      buf << "BnModel::read(\"" << filename << "\"): "
+	  << "cannot detect the file format.";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+  if ( format1 == "blif" ) {
+    return read_blif(filename, option);
+  }
+  if ( format1 == "iscas89" ) {
+    return read_iscas89(filename, option);
+  }
+  if ( format1 == "aag" ) {
+    return read_aag(filename, option);
+  }
+  if ( format1 == "aig" ) {
+    return read_aig(filename, option);
+  }
+  if ( format1 == "truth" ) {
+    return read_truth(filename, option);
+  }
+  if ( format1 == "verilog" ) {
+    return read_verilog(filename, option);
+  }
+  std::ostringstream buf;
+  buf << "BnModel::read(\"" << filename << "\"): "
+      << format << ": unknown format.";
+  throw std::invalid_argument{buf.str()};
+}
+
+// @brief 複数のファイルを並列に読み込む．
+std::vector<BnReadResult>
+BnModel::read_many(
+  const std::vector<std::string>& filename_list,
+  const std::string& format,
+  SizeType thread_num,
+  const JsonValue& option
+)
+{
+  auto n = filename_list.size();
+  std::vector<BnReadResult> result_list(n);
+  auto scope = BnProgressScope::current();
+  if ( scope != nullptr ) {
+    scope->_clear_callback_failed();
+  }
+  if ( thread_num == 0 ) {
+    thread_num = std::thread::hardware_concurrency();
+  }
+  auto nt = std::min(thread_num, n);
+  if ( nt <= 1 ) {
+    for ( SizeType i = 0; i < n; ++ i ) {
+      read_one(filename_list[i], format, option, result_list[i]);
+    }
+    return result_list;
+  }
+
+  // 各スレッドは次に読むファイルの番号を取り出して読み込む．
+  // メッセージはファイルごとの MsgQueue に溜めておき，
+  // このスレッドで入力の順番に出力する．
+  // 進捗の通知先はこのスレッドのものを引き継ぐ．
+  // 中断などの例外は最初のものを error に記録して残りの読み込みを打ち切り，
+  // 全てのスレッドが終了してからこのスレッドで送出する．
+  std::vector<MsgQueue> queue_list(n);
+  std::vector<bool> done_list(n, false);
+  std::atomic<SizeType> next{0};
+  std::exception_ptr error;
+  bool abort = false;
+  std::mutex mtx;
+  std::condition_variable cv;
+  auto worker = [&]() {
+    BnProgressScope::_set_current(scope);
+    for ( ; ; ) {
+      auto i = next ++;
+      if ( i >= n ) {
+	break;
+      }
+      auto old_queue = MsgQueue::set_thread_queue(&queue_list[i]);
+      std::exception_ptr error1;
+      try {
+	read_one(filename_list[i], format, option, result_list[i]);
+      }
+      catch ( ... ) {
+	error1 = std::current_exception();
+      }
+      MsgQueue::set_thread_queue(old_queue);
+      {
+	std::lock_guard<std::mutex> lock{mtx};
+	done_list[i] = true;
+	if ( error1 ) {
+	  if ( !error ) {
+	    error = error1;
+	  }
+	  abort = true;
+	  next = n;
+	}
+      }
+      cv.notify_all();
+      if ( error1 ) {
+	break;
+      }
+    }
+  };
+
+  std::vector<std::thread> thread_list;
+  thread_list.reserve(nt);
+  for ( SizeType t = 0; t < nt; ++ t ) {
+    thread_list.emplace_back(worker);
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    {
+      std::unique_lock<std::mutex> lock{mtx};
+      cv.wait(lock, [&]() { return done_list[i] || abort; });
+      if ( !done_list[i] ) {
+	break;
+      }
+    }
+    queue_list[i].flush();
+  }
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+  if ( error ) {
+    std::rethrow_exception(error);
+  }
+  return result_list;
+}
+
+// @brief ファイルの形式を判定する．
+std::string
+BnModel::detect_format(
+  const std::string& filename
+)
+{
+  auto format = format_from_ext(filename);
+  if ( format.empty() ) {
+    format = format_from_content(filename);
+  }
+  return format;
+}
+
+END_NAMESPACE_YM_BN
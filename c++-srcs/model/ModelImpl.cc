@@ -28,7 +28,9 @@ ModelImpl::ModelImpl(
     mDffList{src.mDffList},
     mLogicList{src.mLogicList},
     mNameDict{src.mNameDict},
-    mFuncMgr{src.mFuncMgr}
+    mFuncMgr{src.mFuncMgr},
+    mStrash{src.mStrash},
+    mStrashDict{src.mStrashDict}
 {
   for ( SizeType i = 0; i < src.mNodeArray.size(); ++ i ) {
     mNodeArray[i] = src.mNodeArray[i]->copy();
@@ -103,9 +105,16 @@ ModelImpl::clear()
   mInputList.clear();
   mOutputList.clear();
   mOutputNameList.clear();
+  mDffList.clear();
   mLogicList.clear();
   mNameDict.clear();
   mFuncMgr.clear();
+  mStrashDict.clear();
+  mFrozen = false;
+  mLevelArray.clear();
+  mDepth = 0;
+  mFanoutBegin.clear();
+  mFanoutList.clear();
 }
 
 BEGIN_NONAMESPACE
@@ -218,6 +227,22 @@ ModelImpl::set_logic(
   // mLogicList には追加しない．
 }
 
+// @brief 論理ノードの情報をセットする．
+void
+ModelImpl::set_logic(
+  SizeType id,
+  SizeType func_id,
+  std::vector<BnIdType>&& fanin_list
+)
+{
+  if ( mNodeArray[id].get() != nullptr ) {
+    throw std::invalid_argument{"id has already been used"};
+  }
+  auto node = NodeImpl::new_logic(func_id, std::move(fanin_list));
+  mNodeArray[id] = std::unique_ptr<NodeImpl>{node};
+  // mLogicList には追加しない．
+}
+
 // @brief ノード名をセットする．
 void
 ModelImpl::set_node_name(
@@ -232,16 +257,20 @@ ModelImpl::set_node_name(
 void
 ModelImpl::make_logic_list()
 {
-  std::unordered_set<SizeType> mark;
+  mLogicList.clear();
+
+  ProgressReporter progress{"wrap_up", mNodeArray.size(),
+			    ProgressReporter::NODE_STRIDE};
+  std::vector<bool> mark(mNodeArray.size(), false);
 
   // 入力ノードに印をつける．
   for ( auto id: mInputList ) {
-    mark.emplace(id);
+    mark[id] = true;
   }
 
   // DFFの出力に印を作る．
   for ( auto& dff: mDffList ) {
-    mark.emplace(dff.id);
+    mark[dff.id] = true;
   }
 
   // 出力ノードからファンインをたどり
@@ -249,35 +278,215 @@ ModelImpl::make_logic_list()
   // 結果としてノードは入力からのトポロジカル順
   // に整列される．
   for ( auto id: mOutputList ) {
-    order_node(id, mark);
+    order_node(id, mark, progress);
   }
 
   // DFFのファンインに番号をつける．
   for ( auto& dff: mDffList ) {
     auto src_id = dff.src_id;
-    order_node(src_id, mark);
+    order_node(src_id, mark, progress);
+  }
+  progress.finish(mNodeArray.size());
+
+  if ( mStrash ) {
+    strash_logic_list();
   }
 }
 
+// @brief 凍結する．
+void
+ModelImpl::freeze()
+{
+  if ( mFrozen ) {
+    return;
+  }
+
+  make_logic_list();
+
+  auto n = mNodeArray.size();
+
+  // レベルを求める．
+  // mLogicList はトポロジカル順なのでファンインのレベルは既に求まっている．
+  mLevelArray.clear();
+  mLevelArray.resize(n, 0);
+  mDepth = 0;
+  for ( auto id: mLogicList ) {
+    SizeType level = 0;
+    for ( auto iid: mNodeArray[id]->fanin_id_list() ) {
+      level = std::max<SizeType>(level, mLevelArray[iid]);
+    }
+    ++ level;
+    mLevelArray[id] = level;
+    mDepth = std::max(mDepth, level);
+  }
+
+  // ファンアウトを求める．
+  // 論理ノードのファンインのみを対象とする．
+  mFanoutBegin.clear();
+  mFanoutBegin.resize(n + 1, 0);
+  for ( auto id: mLogicList ) {
+    for ( auto iid: mNodeArray[id]->fanin_id_list() ) {
+      ++ mFanoutBegin[iid + 1];
+    }
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    mFanoutBegin[i + 1] += mFanoutBegin[i];
+  }
+  mFanoutList.clear();
+  mFanoutList.resize(mFanoutBegin[n]);
+  std::vector<SizeType> pos_array(mFanoutBegin.begin(), mFanoutBegin.end() - 1);
+  for ( auto id: mLogicList ) {
+    for ( auto iid: mNodeArray[id]->fanin_id_list() ) {
+      mFanoutList[pos_array[iid]] = id;
+      ++ pos_array[iid];
+    }
+  }
+
+  mFrozen = true;
+}
+
+// @brief 構造ハッシュを用いて新しい論理ノードを作る．
+SizeType
+ModelImpl::new_logic_strash(
+  SizeType func_id,
+  std::vector<BnIdType>&& fanin_list
+)
+{
+  auto key = strash_key(func_id, fanin_list);
+  auto p = mStrashDict.find(key);
+  if ( p != mStrashDict.end() ) {
+    return p->second;
+  }
+  auto id = alloc_node();
+  set_logic(id, func_id, std::move(fanin_list));
+  mStrashDict.emplace(std::move(key), id);
+  return id;
+}
+
+// @brief mLogicList 中の同一構造のノードを共有化する．
+void
+ModelImpl::strash_logic_list()
+{
+  // 共有化されたノードの代表ノード
+  std::vector<BnIdType> rep_array(mNodeArray.size());
+  for ( SizeType id = 0; id < mNodeArray.size(); ++ id ) {
+    rep_array[id] = id;
+  }
+
+  // mLogicList はトポロジカル順なので
+  // ファンインの代表ノードは既に決まっている．
+  mStrashDict.clear();
+  std::vector<BnIdType> logic_list;
+  logic_list.reserve(mLogicList.size());
+  ProgressReporter progress{"strash", mLogicList.size(),
+			    ProgressReporter::NODE_STRIDE};
+  SizeType count = 0;
+  for ( auto id: mLogicList ) {
+    progress.update(count, mNodeArray.size());
+    ++ count;
+    auto& node = *mNodeArray[id];
+    auto func_id = node.func_id();
+    std::vector<BnIdType> fanin_list;
+    fanin_list.reserve(node.fanin_num());
+    bool changed = false;
+    for ( auto iid: node.fanin_id_list() ) {
+      auto rid = rep_array[iid];
+      if ( rid != iid ) {
+	changed = true;
+      }
+      fanin_list.push_back(rid);
+    }
+    auto key = strash_key(func_id, fanin_list);
+    auto p = mStrashDict.find(key);
+    if ( p != mStrashDict.end() ) {
+      rep_array[id] = p->second;
+      continue;
+    }
+    if ( changed ) {
+      auto new_node = NodeImpl::new_logic(func_id, std::move(fanin_list));
+      mNodeArray[id] = std::unique_ptr<NodeImpl>{new_node};
+    }
+    mStrashDict.emplace(std::move(key), id);
+    logic_list.push_back(id);
+  }
+  std::swap(mLogicList, logic_list);
+  progress.finish(mNodeArray.size());
+
+  // 出力とDFFの入力を代表ノードに置き換える．
+  for ( auto& id: mOutputList ) {
+    id = rep_array[id];
+  }
+  for ( auto& dff: mDffList ) {
+    if ( dff.src_id < rep_array.size() ) {
+      dff.src_id = rep_array[dff.src_id];
+    }
+  }
+}
+
+// @brief 構造ハッシュ用のキーを作る．
+ModelImpl::StrashKey
+ModelImpl::strash_key(
+  SizeType func_id,
+  const std::vector<BnIdType>& fanin_list
+) const
+{
+  StrashKey key{func_id, fanin_list};
+  auto& func = func_impl(func_id);
+  if ( func.is_primitive() ) {
+    switch ( func.primitive_type() ) {
+    case PrimType::And:
+    case PrimType::Nand:
+    case PrimType::Or:
+    case PrimType::Nor:
+    case PrimType::Xor:
+    case PrimType::Xnor:
+      // 対称な関数なのでファンインの順番を正規化する．
+      std::sort(key.fanin_list.begin(), key.fanin_list.end());
+      break;
+
+    default:
+      break;
+    }
+  }
+  return key;
+}
+
 // @brief トポロジカルソートを行い mLogicList にセットする．
 void
 ModelImpl::order_node(
   SizeType id,
-  std::unordered_set<SizeType>& mark
+  std::vector<bool>& mark,
+  ProgressReporter& progress
 )
 {
-  if ( mark.count(id) > 0 ) {
+  // 段数の深い回路でスタックがあふれないように
+  // 再帰ではなく明示的なスタックを用いる．
+  if ( mark[id] ) {
     return;
   }
-  auto node = mNodeArray[id].get();
-  if ( !node->is_logic() ) {
-    throw std::logic_error{"node->is_logic() == false"};
-  }
-  for ( auto iid: node->fanin_id_list() ) {
-    order_node(iid, mark);
+  // (ノード番号, 次に調べるファンインの位置) のスタック
+  std::vector<std::pair<SizeType, SizeType>> stack;
+  stack.push_back({id, 0});
+  while ( !stack.empty() ) {
+    auto& top = stack.back();
+    auto node = mNodeArray[top.first].get();
+    if ( top.second == 0 && !node->is_logic() ) {
+      throw std::logic_error{"node->is_logic() == false"};
+    }
+    if ( top.second < node->fanin_num() ) {
+      auto iid = node->fanin_id(top.second);
+      ++ top.second;
+      if ( !mark[iid] ) {
+	stack.push_back({iid, 0});
+      }
+    }
+    else {
+      mLogicList.push_back(top.first);
+      mark[top.first] = true;
+      stack.pop_back();
+      progress.update(mLogicList.size(), mNodeArray.size());
+    }
   }
-  mLogicList.push_back(id);
-  mark.emplace(id);
 }
 
 // @brief 内容を出力する．
@@ -0,0 +1,120 @@
+
+/// @file NameMgr.cc
+/// @brief NameMgr の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "NameMgr.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス NameMgr
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+NameMgr::NameMgr(
+  const ModelImpl& model
+)
+{
+  auto n = model.node_num();
+  mNameArray.resize(n);
+
+  // 定義されているノードのリスト
+  std::vector<SizeType> id_list;
+  id_list.reserve(model.input_num() + model.dff_num() + model.logic_num());
+  for ( auto id: model.input_id_list() ) {
+    id_list.push_back(id);
+  }
+  for ( SizeType i = 0; i < model.dff_num(); ++ i ) {
+    auto id = model.dff_impl(i).id;
+    if ( id < n ) {
+      id_list.push_back(id);
+    }
+  }
+  for ( auto id: model.logic_id_list() ) {
+    id_list.push_back(id);
+  }
+
+  // まず既存の名前を割り当てる．
+  std::vector<bool> defined(n, false);
+  for ( auto id: id_list ) {
+    defined[id] = true;
+    auto name = model.get_node_name(id);
+    if ( name.empty() ) {
+      auto& node = model.node_impl(id);
+      if ( node.is_dff_output() ) {
+	name = model.dff_name(node.dff_id());
+      }
+    }
+    if ( reg_name(name) ) {
+      mNameArray[id] = name;
+    }
+  }
+
+  // 名前を持たないノードが出力の場合は出力名を用いる．
+  for ( SizeType i = 0; i < model.output_num(); ++ i ) {
+    auto id = model.output_id(i);
+    if ( id < n && defined[id] && mNameArray[id].empty() ) {
+      auto name = model.output_name(i);
+      if ( reg_name(name) ) {
+	mNameArray[id] = name;
+      }
+    }
+  }
+
+  // 残りのノードに名前を生成する．
+  for ( auto id: id_list ) {
+    if ( mNameArray[id].empty() ) {
+      mNameArray[id] = new_name(id);
+    }
+  }
+
+  // 出力名
+  auto no = model.output_num();
+  mOutputNameList.reserve(no);
+  for ( SizeType i = 0; i < no; ++ i ) {
+    auto id = model.output_id(i);
+    auto name = model.output_name(i);
+    if ( id < n && (name.empty() || name == mNameArray[id]) ) {
+      mOutputNameList.push_back(mNameArray[id]);
+    }
+    else if ( reg_name(name) ) {
+      mOutputNameList.push_back(name);
+    }
+    else {
+      mOutputNameList.push_back(new_name(n + i));
+    }
+  }
+}
+
+// @brief 重複しない名前を生成する．
+std::string
+NameMgr::new_name(
+  SizeType num
+)
+{
+  auto name = "n" + std::to_string(num);
+  while ( !reg_name(name) ) {
+    name = "_" + name;
+  }
+  return name;
+}
+
+// @brief 名前を登録する．
+bool
+NameMgr::reg_name(
+  const std::string& name
+)
+{
+  if ( name.empty() ) {
+    return false;
+  }
+  return mNameSet.insert(name).second;
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,105 @@
+
+/// @file BnModelBuilder_test.cc
+/// @brief BnModelBuilder_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnModelBuilder.h"
+#include "ym/BnModel.h"
+#include "ym/BnNode.h"
+#include "ym/BnFunc.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+TEST( BnModelBuilderTest, empty )
+{
+  BnModelBuilder builder;
+
+  auto model = builder.wrap_up();
+
+  EXPECT_EQ( 0, model.node_num() );
+  EXPECT_EQ( 0, model.input_num() );
+  EXPECT_EQ( 0, model.output_num() );
+  EXPECT_EQ( 0, model.logic_num() );
+}
+
+TEST( BnModelBuilderTest, new_logic )
+{
+  BnModelBuilder builder;
+  builder.reserve(5);
+
+  auto id1 = builder.new_input("a");
+  auto id2 = builder.new_input("b");
+  auto id3 = builder.new_input("c");
+  auto and2 = builder.reg_primitive(2, PrimType::And);
+  auto or2 = builder.reg_primitive(2, PrimType::Or);
+  auto id4 = builder.new_logic(and2, {id1, id2});
+  auto id5 = builder.new_logic(or2, std::vector<SizeType>{id4, id3});
+  builder.new_output(id5, "z");
+
+  auto model = builder.wrap_up();
+  EXPECT_EQ( 0, builder.node_num() );
+
+  EXPECT_EQ( 5, model.node_num() );
+  ASSERT_EQ( 3, model.input_num() );
+  EXPECT_EQ( "a", model.input_name(0) );
+  EXPECT_EQ( "b", model.input_name(1) );
+  EXPECT_EQ( "c", model.input_name(2) );
+  ASSERT_EQ( 1, model.output_num() );
+  EXPECT_EQ( "z", model.output_name(0) );
+  EXPECT_EQ( id5, model.output(0).id() );
+  ASSERT_EQ( 2, model.logic_num() );
+  EXPECT_EQ( id4, model.logic(0).id() );
+  EXPECT_EQ( id5, model.logic(1).id() );
+
+  auto node4 = model.node(id4);
+  EXPECT_EQ( and2, node4.func().id() );
+  EXPECT_EQ( (std::vector<SizeType>{id1, id2}),
+	     node4.fanin_id_list().to_vector() );
+
+  auto node5 = model.node(id5);
+  EXPECT_EQ( or2, node5.func().id() );
+  EXPECT_EQ( (std::vector<SizeType>{id4, id3}),
+	     node5.fanin_id_list().to_vector() );
+}
+
+TEST( BnModelBuilderTest, new_dff )
+{
+  BnModelBuilder builder;
+
+  auto id1 = builder.new_input();
+  auto dff_id = builder.new_dff("q", '0');
+  auto id2 = builder.dff_output_id(dff_id);
+  auto xor2 = builder.reg_primitive(2, PrimType::Xor);
+  auto id3 = builder.new_logic(xor2, {id1, id2});
+  builder.set_dff_src(dff_id, id3);
+
+  auto model = builder.wrap_up();
+
+  ASSERT_EQ( 1, model.dff_num() );
+  auto dff = model.dff(0);
+  EXPECT_EQ( "q", model.dff_name(0) );
+  EXPECT_EQ( id2, dff.output().id() );
+  EXPECT_EQ( id3, dff.input().id() );
+  EXPECT_EQ( '0', dff.reset_val() );
+  ASSERT_EQ( 1, model.logic_num() );
+  EXPECT_EQ( id3, model.logic(0).id() );
+}
+
+TEST( BnModelBuilderTest, bad_fanin )
+{
+  BnModelBuilder builder;
+
+  auto id1 = builder.new_input();
+  auto and2 = builder.reg_primitive(2, PrimType::And);
+
+  EXPECT_THROW( builder.new_logic(and2, {id1, id1 + 1}), std::out_of_range );
+  EXPECT_THROW( builder.new_logic(and2 + 1, {id1, id1}), std::out_of_range );
+  EXPECT_THROW( builder.new_output(id1 + 1), std::out_of_range );
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,183 @@
+
+/// @file BnModel_freeze_test.cc
+/// @brief BnModel::freeze() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnModelBuilder.h"
+#include "ym/BnModel.h"
+#include "ym/BnNode.h"
+#include "ym/BnNodeRef.h"
+#include <random>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// ランダムな回路を作る．
+BnModel
+make_random_model(
+  SizeType input_num,
+  SizeType logic_num
+)
+{
+  BnModelBuilder builder;
+  builder.reserve(input_num + logic_num);
+  for ( SizeType i = 0; i < input_num; ++ i ) {
+    builder.new_input();
+  }
+  auto and2 = builder.reg_primitive(2, PrimType::And);
+  auto xor3 = builder.reg_primitive(3, PrimType::Xor);
+  std::mt19937 rg;
+  for ( SizeType i = 0; i < logic_num; ++ i ) {
+    std::uniform_int_distribution<SizeType> fd(0, builder.node_num() - 1);
+    if ( i % 2 == 0 ) {
+      builder.new_logic(and2, {fd(rg), fd(rg)});
+    }
+    else {
+      builder.new_logic(xor3, {fd(rg), fd(rg), fd(rg)});
+    }
+  }
+  auto n = builder.node_num();
+  for ( SizeType i = n - input_num; i < n; ++ i ) {
+    builder.new_output(i);
+  }
+  return builder.wrap_up();
+}
+
+// レベルとファンアウトの整合性を調べてレベルの総和を返す．
+SizeType
+check_model(
+  const BnModel& model,
+  bool& ok
+)
+{
+  ok = true;
+  SizeType sum = 0;
+  for ( auto node: model.input_ref_list() ) {
+    if ( node.level() != 0 ) {
+      ok = false;
+    }
+  }
+  std::vector<SizeType> fanout_count(model.node_num(), 0);
+  for ( auto node: model.logic_ref_list() ) {
+    SizeType level = 0;
+    for ( auto inode: node.fanin_list() ) {
+      level = std::max(level, inode.level() + 1);
+      ++ fanout_count[inode.id()];
+    }
+    if ( node.level() != level ) {
+      ok = false;
+    }
+    sum += level;
+  }
+  for ( SizeType id = 0; id < model.node_num(); ++ id ) {
+    auto node = model.node_ref(id);
+    if ( node.fanout_num() != fanout_count[id] ) {
+      ok = false;
+    }
+    for ( auto onode: node.fanout_list() ) {
+      bool found = false;
+      for ( auto id1: onode.fanin_id_list() ) {
+	if ( id1 == id ) {
+	  found = true;
+	  break;
+	}
+      }
+      if ( !found ) {
+	ok = false;
+      }
+    }
+  }
+  return sum;
+}
+
+END_NONAMESPACE
+
+TEST( BnModelFreezeTest, simple )
+{
+  BnModel model;
+  auto input1 = model.new_input();
+  auto input2 = model.new_input();
+  auto node1 = model.new_primitive(PrimType::And, {input1, input2});
+  auto node2 = model.new_primitive(PrimType::Or, {node1, input2});
+  model.new_output(node2);
+
+  EXPECT_FALSE( model.is_frozen() );
+  EXPECT_THROW( model.depth(), std::logic_error );
+  EXPECT_THROW( node1.level(), std::logic_error );
+
+  model.freeze();
+
+  EXPECT_TRUE( model.is_frozen() );
+  EXPECT_EQ( 2, model.depth() );
+
+  auto n1 = model.node(node1.id());
+  auto n2 = model.node(node2.id());
+  auto i2 = model.node(input2.id());
+  EXPECT_EQ( 0, i2.level() );
+  EXPECT_EQ( 1, n1.level() );
+  EXPECT_EQ( 2, n2.level() );
+  EXPECT_EQ( 2, i2.fanout_num() );
+  EXPECT_EQ( (std::vector<SizeType>{n1.id(), n2.id()}),
+	     i2.fanout_id_list().to_vector() );
+  EXPECT_EQ( 1, n1.fanout_num() );
+  EXPECT_EQ( 0, n2.fanout_num() );
+}
+
+TEST( BnModelFreezeTest, immutable )
+{
+  BnModel model;
+  auto input1 = model.new_input();
+  model.new_output(input1);
+  model.freeze();
+
+  EXPECT_THROW( model.new_input(), std::logic_error );
+  EXPECT_THROW( model.new_output(input1), std::logic_error );
+  EXPECT_THROW( model.new_primitive(PrimType::Not, {input1}), std::logic_error );
+  EXPECT_THROW( model.new_dff(), std::logic_error );
+  EXPECT_THROW( model.clear(), std::logic_error );
+  EXPECT_NO_THROW( model.wrap_up() );
+  EXPECT_NO_THROW( model.freeze() );
+
+  // 複製は凍結されていない．
+  auto model2 = model.copy();
+  EXPECT_FALSE( model2.is_frozen() );
+  EXPECT_NO_THROW( model2.new_input() );
+}
+
+TEST( BnModelFreezeTest, multi_thread )
+{
+  auto model = make_random_model(100, 20000);
+  model.freeze();
+
+  bool ok0;
+  auto sum0 = check_model(model, ok0);
+  ASSERT_TRUE( ok0 );
+
+  const SizeType thread_num = 8;
+  std::vector<SizeType> sum_array(thread_num, 0);
+  std::vector<char> ok_array(thread_num, false);
+  std::vector<std::thread> thread_list;
+  for ( SizeType i = 0; i < thread_num; ++ i ) {
+    thread_list.push_back(std::thread{[&, i](){
+      bool ok;
+      sum_array[i] = check_model(model, ok);
+      ok_array[i] = ok;
+    }});
+  }
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+  for ( SizeType i = 0; i < thread_num; ++ i ) {
+    EXPECT_TRUE( ok_array[i] );
+    EXPECT_EQ( sum0, sum_array[i] );
+  }
+}
+
+END_NAMESPACE_YM_BN
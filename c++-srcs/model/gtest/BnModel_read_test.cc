@@ -0,0 +1,393 @@
+
+/// @file BnModel_read_test.cc
+/// @brief BnModel::read() と read_many() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include <fstream>
+#include "BnTestUtil.h"
+
+#if defined(YM_BN_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 内容を文字列にする．
+std::string
+to_str(
+  const BnModel& model
+)
+{
+  std::ostringstream buf;
+  model.print(buf);
+  return buf.str();
+}
+
+// read_many() を呼び出してメッセージを文字列で返す．
+std::vector<BnReadResult>
+read_many_with_msg(
+  const std::vector<std::string>& filename_list,
+  SizeType thread_num,
+  std::string& msg
+)
+{
+  std::ostringstream msg_buf;
+  StreamMsgHandler msg_handler(msg_buf);
+  MsgMgr::attach_handler(&msg_handler);
+  auto result_list = BnModel::read_many(filename_list, "auto", thread_num);
+  MsgMgr::detach_handler(&msg_handler);
+  msg = msg_buf.str();
+  return result_list;
+}
+
+#if defined(YM_BN_HAS_ZLIB)
+
+// contents を gzip 形式で圧縮したファイルを作る．
+std::string
+make_gzip_file(
+  const std::string& name,
+  const std::string& contents
+)
+{
+  auto path = ::testing::TempDir() + name;
+  auto fp = gzopen(path.c_str(), "wb");
+  gzwrite(fp, contents.data(), contents.size());
+  gzclose(fp);
+  return path;
+}
+
+// 圧縮していないファイルと gzip 形式のファイルを作って読み込み結果を比べる．
+//
+// メッセージ中のファイル名は置き換えて比べる．
+void
+check_gzip(
+  const std::string& name,
+  const std::string& contents
+)
+{
+  auto path1 = make_file(name, contents);
+  auto path2 = make_gzip_file(name + ".gz", contents);
+  std::string result_list[2];
+  std::string msg_list[2];
+  for ( int i = 0; i < 2; ++ i ) {
+    std::ostringstream msg_buf;
+    StreamMsgHandler msg_handler(msg_buf);
+    MsgMgr::attach_handler(&msg_handler);
+    try {
+      auto model = BnModel::read(i == 0 ? path1 : path2);
+      result_list[i] = to_str(model);
+    }
+    catch ( const std::invalid_argument& ) {
+      result_list[i] = "error";
+    }
+    MsgMgr::detach_handler(&msg_handler);
+    msg_list[i] = msg_buf.str();
+  }
+  for ( SizeType pos = 0;
+	(pos = msg_list[1].find(path2, pos)) != std::string::npos;
+	pos += path1.size() ) {
+    msg_list[1].replace(pos, path2.size(), path1);
+  }
+  EXPECT_EQ( result_list[0], result_list[1] );
+  EXPECT_EQ( msg_list[0], msg_list[1] );
+}
+
+#endif
+
+END_NONAMESPACE
+
+TEST( BnModelReadTest, detect_format_ext )
+{
+  EXPECT_EQ( "blif", BnModel::detect_format("foo.blif") );
+  EXPECT_EQ( "iscas89", BnModel::detect_format("foo.bench") );
+  EXPECT_EQ( "aag", BnModel::detect_format("foo.aag") );
+  EXPECT_EQ( "aig", BnModel::detect_format("foo.AIG") );
+  EXPECT_EQ( "truth", BnModel::detect_format("foo.truth") );
+  EXPECT_EQ( "verilog", BnModel::detect_format("dir.v/foo.v") );
+  EXPECT_EQ( std::string{}, BnModel::detect_format("dir.v/no_such_file") );
+}
+
+TEST( BnModelReadTest, detect_format_content )
+{
+  auto path1 = make_file("detect1",
+			 "# comment\n"
+			 "\n"
+			 ".model foo\n");
+  EXPECT_EQ( "blif", BnModel::detect_format(path1) );
+
+  auto path2 = make_file("detect2",
+			 "# comment\n"
+			 "INPUT(a)\n");
+  EXPECT_EQ( "iscas89", BnModel::detect_format(path2) );
+
+  auto path3 = make_file("detect3", "aag 1 1 0 1 0\n");
+  EXPECT_EQ( "aag", BnModel::detect_format(path3) );
+
+  auto path4 = make_file("detect4",
+			 "/* comment\n"
+			 " */\n"
+			 "module foo(a, b);\n");
+  EXPECT_EQ( "verilog", BnModel::detect_format(path4) );
+
+  auto path5 = make_file("detect5",
+			 "0110\n"
+			 "1000");
+  EXPECT_EQ( "truth", BnModel::detect_format(path5) );
+
+  auto path6 = make_file("detect6", "hello world\n");
+  EXPECT_EQ( std::string{}, BnModel::detect_format(path6) );
+}
+
+TEST( BnModelReadTest, read_auto )
+{
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  auto model1 = BnModel::read(path);
+  auto model2 = BnModel::read_blif(path);
+  EXPECT_EQ( to_str(model2), to_str(model1) );
+}
+
+TEST( BnModelReadTest, read_bad_format )
+{
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  EXPECT_THROW( BnModel::read(path, "edif"), std::invalid_argument );
+
+  auto path1 = make_file("unknown", "hello world\n");
+  EXPECT_THROW( BnModel::read(path1), std::invalid_argument );
+}
+
+TEST( BnModelReadTest, read_many )
+{
+  auto datapath = std::string{DATAPATH};
+  std::vector<std::string> filename_list{
+    datapath + "s5378.blif",
+    datapath + "broken.blif",
+    datapath + "b10.bench",
+    datapath + "no_such_file.blif",
+    datapath + "test1.aag",
+    datapath + "ex61.truth",
+  };
+  std::vector<bool> exp_ok{true, false, true, false, true, true};
+
+  std::string msg1;
+  auto result_list1 = read_many_with_msg(filename_list, 1, msg1);
+  std::string msg2;
+  auto result_list2 = read_many_with_msg(filename_list, 4, msg2);
+
+  auto n = filename_list.size();
+  ASSERT_EQ( n, result_list1.size() );
+  ASSERT_EQ( n, result_list2.size() );
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto& filename = filename_list[i];
+    auto& result1 = result_list1[i];
+    auto& result2 = result_list2[i];
+    EXPECT_EQ( filename, result2.filename );
+    EXPECT_EQ( BnModel::detect_format(filename), result2.format );
+    EXPECT_EQ( exp_ok[i], result2.ok );
+    EXPECT_EQ( result1.ok, result2.ok );
+    EXPECT_EQ( result1.error, result2.error );
+    if ( result2.ok ) {
+      auto model = BnModel::read(filename);
+      EXPECT_EQ( to_str(model), to_str(result2.model) );
+      EXPECT_EQ( to_str(result1.model), to_str(result2.model) );
+      EXPECT_EQ( std::string{}, result2.error );
+    }
+    else {
+      EXPECT_NE( std::string{}, result2.error );
+    }
+  }
+  // メッセージの順番も逐次的に読み込んだ場合と同一になる．
+  EXPECT_NE( std::string{}, msg1 );
+  EXPECT_EQ( msg1, msg2 );
+}
+
+#if defined(YM_BN_HAS_ZLIB)
+TEST( BnModelReadTest, read_gzip )
+{
+  auto datapath = std::string{DATAPATH};
+  EXPECT_EQ( "blif", BnModel::detect_format(datapath + "s5378.blif.gz") );
+  auto model1 = BnModel::read(datapath + "s5378.blif.gz");
+  auto model2 = BnModel::read_blif(datapath + "s5378.blif");
+  EXPECT_EQ( to_str(model2), to_str(model1) );
+}
+#endif
+
+#if defined(YM_BN_HAS_LZMA)
+TEST( BnModelReadTest, read_xz )
+{
+  auto datapath = std::string{DATAPATH};
+  EXPECT_EQ( "iscas89", BnModel::detect_format(datapath + "b10.bench.xz") );
+  auto model1 = BnModel::read_iscas89(datapath + "b10.bench.xz");
+  auto model2 = BnModel::read_iscas89(datapath + "b10.bench");
+  EXPECT_EQ( to_str(model2), to_str(model1) );
+}
+#endif
+
+#if defined(YM_BN_HAS_ZSTD)
+TEST( BnModelReadTest, read_zstd )
+{
+  auto datapath = std::string{DATAPATH};
+  EXPECT_EQ( "truth", BnModel::detect_format(datapath + "ex61.truth.zst") );
+  auto model1 = BnModel::read_truth(datapath + "ex61.truth.zst");
+  auto model2 = BnModel::read_truth(datapath + "ex61.truth");
+  EXPECT_EQ( to_str(model2), to_str(model1) );
+}
+#endif
+
+#if defined(YM_BN_HAS_ZLIB)
+TEST( BnModelReadTest, read_compressed_sniff )
+{
+  // 拡張子がなくても内容から判定できる．
+  auto datapath = std::string{DATAPATH};
+  std::ifstream s{datapath + "s5378.blif.gz", std::ios::binary};
+  std::ostringstream buf;
+  buf << s.rdbuf();
+  auto path = make_file("s5378_gz", buf.str());
+  EXPECT_EQ( "blif", BnModel::detect_format(path) );
+}
+
+TEST( BnModelReadTest, read_corrupted )
+{
+  // 途中で切れた圧縮ファイル
+  auto datapath = std::string{DATAPATH};
+  std::ifstream s{datapath + "s5378.blif.gz", std::ios::binary};
+  std::ostringstream buf;
+  buf << s.rdbuf();
+  auto contents = buf.str();
+  auto path = make_file("truncated.blif.gz",
+			contents.substr(0, contents.size() / 2));
+  EXPECT_THROW( BnModel::read_blif(path), std::invalid_argument );
+}
+
+TEST( BnModelReadTest, read_gzip_stream )
+{
+  // 展開と並行して読み込む場合も結果とメッセージは同じになる．
+  // 1度に公開される範囲より大きなファイルと長い行を用いる．
+  const SizeType n = 20000;
+  std::ostringstream bench;
+  bench << "INPUT(x0)\n"
+	<< "OUTPUT(x" << n << ")\n";
+  for ( SizeType i = 0; i < n; ++ i ) {
+    bench << "x" << (i + 1) << " = NOT(x" << i << ")\n";
+  }
+  check_gzip("stream.bench", bench.str());
+
+  std::ostringstream blif;
+  blif << ".model stream\n"
+       << ".inputs";
+  for ( SizeType i = 0; i < n; ++ i ) {
+    blif << " a" << i;
+  }
+  blif << "\n"
+       << ".outputs x" << n << "\n"
+       << ".names a0 x0\n"
+       << "1 1\n";
+  for ( SizeType i = 0; i < n; ++ i ) {
+    blif << ".names x" << i << " a" << i << " x" << (i + 1) << "\n"
+	 << "11 1\n";
+  }
+  blif << ".end\n";
+  check_gzip("stream.blif", blif.str());
+
+  // 警告とエラーのあるファイル
+  auto error_blif = blif.str();
+  error_blif.insert(error_blif.size() / 2,
+		    ".names x0 x0\n1 1\n.names u x1000000\n1 1\n");
+  check_gzip("stream_error.blif", error_blif);
+  check_gzip("stream_noend.blif", blif.str().substr(0, blif.str().size() - 5));
+}
+
+TEST( BnModelReadTest, read_gzip_hier )
+{
+  // 展開しながら読み込んだ後で階層構造を持つことがわかった場合
+  // .subckt 文が後ろにある場合
+  std::ostringstream buf;
+  const SizeType n = 20000;
+  buf << ".model top\n"
+      << ".inputs a b\n"
+      << ".outputs o\n";
+  for ( SizeType i = 0; i < n; ++ i ) {
+    buf << ".names " << (i == 0 ? "a" : "w" + std::to_string(i))
+	<< " w" << (i + 1) << "\n"
+	<< "1 1\n";
+  }
+  buf << ".subckt xor2 i0=w" << n << " i1=b o=o\n"
+      << ".end\n"
+      << ".model xor2\n"
+      << ".inputs i0 i1\n"
+      << ".outputs o\n"
+      << ".names i0 i1 o\n"
+      << "10 1\n"
+      << "01 1\n"
+      << ".end\n";
+  check_gzip("stream_hier1.blif", buf.str());
+
+  // 2つめの .model 文で階層構造を持つことがわかる場合
+  check_gzip("stream_hier2.blif",
+	     ".model top\n"
+	     ".inputs a\n"
+	     ".outputs o\n"
+	     ".names a o\n"
+	     "0 1\n"
+	     ".end\n"
+	     "# unused model\n"
+	     ".model sub\n"
+	     ".inputs i\n"
+	     ".outputs o\n"
+	     ".names i o\n"
+	     "1 1\n"
+	     ".end\n");
+
+  // 最初のモデルでエラーになる場合も階層構造として読み直す．
+  check_gzip("stream_hier3.blif",
+	     ".model top\n"
+	     ".inputs a\n"
+	     ".outputs o\n"
+	     ".names u o\n"
+	     "1 1\n"
+	     ".end\n"
+	     ".model sub\n"
+	     ".inputs i\n"
+	     ".outputs o\n"
+	     ".end\n");
+}
+
+TEST( BnModelReadTest, read_gzip_abort )
+{
+  // 展開が終わる前に読み込みが失敗する場合
+  std::ostringstream buf;
+  buf << "foo\n";
+  for ( SizeType i = 0; i < 1000000; ++ i ) {
+    buf << "// " << i << "\n";
+  }
+  auto path = make_gzip_file("abort.v.gz", buf.str());
+  EXPECT_THROW( BnModel::read_verilog(path), std::invalid_argument );
+}
+
+TEST( BnModelReadTest, read_corrupted_large )
+{
+  // 先頭のみ gzip 形式で残りが壊れている大きなファイル
+  // 展開に失敗した時点では読み出し用のスレッドがまだ動いている．
+  std::string contents{"\x1f\x8b\x08\x00", 4};
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> rd{0, 255};
+  for ( SizeType i = 0; i < 3 * 1024 * 1024; ++ i ) {
+    contents += static_cast<char>(rd(rg));
+  }
+  auto path = make_file("corrupted.blif.gz", contents);
+  EXPECT_THROW( BnModel::read_blif(path), std::invalid_argument );
+  // 内容から形式を判定する場合も判定に失敗するだけとなる．
+  auto path2 = make_file("corrupted_gz", contents);
+  EXPECT_EQ( std::string{}, BnModel::detect_format(path2) );
+}
+#endif
+
+END_NAMESPACE_YM_BN
@@ -298,4 +298,138 @@ TEST( BnModelTest, clear )
   EXPECT_EQ( 0, model.logic_num() );
 }
 
+TEST( BnModelTest, ref_list )
+{
+  BnModel model;
+
+  auto input1 = model.new_input();
+  auto input2 = model.new_input();
+  auto fanin_list = std::vector<BnNode>{input1, input2};
+  auto type = PrimType::And;
+  auto node = model.new_primitive(type, fanin_list);
+  model.new_output(node);
+
+  model.wrap_up();
+
+  auto input_ids = model.input_id_list();
+  ASSERT_EQ( 2, input_ids.size() );
+  EXPECT_EQ( input1.id(), input_ids[0] );
+  EXPECT_EQ( input2.id(), input_ids[1] );
+
+  auto output_ids = model.output_id_list();
+  ASSERT_EQ( 1, output_ids.size() );
+  EXPECT_EQ( node.id(), output_ids[0] );
+
+  auto logic_refs = model.logic_ref_list();
+  ASSERT_EQ( 1, logic_refs.size() );
+  SizeType n = 0;
+  for ( auto ref: logic_refs ) {
+    EXPECT_TRUE( ref.is_valid() );
+    EXPECT_EQ( node.id(), ref.id() );
+    EXPECT_TRUE( ref.is_logic() );
+    EXPECT_EQ( node.func().id(), ref.func_id() );
+    ASSERT_EQ( 2, ref.fanin_num() );
+    EXPECT_EQ( input1.id(), ref.fanin_id(0) );
+    EXPECT_EQ( input2.id(), ref.fanin_id(1) );
+    EXPECT_EQ( node.fanin_id_list().to_vector(),
+	       ref.fanin_id_list().to_vector() );
+    SizeType pos = 0;
+    for ( auto iref: ref.fanin_list() ) {
+      EXPECT_EQ( fanin_list[pos].ref(), iref );
+      EXPECT_TRUE( iref.is_primary_input() );
+      EXPECT_EQ( pos, iref.input_id() );
+      ++ pos;
+    }
+    ++ n;
+  }
+  EXPECT_EQ( 1, n );
+
+  EXPECT_EQ( node.ref(), model.node_ref(node.id()) );
+  EXPECT_THROW( model.node_ref(model.node_num()), std::out_of_range );
+}
+
+TEST( BnModelTest, id_span_iterator )
+{
+  BnModel model;
+
+  std::vector<SizeType> id_list;
+  for ( SizeType i = 0; i < 5; ++ i ) {
+    id_list.push_back(model.new_input().id());
+  }
+  model.wrap_up();
+
+  // 標準のアルゴリズムで用いることができる．
+  auto span = model.input_id_list();
+  auto b = span.begin();
+  auto e = span.end();
+  EXPECT_EQ( 5, std::distance(b, e) );
+  EXPECT_EQ( id_list[3], *std::next(b, 3) );
+  EXPECT_EQ( id_list[4], *std::prev(e) );
+  EXPECT_EQ( id_list[2], b[2] );
+  EXPECT_EQ( id_list[1], *(1 + b) );
+  EXPECT_EQ( id_list[3], *(e - 2) );
+  EXPECT_TRUE( b < e );
+  EXPECT_TRUE( e >= b );
+  EXPECT_EQ( b + 2, std::lower_bound(b, e, id_list[2]) );
+  auto it = e;
+  it -= 5;
+  EXPECT_EQ( b, it );
+  it += 4;
+  -- it;
+  EXPECT_EQ( id_list[3], *it );
+  EXPECT_EQ( std::vector<SizeType>(id_list.rbegin(), id_list.rend()),
+	     std::vector<SizeType>(std::make_reverse_iterator(e),
+				   std::make_reverse_iterator(b)) );
+}
+
+TEST( BnModelTest, bad_ref )
+{
+  BnNodeRef ref;
+
+  EXPECT_FALSE( ref.is_valid() );
+  EXPECT_EQ( BAD_ID, ref.id() );
+  EXPECT_THROW( ref.type(), std::logic_error );
+  EXPECT_THROW( ref.fanin_num(), std::logic_error );
+  EXPECT_THROW( ref.fanin_id_list(), std::logic_error );
+  EXPECT_EQ( ref, BnNode{}.ref() );
+}
+
+TEST( BnModelTest, strash )
+{
+  BnModel model;
+  model.set_strash();
+  EXPECT_TRUE( model.strash() );
+
+  auto input1 = model.new_input();
+  auto input2 = model.new_input();
+  auto node1 = model.new_primitive(PrimType::And, {input1, input2});
+  auto node2 = model.new_primitive(PrimType::And, {input1, input2});
+  EXPECT_EQ( node1, node2 );
+  // 対称な関数なので順番は無視される．
+  auto node3 = model.new_primitive(PrimType::And, {input2, input1});
+  EXPECT_EQ( node1, node3 );
+  // 異なる関数
+  auto node4 = model.new_primitive(PrimType::Or, {input1, input2});
+  EXPECT_NE( node1, node4 );
+
+  model.new_output(node1);
+  model.new_output(node4);
+  model.wrap_up();
+
+  EXPECT_EQ( 4, model.node_num() );
+  EXPECT_EQ( 2, model.logic_num() );
+}
+
+TEST( BnModelTest, no_strash )
+{
+  BnModel model;
+  EXPECT_FALSE( model.strash() );
+
+  auto input1 = model.new_input();
+  auto input2 = model.new_input();
+  auto node1 = model.new_primitive(PrimType::And, {input1, input2});
+  auto node2 = model.new_primitive(PrimType::And, {input1, input2});
+  EXPECT_NE( node1, node2 );
+}
+
 END_NAMESPACE_YM_BN
@@ -0,0 +1,191 @@
+
+/// @file BnProgress_test.cc
+/// @brief BnProgressScope のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnModel.h"
+#include "ym/BnProgress.h"
+#include "ym/JsonValue.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 内容を文字列にする．
+std::string
+to_str(
+  const BnModel& model
+)
+{
+  std::ostringstream buf;
+  model.print(buf);
+  return buf.str();
+}
+
+END_NONAMESPACE
+
+TEST( BnProgressTest, no_scope )
+{
+  EXPECT_EQ( nullptr, BnProgressScope::current() );
+}
+
+TEST( BnProgressTest, nested_scope )
+{
+  BnProgressScope scope1;
+  EXPECT_EQ( &scope1, BnProgressScope::current() );
+  {
+    BnProgressScope scope2;
+    EXPECT_EQ( &scope2, BnProgressScope::current() );
+  }
+  EXPECT_EQ( &scope1, BnProgressScope::current() );
+}
+
+TEST( BnProgressTest, read_blif )
+{
+  auto filename = std::string{DATAPATH} + "s5378.blif";
+  std::vector<BnProgress> progress_list;
+  BnProgressScope scope{[&](const BnProgress& p) {
+    progress_list.push_back(p);
+  }, BnCancelToken{}, 0.0};
+  auto model = BnModel::read_blif(filename);
+
+  ASSERT_FALSE( progress_list.empty() );
+  // 最後の "read" は全体を読み終えたことを表す．
+  const BnProgress* last_read = nullptr;
+  bool has_wrap_up = false;
+  for ( auto& p: progress_list ) {
+    auto phase = std::string{p.phase};
+    if ( phase == "read" ) {
+      EXPECT_LE( p.done, p.total );
+      last_read = &p;
+    }
+    else if ( phase == "wrap_up" ) {
+      has_wrap_up = true;
+    }
+  }
+  ASSERT_NE( nullptr, last_read );
+  EXPECT_EQ( last_read->total, last_read->done );
+  EXPECT_LT( 0, last_read->node_num );
+  EXPECT_TRUE( has_wrap_up );
+}
+
+TEST( BnProgressTest, read_canceled )
+{
+  auto filename = std::string{DATAPATH} + "s5378.blif";
+  BnCancelToken token;
+  token.cancel();
+  BnProgressScope scope{{}, token};
+  EXPECT_THROW( BnModel::read_blif(filename), BnCanceled );
+  EXPECT_THROW( BnModel::read_iscas89(std::string{DATAPATH} + "b10.bench"),
+		BnCanceled );
+}
+
+TEST( BnProgressTest, read_parallel_canceled )
+{
+  auto filename = std::string{DATAPATH} + "s5378.blif";
+  BnCancelToken token;
+  token.cancel();
+  BnProgressScope scope{{}, token};
+  std::unordered_map<std::string, JsonValue> opt_dict;
+  opt_dict.emplace("thread_num", JsonValue{4});
+  EXPECT_THROW( BnModel::read_blif(filename, JsonValue{opt_dict}),
+		BnCanceled );
+  EXPECT_THROW( BnModel::read_truth(std::string{DATAPATH} + "ex61.truth",
+				    JsonValue{opt_dict}),
+		BnCanceled );
+}
+
+TEST( BnProgressTest, cancel_from_callback )
+{
+  auto filename = std::string{DATAPATH} + "s5378.blif";
+  BnCancelToken token;
+  SizeType count = 0;
+  BnProgressScope scope{[&](const BnProgress&) {
+    ++ count;
+    token.cancel();
+  }, token, 0.0};
+  EXPECT_THROW( BnModel::read_blif(filename), BnCanceled );
+  EXPECT_EQ( 1, count );
+}
+
+TEST( BnProgressTest, callback_exception )
+{
+  auto filename = std::string{DATAPATH} + "s5378.blif";
+  BnProgressScope scope{[&](const BnProgress&) {
+    throw std::runtime_error{"stop"};
+  }, BnCancelToken{}, 0.0};
+  EXPECT_THROW( BnModel::read_blif(filename), std::runtime_error );
+}
+
+TEST( BnProgressTest, wrap_up_canceled )
+{
+  auto filename = std::string{DATAPATH} + "s5378.blif";
+  auto model = BnModel::read_blif(filename);
+  auto ref_str = to_str(model);
+
+  BnCancelToken token;
+  BnProgressScope scope{{}, token};
+  token.cancel();
+  EXPECT_THROW( model.wrap_up(), BnCanceled );
+
+  // 中断を取り消してやり直せばよい．
+  token.reset();
+  model.wrap_up();
+  EXPECT_EQ( ref_str, to_str(model) );
+}
+
+TEST( BnProgressTest, read_many_canceled )
+{
+  auto datapath = std::string{DATAPATH};
+  std::vector<std::string> filename_list{
+    datapath + "s5378.blif",
+    datapath + "b10.bench"
+  };
+  BnCancelToken token;
+  token.cancel();
+  BnProgressScope scope{{}, token};
+  EXPECT_THROW( BnModel::read_many(filename_list, "auto", 1), BnCanceled );
+  EXPECT_THROW( BnModel::read_many(filename_list, "auto", 2), BnCanceled );
+}
+
+TEST( BnProgressTest, read_many_cancel_from_callback )
+{
+  auto datapath = std::string{DATAPATH};
+  std::vector<std::string> filename_list;
+  for ( SizeType i = 0; i < 8; ++ i ) {
+    filename_list.push_back(datapath + "s5378.blif");
+  }
+  BnCancelToken token;
+  BnProgressScope scope{[&](const BnProgress&) {
+    token.cancel();
+  }, token, 0.0};
+  EXPECT_THROW( BnModel::read_many(filename_list, "auto", 4), BnCanceled );
+}
+
+TEST( BnProgressTest, read_many_callback_exception )
+{
+  auto datapath = std::string{DATAPATH};
+  std::vector<std::string> filename_list;
+  for ( SizeType i = 0; i < 8; ++ i ) {
+    filename_list.push_back(datapath + "s5378.blif");
+  }
+  // std::exception の派生クラスでなくてもそのまま送出される．
+  BnProgressScope scope{[&](const BnProgress&) {
+    throw 1;
+  }, BnCancelToken{}, 0.0};
+  EXPECT_THROW( BnModel::read_many(filename_list, "auto", 4), int );
+
+  // 読み込みのエラーは従来通り結果に記録される．
+  BnProgressScope scope2;
+  auto result_list = BnModel::read_many({datapath + "not_exist.blif"},
+					"blif", 2);
+  ASSERT_EQ( 1, result_list.size() );
+  EXPECT_FALSE( result_list[0].ok );
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,290 @@
+#ifndef BNTESTUTIL_H
+#define BNTESTUTIL_H
+
+/// @file BnTestUtil.h
+/// @brief BnModel のテストプログラムで共通に用いる関数
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include "ym/BnModel.h"
+#include "ym/BnNode.h"
+#include "ym/BnFunc.h"
+#include "ym/BnDff.h"
+#include "ym/SopCover.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+/// @brief 内容をテンポラリディレクトリのファイルに書き出してそのパスを返す．
+inline
+std::string
+make_file(
+  const std::string& filename, ///< [in] ファイル名
+  const std::string& contents  ///< [in] 内容
+)
+{
+  auto path = ::testing::TempDir() + filename;
+  std::ofstream s{path, std::ios::binary};
+  s << contents;
+  return path;
+}
+
+/// @brief プリミティブ型の関数を評価する．
+inline
+bool
+eval_primitive(
+  PrimType type,                 ///< [in] プリミティブ型
+  const std::vector<bool>& ivals ///< [in] 入力値のリスト
+)
+{
+  bool val = false;
+  switch ( type ) {
+  case PrimType::C0:   return false;
+  case PrimType::C1:   return true;
+  case PrimType::Buff: return ivals[0];
+  case PrimType::Not:  return !ivals[0];
+  case PrimType::And:
+  case PrimType::Nand:
+    val = true;
+    for ( auto v: ivals ) {
+      val = val && v;
+    }
+    return type == PrimType::And ? val : !val;
+  case PrimType::Or:
+  case PrimType::Nor:
+    for ( auto v: ivals ) {
+      val = val || v;
+    }
+    return type == PrimType::Or ? val : !val;
+  case PrimType::Xor:
+  case PrimType::Xnor:
+    for ( auto v: ivals ) {
+      val = val != v;
+    }
+    return type == PrimType::Xor ? val : !val;
+  default:
+    break;
+  }
+  return false;
+}
+
+/// @brief 論理ノードを評価する．
+inline
+bool
+eval_node(
+  const BnNode& node,                ///< [in] 対象のノード
+  const std::vector<bool>& val_array ///< [in] ノード番号をキーにした値の配列
+)
+{
+  std::vector<bool> ivals;
+  SizeType pos = 0;
+  for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+    bool v = val_array[node.fanin(i).id()];
+    ivals.push_back(v);
+    if ( v ) {
+      pos |= (1 << i);
+    }
+  }
+  auto func = node.func();
+  if ( func.is_primitive() ) {
+    return eval_primitive(func.primitive_type(), ivals);
+  }
+  if ( func.is_cover() ) {
+    // 大きなカバーもあるのでキューブごとに評価する．
+    auto& cover = func.input_cover();
+    bool v = false;
+    for ( auto& cube: cover.literal_list() ) {
+      bool cv = true;
+      for ( auto lit: cube ) {
+	if ( ivals[lit.varid()] == lit.is_negative() ) {
+	  cv = false;
+	  break;
+	}
+      }
+      if ( cv ) {
+	v = true;
+	break;
+      }
+    }
+    return v != func.output_inv();
+  }
+  if ( func.is_expr() ) {
+    return func.expr().tvfunc(node.fanin_num()).value(pos) != 0;
+  }
+  if ( func.is_tvfunc() ) {
+    return func.tvfunc().value(pos) != 0;
+  }
+  return false;
+}
+
+/// @brief 入力とDFFの値に対する外部出力とDFFの次状態を求める．
+///
+/// ivals は外部入力の値の後に DFF の出力の値を並べたもの
+inline
+std::vector<bool>
+simulate(
+  const BnModel& model,          ///< [in] 対象のモデル
+  const std::vector<bool>& ivals ///< [in] 入力値のリスト
+)
+{
+  std::vector<bool> val_array(model.node_num(), false);
+  SizeType pos = 0;
+  for ( auto node: model.input_list() ) {
+    val_array[node.id()] = ivals[pos];
+    ++ pos;
+  }
+  for ( SizeType i = 0; i < model.dff_num(); ++ i ) {
+    val_array[model.dff(i).output().id()] = ivals[pos];
+    ++ pos;
+  }
+  for ( auto node: model.logic_list() ) {
+    val_array[node.id()] = eval_node(node, val_array);
+  }
+  std::vector<bool> ans;
+  for ( auto node: model.output_list() ) {
+    ans.push_back(val_array[node.id()]);
+  }
+  for ( SizeType i = 0; i < model.dff_num(); ++ i ) {
+    ans.push_back(val_array[model.dff(i).input().id()]);
+  }
+  return ans;
+}
+
+/// @brief 2つのモデルの動作が等しいか調べる．
+///
+/// 入力数とDFF数の和が小さい時は全パタンを，
+/// そうでなければランダムなパタンを用いる．
+/// model2 は外部入力の後に値が結果に影響しない入力(クロックなど)を
+/// extra_num 個持っていてもよい．
+inline
+void
+check_sim_equiv(
+  const BnModel& model1, ///< [in] モデル1
+  const BnModel& model2, ///< [in] モデル2
+  SizeType extra_num = 0 ///< [in] model2 の余分な入力数
+)
+{
+  auto ni = model1.input_num();
+  auto nd = model1.dff_num();
+  ASSERT_EQ( ni + extra_num, model2.input_num() );
+  ASSERT_EQ( model1.output_num(), model2.output_num() );
+  ASSERT_EQ( nd, model2.dff_num() );
+
+  auto n = ni + nd;
+  std::vector<bool> ivals(n);
+  std::vector<bool> ivals2(n + extra_num, false);
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> rd{0, 1};
+  SizeType nc = n <= 10 ? (1 << n) : 200;
+  for ( SizeType c = 0; c < nc; ++ c ) {
+    for ( SizeType i = 0; i < n; ++ i ) {
+      ivals[i] = n <= 10 ? ((c >> i) & 1) : (rd(rg) == 1);
+    }
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      ivals2[i] = ivals[i];
+    }
+    for ( SizeType i = 0; i < nd; ++ i ) {
+      ivals2[ni + extra_num + i] = ivals[ni + i];
+    }
+    EXPECT_EQ( simulate(model1, ivals), simulate(model2, ivals2) )
+      << "pattern #" << c;
+  }
+}
+
+/// @brief 2つのモデルが等価か調べる．
+///
+/// 入出力とDFFの名前と動作を比較する．
+/// check_reset が false の時は DFF のリセット値を比較しない．
+inline
+void
+check_equiv(
+  const BnModel& model1,  ///< [in] モデル1
+  const BnModel& model2,  ///< [in] モデル2
+  bool check_reset = true ///< [in] リセット値を比較する時 true にする．
+)
+{
+  ASSERT_EQ( model1.input_num(), model2.input_num() );
+  ASSERT_EQ( model1.output_num(), model2.output_num() );
+  ASSERT_EQ( model1.dff_num(), model2.dff_num() );
+  for ( SizeType i = 0; i < model1.input_num(); ++ i ) {
+    EXPECT_EQ( model1.input_name(i), model2.input_name(i) );
+  }
+  for ( SizeType i = 0; i < model1.output_num(); ++ i ) {
+    EXPECT_EQ( model1.output_name(i), model2.output_name(i) );
+  }
+  for ( SizeType i = 0; i < model1.dff_num(); ++ i ) {
+    if ( check_reset ) {
+      EXPECT_EQ( model1.dff(i).reset_val(), model2.dff(i).reset_val() );
+    }
+    EXPECT_EQ( model1.dff_name(i), model2.dff_name(i) );
+  }
+  check_sim_equiv(model1, model2);
+}
+
+/// @brief 指定された形式で書き出して読み戻す．
+///
+/// format は "blif", "iscas89", "aag", "aig", "verilog", "snapshot" のいずれか
+/// 書き出した内容を contents に格納する．
+inline
+BnModel
+round_trip(
+  const BnModel& model,        ///< [in] 対象のモデル
+  const std::string& format,   ///< [in] 形式
+  const std::string& filename, ///< [in] ファイル名
+  std::string& contents        ///< [out] 書き出した内容
+)
+{
+  std::ostringstream buf;
+  if ( format == "blif" ) {
+    model.write_blif(buf);
+  }
+  else if ( format == "iscas89" ) {
+    model.write_iscas89(buf);
+  }
+  else if ( format == "aag" ) {
+    model.write_aag(buf);
+  }
+  else if ( format == "aig" ) {
+    model.write_aig(buf);
+  }
+  else if ( format == "verilog" ) {
+    model.write_verilog(buf);
+  }
+  else if ( format == "snapshot" ) {
+    model.save_snapshot(buf);
+  }
+  else {
+    ADD_FAILURE() << format << ": unknown format";
+    return BnModel{};
+  }
+  contents = buf.str();
+  auto path = make_file(filename, contents);
+  if ( format == "snapshot" ) {
+    return BnModel::load_snapshot(path);
+  }
+  return BnModel::read(path, format);
+}
+
+/// @brief 指定された形式で書き出して読み戻す．
+inline
+BnModel
+round_trip(
+  const BnModel& model,       ///< [in] 対象のモデル
+  const std::string& format,  ///< [in] 形式
+  const std::string& filename ///< [in] ファイル名
+)
+{
+  std::string contents;
+  return round_trip(model, format, filename, contents);
+}
+
+END_NAMESPACE_YM_BN
+
+#endif // BNTESTUTIL_H
@@ -130,7 +130,7 @@ TEST( ModelImplTest, new_logic )
   for ( SizeType i = 0; i < fanin_list.size(); ++ i ) {
     EXPECT_EQ( fanin_list[i], node.fanin_id(i) );
   }
-  EXPECT_EQ( fanin_list, node.fanin_id_list() );
+  EXPECT_EQ( fanin_list, node.fanin_id_list().to_vector() );
 }
 
 TEST( ModelImplTest, set_input )
@@ -162,7 +162,7 @@ TEST( ModelImplTest, set_logic )
   for ( SizeType i = 0; i < fanin_list.size(); ++ i ) {
     EXPECT_EQ( fanin_list[i], node.fanin_id(i) );
   }
-  EXPECT_EQ( fanin_list, node.fanin_id_list() );
+  EXPECT_EQ( fanin_list, node.fanin_id_list().to_vector() );
   EXPECT_EQ( func_id, node.func_id() );
 }
 
@@ -8,6 +8,7 @@
 
 #include "ym/BnNode.h"
 #include "ym/BnModel.h"
+#include "ym/BnNodeRef.h"
 #include "ModelImpl.h"
 
 
@@ -112,17 +113,79 @@ BnNode::fanin(
 std::vector<BnNode>
 BnNode::fanin_list() const
 {
-  auto& id_list = _node_impl().fanin_id_list();
+  auto id_list = _node_impl().fanin_id_list();
   return _id2node_list(id_list);
 }
 
-// @brief ノードの実体を返す．
-const NodeImpl&
-BnNode::_node_impl() const
+// @brief ファンインのノード番号のリストを返す．
+BnIdSpan
+BnNode::fanin_id_list() const
+{
+  return _node_impl().fanin_id_list();
+}
+
+// @brief ファンインのノードの借用参照のリストを返す．
+BnNodeRefList
+BnNode::fanin_ref_list() const
+{
+  return _id2ref_list(_node_impl().fanin_id_list());
+}
+
+// @brief レベルを返す．
+SizeType
+BnNode::level() const
+{
+  _check_valid();
+  return _model_impl().level(mId);
+}
+
+// @brief ファンアウト数を返す．
+SizeType
+BnNode::fanout_num() const
+{
+  _check_valid();
+  return _model_impl().fanout_num(mId);
+}
+
+// @brief ファンアウトのノード番号のリストを返す．
+BnIdSpan
+BnNode::fanout_id_list() const
+{
+  _check_valid();
+  return _model_impl().fanout_id_list(mId);
+}
+
+// @brief ファンアウトのノードの借用参照のリストを返す．
+BnNodeRefList
+BnNode::fanout_ref_list() const
+{
+  return _id2ref_list(fanout_id_list());
+}
+
+// @brief 借用参照を返す．
+BnNodeRef
+BnNode::ref() const
+{
+  if ( !is_valid() ) {
+    return BnNodeRef{};
+  }
+  return _id2ref(mId);
+}
+
+// @brief 適切な値を持っているかチェックする．
+void
+BnNode::_check_valid() const
 {
   if ( !is_valid() ) {
     throw std::logic_error{"BnNode: invalid data"};
   }
+}
+
+// @brief ノードの実体を返す．
+const NodeImpl&
+BnNode::_node_impl() const
+{
+  _check_valid();
   return _model_impl().node_impl(mId);
 }
 
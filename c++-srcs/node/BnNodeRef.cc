@@ -0,0 +1,163 @@
+
+/// @file BnNodeRef.cc
+/// @brief BnNodeRef の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnNodeRef.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNodeRef
+//////////////////////////////////////////////////////////////////////
+
+// @brief ノードの種類を返す．
+BnNode::Type
+BnNodeRef::type() const
+{
+  return _node_impl().type();
+}
+
+// @brief 入力ノードの時 true を返す．
+bool
+BnNodeRef::is_input() const
+{
+  return _node_impl().is_input();
+}
+
+// @brief 論理ノードの時 true を返す．
+bool
+BnNodeRef::is_logic() const
+{
+  return _node_impl().is_logic();
+}
+
+// @brief 外部入力ノードの時 true を返す．
+bool
+BnNodeRef::is_primary_input() const
+{
+  return _node_impl().is_primary_input();
+}
+
+// @brief DFFの出力ノードの時 true を返す．
+bool
+BnNodeRef::is_dff_output() const
+{
+  return _node_impl().is_dff_output();
+}
+
+// @brief 入力番号を返す．
+SizeType
+BnNodeRef::input_id() const
+{
+  return _node_impl().input_id();
+}
+
+// @brief DFF番号を返す．
+SizeType
+BnNodeRef::dff_id() const
+{
+  return _node_impl().dff_id();
+}
+
+// @brief 関数番号を返す．
+SizeType
+BnNodeRef::func_id() const
+{
+  return _node_impl().func_id();
+}
+
+// @brief ファンイン数を返す．
+SizeType
+BnNodeRef::fanin_num() const
+{
+  return _node_impl().fanin_num();
+}
+
+// @brief ファンインのノード番号を返す．
+SizeType
+BnNodeRef::fanin_id(
+  SizeType pos
+) const
+{
+  return _node_impl().fanin_id(pos);
+}
+
+// @brief ファンインのノードを返す．
+BnNodeRef
+BnNodeRef::fanin(
+  SizeType pos
+) const
+{
+  auto id = _node_impl().fanin_id(pos);
+  return BnNodeRef{mModel, id};
+}
+
+// @brief ファンインのノード番号のリストを返す．
+BnIdSpan
+BnNodeRef::fanin_id_list() const
+{
+  return _node_impl().fanin_id_list();
+}
+
+// @brief ファンインのノードのリストを返す．
+BnNodeRefList
+BnNodeRef::fanin_list() const
+{
+  return BnNodeRefList{mModel, fanin_id_list()};
+}
+
+// @brief レベルを返す．
+SizeType
+BnNodeRef::level() const
+{
+  _check_valid();
+  return mModel->level(mId);
+}
+
+// @brief ファンアウト数を返す．
+SizeType
+BnNodeRef::fanout_num() const
+{
+  _check_valid();
+  return mModel->fanout_num(mId);
+}
+
+// @brief ファンアウトのノード番号のリストを返す．
+BnIdSpan
+BnNodeRef::fanout_id_list() const
+{
+  _check_valid();
+  return mModel->fanout_id_list(mId);
+}
+
+// @brief ファンアウトのノードのリストを返す．
+BnNodeRefList
+BnNodeRef::fanout_list() const
+{
+  return BnNodeRefList{mModel, fanout_id_list()};
+}
+
+// @brief 適切な値を持っているかチェックする．
+void
+BnNodeRef::_check_valid() const
+{
+  if ( !is_valid() ) {
+    throw std::logic_error{"BnNodeRef: invalid data"};
+  }
+}
+
+// @brief ノードの実体を返す．
+const NodeImpl&
+BnNodeRef::_node_impl() const
+{
+  _check_valid();
+  return mModel->node_impl(mId);
+}
+
+END_NAMESPACE_YM_BN
@@ -44,6 +44,16 @@ NodeImpl::new_logic(
   return new NodeImpl_Logic(func_id, fanin_list);
 }
 
+// @brief 論理ノードを作る．
+NodeImpl*
+NodeImpl::new_logic(
+  SizeType func_id,
+  std::vector<BnIdType>&& fanin_list
+)
+{
+  return new NodeImpl_Logic(func_id, std::move(fanin_list));
+}
+
 // @brief 入力ノードの時 true を返す．
 bool
 NodeImpl::is_input() const
@@ -110,12 +120,11 @@ NodeImpl::fanin_id(
 }
 
 // @brief ファンイン番号のリストを返す．
-const std::vector<SizeType>&
+BnIdSpan
 NodeImpl::fanin_id_list() const
 {
-  // 空のダミー
-  static std::vector<SizeType> _;
-  return _;
+  // 空のリスト
+  return BnIdSpan{};
 }
 
 
@@ -232,8 +241,17 @@ NodeImpl_DffOutput::copy() const
 NodeImpl_Logic::NodeImpl_Logic(
   SizeType func_id,
   const std::vector<SizeType>& fanin_list
-) : mFuncId{func_id},
-    mFaninList{fanin_list}
+) : mFuncId{static_cast<BnIdType>(func_id)},
+    mFaninList(fanin_list.begin(), fanin_list.end())
+{
+}
+
+// @brief コンストラクタ
+NodeImpl_Logic::NodeImpl_Logic(
+  SizeType func_id,
+  std::vector<BnIdType>&& fanin_list
+) : mFuncId{static_cast<BnIdType>(func_id)},
+    mFaninList{std::move(fanin_list)}
 {
 }
 
@@ -283,7 +301,7 @@ NodeImpl_Logic::fanin_id(
 }
 
 // @brief ファンイン番号のリストを返す．
-const std::vector<SizeType>&
+BnIdSpan
 NodeImpl_Logic::fanin_id_list() const
 {
   return mFaninList;
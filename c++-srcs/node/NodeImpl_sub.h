@@ -156,6 +156,14 @@ public:
     const std::vector<SizeType>& fanin_list ///< [in] ファンインのリスト
   );
 
+  /// @brief コンストラクタ
+  ///
+  /// fanin_list の内容はムーブされる．
+  NodeImpl_Logic(
+    SizeType func_id,                  ///< [in] 関数番号
+    std::vector<BnIdType>&& fanin_list ///< [in] ファンインのリスト
+  );
+
   /// @brief デストラクタ
   ~NodeImpl_Logic();
 
@@ -188,7 +196,7 @@ public:
   ) const override;
 
   /// @brief ファンイン番号のリストを返す．
-  const std::vector<SizeType>&
+  BnIdSpan
   fanin_id_list() const override;
 
   /// @brief 複製を作る．
@@ -202,10 +210,10 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // 関数番号
-  SizeType mFuncId;
+  BnIdType mFuncId;
 
   // ファンインのリスト
-  std::vector<SizeType> mFaninList;
+  std::vector<BnIdType> mFaninList;
 
 };
 
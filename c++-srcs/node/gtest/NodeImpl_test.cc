@@ -31,7 +31,7 @@ TEST( NodeImplTest, primary_input )
   EXPECT_THROW( node->func_id(), std::invalid_argument );
   EXPECT_EQ( 0, node->fanin_num() );
   EXPECT_THROW( node->fanin_id(0), std::out_of_range );
-  EXPECT_EQ( std::vector<SizeType>{}, node->fanin_id_list() );
+  EXPECT_EQ( std::vector<SizeType>{}, node->fanin_id_list().to_vector() );
 }
 
 TEST( NodeImplTest, dff_output )
@@ -52,7 +52,7 @@ TEST( NodeImplTest, dff_output )
   EXPECT_THROW( node->func_id(), std::invalid_argument );
   EXPECT_EQ( 0, node->fanin_num() );
   EXPECT_THROW( node->fanin_id(0), std::out_of_range );
-  EXPECT_EQ( std::vector<SizeType>{}, node->fanin_id_list() );
+  EXPECT_EQ( std::vector<SizeType>{}, node->fanin_id_list().to_vector() );
 }
 
 TEST( NodeImplTest, logic )
@@ -76,7 +76,7 @@ TEST( NodeImplTest, logic )
   for ( SizeType i = 0; i < fanin_list.size(); ++ i ) {
     EXPECT_EQ( fanin_list[i], node->fanin_id(i) );
   }
-  EXPECT_EQ( fanin_list, node->fanin_id_list() );
+  EXPECT_EQ( fanin_list, node->fanin_id_list().to_vector() );
 }
 
 END_NAMESPACE_YM_BN
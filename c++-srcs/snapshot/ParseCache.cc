@@ -0,0 +1,181 @@
+
+/// @file ParseCache.cc
+/// @brief ParseCache の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ParseCache.h"
+#include "MappedFile.h"
+#include "ReadOption.h"
+#include "SnapshotFormat.h"
+#include "ym/BnModel.h"
+#include <filesystem>
+#include <iomanip>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+const std::uint64_t HASH_PRIME = 0x100000001b3ULL;
+const std::uint64_t HASH_BASIS = 0xcbf29ce484222325ULL;
+
+// ハッシュ値に値を混ぜる．
+inline
+std::uint64_t
+hash_mix(
+  std::uint64_t h,
+  std::uint64_t val
+)
+{
+  h ^= val;
+  h *= HASH_PRIME;
+  h ^= h >> 29;
+  return h;
+}
+
+// バイト列のハッシュ値を求める．
+//
+// 8バイトずつ処理する FNV 風のハッシュ関数
+std::uint64_t
+hash_bytes(
+  std::uint64_t h,
+  const char* begin,
+  SizeType size
+)
+{
+  auto p = begin;
+  auto end = begin + size;
+  for ( ; end - p >= 8; p += 8 ) {
+    std::uint64_t val;
+    std::memcpy(&val, p, 8);
+    h = hash_mix(h, val);
+  }
+  std::uint64_t val = 0;
+  std::memcpy(&val, p, end - p);
+  h = hash_mix(h, val);
+  return hash_mix(h, size);
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス ParseCache
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+ParseCache::ParseCache(
+  const std::string& filename,
+  const char* format,
+  const JsonValue& option
+)
+{
+  ReadOption read_option{option};
+  if ( read_option.cache_dir.empty() ) {
+    return;
+  }
+
+  // 圧縮されたファイルは展開せずにハッシュ値を求める．
+  MappedFile file;
+  if ( !file.open(filename, read_option.use_mmap, false) ) {
+    return;
+  }
+
+  // 結果に影響するもののみをキーに含める．
+  bool strash = false;
+  if ( option.is_object() && option.has_key("strash") ) {
+    strash = option.at("strash").get_bool();
+  }
+  std::ostringstream key_buf;
+  key_buf << format
+	  << ":strash=" << (strash ? 1 : 0);
+  if ( !read_option.output_filter.empty() ) {
+    key_buf << ":outputs=";
+    for ( auto& name: read_option.output_filter ) {
+      key_buf << name.size() << "/" << name;
+    }
+  }
+  key_buf << ":snapshot=" << SNAPSHOT_VERSION;
+  auto key = key_buf.str();
+
+  // 独立な2つのハッシュ値を用いて衝突の可能性を下げる．
+  auto h1 = hash_bytes(HASH_BASIS, key.data(), key.size());
+  h1 = hash_bytes(h1, file.begin(), file.size());
+  auto h2 = hash_bytes(~HASH_BASIS, file.begin(), file.size());
+  h2 = hash_bytes(h2, key.data(), key.size());
+
+  std::ostringstream buf;
+  buf << read_option.cache_dir << "/"
+      << format << "-"
+      << std::hex << std::setfill('0')
+      << std::setw(16) << h1
+      << std::setw(16) << h2
+      << ".snap";
+  mPath = buf.str();
+}
+
+// @brief キャッシュから読み込む．
+bool
+ParseCache::load(
+  BnModel& model
+) const
+{
+  if ( !is_enabled() ) {
+    return false;
+  }
+  std::error_code ec;
+  if ( !std::filesystem::exists(mPath, ec) ) {
+    return false;
+  }
+  try {
+    model = BnModel::load_snapshot(mPath);
+  }
+  catch ( std::invalid_argument& ) {
+    // 壊れたエントリは削除して作り直す．
+    std::filesystem::remove(mPath, ec);
+    return false;
+  }
+  return true;
+}
+
+// @brief キャッシュに保存する．
+void
+ParseCache::save(
+  const BnModel& model
+) const
+{
+  if ( !is_enabled() ) {
+    return;
+  }
+
+  std::error_code ec;
+  auto path = std::filesystem::path{mPath};
+  std::filesystem::create_directories(path.parent_path(), ec);
+
+  // 一時ファイルに書いてから置き換える．
+  std::random_device rd;
+  std::ostringstream buf;
+  buf << mPath << ".tmp" << std::hex << rd();
+  auto tmp_path = buf.str();
+  {
+    std::ofstream s{tmp_path, std::ios::binary};
+    if ( !s ) {
+      return;
+    }
+    model.save_snapshot(s);
+    if ( !s ) {
+      s.close();
+      std::filesystem::remove(tmp_path, ec);
+      return;
+    }
+  }
+  std::filesystem::rename(tmp_path, path, ec);
+  if ( ec ) {
+    std::filesystem::remove(tmp_path, ec);
+  }
+}
+
+END_NAMESPACE_YM_BN
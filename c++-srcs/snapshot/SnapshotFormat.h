@@ -0,0 +1,126 @@
+#ifndef SNAPSHOTFORMAT_H
+#define SNAPSHOTFORMAT_H
+
+/// @file SnapshotFormat.h
+/// @brief スナップショットのファイル形式の定義
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// スナップショットのファイル形式
+//
+// 先頭に SnapshotHeader があり，その後に以下のセクションが順に並ぶ．
+// 各セクションの先頭は 8 バイト境界に揃えられる．
+// 数値はすべてネイティブのバイト順で書かれる(byte_order で判別する)．
+//
+//  1. 文字列の開始位置   uint64[string_num + 1]
+//  2. 文字列の本体       char[string_size]
+//  3. ノードの関数番号   uint32[node_num] (論理ノード以外は SNAPSHOT_NONE)
+//  4. ファンインの開始位置 uint64[node_num + 1]
+//  5. ファンインのリスト uint32[fanin_num]
+//  6. ノード名           uint32[node_num] (文字列番号)
+//  7. 入力のノード番号   uint32[input_num]
+//  8. 出力のノード番号   uint32[output_num]
+//  9. 出力名             uint32[output_num] (文字列番号)
+// 10. DFF の情報         uint32[dff_num * 4] (名前, 出力, 入力, リセット値)
+// 11. 論理ノードのリスト uint32[logic_num]
+// 12. コメント           uint32[comment_num] (文字列番号)
+// 13. 関数の開始位置     uint64[func_num + 1]
+// 14. 関数の本体         uint8[func_size]
+//
+// 関数の本体は種類を表す1バイトに続いて uint32 の列で内容を表す．
+// - プリミティブ: 入力数, PrimType
+// - カバー: 入力数, 出力の反転属性, キューブ数, (リテラル数, リテラル...)...
+// - 論理式: 前置記法で演算子(SnapshotExprOp)とオペランド数/変数番号を並べる．
+// - 真理値表: 入力数, 文字数, TvFunc::str() の文字列
+// - BDD: ノード数, (変数番号, 0枝, 1枝)... 枝は 0, 1 が定数，
+//        それ以外は 2 + ノード番号を表す．最後のノードが根となる．
+//        定数の場合はノード数 0 に続けて定数値を置く．
+//////////////////////////////////////////////////////////////////////
+
+/// @brief マジックナンバー
+static const char SNAPSHOT_MAGIC[8] = {'Y', 'M', 'B', 'N', 'S', 'N', 'A', 'P'};
+
+/// @brief 形式のバージョン番号
+///
+/// 形式を変更した場合には必ず増やすこと．
+const std::uint32_t SNAPSHOT_VERSION = 1;
+
+/// @brief バイト順の判別用の値
+const std::uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+/// @brief 該当なしを表す値
+const std::uint32_t SNAPSHOT_NONE = 0xFFFFFFFF;
+
+/// @brief フラグ: 構造ハッシュのモード
+const std::uint32_t SNAPSHOT_FLAG_STRASH = 1;
+
+/// @brief フラグ: 凍結されている
+const std::uint32_t SNAPSHOT_FLAG_FROZEN = 2;
+
+/// @brief 関数の種類を表す値
+enum class SnapshotFuncType : std::uint8_t {
+  Primitive = 0,
+  Cover     = 1,
+  Expr      = 2,
+  TvFunc    = 3,
+  Bdd       = 4
+};
+
+/// @brief 論理式の演算子を表す値
+enum class SnapshotExprOp : std::uint32_t {
+  Zero     = 0,
+  One      = 1,
+  PosiLit  = 2,
+  NegaLit  = 3,
+  And      = 4,
+  Or       = 5,
+  Xor      = 6
+};
+
+//////////////////////////////////////////////////////////////////////
+/// @class SnapshotHeader SnapshotFormat.h "SnapshotFormat.h"
+/// @brief スナップショットのヘッダ
+//////////////////////////////////////////////////////////////////////
+struct SnapshotHeader
+{
+  char magic[8];              ///< マジックナンバー
+  std::uint32_t version;      ///< バージョン番号
+  std::uint32_t byte_order;   ///< バイト順の判別用の値
+  std::uint32_t flags;        ///< フラグ
+  std::uint32_t name;         ///< モデル名の文字列番号
+  std::uint64_t file_size;    ///< ファイル全体のサイズ
+  std::uint64_t string_num;   ///< 文字列数
+  std::uint64_t string_size;  ///< 文字列の本体のサイズ
+  std::uint64_t node_num;     ///< ノード数
+  std::uint64_t fanin_num;    ///< ファンインの総数
+  std::uint64_t input_num;    ///< 入力数
+  std::uint64_t output_num;   ///< 出力数
+  std::uint64_t dff_num;      ///< DFF数
+  std::uint64_t logic_num;    ///< 論理ノード数
+  std::uint64_t comment_num;  ///< コメント数
+  std::uint64_t func_num;     ///< 関数の数
+  std::uint64_t func_size;    ///< 関数の本体のサイズ
+};
+
+/// @brief セクションの境界に揃える．
+inline
+std::uint64_t
+snapshot_align(
+  std::uint64_t size ///< [in] サイズ
+)
+{
+  return (size + 7) & ~static_cast<std::uint64_t>(7);
+}
+
+END_NAMESPACE_YM_BN
+
+#endif // SNAPSHOTFORMAT_H
@@ -0,0 +1,486 @@
+
+/// @file SnapshotReader.cc
+/// @brief SnapshotReader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "SnapshotReader.h"
+#include "MappedFile.h"
+#include "ym/BnModel.h"
+#include "ym/SopCover.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/Bdd.h"
+#include "ym/BddMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+// @brief スナップショットを読み込む．
+BnModel
+BnModel::load_snapshot(
+  const std::string& filename
+)
+{
+  MappedFile file;
+  if ( !file.open(filename) ) {
+    std::ostringstream buf;
+    buf << "BnModel::load_snapshot(\"" << filename << "\"): "
+	<< "No such file.";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  const char* begin = file.begin();
+  std::vector<std::uint64_t> aligned_buff;
+  if ( reinterpret_cast<std::uintptr_t>(begin) % sizeof(std::uint64_t) != 0 ) {
+    // 境界が揃っていない場合はコピーする．
+    aligned_buff.resize((file.size() + 7) / 8);
+    std::memcpy(aligned_buff.data(), begin, file.size());
+    begin = reinterpret_cast<const char*>(aligned_buff.data());
+  }
+
+  BnModel model;
+  SnapshotReader reader{model._model_impl()};
+  try {
+    reader.read(begin, file.size());
+  }
+  catch ( std::invalid_argument& err ) {
+    std::ostringstream buf;
+    buf << "BnModel::load_snapshot(\"" << filename << "\"): "
+	<< err.what();
+    throw std::invalid_argument{buf.str()};
+  }
+  return model;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SnapshotReader
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SnapshotReader::SnapshotReader(
+  ModelImpl& model
+) : mModel{model}
+{
+}
+
+// @brief 読み込む．
+void
+SnapshotReader::read(
+  const char* begin,
+  SizeType size
+)
+{
+  mBegin = begin;
+  mSize = size;
+  mPos = 0;
+
+  // ヘッダのチェック
+  if ( size < sizeof(SnapshotHeader) ) {
+    error("not a snapshot file");
+  }
+  auto& header = *section<SnapshotHeader>(1);
+  if ( std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ) {
+    error("not a snapshot file");
+  }
+  if ( header.byte_order != SNAPSHOT_BYTE_ORDER ) {
+    error("byte order mismatch");
+  }
+  if ( header.version != SNAPSHOT_VERSION ) {
+    error("unsupported snapshot version");
+  }
+  if ( header.file_size != size ) {
+    error("file size mismatch");
+  }
+
+  // セクションの取り出し
+  mStringNum = header.string_num;
+  mStringBegin = section<std::uint64_t>(header.string_num + 1);
+  mStringData = section<char>(header.string_size);
+  auto node_num = header.node_num;
+  auto func_array = section<std::uint32_t>(node_num);
+  auto fanin_begin = section<std::uint64_t>(node_num + 1);
+  auto fanin_list = section<std::uint32_t>(header.fanin_num);
+  auto name_array = section<std::uint32_t>(node_num);
+  auto input_list = section<std::uint32_t>(header.input_num);
+  auto output_list = section<std::uint32_t>(header.output_num);
+  auto output_name_list = section<std::uint32_t>(header.output_num);
+  auto dff_array = section<std::uint32_t>(header.dff_num * 4);
+  auto logic_list = section<std::uint32_t>(header.logic_num);
+  auto comment_list = section<std::uint32_t>(header.comment_num);
+  auto func_begin = section<std::uint64_t>(header.func_num + 1);
+  auto func_data = section<char>(header.func_size);
+
+  if ( mStringBegin[0] != 0 || mStringBegin[mStringNum] != header.string_size ) {
+    error("broken string table");
+  }
+  for ( SizeType i = 0; i < mStringNum; ++ i ) {
+    if ( mStringBegin[i] > mStringBegin[i + 1] ) {
+      error("broken string table");
+    }
+  }
+
+  // 関数
+  // 同じ関数は同じ番号になるはずだが念のため番号の対応表を作る．
+  if ( func_begin[0] != 0 || func_begin[header.func_num] != header.func_size ) {
+    error("broken function table");
+  }
+  std::vector<SizeType> func_map(header.func_num);
+  for ( SizeType i = 0; i < header.func_num; ++ i ) {
+    if ( func_begin[i] > func_begin[i + 1] ) {
+      error("broken function table");
+    }
+    func_map[i] = decode_func(func_data + func_begin[i],
+			      func_data + func_begin[i + 1]);
+  }
+
+  // ノード
+  if ( node_num >= BNID_LIMIT ) {
+    error("too many nodes");
+  }
+  mModel.reserve(node_num);
+  for ( SizeType i = 0; i < node_num; ++ i ) {
+    mModel.alloc_node();
+  }
+
+  // DFF
+  for ( SizeType i = 0; i < header.dff_num; ++ i ) {
+    auto p = dff_array + i * 4;
+    auto reset_val = static_cast<char>(p[3]);
+    if ( reset_val != 'X' && reset_val != '0' && reset_val != '1' ) {
+      error("broken dff table");
+    }
+    mModel.new_dff(get_string(p[0]), reset_val);
+  }
+
+  // 入力
+  for ( SizeType i = 0; i < header.input_num; ++ i ) {
+    auto id = check_node_id(input_list[i]);
+    if ( mModel.is_defined(id) ) {
+      error("node is multiply defined");
+    }
+    mModel.set_input(id);
+  }
+
+  // DFFの出力と入力
+  for ( SizeType i = 0; i < header.dff_num; ++ i ) {
+    auto p = dff_array + i * 4;
+    if ( p[1] != SNAPSHOT_NONE ) {
+      auto id = check_node_id(p[1]);
+      if ( mModel.is_defined(id) ) {
+	error("node is multiply defined");
+      }
+      mModel.set_dff_output(id, i);
+    }
+    if ( p[2] != SNAPSHOT_NONE ) {
+      mModel.set_dff_src(i, check_node_id(p[2]));
+    }
+  }
+
+  // 論理ノード
+  if ( fanin_begin[0] != 0 || fanin_begin[node_num] != header.fanin_num ) {
+    error("broken fanin table");
+  }
+  for ( SizeType id = 0; id < node_num; ++ id ) {
+    auto fbegin = fanin_begin[id];
+    auto fend = fanin_begin[id + 1];
+    if ( fbegin > fend ) {
+      error("broken fanin table");
+    }
+    auto func_id = func_array[id];
+    if ( func_id == SNAPSHOT_NONE ) {
+      if ( fbegin != fend || !mModel.is_defined(id) ) {
+	error("broken node table");
+      }
+      continue;
+    }
+    if ( func_id >= header.func_num || mModel.is_defined(id) ) {
+      error("broken node table");
+    }
+    std::vector<BnIdType> fanins(fanin_list + fbegin, fanin_list + fend);
+    for ( auto iid: fanins ) {
+      check_node_id(iid);
+    }
+    mModel.set_logic(id, func_map[func_id], std::move(fanins));
+  }
+
+  // ノード名
+  for ( SizeType id = 0; id < node_num; ++ id ) {
+    auto name = get_string(name_array[id]);
+    if ( !name.empty() ) {
+      mModel.set_node_name(id, name);
+    }
+  }
+
+  // 出力
+  for ( SizeType i = 0; i < header.output_num; ++ i ) {
+    mModel.new_output(check_node_id(output_list[i]),
+		      get_string(output_name_list[i]));
+  }
+
+  // 論理ノードのリストは保存されている順序をそのまま用いる．
+  std::vector<BnIdType> logic_id_list(logic_list, logic_list + header.logic_num);
+  for ( auto id: logic_id_list ) {
+    check_node_id(id);
+    if ( func_array[id] == SNAPSHOT_NONE ) {
+      error("broken logic list");
+    }
+  }
+  mModel.set_logic_list(std::move(logic_id_list));
+  if ( header.flags & SNAPSHOT_FLAG_STRASH ) {
+    // 構造ハッシュの辞書を作り直す．
+    mModel.set_strash(true);
+    mModel.make_logic_list();
+  }
+
+  // その他の情報
+  mModel.set_name(get_string(header.name));
+  for ( SizeType i = 0; i < header.comment_num; ++ i ) {
+    mModel.add_comment(get_string(comment_list[i]));
+  }
+
+  if ( header.flags & SNAPSHOT_FLAG_FROZEN ) {
+    mModel.freeze();
+  }
+}
+
+// @brief 文字列を返す．
+std::string
+SnapshotReader::get_string(
+  std::uint32_t str_id
+)
+{
+  if ( str_id >= mStringNum ) {
+    error("string id is out of range");
+  }
+  auto b = mStringBegin[str_id];
+  auto e = mStringBegin[str_id + 1];
+  return std::string{mStringData + b, mStringData + e};
+}
+
+BEGIN_NONAMESPACE
+
+// 関数の本体を読み出すクラス
+class FuncDecoder
+{
+public:
+
+  // コンストラクタ
+  FuncDecoder(
+    const char* begin,
+    const char* end
+  ) : mPos{begin},
+      mEnd{end}
+  {
+  }
+
+  // 1バイト読み出す．
+  std::uint8_t
+  get_u8()
+  {
+    if ( mPos >= mEnd ) {
+      throw std::invalid_argument{"broken function table"};
+    }
+    auto val = static_cast<std::uint8_t>(*mPos);
+    ++ mPos;
+    return val;
+  }
+
+  // uint32 を読み出す．
+  std::uint32_t
+  get_u32()
+  {
+    if ( mEnd - mPos < static_cast<std::ptrdiff_t>(sizeof(std::uint32_t)) ) {
+      throw std::invalid_argument{"broken function table"};
+    }
+    std::uint32_t val;
+    std::memcpy(&val, mPos, sizeof(std::uint32_t));
+    mPos += sizeof(std::uint32_t);
+    return val;
+  }
+
+  // 文字列を読み出す．
+  std::string
+  get_str(
+    SizeType size
+  )
+  {
+    if ( static_cast<SizeType>(mEnd - mPos) < size ) {
+      throw std::invalid_argument{"broken function table"};
+    }
+    std::string str{mPos, mPos + size};
+    mPos += size;
+    return str;
+  }
+
+  // 末尾まで読んだか調べる．
+  bool
+  is_end() const
+  {
+    return mPos == mEnd;
+  }
+
+  // 論理式を読み出す．
+  Expr
+  get_expr()
+  {
+    auto op = static_cast<SnapshotExprOp>(get_u32());
+    switch ( op ) {
+    case SnapshotExprOp::Zero: return Expr::zero();
+    case SnapshotExprOp::One:  return Expr::one();
+    case SnapshotExprOp::PosiLit: return Expr::literal(get_u32(), false);
+    case SnapshotExprOp::NegaLit: return Expr::literal(get_u32(), true);
+    case SnapshotExprOp::And:
+    case SnapshotExprOp::Or:
+    case SnapshotExprOp::Xor:
+      break;
+    default:
+      throw std::invalid_argument{"broken function table"};
+    }
+    auto n = get_u32();
+    if ( n == 0 ) {
+      throw std::invalid_argument{"broken function table"};
+    }
+    auto expr = get_expr();
+    for ( SizeType i = 1; i < n; ++ i ) {
+      auto opr = get_expr();
+      if ( op == SnapshotExprOp::And ) {
+	expr = expr & opr;
+      }
+      else if ( op == SnapshotExprOp::Or ) {
+	expr = expr | opr;
+      }
+      else {
+	expr = expr ^ opr;
+      }
+    }
+    return expr;
+  }
+
+
+private:
+
+  // 次に読み出す位置
+  const char* mPos;
+
+  // 末尾
+  const char* mEnd;
+
+};
+
+END_NONAMESPACE
+
+// @brief 関数を復元して登録する．
+SizeType
+SnapshotReader::decode_func(
+  const char* begin,
+  const char* end
+)
+{
+  FuncDecoder dec{begin, end};
+  SizeType func_id = 0;
+  auto type = static_cast<SnapshotFuncType>(dec.get_u8());
+  switch ( type ) {
+  case SnapshotFuncType::Primitive:
+    {
+      auto ni = dec.get_u32();
+      auto prim = dec.get_u32();
+      if ( prim > static_cast<std::uint32_t>(PrimType::Xnor) ) {
+	error("broken function table");
+      }
+      func_id = mModel.reg_primitive(ni, static_cast<PrimType>(prim));
+    }
+    break;
+
+  case SnapshotFuncType::Cover:
+    {
+      auto ni = dec.get_u32();
+      bool inv = dec.get_u32() != 0;
+      auto nc = dec.get_u32();
+      std::vector<std::vector<Literal>> cube_list(nc);
+      for ( auto& cube: cube_list ) {
+	auto nl = dec.get_u32();
+	cube.reserve(nl);
+	for ( SizeType i = 0; i < nl; ++ i ) {
+	  auto code = dec.get_u32();
+	  auto var = code / 2;
+	  if ( var >= ni ) {
+	    error("broken function table");
+	  }
+	  cube.push_back(Literal{var, (code % 2) == 1});
+	}
+      }
+      func_id = mModel.reg_cover(SopCover{ni, cube_list}, inv);
+    }
+    break;
+
+  case SnapshotFuncType::Expr:
+    func_id = mModel.reg_expr(dec.get_expr());
+    break;
+
+  case SnapshotFuncType::TvFunc:
+    {
+      auto ni = dec.get_u32();
+      auto len = dec.get_u32();
+      TvFunc func{dec.get_str(len)};
+      if ( func.input_num() != ni ) {
+	error("broken function table");
+      }
+      func_id = mModel.reg_tvfunc(func);
+    }
+    break;
+
+  case SnapshotFuncType::Bdd:
+    {
+      BddMgr mgr;
+      auto nn = dec.get_u32();
+      std::vector<Bdd> node_list;
+      node_list.reserve(nn);
+      auto edge = [&](std::uint32_t e) -> Bdd {
+	if ( e == 0 ) {
+	  return mgr.zero();
+	}
+	if ( e == 1 ) {
+	  return mgr.one();
+	}
+	if ( e - 2 >= node_list.size() ) {
+	  error("broken function table");
+	}
+	return node_list[e - 2];
+      };
+      if ( nn == 0 ) {
+	func_id = mModel.reg_bdd(edge(dec.get_u32()));
+	break;
+      }
+      for ( SizeType i = 0; i < nn; ++ i ) {
+	auto var = mgr.variable(dec.get_u32());
+	auto bdd0 = edge(dec.get_u32());
+	auto bdd1 = edge(dec.get_u32());
+	node_list.push_back((~var & bdd0) | (var & bdd1));
+      }
+      func_id = mModel.reg_bdd(node_list.back());
+    }
+    break;
+
+  default:
+    error("broken function table");
+  }
+  if ( !dec.is_end() ) {
+    error("broken function table");
+  }
+  return func_id;
+}
+
+// @brief エラーを送出する．
+void
+SnapshotReader::error(
+  const char* msg
+)
+{
+  throw std::invalid_argument{msg};
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,146 @@
+#ifndef SNAPSHOTREADER_H
+#define SNAPSHOTREADER_H
+
+/// @file SnapshotReader.h
+/// @brief SnapshotReader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ModelImpl.h"
+#include "SnapshotFormat.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class SnapshotReader SnapshotReader.h "SnapshotReader.h"
+/// @brief スナップショットから ModelImpl を復元するクラス
+///
+/// メモリ上に展開された(通常は mmap() された)ファイルの内容を
+/// その場で参照しながら復元する．
+/// 字句解析や名前の照合は行わず，各表はそのまま ModelImpl に設定する．
+/// 論理ノードのリストも保存された順序をそのまま用いる．
+///
+/// 内容が壊れている場合は std::invalid_argument 例外を送出する．
+//////////////////////////////////////////////////////////////////////
+class SnapshotReader
+{
+public:
+
+  /// @brief コンストラクタ
+  SnapshotReader(
+    ModelImpl& model ///< [in] 結果を格納するオブジェクト
+  );
+
+  /// @brief デストラクタ
+  ~SnapshotReader() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込む．
+  ///
+  /// begin は 8 バイト境界に揃っている必要がある．
+  void
+  read(
+    const char* begin, ///< [in] 内容の先頭
+    SizeType size      ///< [in] 内容のサイズ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 次のセクションを取り出す．
+  template<typename T>
+  const T*
+  section(
+    std::uint64_t num ///< [in] 要素数
+  )
+  {
+    if ( num > (mSize - mPos) / sizeof(T) ) {
+      error("unexpected end of file");
+    }
+    auto p = reinterpret_cast<const T*>(mBegin + mPos);
+    mPos += snapshot_align(num * sizeof(T));
+    if ( mPos > mSize ) {
+      mPos = mSize;
+    }
+    return p;
+  }
+
+  /// @brief 文字列を返す．
+  std::string
+  get_string(
+    std::uint32_t str_id ///< [in] 文字列番号
+  );
+
+  /// @brief 関数を復元して登録する．
+  /// @return 関数番号を返す．
+  SizeType
+  decode_func(
+    const char* begin, ///< [in] 関数の本体の先頭
+    const char* end    ///< [in] 関数の本体の末尾
+  );
+
+  /// @brief ノード番号をチェックする．
+  SizeType
+  check_node_id(
+    std::uint32_t id ///< [in] ノード番号
+  )
+  {
+    if ( id >= mModel.node_num() ) {
+      error("node id is out of range");
+    }
+    return id;
+  }
+
+  /// @brief エラーを送出する．
+  [[noreturn]]
+  static
+  void
+  error(
+    const char* msg ///< [in] メッセージ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 結果を格納するオブジェクト
+  ModelImpl& mModel;
+
+  // 内容の先頭
+  const char* mBegin{nullptr};
+
+  // 内容のサイズ
+  SizeType mSize{0};
+
+  // 次のセクションの位置
+  SizeType mPos{0};
+
+  // 文字列の開始位置の配列
+  const std::uint64_t* mStringBegin{nullptr};
+
+  // 文字列の本体
+  const char* mStringData{nullptr};
+
+  // 文字列数
+  SizeType mStringNum{0};
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // SNAPSHOTREADER_H
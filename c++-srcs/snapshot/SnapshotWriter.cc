@@ -0,0 +1,384 @@
+
+/// @file SnapshotWriter.cc
+/// @brief SnapshotWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "SnapshotWriter.h"
+#include "BufWriter.h"
+#include "ym/BnModel.h"
+#include "ym/SopCover.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/Bdd.h"
+#include "ym/BddVar.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+// @brief スナップショットを出力する．
+void
+BnModel::save_snapshot(
+  std::ostream& s
+) const
+{
+  SnapshotWriter writer{_model_impl()};
+  writer.write(s);
+}
+
+// @brief スナップショットをファイルに出力する．
+void
+BnModel::save_snapshot(
+  const std::string& filename
+) const
+{
+  write_file(filename, "save_snapshot",
+	     [&](std::ostream& s){ save_snapshot(s); });
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SnapshotWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SnapshotWriter::SnapshotWriter(
+  const ModelImpl& model
+) : mModel{model}
+{
+}
+
+// @brief スナップショットを出力する．
+void
+SnapshotWriter::write(
+  std::ostream& s
+)
+{
+  mStringDict.clear();
+  mStringBegin.clear();
+  mStringBegin.push_back(0);
+  mStringData.clear();
+  mFuncData.clear();
+
+  auto node_num = mModel.node_num();
+
+  // ノードの情報
+  std::vector<std::uint32_t> func_array(node_num, SNAPSHOT_NONE);
+  std::vector<std::uint64_t> fanin_begin(node_num + 1, 0);
+  std::vector<std::uint32_t> fanin_list;
+  std::vector<std::uint32_t> name_array(node_num);
+  for ( SizeType id = 0; id < node_num; ++ id ) {
+    if ( !mModel.is_defined(id) ) {
+      throw std::logic_error{"SnapshotWriter: undefined node. wrap_up() may be required."};
+    }
+    auto& node = mModel.node_impl(id);
+    if ( node.is_logic() ) {
+      func_array[id] = node.func_id();
+      for ( auto iid: node.fanin_id_list() ) {
+	fanin_list.push_back(iid);
+      }
+    }
+    fanin_begin[id + 1] = fanin_list.size();
+    name_array[id] = reg_string(mModel.get_node_name(id));
+  }
+
+  // 入出力とDFFの情報
+  std::vector<std::uint32_t> input_list(mModel.input_id_list().begin(),
+					mModel.input_id_list().end());
+  std::vector<std::uint32_t> output_list(mModel.output_id_list().begin(),
+					 mModel.output_id_list().end());
+  std::vector<std::uint32_t> output_name_list;
+  output_name_list.reserve(mModel.output_num());
+  for ( SizeType i = 0; i < mModel.output_num(); ++ i ) {
+    output_name_list.push_back(reg_string(mModel.output_name(i)));
+  }
+  std::vector<std::uint32_t> dff_array;
+  dff_array.reserve(mModel.dff_num() * 4);
+  for ( SizeType i = 0; i < mModel.dff_num(); ++ i ) {
+    auto& dff = mModel.dff_impl(i);
+    dff_array.push_back(reg_string(dff.name));
+    dff_array.push_back(dff.id);
+    dff_array.push_back(dff.src_id);
+    dff_array.push_back(static_cast<std::uint8_t>(dff.reset_val));
+  }
+  std::vector<std::uint32_t> logic_list(mModel.logic_id_list().begin(),
+					mModel.logic_id_list().end());
+  std::vector<std::uint32_t> comment_list;
+  comment_list.reserve(mModel.comment_list().size());
+  for ( auto& comment: mModel.comment_list() ) {
+    comment_list.push_back(reg_string(comment));
+  }
+
+  // 関数の情報
+  auto func_num = mModel.func_num();
+  std::vector<std::uint64_t> func_begin;
+  func_begin.reserve(func_num + 1);
+  func_begin.push_back(0);
+  for ( SizeType fid = 0; fid < func_num; ++ fid ) {
+    encode_func(mModel.func_impl(fid));
+    func_begin.push_back(mFuncData.size());
+  }
+
+  SnapshotHeader header;
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.byte_order = SNAPSHOT_BYTE_ORDER;
+  header.flags = 0;
+  if ( mModel.strash() ) {
+    header.flags |= SNAPSHOT_FLAG_STRASH;
+  }
+  if ( mModel.is_frozen() ) {
+    header.flags |= SNAPSHOT_FLAG_FROZEN;
+  }
+  header.name = reg_string(mModel.name());
+  header.string_num = mStringBegin.size() - 1;
+  header.string_size = mStringData.size();
+  header.node_num = node_num;
+  header.fanin_num = fanin_list.size();
+  header.input_num = input_list.size();
+  header.output_num = output_list.size();
+  header.dff_num = mModel.dff_num();
+  header.logic_num = logic_list.size();
+  header.comment_num = comment_list.size();
+  header.func_num = func_num;
+  header.func_size = mFuncData.size();
+
+  // ファイルサイズを求める．
+  std::uint64_t size = snapshot_align(sizeof(SnapshotHeader));
+  size += snapshot_align(mStringBegin.size() * sizeof(std::uint64_t));
+  size += snapshot_align(mStringData.size());
+  size += snapshot_align(func_array.size() * sizeof(std::uint32_t));
+  size += snapshot_align(fanin_begin.size() * sizeof(std::uint64_t));
+  size += snapshot_align(fanin_list.size() * sizeof(std::uint32_t));
+  size += snapshot_align(name_array.size() * sizeof(std::uint32_t));
+  size += snapshot_align(input_list.size() * sizeof(std::uint32_t));
+  size += snapshot_align(output_list.size() * sizeof(std::uint32_t));
+  size += snapshot_align(output_name_list.size() * sizeof(std::uint32_t));
+  size += snapshot_align(dff_array.size() * sizeof(std::uint32_t));
+  size += snapshot_align(logic_list.size() * sizeof(std::uint32_t));
+  size += snapshot_align(comment_list.size() * sizeof(std::uint32_t));
+  size += snapshot_align(func_begin.size() * sizeof(std::uint64_t));
+  size += snapshot_align(mFuncData.size());
+  header.file_size = size;
+
+  BufWriter w{s};
+  write_section(w, &header, sizeof(SnapshotHeader));
+  write_section(w, mStringBegin);
+  write_section(w, mStringData.data(), mStringData.size());
+  write_section(w, func_array);
+  write_section(w, fanin_begin);
+  write_section(w, fanin_list);
+  write_section(w, name_array);
+  write_section(w, input_list);
+  write_section(w, output_list);
+  write_section(w, output_name_list);
+  write_section(w, dff_array);
+  write_section(w, logic_list);
+  write_section(w, comment_list);
+  write_section(w, func_begin);
+  write_section(w, mFuncData.data(), mFuncData.size());
+}
+
+// @brief 文字列を登録して番号を返す．
+std::uint32_t
+SnapshotWriter::reg_string(
+  const std::string& str
+)
+{
+  auto p = mStringDict.find(str);
+  if ( p != mStringDict.end() ) {
+    return p->second;
+  }
+  std::uint32_t id = mStringBegin.size() - 1;
+  mStringData.append(str);
+  mStringBegin.push_back(mStringData.size());
+  mStringDict.emplace(str, id);
+  return id;
+}
+
+// @brief 関数を符号化する．
+void
+SnapshotWriter::encode_func(
+  const FuncImpl& func
+)
+{
+  if ( func.is_primitive() ) {
+    put_u8(static_cast<std::uint8_t>(SnapshotFuncType::Primitive));
+    put_u32(func.input_num());
+    put_u32(static_cast<SizeType>(func.primitive_type()));
+  }
+  else if ( func.is_cover() ) {
+    put_u8(static_cast<std::uint8_t>(SnapshotFuncType::Cover));
+    auto& cover = func.input_cover();
+    put_u32(cover.variable_num());
+    put_u32(func.output_inv() ? 1 : 0);
+    auto cube_list = cover.literal_list();
+    put_u32(cube_list.size());
+    for ( auto& cube: cube_list ) {
+      put_u32(cube.size());
+      for ( auto lit: cube ) {
+	put_u32(lit.varid() * 2 + (lit.is_negative() ? 1 : 0));
+      }
+    }
+  }
+  else if ( func.is_expr() ) {
+    put_u8(static_cast<std::uint8_t>(SnapshotFuncType::Expr));
+    encode_expr(func.expr());
+  }
+  else if ( func.is_tvfunc() ) {
+    put_u8(static_cast<std::uint8_t>(SnapshotFuncType::TvFunc));
+    auto& tvfunc = func.tvfunc();
+    auto str = tvfunc.str();
+    put_u32(tvfunc.input_num());
+    put_u32(str.size());
+    mFuncData.append(str);
+  }
+  else if ( func.is_bdd() ) {
+    put_u8(static_cast<std::uint8_t>(SnapshotFuncType::Bdd));
+    encode_bdd(func.bdd());
+  }
+  else {
+    throw std::logic_error{"SnapshotWriter: unknown function type"};
+  }
+}
+
+// @brief 論理式を符号化する．
+void
+SnapshotWriter::encode_expr(
+  const Expr& expr
+)
+{
+  if ( expr.is_zero() ) {
+    put_u32(static_cast<SizeType>(SnapshotExprOp::Zero));
+    return;
+  }
+  if ( expr.is_one() ) {
+    put_u32(static_cast<SizeType>(SnapshotExprOp::One));
+    return;
+  }
+  if ( expr.is_posi_literal() ) {
+    put_u32(static_cast<SizeType>(SnapshotExprOp::PosiLit));
+    put_u32(expr.varid());
+    return;
+  }
+  if ( expr.is_nega_literal() ) {
+    put_u32(static_cast<SizeType>(SnapshotExprOp::NegaLit));
+    put_u32(expr.varid());
+    return;
+  }
+  if ( expr.is_and() ) {
+    put_u32(static_cast<SizeType>(SnapshotExprOp::And));
+  }
+  else if ( expr.is_or() ) {
+    put_u32(static_cast<SizeType>(SnapshotExprOp::Or));
+  }
+  else if ( expr.is_xor() ) {
+    put_u32(static_cast<SizeType>(SnapshotExprOp::Xor));
+  }
+  else {
+    throw std::logic_error{"SnapshotWriter: unexpected expression"};
+  }
+  put_u32(expr.operand_num());
+  for ( auto& opr: expr.operand_list() ) {
+    encode_expr(opr);
+  }
+}
+
+BEGIN_NONAMESPACE
+
+// Bdd 用のハッシュ関数
+struct BddHash
+{
+  SizeType
+  operator()(
+    const Bdd& bdd
+  ) const
+  {
+    return bdd.hash();
+  }
+};
+
+// BDD のノードに番号をつける．
+//
+// 枝の番号は 0, 1 が定数，それ以外は 2 + ノード番号
+std::uint32_t
+number_bdd(
+  const Bdd& bdd,
+  std::unordered_map<Bdd, std::uint32_t, BddHash>& node_map,
+  std::vector<std::uint32_t>& node_list
+)
+{
+  if ( bdd.is_zero() ) {
+    return 0;
+  }
+  if ( bdd.is_one() ) {
+    return 1;
+  }
+  auto p = node_map.find(bdd);
+  if ( p != node_map.end() ) {
+    return p->second;
+  }
+  auto e0 = number_bdd(bdd.root_cofactor0(), node_map, node_list);
+  auto e1 = number_bdd(bdd.root_cofactor1(), node_map, node_list);
+  std::uint32_t e = node_list.size() / 3 + 2;
+  node_list.push_back(bdd.root_var().index());
+  node_list.push_back(e0);
+  node_list.push_back(e1);
+  node_map.emplace(bdd, e);
+  return e;
+}
+
+END_NONAMESPACE
+
+// @brief BDD を符号化する．
+void
+SnapshotWriter::encode_bdd(
+  const Bdd& bdd
+)
+{
+  std::unordered_map<Bdd, std::uint32_t, BddHash> node_map;
+  std::vector<std::uint32_t> node_list;
+  auto root = number_bdd(bdd, node_map, node_list);
+  if ( root < 2 ) {
+    // 定数の場合はノード数 0 に続けて値を書く．
+    put_u32(0);
+    put_u32(root);
+    return;
+  }
+  put_u32(node_list.size() / 3);
+  for ( auto v: node_list ) {
+    put_u32(v);
+  }
+}
+
+// @brief 関数の本体に uint32 を追加する．
+void
+SnapshotWriter::put_u32(
+  SizeType val
+)
+{
+  auto val32 = static_cast<std::uint32_t>(val);
+  char buf[sizeof(std::uint32_t)];
+  std::memcpy(buf, &val32, sizeof(std::uint32_t));
+  mFuncData.append(buf, sizeof(std::uint32_t));
+}
+
+// @brief 1つのセクションを出力する．
+void
+SnapshotWriter::write_section(
+  BufWriter& w,
+  const void* data,
+  SizeType size
+)
+{
+  w.put(std::string_view{static_cast<const char*>(data), size});
+  static const char pad[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  auto pad_size = snapshot_align(size) - size;
+  if ( pad_size > 0 ) {
+    w.put(std::string_view{pad, pad_size});
+  }
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,147 @@
+#ifndef SNAPSHOTWRITER_H
+#define SNAPSHOTWRITER_H
+
+/// @file SnapshotWriter.h
+/// @brief SnapshotWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ModelImpl.h"
+#include "SnapshotFormat.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class BufWriter;
+
+//////////////////////////////////////////////////////////////////////
+/// @class SnapshotWriter SnapshotWriter.h "SnapshotWriter.h"
+/// @brief ModelImpl をスナップショット形式で出力するクラス
+///
+/// 形式は SnapshotFormat.h を参照のこと．
+/// 名前とコメントは文字列表にまとめ，同じ文字列は1度だけ格納する．
+//////////////////////////////////////////////////////////////////////
+class SnapshotWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  SnapshotWriter(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief デストラクタ
+  ~SnapshotWriter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スナップショットを出力する．
+  ///
+  /// 未定義のノードがある場合は std::logic_error 例外を送出する．
+  void
+  write(
+    std::ostream& s ///< [in] 出力先のストリーム(バイナリモード)
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 文字列を登録して番号を返す．
+  std::uint32_t
+  reg_string(
+    const std::string& str ///< [in] 文字列
+  );
+
+  /// @brief 関数を符号化する．
+  void
+  encode_func(
+    const FuncImpl& func ///< [in] 関数
+  );
+
+  /// @brief 論理式を符号化する．
+  void
+  encode_expr(
+    const Expr& expr ///< [in] 論理式
+  );
+
+  /// @brief BDD を符号化する．
+  void
+  encode_bdd(
+    const Bdd& bdd ///< [in] BDD
+  );
+
+  /// @brief 関数の本体に1バイト追加する．
+  void
+  put_u8(
+    std::uint8_t val ///< [in] 値
+  )
+  {
+    mFuncData.push_back(static_cast<char>(val));
+  }
+
+  /// @brief 関数の本体に uint32 を追加する．
+  void
+  put_u32(
+    SizeType val ///< [in] 値
+  );
+
+  /// @brief 1つのセクションを出力する．
+  ///
+  /// 次のセクションが 8 バイト境界から始まるように詰め物をする．
+  static
+  void
+  write_section(
+    BufWriter& w,     ///< [in] 出力先
+    const void* data, ///< [in] 内容の先頭
+    SizeType size     ///< [in] サイズ(バイト数)
+  );
+
+  /// @brief 配列を1つのセクションとして出力する．
+  template<typename T>
+  static
+  void
+  write_section(
+    BufWriter& w,               ///< [in] 出力先
+    const std::vector<T>& array ///< [in] 配列
+  )
+  {
+    write_section(w, array.data(), array.size() * sizeof(T));
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のモデル
+  const ModelImpl& mModel;
+
+  // 文字列をキーにして番号を格納する辞書
+  std::unordered_map<std::string, std::uint32_t> mStringDict;
+
+  // 文字列の開始位置のリスト
+  std::vector<std::uint64_t> mStringBegin;
+
+  // 文字列の本体
+  std::string mStringData;
+
+  // 関数の本体
+  std::string mFuncData;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // SNAPSHOTWRITER_H
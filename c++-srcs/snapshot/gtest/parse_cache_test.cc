@@ -0,0 +1,163 @@
+
+/// @file parse_cache_test.cc
+/// @brief 読み込み結果のキャッシュ("cache_dir" オプション)のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "ym/JsonValue.h"
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 空のキャッシュディレクトリを用意する．
+std::string
+make_cache_dir(
+  const std::string& name
+)
+{
+  auto dir = ::testing::TempDir() + name;
+  std::filesystem::remove_all(dir);
+  return dir;
+}
+
+// キャッシュのエントリのリストを返す．
+std::vector<std::string>
+entry_list(
+  const std::string& dir
+)
+{
+  std::vector<std::string> ans;
+  std::error_code ec;
+  for ( auto& entry: std::filesystem::directory_iterator{dir, ec} ) {
+    ans.push_back(entry.path().string());
+  }
+  std::sort(ans.begin(), ans.end());
+  return ans;
+}
+
+// オプションを作る．
+JsonValue
+cache_option(
+  const std::string& dir,
+  bool strash = false
+)
+{
+  std::unordered_map<std::string, JsonValue> opt_dict;
+  opt_dict.emplace("cache_dir", JsonValue{dir});
+  if ( strash ) {
+    opt_dict.emplace("strash", JsonValue{true});
+  }
+  return JsonValue{opt_dict};
+}
+
+// ファイルをコピーする．
+std::string
+copy_file(
+  const std::string& src,
+  const std::string& name
+)
+{
+  auto dst = ::testing::TempDir() + name;
+  std::filesystem::copy_file(src, dst,
+			     std::filesystem::copy_options::overwrite_existing);
+  return dst;
+}
+
+END_NONAMESPACE
+
+TEST( BnModelTest, parse_cache_blif )
+{
+  auto dir = make_cache_dir("bn_cache_blif");
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  auto option = cache_option(dir);
+
+  auto model1 = BnModel::read_blif(path, option);
+  auto entries = entry_list(dir);
+  ASSERT_EQ( 1, entries.size() );
+
+  // キャッシュから読み込んだ結果も同じになる．
+  auto model2 = BnModel::read_blif(path, option);
+  EXPECT_EQ( 1, entry_list(dir).size() );
+  std::ostringstream buf1;
+  model1.write_blif(buf1);
+  std::ostringstream buf2;
+  model2.write_blif(buf2);
+  EXPECT_EQ( buf1.str(), buf2.str() );
+
+  // エントリを別のモデルに置き換えるとそれが読み込まれる．
+  BnModel dummy;
+  dummy.new_output(dummy.new_input("a"), "b");
+  dummy.wrap_up();
+  dummy.save_snapshot(entries[0]);
+  auto model3 = BnModel::read_blif(path, option);
+  EXPECT_EQ( 1, model3.input_num() );
+  EXPECT_EQ( 1, model3.output_num() );
+}
+
+TEST( BnModelTest, parse_cache_key )
+{
+  auto dir = make_cache_dir("bn_cache_key");
+  auto path = copy_file(std::string{DATAPATH} + "b10.bench", "cache_b10.bench");
+
+  BnModel::read_iscas89(path, cache_option(dir));
+  EXPECT_EQ( 1, entry_list(dir).size() );
+
+  // オプションが異なれば別のエントリになる．
+  BnModel::read_iscas89(path, cache_option(dir, true));
+  EXPECT_EQ( 2, entry_list(dir).size() );
+
+  // 内容が変われば別のエントリになる．
+  {
+    std::ofstream s{path, std::ios::app};
+    s << "# modified" << std::endl;
+  }
+  BnModel::read_iscas89(path, cache_option(dir));
+  EXPECT_EQ( 3, entry_list(dir).size() );
+}
+
+TEST( BnModelTest, parse_cache_broken )
+{
+  auto dir = make_cache_dir("bn_cache_broken");
+  auto path = std::string{DATAPATH} + "b10.bench";
+  auto option = cache_option(dir);
+
+  auto model1 = BnModel::read_iscas89(path, option);
+  auto entries = entry_list(dir);
+  ASSERT_EQ( 1, entries.size() );
+
+  // 壊れたエントリは無視して読み直す．
+  {
+    std::ofstream s{entries[0], std::ios::binary};
+    s << "broken";
+  }
+  auto model2 = BnModel::read_iscas89(path, option);
+  EXPECT_EQ( model1.node_num(), model2.node_num() );
+  EXPECT_EQ( model1.logic_num(), model2.logic_num() );
+
+  // エントリは作り直されている．
+  auto model3 = BnModel::load_snapshot(entries[0]);
+  EXPECT_EQ( model1.node_num(), model3.node_num() );
+}
+
+TEST( BnModelTest, parse_cache_error )
+{
+  auto dir = make_cache_dir("bn_cache_error");
+  auto path = make_file("cache_error.bench",
+			"INPUT(a)\n"
+			"OUTPUT(b)\n"
+			"b = FOO(a)\n");
+
+  // 読み込みに失敗した場合はキャッシュされない．
+  EXPECT_THROW( BnModel::read_iscas89(path, cache_option(dir)),
+		std::invalid_argument );
+  EXPECT_EQ( 0, entry_list(dir).size() );
+}
+
+END_NAMESPACE_YM_BN
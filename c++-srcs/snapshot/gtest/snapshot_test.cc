@@ -0,0 +1,254 @@
+
+/// @file snapshot_test.cc
+/// @brief save_snapshot/load_snapshot のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BddMgr.h"
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 2つのモデルの構造が同一か調べる．
+void
+check_same(
+  const BnModel& model1,
+  const BnModel& model2
+)
+{
+  ASSERT_EQ( model1.node_num(), model2.node_num() );
+  ASSERT_EQ( model1.input_num(), model2.input_num() );
+  ASSERT_EQ( model1.output_num(), model2.output_num() );
+  ASSERT_EQ( model1.dff_num(), model2.dff_num() );
+  ASSERT_EQ( model1.logic_num(), model2.logic_num() );
+  ASSERT_EQ( model1.func_num(), model2.func_num() );
+  EXPECT_EQ( model1.name(), model2.name() );
+  EXPECT_EQ( model1.comment_list(), model2.comment_list() );
+  EXPECT_EQ( model1.strash(), model2.strash() );
+  EXPECT_EQ( model1.is_frozen(), model2.is_frozen() );
+  for ( SizeType i = 0; i < model1.input_num(); ++ i ) {
+    EXPECT_EQ( model1.input(i).id(), model2.input(i).id() );
+    EXPECT_EQ( model1.input_name(i), model2.input_name(i) );
+  }
+  for ( SizeType i = 0; i < model1.output_num(); ++ i ) {
+    EXPECT_EQ( model1.output(i).id(), model2.output(i).id() );
+    EXPECT_EQ( model1.output_name(i), model2.output_name(i) );
+  }
+  for ( SizeType i = 0; i < model1.dff_num(); ++ i ) {
+    auto dff1 = model1.dff(i);
+    auto dff2 = model2.dff(i);
+    EXPECT_EQ( model1.dff_name(i), model2.dff_name(i) );
+    EXPECT_EQ( dff1.output().id(), dff2.output().id() );
+    EXPECT_EQ( dff1.input().id(), dff2.input().id() );
+    EXPECT_EQ( dff1.reset_val(), dff2.reset_val() );
+  }
+  for ( SizeType i = 0; i < model1.logic_num(); ++ i ) {
+    auto node1 = model1.logic(i);
+    auto node2 = model2.logic(i);
+    ASSERT_EQ( node1.id(), node2.id() );
+    EXPECT_EQ( node1.func().id(), node2.func().id() );
+    ASSERT_EQ( node1.fanin_num(), node2.fanin_num() );
+    for ( SizeType j = 0; j < node1.fanin_num(); ++ j ) {
+      EXPECT_EQ( node1.fanin(j).id(), node2.fanin(j).id() );
+    }
+  }
+  for ( SizeType i = 0; i < model1.func_num(); ++ i ) {
+    auto func1 = model1.func(i);
+    auto func2 = model2.func(i);
+    ASSERT_EQ( func1.type(), func2.type() );
+    if ( func1.is_primitive() ) {
+      EXPECT_EQ( func1.primitive_type(), func2.primitive_type() );
+    }
+    else if ( func1.is_cover() ) {
+      EXPECT_EQ( func1.input_cover(), func2.input_cover() );
+      EXPECT_EQ( func1.output_inv(), func2.output_inv() );
+    }
+    else if ( func1.is_expr() ) {
+      EXPECT_EQ( func1.expr(), func2.expr() );
+    }
+    else if ( func1.is_tvfunc() ) {
+      EXPECT_EQ( func1.tvfunc(), func2.tvfunc() );
+    }
+    else if ( func1.is_bdd() ) {
+      EXPECT_EQ( func1.bdd().to_truth(func1.bdd().get_support_list()),
+		 func2.bdd().to_truth(func2.bdd().get_support_list()) );
+    }
+  }
+
+  // 最終的な確認として出力結果を比較する．
+  std::ostringstream buf1;
+  model1.write_blif(buf1);
+  std::ostringstream buf2;
+  model2.write_blif(buf2);
+  EXPECT_EQ( buf1.str(), buf2.str() );
+}
+
+END_NONAMESPACE
+
+TEST( BnModelTest, snapshot_s5378 )
+{
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  auto model = BnModel::read_blif(path);
+  auto model2 = round_trip(model, "snapshot", "s5378.snap");
+  check_same(model, model2);
+}
+
+TEST( BnModelTest, snapshot_funcs )
+{
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto c = model.new_input();
+  auto dff0 = model.new_dff("q0", '1');
+  auto q0 = dff0.output();
+  auto dff1 = model.new_dff({}, '0');
+  auto q1 = dff1.output();
+
+  auto n1 = model.new_primitive(PrimType::Xor, {a, b, c});
+  SopCover cover{3, {{Literal{0, false}, Literal{1, true}},
+		     {Literal{2, false}}}};
+  auto n2 = model.new_cover(cover, true, {a, q0, c});
+  auto expr = (Expr::literal(0) & ~Expr::literal(1)) | (Expr::literal(2) ^ Expr::literal(0));
+  auto n3 = model.new_expr(expr, {n1, n2, q1});
+  TvFunc maj{"11101000"};
+  auto n4 = model.new_tvfunc(maj, {n3, q0, b});
+  auto n5 = model.new_primitive(PrimType::C1, {});
+
+  model.set_dff_src(dff0, n4);
+  model.set_dff_src(dff1, n1);
+  model.new_output(n3, "o1");
+  model.new_output(n4);
+  model.new_output(n5, "one");
+  model.new_output(a, "a");
+  model.wrap_up();
+
+  auto model2 = round_trip(model, "snapshot", "funcs.snap");
+  check_same(model, model2);
+}
+
+TEST( BnModelTest, snapshot_bdd )
+{
+  BddMgr mgr;
+  auto var0 = mgr.variable(0);
+  auto var1 = mgr.variable(1);
+  auto var2 = mgr.variable(2);
+  auto bdd = (var0 & ~var1) | (var1 & var2);
+
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto c = model.new_input("c");
+  auto n1 = model.new_bdd(bdd, {a, b, c});
+  auto n2 = model.new_bdd(mgr.zero(), {});
+  model.new_output(n1, "o1");
+  model.new_output(n2, "o2");
+  model.wrap_up();
+
+  auto model2 = round_trip(model, "snapshot", "bdd.snap");
+  check_same(model, model2);
+}
+
+TEST( BnModelTest, snapshot_frozen )
+{
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto n1 = model.new_primitive(PrimType::And, {a, b});
+  auto n2 = model.new_primitive(PrimType::Or, {n1, a});
+  model.new_output(n2, "o1");
+  model.freeze();
+
+  auto model2 = round_trip(model, "snapshot", "frozen.snap");
+  check_same(model, model2);
+  EXPECT_EQ( model.depth(), model2.depth() );
+  EXPECT_EQ( model.input(0).fanout_num(), model2.input(0).fanout_num() );
+}
+
+TEST( BnModelTest, snapshot_strash )
+{
+  BnModel model;
+  model.set_strash();
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto n1 = model.new_primitive(PrimType::And, {a, b});
+  auto n2 = model.new_primitive(PrimType::Or, {n1, a});
+  model.new_output(n1, "o1");
+  model.new_output(n2, "o2");
+  model.wrap_up();
+
+  auto model2 = round_trip(model, "snapshot", "strash.snap");
+  check_same(model, model2);
+
+  // 構造ハッシュの辞書も復元されている．
+  auto a2 = model2.input(0);
+  auto b2 = model2.input(1);
+  auto n3 = model2.new_primitive(PrimType::And, {b2, a2});
+  EXPECT_EQ( model2.output(0).id(), n3.id() );
+}
+
+TEST( BnModelTest, snapshot_option )
+{
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  auto model = BnModel::read_blif(path);
+  auto model2 = round_trip(model, "snapshot", "option.snap");
+  EXPECT_EQ( model.option(), model2.option() );
+}
+
+TEST( BnModelTest, load_snapshot_bad_file )
+{
+  EXPECT_THROW( BnModel::load_snapshot("/nonexistent/dir/foo.snap"),
+		std::invalid_argument );
+
+  // スナップショット以外のファイル
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  EXPECT_THROW( BnModel::load_snapshot(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, load_snapshot_broken )
+{
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  model.new_output(model.new_primitive(PrimType::And, {a, b}), "o");
+  model.wrap_up();
+  std::ostringstream buf;
+  model.save_snapshot(buf);
+  auto contents = buf.str();
+
+  // 正常な内容
+  {
+    auto path = make_file("ok.snap", contents);
+    auto model2 = BnModel::load_snapshot(path);
+    EXPECT_EQ( 1, model2.logic_num() );
+  }
+  // 途中で切れている．
+  {
+    auto path = make_file("short.snap",
+			  contents.substr(0, contents.size() - 8));
+    EXPECT_THROW( BnModel::load_snapshot(path), std::invalid_argument );
+  }
+  // バージョンが異なる．
+  {
+    auto data = contents;
+    data[8] = static_cast<char>(data[8] + 1);
+    auto path = make_file("version.snap", data);
+    EXPECT_THROW( BnModel::load_snapshot(path), std::invalid_argument );
+  }
+}
+
+TEST( BnModelTest, save_snapshot_bad_file )
+{
+  BnModel model;
+  model.new_output(model.new_input("a"), "b");
+  model.wrap_up();
+  EXPECT_THROW( model.save_snapshot("/nonexistent/dir/foo.snap"),
+		std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
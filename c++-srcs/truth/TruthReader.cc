@@ -1,4 +1,3 @@
-
 /// @file TruthReader.cc
 /// @brief TruthReader の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
@@ -10,32 +9,123 @@
 #include "ym/BnModel.h"
 #include "ym/TvFunc.h"
 #include "ModelImpl.h"
+#include "ParseCache.h"
+#include "MappedFile.h"
+#include "ProgressReporter.h"
+#include "ReadOption.h"
+#include "ThreadJoiner.h"
+#include <cstring>
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_BN
 
+BEGIN_NONAMESPACE
+
+// 1行分の内容
+struct Line
+{
+  // 先頭
+  const char* begin;
+
+  // 末尾(改行文字は含まない)
+  const char* end;
+
+  // 行番号
+  int line_no;
+};
+
+// 内容を行に分割する．
+//
+// 末尾の '\r' は取り除き，空行は無視する．
+std::vector<Line>
+split_lines(
+  const char* begin,
+  const char* end
+)
+{
+  std::vector<Line> line_list;
+  int line_no = 1;
+  for ( auto p = begin; p < end; ++ line_no ) {
+    auto q = static_cast<const char*>(memchr(p, '\n', end - p));
+    auto e = q == nullptr ? end : q;
+    auto next = q == nullptr ? end : q + 1;
+    if ( e > p && *(e - 1) == '\r' ) {
+      -- e;
+    }
+    if ( e > p ) {
+      line_list.push_back({p, e, line_no});
+    }
+    p = next;
+  }
+  return line_list;
+}
+
+// 変換時のエラー
+struct ParseError
+{
+  // エラーのあった行番号(エラーがない場合は 0)
+  int line_no{0};
+
+  // エラーメッセージ
+  std::string msg;
+};
+
+// line_list[begin:end] を TvFunc に変換して func_list に格納する．
+//
+// 最初にエラーの起きた行で中断する．
+// 中断が要求された場合もその行で中断する．
+void
+parse_lines(
+  const std::vector<Line>& line_list,
+  SizeType begin,
+  SizeType end,
+  std::vector<TvFunc>& func_list,
+  ParseError& error,
+  const std::atomic<bool>& cancel,
+  const ProgressReporter& progress
+)
+{
+  for ( SizeType i = begin; i < end; ++ i ) {
+    if ( cancel || progress.is_canceled() ) {
+      return;
+    }
+    auto& line = line_list[i];
+    try {
+      func_list[i] = TvFunc{std::string{line.begin, line.end}};
+    }
+    catch ( std::exception& e ) {
+      error.line_no = line.line_no;
+      error.msg = e.what();
+      return;
+    }
+  }
+}
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラス BnModel
 //////////////////////////////////////////////////////////////////////
 
-
 // @brief .truth 形式のファイルを読み込む．
 // @return ネットワークを返す．
 BnModel
 BnModel::read_truth(
-  const std::string& filename ///< [in] ファイル名
+  const std::string& filename, ///< [in] ファイル名
+  const JsonValue& option      ///< [in] オプション
 )
 {
-  std::ifstream s{filename};
-  if ( !s ) {
-    std::ostringstream buf;
-    buf << filename << ": No such file";
-    throw std::invalid_argument{buf.str()};
-  }
-
+  ParseCache cache{filename, "truth", option};
   BnModel model;
+  if ( cache.load(model) ) {
+    return model;
+  }
+  model._set_read_option(option);
   TruthReader reader;
-  reader.read(s, model._model_impl());
+  reader.read(filename, ReadOption{option}, model._model_impl());
+  cache.save(model);
   return model;
 }
 
@@ -47,33 +137,76 @@ BnModel::read_truth(
 // @brief 真理値表形式のファイルを読み込む．
 void
 TruthReader::read(
-  std::istream& s,
+  const std::string& filename,
+  const ReadOption& option,
   ModelImpl& model
 )
 {
-  std::vector<TvFunc> func_vect;
-  {
-    std::string line;
-    while ( getline(s, line) ) {
-      func_vect.push_back(TvFunc{line});
-    }
+  MappedFile fin;
+  if ( !fin.open(filename, option.use_mmap) ) {
+    std::ostringstream buf;
+    buf << filename << ": No such file";
+    throw std::invalid_argument{buf.str()};
   }
 
-  auto no = func_vect.size();
+  ProgressReporter progress{"read", fin.size(), ProgressReporter::BYTE_STRIDE};
+  auto line_list = split_lines(fin.begin(), fin.end());
+  auto no = line_list.size();
   if ( no == 0 ) {
     return;
   }
 
+  // 行を nt 個の範囲に分けてそれぞれ変換する．
+  // 各スレッドは自分の範囲の要素にのみ書き込むので排他制御は不要
+  auto nt = std::max<SizeType>(std::min(option.thread_num, no), 1);
+  std::vector<TvFunc> func_vect(no);
+  std::vector<ParseError> error_list(nt);
+  std::atomic<bool> cancel{false};
+  if ( nt == 1 ) {
+    parse_lines(line_list, 0, no, func_vect, error_list[0],
+		cancel, progress);
+  }
+  else {
+    std::vector<std::thread> thread_list;
+    {
+      // 例外でブロックを抜ける時にも全てのスレッドを終了させる．
+      ThreadJoiner joiner{cancel, thread_list};
+      thread_list.reserve(nt);
+      for ( SizeType t = 0; t < nt; ++ t ) {
+	auto begin = no * t / nt;
+	auto end = no * (t + 1) / nt;
+	thread_list.emplace_back(parse_lines, std::cref(line_list),
+				 begin, end, std::ref(func_vect),
+				 std::ref(error_list[t]),
+				 std::cref(cancel), std::cref(progress));
+      }
+      for ( auto& th: thread_list ) {
+	th.join();
+      }
+    }
+  }
+  // 中断が要求された場合は変換が途中で終わっている．
+  progress.check_cancel();
+
+  // 最初のエラーを報告する．
+  for ( auto& error: error_list ) {
+    if ( error.line_no > 0 ) {
+      std::ostringstream buf;
+      buf << filename << ":" << error.line_no << ": " << error.msg;
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+
   // 入力数が全て等しいかチェック
   auto ni = func_vect[0].input_num();
   for ( SizeType i = 1; i < no; ++ i ) {
     auto& func = func_vect[i];
     if ( func.input_num() != ni ) {
-      std::cout << "ni = " << ni << ", func_vect["
-		<< i << "].input_num() = "
-		<< func.input_num()
-		<< std::endl;
-      throw std::invalid_argument{"the number of inputs should be the same for all outputs"};
+      std::ostringstream buf;
+      buf << filename << ":" << line_list[i].line_no << ": "
+	  << "the number of inputs should be the same for all outputs"
+	  << " (" << func.input_num() << " != " << ni << ")";
+      throw std::invalid_argument{buf.str()};
     }
   }
 
@@ -94,6 +227,7 @@ TruthReader::read(
     auto id = model.new_logic(func_id, fanin_list);
     model.new_output(id);
   }
+  progress.finish(model.node_num());
   model.make_logic_list();
 }
 
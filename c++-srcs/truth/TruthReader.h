@@ -14,10 +14,17 @@
 BEGIN_NAMESPACE_YM_BN
 
 class ModelImpl;
+struct ReadOption;
 
 //////////////////////////////////////////////////////////////////////
 /// @class TruthReader TruthReader.h "TruthReader.h"
 /// @brief 真理値表形式のファイルを読むためのクラス
+///
+/// 各行が1つの出力の真理値表を表す．
+/// ファイルを MappedFile で読み込んで行単位に分割し，
+/// option.thread_num が 2 以上の場合は各行の TvFunc への変換を
+/// 複数のスレッドで並列に行う．関数の登録は行の順番に逐次的に行うので，
+/// 結果はスレッド数によらず同一となる．
 //////////////////////////////////////////////////////////////////////
 class TruthReader
 {
@@ -36,10 +43,13 @@ public:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 真理値表形式のファイルを読み込む．
+  ///
+  /// 読み込みに失敗した場合は std::invalid_argument 例外を送出する．
   void
   read(
-    std::istream& s, ///< [in] 入力ストリーム
-    ModelImpl& model ///< [in] 結果を格納するオブジェクト
+    const std::string& filename, ///< [in] ファイル名
+    const ReadOption& option,    ///< [in] 読み込み用のオプション
+    ModelImpl& model             ///< [in] 結果を格納するオブジェクト
   );
 
 };
@@ -0,0 +1,268 @@
+
+/// @file TruthWriter.cc
+/// @brief TruthWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "TruthWriter.h"
+#include "BufWriter.h"
+#include "FuncImpl.h"
+#include "ym/BnModel.h"
+#include "ym/SopCover.h"
+#include "ym/Expr.h"
+#include "ym/Bdd.h"
+#include "ym/BddVar.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief truth 形式で出力する．
+void
+BnModel::write_truth(
+  std::ostream& s
+) const
+{
+  TruthWriter writer{_model_impl()};
+  writer.write(s);
+}
+
+// @brief truth 形式でファイルに出力する．
+void
+BnModel::write_truth(
+  const std::string& filename
+) const
+{
+  write_file(filename, "write_truth",
+	     [&](std::ostream& s){ write_truth(s); });
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス TruthWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+TruthWriter::TruthWriter(
+  const ModelImpl& model
+) : mModel{model},
+    mInputNum{model.input_num()}
+{
+}
+
+// @brief 真理値表形式で出力する．
+void
+TruthWriter::write(
+  std::ostream& s
+)
+{
+  if ( mModel.dff_num() > 0 ) {
+    throw std::invalid_argument{"BnModel::write_truth(): "
+				"DFF is not allowed in truth format."};
+  }
+
+  calc_funcs();
+
+  BufWriter w{s};
+  for ( auto id: mModel.output_id_list() ) {
+    if ( id >= mDefined.size() || !mDefined[id] ) {
+      throw std::logic_error{"TruthWriter: undefined node. wrap_up() may be required."};
+    }
+    w.put(mFuncArray[id].str(2));
+    w.put('\n');
+  }
+}
+
+// @brief 各ノードの関数を求める．
+void
+TruthWriter::calc_funcs()
+{
+  auto n = mModel.node_num();
+  mFuncArray.clear();
+  mFuncArray.resize(n);
+  mDefined.clear();
+  mDefined.resize(n, false);
+
+  for ( SizeType i = 0; i < mInputNum; ++ i ) {
+    auto id = mModel.input_id(i);
+    mFuncArray[id] = TvFunc::posi_literal(mInputNum, mInputNum - i - 1);
+    mDefined[id] = true;
+  }
+
+  // 論理ノードはトポロジカル順に並んでいる．
+  for ( auto id: mModel.logic_id_list() ) {
+    mFuncArray[id] = calc_node(mModel.node_impl(id));
+    mDefined[id] = true;
+  }
+}
+
+// @brief 論理ノードの関数を求める．
+TvFunc
+TruthWriter::calc_node(
+  const NodeImpl& node
+)
+{
+  std::vector<TvFunc> ifunc_list;
+  ifunc_list.reserve(node.fanin_num());
+  for ( auto iid: node.fanin_id_list() ) {
+    if ( !mDefined[iid] ) {
+      throw std::logic_error{"TruthWriter: undefined node. wrap_up() may be required."};
+    }
+    ifunc_list.push_back(mFuncArray[iid]);
+  }
+
+  auto& func = mModel.func_impl(node.func_id());
+  if ( func.is_primitive() ) {
+    return calc_primitive(func.primitive_type(), ifunc_list);
+  }
+  if ( func.is_cover() ) {
+    return calc_cover(func.input_cover(), func.output_inv(), ifunc_list);
+  }
+  if ( func.is_expr() ) {
+    return calc_expr(func.expr(), ifunc_list);
+  }
+  if ( func.is_tvfunc() ) {
+    auto& tvfunc = func.tvfunc();
+    return calc_tvfunc(tvfunc, ifunc_list, tvfunc.input_num(), 0);
+  }
+  if ( func.is_bdd() ) {
+    // サポート変数の順番がファンインの順番に対応している．
+    auto bdd = func.bdd();
+    auto tvfunc = bdd.to_truth(bdd.get_support_list());
+    return calc_tvfunc(tvfunc, ifunc_list, tvfunc.input_num(), 0);
+  }
+  throw std::logic_error{"TruthWriter: unknown function type"};
+}
+
+// @brief プリミティブ型の関数を求める．
+TvFunc
+TruthWriter::calc_primitive(
+  PrimType primitive_type,
+  const std::vector<TvFunc>& ifunc_list
+)
+{
+  auto zero = TvFunc::zero(mInputNum);
+  auto one = TvFunc::one(mInputNum);
+  auto fold = [&](TvFunc val, auto op) {
+    for ( auto& ifunc: ifunc_list ) {
+      val = op(val, ifunc);
+    }
+    return val;
+  };
+  auto and_op = [](const TvFunc& a, const TvFunc& b) { return a & b; };
+  auto or_op = [](const TvFunc& a, const TvFunc& b) { return a | b; };
+  auto xor_op = [](const TvFunc& a, const TvFunc& b) { return a ^ b; };
+  switch ( primitive_type ) {
+  case PrimType::C0:   return zero;
+  case PrimType::C1:   return one;
+  case PrimType::Buff: return ifunc_list[0];
+  case PrimType::Not:  return ~ifunc_list[0];
+  case PrimType::And:  return fold(one, and_op);
+  case PrimType::Nand: return ~fold(one, and_op);
+  case PrimType::Or:   return fold(zero, or_op);
+  case PrimType::Nor:  return ~fold(zero, or_op);
+  case PrimType::Xor:  return fold(zero, xor_op);
+  case PrimType::Xnor: return ~fold(zero, xor_op);
+  default: break;
+  }
+  throw std::logic_error{"TruthWriter: unexpected primitive type"};
+}
+
+// @brief カバー型の関数を求める．
+TvFunc
+TruthWriter::calc_cover(
+  const SopCover& cover,
+  bool output_inv,
+  const std::vector<TvFunc>& ifunc_list
+)
+{
+  auto ofunc = TvFunc::zero(mInputNum);
+  for ( auto& cube: cover.literal_list() ) {
+    auto cfunc = TvFunc::one(mInputNum);
+    for ( auto lit: cube ) {
+      auto& ifunc = ifunc_list[lit.varid()];
+      if ( lit.is_negative() ) {
+	cfunc = cfunc & ~ifunc;
+      }
+      else {
+	cfunc = cfunc & ifunc;
+      }
+    }
+    ofunc = ofunc | cfunc;
+  }
+  return output_inv ? ~ofunc : ofunc;
+}
+
+// @brief 論理式型の関数を求める．
+TvFunc
+TruthWriter::calc_expr(
+  const Expr& expr,
+  const std::vector<TvFunc>& ifunc_list
+)
+{
+  if ( expr.is_zero() ) {
+    return TvFunc::zero(mInputNum);
+  }
+  if ( expr.is_one() ) {
+    return TvFunc::one(mInputNum);
+  }
+  if ( expr.is_posi_literal() ) {
+    return ifunc_list[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return ~ifunc_list[expr.varid()];
+  }
+  std::vector<TvFunc> tmp_list;
+  tmp_list.reserve(expr.operand_num());
+  for ( auto& opr: expr.operand_list() ) {
+    tmp_list.push_back(calc_expr(opr, ifunc_list));
+  }
+  auto ans = tmp_list[0];
+  for ( SizeType i = 1; i < tmp_list.size(); ++ i ) {
+    if ( expr.is_and() ) {
+      ans = ans & tmp_list[i];
+    }
+    else if ( expr.is_or() ) {
+      ans = ans | tmp_list[i];
+    }
+    else if ( expr.is_xor() ) {
+      ans = ans ^ tmp_list[i];
+    }
+    else {
+      throw std::logic_error{"TruthWriter: unexpected expression"};
+    }
+  }
+  return ans;
+}
+
+// @brief 真理値表型の関数を求める．
+TvFunc
+TruthWriter::calc_tvfunc(
+  const TvFunc& func,
+  const std::vector<TvFunc>& ifunc_list,
+  SizeType var_num,
+  SizeType base
+)
+{
+  if ( var_num == 0 ) {
+    if ( func.value(base) ) {
+      return TvFunc::one(mInputNum);
+    }
+    return TvFunc::zero(mInputNum);
+  }
+  auto var = var_num - 1;
+  auto f0 = calc_tvfunc(func, ifunc_list, var, base);
+  auto f1 = calc_tvfunc(func, ifunc_list, var, base + (SizeType{1} << var));
+  if ( f0 == f1 ) {
+    return f0;
+  }
+  auto& sel = ifunc_list[var];
+  return (sel & f1) | (~sel & f0);
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,123 @@
+#ifndef TRUTHWRITER_H
+#define TRUTHWRITER_H
+
+/// @file TruthWriter.h
+/// @brief TruthWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ym/TvFunc.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class TruthWriter TruthWriter.h "TruthWriter.h"
+/// @brief BnModel を真理値表形式で出力するクラス
+///
+/// 論理ノードをトポロジカル順にたどって，外部入力を変数とする
+/// 真理値表を求める．
+/// .truth 形式では最後の入力が最上位の変数となるので，
+/// 入力 i は変数 (入力数 - i - 1) に対応させる．
+//////////////////////////////////////////////////////////////////////
+class TruthWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  TruthWriter(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief デストラクタ
+  ~TruthWriter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 真理値表形式で出力する．
+  void
+  write(
+    std::ostream& s ///< [in] 出力先のストリーム
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 各ノードの関数を求める．
+  void
+  calc_funcs();
+
+  /// @brief 論理ノードの関数を求める．
+  TvFunc
+  calc_node(
+    const NodeImpl& node ///< [in] 論理ノード
+  );
+
+  /// @brief プリミティブ型の関数を求める．
+  TvFunc
+  calc_primitive(
+    PrimType primitive_type,              ///< [in] プリミティブの種類
+    const std::vector<TvFunc>& ifunc_list ///< [in] ファンインの関数のリスト
+  );
+
+  /// @brief カバー型の関数を求める．
+  TvFunc
+  calc_cover(
+    const SopCover& cover,                ///< [in] 入力カバー
+    bool output_inv,                      ///< [in] 出力の反転属性
+    const std::vector<TvFunc>& ifunc_list ///< [in] ファンインの関数のリスト
+  );
+
+  /// @brief 論理式型の関数を求める．
+  TvFunc
+  calc_expr(
+    const Expr& expr,                     ///< [in] 論理式
+    const std::vector<TvFunc>& ifunc_list ///< [in] ファンインの関数のリスト
+  );
+
+  /// @brief 真理値表型の関数を求める．
+  ///
+  /// 変数 0 〜 var_num - 1 をシャノン展開する．
+  TvFunc
+  calc_tvfunc(
+    const TvFunc& func,                    ///< [in] 真理値表
+    const std::vector<TvFunc>& ifunc_list, ///< [in] ファンインの関数のリスト
+    SizeType var_num,                      ///< [in] 残りの変数の数
+    SizeType base                          ///< [in] 真理値表の位置の基点
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のモデル
+  const ModelImpl& mModel;
+
+  // 入力数
+  SizeType mInputNum;
+
+  // ノード番号をキーにして関数を格納する配列
+  std::vector<TvFunc> mFuncArray;
+
+  // 関数が求められている時 true となる配列
+  std::vector<bool> mDefined;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // TRUTHWRITER_H
@@ -0,0 +1,178 @@
+
+/// @file write_truth_test.cc
+/// @brief write_truth と並列読み込みのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonValue.h"
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// ファイルの内容を読み込む．
+std::string
+read_contents(
+  const std::string& path
+)
+{
+  std::ifstream s{path};
+  std::string contents;
+  std::string buff;
+  while ( getline(s, buff) ) {
+    contents += buff + '\n';
+  }
+  return contents;
+}
+
+// スレッド数を指定したオプションを作る．
+JsonValue
+thread_option(
+  int thread_num
+)
+{
+  std::unordered_map<std::string, JsonValue> opt_dict;
+  opt_dict.emplace("thread_num", JsonValue{thread_num});
+  return JsonValue{opt_dict};
+}
+
+END_NONAMESPACE
+
+TEST( BnModelTest, write_truth_ex61 )
+{
+  auto path = std::string{DATAPATH} + "ex61.truth";
+  auto model = BnModel::read_truth(path);
+
+  // 読み込んだ内容をそのまま出力できる．
+  std::ostringstream buf;
+  model.write_truth(buf);
+  EXPECT_EQ( read_contents(path), buf.str() );
+}
+
+TEST( BnModelTest, read_truth_parallel )
+{
+  auto path = std::string{DATAPATH} + "ex61.truth";
+  auto model1 = BnModel::read_truth(path);
+  std::ostringstream buf1;
+  model1.print(buf1);
+  for ( int nt: {2, 4, 16} ) {
+    auto model2 = BnModel::read_truth(path, thread_option(nt));
+    std::ostringstream buf2;
+    model2.print(buf2);
+    EXPECT_EQ( buf1.str(), buf2.str() );
+  }
+}
+
+TEST( BnModelTest, read_truth_crlf )
+{
+  // CR LF の改行と空行は無視される．
+  auto path = make_file("crlf.truth", "0110\r\n\r\n1000\r\n");
+  auto model = BnModel::read_truth(path);
+  EXPECT_EQ( 2, model.input_num() );
+  EXPECT_EQ( 2, model.output_num() );
+  std::ostringstream buf;
+  model.write_truth(buf);
+  EXPECT_EQ( "0110\n1000\n", buf.str() );
+}
+
+TEST( BnModelTest, read_truth_bad_line )
+{
+  // 入力数の異なる行
+  auto path1 = make_file("bad1.truth", "0110\n10001000\n");
+  EXPECT_THROW( BnModel::read_truth(path1), std::invalid_argument );
+
+  // 0, 1 以外の文字を含む行
+  auto path2 = make_file("bad2.truth", "0110\n0110\n01x0\n");
+  for ( int nt: {1, 3} ) {
+    EXPECT_THROW( BnModel::read_truth(path2, thread_option(nt)),
+		  std::invalid_argument );
+  }
+}
+
+TEST( BnModelTest, read_truth_bad_file )
+{
+  EXPECT_THROW( BnModel::read_truth("/nonexistent/dir/foo.truth"),
+		std::invalid_argument );
+}
+
+TEST( BnModelTest, write_truth_funcs )
+{
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto c = model.new_input("c");
+  auto n1 = model.new_primitive(PrimType::Xor, {a, b});
+  SopCover cover{2, {{Literal{0, false}, Literal{1, true}}}};
+  auto n2 = model.new_cover(cover, true, {n1, c});
+  auto expr = Expr::literal(0) | (Expr::literal(1) & Expr::literal(2));
+  auto n3 = model.new_expr(expr, {a, b, c});
+  TvFunc mux{"11011000"};
+  auto n4 = model.new_tvfunc(mux, {a, b, c});
+  model.new_output(n1, "o1");
+  model.new_output(n2, "o2");
+  model.new_output(n3, "o3");
+  model.new_output(n4, "o4");
+  model.wrap_up();
+
+  auto path = ::testing::TempDir() + "funcs.truth";
+  model.write_truth(path);
+
+  // 読み戻した結果を全ての入力値について比較する．
+  auto model2 = BnModel::read_truth(path);
+  ASSERT_EQ( 3, model2.input_num() );
+  ASSERT_EQ( 4, model2.output_num() );
+  auto lines = read_contents(path);
+  // 最後の入力 c が最上位の変数となる．
+  // o1 = a ^ b
+  // o2 = ~(o1 & ~c)
+  // o3 = a | (b & c)
+  // o4 = mux(a, b, c) の真理値表をそのまま展開したもの
+  std::string exp_lines;
+  for ( SizeType o = 0; o < 4; ++ o ) {
+    std::string line;
+    for ( int p = 7; p >= 0; -- p ) {
+      bool va = (p >> 2) & 1;
+      bool vb = (p >> 1) & 1;
+      bool vc = (p >> 0) & 1;
+      bool v = false;
+      bool v1 = va != vb;
+      switch ( o ) {
+      case 0: v = v1; break;
+      case 1: v = !(v1 && !vc); break;
+      case 2: v = va || (vb && vc); break;
+      case 3: v = mux.value((va ? 1 : 0) | (vb ? 2 : 0) | (vc ? 4 : 0)); break;
+      }
+      line += v ? '1' : '0';
+    }
+    exp_lines += line + '\n';
+  }
+  EXPECT_EQ( exp_lines, lines );
+}
+
+TEST( BnModelTest, write_truth_dff )
+{
+  BnModel model;
+  auto a = model.new_input("a");
+  auto dff = model.new_dff("q");
+  model.set_dff_src(dff, a);
+  model.new_output(dff.output(), "o");
+  model.wrap_up();
+  std::ostringstream buf;
+  EXPECT_THROW( model.write_truth(buf), std::invalid_argument );
+}
+
+TEST( BnModelTest, write_truth_bad_file )
+{
+  BnModel model;
+  model.new_output(model.new_input("a"), "b");
+  model.wrap_up();
+  EXPECT_THROW( model.write_truth("/nonexistent/dir/foo.truth"),
+		std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
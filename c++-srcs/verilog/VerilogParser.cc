@@ -0,0 +1,1100 @@
+
+/// @file VerilogParser.cc
+/// @brief VerilogParser の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "VerilogParser.h"
+#include "VerilogScanner.h"
+#include "ym/BnModel.h"
+#include "ym/Expr.h"
+#include "ModelImpl.h"
+#include "MappedFile.h"
+#include "ParseFileInfo.h"
+#include "ProgressReporter.h"
+#include "ParseCache.h"
+#include "ym/MsgMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// トークンを表す文字列を返す．
+const char*
+token_str(
+  VerilogToken::Type token
+)
+{
+  switch ( token ) {
+  case VerilogToken::LPAR:      return "(";
+  case VerilogToken::RPAR:      return ")";
+  case VerilogToken::LBK:       return "[";
+  case VerilogToken::RBK:       return "]";
+  case VerilogToken::COMMA:     return ",";
+  case VerilogToken::SEMI:      return ";";
+  case VerilogToken::COLON:     return ":";
+  case VerilogToken::EQ:        return "=";
+  case VerilogToken::LE:        return "<=";
+  case VerilogToken::AT:        return "@";
+  case VerilogToken::SHARP:     return "#";
+  case VerilogToken::QUEST:     return "?";
+  case VerilogToken::NOT:       return "~";
+  case VerilogToken::AND:       return "&";
+  case VerilogToken::OR:        return "|";
+  case VerilogToken::XOR:       return "^";
+  case VerilogToken::XNOR:      return "~^";
+  case VerilogToken::MODULE:    return "module";
+  case VerilogToken::ENDMODULE: return "endmodule";
+  case VerilogToken::INPUT:     return "input";
+  case VerilogToken::OUTPUT:    return "output";
+  case VerilogToken::INOUT:     return "inout";
+  case VerilogToken::WIRE:      return "wire";
+  case VerilogToken::REG:       return "reg";
+  case VerilogToken::ASSIGN:    return "assign";
+  case VerilogToken::ALWAYS:    return "always";
+  case VerilogToken::POSEDGE:   return "posedge";
+  case VerilogToken::NEGEDGE:   return "negedge";
+  case VerilogToken::BEGIN:     return "begin";
+  case VerilogToken::END:       return "end";
+  case VerilogToken::GATE:      return "__gate__";
+  case VerilogToken::NAME:      return "__name__";
+  case VerilogToken::NUMBER:    return "__number__";
+  case VerilogToken::CONST:     return "__const__";
+  case VerilogToken::_EOF:      return "__eof__";
+  case VerilogToken::ERROR:     return "__error__";
+  }
+  ASSERT_NOT_REACHED;
+  return "";
+}
+
+// 論理式に現れる変数に印をつける．
+void
+mark_vars(
+  const Expr& expr,
+  std::vector<bool>& used
+)
+{
+  if ( expr.is_literal() ) {
+    used[expr.varid()] = true;
+    return;
+  }
+  for ( auto& opr: expr.operand_list() ) {
+    mark_vars(opr, used);
+  }
+}
+
+// 論理式の変数番号を付け替える．
+Expr
+remap_expr(
+  const Expr& expr,
+  const std::vector<SizeType>& var_map
+)
+{
+  if ( expr.is_zero() || expr.is_one() ) {
+    return expr;
+  }
+  if ( expr.is_literal() ) {
+    return Expr::literal(var_map[expr.varid()], expr.is_nega_literal());
+  }
+  auto opr_list = expr.operand_list();
+  auto ans = remap_expr(opr_list[0], var_map);
+  for ( SizeType i = 1; i < opr_list.size(); ++ i ) {
+    auto opr = remap_expr(opr_list[i], var_map);
+    if ( expr.is_and() ) {
+      ans = ans & opr;
+    }
+    else if ( expr.is_or() ) {
+      ans = ans | opr;
+    }
+    else {
+      ans = ans ^ opr;
+    }
+  }
+  return ans;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief 構造記述 Verilog ファイルの読み込みを行う．
+BnModel
+BnModel::read_verilog(
+  const std::string& filename,
+  const JsonValue& option
+)
+{
+  ParseCache cache{filename, "verilog", option};
+  BnModel model;
+  if ( cache.load(model) ) {
+    return model;
+  }
+  model._set_read_option(option);
+
+  VerilogParser parser(model._model_impl());
+  if ( !parser.read(filename, ReadOption{option}) ) {
+    std::ostringstream buf;
+    buf << "BnModel::read_verilog(\"" << filename << "\") failed.";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  cache.save(model);
+  return model;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス VerilogParser
+//////////////////////////////////////////////////////////////////////
+
+// @brief 読み込みを行う．
+//
+// 文法：
+//
+// file     = module ;
+// module   = 'module' NAME [ '(' [ ports ] ')' ] ';' { item } 'endmodule' ;
+// ports    = NAME { ',' NAME } | ansi_decl { ',' ansi_decl } ;
+// item     = decl | assign | gate | always ;
+// decl     = ( 'input' | 'output' | 'wire' | 'reg' ) [ 'wire' | 'reg' ]
+//            [ range ] NAME [ '=' expr ] { ',' NAME [ '=' expr ] } ';' ;
+// range    = '[' NUMBER ':' NUMBER ']' ;
+// assign   = 'assign' ref '=' expr { ',' ref '=' expr } ';' ;
+// gate     = GATE [ delay ] inst { ',' inst } ';' ;
+// inst     = [ NAME ] '(' ref { ',' expr } ')' ;
+// always   = 'always' '@' '(' 'posedge' ref ')' ( dff | 'begin' { dff } 'end' ) ;
+// dff      = ref ( '<=' | '=' ) expr ';' ;
+// ref      = NAME [ '[' NUMBER ']' ] ;
+//
+bool
+VerilogParser::read(
+  const std::string& filename,
+  const ReadOption& option
+)
+{
+  if ( option.track_location ) {
+    return read_file(filename, option);
+  }
+
+  // 位置情報を記録せずに読み込む．
+  // 読み直す可能性があるのでメッセージは保留しておく．
+  mTrackLoc = false;
+  mMsgQueue.set_defer(true);
+  auto ok = read_file(filename, option);
+  if ( ok || !mNeedRetry ) {
+    mMsgQueue.flush();
+    return ok;
+  }
+
+  // 位置情報が必要なエラーが見つかったので記録しながら読み直す．
+  mMsgQueue.clear();
+  mModel.clear();
+  VerilogParser parser{mModel};
+  return parser.read_file(filename, option);
+}
+
+// @brief ファイルを開いて読み込む．
+bool
+VerilogParser::read_file(
+  const std::string& filename,
+  const ReadOption& option
+)
+{
+  // ファイルをオープンする．
+  MappedFile fin;
+  if ( !fin.open(filename, option.use_mmap) ) {
+    // エラー
+    std::ostringstream buf;
+    buf << filename << " : No such file.";
+    mMsgQueue.put_msg(__FILE__, __LINE__, FileRegion(),
+		      MsgType::Failure, "VERILOG_PARSER", buf.str());
+    return false;
+  }
+
+  // 圧縮されたファイルは展開済みの部分から読み進める．
+  VerilogScanner scanner(fin.begin(), fin.ready_end(), new_file_info(filename));
+  scanner.set_source(fin);
+  mScanner = &scanner;
+
+  ProgressReporter progress{"read", fin.size_hint(),
+			    ProgressReporter::BYTE_STRIDE};
+
+  next_token();
+  if ( mToken.type() != VerilogToken::MODULE ) {
+    syntax_error(mToken.loc(), "'module' is expected.");
+    return false;
+  }
+  if ( !read_header() ) {
+    return false;
+  }
+
+  // モジュールの本体
+  bool has_error = false;
+  for ( ; ; ) {
+    progress.update(scanner.cur_ptr() - fin.begin(), mModel.node_num());
+    auto type = mToken.type();
+    if ( type == VerilogToken::ENDMODULE ) {
+      next_token();
+      break;
+    }
+    if ( type == VerilogToken::_EOF ) {
+      syntax_error(mToken.loc(), "'endmodule' is expected.");
+      return false;
+    }
+
+    bool ok = false;
+    switch ( type ) {
+    case VerilogToken::INPUT:
+    case VerilogToken::OUTPUT:
+    case VerilogToken::WIRE:
+    case VerilogToken::REG:
+      ok = read_decl();
+      break;
+
+    case VerilogToken::ASSIGN:
+      ok = read_assign();
+      break;
+
+    case VerilogToken::GATE:
+      ok = read_gate(mToken.gate_type());
+      break;
+
+    case VerilogToken::ALWAYS:
+      ok = read_always();
+      break;
+
+    case VerilogToken::INOUT:
+      syntax_error(mToken.loc(), "'inout' is not supported.");
+      break;
+
+    case VerilogToken::NAME:
+      {
+	std::ostringstream buf;
+	buf << mToken.name() << ": Module instances are not supported.";
+	syntax_error(mToken.loc(), buf.str());
+      }
+      break;
+
+    default:
+      syntax_error(mToken.loc(), "Syntax error.");
+      break;
+    }
+    if ( !ok ) {
+      if ( mNeedRetry ) {
+	return false;
+      }
+      has_error = true;
+      // ';' まで読み進める．
+      for ( ; ; ) {
+	auto type = mToken.type();
+	if ( type == VerilogToken::SEMI ) {
+	  next_token();
+	  break;
+	}
+	if ( type == VerilogToken::ENDMODULE ||
+	     type == VerilogToken::_EOF ) {
+	  break;
+	}
+	next_token();
+      }
+    }
+  }
+
+  if ( mToken.type() != VerilogToken::_EOF ) {
+    if ( mToken.type() == VerilogToken::MODULE ) {
+      syntax_error(mToken.loc(), "Only one module is supported.");
+    }
+    else {
+      syntax_error(mToken.loc(), "Syntax error.");
+    }
+    return false;
+  }
+
+  if ( !mTrackLoc ) {
+    // 参照位置がないので未定義のノードが見つかったら読み直す．
+    for ( auto& p: mIdDict ) {
+      if ( !is_defined(p.second) && !has_loc() ) {
+	return false;
+      }
+    }
+  }
+  for ( auto& p: mRefLocDict ) {
+    auto id = p.first;
+    if ( !is_defined(id) ) {
+      std::ostringstream buf;
+      buf << id2str(id) << ": Undefined.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, p.second,
+			MsgType::Error,
+			"UNDEF01", buf.str());
+      return false;
+    }
+  }
+
+  for ( auto& p: mOutputList ) {
+    mModel.new_output(p.first, p.second);
+  }
+
+  progress.set_total(fin.size());
+  progress.finish(mModel.node_num());
+  mModel.make_logic_list();
+
+  return !has_error;
+}
+
+// @brief module 文の先頭からポートリストの末尾の ';' までを読み込む．
+bool
+VerilogParser::read_header()
+{
+  next_token();
+  if ( mToken.type() != VerilogToken::NAME ) {
+    syntax_error(mToken.loc(), "Module name is expected.");
+    return false;
+  }
+  mModel.set_name(mToken.name());
+  next_token();
+
+  if ( mToken.type() == VerilogToken::LPAR ) {
+    next_token();
+    auto type = mToken.type();
+    if ( type == VerilogToken::INPUT ||
+	 type == VerilogToken::OUTPUT ||
+	 type == VerilogToken::INOUT ) {
+      if ( !read_ansi_ports() ) {
+	return false;
+      }
+    }
+    else if ( type == VerilogToken::RPAR ) {
+      next_token();
+    }
+    else {
+      // 従来の形式では名前のみが並ぶ．
+      // 入出力の順番は宣言文で決まるので名前は読み飛ばす．
+      for ( ; ; ) {
+	if ( !expect(VerilogToken::NAME) ) {
+	  return false;
+	}
+	if ( mToken.type() == VerilogToken::RPAR ) {
+	  next_token();
+	  break;
+	}
+	if ( !expect(VerilogToken::COMMA) ) {
+	  return false;
+	}
+      }
+    }
+  }
+
+  return expect(VerilogToken::SEMI);
+}
+
+// @brief ANSI 形式のポートリストを読み込む．
+bool
+VerilogParser::read_ansi_ports()
+{
+  for ( ; ; ) {
+    auto dir = mToken.type();
+    if ( dir == VerilogToken::INOUT ) {
+      syntax_error(mToken.loc(), "'inout' is not supported.");
+      return false;
+    }
+    if ( dir != VerilogToken::INPUT && dir != VerilogToken::OUTPUT ) {
+      syntax_error(mToken.loc(), "'input' or 'output' is expected.");
+      return false;
+    }
+    next_token();
+    if ( !read_decl_body(dir, true) ) {
+      return false;
+    }
+    if ( mToken.type() == VerilogToken::RPAR ) {
+      next_token();
+      return true;
+    }
+  }
+}
+
+// @brief 宣言文を読み込む．
+bool
+VerilogParser::read_decl()
+{
+  auto dir = mToken.type();
+  next_token();
+  if ( !read_decl_body(dir, false) ) {
+    return false;
+  }
+  return expect(VerilogToken::SEMI);
+}
+
+// @brief 宣言の本体を読み込む．
+bool
+VerilogParser::read_decl_body(
+  VerilogToken::Type dir,
+  bool ansi
+)
+{
+  if ( dir == VerilogToken::INPUT || dir == VerilogToken::OUTPUT ) {
+    if ( mToken.type() == VerilogToken::WIRE ||
+	 mToken.type() == VerilogToken::REG ) {
+      next_token();
+    }
+  }
+
+  SizeType msb = 0;
+  SizeType lsb = 0;
+  bool is_vector = false;
+  if ( mToken.type() == VerilogToken::LBK ) {
+    if ( !read_range(msb, lsb) ) {
+      return false;
+    }
+    is_vector = true;
+  }
+
+  for ( ; ; ) {
+    if ( mToken.type() != VerilogToken::NAME ) {
+      syntax_error(mToken.loc(), "Name is expected.");
+      return false;
+    }
+    auto name = mToken.name();
+    auto loc = mToken.loc();
+    next_token();
+    if ( is_vector ) {
+      // MSB から順にビットごとのネットに展開する．
+      mVectorDict.emplace(name, std::make_pair(msb, lsb));
+      for ( SizeType i = msb; ; ) {
+	std::ostringstream buf;
+	buf << name << "[" << i << "]";
+	if ( !declare(dir, buf.str(), loc) ) {
+	  return false;
+	}
+	if ( i == lsb ) {
+	  break;
+	}
+	if ( msb > lsb ) {
+	  -- i;
+	}
+	else {
+	  ++ i;
+	}
+      }
+    }
+    else {
+      if ( !declare(dir, name, loc) ) {
+	return false;
+      }
+      if ( !ansi && dir == VerilogToken::WIRE &&
+	   mToken.type() == VerilogToken::EQ ) {
+	// ネット宣言代入
+	next_token();
+	auto id = find_id(name, loc);
+	if ( !read_assign_rhs(id, loc) ) {
+	  return false;
+	}
+      }
+    }
+    if ( mToken.type() != VerilogToken::COMMA ) {
+      return true;
+    }
+    next_token();
+    if ( ansi ) {
+      auto type = mToken.type();
+      if ( type == VerilogToken::INPUT ||
+	   type == VerilogToken::OUTPUT ||
+	   type == VerilogToken::INOUT ) {
+	return true;
+      }
+    }
+  }
+}
+
+// @brief 範囲指定 '[' msb ':' lsb ']' を読み込む．
+bool
+VerilogParser::read_range(
+  SizeType& msb,
+  SizeType& lsb
+)
+{
+  next_token();
+  if ( mToken.type() != VerilogToken::NUMBER ) {
+    syntax_error(mToken.loc(), "Number is expected.");
+    return false;
+  }
+  msb = mToken.value();
+  next_token();
+  if ( !expect(VerilogToken::COLON) ) {
+    return false;
+  }
+  if ( mToken.type() != VerilogToken::NUMBER ) {
+    syntax_error(mToken.loc(), "Number is expected.");
+    return false;
+  }
+  lsb = mToken.value();
+  next_token();
+  return expect(VerilogToken::RBK);
+}
+
+// @brief 1ビット分の宣言を処理する．
+bool
+VerilogParser::declare(
+  VerilogToken::Type dir,
+  const std::string& name,
+  const FileRegion& loc
+)
+{
+  if ( dir == VerilogToken::INPUT ) {
+    auto id = find_id(name, loc);
+    if ( !check_multi_def(id, loc) ) {
+      return false;
+    }
+    set_defined(id, loc);
+    mModel.set_input(id, name);
+  }
+  else if ( dir == VerilogToken::OUTPUT ) {
+    auto id = find_id(name, loc);
+    if ( mOutputSet.count(id) > 0 ) {
+      std::ostringstream buf;
+      buf << name << ": Declared as output more than once.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, loc,
+			MsgType::Error,
+			"ER_MLTDEF02",
+			buf.str());
+      return false;
+    }
+    mOutputSet.emplace(id);
+    mOutputList.push_back({id, name});
+  }
+  // wire と reg は定義の時に名前が登録されるので何もしない．
+  return true;
+}
+
+// @brief assign 文を読み込む．
+bool
+VerilogParser::read_assign()
+{
+  next_token();
+  for ( ; ; ) {
+    SizeType id;
+    FileRegion loc;
+    if ( !read_net_ref(id, loc) ) {
+      return false;
+    }
+    if ( !expect(VerilogToken::EQ) ) {
+      return false;
+    }
+    if ( !read_assign_rhs(id, loc) ) {
+      return false;
+    }
+    if ( mToken.type() != VerilogToken::COMMA ) {
+      break;
+    }
+    next_token();
+  }
+  return expect(VerilogToken::SEMI);
+}
+
+// @brief 代入の右辺を読み込んで論理ノードを作る．
+bool
+VerilogParser::read_assign_rhs(
+  SizeType id,
+  const FileRegion& loc
+)
+{
+  VarMap var_map;
+  Expr expr;
+  if ( !read_expr(var_map, expr) ) {
+    return false;
+  }
+  if ( !check_multi_def(id, loc) ) {
+    return false;
+  }
+  set_defined(id, loc);
+  std::vector<SizeType> fanin_list;
+  auto func_id = reg_func(expr, var_map, fanin_list);
+  mModel.set_logic(id, func_id, fanin_list);
+  mModel.set_node_name(id, id2str(id));
+  return true;
+}
+
+// @brief プリミティブゲートのインスタンス文を読み込む．
+bool
+VerilogParser::read_gate(
+  PrimType gate_type
+)
+{
+  next_token();
+
+  // 遅延は読み飛ばす．
+  if ( mToken.type() == VerilogToken::SHARP ) {
+    next_token();
+    if ( mToken.type() == VerilogToken::NUMBER ) {
+      next_token();
+    }
+    else if ( mToken.type() == VerilogToken::LPAR ) {
+      while ( mToken.type() != VerilogToken::RPAR ) {
+	if ( mToken.type() == VerilogToken::_EOF ) {
+	  syntax_error(mToken.loc(), "')' is expected.");
+	  return false;
+	}
+	next_token();
+      }
+      next_token();
+    }
+    else {
+      syntax_error(mToken.loc(), "Delay value is expected.");
+      return false;
+    }
+  }
+
+  for ( ; ; ) {
+    // インスタンス名は省略可能
+    if ( mToken.type() == VerilogToken::NAME ) {
+      next_token();
+    }
+    if ( !expect(VerilogToken::LPAR) ) {
+      return false;
+    }
+    SizeType oid;
+    FileRegion oloc;
+    if ( !read_net_ref(oid, oloc) ) {
+      return false;
+    }
+    std::vector<SizeType> fanin_list;
+    while ( mToken.type() == VerilogToken::COMMA ) {
+      next_token();
+      VarMap var_map;
+      Expr expr;
+      if ( !read_expr(var_map, expr) ) {
+	return false;
+      }
+      fanin_list.push_back(make_node(expr, var_map));
+    }
+    if ( !expect(VerilogToken::RPAR) ) {
+      return false;
+    }
+
+    // 入力数をチェックする．
+    auto ni = fanin_list.size();
+    bool single = gate_type == PrimType::Buff || gate_type == PrimType::Not;
+    if ( ni == 0 || (single && ni != 1) ) {
+      std::ostringstream buf;
+      buf << id2str(oid) << ": Wrong # of terminals.";
+      mMsgQueue.put_msg(__FILE__, __LINE__, oloc,
+			MsgType::Error,
+			"ER_GATE01",
+			buf.str());
+      return false;
+    }
+    if ( !check_multi_def(oid, oloc) ) {
+      return false;
+    }
+    set_defined(oid, oloc);
+    auto func_id = mModel.reg_primitive(ni, gate_type);
+    mModel.set_logic(oid, func_id, fanin_list);
+    mModel.set_node_name(oid, id2str(oid));
+
+    if ( mToken.type() != VerilogToken::COMMA ) {
+      break;
+    }
+    next_token();
+  }
+  return expect(VerilogToken::SEMI);
+}
+
+// @brief always 文を読み込む．
+bool
+VerilogParser::read_always()
+{
+  next_token();
+  if ( !expect(VerilogToken::AT) ) {
+    return false;
+  }
+  if ( !expect(VerilogToken::LPAR) ) {
+    return false;
+  }
+  if ( mToken.type() == VerilogToken::NEGEDGE ) {
+    syntax_error(mToken.loc(), "'negedge' is not supported.");
+    return false;
+  }
+  if ( !expect(VerilogToken::POSEDGE) ) {
+    return false;
+  }
+  // クロックは参照するだけ
+  SizeType clock_id;
+  FileRegion clock_loc;
+  if ( !read_net_ref(clock_id, clock_loc) ) {
+    return false;
+  }
+  if ( !expect(VerilogToken::RPAR) ) {
+    return false;
+  }
+
+  if ( mToken.type() == VerilogToken::BEGIN ) {
+    next_token();
+    while ( mToken.type() != VerilogToken::END ) {
+      if ( mToken.type() == VerilogToken::_EOF ) {
+	syntax_error(mToken.loc(), "'end' is expected.");
+	return false;
+      }
+      if ( !read_dff_assign() ) {
+	return false;
+      }
+    }
+    next_token();
+    return true;
+  }
+  return read_dff_assign();
+}
+
+// @brief ノンブロッキング代入文を読み込んで DFF を作る．
+bool
+VerilogParser::read_dff_assign()
+{
+  SizeType id;
+  FileRegion loc;
+  if ( !read_net_ref(id, loc) ) {
+    return false;
+  }
+  if ( mToken.type() != VerilogToken::LE &&
+       mToken.type() != VerilogToken::EQ ) {
+    syntax_error(mToken.loc(), "'<=' is expected.");
+    return false;
+  }
+  next_token();
+  VarMap var_map;
+  Expr expr;
+  if ( !read_expr(var_map, expr) ) {
+    return false;
+  }
+  if ( !expect(VerilogToken::SEMI) ) {
+    return false;
+  }
+  if ( !check_multi_def(id, loc) ) {
+    return false;
+  }
+  set_defined(id, loc);
+  auto src_id = make_node(expr, var_map);
+  auto& name = id2str(id);
+  auto dff_id = mModel.new_dff(name);
+  mModel.set_dff_output(id, dff_id);
+  mModel.set_dff_src(dff_id, src_id);
+  mModel.set_node_name(id, name);
+  return true;
+}
+
+// @brief 1ビットのネットの参照を読み込む．
+bool
+VerilogParser::read_net_ref(
+  SizeType& id,
+  FileRegion& loc
+)
+{
+  if ( mToken.type() != VerilogToken::NAME ) {
+    syntax_error(mToken.loc(), "Name is expected.");
+    return false;
+  }
+  auto name = mToken.name();
+  loc = mToken.loc();
+  next_token();
+  if ( mToken.type() == VerilogToken::LBK ) {
+    next_token();
+    if ( mToken.type() != VerilogToken::NUMBER ) {
+      syntax_error(mToken.loc(), "Bit index is expected.");
+      return false;
+    }
+    std::ostringstream buf;
+    buf << name << "[" << mToken.value() << "]";
+    name = buf.str();
+    next_token();
+    auto last_loc = mToken.loc();
+    if ( !expect(VerilogToken::RBK) ) {
+      return false;
+    }
+    loc = FileRegion{loc, last_loc};
+  }
+  else if ( mVectorDict.count(name) > 0 ) {
+    std::ostringstream buf;
+    buf << name << ": Vector references are not supported.";
+    syntax_error(loc, buf.str());
+    return false;
+  }
+  id = find_id(name, loc);
+  return true;
+}
+
+// @brief 式を読み込む．
+bool
+VerilogParser::read_expr(
+  VarMap& var_map,
+  Expr& expr
+)
+{
+  if ( !read_or_expr(var_map, expr) ) {
+    return false;
+  }
+  if ( mToken.type() != VerilogToken::QUEST ) {
+    return true;
+  }
+  next_token();
+  Expr expr1;
+  if ( !read_expr(var_map, expr1) ) {
+    return false;
+  }
+  if ( !expect(VerilogToken::COLON) ) {
+    return false;
+  }
+  Expr expr0;
+  if ( !read_expr(var_map, expr0) ) {
+    return false;
+  }
+  expr = (expr & expr1) | (~expr & expr0);
+  return true;
+}
+
+// @brief '|' の式を読み込む．
+bool
+VerilogParser::read_or_expr(
+  VarMap& var_map,
+  Expr& expr
+)
+{
+  if ( !read_xor_expr(var_map, expr) ) {
+    return false;
+  }
+  while ( mToken.type() == VerilogToken::OR ) {
+    next_token();
+    Expr expr1;
+    if ( !read_xor_expr(var_map, expr1) ) {
+      return false;
+    }
+    expr = expr | expr1;
+  }
+  return true;
+}
+
+// @brief '^' の式を読み込む．
+bool
+VerilogParser::read_xor_expr(
+  VarMap& var_map,
+  Expr& expr
+)
+{
+  if ( !read_and_expr(var_map, expr) ) {
+    return false;
+  }
+  for ( ; ; ) {
+    auto type = mToken.type();
+    if ( type != VerilogToken::XOR && type != VerilogToken::XNOR ) {
+      break;
+    }
+    next_token();
+    Expr expr1;
+    if ( !read_and_expr(var_map, expr1) ) {
+      return false;
+    }
+    expr = expr ^ expr1;
+    if ( type == VerilogToken::XNOR ) {
+      expr = ~expr;
+    }
+  }
+  return true;
+}
+
+// @brief '&' の式を読み込む．
+bool
+VerilogParser::read_and_expr(
+  VarMap& var_map,
+  Expr& expr
+)
+{
+  if ( !read_primary(var_map, expr) ) {
+    return false;
+  }
+  while ( mToken.type() == VerilogToken::AND ) {
+    next_token();
+    Expr expr1;
+    if ( !read_primary(var_map, expr1) ) {
+      return false;
+    }
+    expr = expr & expr1;
+  }
+  return true;
+}
+
+// @brief 単項演算子とプライマリを読み込む．
+bool
+VerilogParser::read_primary(
+  VarMap& var_map,
+  Expr& expr
+)
+{
+  switch ( mToken.type() ) {
+  case VerilogToken::NOT:
+    next_token();
+    if ( !read_primary(var_map, expr) ) {
+      return false;
+    }
+    expr = ~expr;
+    return true;
+
+  case VerilogToken::LPAR:
+    next_token();
+    if ( !read_expr(var_map, expr) ) {
+      return false;
+    }
+    return expect(VerilogToken::RPAR);
+
+  case VerilogToken::NUMBER:
+  case VerilogToken::CONST:
+    if ( mToken.value() > 1 ) {
+      syntax_error(mToken.loc(), "Only 1-bit constants are supported.");
+      return false;
+    }
+    expr = mToken.value() == 0 ? Expr::zero() : Expr::one();
+    next_token();
+    return true;
+
+  case VerilogToken::NAME:
+    {
+      SizeType id;
+      FileRegion loc;
+      if ( !read_net_ref(id, loc) ) {
+	return false;
+      }
+      expr = Expr::literal(var_map.var(id));
+    }
+    return true;
+
+  default:
+    break;
+  }
+  syntax_error(mToken.loc(), "Syntax error in expression.");
+  return false;
+}
+
+// @brief 論理式を関数として登録する．
+SizeType
+VerilogParser::reg_func(
+  const Expr& expr,
+  const VarMap& var_map,
+  std::vector<SizeType>& fanin_list
+)
+{
+  auto& id_list = var_map.id_list;
+  fanin_list.clear();
+  if ( expr.is_zero() ) {
+    return mModel.reg_primitive(0, PrimType::C0);
+  }
+  if ( expr.is_one() ) {
+    return mModel.reg_primitive(0, PrimType::C1);
+  }
+  if ( expr.is_literal() ) {
+    fanin_list.push_back(id_list[expr.varid()]);
+    auto type = expr.is_posi_literal() ? PrimType::Buff : PrimType::Not;
+    return mModel.reg_primitive(1, type);
+  }
+
+  // 肯定リテラルのみの AND/OR/XOR はプリミティブにする．
+  bool simple = true;
+  for ( auto& opr: expr.operand_list() ) {
+    if ( !opr.is_posi_literal() ) {
+      simple = false;
+      break;
+    }
+    fanin_list.push_back(id_list[opr.varid()]);
+  }
+  if ( simple ) {
+    auto type = expr.is_and() ? PrimType::And :
+      expr.is_or() ? PrimType::Or : PrimType::Xor;
+    return mModel.reg_primitive(fanin_list.size(), type);
+  }
+
+  // 簡単化で消えた変数はファンインに含めない．
+  auto n = id_list.size();
+  std::vector<bool> used(n, false);
+  mark_vars(expr, used);
+  std::vector<SizeType> new_var(n, BAD_ID);
+  fanin_list.clear();
+  for ( SizeType var = 0; var < n; ++ var ) {
+    if ( used[var] ) {
+      new_var[var] = fanin_list.size();
+      fanin_list.push_back(id_list[var]);
+    }
+  }
+  if ( fanin_list.size() == n ) {
+    return mModel.reg_expr(expr);
+  }
+  return mModel.reg_expr(remap_expr(expr, new_var));
+}
+
+// @brief 論理式に対応するノードを返す．
+SizeType
+VerilogParser::make_node(
+  const Expr& expr,
+  const VarMap& var_map
+)
+{
+  if ( expr.is_posi_literal() ) {
+    return var_map.id_list[expr.varid()];
+  }
+  std::vector<SizeType> fanin_list;
+  auto func_id = reg_func(expr, var_map, fanin_list);
+  return mModel.new_logic(func_id, fanin_list);
+}
+
+// @brief 定義済みかチェックする．
+bool
+VerilogParser::check_multi_def(
+  SizeType id,
+  const FileRegion& loc
+)
+{
+  if ( is_defined(id) ) {
+    if ( !has_loc() ) {
+      return false;
+    }
+    auto& loc2 = mDefLocDict.at(id);
+    std::ostringstream buf;
+    buf << id2str(id) << ": Defined more than once. "
+	<< "Previous definition is at " << loc2;
+    mMsgQueue.put_msg(__FILE__, __LINE__, loc,
+		      MsgType::Error,
+		      "ER_MLTDEF01",
+		      buf.str());
+    return false;
+  }
+  return true;
+}
+
+// @brief 現在のトークンが期待されている型か調べる．
+bool
+VerilogParser::expect(
+  VerilogToken::Type exp_type
+)
+{
+  if ( mToken.type() != exp_type ) {
+    std::ostringstream buf;
+    buf << "Syntax error: '" << token_str(exp_type) << "' is expected.";
+    syntax_error(mToken.loc(), buf.str());
+    return false;
+  }
+  next_token();
+  return true;
+}
+
+// @brief シンタックスエラーを出力する．
+void
+VerilogParser::syntax_error(
+  const FileRegion& loc,
+  const std::string& msg
+)
+{
+  mMsgQueue.put_msg(__FILE__, __LINE__, loc,
+		    MsgType::Error,
+		    "ER_SYNTAX01",
+		    msg);
+}
+
+END_NAMESPACE_YM_BN
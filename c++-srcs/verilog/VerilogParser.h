@@ -0,0 +1,435 @@
+#ifndef VERILOGPARSER_H
+#define VERILOGPARSER_H
+
+/// @file VerilogParser.h
+/// @brief VerilogParser のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ym/FileRegion.h"
+#include "VerilogScanner.h"
+#include "VerilogToken.h"
+#include "ModelImpl.h"
+#include "ReadOption.h"
+#include "MsgQueue.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class VerilogParser VerilogParser.h "VerilogParser.h"
+/// @brief 構造記述 Verilog を読み込むパーサークラス
+///
+/// 以下のサブセットのみを扱う．
+/// - 1つのモジュール(ポートリストは ANSI 形式と従来の形式のどちらでもよい)
+/// - input/output/wire/reg 宣言(範囲指定付きのベクタはビットごとに
+///   "name[i]" という名前のネットに展開する)
+/// - ~, &, |, ^, ~^, ?: と定数(1'b0, 1'b1)からなる式の assign 文
+/// - and/nand/or/nor/xor/xnor/buf/not のプリミティブゲートのインスタンス
+/// - always @(posedge clk) 文中のノンブロッキング代入による DFF
+///
+/// 構文木は作らずに，文を読むごとに ModelImpl に直接ノードを作る．
+/// クロック信号は通常の入力として扱う．
+//////////////////////////////////////////////////////////////////////
+class VerilogParser
+{
+public:
+
+  /// @brief コンストラクタ
+  VerilogParser(
+    ModelImpl& model ///< [in] 結果を格納するオブジェクト
+  ) : mModel{model}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~VerilogParser() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込みを行う．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read(
+    const std::string& filename,            ///< [in] ファイル名
+    const ReadOption& option = ReadOption{} ///< [in] 読み込みオプション
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  // 式の変数とノードの対応を記録するクラス
+  struct VarMap
+  {
+    // 変数番号をキーにしてノード番号を格納する配列
+    std::vector<SizeType> id_list;
+
+    // ノード番号をキーにして変数番号を格納する辞書
+    std::unordered_map<SizeType, SizeType> var_dict;
+
+    // ノード番号に対応する変数番号を返す．
+    SizeType
+    var(
+      SizeType id
+    )
+    {
+      auto p = var_dict.find(id);
+      if ( p != var_dict.end() ) {
+	return p->second;
+      }
+      auto var = id_list.size();
+      id_list.push_back(id);
+      var_dict.emplace(id, var);
+      return var;
+    }
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを開いて読み込む．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read_file(
+    const std::string& filename, ///< [in] ファイル名
+    const ReadOption& option     ///< [in] 読み込みオプション
+  );
+
+  /// @brief module 文の先頭からポートリストの末尾の ';' までを読み込む．
+  /// @return エラーが起きたら false を返す．
+  bool
+  read_header();
+
+  /// @brief ANSI 形式のポートリストを読み込む．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// 最初の方向指定子が現在のトークンとなっている．
+  /// 末尾の ')' を読んだところで終わる．
+  bool
+  read_ansi_ports();
+
+  /// @brief 宣言文を読み込む．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// 宣言のキーワードが現在のトークンとなっている．
+  bool
+  read_decl();
+
+  /// @brief 宣言の本体を読み込む．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// [wire|reg] [範囲] 名前 { , 名前 } を読み込む．
+  /// ansi が true の時は ',' の後が方向指定子の場合にそこで止まる．
+  bool
+  read_decl_body(
+    VerilogToken::Type dir, ///< [in] 宣言の種類(INPUT/OUTPUT/WIRE/REG)
+    bool ansi               ///< [in] ANSI 形式のポートリストの時 true
+  );
+
+  /// @brief 範囲指定 '[' msb ':' lsb ']' を読み込む．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// '[' が現在のトークンとなっている．
+  bool
+  read_range(
+    SizeType& msb, ///< [out] 左側の値
+    SizeType& lsb  ///< [out] 右側の値
+  );
+
+  /// @brief 1ビット分の宣言を処理する．
+  /// @return エラーが起きたら false を返す．
+  bool
+  declare(
+    VerilogToken::Type dir,  ///< [in] 宣言の種類
+    const std::string& name, ///< [in] 名前
+    const FileRegion& loc    ///< [in] ファイル上の位置
+  );
+
+  /// @brief assign 文を読み込む．
+  /// @return エラーが起きたら false を返す．
+  bool
+  read_assign();
+
+  /// @brief 代入の右辺を読み込んで論理ノードを作る．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// '=' の次のトークンが現在のトークンとなっている．
+  bool
+  read_assign_rhs(
+    SizeType id,          ///< [in] 左辺のノード番号
+    const FileRegion& loc ///< [in] 左辺のファイル上の位置
+  );
+
+  /// @brief プリミティブゲートのインスタンス文を読み込む．
+  /// @return エラーが起きたら false を返す．
+  bool
+  read_gate(
+    PrimType gate_type ///< [in] ゲートの種類
+  );
+
+  /// @brief always 文を読み込む．
+  /// @return エラーが起きたら false を返す．
+  bool
+  read_always();
+
+  /// @brief ノンブロッキング代入文を読み込んで DFF を作る．
+  /// @return エラーが起きたら false を返す．
+  bool
+  read_dff_assign();
+
+  /// @brief 1ビットのネットの参照を読み込む．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// NAME [ '[' NUMBER ']' ] の形をとる．
+  bool
+  read_net_ref(
+    SizeType& id,   ///< [out] ノード番号
+    FileRegion& loc ///< [out] ファイル上の位置
+  );
+
+  /// @brief 式を読み込む．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// 演算子の優先順位は ~ > & > ^,~^ > | > ?: となる．
+  bool
+  read_expr(
+    VarMap& var_map, ///< [inout] 変数の対応表
+    Expr& expr       ///< [out] 結果の論理式
+  );
+
+  /// @brief '|' の式を読み込む．
+  bool
+  read_or_expr(
+    VarMap& var_map, ///< [inout] 変数の対応表
+    Expr& expr       ///< [out] 結果の論理式
+  );
+
+  /// @brief '^' の式を読み込む．
+  bool
+  read_xor_expr(
+    VarMap& var_map, ///< [inout] 変数の対応表
+    Expr& expr       ///< [out] 結果の論理式
+  );
+
+  /// @brief '&' の式を読み込む．
+  bool
+  read_and_expr(
+    VarMap& var_map, ///< [inout] 変数の対応表
+    Expr& expr       ///< [out] 結果の論理式
+  );
+
+  /// @brief 単項演算子とプライマリを読み込む．
+  bool
+  read_primary(
+    VarMap& var_map, ///< [inout] 変数の対応表
+    Expr& expr       ///< [out] 結果の論理式
+  );
+
+  /// @brief 論理式を関数として登録する．
+  /// @return 関数番号を返す．
+  ///
+  /// 定数，リテラル，リテラルの AND/OR/XOR はプリミティブ型となる．
+  SizeType
+  reg_func(
+    const Expr& expr,                 ///< [in] 論理式
+    const VarMap& var_map,            ///< [in] 変数の対応表
+    std::vector<SizeType>& fanin_list ///< [out] ファンインのノード番号のリスト
+  );
+
+  /// @brief 論理式に対応するノードを返す．
+  ///
+  /// 式が単一の肯定リテラルの場合はそのノードを返す．
+  /// それ以外は新しい論理ノードを作る．
+  SizeType
+  make_node(
+    const Expr& expr,     ///< [in] 論理式
+    const VarMap& var_map ///< [in] 変数の対応表
+  );
+
+  /// @brief 定義済みかチェックする．
+  /// @return 二重定義の時はエラーメッセージを出力して false を返す．
+  bool
+  check_multi_def(
+    SizeType id,          ///< [in] ノード番号
+    const FileRegion& loc ///< [in] ファイル上の位置
+  );
+
+  /// @brief 次のトークンを読み込んで現在のトークンとする．
+  void
+  next_token()
+  {
+    mToken = mScanner->read_token();
+  }
+
+  /// @brief 現在のトークンが期待されている型か調べる．
+  /// @return 異なっていたらエラーメッセージを出力して false を返す．
+  ///
+  /// 型が等しければ次のトークンに進む．
+  bool
+  expect(
+    VerilogToken::Type exp_type ///< [in] トークンの期待値
+  );
+
+  /// @brief シンタックスエラーを出力する．
+  void
+  syntax_error(
+    const FileRegion& loc, ///< [in] ファイル上の位置
+    const std::string& msg ///< [in] メッセージ
+  );
+
+  /// @brief 新しいノードを確保する．
+  /// @return ID番号を返す．
+  SizeType
+  new_node(
+    const FileRegion& loc ///< [in] ファイル上の位置
+  )
+  {
+    auto id = mModel.alloc_node();
+    if ( mTrackLoc ) {
+      mRefLocDict.emplace(id, loc);
+    }
+    return id;
+  }
+
+  /// @brief 識別子番号を得る．
+  ///
+  /// 登録されていなければ新しく作る．
+  SizeType
+  find_id(
+    const std::string& name,
+    const FileRegion& loc
+  )
+  {
+    auto p = mIdDict.find(name);
+    if ( p != mIdDict.end() ) {
+      return p->second;
+    }
+    auto id = new_node(loc);
+    mIdDict.emplace(name, id);
+    mNameDict.emplace(id, name);
+    return id;
+  }
+
+  /// @brief ID 番号から文字列を得る．
+  const std::string&
+  id2str(
+    SizeType id ///< [in] ID番号
+  ) const
+  {
+    return mNameDict.at(id);
+  }
+
+  /// @brief 定義済みの印をつける．
+  void
+  set_defined(
+    SizeType id,          ///< [in] ID番号
+    const FileRegion& loc ///< ファイル上の位置
+  )
+  {
+    // 式から作られたノードも含まれるので必要に応じて拡張する．
+    if ( id >= mDefinedArray.size() ) {
+      mDefinedArray.resize(id + 1, false);
+    }
+    mDefinedArray[id] = true;
+    if ( mTrackLoc ) {
+      mDefLocDict.emplace(id, loc);
+    }
+  }
+
+  /// @brief 該当の識別子が定義済みか調べる．
+  bool
+  is_defined(
+    SizeType id ///< [in] ID番号
+  ) const
+  {
+    return id < mDefinedArray.size() && mDefinedArray[id];
+  }
+
+  /// @brief 位置情報が使えるか調べる．
+  /// @retval true 参照位置と定義位置が記録されている．
+  /// @retval false 位置情報を記録していない．
+  ///
+  /// false の場合は読み直しが必要な印をつける．
+  bool
+  has_loc()
+  {
+    if ( !mTrackLoc ) {
+      mNeedRetry = true;
+    }
+    return mTrackLoc;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 結果を格納するオブジェクト
+  ModelImpl& mModel;
+
+  // 字句解析器
+  // この変数の値は read() 内のみで意味を持つ．
+  VerilogScanner* mScanner;
+
+  // 現在のトークン
+  VerilogToken mToken;
+
+  // 名前をキーにした識別子の辞書
+  std::unordered_map<std::string, SizeType> mIdDict;
+
+  // ID をキーにして名前を格納する辞書
+  std::unordered_map<SizeType, std::string> mNameDict;
+
+  // ベクタ名をキーにして範囲(msb, lsb)を格納する辞書
+  std::unordered_map<std::string, std::pair<SizeType, SizeType>> mVectorDict;
+
+  // 参照位置と定義位置を記録する時 true
+  bool mTrackLoc{true};
+
+  // 位置情報を記録しながら読み直す必要がある時 true
+  bool mNeedRetry{false};
+
+  // 定義済みの印をノード番号ごとに格納する配列
+  std::vector<bool> mDefinedArray;
+
+  // 参照された位置を記録する辞書
+  //
+  // mTrackLoc が true の時のみ用いる．
+  std::unordered_map<SizeType, FileRegion> mRefLocDict;
+
+  // 定義された位置を記録する辞書
+  //
+  // mTrackLoc が true の時のみ用いる．
+  std::unordered_map<SizeType, FileRegion> mDefLocDict;
+
+  // output 宣言された名前のリスト
+  std::vector<std::pair<SizeType, std::string>> mOutputList;
+
+  // 出力宣言済みのノード番号の集合
+  std::unordered_set<SizeType> mOutputSet;
+
+  // メッセージの出力を保留するためのオブジェクト
+  MsgQueue mMsgQueue;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // VERILOGPARSER_H
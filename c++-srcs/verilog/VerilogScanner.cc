@@ -0,0 +1,334 @@
+
+/// @file VerilogScanner.cc
+/// @brief VerilogScanner の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "VerilogScanner.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 識別子の2文字目以降に使える文字の時 true を返す．
+inline
+bool
+is_word_char(
+  int c
+)
+{
+  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+    ('0' <= c && c <= '9') || c == '_' || c == '$';
+}
+
+// 空白文字の時 true を返す．
+inline
+bool
+is_space(
+  int c
+)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// 構造記述 Verilog 用の字句解析器
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+VerilogScanner::VerilogScanner(
+  const char* begin,
+  const char* end,
+  const FileInfo& file_info
+) : BufScanner{begin, end, file_info}
+{
+  // 予約語辞書を作る．
+  mRsvDict.emplace("module", RsvInfo{VerilogToken::MODULE, PrimType::None});
+  mRsvDict.emplace("endmodule", RsvInfo{VerilogToken::ENDMODULE, PrimType::None});
+  mRsvDict.emplace("input", RsvInfo{VerilogToken::INPUT, PrimType::None});
+  mRsvDict.emplace("output", RsvInfo{VerilogToken::OUTPUT, PrimType::None});
+  mRsvDict.emplace("inout", RsvInfo{VerilogToken::INOUT, PrimType::None});
+  mRsvDict.emplace("wire", RsvInfo{VerilogToken::WIRE, PrimType::None});
+  mRsvDict.emplace("reg", RsvInfo{VerilogToken::REG, PrimType::None});
+  mRsvDict.emplace("assign", RsvInfo{VerilogToken::ASSIGN, PrimType::None});
+  mRsvDict.emplace("always", RsvInfo{VerilogToken::ALWAYS, PrimType::None});
+  mRsvDict.emplace("posedge", RsvInfo{VerilogToken::POSEDGE, PrimType::None});
+  mRsvDict.emplace("negedge", RsvInfo{VerilogToken::NEGEDGE, PrimType::None});
+  mRsvDict.emplace("begin", RsvInfo{VerilogToken::BEGIN, PrimType::None});
+  mRsvDict.emplace("end", RsvInfo{VerilogToken::END, PrimType::None});
+  mRsvDict.emplace("buf", RsvInfo{VerilogToken::GATE, PrimType::Buff});
+  mRsvDict.emplace("not", RsvInfo{VerilogToken::GATE, PrimType::Not});
+  mRsvDict.emplace("and", RsvInfo{VerilogToken::GATE, PrimType::And});
+  mRsvDict.emplace("nand", RsvInfo{VerilogToken::GATE, PrimType::Nand});
+  mRsvDict.emplace("or", RsvInfo{VerilogToken::GATE, PrimType::Or});
+  mRsvDict.emplace("nor", RsvInfo{VerilogToken::GATE, PrimType::Nor});
+  mRsvDict.emplace("xor", RsvInfo{VerilogToken::GATE, PrimType::Xor});
+  mRsvDict.emplace("xnor", RsvInfo{VerilogToken::GATE, PrimType::Xnor});
+}
+
+// @brief トークンを一つ読み出す．
+VerilogToken
+VerilogScanner::read_token()
+{
+  auto type = scan();
+  auto loc = cur_region();
+  if ( type == VerilogToken::NAME ) {
+    if ( !mEscaped ) {
+      auto p = mRsvDict.find(mCurString);
+      if ( p != mRsvDict.end() ) {
+	auto& info = p->second;
+	return VerilogToken{info.type, loc, info.gate_type};
+      }
+    }
+    return VerilogToken{VerilogToken::NAME, loc, PrimType::None, mCurString};
+  }
+  if ( type == VerilogToken::NUMBER || type == VerilogToken::CONST ) {
+    return VerilogToken{type, loc, PrimType::None, {}, mCurValue};
+  }
+  return VerilogToken{type, loc};
+}
+
+// @brief read_token() の下請け関数
+VerilogToken::Type
+VerilogScanner::scan()
+{
+  int c;
+
+  mCurString.clear();
+  mEscaped = false;
+
+  // 状態遷移を goto 文で表現したもの
+
+ ST_INIT:
+  c = get();
+  set_first_loc();
+  switch ( c ) {
+  case EOF:
+    return VerilogToken::_EOF;
+
+  case ' ':
+  case '\t':
+  case '\n':
+  case '\f':
+    // ホワイトスペースは読み飛ばす．
+    goto ST_INIT;
+
+  case '/':
+    c = peek();
+    if ( c == '/' ) {
+      accept();
+      goto ST_LINE_COMMENT;
+    }
+    if ( c == '*' ) {
+      accept();
+      goto ST_BLOCK_COMMENT;
+    }
+    return VerilogToken::ERROR;
+
+  case '`':
+    // コンパイラ指示子は行末まで読み飛ばす．
+    goto ST_LINE_COMMENT;
+
+  case '(': return VerilogToken::LPAR;
+  case ')': return VerilogToken::RPAR;
+  case '[': return VerilogToken::LBK;
+  case ']': return VerilogToken::RBK;
+  case ',': return VerilogToken::COMMA;
+  case ';': return VerilogToken::SEMI;
+  case ':': return VerilogToken::COLON;
+  case '=': return VerilogToken::EQ;
+  case '@': return VerilogToken::AT;
+  case '#': return VerilogToken::SHARP;
+  case '?': return VerilogToken::QUEST;
+  case '&': return VerilogToken::AND;
+  case '|': return VerilogToken::OR;
+
+  case '<':
+    if ( peek() == '=' ) {
+      accept();
+      return VerilogToken::LE;
+    }
+    return VerilogToken::ERROR;
+
+  case '~':
+    if ( peek() == '^' ) {
+      accept();
+      return VerilogToken::XNOR;
+    }
+    return VerilogToken::NOT;
+
+  case '^':
+    if ( peek() == '~' ) {
+      accept();
+      return VerilogToken::XNOR;
+    }
+    return VerilogToken::XOR;
+
+  case '\\':
+    // エスケープされた識別子
+    for ( ; ; ) {
+      c = peek();
+      if ( c == EOF || is_space(c) ) {
+	break;
+      }
+      accept();
+      mCurString += static_cast<char>(c);
+    }
+    if ( mCurString.empty() ) {
+      return VerilogToken::ERROR;
+    }
+    mEscaped = true;
+    return VerilogToken::NAME;
+
+  case '\'':
+    return scan_number(c);
+
+  default:
+    if ( '0' <= c && c <= '9' ) {
+      return scan_number(c);
+    }
+    if ( ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || c == '_' ) {
+      mCurString += static_cast<char>(c);
+      scan_word();
+      return VerilogToken::NAME;
+    }
+    return VerilogToken::ERROR;
+  }
+
+ ST_LINE_COMMENT:
+  c = get();
+  if ( c == '\n' ) {
+    goto ST_INIT;
+  }
+  if ( c == EOF ) {
+    return VerilogToken::_EOF;
+  }
+  goto ST_LINE_COMMENT;
+
+ ST_BLOCK_COMMENT:
+  c = get();
+  if ( c == '*' ) {
+    goto ST_BLOCK_COMMENT2;
+  }
+  if ( c == EOF ) {
+    // コメントが閉じていない．
+    return VerilogToken::ERROR;
+  }
+  goto ST_BLOCK_COMMENT;
+
+ ST_BLOCK_COMMENT2:
+  c = get();
+  if ( c == '/' ) {
+    goto ST_INIT;
+  }
+  if ( c == '*' ) {
+    goto ST_BLOCK_COMMENT2;
+  }
+  if ( c == EOF ) {
+    return VerilogToken::ERROR;
+  }
+  goto ST_BLOCK_COMMENT;
+}
+
+// @brief 識別子の残りを読み進めて mCurString に追加する．
+void
+VerilogScanner::scan_word()
+{
+  auto start = cur_ptr();
+  auto end = end_ptr();
+  auto p = start;
+  for ( ; p != end && is_word_char(*p); ++ p ) {
+    ;
+  }
+  mCurString.append(start, p);
+  advance(p);
+}
+
+// @brief 数値を読み込む．
+VerilogToken::Type
+VerilogScanner::scan_number(
+  int c
+)
+{
+  // 幅の部分(もしくは符号なし10進数)
+  mCurValue = 0;
+  while ( c != '\'' ) {
+    mCurValue = mCurValue * 10 + (c - '0');
+    c = peek();
+    if ( c == '_' ) {
+      accept();
+      continue;
+    }
+    if ( c == '\'' ) {
+      accept();
+      break;
+    }
+    if ( c < '0' || '9' < c ) {
+      return VerilogToken::NUMBER;
+    }
+    accept();
+  }
+
+  // 基数指定
+  c = get();
+  if ( c == 's' || c == 'S' ) {
+    c = get();
+  }
+  SizeType base = 0;
+  switch ( c ) {
+  case 'b': case 'B': base = 2; break;
+  case 'o': case 'O': base = 8; break;
+  case 'd': case 'D': base = 10; break;
+  case 'h': case 'H': base = 16; break;
+  default: return VerilogToken::ERROR;
+  }
+  while ( peek() == ' ' || peek() == '\t' ) {
+    accept();
+  }
+
+  // 値の部分
+  mCurValue = 0;
+  SizeType ndigits = 0;
+  for ( ; ; ) {
+    c = peek();
+    SizeType d;
+    if ( '0' <= c && c <= '9' ) {
+      d = c - '0';
+    }
+    else if ( 'a' <= c && c <= 'f' ) {
+      d = c - 'a' + 10;
+    }
+    else if ( 'A' <= c && c <= 'F' ) {
+      d = c - 'A' + 10;
+    }
+    else if ( c == '_' ) {
+      accept();
+      continue;
+    }
+    else if ( c == 'x' || c == 'X' || c == 'z' || c == 'Z' || c == '?' ) {
+      // 不定値は扱えない．
+      accept();
+      return VerilogToken::ERROR;
+    }
+    else {
+      break;
+    }
+    if ( d >= base ) {
+      return VerilogToken::ERROR;
+    }
+    accept();
+    mCurValue = mCurValue * base + d;
+    ++ ndigits;
+  }
+  if ( ndigits == 0 ) {
+    return VerilogToken::ERROR;
+  }
+  return VerilogToken::CONST;
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,109 @@
+#ifndef VERILOGSCANNER_H
+#define VERILOGSCANNER_H
+
+/// @file VerilogScanner.h
+/// @brief VerilogScanner のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "BufScanner.h"
+#include "VerilogToken.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class VerilogScanner VerilogScanner.h "VerilogScanner.h"
+/// @brief 構造記述 Verilog 用の字句解析器
+///
+/// 入力はメモリ上に展開された内容([begin, end))を対象とする．
+/// コメント(// と /* */)とコンパイラ指示子(` で始まる行)は読み飛ばす．
+/// エスケープされた識別子(\ で始まり空白で終わる)は
+/// \ と空白を除いた名前の NAME トークンとなる．
+//////////////////////////////////////////////////////////////////////
+class VerilogScanner :
+  public BufScanner
+{
+public:
+
+  /// @brief コンストラクタ
+  VerilogScanner(
+    const char* begin,        ///< [in] 内容の先頭
+    const char* end,          ///< [in] 内容の末尾の次
+    const FileInfo& file_info ///< [in] ファイル情報
+  );
+
+  /// @brief デストラクタ
+  ~VerilogScanner() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief トークンを一つ読み出す．
+  VerilogToken
+  read_token();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief read_token() の下請け関数
+  /// @return トークンを返す．
+  VerilogToken::Type
+  scan();
+
+  /// @brief 識別子の残りを読み進めて mCurString に追加する．
+  void
+  scan_word();
+
+  /// @brief 数値を読み込む．
+  /// @return トークンを返す．
+  VerilogToken::Type
+  scan_number(
+    int c ///< [in] 最初の文字
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ型
+  //////////////////////////////////////////////////////////////////////
+
+  // 予約語の情報
+  struct RsvInfo
+  {
+    VerilogToken::Type type; // トークンの種類
+    PrimType gate_type;      // ゲートの種類
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 文字列バッファ
+  std::string mCurString;
+
+  // 数値
+  SizeType mCurValue;
+
+  // エスケープされた識別子の時 true
+  bool mEscaped;
+
+  // 予約語の辞書
+  std::unordered_map<std::string, RsvInfo> mRsvDict;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // VERILOGSCANNER_H
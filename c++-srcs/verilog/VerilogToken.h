@@ -0,0 +1,147 @@
+#ifndef VERILOGTOKEN_H
+#define VERILOGTOKEN_H
+
+/// @file VerilogToken.h
+/// @brief VerilogToken のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ym/FileRegion.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class VerilogToken VerilogToken.h "VerilogToken.h"
+/// @brief 構造記述 Verilog のトークンを表すクラス
+//////////////////////////////////////////////////////////////////////
+class VerilogToken
+{
+public:
+
+  /// @brief トークンの種類を表す列挙型
+  enum Type {
+    LPAR,      // (
+    RPAR,      // )
+    LBK,       // [
+    RBK,       // ]
+    COMMA,     // ,
+    SEMI,      // ;
+    COLON,     // :
+    EQ,        // =
+    LE,        // <=
+    AT,        // @
+    SHARP,     // #
+    QUEST,     // ?
+    NOT,       // ~
+    AND,       // &
+    OR,        // |
+    XOR,       // ^
+    XNOR,      // ~^, ^~
+    MODULE,
+    ENDMODULE,
+    INPUT,
+    OUTPUT,
+    INOUT,
+    WIRE,
+    REG,
+    ASSIGN,
+    ALWAYS,
+    POSEDGE,
+    NEGEDGE,
+    BEGIN,
+    END,
+    GATE,      // and, nand, or, nor, xor, xnor, buf, not
+    NAME,      // 識別子
+    NUMBER,    // 符号なし10進数
+    CONST,     // 1'b0 などの定数
+    _EOF,
+    ERROR
+  };
+
+
+public:
+
+  /// @brief 空のコンストラクタ
+  VerilogToken() = default;
+
+  /// @brief 内容を指定したコンストラクタ
+  VerilogToken(
+    Type type,                           ///< [in] 種類
+    const FileRegion& loc,               ///< [in] ファイル上の位置
+    PrimType gate_type = PrimType::None, ///< [in] ゲートの種類
+    const std::string& name = {},        ///< [in] 識別子
+    SizeType value = 0                   ///< [in] 数値
+  ) : mType{type},
+      mLoc{loc},
+      mGateType{gate_type},
+      mName{name},
+      mValue{value}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~VerilogToken() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 種類を返す．
+  Type
+  type() const { return mType; }
+
+  /// @brief ファイル上の位置を返す．
+  const FileRegion&
+  loc() const { return mLoc; }
+
+  /// @brief ゲート型を返す．
+  ///
+  /// type() == GATE の時のみ意味を持つ．
+  PrimType
+  gate_type() const { return mGateType; }
+
+  /// @brief 識別子を返す．
+  ///
+  /// type() == NAME の時のみ意味を持つ．
+  const std::string&
+  name() const { return mName; }
+
+  /// @brief 数値を返す．
+  ///
+  /// type() == NUMBER, CONST の時のみ意味を持つ．
+  SizeType
+  value() const { return mValue; }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 種類
+  Type mType{ERROR};
+
+  // ファイル上の位置
+  FileRegion mLoc;
+
+  // GATE 型の場合のゲートタイプ
+  PrimType mGateType{PrimType::None};
+
+  // NAME 型の場合の識別子
+  std::string mName;
+
+  // NUMBER, CONST 型の場合の値
+  SizeType mValue{0};
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // VERILOGTOKEN_H
@@ -0,0 +1,568 @@
+
+/// @file VerilogWriter.cc
+/// @brief VerilogWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "VerilogWriter.h"
+#include "BufWriter.h"
+#include "FuncImpl.h"
+#include "Isop.h"
+#include "ym/BnModel.h"
+#include "ym/SopCover.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/Bdd.h"
+#include "ym/BddVar.h"
+#include <unordered_set>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 1行の長さの目安
+const SizeType LINE_LIMIT = 72;
+
+// エスケープが必要な予約語
+const std::unordered_set<std::string> RESERVED_WORDS{
+  "always", "and", "assign", "begin", "buf", "bufif0", "bufif1",
+  "case", "casex", "casez", "cmos", "deassign", "default", "defparam",
+  "disable", "edge", "else", "end", "endcase", "endfunction",
+  "endmodule", "endprimitive", "endspecify", "endtable", "endtask",
+  "event", "for", "force", "forever", "fork", "function", "highz0",
+  "highz1", "if", "initial", "inout", "input", "integer", "join",
+  "large", "macromodule", "medium", "module", "nand", "negedge",
+  "nmos", "nor", "not", "notif0", "notif1", "or", "output",
+  "parameter", "pmos", "posedge", "primitive", "pull0", "pull1",
+  "pulldown", "pullup", "rcmos", "real", "realtime", "reg", "release",
+  "repeat", "rnmos", "rpmos", "rtran", "rtranif0", "rtranif1", "scalared",
+  "small", "specify", "specparam", "strong0", "strong1", "supply0",
+  "supply1", "table", "task", "time", "tran", "tranif0", "tranif1",
+  "tri", "tri0", "tri1", "triand", "trior", "trireg", "vectored",
+  "wait", "wand", "weak0", "weak1", "while", "wire", "wor", "xnor", "xor"
+};
+
+// 単純な識別子として出力できる時 true を返す．
+bool
+is_simple_name(
+  const std::string& name
+)
+{
+  if ( name.empty() ) {
+    return false;
+  }
+  auto c0 = name[0];
+  if ( !(('a' <= c0 && c0 <= 'z') || ('A' <= c0 && c0 <= 'Z') || c0 == '_') ) {
+    return false;
+  }
+  for ( auto c: name ) {
+    if ( !(('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+	   ('0' <= c && c <= '9') || c == '_' || c == '$') ) {
+      return false;
+    }
+  }
+  return RESERVED_WORDS.count(name) == 0;
+}
+
+// プリミティブ型に対応するゲート名を返す．
+const char*
+gate_name(
+  PrimType primitive_type
+)
+{
+  switch ( primitive_type ) {
+  case PrimType::Buff: return "buf";
+  case PrimType::Not:  return "not";
+  case PrimType::And:  return "and";
+  case PrimType::Nand: return "nand";
+  case PrimType::Or:   return "or";
+  case PrimType::Nor:  return "nor";
+  case PrimType::Xor:  return "xor";
+  case PrimType::Xnor: return "xnor";
+  default: break;
+  }
+  return nullptr;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnModel
+//////////////////////////////////////////////////////////////////////
+
+// @brief Verilog 形式で出力する．
+void
+BnModel::write_verilog(
+  std::ostream& s
+) const
+{
+  VerilogWriter writer{_model_impl()};
+  writer.write(s);
+}
+
+// @brief Verilog 形式でファイルに出力する．
+void
+BnModel::write_verilog(
+  const std::string& filename
+) const
+{
+  write_file(filename, "write_verilog",
+	     [&](std::ostream& s){ write_verilog(s); });
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス VerilogWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+VerilogWriter::VerilogWriter(
+  const ModelImpl& model
+) : mModel{model},
+    mNameMgr{model},
+    mSopArray(model.func_num()),
+    mSopDone(model.func_num(), false)
+{
+}
+
+// @brief Verilog 形式で出力する．
+void
+VerilogWriter::write(
+  std::ostream& s
+)
+{
+  BufWriter w{s};
+
+  for ( auto& comment: mModel.comment_list() ) {
+    w.put("// ");
+    w.put(comment);
+    w.put('\n');
+  }
+
+  // 入力ポート
+  std::vector<std::string> input_names;
+  input_names.reserve(mModel.input_num() + 1);
+  std::unordered_set<SizeType> input_set;
+  for ( auto id: mModel.input_id_list() ) {
+    input_names.push_back(mNameMgr.node_name(id));
+    input_set.emplace(id);
+  }
+
+  // クロック入力
+  std::string clock_name;
+  if ( mModel.dff_num() > 0 ) {
+    std::unordered_set<std::string> name_set;
+    for ( auto& name: input_names ) {
+      name_set.emplace(name);
+    }
+    for ( SizeType i = 0; i < mModel.dff_num(); ++ i ) {
+      name_set.emplace(mNameMgr.node_name(mModel.dff_impl(i).id));
+    }
+    for ( auto id: mModel.logic_id_list() ) {
+      name_set.emplace(mNameMgr.node_name(id));
+    }
+    for ( auto& name: mNameMgr.output_name_list() ) {
+      name_set.emplace(name);
+    }
+    clock_name = "clk";
+    for ( SizeType i = 1; name_set.count(clock_name) > 0; ++ i ) {
+      clock_name = "clk_" + std::to_string(i);
+    }
+    input_names.push_back(clock_name);
+  }
+
+  // 出力ポート
+  // ノード名と等しい出力名はそのノード自体を出力ポートとする．
+  // ただし，入力ノードの場合と同じノードが複数回出力される場合は
+  // 新たな名前のポートを作って assign 文でつなぐ．
+  auto no = mModel.output_num();
+  std::vector<std::string> output_names;
+  output_names.reserve(no);
+  std::unordered_set<SizeType> port_set;
+  std::vector<SizeType> assign_list;
+  for ( SizeType i = 0; i < no; ++ i ) {
+    auto id = mModel.output_id(i);
+    auto& src_name = mNameMgr.node_name(id);
+    auto& oname = mNameMgr.output_name(i);
+    if ( oname != src_name ) {
+      output_names.push_back(oname);
+      assign_list.push_back(i);
+    }
+    else if ( input_set.count(id) == 0 && port_set.count(id) == 0 ) {
+      output_names.push_back(oname);
+      port_set.emplace(id);
+    }
+    else {
+      output_names.push_back(mNameMgr.new_name(mModel.node_num() + i));
+      assign_list.push_back(i);
+    }
+  }
+
+  w.put("module ");
+  if ( mModel.name() == std::string{} ) {
+    w.put("top");
+  }
+  else {
+    put_name(w, mModel.name());
+  }
+  w.put('(');
+  SizeType len = 0;
+  const char* comma = "";
+  for ( auto names_p: {&input_names, &output_names} ) {
+    for ( auto& name: *names_p ) {
+      w.put(comma);
+      auto l = name_len(name);
+      if ( len + l + 2 > LINE_LIMIT ) {
+	w.put("\n  ");
+	len = 2;
+      }
+      else if ( comma[0] != '\0' ) {
+	w.put(' ');
+      }
+      put_name(w, name);
+      len += l + 2;
+      comma = ",";
+    }
+  }
+  w.put(");\n");
+
+  write_name_list(w, "input", input_names);
+  write_name_list(w, "output", output_names);
+
+  std::vector<std::string> wire_names;
+  wire_names.reserve(mModel.logic_num());
+  for ( auto id: mModel.logic_id_list() ) {
+    if ( port_set.count(id) == 0 ) {
+      wire_names.push_back(mNameMgr.node_name(id));
+    }
+  }
+  write_name_list(w, "wire", wire_names);
+
+  std::vector<std::string> reg_names;
+  reg_names.reserve(mModel.dff_num());
+  for ( SizeType i = 0; i < mModel.dff_num(); ++ i ) {
+    reg_names.push_back(mNameMgr.node_name(mModel.dff_impl(i).id));
+  }
+  write_name_list(w, "reg", reg_names);
+
+  for ( auto id: mModel.logic_id_list() ) {
+    write_logic(w, id);
+  }
+
+  for ( auto i: assign_list ) {
+    w.put("  assign ");
+    put_name(w, output_names[i]);
+    w.put(" = ");
+    put_name(w, mNameMgr.node_name(mModel.output_id(i)));
+    w.put(";\n");
+  }
+
+  for ( SizeType i = 0; i < mModel.dff_num(); ++ i ) {
+    auto& dff = mModel.dff_impl(i);
+    w.put("  always @(posedge ");
+    put_name(w, clock_name);
+    w.put(") ");
+    put_name(w, mNameMgr.node_name(dff.id));
+    w.put(" <= ");
+    put_name(w, mNameMgr.node_name(dff.src_id));
+    w.put(";\n");
+  }
+
+  w.put("endmodule\n");
+}
+
+// @brief 論理ノードの定義を出力する．
+void
+VerilogWriter::write_logic(
+  BufWriter& w,
+  SizeType id
+)
+{
+  auto& node = mModel.node_impl(id);
+  auto& oname = mNameMgr.node_name(id);
+  std::vector<std::string> name_list;
+  name_list.reserve(node.fanin_num());
+  for ( auto iid: node.fanin_id_list() ) {
+    name_list.push_back(mNameMgr.node_name(iid));
+  }
+
+  auto& func = mModel.func_impl(node.func_id());
+  if ( func.is_primitive() ) {
+    auto gname = gate_name(func.primitive_type());
+    if ( gname != nullptr ) {
+      w.put("  ");
+      w.put(gname);
+      w.put(" (");
+      put_name(w, oname);
+      for ( auto& name: name_list ) {
+	w.put(", ");
+	put_name(w, name);
+      }
+      w.put(");\n");
+      return;
+    }
+  }
+
+  w.put("  assign ");
+  put_name(w, oname);
+  w.put(" = ");
+  if ( func.is_expr() ) {
+    write_expr(w, func.expr(), name_list);
+  }
+  else {
+    write_sop(w, sop_info(node.func_id()), name_list);
+  }
+  w.put(";\n");
+}
+
+// @brief 関数に対応する積和形を返す．
+const VerilogWriter::SopInfo&
+VerilogWriter::sop_info(
+  SizeType func_id
+)
+{
+  if ( !mSopDone[func_id] ) {
+    mSopArray[func_id] = make_sop_info(mModel.func_impl(func_id));
+    mSopDone[func_id] = true;
+  }
+  return mSopArray[func_id];
+}
+
+// @brief 関数を積和形に変換する．
+VerilogWriter::SopInfo
+VerilogWriter::make_sop_info(
+  const FuncImpl& func
+)
+{
+  SopInfo info;
+  if ( func.is_primitive() ) {
+    // ゲートにできないのは定数のみ
+    switch ( func.primitive_type() ) {
+    case PrimType::C1:
+      info.output_inv = true;
+      break;
+    default:
+      break;
+    }
+    return info;
+  }
+  if ( func.is_cover() ) {
+    auto& cover = func.input_cover();
+    auto nc = cover.cube_num();
+    auto ni = cover.variable_num();
+    info.cube_list.reserve(nc);
+    for ( SizeType c = 0; c < nc; ++ c ) {
+      std::string pat(ni, '-');
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	switch ( cover.get_pat(c, i) ) {
+	case SopPat::_X: break;
+	case SopPat::_0: pat[i] = '0'; break;
+	case SopPat::_1: pat[i] = '1'; break;
+	}
+      }
+      info.cube_list.push_back(pat);
+    }
+    info.output_inv = func.output_inv();
+    return info;
+  }
+
+  TvFunc tvfunc;
+  if ( func.is_tvfunc() ) {
+    tvfunc = func.tvfunc();
+  }
+  else if ( func.is_bdd() ) {
+    // サポート変数の順番がファンインの順番に対応している．
+    auto bdd = func.bdd();
+    tvfunc = bdd.to_truth(bdd.get_support_list());
+  }
+  else {
+    throw std::logic_error{"VerilogWriter: unknown function type"};
+  }
+  // オンセットとオフセットのうちキューブ数の少ない方を用いる．
+  auto on_cubes = isop(tvfunc);
+  auto off_cubes = isop(~tvfunc);
+  if ( off_cubes.empty() || on_cubes.size() <= off_cubes.size() ) {
+    info.cube_list = std::move(on_cubes);
+  }
+  else {
+    info.cube_list = std::move(off_cubes);
+    info.output_inv = true;
+  }
+  return info;
+}
+
+// @brief 積和形の式を出力する．
+void
+VerilogWriter::write_sop(
+  BufWriter& w,
+  const SopInfo& info,
+  const std::vector<std::string>& name_list
+)
+{
+  auto nc = info.cube_list.size();
+  if ( nc == 0 ) {
+    w.put(info.output_inv ? "1'b1" : "1'b0");
+    return;
+  }
+  if ( info.output_inv ) {
+    w.put("~(");
+  }
+  const char* or_op = "";
+  for ( auto& pat: info.cube_list ) {
+    w.put(or_op);
+    or_op = " | ";
+    SizeType nl = 0;
+    for ( auto c: pat ) {
+      if ( c != '-' ) {
+	++ nl;
+      }
+    }
+    if ( nl == 0 ) {
+      w.put("1'b1");
+      continue;
+    }
+    bool paren = nc > 1 && nl > 1;
+    if ( paren ) {
+      w.put('(');
+    }
+    const char* and_op = "";
+    for ( SizeType i = 0; i < pat.size(); ++ i ) {
+      if ( pat[i] == '-' ) {
+	continue;
+      }
+      w.put(and_op);
+      and_op = " & ";
+      if ( pat[i] == '0' ) {
+	w.put('~');
+      }
+      put_name(w, name_list[i]);
+    }
+    if ( paren ) {
+      w.put(')');
+    }
+  }
+  if ( info.output_inv ) {
+    w.put(')');
+  }
+}
+
+// @brief 論理式を出力する．
+void
+VerilogWriter::write_expr(
+  BufWriter& w,
+  const Expr& expr,
+  const std::vector<std::string>& name_list
+)
+{
+  if ( expr.is_zero() ) {
+    w.put("1'b0");
+    return;
+  }
+  if ( expr.is_one() ) {
+    w.put("1'b1");
+    return;
+  }
+  if ( expr.is_posi_literal() || expr.is_nega_literal() ) {
+    if ( expr.is_nega_literal() ) {
+      w.put('~');
+    }
+    put_name(w, name_list[expr.varid()]);
+    return;
+  }
+
+  const char* op = nullptr;
+  if ( expr.is_and() ) {
+    op = " & ";
+  }
+  else if ( expr.is_or() ) {
+    op = " | ";
+  }
+  else if ( expr.is_xor() ) {
+    op = " ^ ";
+  }
+  else {
+    throw std::logic_error{"VerilogWriter: unexpected expression"};
+  }
+  const char* sep = "";
+  for ( auto& opr: expr.operand_list() ) {
+    w.put(sep);
+    sep = op;
+    bool paren = !opr.is_literal() && !opr.is_constant();
+    if ( paren ) {
+      w.put('(');
+    }
+    write_expr(w, opr, name_list);
+    if ( paren ) {
+      w.put(')');
+    }
+  }
+}
+
+// @brief 名前のリストを出力する．
+void
+VerilogWriter::write_name_list(
+  BufWriter& w,
+  const char* keyword,
+  const std::vector<std::string>& names
+)
+{
+  if ( names.empty() ) {
+    return;
+  }
+  std::string_view kwd{keyword};
+  w.put("  ");
+  w.put(kwd);
+  SizeType len = kwd.size() + 2;
+  const char* comma = "";
+  for ( auto& name: names ) {
+    w.put(comma);
+    comma = ",";
+    auto l = name_len(name);
+    if ( len + l + 2 > LINE_LIMIT && len > kwd.size() + 2 ) {
+      w.put("\n    ");
+      len = 4;
+    }
+    else {
+      w.put(' ');
+    }
+    put_name(w, name);
+    len += l + 2;
+  }
+  w.put(";\n");
+}
+
+// @brief 識別子を出力する．
+void
+VerilogWriter::put_name(
+  BufWriter& w,
+  const std::string& name
+)
+{
+  if ( is_simple_name(name) ) {
+    w.put(name);
+  }
+  else {
+    // エスケープ識別子は空白で終わる．
+    w.put('\\');
+    w.put(name);
+    w.put(' ');
+  }
+}
+
+// @brief 名前の出力時の長さを返す．
+SizeType
+VerilogWriter::name_len(
+  const std::string& name
+)
+{
+  if ( is_simple_name(name) ) {
+    return name.size();
+  }
+  return name.size() + 2;
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,169 @@
+#ifndef VERILOGWRITER_H
+#define VERILOGWRITER_H
+
+/// @file VerilogWriter.h
+/// @brief VerilogWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ModelImpl.h"
+#include "NameMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class BufWriter;
+
+//////////////////////////////////////////////////////////////////////
+/// @class VerilogWriter VerilogWriter.h "VerilogWriter.h"
+/// @brief BnModel を構造記述 Verilog 形式で出力するクラス
+///
+/// 出力は VerilogParser で読み込めるサブセットに限る．
+/// - プリミティブ型のノードはゲートのインスタンスにする．
+///   ただし定数は assign 文にする．
+/// - カバー型/真理値表型/BDD型のノードは積和形の式の assign 文にする．
+///   積和形への変換結果は関数番号ごとにキャッシュする．
+/// - 論理式型のノードは論理式をそのまま assign 文にする．
+/// - DFF は always @(posedge clk) 文にする．
+///   クロックは入力ポートとして追加する．リセット値は出力しない．
+///
+/// 識別子として使えない名前はエスケープ識別子(\name )で出力する．
+//////////////////////////////////////////////////////////////////////
+class VerilogWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  VerilogWriter(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief デストラクタ
+  ~VerilogWriter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief Verilog 形式で出力する．
+  void
+  write(
+    std::ostream& s ///< [in] 出力先のストリーム
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  // 積和形の表現
+  struct SopInfo
+  {
+    // キューブのパタンのリスト('0', '1', '-' の文字列)
+    std::vector<std::string> cube_list;
+
+    // 出力を反転する時 true
+    bool output_inv{false};
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 論理ノードの定義を出力する．
+  void
+  write_logic(
+    BufWriter& w, ///< [in] 出力先
+    SizeType id   ///< [in] ノード番号
+  );
+
+  /// @brief 関数に対応する積和形を返す．
+  ///
+  /// 結果はキャッシュされる．
+  const SopInfo&
+  sop_info(
+    SizeType func_id ///< [in] 関数番号
+  );
+
+  /// @brief 関数を積和形に変換する．
+  static
+  SopInfo
+  make_sop_info(
+    const FuncImpl& func ///< [in] 関数
+  );
+
+  /// @brief 積和形の式を出力する．
+  void
+  write_sop(
+    BufWriter& w,                             ///< [in] 出力先
+    const SopInfo& info,                      ///< [in] 積和形
+    const std::vector<std::string>& name_list ///< [in] ファンインの名前のリスト
+  );
+
+  /// @brief 論理式を出力する．
+  void
+  write_expr(
+    BufWriter& w,                             ///< [in] 出力先
+    const Expr& expr,                         ///< [in] 論理式
+    const std::vector<std::string>& name_list ///< [in] ファンインの名前のリスト
+  );
+
+  /// @brief 名前のリストを出力する．
+  ///
+  /// 長くなる場合には改行する．
+  void
+  write_name_list(
+    BufWriter& w,                         ///< [in] 出力先
+    const char* keyword,                  ///< [in] キーワード
+    const std::vector<std::string>& names ///< [in] 名前のリスト
+  );
+
+  /// @brief 識別子を出力する．
+  ///
+  /// 必要ならエスケープする．
+  static
+  void
+  put_name(
+    BufWriter& w,           ///< [in] 出力先
+    const std::string& name ///< [in] 名前
+  );
+
+  /// @brief 名前の出力時の長さを返す．
+  static
+  SizeType
+  name_len(
+    const std::string& name ///< [in] 名前
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のモデル
+  const ModelImpl& mModel;
+
+  // ノード名の管理
+  NameMgr mNameMgr;
+
+  // 関数番号をキーにして積和形を格納する配列
+  std::vector<SopInfo> mSopArray;
+
+  // mSopArray の内容が設定済みの時 true となる配列
+  std::vector<bool> mSopDone;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // VERILOGWRITER_H
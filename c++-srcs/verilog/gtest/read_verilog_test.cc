@@ -0,0 +1,195 @@
+
+/// @file read_verilog_test.cc
+/// @brief read_verilog_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/JsonValue.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+TEST( BnModelTest, read_verilog1 )
+{
+  auto path = make_file("test1.v",
+			"// comment\n"
+			"module test1(a, b, c, o, p);\n"
+			"  input a, b;\n"
+			"  input [1:0] c;\n"
+			"  output o;\n"
+			"  output [1:0] p;\n"
+			"  wire w1, w2;\n"
+			"  /* block\n"
+			"     comment */\n"
+			"  and g1 (w1, a, b), g2 (w2, c[0], c[1]);\n"
+			"  assign o = ~(w1 | w2) ^ a;\n"
+			"  assign p[1] = a ? c[1] : 1'b0, p[0] = b ~^ c[0];\n"
+			"endmodule\n");
+  auto model = BnModel::read_verilog(path);
+  EXPECT_EQ( "test1", model.name() );
+  ASSERT_EQ( 4, model.input_num() );
+  ASSERT_EQ( 3, model.output_num() );
+  EXPECT_EQ( 0, model.dff_num() );
+  EXPECT_EQ( "a", model.input_name(0) );
+  EXPECT_EQ( "b", model.input_name(1) );
+  EXPECT_EQ( "c[1]", model.input_name(2) );
+  EXPECT_EQ( "c[0]", model.input_name(3) );
+  EXPECT_EQ( "o", model.output_name(0) );
+  EXPECT_EQ( "p[1]", model.output_name(1) );
+  EXPECT_EQ( "p[0]", model.output_name(2) );
+
+  std::vector<bool> ivals(4);
+  for ( SizeType p = 0; p < 16; ++ p ) {
+    for ( SizeType i = 0; i < 4; ++ i ) {
+      ivals[i] = (p >> i) & 1;
+    }
+    bool a = ivals[0];
+    bool b = ivals[1];
+    bool c1 = ivals[2];
+    bool c0 = ivals[3];
+    bool o = !((a && b) || (c0 && c1)) != a;
+    bool p1 = a ? c1 : false;
+    bool p0 = b == c0;
+    EXPECT_EQ( (std::vector<bool>{o, p1, p0}), simulate(model, ivals) )
+      << "p = " << p;
+  }
+}
+
+TEST( BnModelTest, read_verilog_ansi )
+{
+  auto path = make_file("ansi.v",
+			"module ansi(input clk, input d, en, output q);\n"
+			"  reg r;\n"
+			"  wire n = en ? d : r;\n"
+			"  always @(posedge clk)\n"
+			"    begin\n"
+			"      r <= n;\n"
+			"    end\n"
+			"  assign q = r;\n"
+			"endmodule\n");
+  auto model = BnModel::read_verilog(path);
+  ASSERT_EQ( 3, model.input_num() );
+  ASSERT_EQ( 1, model.output_num() );
+  ASSERT_EQ( 1, model.dff_num() );
+  EXPECT_EQ( "clk", model.input_name(0) );
+  EXPECT_EQ( "r", model.dff_name(0) );
+
+  std::vector<bool> ivals(4);
+  for ( SizeType p = 0; p < 16; ++ p ) {
+    for ( SizeType i = 0; i < 4; ++ i ) {
+      ivals[i] = (p >> i) & 1;
+    }
+    bool d = ivals[1];
+    bool en = ivals[2];
+    bool r = ivals[3];
+    EXPECT_EQ( (std::vector<bool>{r, en ? d : r}), simulate(model, ivals) );
+  }
+}
+
+TEST( BnModelTest, read_verilog_escaped )
+{
+  auto path = make_file("escaped.v",
+			"module \\top (\\a[0] , \\and , o);\n"
+			"  input \\a[0] , \\and ;\n"
+			"  output o;\n"
+			"  nand #1 (o, \\a[0] , \\and );\n"
+			"endmodule\n");
+  auto model = BnModel::read_verilog(path);
+  ASSERT_EQ( 2, model.input_num() );
+  EXPECT_EQ( "a[0]", model.input_name(0) );
+  EXPECT_EQ( "and", model.input_name(1) );
+  ASSERT_EQ( 1, model.logic_num() );
+}
+
+TEST( BnModelTest, read_verilog_undefined )
+{
+  auto path = make_file("undef.v",
+			"module undef(a, o);\n"
+			"  input a;\n"
+			"  output o;\n"
+			"  and (o, a, b);\n"
+			"endmodule\n");
+  EXPECT_THROW( BnModel::read_verilog(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_verilog_multidef )
+{
+  auto path = make_file("multidef.v",
+			"module multidef(a, b, o);\n"
+			"  input a, b;\n"
+			"  output o;\n"
+			"  and (o, a, b);\n"
+			"  assign o = a;\n"
+			"endmodule\n");
+  EXPECT_THROW( BnModel::read_verilog(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_verilog_notrack )
+{
+  // 位置情報を記録しない場合も結果とエラーメッセージが同一になるかのテスト
+  std::vector<std::pair<std::string, bool>> body_list{
+    {"  wire w;\n"
+     "  and (w, a, b);\n"
+     "  assign o = ~w;\n", true},
+    {"  and (o, a, c);\n", false},
+    {"  and (o, a, b);\n"
+     "  assign o = a;\n", false}
+  };
+  for ( auto& p: body_list ) {
+    auto path = make_file("notrack.v",
+			  "module notrack(a, b, o);\n"
+			  "  input a, b;\n"
+			  "  output o;\n" +
+			  p.first +
+			  "endmodule\n");
+    std::string result[2];
+    std::string msg[2];
+    for ( int i = 0; i < 2; ++ i ) {
+      auto option = JsonValue{std::unordered_map<std::string, JsonValue>{
+	  {"track_location", JsonValue{i == 0}}}};
+      std::ostringstream msg_buf;
+      StreamMsgHandler msg_handler(msg_buf);
+      MsgMgr::attach_handler(&msg_handler);
+      try {
+	auto model = BnModel::read_verilog(path, option);
+	std::ostringstream buf;
+	model.print(buf);
+	result[i] = buf.str();
+	EXPECT_TRUE( p.second );
+      }
+      catch ( const std::invalid_argument& ) {
+	EXPECT_FALSE( p.second );
+      }
+      MsgMgr::detach_handler(&msg_handler);
+      msg[i] = msg_buf.str();
+    }
+    EXPECT_EQ( result[0], result[1] );
+    EXPECT_EQ( msg[0], msg[1] );
+  }
+}
+
+TEST( BnModelTest, read_verilog_instance )
+{
+  // モジュールのインスタンスは扱えない．
+  auto path = make_file("inst.v",
+			"module inst(a, o);\n"
+			"  input a;\n"
+			"  output o;\n"
+			"  sub u1 (.i(a), .o(o));\n"
+			"endmodule\n");
+  EXPECT_THROW( BnModel::read_verilog(path), std::invalid_argument );
+}
+
+TEST( BnModelTest, read_verilog_bad_file )
+{
+  EXPECT_THROW( BnModel::read_verilog("/nonexistent/foo.v"),
+		std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
@@ -0,0 +1,140 @@
+
+/// @file write_verilog_test.cc
+/// @brief write_verilog_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "BnTestUtil.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+BEGIN_NONAMESPACE
+
+// 2つのモデルが等価か調べる．
+//
+// model2 は model1 を Verilog 形式で書き出して読み戻したもので，
+// DFF がある場合は最後の入力としてクロックが追加されている．
+void
+check_verilog_equiv(
+  const BnModel& model1,
+  const BnModel& model2
+)
+{
+  auto ni = model1.input_num();
+  auto nc = model1.dff_num() > 0 ? 1 : 0;
+  ASSERT_EQ( ni + nc, model2.input_num() );
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    EXPECT_EQ( model1.input_name(i), model2.input_name(i) );
+  }
+  // クロックの値は結果に影響しない．
+  check_sim_equiv(model1, model2, nc);
+}
+
+END_NONAMESPACE
+
+TEST( BnModelTest, write_verilog_s5378 )
+{
+  auto path = std::string{DATAPATH} + "s5378.blif";
+  auto model = BnModel::read_blif(path);
+  std::string contents;
+  auto model2 = round_trip(model, "verilog", "s5378.v", contents);
+  check_verilog_equiv(model, model2);
+  for ( SizeType i = 0; i < model.output_num(); ++ i ) {
+    EXPECT_EQ( model.output_name(i), model2.output_name(i) );
+  }
+}
+
+TEST( BnModelTest, write_verilog_b10 )
+{
+  auto path = std::string{DATAPATH} + "b10.bench";
+  auto model = BnModel::read_iscas89(path);
+  std::string contents;
+  auto model2 = round_trip(model, "verilog", "b10.v", contents);
+
+  // プリミティブゲートはゲートのインスタンスとして出力される．
+  EXPECT_EQ( model.logic_num(), model2.logic_num() );
+  check_verilog_equiv(model, model2);
+}
+
+TEST( BnModelTest, write_verilog_funcs )
+{
+  // 色々な種類の関数を含むモデル
+  BnModel model;
+  auto a = model.new_input("a");
+  auto b = model.new_input("b");
+  auto c = model.new_input("c");
+  auto dff0 = model.new_dff("q0");
+  auto q0 = dff0.output();
+
+  auto n1 = model.new_primitive(PrimType::Xnor, {a, b, c});
+  // a b' + c q0'
+  SopCover cover{4, {{Literal{0, false}, Literal{1, true}},
+		     {Literal{2, false}, Literal{3, true}}}};
+  auto n2 = model.new_cover(cover, true, {a, b, c, q0});
+  auto expr = (Expr::literal(0) & ~Expr::literal(1)) | (Expr::literal(2) ^ Expr::literal(0));
+  auto n3 = model.new_expr(expr, {n1, n2, a});
+  // 多数決関数
+  TvFunc maj{"11101000"};
+  auto n4 = model.new_tvfunc(maj, {n3, q0, b});
+  // オンセットの方が大きい真理値表
+  TvFunc f5{"11111110"};
+  auto n5 = model.new_tvfunc(f5, {n3, n4, a});
+  auto n6 = model.new_primitive(PrimType::C0, {});
+  auto n7 = model.new_primitive(PrimType::C1, {});
+
+  model.set_dff_src(dff0, n4);
+  model.new_output(n3, "o1");
+  model.new_output(n5, "o2");
+  model.new_output(a, "o3");
+  model.new_output(n6, "o4");
+  model.new_output(n7, "o5");
+  model.wrap_up();
+
+  std::string contents;
+  auto model2 = round_trip(model, "verilog", "funcs.v", contents);
+  check_verilog_equiv(model, model2);
+  EXPECT_NE( std::string::npos, contents.find("1'b0") );
+  EXPECT_NE( std::string::npos, contents.find("1'b1") );
+  EXPECT_NE( std::string::npos, contents.find("  xnor (") );
+  EXPECT_NE( std::string::npos, contents.find("always @(posedge clk)") );
+}
+
+TEST( BnModelTest, write_verilog_names )
+{
+  // 識別子として使えない名前や入力と同名の出力
+  BnModel model;
+  auto a = model.new_input("a[0]");
+  auto b = model.new_input("and");
+  auto c = model.new_input("clk");
+  auto dff0 = model.new_dff("q");
+  auto n1 = model.new_primitive(PrimType::And, {a, b});
+  model.set_dff_src(dff0, n1);
+  model.new_output(n1, "1x");
+  model.new_output(n1, "1x");
+  model.new_output(c, "clk");
+  model.new_output(dff0.output(), "q");
+  model.wrap_up();
+
+  std::string contents;
+  auto model2 = round_trip(model, "verilog", "names.v", contents);
+  check_verilog_equiv(model, model2);
+  EXPECT_NE( std::string::npos, contents.find("\\and ") );
+  EXPECT_NE( std::string::npos, contents.find("\\1x ") );
+  EXPECT_NE( std::string::npos, contents.find("always @(posedge clk_1)") );
+  EXPECT_EQ( "1x", model2.output_name(0) );
+}
+
+TEST( BnModelTest, write_verilog_bad_file )
+{
+  BnModel model;
+  model.new_output(model.new_input("a"), "b");
+  model.wrap_up();
+  EXPECT_THROW( model.write_verilog("/nonexistent/dir/foo.v"),
+		std::invalid_argument );
+}
+
+END_NAMESPACE_YM_BN
@@ -9,6 +9,7 @@
 /// All rights reserved.
 
 #include "ym/bn.h"
+#include "ym/BnIdSpan.h"
 
 
 BEGIN_NAMESPACE_YM_BN
@@ -116,7 +117,19 @@ protected:
   /// @brief ノード番号のリストを BnNode のリストに変換する．
   std::vector<BnNode>
   _id2node_list(
-    const std::vector<SizeType>& id_list ///< [in] ノード番号のりスト
+    BnIdSpan id_list ///< [in] ノード番号のりスト
+  ) const;
+
+  /// @brief ノード番号を BnNodeRef に変換する．
+  BnNodeRef
+  _id2ref(
+    SizeType id ///< [in] ノード番号
+  ) const;
+
+  /// @brief ノード番号のリストを BnNodeRefList に変換する．
+  BnNodeRefList
+  _id2ref_list(
+    BnIdSpan id_list ///< [in] ノード番号のりスト
   ) const;
 
   /// @brief BnNode をノード番号に変換する．
@@ -0,0 +1,311 @@
+#ifndef BNCELLLIBRARY_H
+#define BNCELLLIBRARY_H
+
+/// @file BnCellLibrary.h
+/// @brief BnCellLibrary のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class CellLibImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnCellLut BnCellLibrary.h "BnCellLibrary.h"
+/// @brief 遅延テーブル(table_lookup モデル)を表す構造体
+///
+/// values は index_1 を行，index_2 を列とした行優先の配列となる．
+/// 1次元のテーブルの場合は index_2 は空となる．
+//////////////////////////////////////////////////////////////////////
+struct BnCellLut
+{
+  /// @brief テンプレート名
+  std::string template_name;
+
+  /// @brief 1番目の変数のインデックス
+  std::vector<double> index_1;
+
+  /// @brief 2番目の変数のインデックス
+  std::vector<double> index_2;
+
+  /// @brief 値のリスト
+  std::vector<double> values;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnCellTiming BnCellLibrary.h "BnCellLibrary.h"
+/// @brief 出力ピンのタイミング情報を表す構造体
+///
+/// Liberty 形式では遅延テーブルが，genlib 形式では
+/// 負荷に比例する線形の遅延モデルの係数が設定される．
+//////////////////////////////////////////////////////////////////////
+struct BnCellTiming
+{
+  /// @brief 関係する入力ピン名
+  std::string related_pin;
+
+  /// @brief timing_sense 属性("positive_unate" など)
+  std::string timing_sense;
+
+  /// @brief timing_type 属性("combinational" など)
+  std::string timing_type;
+
+  /// @brief 立ち上がり遅延
+  BnCellLut cell_rise;
+
+  /// @brief 立ち下がり遅延
+  BnCellLut cell_fall;
+
+  /// @brief 立ち上がり遷移時間
+  BnCellLut rise_transition;
+
+  /// @brief 立ち下がり遷移時間
+  BnCellLut fall_transition;
+
+  /// @brief 立ち上がりの固有遅延(genlib の rise-block-delay)
+  double rise_block_delay{0.0};
+
+  /// @brief 立ち上がりの負荷あたりの遅延(genlib の rise-fanout-delay)
+  double rise_fanout_delay{0.0};
+
+  /// @brief 立ち下がりの固有遅延(genlib の fall-block-delay)
+  double fall_block_delay{0.0};
+
+  /// @brief 立ち下がりの負荷あたりの遅延(genlib の fall-fanout-delay)
+  double fall_fanout_delay{0.0};
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnCellPin BnCellLibrary.h "BnCellLibrary.h"
+/// @brief セルのピンを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct BnCellPin
+{
+  /// @brief 方向を表す列挙型
+  enum Direction {
+    Input,
+    Output,
+    Inout,
+    Internal
+  };
+
+  /// @brief ピン名
+  std::string name;
+
+  /// @brief 方向
+  Direction direction{Input};
+
+  /// @brief 入力容量
+  double capacitance{0.0};
+
+  /// @brief 論理関数を持つ時 true
+  bool has_function{false};
+
+  /// @brief 論理関数
+  ///
+  /// 変数番号は BnCell::input_list 中の位置を表す．
+  Expr function;
+
+  /// @brief トライステート条件を持つ時 true
+  bool has_tristate{false};
+
+  /// @brief タイミング情報のリスト
+  std::vector<BnCellTiming> timing_list;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnCell BnCellLibrary.h "BnCellLibrary.h"
+/// @brief セルを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct BnCell
+{
+  /// @brief セル名
+  std::string name;
+
+  /// @brief 面積
+  double area{0.0};
+
+  /// @brief ピンのリスト
+  std::vector<BnCellPin> pin_list;
+
+  /// @brief 入力ピンのピン番号のリスト
+  std::vector<SizeType> input_list;
+
+  /// @brief 出力ピンのピン番号のリスト
+  std::vector<SizeType> output_list;
+
+  /// @brief FF やラッチなどの順序素子の時 true
+  bool is_sequential{false};
+
+  /// @brief 名前からピン番号を探す．
+  /// @return ピン番号を返す．
+  ///
+  /// 見つからなければ BAD_ID を返す．
+  SizeType
+  find_pin(
+    const std::string& pin_name ///< [in] ピン名
+  ) const
+  {
+    auto np = pin_list.size();
+    for ( SizeType i = 0; i < np; ++ i ) {
+      if ( pin_list[i].name == pin_name ) {
+	return i;
+      }
+    }
+    return BAD_ID;
+  }
+
+  /// @brief 組み合わせ論理の1出力セルの時 true を返す．
+  ///
+  /// .gate 文で用いることのできるセルはこの条件を満たすものに限られる．
+  bool
+  is_logic() const
+  {
+    if ( is_sequential || output_list.size() != 1 ) {
+      return false;
+    }
+    if ( input_list.size() + output_list.size() != pin_list.size() ) {
+      // inout や internal のピンを持つ．
+      return false;
+    }
+    auto& opin = pin_list[output_list[0]];
+    return opin.has_function && !opin.has_tristate;
+  }
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnCellLibrary BnCellLibrary.h "BnCellLibrary.h"
+/// @brief セルライブラリを表すクラス
+///
+/// BnModel::read_blif() で .gate 文を読み込む際や，
+/// BnModelBuilder::reg_cell() でセルの関数を登録する際に用いられる．
+/// 中身は共有されるのでコピーのコストは小さい．
+//////////////////////////////////////////////////////////////////////
+class BnCellLibrary
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// セルを1つも持たない．
+  BnCellLibrary();
+
+  /// @brief デストラクタ
+  ~BnCellLibrary();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ファイル入力
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief Liberty 形式のファイルを読み込む．
+  /// @return 結果の BnCellLibrary を返す．
+  ///
+  /// セルの面積，ピンの方向と論理関数，入力容量，
+  /// table_lookup モデルの遅延テーブルを取り出す．
+  /// それ以外の属性は読み飛ばす．
+  ///
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  BnCellLibrary
+  read_liberty(
+    const std::string& filename ///< [in] ファイル名
+  );
+
+  /// @brief genlib 形式のファイルを読み込む．
+  /// @return 結果の BnCellLibrary を返す．
+  ///
+  /// GATE 文からセルの面積，論理関数，ピンの入力容量と
+  /// 線形の遅延モデルの係数を取り出す．
+  /// 入力ピンの順番は論理式中に現れた順となる．
+  /// LATCH 文は順序素子のセルとして登録する．
+  ///
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  BnCellLibrary
+  read_genlib(
+    const std::string& filename ///< [in] ファイル名
+  );
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 情報を取得する関数
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ライブラリ名を返す．
+  const std::string&
+  name() const;
+
+  /// @brief セル数を返す．
+  SizeType
+  cell_num() const;
+
+  /// @brief セルを返す．
+  const BnCell&
+  cell(
+    SizeType cell_id ///< [in] セル番号 ( 0 <= cell_id < cell_num() )
+  ) const;
+
+  /// @brief 名前からセル番号を探す．
+  /// @return セル番号を返す．
+  ///
+  /// 見つからなければ BAD_ID を返す．
+  SizeType
+  find_cell(
+    const std::string& name ///< [in] セル名
+  ) const;
+
+  /// @brief 等価比較演算子
+  ///
+  /// 同じ中身を共有している時 true を返す．
+  bool
+  operator==(
+    const BnCellLibrary& right ///< [in] 比較対象
+  ) const
+  {
+    return mImpl == right.mImpl;
+  }
+
+  /// @brief 非等価比較演算子
+  bool
+  operator!=(
+    const BnCellLibrary& right ///< [in] 比較対象
+  ) const
+  {
+    return !operator==(right);
+  }
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 本体
+  std::shared_ptr<CellLibImpl> mImpl;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BNCELLLIBRARY_H
@@ -0,0 +1,202 @@
+#ifndef BNHIERMODEL_H
+#define BNHIERMODEL_H
+
+/// @file BnHierModel.h
+/// @brief BnHierModel のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnModel.h"
+#include "ym/JsonValue.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class HierImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnHierModel BnHierModel.h "BnHierModel.h"
+/// @brief 階層構造を保持したネットワークを表すクラス
+///
+/// 複数のモジュールからなり，各モジュールは自身の論理と
+/// 下位モジュールのインスタンスのリストを持つ．
+/// モジュールの本体(module_body())は BnModel で表され，
+/// インスタンスの部分で切り離されている．
+/// - 入力のうち，先頭の port_input_num() 個が入力ポートで，
+///   残りはインスタンスの出力につながる疑似入力となる．
+/// - 出力のうち，先頭の port_output_num() 個が出力ポートで，
+///   残りはインスタンスの入力につながる疑似出力となる．
+///
+/// flatten() で平坦化した BnModel を得ることができる．
+/// 各モジュールは1度だけ平坦化され，インスタンスごとに
+/// その結果を複製するので，同じモジュールのインスタンスが
+/// 多数あっても高速に平坦化できる．
+//////////////////////////////////////////////////////////////////////
+class BnHierModel
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  BnHierModel();
+
+  /// @brief デストラクタ
+  ~BnHierModel();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ファイル入力
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 階層構造を持つ blif ファイルの読み込みを行う．
+  /// @return 結果の BnHierModel を返す．
+  ///
+  /// 各 .model 文がモジュールとなり，.subckt 文がインスタンスとなる．
+  /// option は BnModel::read_blif() と同じだが，"thread_num" と
+  /// "cache_dir" は無視される．
+  ///
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  BnHierModel
+  read_blif(
+    const std::string& filename,          ///< [in] ファイル名
+    const JsonValue& option = JsonValue{} ///< [in] オプション
+  );
+
+  /// @brief セルライブラリを用いて階層構造を持つ blif ファイルの読み込みを行う．
+  /// @return 結果の BnHierModel を返す．
+  ///
+  /// .gate 文の扱いは BnModel::read_blif() と同じ．
+  ///
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  BnHierModel
+  read_blif(
+    const std::string& filename,          ///< [in] ファイル名
+    const BnCellLibrary& library,         ///< [in] セルライブラリ
+    const JsonValue& option = JsonValue{} ///< [in] オプション
+  );
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 情報を取得する関数
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュール数を返す．
+  ///
+  /// 最上位のモジュールの番号は 0 となる．
+  SizeType
+  module_num() const;
+
+  /// @brief モジュール名を返す．
+  const std::string&
+  module_name(
+    SizeType module_id ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+  ) const;
+
+  /// @brief 名前からモジュール番号を探す．
+  /// @return モジュール番号を返す．
+  ///
+  /// 見つからなければ BAD_ID を返す．
+  SizeType
+  find_module(
+    const std::string& name ///< [in] モジュール名
+  ) const;
+
+  /// @brief モジュールの本体を返す．
+  ///
+  /// 結果は複製なので変更しても元のモジュールには影響しない．
+  BnModel
+  module_body(
+    SizeType module_id ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+  ) const;
+
+  /// @brief 入力ポート数を返す．
+  SizeType
+  port_input_num(
+    SizeType module_id ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+  ) const;
+
+  /// @brief 出力ポート数を返す．
+  SizeType
+  port_output_num(
+    SizeType module_id ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+  ) const;
+
+  /// @brief インスタンス数を返す．
+  SizeType
+  instance_num(
+    SizeType module_id ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+  ) const;
+
+  /// @brief インスタンスのモジュール番号を返す．
+  SizeType
+  instance_module(
+    SizeType module_id, ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+    SizeType inst_pos   ///< [in] インスタンス番号 ( 0 <= inst_pos < instance_num(module_id) )
+  ) const;
+
+  /// @brief インスタンスの入力ポートにつながるノード番号のリストを返す．
+  ///
+  /// ノード番号は module_body() の BnModel のものである．
+  const std::vector<SizeType>&
+  instance_input_list(
+    SizeType module_id, ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+    SizeType inst_pos   ///< [in] インスタンス番号 ( 0 <= inst_pos < instance_num(module_id) )
+  ) const;
+
+  /// @brief インスタンスの出力ポートにつながるノード番号のリストを返す．
+  ///
+  /// ノード番号は module_body() の BnModel の疑似入力のものである．
+  const std::vector<SizeType>&
+  instance_output_list(
+    SizeType module_id, ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+    SizeType inst_pos   ///< [in] インスタンス番号 ( 0 <= inst_pos < instance_num(module_id) )
+  ) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 平坦化
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 平坦化した BnModel を返す．
+  ///
+  /// module_id のモジュールを最上位とする．
+  /// 最上位のモジュールのノード名はそのまま用いるが，
+  /// インスタンスの内部のノードは名前を持たない．
+  BnModel
+  flatten(
+    SizeType module_id = 0 ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+  ) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 本体
+  std::shared_ptr<HierImpl> mImpl;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BNHIERMODEL_H
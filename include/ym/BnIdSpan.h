@@ -0,0 +1,334 @@
+#ifndef BNIDSPAN_H
+#define BNIDSPAN_H
+
+/// @file BnIdSpan.h
+/// @brief BnIdSpan のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnIdSpan BnIdSpan.h "BnIdSpan.h"
+/// @brief ノード番号の配列を参照するだけのクラス
+///
+/// ModelImpl/NodeImpl が保持している番号の配列をそのまま指している．
+/// そのため std::vector<BnNode> を作る場合と異なり，メモリの確保も
+/// 共有ポインタの参照回数の操作も行わない．
+///
+/// 内部の配列の要素は BnIdType だが，取り出す値は SizeType となる．
+///
+/// 参照先の BnModel が破棄されたり，変更された場合には無効となる．
+//////////////////////////////////////////////////////////////////////
+class BnIdSpan
+{
+public:
+
+  /// @brief 反復子
+  ///
+  /// BnIdType の要素を SizeType に変換して返す．
+  class iterator
+  {
+  public:
+
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = SizeType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const SizeType*;
+    using reference = SizeType;
+
+  public:
+
+    /// @brief 空のコンストラクタ
+    iterator() = default;
+
+    /// @brief 内容を指定したコンストラクタ
+    explicit
+    iterator(
+      const BnIdType* ptr ///< [in] 要素を指すポインタ
+    ) : mPtr{ptr}
+    {
+    }
+
+    /// @brief dereference 演算子
+    SizeType
+    operator*() const
+    {
+      return static_cast<SizeType>(*mPtr);
+    }
+
+    /// @brief increment 演算子
+    iterator&
+    operator++()
+    {
+      ++ mPtr;
+      return *this;
+    }
+
+    /// @brief increment 演算子(後置)
+    iterator
+    operator++(int)
+    {
+      auto ans = *this;
+      ++ mPtr;
+      return ans;
+    }
+
+    /// @brief decrement 演算子
+    iterator&
+    operator--()
+    {
+      -- mPtr;
+      return *this;
+    }
+
+    /// @brief decrement 演算子(後置)
+    iterator
+    operator--(int)
+    {
+      auto ans = *this;
+      -- mPtr;
+      return ans;
+    }
+
+    /// @brief n 個先に進める．
+    iterator&
+    operator+=(
+      difference_type n ///< [in] 進める数
+    )
+    {
+      mPtr += n;
+      return *this;
+    }
+
+    /// @brief n 個前に戻す．
+    iterator&
+    operator-=(
+      difference_type n ///< [in] 戻す数
+    )
+    {
+      mPtr -= n;
+      return *this;
+    }
+
+    /// @brief n 個先の反復子を返す．
+    iterator
+    operator+(
+      difference_type n ///< [in] 進める数
+    ) const
+    {
+      return iterator{mPtr + n};
+    }
+
+    /// @brief n 個前の反復子を返す．
+    iterator
+    operator-(
+      difference_type n ///< [in] 戻す数
+    ) const
+    {
+      return iterator{mPtr - n};
+    }
+
+    /// @brief 差を返す．
+    difference_type
+    operator-(
+      const iterator& right
+    ) const
+    {
+      return mPtr - right.mPtr;
+    }
+
+    /// @brief n 個先の要素を返す．
+    SizeType
+    operator[](
+      difference_type n ///< [in] 位置
+    ) const
+    {
+      return static_cast<SizeType>(mPtr[n]);
+    }
+
+    /// @brief 等価比較演算子
+    bool
+    operator==(
+      const iterator& right
+    ) const
+    {
+      return mPtr == right.mPtr;
+    }
+
+    /// @brief 非等価比較演算子
+    bool
+    operator!=(
+      const iterator& right
+    ) const
+    {
+      return !operator==(right);
+    }
+
+    /// @brief 小なり比較演算子
+    bool
+    operator<(
+      const iterator& right
+    ) const
+    {
+      return mPtr < right.mPtr;
+    }
+
+    /// @brief 大なり比較演算子
+    bool
+    operator>(
+      const iterator& right
+    ) const
+    {
+      return right.operator<(*this);
+    }
+
+    /// @brief 小なりイコール比較演算子
+    bool
+    operator<=(
+      const iterator& right
+    ) const
+    {
+      return !right.operator<(*this);
+    }
+
+    /// @brief 大なりイコール比較演算子
+    bool
+    operator>=(
+      const iterator& right
+    ) const
+    {
+      return !operator<(right);
+    }
+
+    /// @brief n 個先の反復子を返す．
+    friend
+    iterator
+    operator+(
+      difference_type n,   ///< [in] 進める数
+      const iterator& iter ///< [in] 基準の反復子
+    )
+    {
+      return iter + n;
+    }
+
+  private:
+
+    // 要素を指すポインタ
+    const BnIdType* mPtr{nullptr};
+
+  };
+
+public:
+
+  /// @brief 空のコンストラクタ
+  BnIdSpan() = default;
+
+  /// @brief 内容を指定したコンストラクタ
+  BnIdSpan(
+    const BnIdType* begin, ///< [in] 先頭の要素を指すポインタ
+    const BnIdType* end    ///< [in] 末尾の次を指すポインタ
+  ) : mBegin{begin},
+      mEnd{end}
+  {
+  }
+
+  /// @brief std::vector から作るコンストラクタ
+  BnIdSpan(
+    const std::vector<BnIdType>& src ///< [in] 元となる配列
+  ) : mBegin{src.data()},
+      mEnd{src.data() + src.size()}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~BnIdSpan() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 要素数を返す．
+  SizeType
+  size() const
+  {
+    return mEnd - mBegin;
+  }
+
+  /// @brief 空の時 true を返す．
+  bool
+  empty() const
+  {
+    return mBegin == mEnd;
+  }
+
+  /// @brief 要素を返す．
+  ///
+  /// 範囲チェックは行わない．
+  SizeType
+  operator[](
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const
+  {
+    return static_cast<SizeType>(mBegin[pos]);
+  }
+
+  /// @brief 要素を返す．
+  ///
+  /// 範囲外の時は std::out_of_range 例外を送出する．
+  SizeType
+  at(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const
+  {
+    if ( pos >= size() ) {
+      throw std::out_of_range{"pos is out of range"};
+    }
+    return static_cast<SizeType>(mBegin[pos]);
+  }
+
+  /// @brief 先頭の反復子を返す．
+  iterator
+  begin() const
+  {
+    return iterator{mBegin};
+  }
+
+  /// @brief 末尾の反復子を返す．
+  iterator
+  end() const
+  {
+    return iterator{mEnd};
+  }
+
+  /// @brief std::vector に変換する．
+  std::vector<SizeType>
+  to_vector() const
+  {
+    return std::vector<SizeType>(mBegin, mEnd);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 先頭の要素
+  const BnIdType* mBegin{nullptr};
+
+  // 末尾の次の要素
+  const BnIdType* mEnd{nullptr};
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BNIDSPAN_H
@@ -15,6 +15,8 @@
 #include "ym/BnDff.h"
 #include "ym/BnNode.h"
 #include "ym/BnFunc.h"
+#include "ym/BnIdSpan.h"
+#include "ym/BnNodeRef.h"
 
 
 BEGIN_NAMESPACE_YM_BN
@@ -55,6 +57,7 @@ BEGIN_NAMESPACE_YM_BN
 ///   * iscas89(.bench)
 ///   * aiger(.aag, .aig)
 ///   * truth(IWLS2022)
+///   * 構造記述 Verilog(.v)
 ///
 /// BnModel クラスとしてはノード名とは別に入力名，出力名，DFF名を持つことが可能である．
 /// この場合，入力名とその入力に対応するノードのノード名が異なる場合もある．
@@ -70,6 +73,9 @@ BEGIN_NAMESPACE_YM_BN
 class BnModel :
   public BnBase
 {
+  friend class BnModelBuilder;
+  friend class BnHierModel;
+
 public:
 
   /// @brief 空のコンストラクタ
@@ -88,30 +94,246 @@ public:
   /// @brief blif ファイルの読み込みを行う．
   /// @return 結果の BnModel を返す．
   ///
+  /// option は以下のキーを持つ JSON オブジェクト
+  /// - "strash": bool 構造ハッシュを行う時 true にする．(set_strash() 参照)
+  /// - "mmap": bool ファイルを mmap() で読み込む時 true にする．(デフォルトは true)
+  /// - "thread_num": int 読み込みに用いるスレッド数(デフォルトは 1)
+  /// - "cache_dir": str 読み込み結果をキャッシュするディレクトリ
+  /// - "track_location": bool 識別子の参照位置と定義位置を記録する時 true にする．(デフォルトは true)
+  /// - "output_filter": list[str] 読み込む出力名のリスト
+  ///
+  /// "cache_dir" を指定すると，ファイルの内容のハッシュ値と形式，
+  /// "strash" の値をキーにして読み込み結果をスナップショット
+  /// (save_snapshot() 参照)として保存し，次回以降はそれを読み込む．
+  /// ファイルの内容が変わればキーも変わるので古い結果が使われることはない．
+  /// キャッシュの読み書きに失敗した場合は通常の読み込みを行う．
+  /// キャッシュは read_iscas89(), read_aag(), read_aig(), read_truth(),
+  /// read_verilog() でも同様に用いることができる．
+  ///
+  /// "thread_num" が 2 以上の場合，.names/.latch/.gate 文の境界でファイルを
+  /// 分割して並列に字句解析とカバーの生成を行う．結果とエラーメッセージは
+  /// 逐次的に読み込んだ場合と同一になる．
+  ///
+  /// "track_location" を false にすると位置情報の記録を省いて高速に読み込む．
+  /// 未定義や多重定義のように位置情報が必要なエラーが見つかった場合は
+  /// 記録しながら読み直すので，エラーメッセージは true の場合と同一になる．
+  /// 階層構造を持つファイルでは常に位置情報を記録する．
+  ///
+  /// "output_filter" を指定すると，それらの出力の推移的ファンインに含まれる
+  /// .names/.latch/.gate 文のみを読み込む．まずファイル全体を軽く走査して
+  /// 各文の位置と出力名を調べ，必要な文の位置から読み込みを再開するので，
+  /// 巨大なファイルの一部分のみが必要な場合に高速に読み込むことができる．
+  /// 出力の順番はファイル中の順となり，入力は全て残る．
+  /// 読み飛ばした文の構文エラーは検出されない．
+  /// この場合は "thread_num" に関わらず逐次的に読み込む．
+  /// 階層構造を持つファイルでは用いることはできない．
+  ///
+  /// .subckt 文を含むか複数の .model 文を持つファイルは最初の .model を
+  /// 最上位として平坦化した結果を返す(BnHierModel 参照)．
+  /// この場合は "thread_num" に関わらず逐次的に読み込む．
+  ///
+  /// gzip, xz, zstd で圧縮されたファイルは先頭のバイト列で判定して
+  /// 展開しながら読み込む．これは他の read_XXX() でも同様である．
+  /// 展開は別スレッドで行われ，逐次的に読み込む場合は展開済みの部分から
+  /// 字句解析を進める．"output_filter" や "thread_num" を指定した場合と
+  /// 階層構造を持つファイル，および read_aag(), read_aig(), read_truth() は
+  /// 展開が終わってから解析を始める．
+  /// どの場合も展開後の内容全体をメモリ上に置くので，展開後のサイズと
+  /// 同じだけのメモリを必要とする．
+  /// 各形式はビルド時にライブラリが見つかった場合のみ利用できる．
+  ///
+  /// BnProgressScope を用いると進捗の通知を受けたり，読み込みを
+  /// 中断したりすることができる．これは他の read_XXX() でも同様である．
+  /// 中断した場合は BnCanceled 例外を送出する．
+  ///
   /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
   static
   BnModel
   read_blif(
-    const std::string& filename ///< [in] ファイル名
+    const std::string& filename,          ///< [in] ファイル名
+    const JsonValue& option = JsonValue{} ///< [in] オプション
+  );
+
+  /// @brief セルライブラリを用いて blif ファイルの読み込みを行う．
+  /// @return 結果の BnModel を返す．
+  ///
+  /// .gate 文のセルを library から探し，その論理関数を持つ
+  /// 論理ノードを作る．関数はセルごとに1度だけ登録される．
+  /// 用いることのできるセルは組み合わせ論理の1出力セルに限られる．
+  /// option は read_blif() と同じだが，"cache_dir" は無視される．
+  ///
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  BnModel
+  read_blif(
+    const std::string& filename,          ///< [in] ファイル名
+    const BnCellLibrary& library,         ///< [in] セルライブラリ
+    const JsonValue& option = JsonValue{} ///< [in] オプション
   );
 
   /// @brief iscas89(.bench) ファイルの読み込みを行う．
   /// @return 結果の BnModel を返す．
   ///
+  /// option は以下のキーを持つ JSON オブジェクト
+  /// - "strash": bool 構造ハッシュを行う時 true にする．(set_strash() 参照)
+  /// - "mmap": bool ファイルを mmap() で読み込む時 true にする．(デフォルトは true)
+  /// - "cache_dir": str 読み込み結果をキャッシュするディレクトリ(read_blif() 参照)
+  /// - "track_location": bool 位置情報を記録する時 true にする．(read_blif() 参照)
+  ///
   /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
   static
   BnModel
   read_iscas89(
-    const std::string& filename ///< [in] ファイル名
+    const std::string& filename,          ///< [in] ファイル名
+    const JsonValue& option = JsonValue{} ///< [in] オプション
+  );
+
+  /// @brief aag(ASCII AIGER) ファイルの読み込みを行う．
+  /// @return 結果の BnModel を返す．
+  ///
+  /// option は以下のキーを持つ JSON オブジェクト
+  /// - "strash": bool 構造ハッシュを行う時 true にする．(set_strash() 参照)
+  /// - "mmap": bool ファイルを mmap() で読み込む時 true にする．(デフォルトは true)
+  /// - "cache_dir": str 読み込み結果をキャッシュするディレクトリ(read_blif() 参照)
+  ///
+  /// ラッチは DFF に変換される．初期値(AIGER 1.9)の 0, 1, 不定は
+  /// それぞれリセット値 '0', '1', 'X' となる．
+  /// bad state と invariant constraint は通常の出力の後ろに追加される．
+  /// justice と fairness を含むファイルは読み込めない．
+  ///
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  BnModel
+  read_aag(
+    const std::string& filename,          ///< [in] ファイル名
+    const JsonValue& option = JsonValue{} ///< [in] オプション
+  );
+
+  /// @brief aig(バイナリ AIGER) ファイルの読み込みを行う．
+  /// @return 結果の BnModel を返す．
+  ///
+  /// option と変換規則は read_aag() と同じ
+  ///
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  BnModel
+  read_aig(
+    const std::string& filename,          ///< [in] ファイル名
+    const JsonValue& option = JsonValue{} ///< [in] オプション
   );
 
   /// @brief truth ファイルの読み込みを行う．
   /// @return 結果の BnModel を返す．
   ///
+  /// option は以下のキーを持つ JSON オブジェクト
+  /// - "strash": bool 構造ハッシュを行う時 true にする．(set_strash() 参照)
+  /// - "mmap": bool ファイルを mmap() で読み込む時 true にする．(デフォルトは true)
+  /// - "thread_num": int 読み込みに用いるスレッド数(デフォルトは 1)
+  /// - "cache_dir": str 読み込み結果をキャッシュするディレクトリ(read_blif() 参照)
+  ///
+  /// "thread_num" が 2 以上の場合，各行の真理値表への変換を並列に行う．
+  /// 結果はスレッド数によらず同一となる．
+  ///
   /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
   static
   BnModel
   read_truth(
+    const std::string& filename,          ///< [in] ファイル名
+    const JsonValue& option = JsonValue{} ///< [in] オプション
+  );
+
+  /// @brief 構造記述 Verilog ファイルの読み込みを行う．
+  /// @return 結果の BnModel を返す．
+  ///
+  /// option は以下のキーを持つ JSON オブジェクト
+  /// - "strash": bool 構造ハッシュを行う時 true にする．(set_strash() 参照)
+  /// - "mmap": bool ファイルを mmap() で読み込む時 true にする．(デフォルトは true)
+  /// - "cache_dir": str 読み込み結果をキャッシュするディレクトリ(read_blif() 参照)
+  /// - "track_location": bool 位置情報を記録する時 true にする．(read_blif() 参照)
+  ///
+  /// 扱えるのは1つのモジュールからなる以下のサブセットのみ．
+  /// - input/output/wire/reg 宣言(ベクタはビットごとに "name[i]" に展開する)
+  /// - ~, &, |, ^, ~^, ?: と定数からなる式の assign 文
+  /// - and/nand/or/nor/xor/xnor/buf/not ゲートのインスタンス
+  /// - always @(posedge clk) 文による DFF
+  ///
+  /// クロック信号は通常の入力として扱う．
+  /// 読み込みが失敗したら std::invalid_argument 例外を送出する．
+  static
+  BnModel
+  read_verilog(
+    const std::string& filename,          ///< [in] ファイル名
+    const JsonValue& option = JsonValue{} ///< [in] オプション
+  );
+
+  /// @brief 形式を指定してファイルの読み込みを行う．
+  /// @return 結果の BnModel を返す．
+  ///
+  /// format は "blif", "iscas89", "aag", "aig", "truth", "verilog"
+  /// のいずれかで，対応する read_XXX() を呼び出す．
+  /// "auto" の場合は detect_format() で形式を判定する．
+  ///
+  /// 形式が不明な場合や判定できない場合，読み込みが失敗した場合は
+  /// std::invalid_argument 例外を送出する．
+  static
+  BnModel
+  read(
+    const std::string& filename,          ///< [in] ファイル名
+    const std::string& format = "auto",   ///< [in] 形式
+    const JsonValue& option = JsonValue{} ///< [in] オプション
+  );
+
+  /// @brief 複数のファイルを並列に読み込む．
+  /// @return 入力と同じ順番で各ファイルの結果を返す．
+  ///
+  /// format と option は全てのファイルに共通で，read() と同じ．
+  /// ファイルごとに1つのスレッドが読み込みを行い，失敗しても例外は
+  /// 送出せずに BnReadResult::ok を false にして残りのファイルを読み込む．
+  ///
+  /// 読み込み中のメッセージはファイルごとに溜めておき，呼び出した
+  /// スレッドで入力の順番に MsgMgr に出力する．そのため異なるファイルの
+  /// メッセージが混ざることはなく，出力の順番は逐次的に読み込んだ場合と
+  /// 同一になる．
+  ///
+  /// thread_num が 0 の場合はハードウェアのスレッド数を用いる．
+  /// 1 の場合は逐次的に読み込む．
+  ///
+  /// 呼び出したスレッドの BnProgressScope は各スレッドに引き継がれる．
+  /// 中断された場合や callback が例外を送出した場合は残りのファイルの
+  /// 読み込みを打ち切り，全てのスレッドが終了してから呼び出したスレッドで
+  /// その例外(BnCanceled など)をそのまま送出する．
+  static
+  std::vector<BnReadResult>
+  read_many(
+    const std::vector<std::string>& filename_list, ///< [in] ファイル名のリスト
+    const std::string& format = "auto",            ///< [in] 形式
+    SizeType thread_num = 0,                       ///< [in] スレッド数
+    const JsonValue& option = JsonValue{}          ///< [in] オプション
+  );
+
+  /// @brief ファイルの形式を判定する．
+  /// @return read() で用いる形式名を返す．
+  ///
+  /// まず拡張子(.blif, .bench, .aag, .aig, .truth, .v)で判定し，
+  /// 判定できなければファイルの先頭部分の内容から判定する．
+  /// 判定できない場合は空文字列を返す．
+  static
+  std::string
+  detect_format(
+    const std::string& filename ///< [in] ファイル名
+  );
+
+  /// @brief save_snapshot() で作られたスナップショットを読み込む．
+  /// @return 結果の BnModel を返す．
+  ///
+  /// ファイルは mmap() でマップされ，各表をその場で読み出して復元する．
+  /// 論理ノードの順序や凍結状態，構造ハッシュのモードも復元される．
+  ///
+  /// ファイルが存在しない場合，形式やバージョンが異なる場合，
+  /// 内容が壊れている場合には std::invalid_argument 例外を送出する．
+  static
+  BnModel
+  load_snapshot(
     const std::string& filename ///< [in] ファイル名
   );
 
@@ -119,6 +341,131 @@ public:
   //////////////////////////////////////////////////////////////////////
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 書き出しを行う関数
+  /// @{
+  ///
+  /// いずれも wrap_up() 後の内容を対象とする．
+  /// ファイル名を引数にとる関数はファイルが作成できなかった時に
+  /// std::invalid_argument 例外を送出する．
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief blif 形式で出力する．
+  ///
+  /// 論理ノードは1つの .names 文となる．
+  /// カバー型以外の関数はカバーに変換して出力する．
+  /// 名前を持たないノードには重複しない名前を生成する．
+  void
+  write_blif(
+    std::ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+  /// @brief blif 形式でファイルに出力する．
+  void
+  write_blif(
+    const std::string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief iscas89(.bench) 形式で出力する．
+  ///
+  /// プリミティブ型以外の関数はプリミティブゲートに分解する．
+  /// 定数と MUX 型の関数は拡張ゲート(CONST0, CONST1, MUX)で表す．
+  /// DFF のリセット値は出力されない．
+  void
+  write_iscas89(
+    std::ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+  /// @brief iscas89(.bench) 形式でファイルに出力する．
+  void
+  write_iscas89(
+    const std::string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief aag(ASCII AIGER) 形式で出力する．
+  ///
+  /// 論理ノードは構造ハッシュを用いて AND-INVERTER グラフに分解される．
+  /// DFF はラッチとなり，リセット値 '0', '1' はそのまま初期値に，
+  /// それ以外は不定(AIGER 1.9 形式)となる．
+  void
+  write_aag(
+    std::ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+  /// @brief aag(ASCII AIGER) 形式でファイルに出力する．
+  void
+  write_aag(
+    const std::string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief aig(バイナリ AIGER) 形式で出力する．
+  ///
+  /// 変換規則は write_aag() と同じ．
+  /// s はバイナリモードで開かれている必要がある．
+  void
+  write_aig(
+    std::ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+  /// @brief aig(バイナリ AIGER) 形式でファイルに出力する．
+  void
+  write_aig(
+    const std::string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief truth 形式で出力する．
+  ///
+  /// 各出力の外部入力に対する真理値表を1行ずつ出力する．
+  /// 変数の順番は read_truth() と同じで，最後の入力が最上位の変数となる．
+  /// DFF を含むモデルは出力できないので std::invalid_argument 例外を送出する．
+  void
+  write_truth(
+    std::ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+  /// @brief truth 形式でファイルに出力する．
+  void
+  write_truth(
+    const std::string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief 構造記述 Verilog 形式で出力する．
+  ///
+  /// read_verilog() で読み込めるサブセットで出力する．
+  /// DFF がある場合はクロック入力を追加する．DFF のリセット値は出力しない．
+  void
+  write_verilog(
+    std::ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+  /// @brief 構造記述 Verilog 形式でファイルに出力する．
+  void
+  write_verilog(
+    const std::string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @brief スナップショットを出力する．
+  ///
+  /// スナップショットは load_snapshot() で高速に読み込むための
+  /// バージョン付きのバイナリ形式で，モデルの内容を全て保存する．
+  /// 同じバージョンで同じバイト順の環境でのみ読み込むことができる．
+  /// s はバイナリモードで開かれている必要がある．
+  void
+  save_snapshot(
+    std::ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+  /// @brief スナップショットをファイルに出力する．
+  void
+  save_snapshot(
+    const std::string& filename ///< [in] ファイル名
+  ) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   /// @name 内容を読み出す関数
@@ -221,6 +568,56 @@ public:
   //////////////////////////////////////////////////////////////////////
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name メモリ確保を伴わない内容の読み出し関数
+  /// @{
+  ///
+  /// 以下の関数は BnNode のリストを作らずに，内部で保持している
+  /// ノード番号の配列をそのまま参照する．
+  /// 返り値は BnModel が存在し，内容が変更されない間のみ有効である．
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの借用参照を返す．
+  ///
+  /// - 範囲外のアクセスは std::out_of_range 例外を送出する．
+  BnNodeRef
+  node_ref(
+    SizeType id ///< [in] ノード番号 ( 0 <= id < node_num() )
+  ) const;
+
+  /// @brief 入力ノードのノード番号のリストを返す．
+  BnIdSpan
+  input_id_list() const;
+
+  /// @brief 入力ノードの借用参照のリストを返す．
+  BnNodeRefList
+  input_ref_list() const;
+
+  /// @brief 出力ノードのノード番号のリストを返す．
+  BnIdSpan
+  output_id_list() const;
+
+  /// @brief 出力ノードの借用参照のリストを返す．
+  BnNodeRefList
+  output_ref_list() const;
+
+  /// @brief 論理ノードのノード番号のリストを返す．
+  ///
+  /// 入力からのトポロジカル順になっている．
+  BnIdSpan
+  logic_id_list() const;
+
+  /// @brief 論理ノードの借用参照のリストを返す．
+  ///
+  /// 入力からのトポロジカル順になっている．
+  BnNodeRefList
+  logic_ref_list() const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   /// @name オプション情報を取得する関数
@@ -278,9 +675,56 @@ public:
   clear();
 
   /// @brief 設定情報を確定する．
+  ///
+  /// BnProgressScope を用いると進捗の通知を受けたり，処理を
+  /// 中断したりすることができる．中断した場合は BnCanceled 例外を
+  /// 送出する．その場合でも再度 wrap_up() を呼べばよい．
   void
   wrap_up();
 
+  /// @brief 構造ハッシュのモードを設定する．
+  ///
+  /// このモードでは同じ関数と同じファンインを持つ論理ノードを共有する．
+  /// 対称なプリミティブ型の場合にはファンインの順番は無視される．
+  /// - new_primitive() などは同一のノードが存在していたらそのノードを返す．
+  /// - ファイルからの読み込み時には wrap_up() の時点でまとめて共有化を行う．
+  ///   共有化されたノードは logic_list() から取り除かれる．
+  void
+  set_strash(
+    bool strash = true ///< [in] 構造ハッシュを行う時 true にする．
+  );
+
+  /// @brief 構造ハッシュのモードの時 true を返す．
+  bool
+  strash() const;
+
+  /// @brief 凍結する．
+  ///
+  /// wrap_up() を行った上で各ノードのレベルとファンアウトを求める．
+  /// 凍結後は内容を変更する関数はすべて std::logic_error 例外を送出する．
+  /// (wrap_up() と freeze() は何もしない)
+  ///
+  /// 凍結された BnModel は内部に遅延評価される状態を持たないので
+  /// ロックなしで複数のスレッドから同時に参照することができる．
+  /// 多数のスレッドで走査する場合には共有ポインタの参照回数の操作を
+  /// 避けるために BnNode ではなく BnNodeRef を用いることが望ましい．
+  /// ただし，BnFunc から取り出した Expr や Bdd などのオブジェクトの
+  /// 扱いは ym-logic の実装に依存する．
+  ///
+  /// copy() で得られる複製は凍結されていない状態となる．
+  void
+  freeze();
+
+  /// @brief 凍結されている時 true を返す．
+  bool
+  is_frozen() const;
+
+  /// @brief 最大レベルを返す．
+  ///
+  /// 凍結されていない時は std::logic_error 例外を送出する．
+  SizeType
+  depth() const;
+
   /// @brief オプション情報をセットする．
   void
   set_option(
@@ -404,6 +848,20 @@ private:
     ModelImpl* impl
   );
 
+  /// @brief 凍結されていないかチェックする．
+  ///
+  /// 凍結されていたら std::logic_error 例外を送出する．
+  void
+  _check_mutable(
+    const char* func_name
+  ) const;
+
+  /// @brief 読み込み時のオプションを適用する．
+  void
+  _set_read_option(
+    const JsonValue& option
+  );
+
   /// @brief 入力番号のチェックを行う．
   void
   _check_input_id(
@@ -430,6 +888,35 @@ private:
 
 };
 
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnReadResult BnModel.h "BnModel.h"
+/// @brief BnModel::read_many() の1つのファイルの結果を表す構造体
+//////////////////////////////////////////////////////////////////////
+struct BnReadResult
+{
+  /// @brief ファイル名
+  std::string filename;
+
+  /// @brief 用いた形式
+  ///
+  /// 形式を判定できなかった場合は空文字列となる．
+  std::string format;
+
+  /// @brief 読み込みに成功した時 true
+  bool ok{false};
+
+  /// @brief 結果の BnModel
+  ///
+  /// ok が false の時は空となる．
+  BnModel model;
+
+  /// @brief エラーメッセージ
+  ///
+  /// ok が false の時に読み込み関数が送出した例外の内容が入る．
+  std::string error;
+};
+
 END_NAMESPACE_YM_BN
 
 #endif // BNMODEL_H
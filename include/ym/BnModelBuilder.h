@@ -0,0 +1,262 @@
+#ifndef BNMODELBUILDER_H
+#define BNMODELBUILDER_H
+
+/// @file BnModelBuilder.h
+/// @brief BnModelBuilder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+#include "ym/BnModel.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class ModelImpl;
+class CellFuncMap;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnModelBuilder BnModelBuilder.h "BnModelBuilder.h"
+/// @brief BnModel を一括して生成するためのクラス
+///
+/// BnModel::new_primitive() などは BnNode のリストを受け取るため，
+/// ノードを一つ作るたびに複数回の配列のコピーが発生する．
+/// このクラスはノード番号/関数番号を直接扱い，ファンインのリストを
+/// ムーブで受け取ることでこのコストを削減する．
+///
+/// 使い方は以下の通り
+/// - 必要なら reserve() で領域を予約しておく．
+/// - reg_XXX() で関数を登録し，new_XXX() でノードを作る．
+/// - 最後に wrap_up() を一回だけ呼んで BnModel を取り出す．
+///
+/// wrap_up() の後はこのオブジェクトは空の状態に戻る．
+///
+/// ファンインのノード番号は既に生成されたノードのものでなければならない．
+/// 条件に合わない時は std::out_of_range 例外を送出する．
+//////////////////////////////////////////////////////////////////////
+class BnModelBuilder
+{
+public:
+
+  /// @brief コンストラクタ
+  BnModelBuilder();
+
+  /// @brief デストラクタ
+  ~BnModelBuilder();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 全体の操作
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノード用の領域を予約する．
+  void
+  reserve(
+    SizeType node_num ///< [in] 予想されるノード数
+  );
+
+  /// @brief 現在のノード数を返す．
+  SizeType
+  node_num() const;
+
+  /// @brief 設定情報を確定して BnModel を返す．
+  ///
+  /// 内部で BnModel::wrap_up() と同じ処理を一回だけ行う．
+  /// この関数の後は空の状態に戻る．
+  BnModel
+  wrap_up();
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 関数の登録
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief プリミティブ型の関数を登録する．
+  /// @return 関数番号を返す．
+  SizeType
+  reg_primitive(
+    SizeType input_num,     ///< [in] 入力数
+    PrimType primitive_type ///< [in] プリミティブの種類
+  );
+
+  /// @brief カバー型の関数を登録する．
+  /// @return 関数番号を返す．
+  SizeType
+  reg_cover(
+    const SopCover& input_cover, ///< [in] 入力カバー
+    bool output_inv              ///< [in] 出力の反転属性
+  );
+
+  /// @brief 論理式型の関数を登録する．
+  /// @return 関数番号を返す．
+  SizeType
+  reg_expr(
+    const Expr& expr ///< [in] 論理式
+  );
+
+  /// @brief 真理値表型の関数を登録する．
+  /// @return 関数番号を返す．
+  SizeType
+  reg_tvfunc(
+    const TvFunc& func ///< [in] 真理値表型の関数
+  );
+
+  /// @brief BDD型の関数を登録する．
+  /// @return 関数番号を返す．
+  SizeType
+  reg_bdd(
+    const Bdd& bdd ///< [in] BDD
+  );
+
+  /// @brief セルの論理関数を登録する．
+  /// @return 関数番号を返す．
+  ///
+  /// 同じセルに対しては最初に登録した関数番号を返すので，
+  /// マッピング結果などのセルごとに何度も呼び出してよい．
+  /// 入力の順番は BnCell::input_list の順となる．
+  /// 異なるライブラリを与えた場合はそれまでの対応表は破棄される．
+  /// セルが組み合わせ論理の1出力セルでない場合は
+  /// std::invalid_argument 例外を送出する．
+  SizeType
+  reg_cell(
+    const BnCellLibrary& library, ///< [in] セルライブラリ
+    SizeType cell_id              ///< [in] セル番号
+  );
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ノードの生成
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力ノードを作る．
+  /// @return ノード番号を返す．
+  SizeType
+  new_input(
+    const std::string& name = {} ///< [in] 名前
+  );
+
+  /// @brief DFFを作る．
+  /// @return DFF番号を返す．
+  ///
+  /// DFFの出力ノードも同時に作られる．
+  /// そのノード番号は dff_output_id() で得られる．
+  SizeType
+  new_dff(
+    const std::string& name = {}, ///< [in] 名前
+    char reset_val = 'X'          ///< [in] リセット値
+  );
+
+  /// @brief DFFの出力ノードのノード番号を返す．
+  SizeType
+  dff_output_id(
+    SizeType dff_id ///< [in] DFF番号
+  ) const;
+
+  /// @brief DFFの入力ノードを設定する．
+  void
+  set_dff_src(
+    SizeType dff_id, ///< [in] DFF番号
+    SizeType src_id  ///< [in] 入力に設定するノード番号
+  );
+
+  /// @brief 出力を作る．
+  /// @return 出力番号を返す．
+  SizeType
+  new_output(
+    SizeType src_id,             ///< [in] ソースのノード番号
+    const std::string& name = {} ///< [in] 名前
+  );
+
+  /// @brief 論理ノードを作る．
+  /// @return ノード番号を返す．
+  ///
+  /// [fanin_begin, fanin_end) の範囲をファンインとする．
+  SizeType
+  new_logic(
+    SizeType func_id,            ///< [in] 関数番号
+    const SizeType* fanin_begin, ///< [in] ファンインの先頭
+    const SizeType* fanin_end    ///< [in] ファンインの末尾の次
+  );
+
+  /// @brief 論理ノードを作る．
+  /// @return ノード番号を返す．
+  SizeType
+  new_logic(
+    SizeType func_id,                      ///< [in] 関数番号
+    std::initializer_list<SizeType> fanins ///< [in] ファンインのリスト
+  )
+  {
+    return new_logic(func_id, fanins.begin(), fanins.end());
+  }
+
+  /// @brief 論理ノードを作る．
+  /// @return ノード番号を返す．
+  ///
+  /// fanin_list の内容はムーブされる．
+  SizeType
+  new_logic(
+    SizeType func_id,                  ///< [in] 関数番号
+    std::vector<SizeType>&& fanin_list ///< [in] ファンインのリスト
+  );
+
+  /// @brief ノード名を設定する．
+  void
+  set_node_name(
+    SizeType id,            ///< [in] ノード番号
+    const std::string& name ///< [in] 名前
+  );
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノード番号のチェックを行う．
+  void
+  _check_node_id(
+    SizeType id,
+    const char* index_name
+  ) const;
+
+  /// @brief 関数番号のチェックを行う．
+  void
+  _check_func_id(
+    SizeType func_id
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 生成中のモデル
+  std::unique_ptr<ModelImpl> mImpl;
+
+  // セル番号から関数番号への変換表
+  std::unique_ptr<CellFuncMap> mCellFuncMap;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BNMODELBUILDER_H
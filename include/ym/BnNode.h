@@ -11,6 +11,7 @@
 #include "ym/bn.h"
 #include "ym/logic.h"
 #include "ym/BnBase.h"
+#include "ym/BnIdSpan.h"
 
 
 BEGIN_NAMESPACE_YM_BN
@@ -169,6 +170,62 @@ public:
   std::vector<BnNode>
   fanin_list() const;
 
+  /// @brief ファンインのノード番号のリストを返す．
+  ///
+  /// - is_logic() が false の時は空リストを返す．
+  /// - fanin_list() と異なりメモリ確保を行わない．
+  BnIdSpan
+  fanin_id_list() const;
+
+  /// @brief ファンインのノードの借用参照のリストを返す．
+  ///
+  /// - is_logic() が false の時は空リストを返す．
+  /// - fanin_list() と異なりメモリ確保を行わない．
+  BnNodeRefList
+  fanin_ref_list() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 凍結された BnModel に対してのみ有効なインターフェイス
+  //
+  // 凍結されていない時は std::logic_error 例外を送出する．
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief レベルを返す．
+  ///
+  /// 入力ノードのレベルは 0, 論理ノードのレベルはファンインの
+  /// 最大レベル + 1 となる．
+  SizeType
+  level() const;
+
+  /// @brief ファンアウト数を返す．
+  ///
+  /// 論理ノードのファンインとして参照されている数を返す．
+  /// 出力やDFFの入力としての参照は含まない．
+  SizeType
+  fanout_num() const;
+
+  /// @brief ファンアウトのノード番号のリストを返す．
+  BnIdSpan
+  fanout_id_list() const;
+
+  /// @brief ファンアウトのノードの借用参照のリストを返す．
+  BnNodeRefList
+  fanout_ref_list() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 借用参照
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 借用参照を返す．
+  ///
+  /// 親の BnModel が存在している間のみ有効となる．
+  BnNodeRef
+  ref() const;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -207,6 +264,12 @@ private:
     SizeType id                              ///< [in] ノード番号
   );
 
+  /// @brief 適切な値を持っているかチェックする．
+  ///
+  /// 不正値の時は std::logic_error 例外を送出する．
+  void
+  _check_valid() const;
+
   /// @brief ノードの実体を返す．
   const NodeImpl&
   _node_impl() const;
@@ -0,0 +1,433 @@
+#ifndef BNNODEREF_H
+#define BNNODEREF_H
+
+/// @file BnNodeRef.h
+/// @brief BnNodeRef のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnNode.h"
+#include "ym/BnIdSpan.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class ModelImpl;
+class NodeImpl;
+class BnNodeRefList;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnNodeRef BnNodeRef.h "BnNodeRef.h"
+/// @brief BnModel のノードを借用参照するクラス
+///
+/// BnNode と同様のインターフェイスを持つが，ModelImpl の共有ポインタ
+/// ではなく生のポインタを持つ．
+/// そのため生成/コピー時に共有ポインタの参照回数の操作が発生しない．
+/// 大きなネットワークを走査する場合に用いる．
+///
+/// 親の BnModel が存在している間しか有効ではない．
+/// また，BnModel の内容が変更された場合の動作は保証されない．
+///
+/// 空のコンストラクタで作られたインスタンスは不正値となる．
+/// その場合，is_valid() は false を返し，id() は BAD_ID を返すが，
+/// それ以外のメンバ関数の呼び出しは std::logic_error 例外を送出する．
+//////////////////////////////////////////////////////////////////////
+class BnNodeRef
+{
+  friend class BnBase;
+  friend class BnNodeRefList;
+
+public:
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// 不正な値となる．
+  BnNodeRef() = default;
+
+  /// @brief デストラクタ
+  ~BnNodeRef() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 共通なインターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 適切な値を持っている時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mModel != nullptr;
+  }
+
+  /// @brief 不正な値を持っている時 true を返す．
+  bool
+  is_invalid() const
+  {
+    return !is_valid();
+  }
+
+  /// @brief ノード番号を返す．
+  SizeType
+  id() const
+  {
+    return mId;
+  }
+
+  /// @brief ノードの種類を返す．
+  BnNode::Type
+  type() const;
+
+  /// @brief 入力ノードの時 true を返す．
+  bool
+  is_input() const;
+
+  /// @brief 論理ノードの時 true を返す．
+  bool
+  is_logic() const;
+
+  /// @brief 外部入力ノードの時 true を返す．
+  bool
+  is_primary_input() const;
+
+  /// @brief DFFの出力ノードの時 true を返す．
+  bool
+  is_dff_output() const;
+
+  /// @brief 入力番号を返す．
+  ///
+  /// - is_primary_input() が true の時のみ意味を持つ．
+  /// - それ以外の時は std::invalid_argument 例外を送出する．
+  SizeType
+  input_id() const;
+
+  /// @brief DFF番号を返す．
+  ///
+  /// - is_dff_output() が true の時のみ意味を持つ．
+  /// - それ以外の時は std::invalid_argument 例外を送出する．
+  SizeType
+  dff_id() const;
+
+  /// @brief 関数番号を返す．
+  ///
+  /// - is_logic() が true の時のみ意味を持つ．
+  /// - それ以外の時は std::invalid_argument 例外を送出する．
+  SizeType
+  func_id() const;
+
+  /// @brief ファンイン数を返す．
+  ///
+  /// - is_logic() が false の時は 0 を返す．
+  SizeType
+  fanin_num() const;
+
+  /// @brief ファンインのノード番号を返す．
+  ///
+  /// - pos が範囲外の時は std::out_of_range 例外を送出する．
+  SizeType
+  fanin_id(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < fanin_num() )
+  ) const;
+
+  /// @brief ファンインのノードを返す．
+  ///
+  /// - pos が範囲外の時は std::out_of_range 例外を送出する．
+  BnNodeRef
+  fanin(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < fanin_num() )
+  ) const;
+
+  /// @brief ファンインのノード番号のリストを返す．
+  ///
+  /// - is_logic() が false の時は空リストを返す．
+  BnIdSpan
+  fanin_id_list() const;
+
+  /// @brief ファンインのノードのリストを返す．
+  ///
+  /// - is_logic() が false の時は空リストを返す．
+  BnNodeRefList
+  fanin_list() const;
+
+  /// @brief レベルを返す．
+  ///
+  /// - 凍結された BnModel の時のみ意味を持つ．
+  /// - それ以外の時は std::logic_error 例外を送出する．
+  SizeType
+  level() const;
+
+  /// @brief ファンアウト数を返す．
+  ///
+  /// - 凍結された BnModel の時のみ意味を持つ．
+  /// - それ以外の時は std::logic_error 例外を送出する．
+  SizeType
+  fanout_num() const;
+
+  /// @brief ファンアウトのノード番号のリストを返す．
+  ///
+  /// - 凍結された BnModel の時のみ意味を持つ．
+  /// - それ以外の時は std::logic_error 例外を送出する．
+  BnIdSpan
+  fanout_id_list() const;
+
+  /// @brief ファンアウトのノードのリストを返す．
+  ///
+  /// - 凍結された BnModel の時のみ意味を持つ．
+  /// - それ以外の時は std::logic_error 例外を送出する．
+  BnNodeRefList
+  fanout_list() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 演算
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 等価比較演算子
+  bool
+  operator==(
+    const BnNodeRef& right ///< [in] 比較対象のオブジェクト
+  ) const
+  {
+    return mModel == right.mModel && mId == right.mId;
+  }
+
+  /// @brief 非等価比較演算子
+  bool
+  operator!=(
+    const BnNodeRef& right ///< [in] 比較対象のオブジェクト
+  ) const
+  {
+    return !operator==(right);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を指定したコンストラクタ
+  ///
+  /// これは BnBase と BnNodeRefList のみが使用する．
+  BnNodeRef(
+    const ModelImpl* model, ///< [in] 親のモデル
+    SizeType id             ///< [in] ノード番号
+  ) : mModel{model},
+      mId{id}
+  {
+  }
+
+  /// @brief 適切な値を持っているかチェックする．
+  ///
+  /// 不正値の時は std::logic_error 例外を送出する．
+  void
+  _check_valid() const;
+
+  /// @brief ノードの実体を返す．
+  const NodeImpl&
+  _node_impl() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 親のモデル
+  const ModelImpl* mModel{nullptr};
+
+  // ノード番号
+  SizeType mId{BAD_ID};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnNodeRefList BnNodeRef.h "BnNodeRef.h"
+/// @brief BnNodeRef のリストを表すクラス
+///
+/// 実際にはノード番号の配列(BnIdSpan)を持ち，要素を取り出す際に
+/// BnNodeRef を作る．そのため，要素数に比例したメモリ確保は行わない．
+/// BnNodeRef と同様に親の BnModel が存在している間しか有効ではない．
+//////////////////////////////////////////////////////////////////////
+class BnNodeRefList
+{
+  friend class BnBase;
+  friend class BnNodeRef;
+
+public:
+
+  /// @brief 反復子
+  class iterator
+  {
+  public:
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = BnNodeRef;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const BnNodeRef*;
+    using reference = BnNodeRef;
+
+  public:
+
+    /// @brief 空のコンストラクタ
+    iterator() = default;
+
+    /// @brief 内容を指定したコンストラクタ
+    iterator(
+      const ModelImpl* model,  ///< [in] 親のモデル
+      BnIdSpan::iterator cur   ///< [in] 現在の位置
+    ) : mModel{model},
+	mCur{cur}
+    {
+    }
+
+    /// @brief dereference 演算子
+    BnNodeRef
+    operator*() const
+    {
+      return BnNodeRef{mModel, *mCur};
+    }
+
+    /// @brief increment 演算子
+    iterator&
+    operator++()
+    {
+      ++ mCur;
+      return *this;
+    }
+
+    /// @brief increment 演算子(後置)
+    iterator
+    operator++(int)
+    {
+      auto ans = *this;
+      ++ mCur;
+      return ans;
+    }
+
+    /// @brief 等価比較演算子
+    bool
+    operator==(
+      const iterator& right
+    ) const
+    {
+      return mCur == right.mCur;
+    }
+
+    /// @brief 非等価比較演算子
+    bool
+    operator!=(
+      const iterator& right
+    ) const
+    {
+      return !operator==(right);
+    }
+
+  private:
+
+    // 親のモデル
+    const ModelImpl* mModel{nullptr};
+
+    // 現在の位置
+    BnIdSpan::iterator mCur;
+
+  };
+
+
+public:
+
+  /// @brief 空のコンストラクタ
+  BnNodeRefList() = default;
+
+  /// @brief デストラクタ
+  ~BnNodeRefList() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 要素数を返す．
+  SizeType
+  size() const
+  {
+    return mIdList.size();
+  }
+
+  /// @brief 空の時 true を返す．
+  bool
+  empty() const
+  {
+    return mIdList.empty();
+  }
+
+  /// @brief 要素を返す．
+  ///
+  /// 範囲チェックは行わない．
+  BnNodeRef
+  operator[](
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < size() )
+  ) const
+  {
+    return BnNodeRef{mModel, mIdList[pos]};
+  }
+
+  /// @brief ノード番号のリストを返す．
+  BnIdSpan
+  id_list() const
+  {
+    return mIdList;
+  }
+
+  /// @brief 先頭の反復子を返す．
+  iterator
+  begin() const
+  {
+    return iterator{mModel, mIdList.begin()};
+  }
+
+  /// @brief 末尾の反復子を返す．
+  iterator
+  end() const
+  {
+    return iterator{mModel, mIdList.end()};
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を指定したコンストラクタ
+  BnNodeRefList(
+    const ModelImpl* model, ///< [in] 親のモデル
+    BnIdSpan id_list        ///< [in] ノード番号のリスト
+  ) : mModel{model},
+      mIdList{id_list}
+  {
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 親のモデル
+  const ModelImpl* mModel{nullptr};
+
+  // ノード番号のリスト
+  BnIdSpan mIdList;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BNNODEREF_H
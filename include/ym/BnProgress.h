@@ -0,0 +1,278 @@
+#ifndef BNPROGRESS_H
+#define BNPROGRESS_H
+
+/// @file BnProgress.h
+/// @brief BnProgress, BnCancelToken, BnProgressScope のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnProgress BnProgress.h "ym/BnProgress.h"
+/// @brief 読み込みなどの時間のかかる処理の進捗を表す構造体
+///
+/// done と total の単位は phase によって異なる．
+/// - "read": ファイルのバイト数(圧縮されている場合は展開後のバイト数)
+///   展開しながら読み込んでいる間は total は 0 となる．
+/// - "wrap_up": ノード数
+/// - "strash": 論理ノード数
+//////////////////////////////////////////////////////////////////////
+struct BnProgress
+{
+  /// @brief 処理の段階を表す文字列
+  const char* phase;
+
+  /// @brief 処理済みの量
+  SizeType done;
+
+  /// @brief 全体の量
+  ///
+  /// 不明な場合は 0 となる．
+  SizeType total;
+
+  /// @brief 生成されたノード数
+  SizeType node_num;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnCancelToken BnProgress.h "ym/BnProgress.h"
+/// @brief 処理の中断を要求するためのクラス
+///
+/// コピーしたオブジェクトは同じフラグを共有するので，
+/// 別のスレッドで cancel() を呼ぶと BnProgressScope に渡した
+/// オブジェクトから中断が要求されていることがわかる．
+//////////////////////////////////////////////////////////////////////
+class BnCancelToken
+{
+public:
+
+  /// @brief コンストラクタ
+  BnCancelToken() :
+    mFlag{std::make_shared<std::atomic<bool>>(false)}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~BnCancelToken() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 中断を要求する．
+  ///
+  /// どのスレッドから呼んでもよい．
+  void
+  cancel() const
+  {
+    mFlag->store(true, std::memory_order_relaxed);
+  }
+
+  /// @brief 中断が要求されている時 true を返す．
+  bool
+  is_canceled() const
+  {
+    return mFlag->load(std::memory_order_relaxed);
+  }
+
+  /// @brief 中断の要求を取り消す．
+  void
+  reset() const
+  {
+    mFlag->store(false, std::memory_order_relaxed);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 中断フラグ
+  std::shared_ptr<std::atomic<bool>> mFlag;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnCanceled BnProgress.h "ym/BnProgress.h"
+/// @brief 処理が中断された時に送出される例外
+//////////////////////////////////////////////////////////////////////
+class BnCanceled :
+  public std::runtime_error
+{
+public:
+
+  /// @brief コンストラクタ
+  explicit
+  BnCanceled(
+    const std::string& msg ///< [in] メッセージ
+  ) : std::runtime_error{msg}
+  {
+  }
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnProgressScope BnProgress.h "ym/BnProgress.h"
+/// @brief 進捗の通知と中断の要求を受け付ける範囲を表すクラス
+///
+/// このオブジェクトが生存している間，同じスレッドで呼ばれた
+/// BnModel::read_XXX(), BnModel::read(), BnModel::read_many(),
+/// BnModel::wrap_up(), BnModel::freeze() は一定の間隔で callback を
+/// 呼び出し，token の中断要求を調べる．
+/// 中断が要求されていたら BnCanceled 例外を送出する．
+/// callback が例外を送出した場合もその例外がそのまま送出される．
+///
+/// read_many() で用いられる作業用のスレッドにも引き継がれる．
+/// その場合 callback は複数のスレッドから呼ばれるが，同時に
+/// 呼ばれることはない．
+///
+/// 入れ子にした場合は内側のものが有効となる．
+/// BnProgressScope がない場合の処理のオーバーヘッドはほぼない．
+///
+/// 使用例:
+/// ```
+/// BnCancelToken token;
+/// BnProgressScope scope{[](const BnProgress& p) {
+///     std::cout << p.phase << ": " << p.done << "/" << p.total << std::endl;
+///   }, token};
+/// auto model = BnModel::read_blif(filename);
+/// ```
+//////////////////////////////////////////////////////////////////////
+class BnProgressScope
+{
+  friend class BnModel;
+
+public:
+
+  /// @brief 進捗を受け取る関数の型
+  using Callback = std::function<void(const BnProgress&)>;
+
+  /// @brief コンストラクタ
+  ///
+  /// callback は最短でも interval 秒の間隔で呼ばれる．
+  /// ただし，各段階の最後には必ず呼ばれる．
+  explicit
+  BnProgressScope(
+    const Callback& callback = {},   ///< [in] 進捗を受け取る関数
+    const BnCancelToken& token = {}, ///< [in] 中断要求のトークン
+    double interval = 0.1            ///< [in] callback を呼ぶ最短の間隔(秒)
+  );
+
+  /// @brief デストラクタ
+  ~BnProgressScope();
+
+  BnProgressScope(const BnProgressScope&) = delete;
+  BnProgressScope& operator=(const BnProgressScope&) = delete;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在のスレッドで有効なオブジェクトを返す．
+  ///
+  /// なければ nullptr を返す．
+  static
+  BnProgressScope*
+  current();
+
+  /// @brief 中断要求のトークンを返す．
+  const BnCancelToken&
+  token() const
+  {
+    return mToken;
+  }
+
+  /// @brief 進捗を通知する．
+  ///
+  /// 中断が要求されていたら BnCanceled 例外を送出する．
+  /// final が false の場合，前回 callback を呼んでから interval 秒
+  /// 経っていなければ callback は呼ばない．
+  /// 複数のスレッドから呼んでもよい．
+  void
+  report(
+    const BnProgress& progress, ///< [in] 進捗
+    bool final = false          ///< [in] 段階の最後の時 true にする．
+  );
+
+  /// @brief callback が例外を送出していたら true を返す．
+  ///
+  /// BnModel::read_many() が読み込みのエラーと区別する際に用いる．
+  bool
+  callback_failed() const
+  {
+    return mCallbackFailed.load(std::memory_order_relaxed);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在のスレッドで有効なオブジェクトを設定する．
+  /// @return 以前のオブジェクトを返す．
+  ///
+  /// BnModel::read_many() が作業用のスレッドに引き継ぐ際に用いる．
+  static
+  BnProgressScope*
+  _set_current(
+    BnProgressScope* scope ///< [in] 設定するオブジェクト
+  );
+
+  /// @brief callback が例外を送出したという記録を消す．
+  void
+  _clear_callback_failed()
+  {
+    mCallbackFailed.store(false, std::memory_order_relaxed);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 進捗を受け取る関数
+  Callback mCallback;
+
+  // 中断要求のトークン
+  BnCancelToken mToken;
+
+  // callback を呼ぶ最短の間隔
+  std::chrono::steady_clock::duration mInterval;
+
+  // 前回 callback を呼んだ時刻
+  std::chrono::steady_clock::time_point mLastTime;
+
+  // callback の呼び出しを排他的に行うための mutex
+  std::mutex mMutex;
+
+  // callback が例外を送出した時 true となるフラグ
+  std::atomic<bool> mCallbackFailed{false};
+
+  // 外側のオブジェクト
+  BnProgressScope* mOuter;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BNPROGRESS_H
@@ -33,23 +33,65 @@ BEGIN_NAMESPACE_YM_BN
 /// @brief 不正なノード番号
 const SizeType BAD_ID = -1;
 
+/// @brief 内部でノード番号/関数番号を格納する型
+///
+/// YM_BN_COMPACT_ID が定義されている場合には 32ビットの符号なし整数
+/// を用いてメモリ使用量を削減する．
+/// この場合，ノード数の上限は 2^32 - 1 となる．
+/// 公開されているインターフェイスはこの設定にかかわらず SizeType を用いる．
+///
+/// ライブラリと利用者側で設定を一致させる必要がある．
+#if defined(YM_BN_COMPACT_ID)
+using BnIdType = std::uint32_t;
+#else
+using BnIdType = SizeType;
+#endif
+
+/// @brief BnIdType で表せるノード番号の上限(この値は含まない)
+///
+/// 全ビット1の値は BAD_ID を表すために予約されている．
+const SizeType BNID_LIMIT = static_cast<SizeType>(static_cast<BnIdType>(-1));
+
 //////////////////////////////////////////////////////////////////////
 // クラスの先行宣言
 //////////////////////////////////////////////////////////////////////
 
 class BnModel;
+struct BnReadResult;
+struct BnProgress;
+class BnCancelToken;
+class BnCanceled;
+class BnProgressScope;
+class BnModelBuilder;
+class BnHierModel;
+class BnCellLibrary;
 class BnDff;
 class BnNode;
 class BnFunc;
+class BnIdSpan;
+class BnNodeRef;
+class BnNodeRefList;
 
 END_NAMESPACE_YM_BN
 
 BEGIN_NAMESPACE_YM
 
 using BN_NAMESPACE::BnModel;
+using BN_NAMESPACE::BnReadResult;
+using BN_NAMESPACE::BnProgress;
+using BN_NAMESPACE::BnCancelToken;
+using BN_NAMESPACE::BnCanceled;
+using BN_NAMESPACE::BnProgressScope;
+using BN_NAMESPACE::BnModelBuilder;
+using BN_NAMESPACE::BnHierModel;
+using BN_NAMESPACE::BnCellLibrary;
 using BN_NAMESPACE::BnDff;
 using BN_NAMESPACE::BnNode;
 using BN_NAMESPACE::BnFunc;
+using BN_NAMESPACE::BnIdType;
+using BN_NAMESPACE::BnIdSpan;
+using BN_NAMESPACE::BnNodeRef;
+using BN_NAMESPACE::BnNodeRefList;
 
 END_NAMESPACE_YM
 
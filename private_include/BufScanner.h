@@ -0,0 +1,330 @@
+#ifndef BUFSCANNER_H
+#define BUFSCANNER_H
+
+/// @file BufScanner.h
+/// @brief BufScanner のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/FileInfo.h"
+#include "ym/FileLoc.h"
+#include "ym/FileRegion.h"
+#include "MappedFile.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BufScanner BufScanner.h "BufScanner.h"
+/// @brief メモリ上の文字列を対象とした字句解析器の基底クラス
+///
+/// ym の Scanner と同じインターフェイス(get(), peek(), accept(),
+/// set_first_loc(), cur_region() など)を持つが，入力は
+/// [begin, end) の範囲の文字列で，ポインタを進めるだけで文字を読む．
+/// 内容はこのクラスの外部で保持されている必要がある．
+///
+/// Scanner と同様に "\r\n" および単独の '\r' は '\n' として扱う．
+///
+/// ファイルの途中から読み出す場合には先頭の行番号とコラム番号を
+/// 指定することで正しい位置情報が得られる．
+///
+/// set_source() で展開中の MappedFile を指定すると，end に達した時点で
+/// 展開済みの範囲が伸びるのを待って読み進める．MappedFile は行の
+/// 末尾の単位で範囲を伸ばすので，end_ptr() までの範囲で区切り文字を
+/// 探す処理は改行文字を区切り文字に含めていればそのまま用いられる．
+//////////////////////////////////////////////////////////////////////
+class BufScanner
+{
+public:
+
+  /// @brief 読み出し位置を表す構造体
+  ///
+  /// mark() で得られた値をコンストラクタに渡すことで
+  /// その位置から読み出しを再開することができる．
+  struct Mark
+  {
+    const char* ptr; ///< 次に読み出す文字の位置
+    int line;        ///< 次に読み出す文字の行番号
+    int column;      ///< 次に読み出す文字のコラム番号
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  BufScanner(
+    const char* begin,         ///< [in] 内容の先頭
+    const char* end,           ///< [in] 内容の末尾の次
+    const FileInfo& file_info, ///< [in] ファイル情報
+    int line = 1,              ///< [in] 先頭の文字の行番号
+    int column = 1             ///< [in] 先頭の文字のコラム番号
+  ) : mCur{begin},
+      mEnd{end},
+      mLast{begin},
+      mFileInfo{file_info},
+      mNextLine{line},
+      mNextColumn{column},
+      mCurLine{line},
+      mCurColumn{column - 1},
+      mFirstLine{line},
+      mFirstColumn{column}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~BufScanner() = default;
+
+  /// @brief 展開中のファイルから読み出すようにする．
+  ///
+  /// 内容の末尾は file の展開済みの範囲に合わせて伸びる．
+  /// 展開に失敗した場合は読み出しの途中で std::invalid_argument 例外が
+  /// 送出される．
+  void
+  set_source(
+    const MappedFile& file ///< [in] 内容を展開しているファイル
+  )
+  {
+    if ( file.is_streaming() ) {
+      mSource = &file;
+    }
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 一文字単位の読み出し
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 一文字読み出す．
+  ///
+  /// peek(); accept() と等価
+  int
+  get()
+  {
+    auto c = peek();
+    accept();
+    return c;
+  }
+
+  /// @brief 次の文字を読み出す．
+  ///
+  /// ただし，読み出し位置は進めない．
+  int
+  peek() const
+  {
+    if ( mCur == mEnd && !refill() ) {
+      return EOF;
+    }
+    auto c = static_cast<unsigned char>(*mCur);
+    if ( c == '\r' ) {
+      return '\n';
+    }
+    return c;
+  }
+
+  /// @brief 直前の peek() を確定させる．
+  void
+  accept()
+  {
+    mCurLine = mNextLine;
+    mCurColumn = mNextColumn;
+    if ( mCur == mEnd ) {
+      return;
+    }
+    mLast = mCur;
+    auto c = *mCur;
+    ++ mCur;
+    if ( c == '\r' ) {
+      if ( mCur != mEnd && *mCur == '\n' ) {
+	++ mCur;
+      }
+      c = '\n';
+    }
+    if ( c == '\n' ) {
+      ++ mNextLine;
+      mNextColumn = 1;
+    }
+    else {
+      ++ mNextColumn;
+    }
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ポインタを直接操作する高速版の読み出し
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在の読み出し位置を返す．
+  const char*
+  cur_ptr() const
+  {
+    return mCur;
+  }
+
+  /// @brief 内容の末尾の次を返す．
+  ///
+  /// set_source() を用いている場合は現時点で読み出せる範囲の末尾となる．
+  const char*
+  end_ptr() const
+  {
+    return mEnd;
+  }
+
+  /// @brief 現在の読み出し位置を返す．
+  Mark
+  mark() const
+  {
+    return Mark{mCur, mNextLine, mNextColumn};
+  }
+
+  /// @brief 現在のトークンの先頭の文字の位置を返す．
+  ///
+  /// set_first_loc() を呼んだ時点の最後に読み出した文字の位置
+  const char*
+  first_ptr() const
+  {
+    return mFirstPtr;
+  }
+
+  /// @brief 読み出し位置を ptr まで進める．
+  ///
+  /// [cur_ptr(), ptr) の範囲には改行文字('\n', '\r')を
+  /// 含んではいけない．
+  /// ptr == cur_ptr() の場合は何もしない．
+  void
+  advance(
+    const char* ptr ///< [in] 新しい読み出し位置
+  )
+  {
+    SizeType n = ptr - mCur;
+    if ( n > 0 ) {
+      mCurLine = mNextLine;
+      mCurColumn = mNextColumn + n - 1;
+      mNextColumn += n;
+      mLast = ptr - 1;
+      mCur = ptr;
+    }
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 位置情報
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在の位置をトークンの最初の位置にセットする．
+  void
+  set_first_loc()
+  {
+    mFirstLine = mCurLine;
+    mFirstColumn = mCurColumn;
+    mFirstPtr = mLast;
+  }
+
+  /// @brief 現在のトークンの位置を返す．
+  FileRegion
+  cur_region() const
+  {
+    return FileRegion{mFileInfo, mFirstLine, mFirstColumn,
+		      mCurLine, mCurColumn};
+  }
+
+  /// @brief 現在のトークンの最初の位置を返す．
+  FileLoc
+  first_loc() const
+  {
+    return FileLoc{mFileInfo, mFirstLine, mFirstColumn};
+  }
+
+  /// @brief 現在の位置を返す．
+  FileLoc
+  cur_loc() const
+  {
+    return FileLoc{mFileInfo, mCurLine, mCurColumn};
+  }
+
+  /// @brief ファイル情報を返す．
+  const FileInfo&
+  file_info() const
+  {
+    return mFileInfo;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容の末尾を伸ばす．
+  /// @retval true 伸ばせた．
+  /// @retval false それ以上の内容がない．
+  ///
+  /// 読み出せる範囲を広げるだけなので const としている．
+  bool
+  refill() const
+  {
+    if ( mSource == nullptr ) {
+      return false;
+    }
+    auto end = mSource->wait_more(mEnd);
+    if ( end == mEnd ) {
+      return false;
+    }
+    mEnd = end;
+    return true;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 現在の読み出し位置
+  const char* mCur;
+
+  // 内容の末尾の次
+  //
+  // mSource がある場合は refill() で伸びる．
+  mutable const char* mEnd;
+
+  // 展開中のファイル
+  const MappedFile* mSource{nullptr};
+
+  // 最後に読み出した文字の位置
+  const char* mLast;
+
+  // トークンの最初の文字の位置
+  const char* mFirstPtr{nullptr};
+
+  // ファイル情報
+  FileInfo mFileInfo;
+
+  // 次の文字の行番号
+  int mNextLine;
+
+  // 次の文字のコラム番号
+  int mNextColumn;
+
+  // 最後に読み出した文字の行番号
+  int mCurLine;
+
+  // 最後に読み出した文字のコラム番号
+  int mCurColumn;
+
+  // トークンの最初の行番号
+  int mFirstLine;
+
+  // トークンの最初のコラム番号
+  int mFirstColumn;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // BUFSCANNER_H
@@ -0,0 +1,174 @@
+#ifndef BUFWRITER_H
+#define BUFWRITER_H
+
+/// @file BufWriter.h
+/// @brief BufWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include <charconv>
+#include <string_view>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BufWriter BufWriter.h "BufWriter.h"
+/// @brief 大きなバッファを介して出力を行うクラス
+///
+/// std::ostream への出力は1回ごとのオーバーヘッドが大きいので，
+/// いったん自前のバッファにためてからまとめて書き出す．
+/// 数値の変換には std::to_chars() を用いる．
+///
+/// デストラクタで残りの内容を書き出す．
+//////////////////////////////////////////////////////////////////////
+class BufWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  explicit
+  BufWriter(
+    std::ostream& s,             ///< [in] 出力先のストリーム
+    SizeType size = 1024 * 1024  ///< [in] バッファのサイズ
+  ) : mS{s},
+      mBuff(std::max<SizeType>(size, 64)),
+      mPos{mBuff.data()},
+      mEnd{mBuff.data() + mBuff.size()}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~BufWriter()
+  {
+    flush();
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 1文字出力する．
+  void
+  put(
+    char c ///< [in] 文字
+  )
+  {
+    if ( mPos == mEnd ) {
+      _write_buff();
+    }
+    *mPos = c;
+    ++ mPos;
+  }
+
+  /// @brief 文字列を出力する．
+  void
+  put(
+    std::string_view str ///< [in] 文字列
+  )
+  {
+    auto n = str.size();
+    if ( static_cast<SizeType>(mEnd - mPos) < n ) {
+      _write_buff();
+      if ( mBuff.size() < n ) {
+	// バッファに収まらない場合は直接書き出す．
+	mS.write(str.data(), n);
+	return;
+      }
+    }
+    std::memcpy(mPos, str.data(), n);
+    mPos += n;
+  }
+
+  /// @brief 符号なし整数を10進数で出力する．
+  void
+  put_num(
+    SizeType num ///< [in] 値
+  )
+  {
+    // 64ビットの整数は最大20桁
+    if ( mEnd - mPos < 20 ) {
+      _write_buff();
+    }
+    auto res = std::to_chars(mPos, mEnd, num);
+    mPos = res.ptr;
+  }
+
+  /// @brief バッファの内容を書き出す．
+  void
+  flush()
+  {
+    _write_buff();
+    mS.flush();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief バッファの内容をストリームに書き出す．
+  void
+  _write_buff()
+  {
+    auto n = mPos - mBuff.data();
+    if ( n > 0 ) {
+      mS.write(mBuff.data(), n);
+      mPos = mBuff.data();
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力先のストリーム
+  std::ostream& mS;
+
+  // バッファ
+  std::vector<char> mBuff;
+
+  // 次に書き込む位置
+  char* mPos;
+
+  // バッファの末尾
+  char* mEnd;
+
+};
+
+/// @brief ファイルを開いて書き出す．
+///
+/// BnModel::write_XXX(filename) の共通処理．
+/// ファイルが作成できなかった時は std::invalid_argument 例外を送出する．
+template<typename Func>
+void
+write_file(
+  const std::string& filename, ///< [in] ファイル名
+  const char* func_name,       ///< [in] 呼び出し元の関数名
+  Func func                    ///< [in] std::ostream& を引数にとる出力関数
+)
+{
+  std::ofstream s{filename, std::ios::binary};
+  if ( !s ) {
+    std::ostringstream buf;
+    buf << "BnModel::" << func_name << "(\"" << filename << "\"): "
+	<< "Could not create file.";
+    throw std::invalid_argument{buf.str()};
+  }
+  func(s);
+}
+
+END_NAMESPACE_YM_BN
+
+#endif // BUFWRITER_H
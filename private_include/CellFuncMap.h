@@ -0,0 +1,105 @@
+#ifndef CELLFUNCMAP_H
+#define CELLFUNCMAP_H
+
+/// @file CellFuncMap.h
+/// @brief CellFuncMap のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnCellLibrary.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class CellFuncMap CellFuncMap.h "CellFuncMap.h"
+/// @brief セル番号から関数番号への変換表
+///
+/// セルの論理関数は最初に参照された時に1度だけ ModelImpl に登録し，
+/// 以降は配列を引くだけで関数番号を返す．
+/// 変換表は1つの ModelImpl に対してのみ有効である．
+//////////////////////////////////////////////////////////////////////
+class CellFuncMap
+{
+public:
+
+  /// @brief コンストラクタ
+  CellFuncMap(
+    const BnCellLibrary& library ///< [in] セルライブラリ
+  ) : mLibrary{library},
+      mFuncList(library.cell_num(), BAD_ID)
+  {
+  }
+
+  /// @brief デストラクタ
+  ~CellFuncMap() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief セルライブラリを返す．
+  const BnCellLibrary&
+  library() const
+  {
+    return mLibrary;
+  }
+
+  /// @brief セルの関数番号を返す．
+  ///
+  /// 未登録の場合は model に登録する．
+  /// セルが組み合わせ論理の1出力セルでない場合は
+  /// std::invalid_argument 例外を送出する．
+  SizeType
+  operator()(
+    ModelImpl& model, ///< [in] 登録先のモデル
+    SizeType cell_id  ///< [in] セル番号
+  )
+  {
+    if ( cell_id >= mFuncList.size() ) {
+      throw std::out_of_range{"cell_id is out of range"};
+    }
+    auto& func_id = mFuncList[cell_id];
+    if ( func_id == BAD_ID ) {
+      func_id = reg_func(model, cell_id);
+    }
+    return func_id;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief セルの関数を登録する．
+  SizeType
+  reg_func(
+    ModelImpl& model, ///< [in] 登録先のモデル
+    SizeType cell_id  ///< [in] セル番号
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // セルライブラリ
+  BnCellLibrary mLibrary;
+
+  // セル番号をキーにして関数番号を格納する配列
+  std::vector<SizeType> mFuncList;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // CELLFUNCMAP_H
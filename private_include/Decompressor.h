@@ -0,0 +1,144 @@
+#ifndef DECOMPRESSOR_H
+#define DECOMPRESSOR_H
+
+/// @file Decompressor.h
+/// @brief Decompressor のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class Decompressor Decompressor.h "Decompressor.h"
+/// @brief 圧縮されたファイルを展開するクラス
+///
+/// gzip, xz, zstd 形式に対応する．形式はファイルの先頭のバイト列
+/// (マジックナンバー)で判定する．
+/// 各形式はビルド時にライブラリが見つかった場合のみ有効となり，
+/// それぞれ YM_BN_HAS_ZLIB, YM_BN_HAS_LZMA, YM_BN_HAS_ZSTD が定義される．
+///
+/// 展開中は別スレッドで圧縮されたデータを読み出す．2つのバッファを
+/// 交互に用いるので，ファイルの読み出しと展開が重なって行われる．
+/// 展開結果は Output を通して書き込むので，展開した部分から順に
+/// 他のスレッドで用いることもできる(MappedFile 参照)．
+//////////////////////////////////////////////////////////////////////
+class Decompressor
+{
+public:
+
+  /// @brief 圧縮形式を表す列挙型
+  enum Type {
+    None, ///< 圧縮されていない．
+    Gzip, ///< gzip
+    Xz,   ///< xz
+    Zstd  ///< zstd
+  };
+
+  /// @brief 形式の判定に必要なバイト数
+  static const SizeType MAGIC_SIZE = 6;
+
+  /// @brief 展開結果の書き込み先を表す基底クラス
+  class Output
+  {
+  public:
+
+    /// @brief デストラクタ
+    virtual
+    ~Output() = default;
+
+    /// @brief 書き込み用の領域を確保する．
+    /// @return 確保した領域の先頭を返す．
+    ///
+    /// 領域を確保できない場合は例外を送出する．
+    virtual
+    char*
+    reserve(
+      SizeType& avail ///< [out] 確保した領域のサイズ
+    ) = 0;
+
+    /// @brief reserve() で確保した領域の先頭から size バイトを確定する．
+    virtual
+    void
+    commit(
+      SizeType size ///< [in] 書き込んだサイズ
+    ) = 0;
+
+    /// @brief 確定したサイズの合計を返す．
+    virtual
+    SizeType
+    size() const = 0;
+
+  };
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 先頭のバイト列から圧縮形式を判定する．
+  ///
+  /// size が MAGIC_SIZE より小さい場合も判定できる範囲で判定する．
+  static
+  Type
+  detect(
+    const char* buf, ///< [in] 先頭のバイト列
+    SizeType size    ///< [in] buf のサイズ
+  );
+
+  /// @brief 圧縮形式の名前を返す．
+  static
+  const char*
+  type_name(
+    Type type ///< [in] 圧縮形式
+  );
+
+  /// @brief 圧縮形式が利用可能な時 true を返す．
+  static
+  bool
+  is_supported(
+    Type type ///< [in] 圧縮形式
+  );
+
+  /// @brief ストリームから読み出して展開する．
+  ///
+  /// 展開結果を out に追加する．
+  /// limit が 0 でない場合は少なくとも limit バイトを展開したら
+  /// その時点で終わる．
+  ///
+  /// 形式が利用できない場合や内容が壊れている場合は
+  /// std::invalid_argument 例外を送出する．
+  static
+  void
+  read(
+    std::istream& s,             ///< [in] 入力ストリーム
+    Type type,                   ///< [in] 圧縮形式
+    const std::string& filename, ///< [in] エラーメッセージ用のファイル名
+    std::string& out,            ///< [out] 展開結果
+    SizeType limit = 0           ///< [in] 展開するサイズの上限
+  );
+
+  /// @brief ストリームから読み出して展開する．
+  ///
+  /// 展開結果を out に書き込む．
+  /// それ以外は std::string に追加する read() と同じ
+  static
+  void
+  read(
+    std::istream& s,             ///< [in] 入力ストリーム
+    Type type,                   ///< [in] 圧縮形式
+    const std::string& filename, ///< [in] エラーメッセージ用のファイル名
+    Output& out,                 ///< [in] 展開結果の書き込み先
+    SizeType limit = 0           ///< [in] 展開するサイズの上限
+  );
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // DECOMPRESSOR_H
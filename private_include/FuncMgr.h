@@ -12,6 +12,7 @@
 #include "ym/logic.h"
 #include "ym/BddMgr.h"
 #include "FuncImpl.h"
+#include <string_view>
 
 
 BEGIN_NAMESPACE_YM_BN
@@ -19,6 +20,14 @@ BEGIN_NAMESPACE_YM_BN
 //////////////////////////////////////////////////////////////////////
 /// @class FuncMgr FuncMgr.h "FuncMgr.h"
 /// @brief 関数情報(FuncImpl)を管理するクラス
+///
+/// カバー型の関数は FuncImpl::signature() の代わりに，キューブを
+/// 1変数あたり2ビットに詰めて順に並べたバイト列をキーとして管理する．
+/// 関数の同一性は SopCover のキューブの並び(正規形)で判定するので，
+/// FuncImpl::signature() で比較した場合と同じ関数番号となる．
+/// begin_cover(), add_cube(), end_cover() を用いるとパーザーが読み込んだ
+/// キューブを直接このバイト列に詰めることができる．同じ並びのキューブが
+/// 既に登録されていた場合には SopCover を作らずに済む．
 //////////////////////////////////////////////////////////////////////
 class FuncMgr
 {
@@ -65,6 +74,34 @@ public:
     bool output_inv              ///< [in] 出力の反転構造
   );
 
+  /// @brief キューブを順に与えてカバー型を登録する準備をする．
+  ///
+  /// この後 add_cube() でキューブを追加して end_cover() で登録する．
+  void
+  begin_cover(
+    SizeType input_num ///< [in] 入力数
+  );
+
+  /// @brief キューブを追加する．
+  /// @retval true 追加した．
+  /// @retval false pat に '0', '1', '-' 以外の文字が含まれていた．
+  ///
+  /// pat の長さは begin_cover() で指定した入力数と等しくなければならない．
+  bool
+  add_cube(
+    const std::string_view& pat ///< [in] キューブのパタン
+  );
+
+  /// @brief 追加したキューブからなるカバー型を登録する．
+  /// @return 関数番号を返す．
+  ///
+  /// 結果は追加したキューブから SopCover を作って reg_cover() を
+  /// 呼んだ場合と同一となる．
+  SizeType
+  end_cover(
+    bool output_inv ///< [in] 出力の反転属性
+  );
+
   /// @brief 論理式型を登録する．
   /// @return 関数番号を返す．
   SizeType
@@ -118,6 +155,27 @@ private:
     FuncImpl* func
   );
 
+  /// @brief カバーの内容をキューブのバッファに設定する．
+  void
+  set_cover(
+    const SopCover& cover ///< [in] カバー
+  );
+
+  /// @brief キューブのバッファの内容からカバーのキーを作る．
+  ///
+  /// 結果は mCoverKey に格納される．
+  void
+  make_cover_key(
+    bool output_inv ///< [in] 出力の反転属性
+  );
+
+  /// @brief mCoverKey をキーとしてカバー型の関数情報を登録する．
+  /// @return 関数番号を返す．
+  SizeType
+  reg_cover_func(
+    FuncImpl* func
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -131,8 +189,34 @@ private:
   std::vector<std::unique_ptr<FuncImpl>> mFuncArray;
 
   // FuncImpl* をキーとして関数番号を格納する辞書
+  //
+  // カバー型以外の関数のみを格納する．
   FuncMap mFuncMap;
 
+  // カバーのキーから関数番号を格納する辞書
+  //
+  // SopCover のキューブの並びから作ったキーに加えて，end_cover() で
+  // 与えられたキューブの並びから作ったキーも別名として格納する．
+  std::unordered_map<std::string, SizeType> mCoverMap;
+
+  // 作成中のカバーの入力数
+  SizeType mCoverInputNum{0};
+
+  // 1つのキューブを表すバイト数
+  SizeType mCoverCubeSize{0};
+
+  // 作成中のカバーのキューブ数
+  SizeType mCoverCubeNum{0};
+
+  // キューブのバッファ
+  //
+  // 1つのキューブを mCoverCubeSize バイトで表す．
+  // 領域は使い回すので大きなカバーを読んだ後は確保し直さない．
+  std::string mCoverBuff;
+
+  // カバーのキー(make_cover_key() の結果)
+  std::string mCoverKey;
+
 };
 
 END_NAMESPACE_YM_BN
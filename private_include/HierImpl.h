@@ -0,0 +1,195 @@
+#ifndef HIERIMPL_H
+#define HIERIMPL_H
+
+/// @file HierImpl.h
+/// @brief HierImpl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ModelImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class HierInst HierImpl.h "HierImpl.h"
+/// @brief 下位モジュールのインスタンスを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct HierInst
+{
+  /// @brief 下位モジュールの番号
+  SizeType module_id;
+
+  /// @brief 下位モジュールの入力ポートにつながる上位のノード番号のリスト
+  std::vector<SizeType> input_list;
+
+  /// @brief 下位モジュールの出力ポートにつながる上位のノード番号のリスト
+  ///
+  /// これらのノードは上位モジュールの本体では疑似入力となっている．
+  std::vector<SizeType> output_list;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class HierModule HierImpl.h "HierImpl.h"
+/// @brief 階層構造中の1つのモジュールを表す構造体
+///
+/// body はモジュール自身の論理のみを持つ ModelImpl で，
+/// インスタンスの部分で切り離されている．
+/// - 入力は先頭の port_input_num 個が入力ポート，
+///   残りがインスタンスの出力につながる疑似入力
+/// - 出力は先頭の port_output_num 個が出力ポート，
+///   残りがインスタンスの入力につながる疑似出力
+//////////////////////////////////////////////////////////////////////
+struct HierModule
+{
+  /// @brief モジュール名
+  std::string name;
+
+  /// @brief 本体
+  std::unique_ptr<ModelImpl> body;
+
+  /// @brief 入力ポート数
+  SizeType port_input_num{0};
+
+  /// @brief 出力ポート数
+  SizeType port_output_num{0};
+
+  /// @brief インスタンスのリスト
+  std::vector<HierInst> inst_list;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class HierImpl HierImpl.h "HierImpl.h"
+/// @brief BnHierModel の内部情報を表すクラス
+///
+/// 平坦化は各モジュールを1度だけ平坦化したテンプレートを作り，
+/// インスタンスごとにテンプレートのノード配列を番号をずらして
+/// 複製することで行う．
+//////////////////////////////////////////////////////////////////////
+class HierImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  HierImpl() = default;
+
+  /// @brief デストラクタ
+  ~HierImpl() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュール数を返す．
+  SizeType
+  module_num() const
+  {
+    return mModuleList.size();
+  }
+
+  /// @brief モジュールを返す．
+  const HierModule&
+  module(
+    SizeType module_id ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+  ) const
+  {
+    _check_module_id(module_id);
+    return mModuleList[module_id];
+  }
+
+  /// @brief モジュールを返す．
+  HierModule&
+  module(
+    SizeType module_id ///< [in] モジュール番号 ( 0 <= module_id < module_num() )
+  )
+  {
+    _check_module_id(module_id);
+    return mModuleList[module_id];
+  }
+
+  /// @brief 名前からモジュール番号を探す．
+  /// @return モジュール番号を返す．
+  ///
+  /// 見つからなければ BAD_ID を返す．
+  SizeType
+  find_module(
+    const std::string& name ///< [in] モジュール名
+  ) const
+  {
+    auto p = mModuleDict.find(name);
+    if ( p == mModuleDict.end() ) {
+      return BAD_ID;
+    }
+    return p->second;
+  }
+
+  /// @brief モジュールを追加する．
+  /// @return モジュール番号を返す．
+  ///
+  /// 同名のモジュールが存在する場合は BAD_ID を返す．
+  /// その場合 body は破棄される．
+  SizeType
+  new_module(
+    const std::string& name,          ///< [in] モジュール名
+    std::unique_ptr<ModelImpl>&& body ///< [in] 本体
+  );
+
+  /// @brief インスタンスの循環がないか調べる．
+  /// @return 循環している場合はそのモジュール番号を返す．
+  ///
+  /// 循環がない場合は BAD_ID を返す．
+  SizeType
+  find_cycle() const;
+
+  /// @brief 平坦化した結果を dst に作る．
+  ///
+  /// dst は空でなければならない．
+  /// 最上位のモジュールのノード名はそのまま用いるが，
+  /// インスタンスの内部のノードは名前を持たない．
+  void
+  flatten(
+    SizeType module_id, ///< [in] 最上位のモジュール番号
+    ModelImpl& dst      ///< [out] 結果を格納するオブジェクト
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュール番号をチェックする．
+  void
+  _check_module_id(
+    SizeType module_id
+  ) const
+  {
+    if ( module_id >= module_num() ) {
+      throw std::out_of_range{"module_id is out of range"};
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // モジュールのリスト
+  std::vector<HierModule> mModuleList;
+
+  // モジュール名をキーにしてモジュール番号を格納する辞書
+  std::unordered_map<std::string, SizeType> mModuleDict;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // HIERIMPL_H
@@ -0,0 +1,32 @@
+#ifndef ISOP_H
+#define ISOP_H
+
+/// @file Isop.h
+/// @brief isop() のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/logic.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+/// @brief 真理値表の非冗長積和形を求める．
+/// @return キューブのリストを返す．
+///
+/// Minato-Morreale の方法を用いる．
+/// 各キューブは入力数と同じ長さの文字列で，
+/// i 文字目が '0', '1', '-' で入力 i のリテラルを表す．
+/// 定数0の場合は空のリストを，定数1の場合は '-' のみのキューブを1つ返す．
+extern
+std::vector<std::string>
+isop(
+  const TvFunc& func ///< [in] 真理値表
+);
+
+END_NAMESPACE_YM_BN
+
+#endif // ISOP_H
@@ -0,0 +1,241 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+/// @file MappedFile.h
+/// @brief MappedFile のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "Decompressor.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class MappedFile MappedFile.h "MappedFile.h"
+/// @brief ファイルの内容をメモリ上に展開するクラス
+///
+/// 可能ならば mmap() でファイルを読み出し専用でマップする．
+/// mmap() が使えない場合や use_mmap = false の場合には
+/// std::ifstream でファイル全体をバッファに読み込む．
+/// gzip, xz, zstd で圧縮されたファイルは展開した内容をバッファに
+/// 読み込む(Decompressor 参照)．
+/// どの場合でも [begin(), end()) が内容を表す．
+///
+/// 可能ならば展開は open() から戻った後も別スレッドで続けられる．
+/// 展開結果は最初に確保した仮想アドレスの領域に順に書き込まれるので，
+/// 内容は常に連続していて途中で移動することはない．
+/// 展開済みの範囲は行の末尾の単位で [begin(), ready_end()) として
+/// 公開され，wait_more() で範囲が伸びるのを待つことができる．
+/// スキャナーは BufScanner::set_source() でこのオブジェクトを
+/// 指定すると展開と並行して字句解析を行う．
+/// end() と size() は展開が終わるまで待つので，内容全体を用いる
+/// 処理はそのまま用いることができる．
+//////////////////////////////////////////////////////////////////////
+class MappedFile
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  MappedFile() = default;
+
+  /// @brief デストラクタ
+  ~MappedFile();
+
+  /// @brief コピーは禁止
+  MappedFile(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief コピー代入も禁止
+  MappedFile&
+  operator=(
+    const MappedFile& src
+  ) = delete;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを開く．
+  /// @retval true 成功した．
+  /// @retval false ファイルが開けなかった．
+  ///
+  /// decompress が true の場合，圧縮されたファイルは展開する．
+  /// 圧縮形式が利用できない場合や内容が壊れている場合は
+  /// std::invalid_argument 例外を送出する．
+  bool
+  open(
+    const std::string& filename, ///< [in] ファイル名
+    bool use_mmap = true,        ///< [in] mmap() を用いる時 true にする．
+    bool decompress = true       ///< [in] 圧縮されたファイルを展開する時 true にする．
+  );
+
+  /// @brief ストリームの内容を全て読み込む．
+  void
+  read(
+    std::istream& s ///< [in] 入力ストリーム
+  );
+
+  /// @brief 閉じる．
+  void
+  close();
+
+  /// @brief 内容の先頭を返す．
+  const char*
+  begin() const
+  {
+    return mBegin;
+  }
+
+  /// @brief 内容の末尾の次を返す．
+  ///
+  /// 展開中の場合は展開が終わるまで待つ．
+  const char*
+  end() const
+  {
+    return mBegin + size();
+  }
+
+  /// @brief 内容のサイズ(バイト数)を返す．
+  ///
+  /// 展開中の場合は展開が終わるまで待つ．
+  /// 展開に失敗した場合は std::invalid_argument 例外を送出する．
+  SizeType
+  size() const
+  {
+    if ( mStreaming ) {
+      wait_more(nullptr);
+    }
+    return mSize;
+  }
+
+  /// @brief 展開と並行して読み出している時 true を返す．
+  bool
+  is_streaming() const
+  {
+    return mStreaming;
+  }
+
+  /// @brief 内容のサイズがわかっていればそれを返す．
+  ///
+  /// 展開中でまだわからない場合は 0 を返す．
+  SizeType
+  size_hint() const;
+
+  /// @brief 展開済みの範囲の末尾の次を返す．
+  ///
+  /// 展開中でなければ end() と同じ
+  const char*
+  ready_end() const;
+
+  /// @brief 展開済みの範囲が end より先に伸びるまで待つ．
+  /// @return 展開済みの範囲の末尾の次を返す．
+  ///
+  /// 展開が終わっている場合は待たずに内容の末尾の次を返すので，
+  /// 返り値が end と等しければそれ以上の内容はない．
+  /// end が nullptr の場合は展開が終わるまで待つ．
+  /// 展開に失敗した場合は std::invalid_argument 例外を送出する．
+  const char*
+  wait_more(
+    const char* end ///< [in] 現在の末尾
+  ) const;
+
+  /// @brief mmap() でマップされている時 true を返す．
+  bool
+  is_mapped() const
+  {
+    return mMapAddr != nullptr;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 展開用のスレッドを起動する．
+  /// @retval true 起動した．
+  /// @retval false 領域が確保できなかった．
+  bool
+  start_stream(
+    std::ifstream&& s,           ///< [in] 圧縮されたファイルのストリーム
+    Decompressor::Type type,     ///< [in] 圧縮形式
+    const std::string& filename, ///< [in] ファイル名
+    SizeType file_size           ///< [in] 圧縮されたファイルのサイズ
+  );
+
+  /// @brief 展開済みの範囲を公開する．
+  void
+  publish(
+    SizeType size, ///< [in] 公開する範囲のサイズ
+    bool done      ///< [in] 展開が終わった時 true
+  );
+
+  // 展開結果の書き込み先
+  class StreamOutput;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 内容の先頭
+  const char* mBegin{nullptr};
+
+  // 内容のサイズ
+  //
+  // 展開中の場合は展開が終わった時点で設定される．
+  SizeType mSize{0};
+
+  // mmap() で得られたアドレス
+  void* mMapAddr{nullptr};
+
+  // mmap() でマップした領域のサイズ
+  SizeType mMapSize{0};
+
+  // 展開と並行して読み出している時 true
+  bool mStreaming{false};
+
+  // 以下は展開用のスレッドとの間で用いる．
+
+  // mReady, mDone, mError を保護する mutex
+  mutable std::mutex mMutex;
+
+  // mReady が伸びたか展開が終わったことを知らせる条件変数
+  mutable std::condition_variable mCond;
+
+  // 公開済みの範囲のサイズ
+  SizeType mReady{0};
+
+  // 展開が終わった時 true
+  bool mDone{false};
+
+  // 展開中に送出された例外
+  std::exception_ptr mError;
+
+  // 展開を中断させる時 true にする．
+  std::atomic<bool> mAbort{false};
+
+  // 展開用のスレッド
+  std::thread mDecoder;
+
+  // mmap() を使わない時のバッファ
+  std::string mBuff;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // MAPPEDFILE_H
@@ -13,6 +13,7 @@
 #include "ym/JsonValue.h"
 #include "NodeImpl.h"
 #include "FuncMgr.h"
+#include "ProgressReporter.h"
 
 
 BEGIN_NAMESPACE_YM_BN
@@ -24,8 +25,8 @@ BEGIN_NAMESPACE_YM_BN
 struct DffImpl
 {
   std::string name; ///< [in] 名前
-  SizeType id;      ///< [in] 出力のノード番号
-  SizeType src_id;  ///< [in] 入力のノード番号
+  BnIdType id;      ///< [in] 出力のノード番号
+  BnIdType src_id;  ///< [in] 入力のノード番号
   char reset_val;   ///< [in] リセット値 ('X', '0', '1')
 };
 
@@ -133,6 +134,18 @@ public:
     return *mNodeArray[id];
   }
 
+  /// @brief ノードが定義されている時 true を返す．
+  ///
+  /// alloc_node() で番号を確保しただけのノードは定義されていない．
+  bool
+  is_defined(
+    SizeType id ///< [in] ID番号
+  ) const
+  {
+    _check_node_id(id, "is_defined");
+    return mNodeArray[id].get() != nullptr;
+  }
+
   /// @brief 入力数を返す．
   SizeType
   input_num() const
@@ -164,8 +177,23 @@ public:
     return {};
   }
 
+  /// @brief ノード名を返す．
+  ///
+  /// 名前を持たない場合は空文字列を返す．
+  std::string
+  get_node_name(
+    SizeType id ///< [in] ID番号
+  ) const
+  {
+    auto p = mNameDict.find(id);
+    if ( p != mNameDict.end() ) {
+      return p->second;
+    }
+    return {};
+  }
+
   /// @brief 入力のノード番号のリストを返す．
-  const std::vector<SizeType>&
+  const std::vector<BnIdType>&
   input_id_list() const
   {
     return mInputList;
@@ -199,7 +227,7 @@ public:
   }
 
   /// @brief 出力のノード番号のリストを返す．
-  const std::vector<SizeType>&
+  const std::vector<BnIdType>&
   output_id_list() const
   {
     return mOutputList;
@@ -223,12 +251,69 @@ public:
   }
 
   /// @brief 論理ノード番号のリストを返す．
-  const std::vector<SizeType>&
+  const std::vector<BnIdType>&
   logic_id_list() const
   {
     return mLogicList;
   }
 
+  /// @brief 凍結されている時 true を返す．
+  bool
+  is_frozen() const
+  {
+    return mFrozen;
+  }
+
+  /// @brief ノードのレベルを返す．
+  ///
+  /// 凍結されていない時は std::logic_error 例外を送出する．
+  SizeType
+  level(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    _check_frozen("level");
+    _check_node_id(id, "level");
+    return mLevelArray[id];
+  }
+
+  /// @brief 最大レベルを返す．
+  ///
+  /// 凍結されていない時は std::logic_error 例外を送出する．
+  SizeType
+  depth() const
+  {
+    _check_frozen("depth");
+    return mDepth;
+  }
+
+  /// @brief ファンアウト数を返す．
+  ///
+  /// 凍結されていない時は std::logic_error 例外を送出する．
+  SizeType
+  fanout_num(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    _check_frozen("fanout_num");
+    _check_node_id(id, "fanout_num");
+    return mFanoutBegin[id + 1] - mFanoutBegin[id];
+  }
+
+  /// @brief ファンアウトのノード番号のリストを返す．
+  ///
+  /// 凍結されていない時は std::logic_error 例外を送出する．
+  BnIdSpan
+  fanout_id_list(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    _check_frozen("fanout_id_list");
+    _check_node_id(id, "fanout_id_list");
+    auto base = mFanoutList.data();
+    return BnIdSpan{base + mFanoutBegin[id], base + mFanoutBegin[id + 1]};
+  }
+
   /// @brief 関数の数を返す．
   SizeType
   func_num() const
@@ -258,9 +343,35 @@ public:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 内容をクリアする．
+  ///
+  /// 構造ハッシュのモードは変更しない．
   void
   clear();
 
+  /// @brief 構造ハッシュのモードを設定する．
+  ///
+  /// このモードでは同じ関数番号と同じファンインを持つ論理ノードを
+  /// 共有する．
+  /// - new_logic() は既に同じノードが存在していたらそのノード番号を返す．
+  /// - set_logic() で設定されたノードはファンインが未定義の場合がある
+  ///   ので make_logic_list() の中でまとめて共有化を行う．
+  ///   共有化されたノードは論理ノードのリストから取り除かれ，
+  ///   そのノードを参照している出力やDFFの入力は代表ノードに置き換えられる．
+  void
+  set_strash(
+    bool strash ///< [in] 構造ハッシュを行う時 true にする．
+  )
+  {
+    mStrash = strash;
+  }
+
+  /// @brief 構造ハッシュのモードの時 true を返す．
+  bool
+  strash() const
+  {
+    return mStrash;
+  }
+
   /// @brief オプション情報をセットする．
   void
   set_option(
@@ -337,6 +448,9 @@ public:
   alloc_node()
   {
     auto id = mNodeArray.size();
+    if ( id >= BNID_LIMIT ) {
+      throw std::overflow_error{"too many nodes"};
+    }
     mNodeArray.push_back(std::unique_ptr<NodeImpl>{nullptr});
     return id;
   }
@@ -363,6 +477,16 @@ public:
     const std::vector<SizeType>& fanin_list ///< [in] 入力の識別子番号のリスト
   );
 
+  /// @brief 論理ノードの情報をセットする．
+  ///
+  /// fanin_list の内容はムーブされる．
+  void
+  set_logic(
+    SizeType id,                        ///< [in] ID番号
+    SizeType func_id,                   ///< [in] 関数番号
+    std::vector<BnIdType>&& fanin_list ///< [in] 入力の識別子番号のリスト
+  );
+
   /// @brief ノード名をセットする．
   void
   set_node_name(
@@ -380,7 +504,8 @@ public:
   )
   {
     auto dff_id = mDffList.size();
-    mDffList.push_back({name, BAD_ID, BAD_ID, reset_val});
+    auto bad_id = static_cast<BnIdType>(BAD_ID);
+    mDffList.push_back({name, bad_id, bad_id, reset_val});
     return dff_id;
   }
 
@@ -393,7 +518,7 @@ public:
   )
   {
     auto id = alloc_node();
-    set_input(id);
+    set_input(id, name);
     return id;
   }
 
@@ -434,15 +559,70 @@ public:
     const std::vector<SizeType>& fanin_list ///< [in] 入力の識別子番号のリスト
   )
   {
+    if ( mStrash ) {
+      auto tmp_list = std::vector<BnIdType>(fanin_list.begin(), fanin_list.end());
+      return new_logic_strash(func_id, std::move(tmp_list));
+    }
     auto id = alloc_node();
     set_logic(id, func_id, fanin_list);
     return id;
   }
 
+  /// @brief 新しい論理ノードを作る．
+  ///
+  /// fanin_list の内容はムーブされる．
+  /// @return ID番号を返す．
+  SizeType
+  new_logic(
+    SizeType func_id,                   ///< [in] 関数番号
+    std::vector<BnIdType>&& fanin_list ///< [in] 入力の識別子番号のリスト
+  )
+  {
+    if ( mStrash ) {
+      return new_logic_strash(func_id, std::move(fanin_list));
+    }
+    auto id = alloc_node();
+    set_logic(id, func_id, std::move(fanin_list));
+    return id;
+  }
+
+  /// @brief ノード用の領域を予約する．
+  void
+  reserve(
+    SizeType node_num ///< [in] ノード数
+  )
+  {
+    mNodeArray.reserve(node_num);
+    mLogicList.reserve(node_num);
+  }
+
   /// @brief 論理ノードのリストを作る．
+  ///
+  /// 以前の内容はクリアされる．
   void
   make_logic_list();
 
+  /// @brief 論理ノードのリストを直接設定する．
+  ///
+  /// logic_list はトポロジカル順に並んでいなければならない．
+  /// スナップショットの読み込みのように順序がわかっている場合に
+  /// make_logic_list() の代わりに用いる．
+  void
+  set_logic_list(
+    std::vector<BnIdType>&& logic_list ///< [in] 論理ノード番号のリスト
+  )
+  {
+    mLogicList = std::move(logic_list);
+  }
+
+  /// @brief 凍結する．
+  ///
+  /// 論理ノードのリストを作り直し，レベルとファンアウトの情報を求める．
+  /// 凍結後の ModelImpl は変更されないので複数のスレッドから
+  /// 同時に参照することができる．
+  void
+  freeze();
+
   /// @brief プリミティブを登録する．
   /// @return 関数番号を返す．
   SizeType
@@ -465,6 +645,38 @@ public:
     return mFuncMgr.reg_cover(input_cover, output_inv);
   }
 
+  /// @brief キューブを順に与えてカバーを登録する準備をする．
+  ///
+  /// 詳細は FuncMgr::begin_cover() を参照のこと．
+  void
+  begin_cover(
+    SizeType input_num ///< [in] 入力数
+  )
+  {
+    mFuncMgr.begin_cover(input_num);
+  }
+
+  /// @brief キューブを追加する．
+  /// @retval true 追加した．
+  /// @retval false pat に不正な文字が含まれていた．
+  bool
+  add_cube(
+    const std::string_view& pat ///< [in] キューブのパタン
+  )
+  {
+    return mFuncMgr.add_cube(pat);
+  }
+
+  /// @brief 追加したキューブからなるカバーを登録する．
+  /// @return 関数番号を返す．
+  SizeType
+  end_cover(
+    bool output_inv ///< [in] 出力の反転属性
+  )
+  {
+    return mFuncMgr.end_cover(output_inv);
+  }
+
   /// @brief 論理式を登録する．
   /// @return 関数番号を返す．
   SizeType
@@ -496,16 +708,74 @@ public:
   }
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  // 構造ハッシュ用のキー
+  struct StrashKey {
+    SizeType func_id;                 ///< 関数番号
+    std::vector<BnIdType> fanin_list; ///< ファンインのリスト
+
+    bool
+    operator==(
+      const StrashKey& right
+    ) const
+    {
+      return func_id == right.func_id && fanin_list == right.fanin_list;
+    }
+  };
+
+  // StrashKey のハッシュ関数
+  struct StrashHash {
+    SizeType
+    operator()(
+      const StrashKey& key
+    ) const
+    {
+      SizeType h = key.func_id;
+      for ( auto id: key.fanin_list ) {
+	h = h * 1048573 + id;
+      }
+      return h;
+    }
+  };
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 構造ハッシュを用いて新しい論理ノードを作る．
+  ///
+  /// 同じノードが既に存在していたらそのノード番号を返す．
+  SizeType
+  new_logic_strash(
+    SizeType func_id,                  ///< [in] 関数番号
+    std::vector<BnIdType>&& fanin_list ///< [in] 入力の識別子番号のリスト
+  );
+
+  /// @brief mLogicList 中の同一構造のノードを共有化する．
+  void
+  strash_logic_list();
+
+  /// @brief 構造ハッシュ用のキーを作る．
+  ///
+  /// 対称な関数の場合にはファンインを整列させる．
+  StrashKey
+  strash_key(
+    SizeType func_id,                       ///< [in] 関数番号
+    const std::vector<BnIdType>& fanin_list ///< [in] 入力の識別子番号のリスト
+  ) const;
+
   /// @brief トポロジカルソートを行い mLogicList にセットする．
   void
   order_node(
-    SizeType id,                       ///< [in] ID番号
-    std::unordered_set<SizeType>& mark ///< [in] マーク
+    SizeType id,                ///< [in] ID番号
+    std::vector<bool>& mark,    ///< [in] マーク
+    ProgressReporter& progress  ///< [in] 進捗の通知先
   );
 
   /// @brief print() 中でノード名を出力する関数
@@ -574,6 +844,20 @@ private:
     }
   }
 
+  /// @brief 凍結されているかチェックする．
+  void
+  _check_frozen(
+    const char* func_name
+  ) const
+  {
+    if ( !mFrozen ) {
+      std::ostringstream buf;
+      buf << "Error in "
+	  << func_name << ": model is not frozen";
+      throw std::logic_error{buf.str()};
+    }
+  }
+
   /// @brief 論理ノード番号をチェックする．
   void
   _check_logic_id(
@@ -612,10 +896,10 @@ private:
   std::vector<std::unique_ptr<NodeImpl>> mNodeArray;
 
   // 入力のノード番号のリスト
-  std::vector<SizeType> mInputList;
+  std::vector<BnIdType> mInputList;
 
   // 出力のノード番号のリスト
-  std::vector<SizeType> mOutputList;
+  std::vector<BnIdType> mOutputList;
 
   // 出力名のりスト
   std::vector<std::string> mOutputNameList;
@@ -624,7 +908,7 @@ private:
   std::vector<DffImpl> mDffList;
 
   // 論理ノード番号のリスト
-  std::vector<SizeType> mLogicList;
+  std::vector<BnIdType> mLogicList;
 
   // ノード番号をキーにしてノード名を記録する辞書
   std::unordered_map<SizeType, std::string> mNameDict;
@@ -632,6 +916,33 @@ private:
   // 関数情報のマネージャ
   FuncMgr mFuncMgr;
 
+  // 構造ハッシュのモード
+  bool mStrash{false};
+
+  // 構造ハッシュ用の辞書
+  std::unordered_map<StrashKey, SizeType, StrashHash> mStrashDict;
+
+  // 凍結されている時 true にするフラグ
+  bool mFrozen{false};
+
+  // ノードのレベルの配列
+  // 凍結時に設定される．
+  std::vector<BnIdType> mLevelArray;
+
+  // 最大レベル
+  // 凍結時に設定される．
+  SizeType mDepth{0};
+
+  // ファンアウトリストの開始位置の配列
+  // ノード番号 id のファンアウトは mFanoutList の
+  // [mFanoutBegin[id], mFanoutBegin[id + 1]) に格納される．
+  // 凍結時に設定される．
+  std::vector<SizeType> mFanoutBegin;
+
+  // ファンアウトのノード番号のリスト
+  // 凍結時に設定される．
+  std::vector<BnIdType> mFanoutList;
+
 };
 
 END_NAMESPACE_YM_BN
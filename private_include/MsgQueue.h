@@ -0,0 +1,185 @@
+#ifndef MSGQUEUE_H
+#define MSGQUEUE_H
+
+/// @file MsgQueue.h
+/// @brief MsgQueue のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/MsgMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class MsgQueue MsgQueue.h "MsgQueue.h"
+/// @brief MsgMgr へのメッセージの出力を保留するためのクラス
+///
+/// 保留モードでは put_msg() の内容を溜めておき，flush() で
+/// まとめて MsgMgr に出力する．読み直す場合は clear() で破棄する．
+/// 保留モードでなければ put_msg() はそのまま MsgMgr に出力する．
+///
+/// set_thread_queue() でスレッドごとの MsgQueue を設定すると，
+/// そのスレッドで output() に渡されたメッセージは MsgMgr ではなく
+/// その MsgQueue に溜められる．複数のファイルを並列に読み込む際に
+/// ファイルごとにメッセージを分けるために用いる．
+/// パーサーは MsgMgr::put_msg() の代わりに output() を用いること．
+//////////////////////////////////////////////////////////////////////
+class MsgQueue
+{
+public:
+
+  /// @brief コンストラクタ
+  MsgQueue() = default;
+
+  /// @brief デストラクタ
+  ~MsgQueue() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 保留モードを設定する．
+  void
+  set_defer(
+    bool defer ///< [in] 保留する時 true
+  )
+  {
+    mDefer = defer;
+  }
+
+  /// @brief 保留モードの時 true を返す．
+  bool
+  is_deferred() const
+  {
+    return mDefer;
+  }
+
+  /// @brief メッセージを出力する．
+  ///
+  /// 引数は MsgMgr::put_msg() と同じ
+  void
+  put_msg(
+    const char* src_file,  ///< [in] ソースファイル名
+    int src_line,          ///< [in] ソースファイルの行番号
+    const FileRegion& loc, ///< [in] ファイル位置
+    MsgType type,          ///< [in] メッセージの種類
+    const char* label,     ///< [in] メッセージラベル
+    const std::string& msg ///< [in] メッセージ本文
+  )
+  {
+    if ( mDefer ) {
+      mMsgList.push_back(Msg{src_file, src_line, loc, type, label, msg});
+    }
+    else {
+      output(src_file, src_line, loc, type, label, msg);
+    }
+  }
+
+  /// @brief 保留しているメッセージを出力する．
+  void
+  flush()
+  {
+    for ( auto& m: mMsgList ) {
+      output(m.src_file, m.src_line, m.loc, m.type, m.label, m.msg);
+    }
+    mMsgList.clear();
+  }
+
+  /// @brief 保留しているメッセージがある時 true を返す．
+  bool
+  has_msg() const
+  {
+    return !mMsgList.empty();
+  }
+
+  /// @brief このスレッドのメッセージを溜める MsgQueue を設定する．
+  /// @return 以前の設定を返す．
+  ///
+  /// queue が nullptr の場合は MsgMgr に直接出力する．
+  static
+  MsgQueue*
+  set_thread_queue(
+    MsgQueue* queue ///< [in] メッセージを溜めるオブジェクト
+  )
+  {
+    auto old_queue = sThreadQueue;
+    sThreadQueue = queue;
+    return old_queue;
+  }
+
+  /// @brief メッセージを出力する．
+  ///
+  /// このスレッドの MsgQueue が設定されていればそこに溜め，
+  /// そうでなければ MsgMgr に出力する．
+  /// 引数は MsgMgr::put_msg() と同じ
+  static
+  void
+  output(
+    const char* src_file,  ///< [in] ソースファイル名
+    int src_line,          ///< [in] ソースファイルの行番号
+    const FileRegion& loc, ///< [in] ファイル位置
+    MsgType type,          ///< [in] メッセージの種類
+    const char* label,     ///< [in] メッセージラベル
+    const std::string& msg ///< [in] メッセージ本文
+  )
+  {
+    if ( sThreadQueue != nullptr ) {
+      sThreadQueue->mMsgList.push_back(Msg{src_file, src_line, loc,
+					   type, label, msg});
+    }
+    else {
+      MsgMgr::put_msg(src_file, src_line, loc, type, label, msg);
+    }
+  }
+
+  /// @brief 保留しているメッセージを破棄する．
+  void
+  clear()
+  {
+    mMsgList.clear();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 保留中のメッセージ
+  struct Msg
+  {
+    const char* src_file;
+    int src_line;
+    FileRegion loc;
+    MsgType type;
+    const char* label;
+    std::string msg;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 保留モードの時 true
+  bool mDefer{false};
+
+  // 保留中のメッセージのリスト
+  std::vector<Msg> mMsgList;
+
+  // スレッドごとのメッセージを溜めるオブジェクト
+  inline
+  static thread_local MsgQueue* sThreadQueue{nullptr};
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // MSGQUEUE_H
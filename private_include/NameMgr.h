@@ -0,0 +1,124 @@
+#ifndef NAMEMGR_H
+#define NAMEMGR_H
+
+/// @file NameMgr.h
+/// @brief NameMgr のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+class ModelImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class NameMgr NameMgr.h "NameMgr.h"
+/// @brief ファイル出力用にノード名を割り当てるクラス
+///
+/// 名前を持つノードにはその名前を，名前を持たないノードや
+/// 名前が他と重複しているノードには重複しない名前を生成して割り当てる．
+/// DFF の出力ノードが名前を持たない場合は DFF 名を，
+/// 外部出力となっているノードが名前を持たない場合は出力名を用いる．
+///
+/// 出力名が空の場合やソースノードの名前と等しい場合は
+/// ソースノードの名前を出力名とする．
+/// そうでない場合は出力名とノード名が異なるので，
+/// 呼び出し側でバッファを挿入する必要がある．
+//////////////////////////////////////////////////////////////////////
+class NameMgr
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// この時点で名前の割り当てを行う．
+  NameMgr(
+    const ModelImpl& model ///< [in] 対象のモデル
+  );
+
+  /// @brief デストラクタ
+  ~NameMgr() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノード名を返す．
+  ///
+  /// 定義されていないノードの場合は std::logic_error 例外を送出する．
+  const std::string&
+  node_name(
+    SizeType id ///< [in] ID番号
+  ) const
+  {
+    if ( id >= mNameArray.size() || mNameArray[id].empty() ) {
+      throw std::logic_error{"undefined node. wrap_up() may be required."};
+    }
+    return mNameArray[id];
+  }
+
+  /// @brief 出力名を返す．
+  const std::string&
+  output_name(
+    SizeType pos ///< [in] 出力番号
+  ) const
+  {
+    return mOutputNameList[pos];
+  }
+
+  /// @brief 出力名のリストを返す．
+  const std::vector<std::string>&
+  output_name_list() const
+  {
+    return mOutputNameList;
+  }
+
+  /// @brief 重複しない名前を生成する．
+  ///
+  /// 生成した名前は登録済みとなる．
+  std::string
+  new_name(
+    SizeType num ///< [in] 名前の元になる番号
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 名前を登録する．
+  /// @return 登録できたら true を返す．
+  ///
+  /// 空文字列の場合や既に使われていた場合は登録しない．
+  bool
+  reg_name(
+    const std::string& name ///< [in] 名前
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノード番号をキーにして名前を格納する配列
+  std::vector<std::string> mNameArray;
+
+  // 出力名のリスト
+  std::vector<std::string> mOutputNameList;
+
+  // 使用済みの名前の集合
+  std::unordered_set<std::string> mNameSet;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // NAMEMGR_H
@@ -11,6 +11,7 @@
 #include "ym/bn.h"
 #include "ym/logic.h"
 #include "ym/BnNode.h"
+#include "ym/BnIdSpan.h"
 
 
 BEGIN_NAMESPACE_YM_BN
@@ -58,6 +59,16 @@ public:
     const std::vector<SizeType>& fanin_list ///< [in] ファンインのノード番号のりスト
   );
 
+  /// @brief 論理ノードを作る．
+  ///
+  /// fanin_list の内容はムーブされる．
+  static
+  NodeImpl*
+  new_logic(
+    SizeType func_id,                  ///< [in] 関数番号
+    std::vector<BnIdType>&& fanin_list ///< [in] ファンインのノード番号のりスト
+  );
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -137,7 +148,7 @@ public:
 
   /// @brief ファンイン番号のリストを返す．
   virtual
-  const std::vector<SizeType>&
+  BnIdSpan
   fanin_id_list() const;
 
 };
@@ -0,0 +1,98 @@
+#ifndef PARSECACHE_H
+#define PARSECACHE_H
+
+/// @file ParseCache.h
+/// @brief ParseCache のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/JsonValue.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class ParseCache ParseCache.h "ParseCache.h"
+/// @brief 読み込み結果のキャッシュ
+///
+/// BnModel::read_XXX() の option に "cache_dir" が指定された時のみ有効となる．
+/// 入力ファイルの内容のハッシュ値と形式，結果に影響するオプション，
+/// スナップショットのバージョンからキーを作り，
+/// "cache_dir/<キー>.snap" にスナップショットとして保存する．
+/// 同じキーのスナップショットが存在する場合はそれを読み込む．
+///
+/// キャッシュの読み書きに失敗しても例外は送出せず，
+/// 通常の読み込みを行う．
+/// 複数のプロセスから同時に使えるように，保存は一時ファイルに書いてから
+/// rename() で置き換える．
+//////////////////////////////////////////////////////////////////////
+class ParseCache
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// option に "cache_dir" がない場合や filename が読めない場合は
+  /// 無効となる．
+  ParseCache(
+    const std::string& filename, ///< [in] 入力ファイル名
+    const char* format,          ///< [in] 形式名
+    const JsonValue& option      ///< [in] 読み込み用のオプション
+  );
+
+  /// @brief デストラクタ
+  ~ParseCache() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 有効な時 true を返す．
+  bool
+  is_enabled() const
+  {
+    return !mPath.empty();
+  }
+
+  /// @brief キャッシュファイルのパスを返す．
+  ///
+  /// 無効な場合は空文字列を返す．
+  const std::string&
+  path() const
+  {
+    return mPath;
+  }
+
+  /// @brief キャッシュから読み込む．
+  /// @retval true 読み込めた．
+  /// @retval false キャッシュが無効か該当するエントリがなかった．
+  bool
+  load(
+    BnModel& model ///< [out] 結果を格納するオブジェクト
+  ) const;
+
+  /// @brief キャッシュに保存する．
+  void
+  save(
+    const BnModel& model ///< [in] 保存するモデル
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // キャッシュファイルのパス
+  std::string mPath;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // PARSECACHE_H
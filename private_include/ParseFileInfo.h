@@ -0,0 +1,30 @@
+#ifndef PARSEFILEINFO_H
+#define PARSEFILEINFO_H
+
+/// @file ParseFileInfo.h
+/// @brief new_file_info() のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/FileInfo.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+/// @brief 読み込むファイルの FileInfo を作る．
+///
+/// FileInfo の登録はスレッドセーフではないので排他制御を行う．
+/// BnModel::read_many() で複数のファイルを並列に読み込むので
+/// パーサーは FileInfo のコンストラクタを直接呼ばずにこれを用いること．
+extern
+FileInfo
+new_file_info(
+  const std::string& filename ///< [in] ファイル名
+);
+
+END_NAMESPACE_YM_BN
+
+#endif // PARSEFILEINFO_H
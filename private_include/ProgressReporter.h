@@ -0,0 +1,149 @@
+#ifndef PROGRESSREPORTER_H
+#define PROGRESSREPORTER_H
+
+/// @file ProgressReporter.h
+/// @brief ProgressReporter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/BnProgress.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class ProgressReporter ProgressReporter.h "ProgressReporter.h"
+/// @brief パーサーなどから BnProgressScope に進捗を通知するクラス
+///
+/// 生成時のスレッドで有効な BnProgressScope を用いる．
+/// update() は処理済みの量が前回の通知から stride 以上増えた時のみ
+/// BnProgressScope::report() を呼ぶので，文ごとに呼んでも負担にならない．
+/// BnProgressScope がない場合は何もしない．
+//////////////////////////////////////////////////////////////////////
+class ProgressReporter
+{
+public:
+
+  /// @brief ファイルの読み込みで通知する間隔(バイト数)
+  static const SizeType BYTE_STRIDE = 64 * 1024;
+
+  /// @brief ノードの処理で通知する間隔(ノード数)
+  static const SizeType NODE_STRIDE = 4 * 1024;
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// 何も通知しない．
+  ProgressReporter() = default;
+
+  /// @brief コンストラクタ
+  ProgressReporter(
+    const char* phase, ///< [in] 処理の段階
+    SizeType total,    ///< [in] 全体の量
+    SizeType stride    ///< [in] 通知する間隔
+  ) : mScope{BnProgressScope::current()},
+      mPhase{phase},
+      mTotal{total},
+      mStride{stride},
+      mNext{mScope != nullptr ? 0 : NO_NEXT}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~ProgressReporter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 進捗を更新する．
+  ///
+  /// 中断が要求されていたら BnCanceled 例外を送出する．
+  void
+  update(
+    SizeType done,    ///< [in] 処理済みの量
+    SizeType node_num ///< [in] 生成されたノード数
+  )
+  {
+    if ( done >= mNext ) {
+      mNext = done + mStride;
+      mScope->report(BnProgress{mPhase, done, mTotal, node_num});
+    }
+  }
+
+  /// @brief 全体の量を設定する．
+  ///
+  /// 展開しながら読み込む場合のように，始めは全体の量がわからずに
+  /// 0 で生成した場合に finish() の前に呼ぶ．
+  void
+  set_total(
+    SizeType total ///< [in] 全体の量
+  )
+  {
+    mTotal = total;
+  }
+
+  /// @brief 段階の終了を通知する．
+  void
+  finish(
+    SizeType node_num ///< [in] 生成されたノード数
+  )
+  {
+    if ( mScope != nullptr ) {
+      mScope->report(BnProgress{mPhase, mTotal, mTotal, node_num}, true);
+    }
+  }
+
+  /// @brief 中断が要求されていたら BnCanceled 例外を送出する．
+  ///
+  /// update() と異なり通知する間隔によらずに調べる．
+  void
+  check_cancel()
+  {
+    if ( is_canceled() ) {
+      mScope->report(BnProgress{mPhase, 0, mTotal, 0});
+    }
+  }
+
+  /// @brief 中断が要求されている時 true を返す．
+  ///
+  /// 例外を送出できない作業用のスレッドで用いる．
+  bool
+  is_canceled() const
+  {
+    return mScope != nullptr && mScope->token().is_canceled();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // mNext の無効値
+  static const SizeType NO_NEXT = static_cast<SizeType>(-1);
+
+  // 通知先
+  BnProgressScope* mScope{nullptr};
+
+  // 処理の段階
+  const char* mPhase{""};
+
+  // 全体の量
+  SizeType mTotal{0};
+
+  // 通知する間隔
+  SizeType mStride{0};
+
+  // 次に通知する量
+  SizeType mNext{NO_NEXT};
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // PROGRESSREPORTER_H
@@ -0,0 +1,69 @@
+#ifndef READOPTION_H
+#define READOPTION_H
+
+/// @file ReadOption.h
+/// @brief ReadOption のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include "ym/JsonValue.h"
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class ReadOption ReadOption.h "ReadOption.h"
+/// @brief パーサー側で解釈する読み込み用のオプション
+///
+/// BnModel::read_XXX() の option のうち，ModelImpl の設定に
+/// 関係しないもの(入力方法など)を保持する．
+/// ModelImpl に関係するものは BnModel::_set_read_option() で扱う．
+//////////////////////////////////////////////////////////////////////
+struct ReadOption
+{
+  /// @brief 空のコンストラクタ
+  ReadOption() = default;
+
+  /// @brief JSON オブジェクトから値を取り出すコンストラクタ
+  ///
+  /// 知らないキーは無視する．
+  explicit
+  ReadOption(
+    const JsonValue& option ///< [in] オプションを表す JSON オブジェクト
+  );
+
+  // ファイルを mmap() で読み込む時 true
+  bool use_mmap{true};
+
+  // 読み込みに用いるスレッド数
+  //
+  // 1 以下の場合は逐次的に読み込む．
+  // 並列読み込みに対応していない形式では無視される．
+  SizeType thread_num{1};
+
+  // 読み込み結果をキャッシュするディレクトリ
+  //
+  // 空の場合はキャッシュを用いない．(ParseCache 参照)
+  std::string cache_dir;
+
+  // 識別子の参照位置と定義位置を記録する時 true
+  //
+  // false の場合は位置情報を記録せずに読み込み，位置情報が必要な
+  // エラーが見つかった時だけ記録しながら読み直す．
+  // どちらの場合も結果とエラーメッセージは同一となる．
+  bool track_location{true};
+
+  // 読み込む出力名のリスト
+  //
+  // 空でない場合はこれらの出力の推移的ファンインのみを読み込む．
+  // 現時点では blif 形式のみが対応している．
+  std::vector<std::string> output_filter;
+
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // READOPTION_H
@@ -0,0 +1,49 @@
+#ifndef THREADJOINER_H
+#define THREADJOINER_H
+
+/// @file ThreadJoiner.h
+/// @brief ThreadJoiner のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bn.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+BEGIN_NAMESPACE_YM_BN
+
+//////////////////////////////////////////////////////////////////////
+/// @class ThreadJoiner ThreadJoiner.h "ThreadJoiner.h"
+/// @brief スコープを抜ける時にスレッドを全て終了させるためのクラス
+///
+/// cancel を立ててから thread_list 中の join 可能なスレッドを join する．
+/// スレッドの生成の途中や読み込みの途中で例外が送出された場合にも
+/// join されないスレッドが残らないようにするために用いる．
+//////////////////////////////////////////////////////////////////////
+struct ThreadJoiner
+{
+  /// @brief デストラクタ
+  ~ThreadJoiner()
+  {
+    cancel = true;
+    for ( auto& th: thread_list ) {
+      if ( th.joinable() ) {
+	th.join();
+      }
+    }
+  }
+
+  /// @brief 各スレッドに中断を知らせるフラグ
+  std::atomic<bool>& cancel;
+
+  /// @brief スレッドのリスト
+  std::vector<std::thread>& thread_list;
+};
+
+END_NAMESPACE_YM_BN
+
+#endif // THREADJOINER_H
@@ -0,0 +1,83 @@
+
+/// @file bench_blif_scanner.cc
+/// @brief BlifScanner の処理速度(tokens/s)を測るプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BlifScanner.h"
+#include "MappedFile.h"
+#include <chrono>
+
+
+void
+usage(
+  const char* argv0
+)
+{
+  using namespace std;
+
+  cerr << "USAGE : " << argv0 << " file [loop_num]" << endl;
+}
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+  using namespace nsYm::nsBn;
+
+  if ( argc < 2 || argc > 3 ) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::string filename = argv[1];
+  SizeType loop_num = 3;
+  if ( argc > 2 ) {
+    loop_num = atoi(argv[2]);
+  }
+
+  MappedFile fin;
+  if ( !fin.open(filename) ) {
+    cerr << filename << ": No such file" << endl;
+    return 1;
+  }
+  double mbytes = static_cast<double>(fin.size()) / (1024.0 * 1024.0);
+
+  // 文字列の長さの合計も求めて最適化で消されないようにする．
+  double total = 0.0;
+  SizeType token_num = 0;
+  SizeType char_num = 0;
+  for ( SizeType l = 0; l < loop_num; ++ l ) {
+    auto t0 = chrono::steady_clock::now();
+    BlifScanner scanner{fin.begin(), fin.end(), FileInfo{filename}};
+    token_num = 0;
+    char_num = 0;
+    for ( ; ; ) {
+      FileRegion loc;
+      auto token = scanner.read_token(loc);
+      if ( token == BlifToken::_EOF ) {
+	break;
+      }
+      ++ token_num;
+      if ( token == BlifToken::STRING ) {
+	char_num += scanner.cur_string().size();
+      }
+    }
+    auto t1 = chrono::steady_clock::now();
+    total += chrono::duration<double>(t1 - t0).count();
+  }
+  auto sec = total / loop_num;
+  cout << sec << " sec, "
+       << token_num / sec / 1.0e6 << " Mtokens/s, "
+       << mbytes / sec << " MB/s"
+       << " (" << token_num << " tokens, "
+       << char_num << " chars)" << endl;
+
+  return 0;
+}
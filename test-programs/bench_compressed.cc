@@ -0,0 +1,131 @@
+
+/// @file bench_compressed.cc
+/// @brief 圧縮されたファイルの読み込みの処理速度を測るプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModel.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+
+void
+usage(
+  const char* argv0
+)
+{
+  using namespace std;
+
+  cerr << "USAGE : " << argv0 << " file.{gz|xz|zst} [loop_num]" << endl;
+}
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  if ( argc < 2 || argc > 3 ) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::string filename = argv[1];
+  SizeType loop_num = 3;
+  if ( argc > 2 ) {
+    loop_num = atoi(argv[2]);
+  }
+
+  // 展開に用いるコマンド
+  auto pos = filename.rfind('.');
+  if ( pos == std::string::npos ) {
+    usage(argv[0]);
+    return 2;
+  }
+  auto ext = filename.substr(pos + 1);
+  std::string command;
+  if ( ext == "gz" ) {
+    command = "gzip -dc";
+  }
+  else if ( ext == "xz" ) {
+    command = "xz -dc";
+  }
+  else if ( ext == "zst" ) {
+    command = "zstd -qdc";
+  }
+  else {
+    usage(argv[0]);
+    return 2;
+  }
+  auto format = BnModel::detect_format(filename);
+  if ( format.empty() ) {
+    cerr << filename << ": Unknown format" << endl;
+    return 1;
+  }
+
+  StreamMsgHandler msg_handler(cerr);
+  MsgMgr::attach_handler(&msg_handler);
+
+  // 一時ファイルは元の拡張子を残す．
+  auto base = filename.substr(0, pos);
+  auto slash = base.rfind('/');
+  if ( slash != std::string::npos ) {
+    base = base.substr(slash + 1);
+  }
+  auto tmp_name = "/tmp/bench_compressed_" + std::to_string(getpid())
+    + "_" + base;
+
+  try {
+    // 展開後のサイズを一時ファイルで求めておく．
+    double mbytes = 0.0;
+    for ( auto direct: {false, true} ) {
+      double total = 0.0;
+      SizeType node_num = 0;
+      for ( SizeType l = 0; l < loop_num; ++ l ) {
+	auto t0 = chrono::steady_clock::now();
+	BnModel model;
+	if ( direct ) {
+	  model = BnModel::read(filename, format);
+	}
+	else {
+	  auto cmd = command + " '" + filename + "' > '" + tmp_name + "'";
+	  if ( std::system(cmd.c_str()) != 0 ) {
+	    cerr << cmd << ": failed" << endl;
+	    return 1;
+	  }
+	  model = BnModel::read(tmp_name, format);
+	}
+	auto t1 = chrono::steady_clock::now();
+	total += chrono::duration<double>(t1 - t0).count();
+	node_num = model.node_num();
+      }
+      if ( !direct ) {
+	std::ifstream s{tmp_name, std::ios::binary | std::ios::ate};
+	mbytes = static_cast<double>(s.tellg()) / (1024.0 * 1024.0);
+	std::remove(tmp_name.c_str());
+      }
+      auto sec = total / loop_num;
+      cout << (direct ? "streaming: " : "temp file: ")
+	   << sec << " sec, "
+	   << mbytes / sec << " MB/s"
+	   << " (" << mbytes << " MB, "
+	   << node_num << " nodes)" << endl;
+    }
+  }
+  catch ( const std::invalid_argument& err ) {
+    cout << err.what() << endl;
+    std::remove(tmp_name.c_str());
+    return 1;
+  }
+
+  return 0;
+}
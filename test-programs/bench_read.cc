@@ -0,0 +1,103 @@
+
+/// @file bench_read.cc
+/// @brief 読み込みの処理速度(MB/s)を測るプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModel.h"
+#include "ym/JsonValue.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include <chrono>
+
+
+void
+usage(
+  const char* argv0
+)
+{
+  using namespace std;
+
+  cerr << "USAGE : " << argv0 << " blif|iscas89|aag|aig file [loop_num]" << endl;
+}
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  if ( argc < 3 || argc > 4 ) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::string format = argv[1];
+  std::string filename = argv[2];
+  SizeType loop_num = 3;
+  if ( argc > 3 ) {
+    loop_num = atoi(argv[3]);
+  }
+
+  if ( format != "blif" && format != "iscas89" &&
+       format != "aag" && format != "aig" ) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  StreamMsgHandler msg_handler(cerr);
+  MsgMgr::attach_handler(&msg_handler);
+
+  std::ifstream s{filename, std::ios::binary | std::ios::ate};
+  if ( !s ) {
+    cerr << filename << ": No such file" << endl;
+    return 1;
+  }
+  double mbytes = static_cast<double>(s.tellg()) / (1024.0 * 1024.0);
+
+  try {
+    for ( auto use_mmap: {false, true} ) {
+      std::unordered_map<std::string, JsonValue> opt_dict;
+      opt_dict.emplace("mmap", JsonValue{use_mmap});
+      JsonValue option{opt_dict};
+      double total = 0.0;
+      SizeType node_num = 0;
+      for ( SizeType l = 0; l < loop_num; ++ l ) {
+	auto t0 = chrono::steady_clock::now();
+	BnModel model;
+	if ( format == "blif" ) {
+	  model = BnModel::read_blif(filename, option);
+	}
+	else if ( format == "iscas89" ) {
+	  model = BnModel::read_iscas89(filename, option);
+	}
+	else if ( format == "aag" ) {
+	  model = BnModel::read_aag(filename, option);
+	}
+	else {
+	  model = BnModel::read_aig(filename, option);
+	}
+	auto t1 = chrono::steady_clock::now();
+	total += chrono::duration<double>(t1 - t0).count();
+	node_num = model.node_num();
+      }
+      auto sec = total / loop_num;
+      cout << (use_mmap ? "mmap:    " : "istream: ")
+	   << sec << " sec, "
+	   << mbytes / sec << " MB/s"
+	   << " (" << mbytes << " MB, "
+	   << node_num << " nodes)" << endl;
+    }
+  }
+  catch ( const std::invalid_argument& err ) {
+    cout << err.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+
+/// @file bench_snapshot.cc
+/// @brief スナップショットの読み込み時間を測るプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModel.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
+#include <chrono>
+
+
+void
+usage(
+  const char* argv0
+)
+{
+  using namespace std;
+
+  cerr << "USAGE : " << argv0 << " blif-file snapshot-file [loop_num]" << endl;
+}
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  if ( argc < 3 || argc > 4 ) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::string filename = argv[1];
+  std::string snap_filename = argv[2];
+  SizeType loop_num = 3;
+  if ( argc > 3 ) {
+    loop_num = atoi(argv[3]);
+  }
+
+  StreamMsgHandler msg_handler(cerr);
+  MsgMgr::attach_handler(&msg_handler);
+
+  auto file_mbytes = [](const std::string& filename) {
+    std::ifstream s{filename, std::ios::binary | std::ios::ate};
+    return static_cast<double>(s.tellg()) / (1024.0 * 1024.0);
+  };
+
+  try {
+    // blif の読み込み
+    double blif_total = 0.0;
+    BnModel model;
+    for ( SizeType l = 0; l < loop_num; ++ l ) {
+      auto t0 = chrono::steady_clock::now();
+      model = BnModel::read_blif(filename);
+      auto t1 = chrono::steady_clock::now();
+      blif_total += chrono::duration<double>(t1 - t0).count();
+    }
+
+    // スナップショットの書き出し
+    auto t0 = chrono::steady_clock::now();
+    model.save_snapshot(snap_filename);
+    auto t1 = chrono::steady_clock::now();
+    auto save_sec = chrono::duration<double>(t1 - t0).count();
+
+    // スナップショットの読み込み
+    double snap_total = 0.0;
+    SizeType node_num = 0;
+    for ( SizeType l = 0; l < loop_num; ++ l ) {
+      auto t0 = chrono::steady_clock::now();
+      auto model2 = BnModel::load_snapshot(snap_filename);
+      auto t1 = chrono::steady_clock::now();
+      snap_total += chrono::duration<double>(t1 - t0).count();
+      node_num = model2.node_num();
+    }
+
+    auto blif_mbytes = file_mbytes(filename);
+    auto snap_mbytes = file_mbytes(snap_filename);
+    auto blif_sec = blif_total / loop_num;
+    auto snap_sec = snap_total / loop_num;
+    cout << "read_blif:     " << blif_sec << " sec, "
+	 << blif_mbytes / blif_sec << " MB/s"
+	 << " (" << blif_mbytes << " MB)" << endl
+	 << "save_snapshot: " << save_sec << " sec" << endl
+	 << "load_snapshot: " << snap_sec << " sec, "
+	 << snap_mbytes / snap_sec << " MB/s"
+	 << " (" << snap_mbytes << " MB)" << endl
+	 << "speedup:       " << blif_sec / snap_sec
+	 << " (" << node_num << " nodes)" << endl;
+  }
+  catch ( const std::invalid_argument& err ) {
+    cout << err.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
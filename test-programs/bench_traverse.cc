@@ -0,0 +1,109 @@
+
+/// @file bench_traverse.cc
+/// @brief ノード番号の格納形式によるメモリ量/走査時間を測るプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModel.h"
+#include <chrono>
+#include <random>
+
+
+void
+usage(
+  const char* argv0
+)
+{
+  using namespace std;
+
+  cerr << "USAGE : " << argv0 << " [node_num [loop_num]]" << endl;
+}
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  SizeType node_num = 1000000;
+  SizeType loop_num = 20;
+  if ( argc > 3 ) {
+    usage(argv[0]);
+    return 2;
+  }
+  if ( argc > 1 ) {
+    node_num = atoi(argv[1]);
+  }
+  if ( argc > 2 ) {
+    loop_num = atoi(argv[2]);
+  }
+
+  // 入力数はノード数の 1/16 とする．
+  SizeType input_num = node_num / 16 + 1;
+
+  auto t0 = chrono::steady_clock::now();
+
+  BnModel model;
+  std::vector<BnNode> node_list;
+  node_list.reserve(node_num);
+  for ( SizeType i = 0; i < input_num; ++ i ) {
+    node_list.push_back(model.new_input());
+  }
+  std::mt19937 rg;
+  SizeType fanin_total = 0;
+  for ( SizeType i = input_num; i < node_num; ++ i ) {
+    std::uniform_int_distribution<SizeType> nd(2, 4);
+    std::uniform_int_distribution<SizeType> fd(0, node_list.size() - 1);
+    auto ni = nd(rg);
+    std::vector<BnNode> fanin_list(ni);
+    for ( SizeType j = 0; j < ni; ++ j ) {
+      fanin_list[j] = node_list[fd(rg)];
+    }
+    node_list.push_back(model.new_primitive(PrimType::And, fanin_list));
+    fanin_total += ni;
+  }
+  // 最後の 1/16 を出力にする．
+  for ( SizeType i = node_num - input_num; i < node_num; ++ i ) {
+    model.new_output(node_list[i]);
+  }
+  node_list.clear();
+  model.wrap_up();
+
+  auto t1 = chrono::steady_clock::now();
+
+  // ノード番号の格納に用いているメモリ量
+  SizeType id_bytes = sizeof(BnIdType) * (fanin_total
+					  + model.input_num()
+					  + model.output_num()
+					  + model.logic_num()
+					  + model.logic_num()); // 関数番号
+
+  // 論理ノードのファンインをたどる．
+  SizeType sum = 0;
+  for ( SizeType l = 0; l < loop_num; ++ l ) {
+    for ( auto node: model.logic_ref_list() ) {
+      for ( auto id: node.fanin_id_list() ) {
+	sum += id;
+      }
+    }
+  }
+
+  auto t2 = chrono::steady_clock::now();
+
+  auto build_time = chrono::duration<double>(t1 - t0).count();
+  auto trav_time = chrono::duration<double>(t2 - t1).count();
+  cout << "sizeof(BnIdType): " << sizeof(BnIdType) << endl
+       << "# of nodes:       " << model.node_num() << endl
+       << "# of fanins:      " << fanin_total << endl
+       << "ID storage:       " << id_bytes << " bytes" << endl
+       << "build time:       " << build_time << " sec" << endl
+       << "traverse time:    " << trav_time << " sec"
+       << " (" << loop_num << " loops, checksum = " << sum << ")" << endl;
+
+  return 0;
+}
@@ -7,26 +7,19 @@
 /// All rights reserved.
 
 #include "ym/BnModel.h"
+#include "ym/MsgMgr.h"
+#include "ym/StreamMsgHandler.h"
 
 
-BEGIN_NAMESPACE_YM
-
-int
-read_aag(
-  int argc,
-  char** argv
+void
+usage(
+  const char* argv0
 )
 {
-  for ( SizeType i = 1; i < argc; ++ i ) {
-    string filename = argv[i];
-    auto aig = BnModel::read_aag(filename);
-    aig.print(cout);
-  }
-  return 0;
-}
-
-END_NAMESPACE_YM
+  using namespace std;
 
+  cerr << "USAGE : " << argv0 << " aag|aig-file ..." << endl;
+}
 
 int
 main(
@@ -34,5 +27,32 @@ main(
   char** argv
 )
 {
-  return YM_NAMESPACE::read_aag(argc, argv);
+  using namespace std;
+  using namespace nsYm;
+
+  if ( argc < 2 ) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  StreamMsgHandler msg_handler(cerr);
+  MsgMgr::attach_handler(&msg_handler);
+
+  for ( int i = 1; i < argc; ++ i ) {
+    std::string filename = argv[i];
+    // 拡張子が .aig ならバイナリ形式とみなす．
+    bool binary = filename.size() > 4 &&
+      filename.compare(filename.size() - 4, 4, ".aig") == 0;
+    try {
+      auto model = binary ?
+	BnModel::read_aig(filename) :
+	BnModel::read_aag(filename);
+      model.print(cout);
+    }
+    catch ( const std::invalid_argument& err ) {
+      cout << err.what() << endl;
+    }
+  }
+
+  return 0;
 }